@@ -1,3 +1,4 @@
+import functools
 import os
 import os.path
 import sys
@@ -21,16 +22,24 @@ class TestDataset(Dataset):
         np.random.seed(20240109)
         self.num_samples = 29
         self.sample_size = 7
+        self.label_size = 3
+        self.response_size = 2
         self.samples = np.random.normal(size=(self.num_samples,self.sample_size)).astype(np.float32)
+        self.labels = np.random.normal(size=(self.num_samples,self.label_size)).astype(np.float32)
+        self.responses = np.random.normal(size=(self.num_samples,self.response_size)).astype(np.float32)
     
     def __len__(self):
         return self.num_samples
     
     def __getitem__(self, index):
-        return Sample(sample=self.samples[index,:])
+        return Sample(sample=self.samples[index,:],
+                      label=self.labels[index,:],
+                      response=self.responses[index,:])
     
     def get_sample_dims(self):
-        return SampleDims(sample=[self.sample_size])
+        return SampleDims(sample=[self.sample_size],
+                          label=self.label_size,
+                          response=self.response_size)
 
 test_dataset = TestDataset()
 
@@ -38,17 +47,20 @@ test_dataset = TestDataset()
 # Setup LBANN experiment
 # ==============================================
 
-def setup_experiment(lbann, weekly):
+def setup_experiment(lbann, weekly, shared_memory_ring, work_dir):
     """Construct LBANN experiment.
 
     Args:
         lbann (module): Module for LBANN Python frontend
+        shared_memory_ring (bool): Whether workers pass samples
+            through the shared-memory ring
+        work_dir (str): Directory for the pickled dataset
 
     """
     mini_batch_size = len(test_dataset) // 4
     trainer = lbann.Trainer(mini_batch_size)
     model = construct_model(lbann)
-    data_reader = construct_data_reader(lbann)
+    data_reader = construct_data_reader(lbann, shared_memory_ring, work_dir)
     optimizer = lbann.NoOptimizer()
     return trainer, model, data_reader, optimizer, None # Don't request any specific number of nodes
 
@@ -60,36 +72,43 @@ def construct_model(lbann):
 
     """
 
-    # Layer graph
-    x = lbann.Input(data_field='samples')
-    y = lbann.L2Norm2(x)
-    layers = list(lbann.traverse_layer_graph(x))
-    metric = lbann.Metric(y, name='obj')
+    # Check each data field against a metric computed with NumPy
+    inputs = []
+    metrics = []
     callbacks = []
-
-    # Compute expected value with NumPy
-    vals = []
-    for i in range(len(test_dataset)):
-        x = test_dataset[i].sample.astype(np.float64)
-        y = tools.numpy_l2norm2(x)
-        vals.append(y)
-    val = np.mean(vals)
-    tol = 8 * val * np.finfo(np.float32).eps
-    callbacks.append(lbann.CallbackCheckMetric(
-        metric=metric.name,
-        lower_bound=val-tol,
-        upper_bound=val+tol,
-        error_on_failure=True,
-        execution_modes='test'))
+    for data_field, field in (('samples', 'sample'),
+                              ('labels', 'label'),
+                              ('responses', 'response')):
+
+        # Layer graph
+        x = lbann.Input(data_field=data_field)
+        y = lbann.L2Norm2(x)
+        inputs.append(x)
+        metrics.append(lbann.Metric(y, name=f'{field}_obj'))
+
+        # Compute expected value with NumPy
+        vals = []
+        for i in range(len(test_dataset)):
+            x = getattr(test_dataset[i], field).astype(np.float64)
+            y = tools.numpy_l2norm2(x)
+            vals.append(y)
+        val = np.mean(vals)
+        tol = 8 * val * np.finfo(np.float32).eps
+        callbacks.append(lbann.CallbackCheckMetric(
+            metric=metrics[-1].name,
+            lower_bound=val-tol,
+            upper_bound=val+tol,
+            error_on_failure=True,
+            execution_modes='test'))
 
     # Construct model
     num_epochs = 0
     return lbann.Model(num_epochs,
-                       layers=layers,
-                       metrics=[metric],
+                       layers=list(lbann.traverse_layer_graph(inputs)),
+                       metrics=metrics,
                        callbacks=callbacks)
 
-def construct_data_reader(lbann):
+def construct_data_reader(lbann, shared_memory_ring, work_dir):
     """Construct Protobuf message for Python dataset data reader.
 
     The Python data reader will import the current Python file to
@@ -97,6 +116,9 @@ def construct_data_reader(lbann):
 
     Args:
         lbann (module): Module for LBANN Python frontend
+        shared_memory_ring (bool): Whether workers pass samples
+            through the shared-memory ring
+        work_dir (str): Directory for the pickled dataset
 
     """
 
@@ -110,7 +132,8 @@ def construct_data_reader(lbann):
             test_dataset,
             dataset_path,
             'train',
-            shuffle=False
+            shuffle=False,
+            shared_memory_ring=shared_memory_ring
         )
     ])
     message.reader.extend([
@@ -118,7 +141,8 @@ def construct_data_reader(lbann):
             test_dataset,
             dataset_path,
             'test',
-            shuffle=False
+            shuffle=False,
+            shared_memory_ring=shared_memory_ring
         )
     ])
     return message
@@ -127,11 +151,23 @@ def construct_data_reader(lbann):
 # Setup PyTest
 # ==============================================
 
-work_dir = os.path.join(os.path.dirname(__file__),
-                        'experiments',
-                        os.path.basename(__file__).split('.py')[0])
-os.makedirs(work_dir, exist_ok=True)
-
-# Create test functions that can interact with PyTest
-for _test_func in tools.create_tests(setup_experiment, __file__, work_dir=work_dir):
-    globals()[_test_func.__name__] = _test_func
+# Run with and without the shared-memory sample ring
+for shared_memory_ring in (False, True):
+    test_name_base = os.path.basename(__file__).split('.py')[0]
+    if shared_memory_ring:
+        test_name_base += '_ring'
+    work_dir = os.path.join(os.path.dirname(__file__),
+                            'experiments',
+                            test_name_base)
+    os.makedirs(work_dir, exist_ok=True)
+    _setup_experiment = functools.partial(
+        setup_experiment,
+        shared_memory_ring=shared_memory_ring,
+        work_dir=work_dir)
+
+    # Create test functions that can interact with PyTest
+    for _test_func in tools.create_tests(_setup_experiment,
+                                         __file__,
+                                         test_name_base=test_name_base,
+                                         work_dir=work_dir):
+        globals()[_test_func.__name__] = _test_func
@@ -181,6 +181,44 @@ def construct_model(lbann):
         error_on_failure=True,
         execution_modes='test'))
 
+    # --------------------------
+    # Shared buffers along axis 0
+    # --------------------------
+    # Note: ELU layers can view the slice outputs and write directly
+    # into the concatenated output.
+
+    # LBANN implementation
+    x = x_lbann
+    x = lbann.Reshape(x, dims=[4,3,5])
+    x_slice = lbann.Slice(x, axis=0, slice_points=[0,1,3,4])
+    x1 = lbann.Elu(x_slice, alpha=1)
+    x2 = lbann.Elu(x_slice, alpha=1)
+    x3 = lbann.Elu(x_slice, alpha=1)
+    y = lbann.Concatenation(x3, x1, x2, axis=0)
+    z = lbann.L2Norm2(lbann.Multiply(x, y))
+    obj.append(z)
+    metrics.append(lbann.Metric(z, name='shared buffers'))
+
+    # NumPy implementation
+    vals = []
+    for i in range(num_samples()):
+        x = get_sample(i).reshape([4,3,5]).astype(np.float64)
+        x1 = x[0:1,:,:]
+        x2 = x[1:3,:,:]
+        x3 = x[3:4,:,:]
+        y = np.concatenate((x3, x1, x2), axis=0)
+        y = np.where(y > 0, y, np.expm1(y))
+        z = tools.numpy_l2norm2(x*y)
+        vals.append(z)
+    val = np.mean(vals)
+    tol = 8 * val * np.finfo(np.float32).eps
+    callbacks.append(lbann.CallbackCheckMetric(
+        metric=metrics[-1].name,
+        lower_bound=val-tol,
+        upper_bound=val+tol,
+        error_on_failure=True,
+        execution_modes='test'))
+
     # --------------------------
     # Model-parallel
     # --------------------------
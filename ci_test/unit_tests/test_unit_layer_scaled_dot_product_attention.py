@@ -0,0 +1,245 @@
+import functools
+import operator
+import os
+import os.path
+import sys
+import numpy as np
+
+# Bamboo utilities
+current_file = os.path.realpath(__file__)
+current_dir = os.path.dirname(current_file)
+sys.path.insert(0, os.path.join(os.path.dirname(current_dir), 'common_python'))
+import tools
+
+# ==============================================
+# Objects for Python data reader
+# ==============================================
+# Note: The Python data reader imports this file as a module and calls
+# the functions below to ingest data.
+
+# Data
+# Note: Each sample holds query, key, and value sequences for
+# multi-head attention.
+np.random.seed(202410182)
+_num_samples = 7
+_num_heads = 2
+_num_queries = 5
+_num_keys = 9
+_embed_dim = 6
+_value_dim = 4
+_query_size = _num_queries * _embed_dim
+_key_size = _num_keys * _embed_dim
+_value_size = _num_keys * _value_dim
+_sample_size = _query_size + _key_size + _value_size
+_samples = np.random.normal(size=(_num_samples, _sample_size)).astype(np.float32)
+
+# Sample access functions
+def get_sample(index):
+    return _samples[index,:]
+def num_samples():
+    return _num_samples
+def sample_dims():
+    return (_sample_size,)
+
+# ==============================================
+# NumPy implementation
+# ==============================================
+
+def numpy_attention(sample, causal=False, scale=None):
+    """Multi-head scaled dot-product attention
+
+    The computation is performed with 64-bit floats.
+
+    """
+    sample = sample.astype(np.float64)
+    q = sample[:_query_size].reshape(_num_queries, _embed_dim)
+    k = sample[_query_size:_query_size+_key_size].reshape(_num_keys, _embed_dim)
+    v = sample[_query_size+_key_size:].reshape(_num_keys, _value_dim)
+    head_dim = _embed_dim // _num_heads
+    value_head_dim = _value_dim // _num_heads
+    if scale is None:
+        scale = 1 / np.sqrt(head_dim)
+    heads = []
+    for h in range(_num_heads):
+        qh = q[:, h*head_dim:(h+1)*head_dim]
+        kh = k[:, h*head_dim:(h+1)*head_dim]
+        vh = v[:, h*value_head_dim:(h+1)*value_head_dim]
+        scores = scale * np.matmul(qh, kh.T)
+        if causal:
+            scores = np.where(np.tri(_num_queries, _num_keys) > 0,
+                              scores,
+                              -np.inf)
+        scores -= np.max(scores, axis=1, keepdims=True)
+        probs = np.exp(scores)
+        probs /= np.sum(probs, axis=1, keepdims=True)
+        heads.append(np.matmul(probs, vh))
+    return np.concatenate(heads, axis=1)
+
+# ==============================================
+# Setup LBANN experiment
+# ==============================================
+
+def setup_experiment(lbann, weekly):
+    """Construct LBANN experiment.
+
+    Args:
+        lbann (module): Module for LBANN Python frontend
+
+    """
+    mini_batch_size = num_samples() // 2
+    trainer = lbann.Trainer(mini_batch_size)
+    model = construct_model(lbann)
+    data_reader = construct_data_reader(lbann)
+    optimizer = lbann.NoOptimizer()
+    return trainer, model, data_reader, optimizer, None # Don't request any specific number of nodes
+
+def construct_model(lbann):
+    """Construct LBANN model.
+
+    Args:
+        lbann (module): Module for LBANN Python frontend
+
+    """
+
+    # Input data
+    # Note: Sum with a weights layer so that gradient checking will
+    # verify that error signals are correct.
+    x_weights = lbann.Weights(optimizer=lbann.SGD(),
+                              initializer=lbann.ConstantInitializer(value=0.0),
+                              name='input_weights')
+    x = lbann.Sum(lbann.Input(data_field='samples'),
+                  lbann.WeightsLayer(weights=x_weights,
+                                     dims=[_sample_size]))
+    x_slice = lbann.Slice(x,
+                          slice_points=[0,
+                                        _query_size,
+                                        _query_size+_key_size,
+                                        _sample_size])
+    q = lbann.Reshape(x_slice, dims=[_num_queries, _embed_dim])
+    k = lbann.Reshape(x_slice, dims=[_num_keys, _embed_dim])
+    v = lbann.Reshape(x_slice, dims=[_num_keys, _value_dim])
+    x_lbann = x
+
+    # Objects for LBANN model
+    obj = []
+    metrics = []
+    callbacks = []
+
+    # ------------------------------------------
+    # Full attention
+    # ------------------------------------------
+
+    # LBANN implementation
+    y = lbann.ScaledDotProductAttention(q,
+                                        k,
+                                        v,
+                                        num_heads=_num_heads,
+                                        device='cpu')
+    z = lbann.L2Norm2(y)
+    obj.append(z)
+    metrics.append(lbann.Metric(z, name='full'))
+
+    # NumPy implementation
+    vals = []
+    for i in range(num_samples()):
+        y = numpy_attention(get_sample(i))
+        vals.append(tools.numpy_l2norm2(y))
+    val = np.mean(vals)
+    tol = 8 * val * np.finfo(np.float32).eps
+    callbacks.append(lbann.CallbackCheckMetric(
+        metric=metrics[-1].name,
+        lower_bound=val-tol,
+        upper_bound=val+tol,
+        error_on_failure=True,
+        execution_modes='test'))
+
+    # ------------------------------------------
+    # Causal attention with custom scale
+    # ------------------------------------------
+
+    # LBANN implementation
+    y = lbann.ScaledDotProductAttention(q,
+                                        k,
+                                        v,
+                                        num_heads=_num_heads,
+                                        causal=True,
+                                        scale=0.25,
+                                        device='cpu')
+    z = lbann.L2Norm2(y)
+    obj.append(z)
+    metrics.append(lbann.Metric(z, name='causal'))
+
+    # NumPy implementation
+    vals = []
+    for i in range(num_samples()):
+        y = numpy_attention(get_sample(i), causal=True, scale=0.25)
+        vals.append(tools.numpy_l2norm2(y))
+    val = np.mean(vals)
+    tol = 8 * val * np.finfo(np.float32).eps
+    callbacks.append(lbann.CallbackCheckMetric(
+        metric=metrics[-1].name,
+        lower_bound=val-tol,
+        upper_bound=val+tol,
+        error_on_failure=True,
+        execution_modes='test'))
+
+    # ------------------------------------------
+    # Gradient checking
+    # ------------------------------------------
+
+    callbacks.append(lbann.CallbackCheckGradients(error_on_failure=True))
+
+    # ------------------------------------------
+    # Construct model
+    # ------------------------------------------
+
+    num_epochs = 0
+    return lbann.Model(num_epochs,
+                       layers=lbann.traverse_layer_graph(x_lbann),
+                       objective_function=obj,
+                       metrics=metrics,
+                       callbacks=callbacks)
+
+def construct_data_reader(lbann):
+    """Construct Protobuf message for Python data reader.
+
+    The Python data reader will import the current Python file to
+    access the sample access functions.
+
+    Args:
+        lbann (module): Module for LBANN Python frontend
+
+    """
+
+    # Note: The training data reader should be removed when
+    # https://github.com/LLNL/lbann/issues/1098 is resolved.
+    message = lbann.reader_pb2.DataReader()
+    message.reader.extend([
+        tools.create_python_data_reader(
+            lbann,
+            current_file,
+            'get_sample',
+            'num_samples',
+            'sample_dims',
+            'train'
+        )
+    ])
+    message.reader.extend([
+        tools.create_python_data_reader(
+            lbann,
+            current_file,
+            'get_sample',
+            'num_samples',
+            'sample_dims',
+            'test'
+        )
+    ])
+    return message
+
+# ==============================================
+# Setup PyTest
+# ==============================================
+
+# Create test functions that can interact with PyTest
+for _test_func in tools.create_tests(setup_experiment, __file__):
+    globals()[_test_func.__name__] = _test_func
@@ -0,0 +1,221 @@
+import functools
+import operator
+import os
+import os.path
+import sys
+import numpy as np
+
+# Bamboo utilities
+current_file = os.path.realpath(__file__)
+current_dir = os.path.dirname(current_file)
+sys.path.insert(0, os.path.join(os.path.dirname(current_dir), 'common_python'))
+import tools
+
+# ==============================================
+# Objects for Python data reader
+# ==============================================
+# Note: The Python data reader imports this file as a module and calls
+# the functions below to ingest data.
+
+# Data
+# Note: Each sample holds logits for a short sequence followed by one
+# integer label per sequence position. Label 0 is used as the ignored
+# (padding) label.
+np.random.seed(202410181)
+_num_samples = 15
+_sequence_length = 5
+_num_classes = 11
+_logits_size = _sequence_length * _num_classes
+_sample_size = _logits_size + _sequence_length
+_samples = np.concatenate(
+    (np.random.normal(size=(_num_samples, _logits_size)),
+     np.random.randint(_num_classes, size=(_num_samples, _sequence_length))),
+    axis=1,
+).astype(np.float32)
+
+# Sample access functions
+def get_sample(index):
+    return _samples[index,:]
+def num_samples():
+    return _num_samples
+def sample_dims():
+    return (_sample_size,)
+
+# ==============================================
+# NumPy implementation
+# ==============================================
+
+def numpy_softmax_cross_entropy(logits, labels, ignore_index=None):
+    """Sum of cross entropies between softmax of logits and labels
+
+    The computation is performed with 64-bit floats.
+
+    """
+    logits = logits.astype(np.float64).reshape(-1, _num_classes)
+    loss = 0.
+    for x, label in zip(logits, labels.astype(np.int64)):
+        if label == ignore_index:
+            continue
+        shift = np.max(x)
+        loss += shift + np.log(np.sum(np.exp(x - shift))) - x[label]
+    return loss
+
+# ==============================================
+# Setup LBANN experiment
+# ==============================================
+
+def setup_experiment(lbann, weekly):
+    """Construct LBANN experiment.
+
+    Args:
+        lbann (module): Module for LBANN Python frontend
+
+    """
+    mini_batch_size = num_samples() // 2
+    trainer = lbann.Trainer(mini_batch_size)
+    model = construct_model(lbann)
+    data_reader = construct_data_reader(lbann)
+    optimizer = lbann.NoOptimizer()
+    return trainer, model, data_reader, optimizer, None # Don't request any specific number of nodes
+
+def construct_model(lbann):
+    """Construct LBANN model.
+
+    Args:
+        lbann (module): Module for LBANN Python frontend
+
+    """
+
+    # Input data
+    # Note: Sum with a weights layer so that gradient checking will
+    # verify that error signals are correct.
+    x_weights = lbann.Weights(optimizer=lbann.SGD(),
+                              initializer=lbann.ConstantInitializer(value=0.0),
+                              name='input_weights')
+    x_slice = lbann.Slice(lbann.Input(data_field='samples'),
+                          slice_points=[0, _logits_size, _sample_size])
+    x = lbann.Sum(lbann.Reshape(x_slice,
+                                dims=[_sequence_length, _num_classes]),
+                  lbann.WeightsLayer(weights=x_weights,
+                                     dims=[_sequence_length, _num_classes]))
+    labels = lbann.Reshape(lbann.Identity(x_slice), dims=[_sequence_length])
+    x_lbann = x
+
+    # Objects for LBANN model
+    obj = []
+    metrics = []
+    callbacks = []
+
+    # ------------------------------------------
+    # All classes at once
+    # ------------------------------------------
+
+    # LBANN implementation
+    y = lbann.SoftmaxCrossEntropy(x_lbann, labels, device='cpu')
+    obj.append(y)
+    metrics.append(lbann.Metric(y, name='all classes'))
+
+    # NumPy implementation
+    vals = []
+    for i in range(num_samples()):
+        sample = get_sample(i)
+        vals.append(numpy_softmax_cross_entropy(sample[:_logits_size],
+                                                sample[_logits_size:]))
+    val = np.mean(vals)
+    tol = 8 * val * np.finfo(np.float32).eps
+    callbacks.append(lbann.CallbackCheckMetric(
+        metric=metrics[-1].name,
+        lower_bound=val-tol,
+        upper_bound=val+tol,
+        error_on_failure=True,
+        execution_modes='test'))
+
+    # ------------------------------------------
+    # Chunked vocabulary with ignored label
+    # ------------------------------------------
+
+    # LBANN implementation
+    y = lbann.SoftmaxCrossEntropy(x_lbann,
+                                  labels,
+                                  vocab_chunk_size=4,
+                                  ignore_index=0,
+                                  device='cpu')
+    obj.append(y)
+    metrics.append(lbann.Metric(y, name='chunked, ignore index'))
+
+    # NumPy implementation
+    vals = []
+    for i in range(num_samples()):
+        sample = get_sample(i)
+        vals.append(numpy_softmax_cross_entropy(sample[:_logits_size],
+                                                sample[_logits_size:],
+                                                ignore_index=0))
+    val = np.mean(vals)
+    tol = 8 * val * np.finfo(np.float32).eps
+    callbacks.append(lbann.CallbackCheckMetric(
+        metric=metrics[-1].name,
+        lower_bound=val-tol,
+        upper_bound=val+tol,
+        error_on_failure=True,
+        execution_modes='test'))
+
+    # ------------------------------------------
+    # Gradient checking
+    # ------------------------------------------
+
+    callbacks.append(lbann.CallbackCheckGradients(error_on_failure=True))
+
+    # ------------------------------------------
+    # Construct model
+    # ------------------------------------------
+
+    num_epochs = 0
+    return lbann.Model(num_epochs,
+                       layers=lbann.traverse_layer_graph(x_lbann),
+                       objective_function=obj,
+                       metrics=metrics,
+                       callbacks=callbacks)
+
+def construct_data_reader(lbann):
+    """Construct Protobuf message for Python data reader.
+
+    The Python data reader will import the current Python file to
+    access the sample access functions.
+
+    Args:
+        lbann (module): Module for LBANN Python frontend
+
+    """
+
+    # Note: The training data reader should be removed when
+    # https://github.com/LLNL/lbann/issues/1098 is resolved.
+    message = lbann.reader_pb2.DataReader()
+    message.reader.extend([
+        tools.create_python_data_reader(
+            lbann,
+            current_file,
+            'get_sample',
+            'num_samples',
+            'sample_dims',
+            'train'
+        )
+    ])
+    message.reader.extend([
+        tools.create_python_data_reader(
+            lbann,
+            current_file,
+            'get_sample',
+            'num_samples',
+            'sample_dims',
+            'test'
+        )
+    ])
+    return message
+
+# ==============================================
+# Setup PyTest
+# ==============================================
+
+# Create test functions that can interact with PyTest
+for _test_func in tools.create_tests(setup_experiment, __file__):
+    globals()[_test_func.__name__] = _test_func
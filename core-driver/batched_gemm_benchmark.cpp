@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////
+//// Copyright (c) 2014-2021, Lawrence Livermore National Security, LLC.
+//// Produced at the Lawrence Livermore National Laboratory.
+//// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+//// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+////
+//// LLNL-CODE-697807.
+//// All rights reserved.
+////
+//// This file is part of LBANN: Livermore Big Artificial Neural Network
+//// Toolkit. For details, see http://software.llnl.gov/LBANN or
+//// https://github.com/LLNL/LBANN.
+////
+//// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+//// may not use this file except in compliance with the License.  You may
+//// obtain a copy of the License at:
+////
+//// http://www.apache.org/licenses/LICENSE-2.0
+////
+//// Unless required by applicable law or agreed to in writing, software
+//// distributed under the License is distributed on an "AS IS" BASIS,
+//// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//// implied. See the License for the specific language governing
+//// permissions and limitations under the license.
+///////////////////////////////////////////////////////////////////////////////
+
+// Microbenchmark for the CPU strided batched GEMM used by the matmul
+// layer. Shapes follow the per-head products in multi-head attention:
+// scores = Q K^T (seq x seq x head_dim) and context = P V
+// (seq x head_dim x seq), batched over mini-batch samples and heads.
+// The batched kernel is compared against one El::blas::Gemm call per
+// matrix inside an OpenMP loop, which is how matmul used to work.
+
+#include "lbann/utils/argument_parser.hpp"
+#include "lbann/utils/batched_gemm.hpp"
+#include "lbann/utils/omp_pragma.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using clock_type = std::chrono::steady_clock;
+
+void construct_opts(int argc, char **argv) {
+  auto& arg_parser = lbann::global_argument_parser();
+  arg_parser.add_option("iterations",
+                        {"-n"},
+                        "Number of timed iterations per shape",
+                        20);
+  arg_parser.add_option("batch",
+                        {"-b"},
+                        "Mini-batch size (number of samples)",
+                        8);
+  arg_parser.add_option("heads",
+                        {"--heads"},
+                        "Number of attention heads",
+                        8);
+  arg_parser.parse(argc, argv);
+}
+
+struct shape {
+  const char* name;
+  El::Orientation transA, transB;
+  El::Int m, n, k;
+};
+
+// Time a functor, returning the median of several runs in ms
+template <typename F>
+double time_ms(F&& f, int iterations) {
+  f(); // Warm up
+  std::vector<double> times(iterations);
+  for (auto& t : times) {
+    const auto start = clock_type::now();
+    f();
+    t = std::chrono::duration<double, std::milli>(clock_type::now() - start)
+          .count();
+  }
+  std::sort(times.begin(), times.end());
+  return times[times.size() / 2];
+}
+
+int main(int argc, char **argv) {
+  construct_opts(argc, argv);
+  auto& arg_parser = lbann::global_argument_parser();
+  const int iterations = arg_parser.get<int>("iterations");
+  const El::Int batch_count =
+    arg_parser.get<int>("batch") * arg_parser.get<int>("heads");
+
+  // (sequence length, head dimension) pairs
+  const std::vector<std::pair<El::Int, El::Int>> configs = {
+    {64, 32}, {128, 64}, {256, 64}, {512, 64}, {1024, 128}};
+
+  std::cout << "batch count = " << batch_count
+            << ", OpenMP threads = " << omp_get_max_threads() << std::endl;
+  std::cout << std::setw(8) << "seq" << std::setw(6) << "dim"
+            << std::setw(10) << "product"
+            << std::setw(14) << "loop (ms)"
+            << std::setw(14) << "batched (ms)"
+            << std::setw(10) << "speedup"
+            << std::setw(12) << "GFLOP/s" << std::endl;
+
+  std::mt19937 gen(20240101);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  for (const auto& [seq, dim] : configs) {
+    const std::vector<shape> shapes = {
+      {"QK^T", El::TRANSPOSE, El::NORMAL, seq, seq, dim},
+      {"PV", El::NORMAL, El::NORMAL, dim, seq, seq},
+      {"dP", El::TRANSPOSE, El::NORMAL, seq, seq, dim},
+      {"dV", El::NORMAL, El::TRANSPOSE, dim, seq, seq}};
+    for (const auto& s : shapes) {
+      const El::Int lda = (s.transA == El::NORMAL ? s.m : s.k);
+      const El::Int ldb = (s.transB == El::NORMAL ? s.k : s.n);
+      const El::Int ldc = s.m;
+      const El::Int strideA = s.m * s.k;
+      const El::Int strideB = s.k * s.n;
+      const El::Int strideC = s.m * s.n;
+      std::vector<float> A(strideA * batch_count), B(strideB * batch_count);
+      std::vector<float> C(strideC * batch_count);
+      for (auto& x : A) {
+        x = dist(gen);
+      }
+      for (auto& x : B) {
+        x = dist(gen);
+      }
+
+      const char transa = (s.transA == El::NORMAL ? 'N' : 'T');
+      const char transb = (s.transB == El::NORMAL ? 'N' : 'T');
+      const double loop_time = time_ms(
+        [&]() {
+          LBANN_OMP_PARALLEL_FOR
+          for (El::Int i = 0; i < batch_count; ++i) {
+            El::blas::Gemm(transa,
+                           transb,
+                           s.m,
+                           s.n,
+                           s.k,
+                           1.f,
+                           A.data() + i * strideA,
+                           lda,
+                           B.data() + i * strideB,
+                           ldb,
+                           0.f,
+                           C.data() + i * strideC,
+                           ldc);
+          }
+        },
+        iterations);
+      const double batched_time = time_ms(
+        [&]() {
+          lbann::gemm_strided_batched(s.transA,
+                                      s.transB,
+                                      s.m,
+                                      s.n,
+                                      s.k,
+                                      1.f,
+                                      A.data(),
+                                      lda,
+                                      strideA,
+                                      B.data(),
+                                      ldb,
+                                      strideB,
+                                      0.f,
+                                      C.data(),
+                                      ldc,
+                                      strideC,
+                                      batch_count);
+        },
+        iterations);
+
+      const double gflops =
+        2. * s.m * s.n * s.k * batch_count / (batched_time * 1e6);
+      std::cout << std::setw(8) << seq << std::setw(6) << dim
+                << std::setw(10) << s.name
+                << std::setw(14) << std::fixed << std::setprecision(3)
+                << loop_time
+                << std::setw(14) << batched_time
+                << std::setw(10) << std::setprecision(2)
+                << loop_time / batched_time
+                << std::setw(12) << std::setprecision(1) << gflops
+                << std::defaultfloat << std::endl;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,222 @@
+///////////////////////////////////////////////////////////////////////////////
+//// Copyright (c) 2014-2021, Lawrence Livermore National Security, LLC.
+//// Produced at the Lawrence Livermore National Laboratory.
+//// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+//// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+////
+//// LLNL-CODE-697807.
+//// All rights reserved.
+////
+//// This file is part of LBANN: Livermore Big Artificial Neural Network
+//// Toolkit. For details, see http://software.llnl.gov/LBANN or
+//// https://github.com/LLNL/LBANN.
+////
+//// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+//// may not use this file except in compliance with the License.  You may
+//// obtain a copy of the License at:
+////
+//// http://www.apache.org/licenses/LICENSE-2.0
+////
+//// Unless required by applicable law or agreed to in writing, software
+//// distributed under the License is distributed on an "AS IS" BASIS,
+//// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//// implied. See the License for the specific language governing
+//// permissions and limitations under the license.
+///////////////////////////////////////////////////////////////////////////////
+
+// Load generator for the dynamic-batching inference server. Requests
+// arrive as a Poisson process at each offered rate and the latency of
+// each request is measured from submission until its result is ready.
+
+#include "lbann/lbann.hpp"
+#include "lbann/utils/argument_parser.hpp"
+#include <mpi.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using clock_type = std::chrono::steady_clock;
+
+void construct_opts(int argc, char **argv) {
+  auto& arg_parser = lbann::global_argument_parser();
+  arg_parser.add_option("channels",
+                        {"-c"},
+                        "Number of image channels in sample",
+                        1);
+  arg_parser.add_option("height",
+                        {"-h"},
+                        "Height of image in sample",
+                        28);
+  arg_parser.add_option("width",
+                        {"-w"},
+                        "Width of image in sample",
+                        28);
+  arg_parser.add_option("labels",
+                        {"-l"},
+                        "Number of labels in dataset",
+                        10);
+  arg_parser.add_option("minibatchsize",
+                        {"-mbs"},
+                        "Max number of samples in a mini-batch",
+                        16);
+  arg_parser.add_option("max_delay_us",
+                        {"--max_delay_us"},
+                        "Max time a request waits for a mini-batch to fill (us)",
+                        2000);
+  arg_parser.add_option("requests",
+                        {"-n"},
+                        "Number of requests per offered rate",
+                        2000);
+  arg_parser.add_option("rates",
+                        {"--rates"},
+                        "Comma-separated offered loads (requests/s)",
+                        std::string("100,500,1000,2000,5000,10000"));
+  arg_parser.add_flag("optimize_graph",
+                      {"--optimize_graph"},
+                      "Apply inference-only graph rewrites to the model");
+  arg_parser.add_required_argument<std::string>
+                                  ("model",
+                                   "Directory containing checkpointed model");
+  arg_parser.parse(argc, argv);
+}
+
+std::vector<double> parse_rates(std::string const& str) {
+  std::vector<double> rates;
+  std::istringstream ss(str);
+  std::string token;
+  while (std::getline(ss, token, ',')) {
+    if (!token.empty()) {
+      rates.push_back(std::stod(token));
+    }
+  }
+  return rates;
+}
+
+double percentile(std::vector<double> sorted_values, double p) {
+  if (sorted_values.empty()) {
+    return 0.;
+  }
+  const size_t idx = std::min(
+    sorted_values.size() - 1,
+    static_cast<size_t>(p * static_cast<double>(sorted_values.size())));
+  return sorted_values[idx];
+}
+
+int main(int argc, char **argv) {
+  // Initialize MPI
+  int provided;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+  if (provided != MPI_THREAD_MULTIPLE) {
+    std::cout << "MPI_THREAD_MULTIPLE not supported" << std::endl;
+  }
+
+  construct_opts(argc, argv);
+  auto& arg_parser = lbann::global_argument_parser();
+  const int mbs = arg_parser.get<int>("minibatchsize");
+  const int num_requests = arg_parser.get<int>("requests");
+  const std::chrono::microseconds max_delay(
+    arg_parser.get<int>("max_delay_us"));
+  const auto rates = parse_rates(arg_parser.get<std::string>("rates"));
+
+  // Load model
+  auto lbann_comm = lbann::initialize_lbann(MPI_COMM_WORLD);
+  auto m = lbann::load_inference_model(lbann_comm.get(),
+                                       arg_parser.get<std::string>("model"),
+                                       mbs,
+                                       {
+                                         arg_parser.get<int>("channels"),
+                                         arg_parser.get<int>("height"),
+                                         arg_parser.get<int>("width")
+                                       },
+                                       {arg_parser.get<int>("labels")},
+                                       arg_parser.get<bool>("optimize_graph"));
+
+  // Pool of random samples
+  const size_t sample_size = arg_parser.get<int>("channels")
+                             * arg_parser.get<int>("height")
+                             * arg_parser.get<int>("width");
+  std::mt19937 gen(lbann::lbann_default_random_seed);
+  std::uniform_real_distribution<float> uniform(0.f, 1.f);
+  std::vector<std::vector<float>> pool(64, std::vector<float>(sample_size));
+  for (auto& sample : pool) {
+    for (auto& val : sample) {
+      val = uniform(gen);
+    }
+  }
+
+  std::cout << "max batch size = " << mbs
+            << ", max delay = " << max_delay.count() << " us"
+            << ", requests per rate = " << num_requests << std::endl;
+  std::cout << std::setw(14) << "offered (r/s)"
+            << std::setw(14) << "achieved (r/s)"
+            << std::setw(12) << "mean batch"
+            << std::setw(12) << "p50 (ms)"
+            << std::setw(12) << "p99 (ms)" << std::endl;
+
+  for (const double rate : rates) {
+    lbann::inference_server server(m.get(), mbs, max_delay);
+    std::vector<std::future<std::vector<float>>> results(num_requests);
+    std::vector<clock_type::time_point> submit_times(num_requests);
+    std::vector<double> latencies(num_requests);
+
+    // Collect results in submission order. Mini-batches are formed
+    // in order, so each result is collected as soon as it is ready.
+    std::atomic<int> num_submitted(0);
+    clock_type::time_point end;
+    std::thread collector([&]() {
+      for (int i = 0; i < num_requests; ++i) {
+        while (num_submitted.load(std::memory_order_acquire) <= i) {
+          std::this_thread::yield();
+        }
+        results[i].wait();
+        end = clock_type::now();
+        latencies[i] =
+          std::chrono::duration<double, std::milli>(end - submit_times[i])
+            .count();
+      }
+    });
+
+    // Open-loop Poisson arrivals
+    std::exponential_distribution<double> interarrival(rate);
+    const auto start = clock_type::now();
+    auto next = start;
+    for (int i = 0; i < num_requests; ++i) {
+      std::this_thread::sleep_until(next);
+      submit_times[i] = clock_type::now();
+      results[i] = server.submit(pool[i % pool.size()]);
+      num_submitted.store(i + 1, std::memory_order_release);
+      next += std::chrono::duration_cast<clock_type::duration>(
+        std::chrono::duration<double>(interarrival(gen)));
+    }
+    collector.join();
+    server.stop();
+
+    const auto stats = server.get_statistics();
+    std::sort(latencies.begin(), latencies.end());
+    const double elapsed = std::chrono::duration<double>(end - start).count();
+    std::cout << std::setw(14) << rate
+              << std::setw(14) << std::fixed << std::setprecision(1)
+              << num_requests / elapsed
+              << std::setw(12) << std::setprecision(2)
+              << static_cast<double>(stats.num_requests)
+                   / std::max<size_t>(stats.num_batches, 1)
+              << std::setw(12) << std::setprecision(3)
+              << percentile(latencies, 0.50)
+              << std::setw(12) << percentile(latencies, 0.99)
+              << std::defaultfloat << std::endl;
+  }
+
+  // Clean up
+  m.reset();
+  lbann::finalize_lbann();
+  MPI_Finalize();
+
+  return 0;
+}
@@ -55,6 +55,9 @@ void construct_opts(int argc, char **argv) {
                         {"-mbs"},
                         "Number of samples in a mini-batch",
                         16);
+  arg_parser.add_flag("optimize_graph",
+                      {"--optimize_graph"},
+                      "Apply inference-only graph rewrites to the model");
   arg_parser.add_required_argument<std::string>
                                   ("model",
                                    "Directory containing checkpointed model");
@@ -104,7 +107,8 @@ int main(int argc, char **argv) {
                                          arg_parser.get<int>("height"),
                                          arg_parser.get<int>("width")
                                        },
-                                       {arg_parser.get<int>("labels")});
+                                       {arg_parser.get<int>("labels")},
+                                       arg_parser.get<bool>("optimize_graph"));
   auto samples = random_samples(lbann_comm->get_trainer_grid(),
                                 arg_parser.get<int>("samples"),
                                 arg_parser.get<int>("channels"),
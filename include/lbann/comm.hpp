@@ -41,6 +41,7 @@
 #include "detect_El_mpi.hpp"
 
 #include <map>
+#include <memory>
 #include <typeindex>
 #include <vector>
 
@@ -51,6 +52,9 @@ namespace lbann {
 ::Al::ReductionOperator mpi_op_to_al_op(El::mpi::Op op);
 #endif
 
+// Forward declarations
+class comm_progress_engine;
+
 /** Grid types in sub-grid parallelism (2nd order) */
 enum class GridType
 {
@@ -369,6 +373,29 @@ public:
                   int rcv_count,
                   const El::mpi::Comm& c,
                   El::SyncInfo<D> const& syncInfo) const;
+  /** Non-blocking allgather over an arbitrary communicator.
+   *  Entries are transferred as raw bytes, so @c T must be trivially
+   *  copyable. This always uses MPI directly.
+   */
+  template <typename T>
+  void nb_all_gather(const T* src,
+                     int src_count,
+                     T* rcv,
+                     int rcv_count,
+                     const El::mpi::Comm& c,
+                     Al::request& req) const;
+  /** Non-blocking reduce-scatter over an arbitrary communicator.
+   *  @c src holds @c rcv_count entries for each rank, in rank order,
+   *  and each rank receives the reduction of its block in @c rcv.
+   *  This always uses MPI directly.
+   */
+  template <typename T>
+  void nb_reduce_scatter(const T* src,
+                         T* rcv,
+                         int rcv_count,
+                         const El::mpi::Comm& c,
+                         Al::request& req,
+                         El::mpi::Op op = El::mpi::SUM) const;
 
   /**
    * Allgatherv over an arbitrary communicator;
@@ -629,6 +656,19 @@ public:
                     const El::mpi::Comm& c,
                     Al::request& req,
                     El::mpi::Op op = El::mpi::SUM) const;
+  /** Non-blocking in-place scalar-array allreduce with a user-defined
+   *  MPI datatype and reduction operation.
+   *  This is intended for encoded buffers that MPI cannot reduce
+   *  natively and always uses MPI directly. @c type must describe
+   *  entries of type @c T.
+   */
+  template <typename T>
+  void nb_allreduce(T* data,
+                    int count,
+                    const El::mpi::Comm& c,
+                    Al::request& req,
+                    MPI_Datatype type,
+                    MPI_Op op) const;
 
   /** Wait for a all non-blocking requests to complete. */
   template <typename T>
@@ -850,13 +890,36 @@ public:
   /** Return the number of bytes received. */
   inline size_t get_bytes_received() const noexcept { return m_bytes_received; }
 
-  inline void reset_stats_counters() noexcept
+  /** Return the time (in seconds) that non-blocking requests handled
+   *  by the progress thread were in flight before they were waited on.
+   *  This is the communication time hidden behind computation.
+   */
+  double get_comm_overlap_time() const;
+  /** Return the time (in seconds) spent blocked waiting for
+   *  non-blocking requests handled by the progress thread.
+   */
+  double get_comm_wait_time() const;
+
+  void reset_stats_counters();
+
+  /** Launch a background thread that progresses non-blocking MPI
+   *  requests issued through this communicator.
+   *  Only requests that go directly through MPI (not Aluminum) are
+   *  progressed. Does nothing (with a warning) if MPI does not
+   *  provide MPI_THREAD_MULTIPLE.
+   *  @param pu_index Processing unit to bind the thread to (see
+   *                  bind_current_thread_to_pu). Negative values
+   *                  leave the thread unbound.
+   */
+  void start_progress_thread(int pu_index = -1);
+  /** Stop the progress thread.
+   *  Outstanding requests must have been waited on.
+   */
+  void stop_progress_thread();
+  /** Whether a progress thread is running. */
+  bool has_progress_thread() const noexcept
   {
-    m_num_trainer_barriers = 0;
-    m_num_intertrainer_barriers = 0;
-    m_num_global_barriers = 0;
-    m_bytes_sent = 0;
-    m_bytes_received = 0;
+    return m_progress_engine != nullptr;
   }
 
   /** Return true if mat can be transmitted. */
@@ -998,6 +1061,12 @@ private:
   mutable size_t m_bytes_sent;
   mutable size_t m_bytes_received;
 
+  /** Progresses non-blocking MPI requests in the background. */
+  std::unique_ptr<comm_progress_engine> m_progress_engine;
+
+  /** Hand a raw MPI request to the progress thread, if running. */
+  void track_request(Al::request& req) const;
+
   /** Setup communicator for processes in the same compute node. */
   void setup_node_comm();
 
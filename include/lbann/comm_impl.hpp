@@ -196,6 +196,47 @@ void lbann_comm::all_gather(const T* const src,
 {
   El::mpi::AllGather(src, src_count, rcv, rcv_count, c, syncInfo);
 }
+template <typename T>
+void lbann_comm::nb_all_gather(const T* const src,
+                               const int src_count,
+                               T* const rcv,
+                               const int rcv_count,
+                               const El::mpi::Comm& c,
+                               Al::request& req) const
+{
+  m_bytes_sent += sizeof(T) * src_count;
+  MPI_Iallgather(src,
+                 sizeof(T) * src_count,
+                 MPI_BYTE,
+                 rcv,
+                 sizeof(T) * rcv_count,
+                 MPI_BYTE,
+                 c.GetMPIComm(),
+                 &(req.raw_mpi_req));
+  track_request(req);
+  m_bytes_received += sizeof(T) * rcv_count * (El::mpi::Size(c) - 1);
+}
+
+template <typename T>
+void lbann_comm::nb_reduce_scatter(const T* const src,
+                                   T* const rcv,
+                                   const int rcv_count,
+                                   const El::mpi::Comm& c,
+                                   Al::request& req,
+                                   const El::mpi::Op op) const
+{
+  const int size_c = El::mpi::Size(c);
+  m_bytes_sent += sizeof(T) * rcv_count * (size_c - 1);
+  MPI_Ireduce_scatter_block(src,
+                            rcv,
+                            rcv_count,
+                            El::mpi::TypeMap<T>(),
+                            op.op,
+                            c.GetMPIComm(),
+                            &(req.raw_mpi_req));
+  track_request(req);
+  m_bytes_received += sizeof(T) * rcv_count * (size_c - 1);
+}
 
 /**
  * Allgatherv over an arbitrary communicator;
@@ -738,9 +779,32 @@ void lbann_comm::nb_allreduce(T* data,
                  op.op,
                  c.GetMPIComm(),
                  &(req.raw_mpi_req));
+  track_request(req);
 #endif // LBANN_HAS_ALUMINUM
   m_bytes_received += count * sizeof(T) * (El::mpi::Size(c) - 1);
 }
+/** Non-blocking in-place scalar-array allreduce with a user-defined
+ *  MPI datatype and reduction operation.
+ */
+template <typename T>
+void lbann_comm::nb_allreduce(T* data,
+                              const int count,
+                              const El::mpi::Comm& c,
+                              Al::request& req,
+                              MPI_Datatype type,
+                              MPI_Op op) const
+{
+  m_bytes_sent += count * sizeof(T);
+  MPI_Iallreduce(MPI_IN_PLACE,
+                 data,
+                 count,
+                 type,
+                 op,
+                 c.GetMPIComm(),
+                 &(req.raw_mpi_req));
+  track_request(req);
+  m_bytes_received += count * sizeof(T) * (El::mpi::Size(c) - 1);
+}
 
 /** Wait for a all non-blocking requests to complete. */
 template <typename T>
@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_COMM_PROGRESS_ENGINE_HPP_INCLUDED
+#define LBANN_COMM_PROGRESS_ENGINE_HPP_INCLUDED
+
+#include <mpi.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lbann {
+
+/** @brief Background thread that progresses non-blocking MPI requests.
+ *
+ *  Most MPI implementations only advance a non-blocking collective
+ *  when the application calls into the MPI library. Requests handed
+ *  to this engine are polled from a dedicated thread so that they
+ *  complete while the main thread computes, e.g. so that gradient
+ *  allreduces overlap with backprop.
+ *
+ *  The engine keeps a copy of each tracked handle and polls it with
+ *  @c MPI_Request_get_status, outside of its mutex. Unlike
+ *  @c MPI_Test, this does not free the request, so the handle stays
+ *  valid and unique until @c wait or @c test reports completion,
+ *  which free it and reset the caller's handle to
+ *  @c MPI_REQUEST_NULL. Requests are identified by handle value
+ *  rather than by address, so the structure holding a handle may be
+ *  copied or moved while it is in flight. The caller must not wait
+ *  on or test a tracked handle with MPI directly. Requires
+ *  @c MPI_THREAD_MULTIPLE.
+ */
+class comm_progress_engine
+{
+public:
+  /** @brief Launch the progress thread.
+   *  @param pu_index Processing unit to bind the thread to (see
+   *                  @c bind_current_thread_to_pu). Negative values
+   *                  leave the thread unbound.
+   */
+  explicit comm_progress_engine(int pu_index = -1);
+  ~comm_progress_engine();
+  comm_progress_engine(const comm_progress_engine&) = delete;
+  comm_progress_engine& operator=(const comm_progress_engine&) = delete;
+
+  /** @brief Whether MPI was initialized with sufficient thread support. */
+  static bool is_supported();
+
+  /** @brief Hand a request to the progress thread. */
+  void track(MPI_Request* req);
+
+  /** @brief Block until a tracked request completes.
+   *  @returns False if the request is not tracked by this engine.
+   */
+  bool wait(MPI_Request* req);
+
+  /** @brief Check whether a tracked request has completed.
+   *  @param complete Set to true if the request has completed.
+   *  @returns False if the request is not tracked by this engine.
+   */
+  bool test(MPI_Request* req, bool& complete);
+
+  /** @brief Time (in seconds) requests spent in flight before the
+   *  application waited on them, i.e. communication hidden behind
+   *  computation.
+   */
+  double get_overlap_time() const;
+  /** @brief Time (in seconds) the application spent blocked waiting
+   *  for tracked requests.
+   */
+  double get_wait_time() const;
+  /** @brief Number of requests completed since the last reset. */
+  size_t get_num_requests() const;
+  void reset_counters();
+
+private:
+  struct tracked_request
+  {
+    MPI_Request handle;
+    /** @brief Time when the request was handed to the engine. */
+    double start_time;
+    /** @brief Time when the progress thread observed completion. */
+    double finish_time;
+    bool done;
+  };
+
+  mutable std::mutex m_mutex;
+  /** @brief Signals the progress thread that there is work. */
+  std::condition_variable m_work_cv;
+  /** @brief Signals waiters that a request has completed. */
+  std::condition_variable m_done_cv;
+  std::vector<tracked_request> m_requests;
+  size_t m_num_pending = 0;
+  bool m_stop = false;
+
+  double m_overlap_time = 0.0;
+  double m_wait_time = 0.0;
+  size_t m_num_requests = 0;
+
+  /** @brief Handles polled in one iteration. Only accessed by the
+   *  progress thread.
+   */
+  std::vector<MPI_Request> m_polled;
+  /** @brief Handles found complete in one iteration. Only accessed
+   *  by the progress thread.
+   */
+  std::vector<MPI_Request> m_completed;
+
+  std::thread m_thread;
+
+  void progress_loop(int pu_index);
+  /** @brief Find a tracked request. Caller must hold the mutex. */
+  std::vector<tracked_request>::iterator find(MPI_Request req);
+  /** @brief Update statistics and stop tracking a completed request.
+   *  Caller must hold the mutex.
+   */
+  void retire(std::vector<tracked_request>::iterator it, double wait_start);
+};
+
+} // namespace lbann
+
+#endif // LBANN_COMM_PROGRESS_ENGINE_HPP_INCLUDED
@@ -215,6 +215,8 @@ protected:
 
   uint64_t get_current_mini_batch_size(execution_mode mode) const override;
 
+  uint64_t get_effective_sequence_length(execution_mode mode) const override;
+
   //************************************************************************
   //
   //************************************************************************
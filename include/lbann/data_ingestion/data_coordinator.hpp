@@ -180,6 +180,14 @@ public:
 
   virtual uint64_t get_current_mini_batch_size(execution_mode mode) const;
 
+  /**
+   * Return the length of the longest sample in the current
+   * mini-batch, or 0 if the data reader does not report sample
+   * lengths. Entries past this length are padding in every sample of
+   * the mini-batch.
+   */
+  virtual uint64_t get_effective_sequence_length(execution_mode mode) const;
+
   //************************************************************************
   // Helper functions to access the data readers
   //************************************************************************
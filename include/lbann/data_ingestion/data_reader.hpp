@@ -210,6 +210,35 @@ public:
    */
   bool is_shuffled() const { return m_shuffle; }
 
+  /**
+   * Group samples of similar length into the same mini-batch when
+   * shuffling. Pools of @c pool_size mini-batches are sorted by
+   * sample length before the mini-batch order is shuffled; 0
+   * disables bucketing. Only has an effect for shuffled readers that
+   * report sample lengths (see get_sample_length()).
+   */
+  void set_length_bucketing_pool_size(uint64_t pool_size)
+  {
+    m_length_bucketing_pool_size = pool_size;
+  }
+
+  /**
+   * Returns the number of mini-batches sorted together by length.
+   */
+  uint64_t get_length_bucketing_pool_size() const
+  {
+    return m_length_bucketing_pool_size;
+  }
+
+  /**
+   * Set the mini-batch size used to cut the shuffled indices into
+   * length buckets. Set by the data coordinator.
+   */
+  void set_length_bucketing_mini_batch_size(uint64_t mini_batch_size)
+  {
+    m_length_bucketing_mini_batch_size = mini_batch_size;
+  }
+
   /**
    * Set shuffled indices; primary use is for testing
    * and reproducibility
@@ -390,6 +419,20 @@ public:
     return {};
   }
 
+  /**
+   * Returns the sequence length of a sample, i.e. the number of
+   * leading entries that are not padding, or -1 if the reader does
+   * not produce variable-length sequences.
+   */
+  virtual int get_sample_length(uint64_t data_id) const { return -1; }
+
+  /**
+   * Returns the length of the longest sample in the range
+   * [begin, end) of the shuffled indices, or 0 if the reader does not
+   * report sample lengths.
+   */
+  uint64_t get_max_sample_length(uint64_t begin, uint64_t end) const;
+
   /// Get a pointer to the start of the shuffled indices.
   uint64_t* get_indices() { return &m_shuffled_indices[0]; }
   /// Get the number of samples in this dataset.
@@ -674,6 +717,13 @@ private:
 protected:
   bool m_use_data_store = false;
 
+  /** Number of mini-batches sorted together by sample length when
+   *  shuffling (0 disables length bucketing) */
+  uint64_t m_length_bucketing_pool_size = 0;
+  /** Mini-batch size used to cut the shuffled indices into length
+   *  buckets */
+  uint64_t m_length_bucketing_mini_batch_size = 0;
+
   /** @brief Holds a true value for each input data type that is supported.
    *  Use an ordered map so that checkpoints are stable. */
   std::map<data_field_type, bool> m_supported_input_types;
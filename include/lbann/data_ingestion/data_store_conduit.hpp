@@ -35,8 +35,10 @@
 #include "lbann/comm.hpp"
 #include "lbann/utils/exception.hpp"
 #include <mutex>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace lbann {
 
@@ -58,6 +60,53 @@ struct size_t_pair_hash
   }
 };
 
+/** @brief Typed view of one field of a stored sample. */
+struct sample_field_view
+{
+  /** Address of the first element */
+  const void* data = nullptr;
+  /** Conduit type id of the elements */
+  conduit::index_t dtype_id = conduit::DataType::EMPTY_ID;
+  /** Number of elements */
+  size_t count = 0;
+
+  template <typename T>
+  const T* as() const
+  {
+    return static_cast<const T*>(data);
+  }
+};
+
+/** @brief Resolves a field of the samples held in the data store.
+ *
+ *  Samples are stored as nodes with a single child named after the
+ *  zero-padded sample id, which in turn holds the sample's fields.
+ *  Looking a field up with a path string means formatting the id and
+ *  joining and parsing the path for every sample. An accessor is
+ *  instead built once per field path (e.g. "data" or "frm/data") and
+ *  walks the children of each sample directly, comparing the path
+ *  components against the child names in place.
+ */
+class sample_field_accessor
+{
+public:
+  /** @param field_path Path of the field below the sample id. */
+  explicit sample_field_accessor(const std::string& field_path);
+
+  const std::string& get_field_path() const { return m_field_path; }
+
+  /** Node holding the field in @c sample. */
+  const conduit::Node& get_node(const conduit::Node& sample) const;
+
+  /** Pointer, type and element count of the field in @c sample. */
+  sample_field_view get_view(const conduit::Node& sample) const;
+
+private:
+  std::string m_field_path;
+  /** Components of the field path */
+  std::vector<std::string> m_path;
+};
+
 class data_store_conduit
 {
 
@@ -38,6 +38,9 @@ class Node;
 }
 
 namespace lbann {
+
+class sample_field_accessor;
+
 namespace data_packer {
 
 /** @brief Copy data fields from Conduit nodes to Hydrogen matrices.
@@ -83,6 +86,18 @@ size_t extract_data_field_from_sample(data_field_type const& data_field,
                                       CPUMat& X,
                                       size_t sample_idx);
 
+/** @brief Copies data from the field resolved by an accessor into the
+ *         Hydrogen matrix.
+ *
+ *  Same as the overload taking a data field identifier, but the
+ *  field's path is only parsed once when the accessor is built, so
+ *  the accessor should be reused across the samples of a mini-batch.
+ */
+size_t extract_data_field_from_sample(sample_field_accessor const& field,
+                                      conduit::Node const& sample,
+                                      CPUMat& X,
+                                      size_t sample_idx);
+
 } // namespace data_packer
 
 } // namespace lbann
@@ -46,6 +46,8 @@ public:
 public:
   /** Number of samples in the current mini-batch */
   uint64_t m_num_samples_fetched;
+  /** Length of the longest sample in the mini-batch (0 if unknown) */
+  uint64_t m_effective_sequence_length;
   /** Distributed matrix used to stage local data to layer output */
   std::map<data_field_type, std::unique_ptr<AbsDistMatrixType>> m_input_buffers;
   std::atomic<bool> m_fetch_data_in_background;
@@ -57,14 +59,17 @@ public:
   std::map<data_field_type, uint64_t> m_num_samples_per_field_distributed;
 
   data_buffer(lbann_comm* comm)
-    : m_num_samples_fetched(0), m_fetch_data_in_background(false)
+    : m_num_samples_fetched(0),
+      m_effective_sequence_length(0),
+      m_fetch_data_in_background(false)
   {
     m_input_buffers.clear();
     m_num_samples_per_field_distributed.clear();
   }
 
   data_buffer(const data_buffer& other)
-    : m_num_samples_fetched(other.m_num_samples_fetched)
+    : m_num_samples_fetched(other.m_num_samples_fetched),
+      m_effective_sequence_length(other.m_effective_sequence_length)
   {
     m_fetch_data_in_background.store(other.m_fetch_data_in_background);
     m_input_buffers.clear();
@@ -77,6 +82,7 @@ public:
   data_buffer& operator=(const data_buffer& other)
   {
     m_num_samples_fetched = other.m_num_samples_fetched;
+    m_effective_sequence_length = other.m_effective_sequence_length;
     m_fetch_data_in_background.store(other.m_fetch_data_in_background);
     m_input_buffers.clear();
     m_num_samples_per_field_distributed.clear();
@@ -30,6 +30,10 @@
 #define LBANN_DATA_READER_CSV_HPP
 
 #include "lbann/data_ingestion/data_reader.hpp"
+#include "lbann/utils/file_utils.hpp"
+
+#include <memory>
+#include <string_view>
 #include <unordered_map>
 
 namespace lbann {
@@ -39,6 +43,8 @@ namespace lbann {
  * This will parse a header to determine how many columns of data there are, and
  * will return each row split based on a separator. This does not handle quotes
  * or escape sequences. The label column is by default converted to an integer.
+ * The file is memory-mapped and rows are parsed in place, directly into the
+ * minibatch matrix.
  * @note This does not currently support comments or blank lines.
  */
 class csv_reader : public generic_data_reader
@@ -80,6 +86,22 @@ public:
   void set_skip_rows(int rows) { m_skip_rows = rows; }
   /// Set whether the CSV file has a header; default true.
   void set_has_header(bool b) { m_has_header = b; }
+  /**
+   * Keep the line index in a sidecar file (<data file>.lbidx) so that it is
+   * only built once. The index is memory-mapped on load and shared by all
+   * ranks on the node. It is rebuilt if the data file changes. Ranks that
+   * cannot see the file written by the master get the index by broadcast.
+   */
+  void set_persistent_index(bool b) { m_persistent_index = b; }
+  /**
+   * Convert the CSV file once into a binary cache (<data file>.lbcache) with
+   * the parsed labels, responses and data values, and read samples from the
+   * cache afterwards. The cache is rebuilt if the data file or the reader
+   * configuration changes. Custom column, label and response transforms are
+   * applied before caching, so the cache must be deleted if they change.
+   * Ranks that cannot see the cache parse the CSV file instead.
+   */
+  void set_binary_cache(bool b) { m_binary_cache = b; }
 
   /**
    * Supply a custom transform to convert an input string to a numerical value.
@@ -95,7 +117,8 @@ public:
 
   /**
    * Supply a custom transform to convert the label column to an integer.
-   * Note that the label should be an integer starting from 0.
+   * Note that the label should be an integer starting from 0. By default the
+   * label is parsed in place as a number.
    */
   void set_label_transform(std::function<int(const std::string&)> f)
   {
@@ -103,6 +126,7 @@ public:
   }
   /**
    * Supply a custom transform to convert the response column to a DataType.
+   * By default the response is parsed in place as a number.
    */
   void set_response_transform(std::function<DataType(const std::string&)> f)
   {
@@ -158,16 +182,52 @@ protected:
    */
   std::vector<DataType> fetch_line(uint64_t data_id);
 
-  /// Skip rows in an ifstream.
-  void skip_rows(std::ifstream& s, int rows);
+  /** Return a raw line from the CSV file, excluding the line terminator.
+   *  The view points into the memory-mapped file.
+   */
+  std::string_view fetch_raw_line(uint64_t data_id) const;
 
-  /// Initialize the ifstreams vector.
-  void setup_ifstreams();
+  /**
+   * Parse a line into @c out, writing at most @c capacity values.
+   * Skipped columns are omitted, as are the label and response columns if
+   * @c skip_label_response is set.
+   * @return The number of values written.
+   */
+  size_t parse_line(std::string_view line,
+                    DataType* out,
+                    size_t capacity,
+                    bool skip_label_response) const;
 
-  /** Return a raw line from the CSV file.
-   *  (Made public to support data store functionality)
+  /// Return the contents of column @c col of a line.
+  std::string_view get_column(std::string_view line, int col) const;
+  /// Convert the label column of a line.
+  int parse_label(std::string_view line) const;
+  /// Convert the response column of a line.
+  DataType parse_response(std::string_view line) const;
+
+  /**
+   * Scan the data file for the header and the start offset of each line.
+   * Stops after @c max_rows lines if it is non-negative.
    */
-  std::string fetch_raw_line(uint64_t data_id);
+  void build_index(int max_rows);
+  /// Map the sidecar index file if it matches the data file.
+  bool open_index_file(const std::string& path, const file::file_stamp& stamp);
+  /// Write the index to a sidecar file.
+  bool write_index_file(const std::string& path,
+                        const file::file_stamp& stamp) const;
+  /// Map the binary cache if it matches @c key.
+  bool open_binary_cache(const std::string& path,
+                         const std::vector<uint64_t>& key);
+  /// Convert the loaded CSV file into a binary cache.
+  bool write_binary_cache(const std::string& path,
+                          const std::vector<uint64_t>& key) const;
+  /// Key identifying the data file and configuration of a binary cache.
+  std::vector<uint64_t> get_binary_cache_key(const file::file_stamp& stamp,
+                                             int num_samples_to_use) const;
+  /// Offsets of the start of each line, plus the end of the last line.
+  const uint64_t* get_line_offsets() const;
+  /// Number of lines in the line index.
+  int get_num_indexed_lines() const;
 
   /// String value that separates data.
   char m_separator = ',';
@@ -195,14 +255,28 @@ protected:
   int m_num_samples = 0;
   /// Number of label classes.
   int m_num_labels = 0;
-  /// Input file streams (per-thread).
-  std::vector<std::ifstream*> m_ifstreams;
+  /// Whether to keep the line index in a sidecar file.
+  bool m_persistent_index = false;
+  /// Whether to read samples from a binary cache.
+  bool m_binary_cache = false;
+  /// Memory-mapped data file, shared by all I/O threads and copies.
+  std::shared_ptr<const file::mapped_file> m_data_file;
+  /// Memory-mapped sidecar index, if used.
+  std::shared_ptr<const file::mapped_file> m_index_file;
+  /// Memory-mapped binary cache, if used.
+  std::shared_ptr<const file::mapped_file> m_cache_file;
+  /// Offset of the line offsets in the binary cache.
+  size_t m_cache_offsets_offset = 0;
+  /// Offset of the data values in the binary cache.
+  size_t m_cache_values_offset = 0;
+  /// Number of data values per sample in the binary cache.
+  size_t m_cache_row_width = 0;
   /**
    * Index mapping lines (samples) to their start offset within the file.
    * This excludes the header, but includes a final entry indicating the length
-   * of the file.
+   * of the file. Empty when the index is memory-mapped.
    */
-  std::vector<std::streampos> m_index;
+  std::vector<uint64_t> m_index;
   /// Store labels.
   std::vector<int> m_labels;
   /// Store responses.
@@ -210,12 +284,10 @@ protected:
   /// Per-column transformation functions.
   std::unordered_map<int, std::function<DataType(const std::string&)>>
     m_col_transforms;
-  /// Label transform function that converts to an int.
-  std::function<int(const std::string&)> m_label_transform =
-    [](const std::string& s) -> int { return std::stoi(s); };
-  /// Response transform function that converts to a DataType.
-  std::function<DataType(const std::string&)> m_response_transform =
-    [](const std::string& s) -> DataType { return std::stod(s); };
+  /// Label transform function that converts to an int (optional).
+  std::function<int(const std::string&)> m_label_transform;
+  /// Response transform function that converts to a DataType (optional).
+  std::function<DataType(const std::string&)> m_response_transform;
 };
 
 } // namespace lbann
@@ -39,11 +39,13 @@ public:
   python_dataset_reader(std::string dataset_path,
                         std::string module_dir,
                         uint64_t prefetch_factor,
-                        bool shuffle)
+                        bool shuffle,
+                        bool shared_memory_ring = false)
     : generic_data_reader(shuffle),
       m_dataset_path(dataset_path),
       m_module_dir(module_dir),
-      m_prefetch_factor(prefetch_factor)
+      m_prefetch_factor(prefetch_factor),
+      m_shared_memory_ring(shared_memory_ring)
   {}
   python_dataset_reader(const python_dataset_reader&) = default;
   python_dataset_reader& operator=(const python_dataset_reader&) = default;
@@ -89,12 +91,25 @@ private:
   void queue_epoch();
   void queue_samples(uint64_t samples_to_queue);
 
+  /** @brief Copy the next mini-batch out of the shared-memory ring.
+   *
+   *  Waits for the worker processes to finish writing the samples.
+   *  The GIL is only acquired to check for worker errors if the
+   *  wait is long.
+   */
+  void fetch_from_ring(std::map<data_field_type, CPUMat*>& input_buffers,
+                       uint64_t mb_size);
+  /** @brief Wait until a sample has been written into the ring. */
+  void wait_for_ring_slot(uint64_t sequence_number);
+
   /** @brief Path to the pickled dataset object. */
   std::string m_dataset_path;
   /** @brief Optional directory containing module with dataset definition. */
   std::string m_module_dir;
   /** @brief Number of samples to prefetch per worker. */
   int m_prefetch_factor;
+  /** @brief Whether workers write samples into a shared-memory ring. */
+  bool m_shared_memory_ring;
   /** @brief Number of I/O threads. */
   int m_num_io_threads;
   /** @brief The current dataset shuffled minibatch offset. */
@@ -124,6 +139,34 @@ private:
    */
   python::object m_data_reader;
 
+  /** @brief Indices of samples to queue, passed to Python as a flat
+   *  int64 buffer.
+   */
+  std::vector<int64_t> m_indices_to_queue;
+
+  /** @name Shared-memory ring
+   *
+   *  Each data field occupies a column-major matrix with one column
+   *  per ring slot. The ready flag of a slot holds one plus the
+   *  sequence number of the last sample written into it. Samples
+   *  are assigned to slots in the order they are queued, so the
+   *  sample with sequence number @c s lives in slot
+   *  <tt>s % m_ring_size</tt>.
+   */
+  ///@{
+  /** @brief Number of slots in the ring. */
+  uint64_t m_ring_size = 0;
+  /** @brief Number of samples queued into the ring. */
+  uint64_t m_ring_queued = 0;
+  /** @brief Number of samples copied out of the ring. */
+  uint64_t m_ring_consumed = 0;
+  /** @brief Ready flags, one per slot. */
+  int64_t* m_ring_flags = nullptr;
+  DataType* m_ring_samples = nullptr;
+  DataType* m_ring_labels = nullptr;
+  DataType* m_ring_responses = nullptr;
+  ///@}
+
 #ifdef LBANN_HAS_DISTCONV
   /** @brief Whether or not tensor needs shuffling for distconv. */
   bool m_tensor_shuffle_required = true;
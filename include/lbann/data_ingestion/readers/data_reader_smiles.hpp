@@ -90,6 +90,11 @@ public:
 
   void use_unused_index_set(execution_mode m) override;
 
+  /** Returns the encoded length of a sample, including the <bos> and
+   *  <eos> tokens; positions past it are filled with the pad token.
+   */
+  int get_sample_length(uint64_t data_id) const override;
+
   /** This method is for use during testing and development */
   void get_sample_origin(const size_t index_in,
                          std::string& filename_out,
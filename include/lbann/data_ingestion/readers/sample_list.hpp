@@ -38,6 +38,7 @@ namespace lbann {
 
 // Forward Declarations
 class lbann_comm;
+class binary_sample_list_file;
 
 static const std::string multi_sample_exclusion = "MULTI-SAMPLE_EXCLUSION";
 static const std::string multi_sample_inclusion = "MULTI-SAMPLE_INCLUSION";
@@ -135,6 +136,14 @@ public:
             const lbann_comm& comm,
             bool interleave);
 
+  /** Load the lines offset, offset+stride, ... of a binary sample list
+   *  (see binary_sample_list_file). Only the selected lines are read and
+   *  parsed.
+   */
+  void load_binary(const std::string& samplelist_file,
+                   size_t stride = 1,
+                   size_t offset = 0);
+
   /// Restore a sample list from a serialized string
   void load_from_string(const std::string& samplelist,
                         const lbann_comm& comm,
@@ -221,6 +230,15 @@ protected:
   virtual void
   read_sample_list(std::istream& istrm, size_t stride = 1, size_t offset = 0);
 
+  /// Parse one line of the body of a sample list, with trailing whitespace
+  /// removed
+  virtual void read_sample_line(const std::string& line);
+
+  /// Read the selected lines of the body of a binary sample list
+  virtual void read_binary_sample_list(const binary_sample_list_file& blist,
+                                       size_t stride,
+                                       size_t offset);
+
   /// Assign names to samples when there is only one sample per file without a
   /// name.
   virtual void assign_samples_name();
@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_DATA_READERS_SAMPLE_LIST_BINARY_HPP
+#define LBANN_DATA_READERS_SAMPLE_LIST_BINARY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+namespace lbann {
+
+/** @brief Read-only view of a binary sample list.
+ *
+ *  A binary sample list holds the same information as a text sample
+ *  list, but each line of the body (one per data file: the file name
+ *  followed by its sample names or ranges) is stored as a record that
+ *  is located through an offset table. Each rank can therefore map
+ *  the file and parse only the lines it loads, instead of scanning
+ *  the whole list or receiving it in a broadcast.
+ *
+ *  The records may be stored pre-partitioned for a given number of
+ *  ranks, with partition @c p holding lines @c p, @c p+P, @c p+2P,
+ *  ..., i.e. exactly the lines that an interleaved load assigns to
+ *  rank @c p. Loading with a matching stride then touches one
+ *  contiguous range of the file.
+ *
+ *  Layout (all integers are 64-bit in host byte order):
+ *  @verbatim
+ *  magic                      8 bytes, "LBSLBIN1"
+ *  header_size                text header of the sample list
+ *  header                     header_size bytes
+ *  num_records                number of body lines (data files)
+ *  num_partitions
+ *  partition_begin[num_partitions+1]  first record of each partition
+ *  record_offset[num_records+1]       byte offset of each record
+ *  record data
+ *  @endverbatim
+ *
+ *  Binary sample lists are generated from text sample lists with
+ *  @c convert_sample_list_to_binary, e.g. through
+ *  <tt>tools/partition_input_list --sample_list</tt>.
+ */
+class binary_sample_list_file
+{
+public:
+  /** @brief Map a binary sample list into memory. */
+  explicit binary_sample_list_file(const std::string& filename);
+  ~binary_sample_list_file();
+  binary_sample_list_file(const binary_sample_list_file&) = delete;
+  binary_sample_list_file& operator=(const binary_sample_list_file&) = delete;
+
+  /** @brief Whether a file starts with the binary sample list magic. */
+  static bool is_binary(const std::string& filename);
+
+  /** @brief Text header, as found at the top of a text sample list. */
+  std::string get_header() const;
+  /** @brief Number of body lines, i.e. data files. */
+  size_t get_num_records() const noexcept { return m_num_records; }
+  /** @brief Number of ranks the records are partitioned for. */
+  size_t get_num_partitions() const noexcept { return m_num_partitions; }
+
+  /** @brief Call @c f on the body lines @c offset, @c offset+stride,
+   *  ..., in that order.
+   */
+  void
+  for_each_record(size_t stride,
+                  size_t offset,
+                  const std::function<void(const std::string&)>& f) const;
+
+private:
+  /** @brief Validate the magic and locate the tables. */
+  void read_layout();
+  /** @brief Record that holds body line @c idx. */
+  std::string get_record(size_t idx) const;
+  /** @brief Record at storage position @c pos. */
+  std::string get_stored_record(size_t pos) const;
+  uint64_t read_u64(size_t pos) const;
+
+  std::string m_filename;
+  const char* m_data = nullptr;
+  size_t m_size = 0;
+  size_t m_header_size = 0;
+  size_t m_num_records = 0;
+  size_t m_num_partitions = 0;
+  /** @brief Byte positions of the tables and the record data. */
+  size_t m_partition_table = 0;
+  size_t m_offset_table = 0;
+  size_t m_record_data = 0;
+};
+
+/** @brief Convert a text sample list into a binary sample list.
+ *
+ *  @param text           Text sample list
+ *  @param out            Binary output stream
+ *  @param num_partitions Number of ranks (per trainer) to lay out the
+ *                        records for
+ */
+void convert_sample_list_to_binary(std::istream& text,
+                                   std::ostream& out,
+                                   size_t num_partitions = 1);
+
+} // namespace lbann
+
+#endif // LBANN_DATA_READERS_SAMPLE_LIST_BINARY_HPP
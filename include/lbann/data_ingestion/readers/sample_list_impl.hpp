@@ -44,6 +44,7 @@
 
 #include "lbann/comm_impl.hpp"
 #include "lbann/data_ingestion/readers/sample_list.hpp"
+#include "lbann/data_ingestion/readers/sample_list_binary.hpp"
 #include "lbann/utils/exception.hpp"
 #include "lbann/utils/file_utils.hpp"
 #include "lbann/utils/serialize.hpp"
@@ -359,6 +360,12 @@ inline void sample_list<sample_name_t>::load(const std::string& samplelist_file,
                                              const lbann_comm& comm,
                                              bool interleave)
 {
+  if (binary_sample_list_file::is_binary(samplelist_file)) {
+    const size_t stride = interleave ? comm.get_procs_per_trainer() : 1ul;
+    const size_t offset = interleave ? comm.get_rank_in_trainer() : 0ul;
+    load_binary(samplelist_file, stride, offset);
+    return;
+  }
   m_header.set_sample_list_name(samplelist_file);
   zstr::ifstream istrm(samplelist_file);
   // std::ifstream istrm(samplelist_file);
@@ -391,6 +398,30 @@ inline void sample_list<sample_name_t>::load(const sample_list_header& header,
   read_sample_list(istrm, stride, offset);
 }
 
+template <typename sample_name_t>
+inline void
+sample_list<sample_name_t>::load_binary(const std::string& samplelist_file,
+                                        size_t stride,
+                                        size_t offset)
+{
+  m_header.set_sample_list_name(samplelist_file);
+  binary_sample_list_file blist(samplelist_file);
+  std::istringstream header(blist.get_header());
+  read_header(header);
+  if (blist.get_num_records() != m_header.get_num_files()) {
+    LBANN_ERROR("binary sample list ",
+                samplelist_file,
+                " has ",
+                blist.get_num_records(),
+                " records, but its header lists ",
+                m_header.get_num_files(),
+                " files");
+  }
+
+  m_stride = stride;
+  read_binary_sample_list(blist, stride, offset);
+}
+
 template <typename sample_name_t>
 inline void
 sample_list<sample_name_t>::load_from_string(const std::string& samplelist,
@@ -506,25 +537,8 @@ inline void sample_list<sample_name_t>::read_sample_list(std::istream& istrm,
       continue;
     }
 
-    std::stringstream sstr(line.substr(
-      0,
-      end_of_str + 1)); // clear trailing spaces for accurate parsing
-    std::string filename;
-
-    sstr >> filename;
-
-    const std::string file_path =
-      add_delimiter(m_header.get_file_dir()) + filename;
-
-    if (filename.empty() ||
-        (m_check_data_file && !check_if_file_exists(file_path))) {
-      LBANN_ERROR("data file '", file_path, "' does not exist.");
-    }
-
-    const sample_file_id_t index = m_file_id_stats_map.size();
-    static const auto sn0 = uninitialized_sample_name<sample_name_t>();
-    m_sample_list.emplace_back(std::make_pair(index, sn0));
-    m_file_id_stats_map.emplace_back(filename);
+    // clear trailing spaces for accurate parsing
+    read_sample_line(line.substr(0, end_of_str + 1));
   }
 
   if (m_header.get_num_files() != cnt_files) {
@@ -542,6 +556,48 @@ inline void sample_list<sample_name_t>::read_sample_list(std::istream& istrm,
   }
 }
 
+template <typename sample_name_t>
+inline void
+sample_list<sample_name_t>::read_sample_line(const std::string& line)
+{
+  std::stringstream sstr(line);
+  std::string filename;
+
+  sstr >> filename;
+
+  const std::string file_path =
+    add_delimiter(m_header.get_file_dir()) + filename;
+
+  if (filename.empty() ||
+      (m_check_data_file && !check_if_file_exists(file_path))) {
+    LBANN_ERROR("data file '", file_path, "' does not exist.");
+  }
+
+  const sample_file_id_t index = m_file_id_stats_map.size();
+  static const auto sn0 = uninitialized_sample_name<sample_name_t>();
+  m_sample_list.emplace_back(std::make_pair(index, sn0));
+  m_file_id_stats_map.emplace_back(filename);
+}
+
+template <typename sample_name_t>
+inline void sample_list<sample_name_t>::read_binary_sample_list(
+  const binary_sample_list_file& blist,
+  size_t stride,
+  size_t offset)
+{
+  m_sample_list.reserve(m_header.get_sample_count() / stride + 1);
+  blist.for_each_record(stride, offset, [this](const std::string& line) {
+    read_sample_line(line);
+  });
+
+  if (stride == 1 && m_header.get_sample_count() != m_sample_list.size()) {
+    LBANN_ERROR(std::string("Sample list count ") +
+                std::to_string(m_header.get_sample_count()) +
+                std::string(" does not equal sample list size ") +
+                std::to_string(m_sample_list.size()));
+  }
+}
+
 template <typename sample_name_t>
 inline size_t
 sample_list<sample_name_t>::get_samples_per_file(std::istream& istrm,
@@ -164,11 +164,22 @@ protected:
                            size_t stride = 1,
                            size_t offset = 0);
 
+  /// read one line of the body of exclusive sample list
+  void read_exclusive_line(const std::string& line);
+
+  /// read one line of the body of inclusive sample list
+  void read_inclusive_line(const std::string& line);
+
   /// read the body of a sample list
   void read_sample_list(std::istream& istrm,
                         size_t stride = 1,
                         size_t offset = 0) override;
 
+  /// read the selected lines of the body of a binary sample list
+  void read_binary_sample_list(const binary_sample_list_file& blist,
+                               size_t stride,
+                               size_t offset) override;
+
   void assign_samples_name() override {}
 
   /// Get the number of total/included/excluded samples
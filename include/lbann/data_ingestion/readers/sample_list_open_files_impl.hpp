@@ -147,100 +147,107 @@ sample_list_open_files<sample_name_t, file_handle_t>::read_exclusive_list(
       continue;
     }
 
-    std::stringstream sstr(line.substr(
-      0,
-      end_of_str + 1)); // clear trailing spaces for accurate parsing
-    std::string filename;
-    size_t included_samples;
-    size_t excluded_samples;
-    std::unordered_set<std::string> excluded_sample_indices;
-
-    sstr >> filename >> included_samples >> excluded_samples;
-
-    const std::string file_path =
-      add_delimiter(m_header.get_file_dir()) + filename;
-
-    if (filename.empty() ||
-        (this->m_check_data_file && !check_if_file_exists(file_path))) {
-      LBANN_ERROR(std::string{} + " :: data file '" + file_path +
-                  "' does not exist.");
-    }
+    // clear trailing spaces for accurate parsing
+    read_exclusive_line(line.substr(0, end_of_str + 1));
+  }
 
-    excluded_sample_indices.reserve(excluded_samples);
+  if (m_header.get_num_files() != cnt_files) {
+    LBANN_ERROR(std::string("Sample list ") + m_header.get_sample_list_name() +
+                std::string(": number of files requested ") +
+                std::to_string(m_header.get_num_files()) +
+                std::string(" does not equal number of files loaded ") +
+                std::to_string(cnt_files));
+  }
 
-    while (!sstr.eof()) {
-      std::string index;
-      sstr >> index;
-      excluded_sample_indices.insert(index);
-    }
+  m_header.m_is_exclusive = false;
+}
 
-    if (excluded_sample_indices.size() != excluded_samples) {
-      LBANN_ERROR(std::string("Index file does not contain the correct number "
-                              "of excluded samples: expected ") +
-                  std::to_string(excluded_samples) +
-                  std::string(" exclusions but found ") +
-                  std::to_string(excluded_sample_indices.size()));
-    }
+template <typename sample_name_t, typename file_handle_t>
+inline void
+sample_list_open_files<sample_name_t, file_handle_t>::read_exclusive_line(
+  const std::string& line)
+{
+  std::stringstream sstr(line);
+  std::string filename;
+  size_t included_samples;
+  size_t excluded_samples;
+  std::unordered_set<std::string> excluded_sample_indices;
 
-    std::vector<std::string> sample_names;
-    file_handle_t file_hnd = get_bundled_sample_names(file_path,
-                                                      sample_names,
-                                                      included_samples,
-                                                      excluded_samples);
-    if (!is_file_handle_valid(file_hnd)) {
-      continue; // skipping the file
-    }
+  sstr >> filename >> included_samples >> excluded_samples;
 
-    if (m_file_map.count(filename) > 0) {
-      if (sample_names.size() != m_file_map[filename]) {
-        LBANN_ERROR(
-          std::string("The same file ") + filename +
-          " was opened multiple times and reported different sizes: " +
-          std::to_string(sample_names.size()) + " and " +
-          std::to_string(m_file_map[filename]));
-      }
-    }
-    else {
-      m_file_map[filename] = sample_names.size();
-    }
+  const std::string file_path =
+    add_delimiter(m_header.get_file_dir()) + filename;
 
-    sample_file_id_t index = m_file_id_stats_map.size();
-    m_file_id_stats_map.emplace_back(
-      std::make_tuple(filename,
-                      uninitialized_file_handle<file_handle_t>(),
-                      std::deque<std::pair<int, int>>{}));
-    set_files_handle(filename, file_hnd);
-
-    size_t valid_sample_count = 0u;
-    for (auto s : sample_names) {
-      std::unordered_set<std::string>::const_iterator found =
-        excluded_sample_indices.find(s);
-      if (found != excluded_sample_indices.cend()) {
-        continue;
-      }
-      this->m_sample_list.emplace_back(index,
-                                       to_sample_name_t<sample_name_t>(s));
-      valid_sample_count++;
-    }
+  if (filename.empty() ||
+      (this->m_check_data_file && !check_if_file_exists(file_path))) {
+    LBANN_ERROR(std::string{} + " :: data file '" + file_path +
+                "' does not exist.");
+  }
+
+  excluded_sample_indices.reserve(excluded_samples);
 
-    if (valid_sample_count != included_samples) {
-      LBANN_ERROR(std::string("Bundle file does not contain the correct number "
-                              "of included samples: expected ") +
-                  std::to_string(included_samples) +
-                  std::string(" samples, but found ") +
-                  std::to_string(valid_sample_count));
+  while (!sstr.eof()) {
+    std::string index;
+    sstr >> index;
+    excluded_sample_indices.insert(index);
+  }
+
+  if (excluded_sample_indices.size() != excluded_samples) {
+    LBANN_ERROR(std::string("Index file does not contain the correct number "
+                            "of excluded samples: expected ") +
+                std::to_string(excluded_samples) +
+                std::string(" exclusions but found ") +
+                std::to_string(excluded_sample_indices.size()));
+  }
+
+  std::vector<std::string> sample_names;
+  file_handle_t file_hnd = get_bundled_sample_names(file_path,
+                                                    sample_names,
+                                                    included_samples,
+                                                    excluded_samples);
+  if (!is_file_handle_valid(file_hnd)) {
+    return; // skipping the file
+  }
+
+  if (m_file_map.count(filename) > 0) {
+    if (sample_names.size() != m_file_map[filename]) {
+      LBANN_ERROR(
+        std::string("The same file ") + filename +
+        " was opened multiple times and reported different sizes: " +
+        std::to_string(sample_names.size()) + " and " +
+        std::to_string(m_file_map[filename]));
     }
   }
+  else {
+    m_file_map[filename] = sample_names.size();
+  }
 
-  if (m_header.get_num_files() != cnt_files) {
-    LBANN_ERROR(std::string("Sample list ") + m_header.get_sample_list_name() +
-                std::string(": number of files requested ") +
-                std::to_string(m_header.get_num_files()) +
-                std::string(" does not equal number of files loaded ") +
-                std::to_string(cnt_files));
+  sample_file_id_t index = m_file_id_stats_map.size();
+  m_file_id_stats_map.emplace_back(
+    std::make_tuple(filename,
+                    uninitialized_file_handle<file_handle_t>(),
+                    std::deque<std::pair<int, int>>{}));
+  set_files_handle(filename, file_hnd);
+
+  size_t valid_sample_count = 0u;
+  for (auto s : sample_names) {
+    std::unordered_set<std::string>::const_iterator found =
+      excluded_sample_indices.find(s);
+    if (found != excluded_sample_indices.cend()) {
+      continue;
+    }
+    this->m_sample_list.emplace_back(index,
+                                     to_sample_name_t<sample_name_t>(s));
+    valid_sample_count++;
   }
 
-  m_header.m_is_exclusive = false;
+  if (valid_sample_count != included_samples) {
+    LBANN_ERROR(std::string("Bundle file does not contain the correct number "
+                            "of included samples: expected ") +
+                std::to_string(included_samples) +
+                std::string(" samples, but found ") +
+                std::to_string(valid_sample_count));
+  }
 }
 
 template <typename sample_name_t, typename file_handle_t>
@@ -355,90 +362,97 @@ sample_list_open_files<sample_name_t, file_handle_t>::read_inclusive_list(
       continue;
     }
 
-    std::istringstream sstr(line.substr(
-      0,
-      end_of_str + 1)); // clear trailing spaces for accurate parsing
-    std::string filename;
-    size_t included_samples;
-    size_t excluded_samples = 0;
+    // clear trailing spaces for accurate parsing
+    read_inclusive_line(line.substr(0, end_of_str + 1));
+  }
 
-    sstr >> filename >> included_samples;
+  if (m_header.get_num_files() != cnt_files) {
+    LBANN_ERROR(std::string("Sample list number of files requested ") +
+                std::to_string(m_header.get_num_files()) +
+                std::string(" does not equal number of files loaded ") +
+                std::to_string(cnt_files));
+  }
+}
 
-    if (m_header.has_unused_sample_fields()) {
-      sstr >> excluded_samples;
-    }
+template <typename sample_name_t, typename file_handle_t>
+inline void
+sample_list_open_files<sample_name_t, file_handle_t>::read_inclusive_line(
+  const std::string& line)
+{
+  std::istringstream sstr(line);
+  std::string filename;
+  size_t included_samples;
+  size_t excluded_samples = 0;
 
-    const std::string file_path =
-      add_delimiter(m_header.get_file_dir()) + filename;
+  sstr >> filename >> included_samples;
 
-    if (filename.empty() ||
-        (this->m_check_data_file && !check_if_file_exists(file_path))) {
-      throw lbann_exception(std::string{} + __FILE__ + " " +
-                            std::to_string(__LINE__) + " :: data file '" +
-                            filename + "' does not exist.");
-    }
+  if (m_header.has_unused_sample_fields()) {
+    sstr >> excluded_samples;
+  }
 
-    file_handle_t file_hnd = open_file_handle(file_path);
-    if (this->m_check_data_file && !is_file_handle_valid(file_hnd)) {
-      continue; // skipping the file
-    }
+  const std::string file_path =
+    add_delimiter(m_header.get_file_dir()) + filename;
 
-    sample_file_id_t index = m_file_id_stats_map.size();
-    m_file_id_stats_map.emplace_back(
-      std::make_tuple(filename,
-                      uninitialized_file_handle<file_handle_t>(),
-                      std::deque<std::pair<int, int>>{}));
-    set_files_handle(filename, file_hnd);
+  if (filename.empty() ||
+      (this->m_check_data_file && !check_if_file_exists(file_path))) {
+    throw lbann_exception(std::string{} + __FILE__ + " " +
+                          std::to_string(__LINE__) + " :: data file '" +
+                          filename + "' does not exist.");
+  }
 
-    size_t valid_sample_count = 0u;
-    // #define VALIDATE_SAMPLE_LIST
-#ifdef VALIDATE_SAMPLE_LIST
-    std::vector<std::string> sample_names;
-#endif
-    if constexpr (std::is_integral_v<sample_name_t>) {
-      valid_sample_count = read_line_integral_type(sstr, index);
-    }
-    else {
-      valid_sample_count = read_line(sstr, index);
-    }
-    if (valid_sample_count != included_samples) {
-      LBANN_ERROR(
-        "Bundle file",
-        filename,
-        " does not contain the correct number of included samples: expected ",
-        included_samples,
-        " samples, but found ",
-        valid_sample_count);
-    }
+  file_handle_t file_hnd = open_file_handle(file_path);
+  if (this->m_check_data_file && !is_file_handle_valid(file_hnd)) {
+    return; // skipping the file
+  }
 
-    if (m_file_map.count(filename) > 0) {
-      if (valid_sample_count != m_file_map[filename]) {
-        LBANN_ERROR(
-          std::string("The same file ") + filename +
-          " was opened multiple times and reported different sizes: " +
-          std::to_string(valid_sample_count) + " and " +
-          std::to_string(m_file_map[filename]));
-      }
-    }
-    else {
-      m_file_map[filename] =
-        /*valid_sample_count*/ included_samples + excluded_samples;
-    }
+  sample_file_id_t index = m_file_id_stats_map.size();
+  m_file_id_stats_map.emplace_back(
+    std::make_tuple(filename,
+                    uninitialized_file_handle<file_handle_t>(),
+                    std::deque<std::pair<int, int>>{}));
+  set_files_handle(filename, file_hnd);
+
+  size_t valid_sample_count = 0u;
+  // #define VALIDATE_SAMPLE_LIST
 #ifdef VALIDATE_SAMPLE_LIST
-    validate_implicit_bundles_sample_names(file_path,
-                                           filename,
-                                           sample_names,
-                                           included_samples,
-                                           excluded_samples);
+  std::vector<std::string> sample_names;
 #endif
+  if constexpr (std::is_integral_v<sample_name_t>) {
+    valid_sample_count = read_line_integral_type(sstr, index);
+  }
+  else {
+    valid_sample_count = read_line(sstr, index);
+  }
+  if (valid_sample_count != included_samples) {
+    LBANN_ERROR(
+      "Bundle file",
+      filename,
+      " does not contain the correct number of included samples: expected ",
+      included_samples,
+      " samples, but found ",
+      valid_sample_count);
   }
 
-  if (m_header.get_num_files() != cnt_files) {
-    LBANN_ERROR(std::string("Sample list number of files requested ") +
-                std::to_string(m_header.get_num_files()) +
-                std::string(" does not equal number of files loaded ") +
-                std::to_string(cnt_files));
+  if (m_file_map.count(filename) > 0) {
+    if (valid_sample_count != m_file_map[filename]) {
+      LBANN_ERROR(
+        std::string("The same file ") + filename +
+        " was opened multiple times and reported different sizes: " +
+        std::to_string(valid_sample_count) + " and " +
+        std::to_string(m_file_map[filename]));
+    }
   }
+  else {
+    m_file_map[filename] =
+      /*valid_sample_count*/ included_samples + excluded_samples;
+  }
+#ifdef VALIDATE_SAMPLE_LIST
+  validate_implicit_bundles_sample_names(file_path,
+                                         filename,
+                                         sample_names,
+                                         included_samples,
+                                         excluded_samples);
+#endif
 }
 
 template <typename sample_name_t, typename file_handle_t>
@@ -456,6 +470,26 @@ sample_list_open_files<sample_name_t, file_handle_t>::read_sample_list(
   }
 }
 
+template <typename sample_name_t, typename file_handle_t>
+inline void
+sample_list_open_files<sample_name_t, file_handle_t>::read_binary_sample_list(
+  const binary_sample_list_file& blist,
+  size_t stride,
+  size_t offset)
+{
+  if (m_header.is_exclusive()) {
+    blist.for_each_record(stride, offset, [this](const std::string& line) {
+      read_exclusive_line(line);
+    });
+    m_header.m_is_exclusive = false;
+  }
+  else {
+    blist.for_each_record(stride, offset, [this](const std::string& line) {
+      read_inclusive_line(line);
+    });
+  }
+}
+
 template <typename sample_name_t, typename file_handle_t>
 template <class Archive>
 void sample_list_open_files<sample_name_t, file_handle_t>::save(
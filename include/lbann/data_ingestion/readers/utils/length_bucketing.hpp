@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_DATA_INGESTION_LENGTH_BUCKETING_HPP_INCLUDED
+#define LBANN_DATA_INGESTION_LENGTH_BUCKETING_HPP_INCLUDED
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace lbann {
+
+/** @brief Reorder a shuffled index list so that each mini-batch holds
+ *  samples of similar length.
+ *
+ *  The full mini-batches of the list are grouped into pools of
+ *  @c pool_size mini-batches. Each pool is stably sorted by sample
+ *  length and cut back into mini-batches, and the order of all full
+ *  mini-batches is then shuffled. Every index is still visited
+ *  exactly once, and since the input is already shuffled the
+ *  composition of the mini-batches remains random. A trailing partial
+ *  mini-batch is left at the end of the list so that mini-batch
+ *  boundaries match the ones used by the data coordinator.
+ *
+ *  @param indices          Shuffled sample indices, reordered in place.
+ *  @param get_length       Returns the sequence length of a sample.
+ *  @param mini_batch_size  Number of samples per mini-batch.
+ *  @param pool_size        Number of mini-batches sorted together.
+ *  @param gen              Random number generator.
+ */
+template <typename LengthFunction, typename Generator>
+void bucket_indices_by_length(std::vector<uint64_t>& indices,
+                              LengthFunction const& get_length,
+                              size_t mini_batch_size,
+                              size_t pool_size,
+                              Generator& gen)
+{
+  if (mini_batch_size < 2 || pool_size == 0) {
+    return;
+  }
+  const size_t num_batches = indices.size() / mini_batch_size;
+  if (num_batches == 0) {
+    return;
+  }
+  const size_t num_samples = num_batches * mini_batch_size;
+
+  // Query the lengths once so the sort does not call back into the
+  // data reader
+  std::vector<std::pair<int, uint64_t>> keyed;
+  keyed.reserve(num_samples);
+  for (size_t i = 0; i < num_samples; ++i) {
+    keyed.emplace_back(get_length(indices[i]), indices[i]);
+  }
+
+  // Sort each pool by length
+  const size_t pool_samples = pool_size * mini_batch_size;
+  for (size_t begin = 0; begin < num_samples; begin += pool_samples) {
+    const size_t end = std::min(begin + pool_samples, num_samples);
+    std::stable_sort(keyed.begin() + begin,
+                     keyed.begin() + end,
+                     [](const auto& a, const auto& b) {
+                       return a.first < b.first;
+                     });
+  }
+
+  // Shuffle the order of the mini-batches
+  std::vector<size_t> batch_order(num_batches);
+  std::iota(batch_order.begin(), batch_order.end(), size_t{0});
+  std::shuffle(batch_order.begin(), batch_order.end(), gen);
+  for (size_t b = 0; b < num_batches; ++b) {
+    const auto* src = keyed.data() + batch_order[b] * mini_batch_size;
+    for (size_t k = 0; k < mini_batch_size; ++k) {
+      indices[b * mini_batch_size + k] = src[k].second;
+    }
+  }
+}
+
+} // namespace lbann
+
+#endif // LBANN_DATA_INGESTION_LENGTH_BUCKETING_HPP_INCLUDED
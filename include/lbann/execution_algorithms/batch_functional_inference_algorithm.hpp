@@ -104,6 +104,13 @@ public:
     // Explicitly set the size of the mini-batch that the model is executing
     model->set_current_mini_batch_size(mbs);
 
+    // Predictions are read from the softmax layer after forward prop
+    for (auto* l : model->get_layers()) {
+      if (l->get_type() == "softmax") {
+        l->set_keep_activations(true);
+      }
+    }
+
     // Infer on mini batches
     for (size_t i = 0; i < samples_size; i += mbs) {
       size_t mb_idx = std::min(i + mbs, samples_size);
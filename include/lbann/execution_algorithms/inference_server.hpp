@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef LBANN_EXECUTION_ALGORITHMS_INFERENCE_SERVER_HPP_INCLUDED
+#define LBANN_EXECUTION_ALGORITHMS_INFERENCE_SERVER_HPP_INCLUDED
+
+#include "lbann/base.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lbann {
+
+// Forward declarations
+class model;
+template <typename TensorDataType>
+class data_type_layer;
+
+/** @brief In-process inference server with dynamic batching.
+ *
+ *  Samples are submitted one at a time and their outputs are returned
+ *  through futures. A batching thread coalesces pending requests into
+ *  mini-batches: a mini-batch is launched as soon as it holds
+ *  @c max_batch_size samples, or when its oldest sample has waited
+ *  for @c max_delay. An execution thread runs forward propagation on
+ *  the model. There are two staging buffers, so the next mini-batch
+ *  is packed while the current one is being computed.
+ *
+ *  The model must have a single input layer and must have been set
+ *  up with a max mini-batch size of at least @c max_batch_size. Once
+ *  the server is constructed, the model must not be used by anything
+ *  else until the server is destroyed. Only trainers with a single
+ *  process are supported, since requests are local to a process.
+ */
+class inference_server
+{
+public:
+  /** @brief A sample, flattened in the input layer's layout. */
+  using sample_type = std::vector<DataType>;
+  /** @brief The output layer's activations for a sample. */
+  using output_type = std::vector<DataType>;
+
+  /** @brief Counters describing the batches executed so far. */
+  struct statistics
+  {
+    size_t num_requests = 0;
+    size_t num_batches = 0;
+  };
+
+  /** @brief Start serving a model.
+   *
+   *  @param m              Model to run. Must be set up.
+   *  @param max_batch_size Largest mini-batch to execute.
+   *  @param max_delay      Longest time a request may wait for more
+   *                        requests to join its mini-batch.
+   *  @param output_layer   Name of the layer whose activations are
+   *                        returned. Defaults to the last layer that
+   *                        is not a dummy layer.
+   */
+  inference_server(observer_ptr<model> m,
+                   size_t max_batch_size,
+                   std::chrono::microseconds max_delay,
+                   std::string const& output_layer = "");
+  /** @brief Finish all pending requests and stop the server. */
+  ~inference_server();
+
+  inference_server(inference_server const&) = delete;
+  inference_server& operator=(inference_server const&) = delete;
+
+  /** @brief Submit a sample for inference.
+   *
+   *  Thread-safe. Errors raised while computing the mini-batch are
+   *  reported through the returned future.
+   */
+  std::future<output_type> submit(sample_type sample);
+
+  /** @brief Finish all pending requests and stop the server threads.
+   *  Further submissions raise an exception.
+   */
+  void stop();
+
+  /** @brief Size of a flattened input sample. */
+  El::Int get_sample_size() const noexcept { return m_sample_size; }
+  /** @brief Size of a flattened output. */
+  El::Int get_output_size() const noexcept { return m_output_size; }
+  size_t get_max_batch_size() const noexcept { return m_max_batch_size; }
+  std::chrono::microseconds get_max_delay() const noexcept
+  {
+    return m_max_delay;
+  }
+  statistics get_statistics() const;
+
+private:
+  using clock_type = std::chrono::steady_clock;
+  using buffer_type =
+    El::DistMatrix<DataType, El::STAR, El::STAR, El::ELEMENT, El::Device::CPU>;
+
+  struct request
+  {
+    sample_type sample;
+    std::promise<output_type> result;
+    clock_type::time_point arrival;
+  };
+
+  struct batch
+  {
+    std::unique_ptr<buffer_type> samples;
+    std::vector<std::promise<output_type>> results;
+  };
+
+  /** @brief Body of the batching thread. */
+  void batch_loop();
+  /** @brief Body of the execution thread. */
+  void execute_loop();
+  /** @brief Run forward propagation and fulfill a batch's promises. */
+  void execute(batch& b);
+
+  model& m_model;
+  /** @brief Copies a mini-batch into the model's input layer. */
+  std::function<void(El::AbstractDistMatrix<DataType> const&)> m_set_samples;
+  data_type_layer<DataType> const* m_output_layer;
+  El::Int m_sample_size;
+  El::Int m_output_size;
+  size_t m_max_batch_size;
+  std::chrono::microseconds m_max_delay;
+
+  /** @brief Requests waiting to be batched. */
+  std::deque<request> m_requests;
+  bool m_stopping = false;
+  std::mutex m_request_mutex;
+  std::condition_variable m_request_cv;
+
+  /** @brief Packed mini-batches waiting to be executed. */
+  std::deque<batch> m_batches;
+  /** @brief Staging buffers that are not in use. */
+  std::vector<std::unique_ptr<buffer_type>> m_free_buffers;
+  bool m_batching_done = false;
+  statistics m_statistics;
+  mutable std::mutex m_batch_mutex;
+  std::condition_variable m_batch_cv;
+
+  std::thread m_batch_thread;
+  std::thread m_execute_thread;
+};
+
+} // namespace lbann
+
+#endif // LBANN_EXECUTION_ALGORITHMS_INFERENCE_SERVER_HPP_INCLUDED
@@ -35,6 +35,7 @@
 #include "lbann/utils/cloneable.hpp"
 #include "lbann/utils/make_abstract.hpp"
 
+#include <future>
 #include <google/protobuf/message.h>
 #include <memory>
 
@@ -91,7 +92,9 @@ public:
        bool distribute_precondition_compute,
        bool use_eigen_decomposition,
        bool enable_copy_errors,
-       bool enable_copy_activations);
+       bool enable_copy_activations,
+       size_t max_inverse_staleness = 0,
+       bool refine_inverse_placement = false);
 
   ~KFAC() noexcept = default;
   KFAC(KFAC const& other) = delete;
@@ -201,6 +204,35 @@ private:
   void allgather_precondition_gradient(lbann_comm& comm,
                                        ExeContextType& context);
 
+  /** @brief Compute the inverse of one block's Kronecker factors and
+   *  record the time it took. */
+  void update_block_inverse(ExeContextType& context,
+                            size_t block_index,
+                            lbann_comm& comm,
+                            double damping_act,
+                            double damping_err,
+                            double damping_bn_act,
+                            double damping_bn_err);
+
+  /** @brief Reassign blocks to processes for the balanced inverse
+   *  strategy, from estimated costs on the first update and from
+   *  measured times once if refinement is enabled. */
+  void update_inverse_proc_ranks(ExeContextType& context, lbann_comm& comm);
+
+  /** @brief Allgather the inverses computed by each process. */
+  void allgather_inverses(ExeContextType& context, lbann_comm& comm);
+
+  /** @brief Launch the inverse computation on a background thread.
+   *  Preconditioning keeps using the published inverses until
+   *  finish_async_inverse is called. */
+  void start_async_inverse(ExeContextType& context,
+                           lbann_comm& comm,
+                           size_t step);
+
+  /** @brief Wait for the background inverse computation, publish the
+   *  new inverses and allgather them. */
+  void finish_async_inverse(ExeContextType& context, lbann_comm& comm);
+
   /** @brief The KFAC stopping criteria. */
   std::unique_ptr<TermCriteriaType> m_stopping_criteria;
 
@@ -235,6 +267,20 @@ private:
   /** @brief Assignment strategy for the model-parallel part. */
   kfac::kfac_inverse_strategy m_inverse_strategy;
 
+  /** @brief Whether the balanced strategy refines its placement with
+   *  measured inverse times. */
+  bool m_refine_inverse_placement;
+
+  /** @brief Whether the placement has been refined already. */
+  bool m_inverse_placement_refined = false;
+
+  /** @brief Number of Kronecker factor updates so far. */
+  size_t m_num_inverse_updates = 0;
+
+  /** @brief Time of the latest inverse update of each block (us).
+   *  Only valid for the blocks owned by this process. */
+  std::vector<double> m_inverse_block_times;
+
   /** @brief List of layers to be ignored by the callback. */
   std::vector<std::string> m_disable_layers;
 
@@ -261,6 +307,23 @@ private:
   /** @brief use eigen value decomposition for inversing the matrix. */
   bool m_use_eigen_decomposition;
 
+  /** @brief Maximum number of steps that gradients may be
+   *  preconditioned with stale inverses while new ones are computed
+   *  in the background. Zero computes inverses synchronously. */
+  size_t m_max_inverse_staleness;
+
+  /** @brief Pending background inverse computation. */
+  std::future<void> m_inverse_future;
+
+  /** @brief Step at which the pending inverse computation started. */
+  size_t m_inverse_launch_step = 0;
+
+  /** @brief Background inverse statistics: number of computations,
+   *  number that were not finished when their inverses were needed
+   *  and the time spent waiting for them (us). */
+  size_t m_num_async_inverses = 0, m_num_blocked_async_inverses = 0;
+  int m_time_span_inverse_wait = 0;
+
   El::Matrix<double, El::Device::CPU> m_inverse_matrices_size;
 
   int m_global_inverse_buffer_size = 0, m_weight_matrices_buffer_size = 0;
@@ -274,7 +337,7 @@ private:
       m_time_span_forward_comm = 0, m_time_span_forward_comm_end = 0,
       m_time_span_backward_comm = 0, m_time_span_backward_comm_end = 0,
       m_time_span_precond_comm = 0, m_time_forward_pass = 0,
-      m_time_backward_pass = 0, m_time_kfac = 0;
+      m_time_backward_pass = 0, m_time_kfac = 0, m_time_span_inverse = 0;
 
   std::vector<bool> m_use_KFAC_epoch;
 
@@ -31,6 +31,7 @@
 #include "lbann/execution_algorithms/kfac/kfac_util.hpp"
 #include "lbann/execution_algorithms/sgd_execution_context.hpp"
 #include <memory>
+#include <mutex>
 #include <string>
 
 // Forward declarations
@@ -130,6 +131,10 @@ private:
   /** @brief Workspace matrices that are used by m_blocks. */
   std::unordered_map<std::string, El::Matrix<DataType, Device>> m_workspace;
 
+  /** @brief Guards m_workspace against concurrent lookups from
+   *  background inverse updates. */
+  std::mutex m_workspace_mutex;
+
 }; // class ExecutionContext
 
 } // namespace kfac
@@ -30,6 +30,8 @@
 #include "lbann/execution_algorithms/kfac/execution_context.hpp"
 #include "lbann/layers/layer.hpp"
 
+#include <unordered_map>
+
 namespace lbann {
 
 // Forward declaration
@@ -98,6 +100,10 @@ public:
                                         bool print_matrix,
                                         bool print_matrix_summary);
 
+  /** @brief Estimated relative cost of update_kronecker_inverse.
+   *  Only valid once the average Kronecker factors are available. */
+  virtual double get_inverse_cost() const;
+
   /** @brief Compute the inverse of the average Kronecker factors. */
   virtual void update_kronecker_inverse(lbann_comm* comm,
                                         bool use_pi,
@@ -155,6 +161,18 @@ public:
 
   void set_current_batch_size(El::Int batch_size) { m_batch_size = batch_size; }
 
+  /** @brief Redirect inverse updates to staging matrices.
+   *
+   *  While staging is enabled, update_kronecker_inverse writes into
+   *  private copies of the inverse matrices so that
+   *  compute_preconditioned_gradients may keep using the published
+   *  inverses concurrently.
+   */
+  void set_stage_inverse_updates(bool stage) { m_stage_inverse_updates = stage; }
+
+  /** @brief Copy staged inverse matrices into the published ones. */
+  void publish_staged_inverses();
+
   /** @brief Get block's information in one line. */
   virtual std::string get_info() const
   {
@@ -169,6 +187,8 @@ public:
 
   size_t get_inverse_proc_rank() const { return m_inverse_proc_rank; }
 
+  void set_inverse_proc_rank(size_t rank) { m_inverse_proc_rank = rank; }
+
   DataType* get_local_activation_buffer(int index)
   {
     return m_parent_local_activations[index]->Buffer();
@@ -210,6 +230,11 @@ protected:
   /** @brief Return the default sync info that may used in update functions. */
   El::SyncInfo<Device> get_sync_info();
 
+  /** @brief Get the matrix an inverse update should be written to.
+   *  This is @c inverse itself unless inverse updates are staged. */
+  El::Matrix<DataType, Device>&
+  get_inverse_update_target(El::Matrix<DataType, Device>& inverse);
+
   /** @brief The target layer. */
   Layer* m_layer;
 
@@ -218,7 +243,7 @@ protected:
   const size_t m_layer_id;
 
   /** @brief The process ID which perform inverse on Kronecker. */
-  const int m_inverse_proc_rank;
+  int m_inverse_proc_rank;
 
   /** @brief distributed martices for activations and gradients. */
   std::vector<std::unique_ptr<AbsDistMat>> m_parent_local_activations,
@@ -245,10 +270,25 @@ protected:
   /** @brief Whether this block already has an inverse history. */
   bool m_has_kronecker_inverse;
 
+  /** @brief Whether this block already has average Kronecker factors.
+   *
+   *  Averages are kept on every process, so a process that takes over
+   *  the inverse of this block continues the running average.
+   */
+  bool m_has_kronecker_average = false;
+
 private:
   /** @brief The execution context that created this block.
    *  TODO: Use its own workspace and remove this pointer. */
   kfac::KFACExecutionContext* m_context;
+
+  /** @brief Whether inverse updates are written to staging matrices. */
+  bool m_stage_inverse_updates = false;
+
+  /** @brief Staged inverse matrices, keyed by the published matrix. */
+  std::unordered_map<El::Matrix<DataType, Device>*,
+                     El::Matrix<DataType, Device>>
+    m_staged_inverses;
 };
 
 } // namespace lbann
@@ -122,6 +122,11 @@ public:
     return total_size;
   }
 
+  double get_inverse_cost() const override
+  {
+    return kfac::get_inverse_cost(m_fisher_average.Height());
+  }
+
   void compute_local_kronecker_factors(lbann_comm* comm,
                                        bool print_matrix,
                                        bool print_matrix_summary) override;
@@ -82,6 +82,12 @@ public:
     return total_size;
   }
 
+  double get_inverse_cost() const final
+  {
+    return kfac::get_inverse_cost(m_kronecker_average_A.Height()) +
+           kfac::get_inverse_cost(m_kronecker_average_G.Height());
+  }
+
   void compute_local_kronecker_factors(lbann_comm* comm,
                                        bool print_matrix,
                                        bool print_matrix_summary) final;
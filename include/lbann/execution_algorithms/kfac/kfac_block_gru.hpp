@@ -159,6 +159,15 @@ public:
     return -1;
   }
 
+  double get_inverse_cost() const override
+  {
+    double cost = kfac::get_inverse_cost(m_kronecker_average_A_h.Height()) +
+                  kfac::get_inverse_cost(m_kronecker_average_A_x.Height());
+    for (const auto& kv : m_kronecker_average_G)
+      cost += kfac::get_inverse_cost(kv.second.Height());
+    return cost;
+  }
+
   void compute_local_kronecker_factors(lbann_comm* comm,
                                        bool print_matrix,
                                        bool print_matrix_summary) override;
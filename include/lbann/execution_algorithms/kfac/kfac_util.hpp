@@ -62,6 +62,8 @@ enum class kfac_inverse_strategy
   EACH, // Apply round-robin assingment to every type of layers. may
   // not work well for small networks.
   ROOT, // Use only the root GPU. This is only for testing.
+  BALANCED, // Assign layers by longest-processing-time bin packing of their
+            // estimated inverse cost.
 };
 
 enum class kfac_reduce_scatter_mode
@@ -78,6 +80,21 @@ enum class kfac_allgather_mode
   BROADCAST  // Use El::Broadcast for each block
 };
 
+/** @brief Estimated cost of inverting a square matrix of the given
+ *  height. Cholesky and eigen decompositions are both cubic. **/
+inline double get_inverse_cost(El::Int height)
+{
+  const double n = height;
+  return n * n * n;
+}
+
+/** @brief Assign blocks to processes with the longest-processing-time
+ *  heuristic: blocks are visited in order of decreasing cost and each
+ *  one is placed on the least loaded process. Ties are broken by
+ *  index, so every process computes the same assignment. **/
+std::vector<size_t> assign_inverse_proc_ranks(const std::vector<double>& costs,
+                                              size_t num_procs);
+
 /** @brief Gets the inverse matrix of A. **/
 template <El::Device Device>
 void get_matrix_inverse(El::AbstractMatrix<DataType>& Ainv,
@@ -36,6 +36,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace lbann {
 namespace ltfb {
@@ -97,6 +98,38 @@ public:
     // Better API, but complicates "sendrecv_weights":
     // virtual std::unique_ptr<model> get_partner_model(
     //   lbann_comm const& c, El::Int partner_trainer);
+
+    /** @brief Whether the strategy can exchange weights in place.
+     *
+     *  Strategies that return true implement start_weights_exchange(),
+     *  finish_weights_exchange() and restore_local_weights(), which
+     *  let the tournament evaluate the partner weights inside the
+     *  local model instead of a full model copy.
+     */
+    virtual bool supports_in_place_exchange() const noexcept { return false; }
+
+    /** @brief Start sending the local weights to the partner trainer.
+     *
+     *  The local weights values are captured when this is called and
+     *  are not modified until finish_weights_exchange(), so the
+     *  local model can be evaluated while the transfer is in flight.
+     *
+     *  @param[in] m The local model.
+     *  @param[in] partner_trainer The ID of the partner trainer.
+     *  @param[in] step The LTFB step ID.
+     */
+    virtual void
+    start_weights_exchange(model& m, El::Int partner_trainer, size_t step);
+
+    /** @brief Replace the local weights values with the partner's.
+     *  @details Completes the transfer begun by
+     *           start_weights_exchange().
+     */
+    virtual void finish_weights_exchange(model& m);
+
+    /** @brief Undo the last call to finish_weights_exchange(). */
+    virtual void restore_local_weights(model& m);
+
   protected:
     /** @brief Access weights_names. */
     std::set<std::string> const& weights_names() const noexcept
@@ -125,11 +158,14 @@ public:
    *             of a tournament.
    *  @param[in] comm_algo Algorithm for exchanging models.
    *  @param[in] mutate_algo Algorithm for mutating models.
+   *  @param[in] paired_evaluation Evaluate the local and partner
+   *             models in a single pass over the tournament data.
    */
   RandomPairwiseExchange(std::string metric_name,
                          metric_strategy winner_strategy,
                          std::unique_ptr<ExchangeStrategy> comm_algo,
-                         std::unique_ptr<MutationStrategy> mutate_algo);
+                         std::unique_ptr<MutationStrategy> mutate_algo,
+                         bool paired_evaluation = false);
 
   /** @brief Constructor
    *  @param[in] metrics The list of metric/strategy pairs. A metric
@@ -139,11 +175,14 @@ public:
    *             declared the winner.
    *  @param[in] comm_algo Algorithm for exchanging models.
    *  @param[in] mutate_algo Algorithm for mutating models.
+   *  @param[in] paired_evaluation Evaluate the local and partner
+   *             models in a single pass over the tournament data.
    */
   RandomPairwiseExchange(
     std::unordered_map<std::string, metric_strategy> metrics,
     std::unique_ptr<ExchangeStrategy> comm_algo,
-    std::unique_ptr<MutationStrategy> mutate_algo);
+    std::unique_ptr<MutationStrategy> mutate_algo,
+    bool paired_evaluation = false);
 
   ~RandomPairwiseExchange() = default;
   RandomPairwiseExchange(RandomPairwiseExchange const& other);
@@ -168,6 +207,16 @@ private:
   evaluate_model(model& m,
                  LTFBExecutionContext& ctxt,
                  data_coordinator& dc) const;
+  /** @brief Get the metric values from several models.
+   *
+   *  The models are evaluated in a single pass over the tournament
+   *  data set, i.e. each mini-batch is loaded once and forward
+   *  propagated through every model.
+   */
+  std::vector<std::unordered_map<std::string, EvalType>>
+  evaluate_models(std::vector<model*> const& models,
+                  LTFBExecutionContext& ctxt,
+                  data_coordinator& dc) const;
   /** @brief Generate a new trainer partner from the comm. */
   int get_partner_trainer(lbann_comm const& c) const noexcept;
   /** @brief Evaluate the output of two models according to the input
@@ -211,6 +260,13 @@ private:
    */
   std::unique_ptr<MutationStrategy> m_mutate_algo;
 
+  /** @brief Evaluate both candidates in a single data pass.
+   *
+   *  This shares the tournament I/O between the two models at the
+   *  cost of holding a copy of the partner model.
+   */
+  bool m_paired_evaluation;
+
 }; // class RandomPairwiseExchange
 
 /** @class SendRecvWeights
@@ -254,6 +310,96 @@ private:
   bool exchange_hyperparams_;
 }; // class SendRecvWeights
 
+/** @class PackedSendRecvWeights
+ *  @brief Exchange model weights in place through a packed buffer.
+ *
+ *  The values of the selected weights (and, optionally, the SGD
+ *  velocity or the Adam moments and bias-correction products) are
+ *  packed into one contiguous buffer that is streamed to the partner
+ *  trainer in chunks with non-blocking sends and receives. The
+ *  packed local values double as a shadow copy, so the partner can
+ *  be evaluated in the local model and the local values restored if
+ *  the local model wins. No model copy is made on this path. The
+ *  transfer is started before the local model is evaluated, so it
+ *  overlaps with the local evaluation.
+ *
+ *  Like SendRecvWeights, this assumes that the exchanged weights
+ *  appear in the same order and with the same distributions in both
+ *  trainers. All exchanged weights must have the default data type.
+ */
+class PackedSendRecvWeights final
+  : public Cloneable<PackedSendRecvWeights,
+                     RandomPairwiseExchange::ExchangeStrategy>
+{
+  using BaseType = Cloneable<PackedSendRecvWeights,
+                             RandomPairwiseExchange::ExchangeStrategy>;
+
+public:
+  /** @brief Construct from weights names
+   *  @param[in] weights_names Names of weights to exchange. If empty,
+   *                           then all weights are exchanged.
+   *  @param[in] exchange_optimizer_state Also exchange SGD velocity
+   *                                      and Adam moments and
+   *                                      bias-correction products.
+   *  @param[in] chunk_size Maximum number of entries per message. If
+   *                        zero, a default is used. Must fit in an
+   *                        int.
+   */
+  PackedSendRecvWeights(std::set<std::string> weights_names,
+                        bool exchange_optimizer_state,
+                        size_t chunk_size);
+
+  std::unique_ptr<model> get_partner_model(model const& m,
+                                           El::Int partner_trainer,
+                                           size_t step) final;
+
+  bool supports_in_place_exchange() const noexcept final { return true; }
+  void start_weights_exchange(model& m,
+                              El::Int partner_trainer,
+                              size_t step) final;
+  void finish_weights_exchange(model& m) final;
+  void restore_local_weights(model& m) final;
+
+private:
+  using BufferType = El::Matrix<DataType, El::Device::CPU>;
+
+  /** @brief Agree with the partner on which optimizer states to send. */
+  void negotiate_optimizer_state(model& m,
+                                 lbann_comm const& comm,
+                                 El::Int partner_trainer);
+  /** @brief Local state to exchange, in packing order. */
+  struct ExchangeState
+  {
+    /** @brief Weights values and optimizer state matrices. */
+    std::vector<El::AbstractMatrix<DataType>*> matrices;
+    /** @brief Optimizers whose scalar state is packed after the
+     *         matrices. */
+    std::vector<optimizer*> optimizers;
+  };
+
+  ExchangeState get_exchange_state(model& m);
+  /** @brief Number of buffer entries needed for a state. */
+  static El::Int get_packed_size(ExchangeState const& state);
+  /** @brief Copy local state into a buffer. */
+  static void pack(ExchangeState const& state, BufferType& buffer);
+  /** @brief Copy a buffer into local state. */
+  static void unpack(BufferType const& buffer, ExchangeState const& state);
+
+private:
+  bool m_exchange_optimizer_state;
+  size_t m_chunk_size;
+  /** @brief Packed values of the local model (the shadow copy). */
+  BufferType m_local_buffer;
+  /** @brief Packed values received from the partner trainer. */
+  BufferType m_partner_buffer;
+  /** @brief Outstanding chunk sends and receives. */
+  std::vector<El::mpi::Request<DataType>> m_requests;
+  /** @brief Whether optimizer state is exchanged, per weights. */
+  std::vector<bool> m_with_optimizer_state;
+  /** @brief Whether m_local_buffer holds values to restore. */
+  bool m_has_shadow = false;
+}; // class PackedSendRecvWeights
+
 /// See @c lbann::callbacks::ltfb::communication_algorithm::checkpoint_file
 class CheckpointFile final
   : public Cloneable<CheckpointFile, RandomPairwiseExchange::ExchangeStrategy>
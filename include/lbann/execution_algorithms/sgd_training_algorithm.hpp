@@ -91,6 +91,16 @@ public:
                 execution_mode mode,
                 SGDTerminationCriteria const& term);
 
+  /** Evaluate several models in a single pass over the data set.
+   *  Each mini-batch is fetched once and forward propagated through
+   *  every model.
+   */
+  void evaluate(SGDExecutionContext& c,
+                std::vector<observer_ptr<model>> const& models,
+                data_coordinator& dc,
+                execution_mode mode,
+                SGDTerminationCriteria const& term);
+
   /** @brief Get a default-initialized execution context.
    *  @note This method participates in the
    *        "covariant-smart-pointer-return" pattern. In particular,
@@ -106,9 +116,9 @@ protected:
                         data_coordinator& dc,
                         ScopeTimer timer);
 
-  /** Evaluate model on one step / mini-batch of an SGD forward pass */
+  /** Evaluate models on one step / mini-batch of an SGD forward pass */
   bool evaluate_mini_batch(SGDExecutionContext& c,
-                           model& model,
+                           std::vector<observer_ptr<model>> const& models,
                            data_coordinator& dc,
                            execution_mode mode,
                            ScopeTimer timer);
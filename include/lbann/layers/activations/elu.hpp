@@ -62,6 +62,7 @@ public:
   data_layout get_data_layout() const override { return Layout; }
   El::Device get_device_allocation() const override { return Device; }
   bool can_run_inplace() const override { return true; }
+  bool supports_strided_tensors() const override { return true; }
   int get_backprop_requirements() const override
   {
     return ERROR_SIGNALS | PREV_ACTIVATIONS;
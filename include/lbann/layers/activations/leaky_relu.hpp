@@ -126,6 +126,7 @@ protected:
   void bp_compute() override;
 
   bool can_run_inplace() const override { return true; }
+  bool supports_strided_tensors() const override { return true; }
   int get_backprop_requirements() const override
   {
     return ERROR_SIGNALS | ACTIVATIONS;
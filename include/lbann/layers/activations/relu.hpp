@@ -76,6 +76,7 @@ public:
   data_layout get_data_layout() const override { return T_layout; }
   El::Device get_device_allocation() const override { return Dev; }
   bool can_run_inplace() const override { return true; }
+  bool supports_strided_tensors() const override { return true; }
   int get_backprop_requirements() const override
   {
     return ERROR_SIGNALS | ACTIVATIONS;
@@ -196,6 +196,28 @@ public:
 
   El::mpi::Comm& get_subgrid_comm() { return *m_interSubGridVCComm; }
 
+  /** @brief Write an output tensor directly into a child's output.
+   *
+   *  During forward prop, the output tensor is setup as a view into
+   *  rows [row_offset, row_offset + output size) of @c owner's output
+   *  tensor instead of being allocated. The layer must use the
+   *  default @c fp_setup_outputs and support strided tensors. A null
+   *  @c owner removes the alias.
+   */
+  void set_output_alias(int child_index,
+                        data_type_layer<OutputTensorDataType>* owner,
+                        El::Int row_offset);
+
+  /** @brief Get the output tensor that parent layers write into.
+   *
+   *  The tensor is allocated by the first parent layer that requests
+   *  it in a forward pass. Each request adds a reference to it in the
+   *  activation reference counter, which the parent releases as if it
+   *  owned its output tensor.
+   */
+  OutputAbsDistMatrixType& get_aliased_output(El::Int mini_batch_size,
+                                              El::DistData const& alignment);
+
   /** @name Serialization */
   ///@{
 
@@ -266,6 +288,14 @@ protected:
   /** Creates a new reference counter entry in the model object, if exists. */
   void setup_reference_counter(OutputAbsDistMatrixType& mat);
 
+  /** @brief Setup the output tensor if parent layers allocated it.
+   *
+   *  Returns false if no parent requested the output tensor with
+   *  @c get_aliased_output during this forward pass, in which case it
+   *  must be setup as usual.
+   */
+  bool fp_setup_aliased_output();
+
   // ===========================================================
   // Forward prop step helper functions
   // ===========================================================
@@ -449,6 +479,19 @@ private:
    */
   bool m_activations_created = false;
 
+  /** @brief Output tensors written into another layer's output.
+   *
+   *  Each entry is the owning layer and the row offset, as set by
+   *  @c set_output_alias. Not copied with the layer.
+   */
+  std::vector<std::pair<data_type_layer<OutputTensorDataType>*, El::Int>>
+    m_output_aliases;
+
+  /** @brief Whether a parent layer allocated the output tensor in the
+   *  current forward pass.
+   */
+  bool m_aliased_output_ready = false;
+
 #ifdef LBANN_HAS_DISTCONV
   friend class data_type_distconv_adapter<InputTensorDataType,
                                           OutputTensorDataType>;
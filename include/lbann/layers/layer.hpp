@@ -427,6 +427,13 @@ public:
    */
   virtual bool can_run_inplace() const { return false; }
 
+  /**
+   * @brief If True, the compute kernels accept input, output, and
+   * gradient tensors whose local matrices are not contiguous (e.g.
+   * views into a row range of a larger tensor)
+   */
+  virtual bool supports_strided_tensors() const { return false; }
+
   /** @brief Whether the layer is using a GPU implementation. */
 #ifdef LBANN_HAS_GPU
   bool using_gpus() const { return get_device_allocation() == El::Device::GPU; }
@@ -727,6 +734,20 @@ public:
    */
   bool runs_inplace() const { return m_runs_inplace; }
 
+  /** @brief Keep the output activations after forward prop.
+   *
+   *  Forward-only models release each layer's activations once its
+   *  children have consumed them. Layers whose outputs are read
+   *  after forward prop (e.g. by an inference server) must keep
+   *  them. Children of such layers do not run in-place, which is
+   *  decided during setup.
+   */
+  void set_keep_activations(bool keep) { m_keep_activations = keep; }
+  /** @brief Whether the output activations are kept after forward
+   *  prop (see @c set_keep_activations).
+   */
+  bool keeps_activations() const { return m_keep_activations; }
+
   /** @brief If true, the layer creates new activations during forward
    * computation and owns their memory. This is used to control freeing
    * activations during model training/evaluation.
@@ -812,6 +833,11 @@ protected:
    *  Called by the 'setup' function if the layer is on GPUs.
    */
   virtual void setup_gpu() {}
+  /** @brief Setup buffers shared with neighboring layers.
+   *  Called by the model once all of its layers have been setup, so
+   *  the parent and child layers' configuration is final.
+   */
+  virtual void setup_buffer_aliasing() {}
 
   // ===========================================================
   // Forward prop step helper functions
@@ -903,6 +929,9 @@ protected:
    */
   bool m_runs_inplace = false;
 
+  /** @brief Keep the output activations after forward prop. */
+  bool m_keep_activations = false;
+
   /** @name Layer parallelism */
   ///@{
 
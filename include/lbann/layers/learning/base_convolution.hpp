@@ -120,6 +120,18 @@ public:
   const std::vector<int>& get_strides() const { return m_strides; }
   const std::vector<int>& get_dilations() const { return m_dilations; }
 
+  /** @brief Whether a bias term is applied. */
+  bool has_bias() const noexcept
+  {
+    return m_bias_scaling_factor != El::TypeTraits<ScalingType>::Zero();
+  }
+  /** @brief Apply a bias term.
+   *  @details Takes effect the next time the layer is set up. */
+  void enable_bias() noexcept
+  {
+    m_bias_scaling_factor = El::TypeTraits<ScalingType>::One();
+  }
+
 protected:
   int m_output_channels;
   /** @brief Spatial dimensions for convolution kernel.
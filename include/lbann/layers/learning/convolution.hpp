@@ -105,6 +105,8 @@ public:
 
   bool can_run_inplace() const override { return false; }
 
+  bool supports_strided_tensors() const override { return true; }
+
   int get_backprop_requirements() const override
   {
     return ERROR_SIGNALS | WEIGHTS | PREV_ACTIVATIONS;
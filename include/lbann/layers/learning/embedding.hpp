@@ -27,10 +27,12 @@
 #ifndef LBANN_LAYERS_LEARNING_EMBEDDING_HPP_INCLUDED
 #define LBANN_LAYERS_LEARNING_EMBEDDING_HPP_INCLUDED
 
+#include "lbann/data_ingestion/data_coordinator.hpp"
 #include "lbann/layers/data_type_layer.hpp"
 #include "lbann/models/model.hpp"
 #include "lbann/proto/datatype_helpers.hpp"
 #include "lbann/proto/layers.pb.h"
+#include "lbann/trainers/trainer.hpp"
 #include "lbann/utils/memory.hpp"
 
 namespace lbann {
@@ -48,6 +50,11 @@ namespace lbann {
  *  @f$ \text{embedding\_dim} \times \text{num\_embeddings} @f$
  *  weights matrix. Note that this is the transpose of the weights in
  *  the PyTorch embedding layer.
+ *
+ *  If @c truncate_padding is set, only the first entries of the input,
+ *  up to the longest sample of the current mini-batch as reported by
+ *  the data reader, are looked up. The remaining entries are assumed
+ *  to hold the padding index and produce vectors of zeros.
  */
 template <typename TensorDataType, data_layout Layout, El::Device Device>
 class embedding_layer : public data_type_layer<TensorDataType>
@@ -78,10 +85,14 @@ public:
    *                        vector is initialized with zeros. The
    *                        objective function gradient w.r.t. this
    *                        embedding vector is always zero.
+   *  @param truncate_padding Skip input entries past the effective
+   *                        sequence length of the mini-batch. Requires
+   *                        @c padding_idx.
    */
   embedding_layer(size_t num_embeddings,
                   size_t embedding_dim,
-                  El::Int padding_idx = -1);
+                  El::Int padding_idx = -1,
+                  bool truncate_padding = false);
 
   embedding_layer(const embedding_layer& other);
   embedding_layer& operator=(const embedding_layer& other);
@@ -120,6 +131,10 @@ protected:
   void fp_compute() override;
   void bp_compute() override;
 
+  /** Number of leading input entries that are not padding in any
+   *  sample of the current mini-batch. */
+  size_t get_active_input_size() const;
+
 private:
   /** Size of dictionary of embeddings. */
   size_t m_num_embeddings;
@@ -130,6 +145,9 @@ private:
    *  gradient w.r.t. this embedding vector is always zero.
    */
   El::Int m_padding_idx;
+  /** Only look up input entries up to the effective sequence length
+   *  of the mini-batch; later entries are treated as padding. */
+  bool m_truncate_padding;
 };
 
 // =========================================================
@@ -145,17 +163,20 @@ void embedding_layer<T, L, D>::write_specific_proto(
   msg->set_num_embeddings(m_num_embeddings);
   msg->set_embedding_dim(m_embedding_dim);
   msg->mutable_padding_idx()->set_value(m_padding_idx);
+  msg->set_truncate_padding(m_truncate_padding);
 }
 
 template <typename TensorDataType, data_layout Layout, El::Device Device>
 embedding_layer<TensorDataType, Layout, Device>::embedding_layer(
   size_t num_embeddings,
   size_t embedding_dim,
-  El::Int padding_idx)
+  El::Int padding_idx,
+  bool truncate_padding)
   : data_type_layer<TensorDataType>(nullptr),
     m_num_embeddings{num_embeddings},
     m_embedding_dim{embedding_dim},
-    m_padding_idx{padding_idx}
+    m_padding_idx{padding_idx},
+    m_truncate_padding{truncate_padding}
 {}
 
 template <typename TensorDataType, data_layout Layout, El::Device Device>
@@ -169,7 +190,8 @@ embedding_layer<TensorDataType, Layout, Device>::embedding_layer(
   : data_type_layer<TensorDataType>(other),
     m_num_embeddings{other.m_num_embeddings},
     m_embedding_dim{other.m_embedding_dim},
-    m_padding_idx{other.m_padding_idx}
+    m_padding_idx{other.m_padding_idx},
+    m_truncate_padding{other.m_truncate_padding}
 {}
 
 template <typename TensorDataType, data_layout Layout, El::Device Device>
@@ -181,6 +203,7 @@ embedding_layer<TensorDataType, Layout, Device>::operator=(
   m_num_embeddings = other.m_num_embeddings;
   m_embedding_dim = other.m_embedding_dim;
   m_padding_idx = other.m_padding_idx;
+  m_truncate_padding = other.m_truncate_padding;
   return *this;
 }
 
@@ -219,6 +242,7 @@ embedding_layer<TensorDataType, Layout, Device>::get_description() const
   desc.add("Num embeddings", m_num_embeddings);
   desc.add("Embedding dim", m_embedding_dim);
   desc.add("Padding index", m_padding_idx);
+  desc.add("Truncate padding", m_truncate_padding);
   return desc;
 }
 
@@ -229,6 +253,29 @@ void embedding_layer<TensorDataType, Layout, Device>::setup_dims()
   auto dims = this->get_input_dims();
   dims.push_back(static_cast<int>(m_embedding_dim));
   this->set_output_dims(dims);
+  if (m_truncate_padding && m_padding_idx < 0) {
+    LBANN_ERROR(this->get_type(),
+                " layer \"",
+                this->get_name(),
+                "\" ",
+                "truncates padding but has no padding index");
+  }
+}
+
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+size_t
+embedding_layer<TensorDataType, Layout, Device>::get_active_input_size() const
+{
+  const size_t input_size = this->get_input_size();
+  if (!m_truncate_padding) {
+    return input_size;
+  }
+  const auto mode =
+    this->m_model->get_execution_context().get_execution_mode();
+  const size_t length =
+    get_const_trainer().get_data_coordinator().get_effective_sequence_length(
+      mode);
+  return (0 < length && length < input_size) ? length : input_size;
 }
 
 template <typename TensorDataType, data_layout Layout, El::Device Device>
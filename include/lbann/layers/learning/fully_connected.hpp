@@ -103,6 +103,20 @@ public:
 
   description get_description() const override;
 
+  /** @brief Whether the transpose of the linearity matrix is applied. */
+  bool is_transposed() const noexcept { return m_transpose; }
+  /** @brief Whether a bias term is applied. */
+  bool has_bias() const noexcept
+  {
+    return m_bias_scaling_factor != El::TypeTraits<TensorDataType>::Zero();
+  }
+  /** @brief Apply a bias term.
+   *  @details Takes effect the next time the layer is set up. */
+  void enable_bias() noexcept
+  {
+    m_bias_scaling_factor = El::TypeTraits<TensorDataType>::One();
+  }
+
   /** @name Serialization */
   ///@{
 
@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_LAYERS_LOSS_SOFTMAX_CROSS_ENTROPY_HPP_INCLUDED
+#define LBANN_LAYERS_LOSS_SOFTMAX_CROSS_ENTROPY_HPP_INCLUDED
+
+#include "lbann/layers/data_type_layer.hpp"
+#include "lbann/proto/datatype_helpers.hpp"
+#include "lbann/proto/layers.pb.h"
+
+namespace lbann {
+
+/** @brief Cross entropy between softmax of logits and integer labels
+ *
+ *  Requires two inputs. The first is interpreted as logits, with the
+ *  last tensor dimension indexing classes, and the second as integer
+ *  class labels for each position of the remaining dimensions. The
+ *  output is the sum over positions of
+ *  @f[ -\log \text{softmax}(x)_{\hat{y}}
+ *      = \log \sum\limits_{i} e^{x_i} - x_{\hat{y}} @f]
+ *
+ *  This is equivalent to a @c log_softmax layer followed by a
+ *  @c cross_entropy layer with one-hot labels, but the loss and its
+ *  gradient are computed in one streaming pass over the logits with
+ *  an online log-sum-exp. The probabilities are never stored, so the
+ *  only logit-sized buffer besides the input is the gradient.
+ */
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+class softmax_cross_entropy_layer : public data_type_layer<TensorDataType>
+{
+  static_assert(Layout == data_layout::DATA_PARALLEL,
+                "softmax cross entropy layer only supports data parallel "
+                "layout");
+  static_assert(Device == El::Device::CPU,
+                "softmax cross entropy layer only supports CPU");
+
+public:
+  /** @param comm             LBANN communicator
+   *  @param vocab_chunk_size Number of classes processed at a time by
+   *                          the online log-sum-exp. 0 processes all
+   *                          classes at once.
+   *  @param ignore_index     Positions with this label do not
+   *                          contribute to the loss. Negative values
+   *                          disable this.
+   */
+  softmax_cross_entropy_layer(lbann_comm* comm,
+                              El::Int vocab_chunk_size = 0,
+                              El::Int ignore_index = -1)
+    : data_type_layer<TensorDataType>(comm),
+      m_vocab_chunk_size(vocab_chunk_size),
+      m_ignore_index(ignore_index)
+  {
+    this->m_expected_num_parent_layers = 2;
+  }
+
+  softmax_cross_entropy_layer* copy() const override
+  {
+    return new softmax_cross_entropy_layer(*this);
+  }
+
+  /** @name Serialization */
+  ///@{
+
+  template <typename ArchiveT>
+  void serialize(ArchiveT& ar);
+
+  ///@}
+
+  std::string get_type() const override { return "softmax cross entropy"; }
+  data_layout get_data_layout() const override { return Layout; }
+  El::Device get_device_allocation() const override { return Device; }
+  bool can_run_inplace() const override { return false; }
+  int get_backprop_requirements() const override
+  {
+    return ERROR_SIGNALS | PREV_ACTIVATIONS;
+  }
+
+  description get_description() const override
+  {
+    auto desc = data_type_layer<TensorDataType>::get_description();
+    desc.add("Vocabulary chunk size", m_vocab_chunk_size);
+    desc.add("Ignore index", m_ignore_index);
+    return desc;
+  }
+
+protected:
+  /** Add layer specific data to prototext */
+  void write_specific_proto(lbann_data::Layer& proto) const final;
+
+  friend class cereal::access;
+  softmax_cross_entropy_layer() : softmax_cross_entropy_layer(nullptr) {}
+
+  void setup_dims() override;
+
+  void fp_compute() override;
+
+  void bp_compute() override;
+
+private:
+  /** Number of classes, i.e. the last dimension of the logits. */
+  El::Int get_num_classes() const;
+
+  /** Number of classes processed at a time, or 0 for all. */
+  El::Int m_vocab_chunk_size;
+  /** Label of positions excluded from the loss, or negative. */
+  El::Int m_ignore_index;
+
+  /** Log-sum-exp of each position's logits, saved for backprop. */
+  El::Matrix<TensorDataType, El::Device::CPU> m_log_sum_exp;
+};
+
+#ifndef LBANN_SOFTMAX_CROSS_ENTROPY_LAYER_INSTANTIATE
+#define PROTO(T)                                                               \
+  extern template class softmax_cross_entropy_layer<                           \
+    T,                                                                         \
+    data_layout::DATA_PARALLEL,                                                \
+    El::Device::CPU>
+
+#define LBANN_INSTANTIATE_CPU_HALF
+#include "lbann/macros/instantiate.hpp"
+#undef PROTO
+#undef LBANN_INSTANTIATE_CPU_HALF
+#endif // LBANN_SOFTMAX_CROSS_ENTROPY_LAYER_INSTANTIATE
+
+} // namespace lbann
+
+#endif // LBANN_LAYERS_LOSS_SOFTMAX_CROSS_ENTROPY_HPP_INCLUDED
@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_LAYERS_MATH_SCALED_DOT_PRODUCT_ATTENTION_HPP_INCLUDED
+#define LBANN_LAYERS_MATH_SCALED_DOT_PRODUCT_ATTENTION_HPP_INCLUDED
+
+#include "lbann/layers/data_type_layer.hpp"
+
+#include <cstdint>
+
+namespace lbann {
+
+/** @brief Fused multi-head scaled dot-product attention
+ *
+ *  Expects three inputs: queries (@f$ S_q \times E @f$), keys
+ *  (@f$ S_k \times E @f$), and values (@f$ S_k \times E_v @f$). The
+ *  embedding dimensions are split evenly into heads and each head
+ *  computes
+ *  @f[ \text{softmax}\left( \alpha Q K^T + M \right) V @f]
+ *  where @f$ \alpha @f$ defaults to @f$ 1/\sqrt{E/\text{heads}} @f$
+ *  and @f$ M @f$ is an optional causal mask that hides key @f$ j @f$
+ *  from query @f$ i @f$ if @f$ j > i @f$. The head outputs are
+ *  concatenated into an @f$ S_q \times E_v @f$ tensor, which matches
+ *  the output of the attention heads in
+ *  @c lbann.modules.MultiheadAttention before the output projection.
+ *
+ *  The CPU kernel follows FlashAttention: queries and keys are
+ *  processed in tiles with an online softmax, so the
+ *  @f$ S_q \times S_k @f$ attention matrix is never stored. Dropout
+ *  on the attention weights is applied inside the kernel with a
+ *  counter-based RNG, and backprop recomputes the attention tiles
+ *  from the saved log-sum-exp of each query row. If LBANN is built
+ *  with @c LBANN_DETERMINISTIC, every process uses the trainer
+ *  master's seed, so the dropout mask does not depend on the number
+ *  of processes. See:
+ *
+ *  Tri Dao. "FlashAttention-2: Faster attention with better
+ *  parallelism and work partitioning." arXiv:2307.08691. 2023.
+ */
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+class scaled_dot_product_attention_layer
+  : public data_type_layer<TensorDataType>
+{
+  static_assert(Layout == data_layout::DATA_PARALLEL,
+                "scaled dot-product attention layer only supports data "
+                "parallel layout");
+  static_assert(Device == El::Device::CPU,
+                "scaled dot-product attention layer only supports CPU");
+
+public:
+  /** @param comm      LBANN communicator
+   *  @param num_heads Number of attention heads
+   *  @param causal    Whether each query only attends to keys at the
+   *                   same or earlier positions
+   *  @param dropout   Probability of dropping attention weights
+   *                   during training
+   *  @param scale     Scaling factor for query-key dot products.
+   *                   Non-positive values select
+   *                   @f$ 1/\sqrt{\text{head dim}} @f$.
+   */
+  scaled_dot_product_attention_layer(lbann_comm* comm,
+                                     El::Int num_heads = 1,
+                                     bool causal = false,
+                                     double dropout = 0.0,
+                                     double scale = 0.0)
+    : data_type_layer<TensorDataType>(comm),
+      m_num_heads(num_heads),
+      m_causal(causal),
+      m_dropout(dropout),
+      m_scale(scale)
+  {
+    this->m_expected_num_parent_layers = 3;
+  }
+
+  scaled_dot_product_attention_layer* copy() const override
+  {
+    return new scaled_dot_product_attention_layer(*this);
+  }
+
+  /** @name Serialization */
+  ///@{
+
+  template <typename ArchiveT>
+  void serialize(ArchiveT& ar);
+
+  ///@}
+
+  std::string get_type() const override
+  {
+    return "scaled dot-product attention";
+  }
+  data_layout get_data_layout() const override { return Layout; }
+  El::Device get_device_allocation() const override { return Device; }
+  bool can_run_inplace() const override { return false; }
+  int get_backprop_requirements() const override
+  {
+    return ERROR_SIGNALS | PREV_ACTIVATIONS | ACTIVATIONS;
+  }
+
+  description get_description() const override
+  {
+    auto desc = data_type_layer<TensorDataType>::get_description();
+    desc.add("Heads", m_num_heads);
+    desc.add("Causal", m_causal);
+    desc.add("Dropout", m_dropout);
+    desc.add("Scale", get_scale());
+    return desc;
+  }
+
+protected:
+  /** Add layer specific data to prototext */
+  void write_specific_proto(lbann_data::Layer& proto) const final;
+
+  friend class cereal::access;
+  scaled_dot_product_attention_layer()
+    : scaled_dot_product_attention_layer(nullptr)
+  {}
+
+  void setup_dims() override;
+
+  void fp_compute() override;
+
+  void bp_compute() override;
+
+private:
+  /** Scaling factor for query-key dot products. */
+  double get_scale() const;
+  /** Whether dropout is applied in the current execution mode. */
+  bool is_dropout_active() const;
+
+  /** Number of attention heads. */
+  El::Int m_num_heads;
+  /** Whether keys after each query position are masked. */
+  bool m_causal;
+  /** Probability of dropping attention weights. */
+  double m_dropout;
+  /** Scaling factor for query-key dot products, or non-positive. */
+  double m_scale;
+
+  /** Log-sum-exp of each query row's attention scores, saved for
+   *  backprop. Rows are ordered by head, then query position. */
+  El::Matrix<TensorDataType, El::Device::CPU> m_log_sum_exp;
+  /** Seed for the counter-based RNG that generates the dropout
+   *  mask. */
+  uint64_t m_mask_seed = 0;
+};
+
+#ifndef LBANN_SCALED_DOT_PRODUCT_ATTENTION_LAYER_INSTANTIATE
+#define PROTO(T)                                                               \
+  extern template class scaled_dot_product_attention_layer<                    \
+    T,                                                                         \
+    data_layout::DATA_PARALLEL,                                                \
+    El::Device::CPU>
+
+#define LBANN_INSTANTIATE_CPU_HALF
+#include "lbann/macros/instantiate.hpp"
+#undef PROTO
+#undef LBANN_INSTANTIATE_CPU_HALF
+#endif // LBANN_SCALED_DOT_PRODUCT_ATTENTION_LAYER_INSTANTIATE
+
+} // namespace lbann
+
+#endif // LBANN_LAYERS_MATH_SCALED_DOT_PRODUCT_ATTENTION_HPP_INCLUDED
@@ -28,6 +28,7 @@
 
 #include "lbann/layers/data_type_layer.hpp"
 #include "lbann/layers/layer.hpp"
+#include "lbann/operators/elementwise_operator.hpp"
 #include "lbann/operators/operator.hpp"
 #include "lbann/utils/describable.hpp"
 #include "lbann/utils/tensor.hpp"
@@ -41,7 +42,16 @@ namespace lbann {
 
 /** @brief Layer composed of one or more operator objects
  *
- *  Operators are applied sequentially.
+ *  Operators are applied sequentially. Operators after the first are
+ *  applied in place to the layer's output, so they must be
+ *  entry-wise.
+ *
+ *  On CPU, a chain of unary operators that provide block kernels is
+ *  fused at setup. The fused kernel processes the local data in
+ *  cache-sized blocks, so each entry is read and written once per
+ *  pass, and intermediate values are recomputed during back
+ *  propagation instead of being stored. Otherwise, back propagation
+ *  is only supported with a single operator.
  */
 template <typename InputT, typename OutputT, data_layout Layout, El::Device D>
 class OperatorLayer final : public data_type_layer<InputT, OutputT>
@@ -49,9 +59,20 @@ class OperatorLayer final : public data_type_layer<InputT, OutputT>
   using DataTypeLayer = data_type_layer<InputT, OutputT>;
   using OperatorType = Operator<InputT, OutputT, D>;
   using OperatorPtr = std::unique_ptr<OperatorType>;
+  using ElementwiseOperatorType = ElementwiseOperator<InputT, OutputT, D>;
+
+  /** @brief Number of entries processed at a time by fused kernels. */
+  static constexpr El::Int fused_block_size = 256;
 
   std::vector<OperatorPtr> m_ops;
 
+  /** @brief Operators applied by the fused kernels.
+   *
+   *  Non-owning pointers into @c m_ops. Empty if the operators are
+   *  not fused.
+   */
+  std::vector<ElementwiseOperatorType const*> m_fused_ops;
+
 public:
   /** @name Lifecycle functions */
   ///@{
@@ -82,12 +103,29 @@ public:
   El::Device get_device_allocation() const final;
   bool can_run_inplace() const final;
   int get_backprop_requirements() const final;
+  /** @brief The fused kernels index tensors by leading dimension. */
+  bool supports_strided_tensors() const final
+  {
+    return has_fused_operators();
+  }
 
   void fp_compute() final;
   void bp_compute() final;
 
   description get_description() const final;
 
+  /** @brief Number of operators applied by this layer. */
+  size_t get_num_operators() const noexcept { return m_ops.size(); }
+
+  /** @brief Whether the operators are applied by a fused kernel. */
+  bool has_fused_operators() const noexcept { return !m_fused_ops.empty(); }
+
+  /** @brief Append copies of another layer's operators.
+   *
+   *  Used to fuse a chain of operator layers into one layer.
+   */
+  void append_operators(OperatorLayer const& other);
+
   template <typename ArchiveT>
   void serialize(ArchiveT&);
 
@@ -95,6 +133,8 @@ protected:
   /** Add layer specific data to prototext */
   void write_specific_proto(lbann_data::Layer& proto) const final;
 
+  void setup_data(size_t max_mini_batch_size) final;
+
 private:
   friend cereal::access;
   OperatorLayer();
@@ -104,8 +144,20 @@ private:
 
   static std::vector<size_t> fix_type(std::vector<int> const& in);
 
+  /** @brief Get the operators if they can be fused.
+   *
+   *  Returns an empty list unless there are several operators and
+   *  all of them provide block kernels.
+   */
+  static std::vector<ElementwiseOperatorType const*>
+  get_fusable_ops(std::vector<OperatorPtr> const& ops);
+
+  void fused_fp_compute();
+  void fused_bp_compute();
+
   std::vector<utils::ConstDistTensorView<InputT, D>> get_inputs() const;
   std::vector<utils::DistTensorView<OutputT, D>> get_outputs();
+  std::vector<utils::ConstDistTensorView<OutputT, D>> get_const_outputs() const;
   std::vector<utils::ConstDistTensorView<OutputT, D>>
   get_grad_wrt_outputs() const;
   std::vector<utils::DistTensorView<InputT, D>> get_grad_wrt_inputs();
@@ -33,10 +33,14 @@
 #include "lbann/proto/factories.hpp"
 #include "lbann/proto/operator_factory.hpp"
 #include "lbann/utils/exception.hpp"
+#include "lbann/utils/omp_pragma.hpp"
 
 #include "lbann/proto/layers.pb.h"
+#include <algorithm>
+#include <array>
 #include <cereal/types/base_class.hpp>
 #include <memory>
+#include <type_traits>
 
 namespace lbann {
 
@@ -57,8 +61,9 @@ OperatorLayer<InputT, OutputT, Layout, D>::OperatorLayer(
   std::vector<OperatorPtr> operators)
   : DataTypeLayer(&comm), m_ops{std::move(operators)}
 {
-  LBANN_ASSERT(m_ops.size() == 1UL); // For starters.
-  LBANN_ASSERT(m_ops[0]);
+  LBANN_ASSERT(!m_ops.empty());
+  for (auto const& op : m_ops)
+    LBANN_ASSERT(op);
   this->m_expected_num_parent_layers = -1; // No limit on parents
 }
 
@@ -66,7 +71,11 @@ template <typename InputT, typename OutputT, data_layout Layout, El::Device D>
 OperatorLayer<InputT, OutputT, Layout, D>::OperatorLayer(
   OperatorLayer const& other)
   : DataTypeLayer(other), m_ops{clone_ops(other.m_ops)}
-{}
+{
+  if (!other.m_fused_ops.empty()) {
+    m_fused_ops = get_fusable_ops(m_ops);
+  }
+}
 
 template <typename InputT, typename OutputT, data_layout Layout, El::Device D>
 auto OperatorLayer<InputT, OutputT, Layout, D>::operator=(
@@ -75,6 +84,10 @@ auto OperatorLayer<InputT, OutputT, Layout, D>::operator=(
   // This is self-assignment safe
   data_type_layer<InputT, OutputT>::operator=(other);
   m_ops = clone_ops(other.m_ops);
+  m_fused_ops.clear();
+  if (!other.m_fused_ops.empty()) {
+    m_fused_ops = get_fusable_ops(m_ops);
+  }
   return *this;
 }
 
@@ -120,15 +133,52 @@ int OperatorLayer<InputT, OutputT, Layout, D>::get_backprop_requirements() const
   return result;
 }
 
+template <typename InputT, typename OutputT, data_layout Layout, El::Device D>
+void OperatorLayer<InputT, OutputT, Layout, D>::setup_data(
+  size_t max_mini_batch_size)
+{
+  DataTypeLayer::setup_data(max_mini_batch_size);
+  m_fused_ops.clear();
+  if (this->get_num_parents() == 1 && this->get_num_children() == 1) {
+    m_fused_ops = get_fusable_ops(m_ops);
+  }
+}
+
 template <typename InputT, typename OutputT, data_layout Layout, El::Device D>
 void OperatorLayer<InputT, OutputT, Layout, D>::fp_compute()
 {
-  return m_ops[0]->fp_compute(this->get_inputs(), this->get_outputs());
+  if (!m_fused_ops.empty()) {
+    return fused_fp_compute();
+  }
+  m_ops[0]->fp_compute(this->get_inputs(), this->get_outputs());
+  if constexpr (std::is_same_v<InputT, OutputT>) {
+    // Remaining operators are applied in place
+    for (size_t i = 1; i < m_ops.size(); ++i) {
+      m_ops[i]->fp_compute(this->get_const_outputs(), this->get_outputs());
+    }
+  }
+  else if (m_ops.size() > 1) {
+    LBANN_ERROR("operator layer \"",
+                this->get_name(),
+                "\" cannot chain operators with different ",
+                "input and output types");
+  }
 }
 
 template <typename InputT, typename OutputT, data_layout Layout, El::Device D>
 void OperatorLayer<InputT, OutputT, Layout, D>::bp_compute()
 {
+  if (!m_fused_ops.empty()) {
+    return fused_bp_compute();
+  }
+  if (m_ops.size() > 1) {
+    LBANN_ERROR("operator layer \"",
+                this->get_name(),
+                "\" has ",
+                m_ops.size(),
+                " operators that cannot be fused and only supports ",
+                "inference");
+  }
   return m_ops[0]->bp_compute(this->get_inputs(),
                               this->get_grad_wrt_outputs(),
                               this->get_grad_wrt_inputs());
@@ -143,6 +193,17 @@ description OperatorLayer<InputT, OutputT, Layout, D>::get_description() const
   return desc;
 }
 
+template <typename InputT, typename OutputT, data_layout Layout, El::Device D>
+void OperatorLayer<InputT, OutputT, Layout, D>::append_operators(
+  OperatorLayer const& other)
+{
+  for (auto const& op : other.m_ops) {
+    m_ops.emplace_back(op->clone());
+  }
+  // Fused kernels are rebuilt when the layer is set up again
+  m_fused_ops.clear();
+}
+
 template <typename InputT, typename OutputT, data_layout Layout, El::Device D>
 template <typename ArchiveT>
 void OperatorLayer<InputT, OutputT, Layout, D>::serialize(ArchiveT& ar)
@@ -176,6 +237,152 @@ OperatorLayer<InputT, OutputT, Layout, D>::fix_type(std::vector<int> const& in)
   return std::vector<size_t>{cbegin(in), cend(in)};
 }
 
+template <typename InputT, typename OutputT, data_layout Layout, El::Device D>
+auto OperatorLayer<InputT, OutputT, Layout, D>::get_fusable_ops(
+  std::vector<OperatorPtr> const& ops)
+  -> std::vector<ElementwiseOperatorType const*>
+{
+  std::vector<ElementwiseOperatorType const*> out;
+  if constexpr (D == El::Device::CPU && std::is_same_v<InputT, OutputT>) {
+    if (ops.size() < 2) {
+      return out;
+    }
+    out.reserve(ops.size());
+    for (auto const& op : ops) {
+      auto const* ew_op =
+        dynamic_cast<ElementwiseOperatorType const*>(op.get());
+      if (ew_op == nullptr || !ew_op->has_block_kernels()) {
+        return {};
+      }
+      out.push_back(ew_op);
+    }
+  }
+  return out;
+}
+
+// The fused kernels split the local matrices into blocks of at most
+// fused_block_size entries within a column. Operators are applied to
+// a block while it is resident in cache.
+
+template <typename InputT, typename OutputT, data_layout Layout, El::Device D>
+void OperatorLayer<InputT, OutputT, Layout, D>::fused_fp_compute()
+{
+  if constexpr (D == El::Device::CPU && std::is_same_v<InputT, OutputT>) {
+    auto const& local_input = this->get_local_prev_activations();
+    auto& local_output = this->get_local_activations();
+    const El::Int height = local_input.Height();
+    const El::Int width = local_input.Width();
+    const InputT* x = local_input.LockedBuffer();
+    const El::Int x_ldim = local_input.LDim();
+    OutputT* y = local_output.Buffer();
+    const El::Int y_ldim = local_output.LDim();
+    if (height == 0 || width == 0) {
+      return;
+    }
+
+    const auto& ops = m_fused_ops;
+    const size_t num_ops = ops.size();
+    const El::Int blocks_per_col =
+      (height + fused_block_size - 1) / fused_block_size;
+    const El::Int num_blocks = blocks_per_col * width;
+    LBANN_OMP_PARALLEL_FOR
+    for (El::Int block = 0; block < num_blocks; ++block) {
+      std::array<InputT, fused_block_size> work;
+      const El::Int col = block / blocks_per_col;
+      const El::Int row = (block % blocks_per_col) * fused_block_size;
+      const El::Int n = std::min(fused_block_size, height - row);
+      ops.front()->fp_compute_block(x + row + col * x_ldim, work.data(), n);
+      for (size_t k = 1; k + 1 < num_ops; ++k) {
+        ops[k]->fp_compute_block(work.data(), work.data(), n);
+      }
+      ops.back()->fp_compute_block(work.data(), y + row + col * y_ldim, n);
+    }
+  }
+}
+
+template <typename InputT, typename OutputT, data_layout Layout, El::Device D>
+void OperatorLayer<InputT, OutputT, Layout, D>::fused_bp_compute()
+{
+  if constexpr (D == El::Device::CPU && std::is_same_v<InputT, OutputT>) {
+    auto const& local_grad_wrt_output = this->get_local_prev_error_signals();
+    auto& local_grad_wrt_input = this->get_local_error_signals();
+    const El::Int height = local_grad_wrt_output.Height();
+    const El::Int width = local_grad_wrt_output.Width();
+    const OutputT* dy = local_grad_wrt_output.LockedBuffer();
+    const El::Int dy_ldim = local_grad_wrt_output.LDim();
+    InputT* dx = local_grad_wrt_input.Buffer();
+    const El::Int dx_ldim = local_grad_wrt_input.LDim();
+    if (height == 0 || width == 0) {
+      return;
+    }
+
+    // Operator inputs are only needed if some operator's derivative
+    // depends on them. Otherwise the previous activations may have
+    // been overwritten by in-place execution, and a placeholder is
+    // passed to the backward kernels.
+    const bool need_inputs =
+      (this->get_backprop_requirements() & PREV_ACTIVATIONS);
+    const InputT* x = nullptr;
+    El::Int x_ldim = 0;
+    if (need_inputs) {
+      auto const& local_input = this->get_local_prev_activations();
+      x = local_input.LockedBuffer();
+      x_ldim = local_input.LDim();
+    }
+
+    // Each task owns a workspace with the inputs of operators after
+    // the first and a gradient block
+    const auto& ops = m_fused_ops;
+    const El::Int num_ops = ops.size();
+    const El::Int blocks_per_col =
+      (height + fused_block_size - 1) / fused_block_size;
+    const El::Int num_blocks = blocks_per_col * width;
+    const El::Int num_tasks =
+      std::min(num_blocks, static_cast<El::Int>(omp_get_max_threads()));
+    const El::Int task_workspace_size = num_ops * fused_block_size;
+    std::vector<InputT> workspace(num_tasks * task_workspace_size);
+    LBANN_OMP_PARALLEL_FOR
+    for (El::Int task = 0; task < num_tasks; ++task) {
+      InputT* acts = &workspace[task * task_workspace_size];
+      InputT* grad = acts + (num_ops - 1) * fused_block_size;
+      const El::Int block_start = (task * num_blocks) / num_tasks;
+      const El::Int block_end = ((task + 1) * num_blocks) / num_tasks;
+      for (El::Int block = block_start; block < block_end; ++block) {
+        const El::Int col = block / blocks_per_col;
+        const El::Int row = (block % blocks_per_col) * fused_block_size;
+        const El::Int n = std::min(fused_block_size, height - row);
+        const OutputT* dy_block = dy + row + col * dy_ldim;
+        InputT* dx_block = dx + row + col * dx_ldim;
+
+        // Recompute the input of each operator
+        const InputT* x_block =
+          need_inputs ? x + row + col * x_ldim : dy_block;
+        if (need_inputs) {
+          ops[0]->fp_compute_block(x_block, acts, n);
+          for (El::Int k = 1; k + 1 < num_ops; ++k) {
+            ops[k]->fp_compute_block(acts + (k - 1) * fused_block_size,
+                                     acts + k * fused_block_size,
+                                     n);
+          }
+        }
+        auto op_input = [&](El::Int k) -> const InputT* {
+          if (k == 0 || !need_inputs) {
+            return x_block;
+          }
+          return acts + (k - 1) * fused_block_size;
+        };
+
+        // Apply the chain rule in reverse order
+        ops.back()->bp_compute_block(op_input(num_ops - 1), dy_block, grad, n);
+        for (El::Int k = num_ops - 2; k > 0; --k) {
+          ops[k]->bp_compute_block(op_input(k), grad, grad, n);
+        }
+        ops.front()->bp_compute_block(op_input(0), grad, dx_block, n);
+      }
+    }
+  }
+}
+
 // WARNING: The next 4 functions all assume the minibatch dim is the
 // width of the matrix.
 
@@ -208,6 +415,20 @@ OperatorLayer<InputT, OutputT, Layout, D>::get_outputs()
   return out;
 }
 
+template <typename InputT, typename OutputT, data_layout Layout, El::Device D>
+std::vector<utils::ConstDistTensorView<OutputT, D>>
+OperatorLayer<InputT, OutputT, Layout, D>::get_const_outputs() const
+{
+  auto n_children = this->get_num_children();
+  std::vector<utils::ConstDistTensorView<OutputT, D>> out;
+  out.reserve(n_children);
+  for (int c = 0; c < n_children; ++c) {
+    auto const& acts = this->get_activations(c);
+    out.emplace_back(acts, splice_dims(acts.Width(), this->get_output_dims(c)));
+  }
+  return out;
+}
+
 template <typename InputT, typename OutputT, data_layout Layout, El::Device D>
 std::vector<utils::ConstDistTensorView<OutputT, D>>
 OperatorLayer<InputT, OutputT, Layout, D>::get_grad_wrt_outputs() const
@@ -285,11 +285,15 @@ public:
   data_layout get_data_layout() const override { return T_layout; }
   El::Device get_device_allocation() const override { return Dev; }
   bool can_run_inplace() const override { return false; }
+  bool supports_strided_tensors() const override { return true; }
   int get_backprop_requirements() const override
   {
     return ERROR_SIGNALS | WEIGHTS | PREV_ACTIVATIONS;
   }
 
+  /** @brief Small number added to the variance for numerical stability. */
+  AccT get_epsilon() const noexcept { return m_epsilon; }
+
   description get_description() const override
   {
     auto desc = data_type_layer<TensorDataType>::get_description();
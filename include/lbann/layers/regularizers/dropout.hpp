@@ -32,6 +32,7 @@
 #include "lbann/utils/dnn_lib/dropout.hpp"
 #include "lbann/utils/dnn_lib/helpers.hpp"
 #endif // LBANN_HAS_DNN_LIB
+#include "lbann/utils/counter_based_rng.hpp"
 #include "lbann/utils/random_number_generators.hpp"
 
 namespace lbann {
@@ -46,6 +47,12 @@ namespace lbann {
  *  Sutskever, and Ruslan Salakhutdinov. "Dropout: a simple way to
  *  prevent neural networks from overfitting." The Journal of Machine
  *  Learning Research 15, no. 1 (2014): 1929-1958.
+ *
+ *  On CPU, the mask is generated with a counter-based RNG. If
+ *  @c regenerate_mask is set, only the RNG seed is stored and the
+ *  mask is recomputed during backprop, so no mask matrix is
+ *  allocated and masking and scaling are fused into a single pass.
+ *  Mask regeneration is not supported on GPU.
  */
 template <typename TensorDataType, data_layout T_layout, El::Device Dev>
 class dropout : public data_type_layer<TensorDataType>
@@ -61,9 +68,10 @@ public:
 
 public:
   /** Keep units with probabiliy keep_prob. */
-  dropout(EvalType keep_prob = EvalType(0.5))
+  dropout(EvalType keep_prob = EvalType(0.5), bool regenerate_mask = false)
     : data_type_layer<TensorDataType>(nullptr),
-      m_keep_prob(keep_prob)
+      m_keep_prob(keep_prob),
+      m_regenerate_mask(regenerate_mask)
 #ifdef LBANN_HAS_DNN_LIB
       ,
       m_tensors_dnn_desc(this)
@@ -73,6 +81,8 @@ public:
   dropout(const dropout& other)
     : data_type_layer<TensorDataType>(other),
       m_keep_prob(other.m_keep_prob),
+      m_regenerate_mask(other.m_regenerate_mask),
+      m_mask_seed(other.m_mask_seed),
       m_mask(other.m_mask ? other.m_mask->Copy() : nullptr)
 #ifdef LBANN_HAS_DNN_LIB
       ,
@@ -93,6 +103,8 @@ public:
   {
     data_type_layer<TensorDataType>::operator=(other);
     m_keep_prob = other.m_keep_prob;
+    m_regenerate_mask = other.m_regenerate_mask;
+    m_mask_seed = other.m_mask_seed;
     m_mask = other.m_mask
                ? std::unique_ptr<AbsDistMatrixType>(other.m_mask->Copy())
                : nullptr;
@@ -121,12 +133,15 @@ public:
   {
     auto desc = data_type_layer<TensorDataType>::get_description();
     desc.add("Keep probability", m_keep_prob);
+    desc.add("Regenerate mask", m_regenerate_mask);
     return desc;
   }
   /** @brief get prob for keep each unit. */
   EvalType get_keep_prob() const { return m_keep_prob; }
   /** @brief set prob for keep each unit. */
   void set_keep_prob(EvalType keep_prob) { m_keep_prob = keep_prob; }
+  /** @brief Whether the mask is regenerated during backprop. */
+  bool get_regenerate_mask() const { return m_regenerate_mask; }
 
   /** @name Serialization */
   ///@{
@@ -149,7 +164,27 @@ protected:
   void setup_data(size_t max_mini_batch_size) override
   {
     data_type_layer<TensorDataType>::setup_data(max_mini_batch_size);
-    m_mask = std::unique_ptr<AbsDistMatrixType>(this->get_activations().Copy());
+    if (m_regenerate_mask && Dev != El::Device::CPU) {
+      LBANN_ERROR(this->get_type(),
+                  " layer \"",
+                  this->get_name(),
+                  "\" can only regenerate its dropout mask on CPU");
+    }
+#ifdef LBANN_DETERMINISTIC
+    if (m_regenerate_mask && this->get_comm()->am_trainer_master()) {
+      LBANN_WARNING(this->get_type(),
+                    " layer \"",
+                    this->get_name(),
+                    "\" ",
+                    "stores its dropout mask to guarantee sequential "
+                    "consistency");
+    }
+    m_regenerate_mask = false;
+#endif // LBANN_DETERMINISTIC
+    if (!m_regenerate_mask) {
+      m_mask =
+        std::unique_ptr<AbsDistMatrixType>(this->get_activations().Copy());
+    }
   }
 
   void setup_gpu() override
@@ -228,7 +263,13 @@ private:
 
   /** Probability of keeping each unit. */
   EvalType m_keep_prob;
-  /** Current dropout mask (a scaled Bernoulli random matrix). */
+  /** Whether to regenerate the mask in backprop instead of storing it. */
+  bool m_regenerate_mask;
+  /** Seed for the counter-based RNG used to generate the mask on CPU. */
+  uint64_t m_mask_seed = 0;
+  /** Current dropout mask (a scaled Bernoulli random matrix).
+   *  Not allocated if the mask is regenerated on CPU.
+   */
   std::unique_ptr<AbsDistMatrixType> m_mask;
 
 #ifdef LBANN_HAS_DNN_LIB
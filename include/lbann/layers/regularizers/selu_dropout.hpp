@@ -29,6 +29,7 @@
 
 #include "lbann/layers/data_type_layer.hpp"
 #include "lbann/layers/layer.hpp"
+#include "lbann/utils/counter_based_rng.hpp"
 
 namespace lbann {
 
@@ -39,6 +40,10 @@ namespace lbann {
  *  Gunter Klambauer, Thomas Unterthiner, Andreas Mayr, and Sepp
  *  Hochreiter. "Self-normalizing neural networks." In Advances in
  *  Neural Information Processing Systems, pp. 971-980. 2017.
+ *
+ *  If @c regenerate_mask is set, the mask is generated with a
+ *  counter-based RNG and recomputed during backprop, so only the RNG
+ *  seed is stored. This is only supported on CPU.
  */
 template <typename TensorDataType, data_layout T_layout, El::Device Dev>
 class selu_dropout final : public data_type_layer<TensorDataType>
@@ -61,7 +66,8 @@ public:
                TensorDataType alpha =
                  El::To<TensorDataType>(1.6732632423543772848170429916717),
                TensorDataType scale =
-                 El::To<TensorDataType>(1.0507009873554804934193349852946));
+                 El::To<TensorDataType>(1.0507009873554804934193349852946),
+               bool regenerate_mask = false);
 
   selu_dropout(const selu_dropout& other);
 
@@ -81,6 +87,11 @@ public:
 
   int get_backprop_requirements() const override { return ERROR_SIGNALS; }
 
+  /** @brief Regenerate the mask in backprop instead of storing it.
+   *  @details Must be called before setup.
+   */
+  void set_regenerate_mask(bool regenerate) { m_regenerate_mask = regenerate; }
+
   void setup_dims() final;
 
   void setup_data(size_t max_mini_batch_size) final;
@@ -113,7 +124,13 @@ private:
   TensorDataType m_b;
   /** Probability of keeping each unit. */
   TensorDataType m_keep_prob;
-  /** Current dropout mask (a scaled Bernoulli random matrix). */
+  /** Whether to regenerate the mask in backprop instead of storing it. */
+  bool m_regenerate_mask;
+  /** Seed for the counter-based RNG used to regenerate the mask. */
+  uint64_t m_mask_seed = 0;
+  /** Current dropout mask (a scaled Bernoulli random matrix).
+   *  Not allocated if the mask is regenerated.
+   */
   AbsDistMatrixType* m_mask;
 };
 
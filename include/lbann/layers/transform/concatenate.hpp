@@ -101,6 +101,7 @@ protected:
 
   void setup_pointers() override;
   void setup_dims() override;
+  void setup_buffer_aliasing() override;
 
   void fp_setup_outputs() override;
   void bp_setup_gradient_wrt_inputs() override;
@@ -111,6 +112,11 @@ private:
   /** @brief Tensor dimension to concatenate along. */
   size_t m_concat_dim;
 
+  /** @brief Whether any parent layer writes its output directly into
+   *  the output tensor.
+   */
+  bool m_has_aliased_parents = false;
+
 #ifdef LBANN_HAS_GPU
   /** @brief Workspace buffer.
    *
@@ -138,6 +144,14 @@ private:
 
   void bp_compute_subgrid();
 
+  /** @brief Copy the input tensors that are not already in place.
+   *
+   *  Parent layers that write directly into the output tensor are
+   *  skipped. Each input tensor is a contiguous range of rows in the
+   *  output tensor.
+   */
+  void fp_compute_aliased();
+
 #ifdef LBANN_HAS_DISTCONV
   friend class concatenate_distconv_adapter<TensorDataType, Layout, Device>;
 
@@ -304,6 +318,63 @@ void concatenate_layer<TensorDataType, Layout, Device>::setup_dims()
   this->set_output_dims(output_dims);
 }
 
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+void concatenate_layer<TensorDataType, Layout, Device>::setup_buffer_aliasing()
+{
+  data_type_layer<TensorDataType>::setup_buffer_aliasing();
+  m_has_aliased_parents = false;
+
+  // Each input tensor must be a contiguous range of rows in the
+  // output tensor
+  const auto& output_dims = this->get_output_dims();
+  if (Layout != data_layout::DATA_PARALLEL || this->distconv_enabled() ||
+      this->get_num_parents() < 2 ||
+      get_linear_size(m_concat_dim, output_dims.data()) > 1) {
+    return;
+  }
+
+  // Children that run in-place would overwrite parent activations
+  bool has_inplace_children = false;
+  for (int i = 0; i < this->get_num_children(); ++i) {
+    if (this->get_child_layer(i).runs_inplace()) {
+      has_inplace_children = true;
+    }
+  }
+
+  // Let parent layers write into the output tensor. Chains of
+  // in-place layers are followed up to the layer that allocates the
+  // buffer.
+  const auto is_compatible = [this](const Layer& l) {
+    return (l.supports_strided_tensors() && !l.distconv_enabled() &&
+            l.get_num_children() == 1 && l.get_data_layout() == Layout &&
+            l.get_device_allocation() == Device &&
+            l.get_grid_tag() == this->get_grid_tag());
+  };
+  El::Int offset = 0;
+  for (int j = 0; j < this->get_num_parents(); ++j) {
+    const Layer* owner = &this->get_parent_layer(j);
+    bool needs_activations = false;
+    bool compatible = true;
+    while (compatible) {
+      needs_activations = (needs_activations ||
+                           (owner->get_backprop_requirements() & ACTIVATIONS));
+      compatible = is_compatible(*owner);
+      if (!owner->runs_inplace()) {
+        break;
+      }
+      owner = &owner->get_parent_layer(0);
+    }
+    auto* dt_owner = dynamic_cast<data_type_layer<TensorDataType>*>(
+      const_cast<Layer*>(owner));
+    if (compatible && dt_owner != nullptr &&
+        !(has_inplace_children && needs_activations)) {
+      dt_owner->set_output_alias(0, this, offset);
+      m_has_aliased_parents = true;
+    }
+    offset += this->get_input_size(j);
+  }
+}
+
 template <typename TensorDataType, data_layout Layout, El::Device Device>
 void concatenate_layer<TensorDataType, Layout, Device>::fp_setup_outputs()
 {
@@ -311,6 +382,12 @@ void concatenate_layer<TensorDataType, Layout, Device>::fp_setup_outputs()
   if (!this->keep_original_outputs(0))
     return;
 #endif // LBANN_HAS_DISTCONV
+  // Parent layers have already allocated and written the output
+  // tensor
+  if (this->get_num_parents() > 1 && this->fp_setup_aliased_output()) {
+    return;
+  }
+
   const auto& input0 = this->get_prev_activations(0);
   auto& output = this->get_activations();
   output.Empty(false);
@@ -349,6 +426,27 @@ void concatenate_layer<TensorDataType, Layout, Device>::fp_compute_subgrid()
     syncSubGridCommunication);
 }
 
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+void concatenate_layer<TensorDataType, Layout, Device>::fp_compute_aliased()
+{
+  auto& output = this->get_activations();
+  std::unique_ptr<El::AbstractDistMatrix<TensorDataType>> output_v(
+    output.Construct(output.Grid(), output.Root()));
+  El::Int offset = 0;
+  for (int j = 0; j < this->get_num_parents(); ++j) {
+    const auto& input = this->get_prev_activations(j);
+    El::View(*output_v,
+             output,
+             El::IR(offset, offset + input.Height()),
+             El::ALL);
+    if (input.LockedBuffer() != output_v->LockedBuffer() ||
+        input.LDim() != output_v->LDim()) {
+      El::Copy(input, *output_v);
+    }
+    offset += input.Height();
+  }
+}
+
 template <typename TensorDataType, data_layout Layout, El::Device Device>
 void concatenate_layer<TensorDataType, Layout, Device>::bp_compute_subgrid()
 {
@@ -414,6 +512,9 @@ void concatenate_layer<TensorDataType, Layout, Device>::fp_compute()
   if (m_concat_dim == num_dims - 1 && this->subgraph_parallelism_execution()) {
     this->fp_compute_subgrid();
   }
+  else if (m_has_aliased_parents) {
+    this->fp_compute_aliased();
+  }
   else {
     fp_compute_impl(*this, m_concat_dim);
   }
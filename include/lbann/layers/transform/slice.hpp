@@ -96,6 +96,7 @@ protected:
   slice_layer() : slice_layer(nullptr) {}
 
   void setup_dims() override;
+  void setup_buffer_aliasing() override;
 
   void fp_setup_outputs() override;
   void bp_setup_gradient_wrt_inputs() override;
@@ -113,6 +114,8 @@ private:
   bool m_set_slice_points_from_data_reader;
   /** Category for retrieving slice points from data reader */
   slice_points_mode m_var_category;
+  /** Whether output tensors are views into the input tensor. */
+  bool m_outputs_view_input = false;
 
 #ifdef LBANN_HAS_GPU
   /** @brief Workspace buffer.
@@ -237,6 +240,24 @@ void fp_setup_outputs_impl(
 
   const size_t num_outputs = l.get_num_children();
   const auto& input = l.get_prev_activations();
+
+  // Each output tensor is a contiguous range of rows in the input
+  // tensor, so child layers can read it in place
+  if (l.m_outputs_view_input) {
+    const auto& input_dims = l.get_input_dims();
+    const size_t stride = l.get_input_size() / input_dims[l.m_slice_dim];
+    size_t offset = l.m_slice_points.front() * stride;
+    for (size_t j = 0; j < num_outputs; ++j) {
+      const size_t output_size = l.get_output_size(j);
+      El::LockedView(l.get_activations(j),
+                     input,
+                     El::IR(offset, offset + output_size),
+                     El::ALL);
+      offset += output_size;
+    }
+    return;
+  }
+
   for (size_t j = 0; j < num_outputs; ++j) {
     auto& output = l.get_activations(j);
     // output.AlignWith(input);
@@ -322,6 +343,11 @@ void slice_layer<TensorDataType, Layout, Device>::fp_compute()
   const auto& input_dims = this->get_input_dims();
   const size_t num_dims = input_dims.size();
 
+  // Output tensors are views into the input tensor
+  if (m_outputs_view_input) {
+    return;
+  }
+
   if (this->m_slice_dim == num_dims - 1 &&
       this->subgraph_parallelism_execution()) {
     fp_compute_subgrid();
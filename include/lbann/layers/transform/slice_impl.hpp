@@ -29,6 +29,7 @@
 
 #include "lbann/data_ingestion/data_coordinator.hpp"
 #include "lbann/layers/transform/slice.hpp"
+#include "lbann/utils/dim_helpers.hpp"
 
 namespace lbann {
 
@@ -129,6 +130,33 @@ void slice_layer<TensorDataType, Layout, Device>::setup_dims()
   }
 }
 
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+void slice_layer<TensorDataType, Layout, Device>::setup_buffer_aliasing()
+{
+  data_type_layer<TensorDataType>::setup_buffer_aliasing();
+  m_outputs_view_input = false;
+
+  // Each output tensor must be a contiguous range of rows in the
+  // input tensor
+  const auto& input_dims = this->get_input_dims();
+  if (Layout != data_layout::DATA_PARALLEL || this->distconv_enabled() ||
+      input_dims[m_slice_dim] < 1 ||
+      get_linear_size(m_slice_dim, input_dims.data()) > 1) {
+    return;
+  }
+
+  // Child layers must read strided tensors and must not write into
+  // their inputs
+  for (int i = 0; i < this->get_num_children(); ++i) {
+    const auto& child = this->get_child_layer(i);
+    if (!child.supports_strided_tensors() || child.runs_inplace() ||
+        child.distconv_enabled()) {
+      return;
+    }
+  }
+  m_outputs_view_input = true;
+}
+
 } // namespace lbann
 
 #endif // LBANN_LAYER_SLICE_IMPL_HPP_INCLUDED
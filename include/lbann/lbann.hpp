@@ -35,6 +35,7 @@
 
 /// Training Algorithms
 #include "lbann/execution_algorithms/batch_functional_inference_algorithm.hpp"
+#include "lbann/execution_algorithms/inference_server.hpp"
 #include "lbann/execution_algorithms/training_algorithm.hpp"
 
 /// Models
@@ -66,10 +67,12 @@
 #include "lbann/layers/loss/l2_norm2.hpp"
 #include "lbann/layers/loss/mean_absolute_error.hpp"
 #include "lbann/layers/loss/mean_squared_error.hpp"
+#include "lbann/layers/loss/softmax_cross_entropy.hpp"
 #include "lbann/layers/loss/top_k_categorical_accuracy.hpp"
 
 /// Math layers
 #include "lbann/layers/math/matmul.hpp"
+#include "lbann/layers/math/scaled_dot_product_attention.hpp"
 
 /// Transform layers
 #include "lbann/layers/transform/bernoulli.hpp"
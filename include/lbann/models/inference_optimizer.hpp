@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef LBANN_MODELS_INFERENCE_OPTIMIZER_HPP_INCLUDED
+#define LBANN_MODELS_INFERENCE_OPTIMIZER_HPP_INCLUDED
+
+#include "lbann/base.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace lbann {
+
+// Forward declarations
+class model;
+
+/** @brief Summary of the rewrites applied by @c optimize_for_inference. */
+struct inference_optimization_summary
+{
+  /** @brief Batch normalization layers folded into the weights of a
+   *  preceding convolution or fully-connected layer. */
+  size_t num_folded_normalizations = 0;
+  /** @brief Layers that are the identity at inference (dropout,
+   *  identity, stop-gradient) and were removed. */
+  size_t num_removed_layers = 0;
+  /** @brief Operator layers merged into the preceding operator layer. */
+  size_t num_fused_operator_layers = 0;
+
+  size_t num_rewrites() const noexcept
+  {
+    return (num_folded_normalizations + num_removed_layers +
+            num_fused_operator_layers);
+  }
+};
+
+/** @brief Rewrite a trained model's layer graph for inference.
+ *
+ *  The following rewrites are applied:
+ *
+ *  - Batch normalization layers that directly follow a convolution
+ *    or data-parallel fully-connected layer are folded into that
+ *    layer's weights and bias, using the running statistics.
+ *
+ *  - Dropout, SELU dropout, identity and stop-gradient layers are
+ *    removed.
+ *
+ *  - Chains of operator layers are merged into a single layer that
+ *    applies the operators one after the other in place.
+ *
+ *  Layers referenced by the objective function or by metrics, and
+ *  layers that share weights with other layers, are left untouched. The model must be set up; it is set up again
+ *  after rewriting. The rewritten model computes the same outputs as
+ *  the original one in inference mode, but can no longer be trained.
+ *
+ *  @param m     Model to rewrite.
+ *  @param grids Process grids used to set up the model.
+ */
+inference_optimization_summary
+optimize_for_inference(model& m, std::vector<El::Grid*> const& grids);
+
+} // namespace lbann
+
+#endif // LBANN_MODELS_INFERENCE_OPTIMIZER_HPP_INCLUDED
@@ -446,6 +446,26 @@ public:
                   EvalType backoff_factor = 0.5,
                   size_t growth_interval = 2000);
 
+  // ===========================================
+  // Forward-only execution
+  // ===========================================
+
+  /** @brief Return true if the model only runs forward propagation. */
+  bool is_forward_only() const noexcept;
+  /** @brief Restrict the model to forward propagation.
+   *
+   *  Takes effect at the next setup. A forward-only model does not
+   *  construct error signal matrices, drops the optimizers of its
+   *  weights, and releases each layer's activations as soon as its
+   *  children have consumed them. Only the inputs of layers without
+   *  children (e.g. dummy layers) and the outputs of layers marked
+   *  with @c Layer::set_keep_activations are kept after forward
+   *  prop, so peak activation memory depends on the widest part of
+   *  the graph rather than its depth. The model cannot be trained.
+   *  The mode is not saved in checkpoints.
+   */
+  void set_forward_only(bool forward_only) noexcept;
+
   // ===========================================
   // Callbacks
   // ===========================================
@@ -579,6 +599,9 @@ private:
    */
   bool m_model_is_setup = false;
 
+  /** @brief Whether the model only runs forward propagation. */
+  bool m_forward_only = false;
+
   /** @brief Whether automatic mixed precision (AMP) is enabled. */
   bool m_amp_enabled = false;
   /** @brief Scale factor for AMP loss scaling. */
@@ -813,6 +836,13 @@ inline EvalType model::get_amp_scale_factor() const noexcept
   return m_amp_scale_factor;
 }
 
+inline bool model::is_forward_only() const noexcept { return m_forward_only; }
+
+inline void model::set_forward_only(bool forward_only) noexcept
+{
+  m_forward_only = forward_only;
+}
+
 } // namespace lbann
 
 #endif // LBANN_MODELS_MODEL_HPP_INCLUDED
@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_MODELS_SHARDED_WEIGHTS_PREFETCHER_HPP_INCLUDED
+#define LBANN_MODELS_SHARDED_WEIGHTS_PREFETCHER_HPP_INCLUDED
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace lbann {
+
+// Forward declarations
+class Layer;
+class model;
+class weights;
+
+/** @brief Gathers sharded weights ahead of the layers that use them.
+ *
+ *  Before a layer runs, non-blocking gathers are started for the
+ *  sharded weights of the next few layers in execution order, as long
+ *  as the full weights that have been requested but not yet released
+ *  fit in a memory budget. Layers wait on the gathers right before
+ *  their compute functions, so the communication overlaps with the
+ *  computation of the preceding layers.
+ */
+class sharded_weights_prefetcher
+{
+public:
+  /** @param layers Layers in execution order.
+   *  @param depth  Number of layers to look ahead. 0 disables
+   *                prefetching.
+   *  @param budget Maximum memory in bytes of requested full
+   *                weights. 0 means no limit.
+   */
+  sharded_weights_prefetcher(std::vector<Layer*> layers,
+                             size_t depth,
+                             size_t budget);
+
+  /** @brief Request weights of the layers following position @c pos. */
+  void prefetch(size_t pos);
+
+  /** @brief Release weights requested for layers up to position @c pos.
+   *
+   *  Layers release their weights after computing, so this only
+   *  matters for layers that were skipped.
+   */
+  void release(size_t pos);
+
+  /** @brief Release all outstanding requests. */
+  void finish();
+
+  /** @brief Whether a gather of @c w has been requested and not yet
+   *  released. */
+  bool is_requested(weights const& w) const;
+
+  /** @brief Memory in bytes of the outstanding requests. */
+  size_t get_requested_memory_size() const noexcept { return m_bytes; }
+
+private:
+  std::vector<Layer*> m_layers;
+  size_t m_depth;
+  size_t m_budget;
+  /** Next layer position whose weights have not been considered. */
+  size_t m_next = 0;
+  /** Memory in bytes of outstanding requests. */
+  size_t m_bytes = 0;
+  /** Outstanding requests with the position of the requesting layer. */
+  std::vector<std::pair<size_t, weights const*>> m_requested;
+};
+
+/** @brief Construct a prefetcher from the command-line options.
+ *
+ *  Uses --sharded_weights_prefetch_depth and
+ *  --sharded_weights_prefetch_budget (in MiB). Prefetching is disabled
+ *  with sub-graph parallelism since layers do not run on all
+ *  processes.
+ *
+ *  @param reverse Visit the layers in reverse order, for backprop.
+ */
+sharded_weights_prefetcher make_sharded_weights_prefetcher(model& m,
+                                                           bool reverse);
+
+} // namespace lbann
+
+#endif // LBANN_MODELS_SHARDED_WEIGHTS_PREFETCHER_HPP_INCLUDED
@@ -81,9 +81,10 @@
     void do_fill_description(description&) const final {}                      \
   }
 
-#define LBANN_DECLARE_STATELESS_ELEMENTWISE_OPERATOR(OP_NAME,                  \
-                                                     OP_STRING,                \
-                                                     NEEDS_PREVACTS)           \
+#define LBANN_STATELESS_ELEMENTWISE_OPERATOR_CLASS(OP_NAME,                    \
+                                                   OP_STRING,                  \
+                                                   NEEDS_PREVACTS,             \
+                                                   EXTRA_DECLS)                \
   template <typename DataT, El::Device D>                                      \
   class OP_NAME##Operator final                                                \
     : public Cloneable<OP_NAME##Operator<DataT, D>,                            \
@@ -118,6 +119,7 @@
       ar(::cereal::make_nvp("ElementwiseOperator",                             \
                             ::cereal::base_class<OperatorType>(this)));        \
     }                                                                          \
+    EXTRA_DECLS                                                                \
                                                                                \
   private:                                                                     \
     void                                                                       \
@@ -134,4 +136,30 @@
     void do_fill_description(description&) const final {}                      \
   }
 
+#define LBANN_DECLARE_STATELESS_ELEMENTWISE_OPERATOR(OP_NAME,                  \
+                                                     OP_STRING,                \
+                                                     NEEDS_PREVACTS)           \
+  LBANN_STATELESS_ELEMENTWISE_OPERATOR_CLASS(OP_NAME,                          \
+                                             OP_STRING,                        \
+                                             NEEDS_PREVACTS, )
+
+// Single-input operators also provide block kernels on raw CPU
+// buffers, so chains of them can be fused by OperatorLayer. This is
+// also used by the operators with a constant argument.
+#define LBANN_STATELESS_BLOCK_KERNEL_DECLS                                     \
+  bool has_block_kernels() const final { return D == El::Device::CPU; }        \
+  void fp_compute_block(DataT const* x, DataT* y, El::Int n) const final;      \
+  void bp_compute_block(DataT const* x,                                        \
+                        DataT const* dy,                                       \
+                        DataT* dx,                                             \
+                        El::Int n) const final;
+
+#define LBANN_DECLARE_STATELESS_UNARY_OPERATOR(OP_NAME,                        \
+                                               OP_STRING,                      \
+                                               NEEDS_PREVACTS)                 \
+  LBANN_STATELESS_ELEMENTWISE_OPERATOR_CLASS(OP_NAME,                          \
+                                             OP_STRING,                        \
+                                             NEEDS_PREVACTS,                   \
+                                             LBANN_STATELESS_BLOCK_KERNEL_DECLS)
+
 #endif // LBANN_INCLUDE_LBANN_OPERATORS_DECLARE_STATELESS_OP_HPP_INCLUDED
@@ -131,6 +131,38 @@ public:
   }
 
   ///@}
+  /** @name Block compute interface */
+  ///@{
+
+  /** @brief Whether the operator provides block kernels.
+   *  @details Block kernels apply a single-input operator to a
+   *           contiguous range of host memory. They let a chain of
+   *           operators be evaluated one cache-resident block at a
+   *           time.
+   */
+  virtual bool has_block_kernels() const { return false; }
+
+  /** @brief Apply the forward operation to @c n contiguous entries.
+   *  @details @c x and @c y may alias.
+   */
+  virtual void
+  fp_compute_block(InputT const* /*x*/, OutputT* /*y*/, El::Int /*n*/) const
+  {
+    LBANN_ERROR("operator \"", this->get_type(), "\" has no block kernels");
+  }
+
+  /** @brief Apply the backward operation to @c n contiguous entries.
+   *  @details @c dy and @c dx may alias.
+   */
+  virtual void bp_compute_block(InputT const* /*x*/,
+                                OutputT const* /*dy*/,
+                                InputT* /*dx*/,
+                                El::Int /*n*/) const
+  {
+    LBANN_ERROR("operator \"", this->get_type(), "\" has no block kernels");
+  }
+
+  ///@}
 
 protected:
   /** @name Lifecycle management. */
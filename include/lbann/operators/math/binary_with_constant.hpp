@@ -44,6 +44,7 @@
  *  for such an ephemeral operation.
  */
 
+#include "lbann/operators/declare_stateless_op.hpp"
 #include "lbann/operators/elementwise_operator.hpp"
 #include "lbann/operators/operator.hpp"
 #include "lbann/utils/cloneable.hpp"
@@ -93,6 +94,7 @@
          CEREAL_NVP(m_constant));                                              \
     }                                                                          \
     DataT get_constant() const noexcept { return m_constant; }                 \
+    LBANN_STATELESS_BLOCK_KERNEL_DECLS                                         \
                                                                                \
   private:                                                                     \
     void                                                                       \
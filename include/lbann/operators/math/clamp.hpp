@@ -105,6 +105,17 @@ public:
   DataT get_min() const noexcept { return m_min; }
   DataT get_max() const noexcept { return m_max; }
 
+  ///@}
+  /** @name Block compute interface */
+  ///@{
+
+  bool has_block_kernels() const final { return D == El::Device::CPU; }
+  void fp_compute_block(DataT const* x, DataT* y, El::Int n) const final;
+  void bp_compute_block(DataT const* x,
+                        DataT const* dy,
+                        DataT* dx,
+                        El::Int n) const final;
+
   ///@}
   /** @name Serialization */
   ///@{
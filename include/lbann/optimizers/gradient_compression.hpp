@@ -0,0 +1,290 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_OPTIMIZERS_GRADIENT_COMPRESSION_HPP_INCLUDED
+#define LBANN_OPTIMIZERS_GRADIENT_COMPRESSION_HPP_INCLUDED
+
+#include "lbann/base.hpp"
+#include "lbann/comm_nb_request.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace lbann {
+
+// Forward declarations
+class lbann_comm;
+
+/** @brief Compression applied to gradients before data-parallel
+ *  synchronization.
+ */
+enum class gradient_compression_type
+{
+  /** @brief Full-precision allreduce. */
+  none,
+  /** @brief Allreduce in IEEE half precision with dynamic scaling. */
+  fp16,
+  /** @brief Allreduce in bfloat16. */
+  bf16,
+  /** @brief Allgather of the largest-magnitude entries on each rank. */
+  top_k,
+  /** @brief Allreduce of a random subset of entries shared by all ranks. */
+  random_k,
+};
+
+/** @brief Human-readable name of gradient compression type. */
+std::string to_string(gradient_compression_type type);
+
+/** @brief Per-weights gradient compression settings. */
+struct gradient_compression_config
+{
+  gradient_compression_type type = gradient_compression_type::none;
+  /** @brief Fraction of entries sent by the sparsifying compressors. */
+  double ratio = 0.01;
+  /** @brief Accumulate the unsent part of the gradient into the next
+   *  step (sparsifying compressors only).
+   */
+  bool error_feedback = true;
+  /** @brief Seed for random-k index selection.
+   *  @details Must match on all ranks.
+   */
+  uint64_t seed = 0;
+};
+
+namespace gradient_compression {
+
+/** @brief Convert float to IEEE binary16 bits (round to nearest even). */
+inline uint16_t float_to_half_bits(float f) noexcept
+{
+  uint32_t x;
+  std::memcpy(&x, &f, sizeof(x));
+  const uint32_t sign = (x >> 16) & 0x8000u;
+  uint32_t absx = x & 0x7FFFFFFFu;
+  if (absx >= 0x7F800000u) {
+    // Inf or NaN (keep NaNs quiet)
+    return static_cast<uint16_t>(sign | 0x7C00u |
+                                 (absx > 0x7F800000u ? 0x200u : 0u));
+  }
+  if (absx >= 0x477FF000u) {
+    // Rounds past largest finite half (65504)
+    return static_cast<uint16_t>(sign | 0x7C00u);
+  }
+  if (absx < 0x38800000u) {
+    // Subnormal half: let the FPU round to a multiple of 2^-24
+    float a;
+    std::memcpy(&a, &absx, sizeof(a));
+    a += 0.5f;
+    uint32_t bits;
+    std::memcpy(&bits, &a, sizeof(bits));
+    return static_cast<uint16_t>(sign | (bits - 0x3F000000u));
+  }
+  const uint32_t mant_odd = (absx >> 13) & 1u;
+  absx += 0xC8000000u + 0xFFFu + mant_odd; // Rebias exponent and round
+  return static_cast<uint16_t>(sign | (absx >> 13));
+}
+
+/** @brief Convert IEEE binary16 bits to float. */
+inline float half_bits_to_float(uint16_t h) noexcept
+{
+  const uint32_t sign = static_cast<uint32_t>(h & 0x8000u) << 16;
+  const uint32_t exp = (h >> 10) & 0x1Fu;
+  const uint32_t mant = h & 0x3FFu;
+  uint32_t bits;
+  if (exp == 0) {
+    const float a = static_cast<float>(mant) * 5.9604644775390625e-8f; // 2^-24
+    std::memcpy(&bits, &a, sizeof(bits));
+    bits |= sign;
+  }
+  else if (exp == 0x1Fu) {
+    bits = sign | 0x7F800000u | (mant << 13);
+  }
+  else {
+    bits = sign | ((exp + 112u) << 23) | (mant << 13);
+  }
+  float f;
+  std::memcpy(&f, &bits, sizeof(f));
+  return f;
+}
+
+/** @brief Convert float to bfloat16 bits (round to nearest even). */
+inline uint16_t float_to_bfloat16_bits(float f) noexcept
+{
+  uint32_t x;
+  std::memcpy(&x, &f, sizeof(x));
+  if ((x & 0x7FFFFFFFu) > 0x7F800000u) {
+    return static_cast<uint16_t>((x >> 16) | 0x40u);
+  }
+  x += 0x7FFFu + ((x >> 16) & 1u);
+  return static_cast<uint16_t>(x >> 16);
+}
+
+/** @brief Convert bfloat16 bits to float. */
+inline float bfloat16_bits_to_float(uint16_t b) noexcept
+{
+  const uint32_t bits = static_cast<uint32_t>(b) << 16;
+  float f;
+  std::memcpy(&f, &bits, sizeof(f));
+  return f;
+}
+
+/** @brief Number of entries sent by a sparsifying compressor. */
+size_t num_sparse_entries(size_t size, double ratio);
+
+/** @brief Find the @c k entries of largest magnitude.
+ *
+ *  On exit, the first @c k entries of @c indices hold the selected
+ *  positions in unspecified order. NaNs are treated as larger than
+ *  any other value so that they are always sent. @c indices is
+ *  reused across calls to avoid reallocation.
+ */
+template <typename T>
+void select_top_k(const T* values,
+                  size_t size,
+                  size_t k,
+                  std::vector<uint32_t>& indices);
+
+} // namespace gradient_compression
+
+/** @brief Compressed sum of a gradient over a communicator.
+ *
+ *  Replaces the full-precision in-place allreduce of a contiguous CPU
+ *  gradient buffer. The low-precision casts reduce with a custom MPI
+ *  operation that adds two partial sums in single precision and
+ *  rounds the result back to 16 bits, so rounding errors grow with
+ *  the number of ranks.
+ *
+ *  Half precision scales the gradient by a power of two chosen from
+ *  the largest magnitude of the previous synchronized gradient. That
+ *  gradient is the same on every rank, so the scale needs no extra
+ *  communication. The first gradient is summed at full precision to
+ *  choose the initial scale. If the half-precision sum is not finite,
+ *  either because it overflowed or because the gradient contains Inf
+ *  or NaN (e.g. when a mixed-precision loss scale is too large),
+ *  @c finish sums the gradient again at full precision so an overflow
+ *  is still visible to the caller.
+ *
+ *  The sparsifying compressors send a fraction of the entries and,
+ *  with error feedback, keep the unsent remainder in a residual
+ *  buffer that is added to the next gradient.
+ *
+ *  Each compressor holds persistent state for one gradient buffer,
+ *  so there should be one instance per weights.
+ */
+template <typename T>
+class gradient_compressor
+{
+public:
+  gradient_compressor(gradient_compression_config const& config);
+
+  gradient_compression_type get_type() const noexcept
+  {
+    return m_config.type;
+  }
+
+  /** @brief Launch the compressed allreduce of @c data.
+   *
+   *  @c data must stay valid until @c finish is called and must not
+   *  be accessed in between. Since MPI counts are ints, @c size must
+   *  not exceed @c INT_MAX.
+   */
+  void start(lbann_comm& comm,
+             T* data,
+             size_t size,
+             El::mpi::Comm const& c,
+             Al::request& req);
+
+  /** @brief Write the synchronized gradient back to the buffer.
+   *
+   *  Must be called after the request passed to @c start has
+   *  completed. Does nothing if no synchronization is in flight.
+   *  Runs a blocking full-precision allreduce if a half-precision sum
+   *  is not finite.
+   */
+  void finish();
+
+  /** @brief Unsent gradient carried over to the next step.
+   *
+   *  Empty unless a sparsifying compressor with error feedback has
+   *  been started.
+   */
+  std::vector<T> const& get_residual() const noexcept { return m_residual; }
+
+private:
+  gradient_compression_config m_config;
+
+  /** @brief Buffer being synchronized (null if none). */
+  T* m_data = nullptr;
+  size_t m_size = 0;
+  /** @brief Communicators of the synchronization in flight. */
+  lbann_comm* m_comm = nullptr;
+  El::mpi::Comm const* m_mpi_comm = nullptr;
+  /** @brief Size of the redundant communicator. */
+  int m_comm_size = 1;
+  /** @brief The full-precision allreduce was used instead. */
+  bool m_passthrough = false;
+
+  /** @brief Encoded values for the low-precision casts. */
+  std::vector<uint16_t> m_packed;
+  /** @brief Power-of-two scale applied before the half cast. */
+  float m_scale = 1.f;
+  /** @brief Whether @c m_scale has been chosen. */
+  bool m_has_scale = false;
+
+  /** @brief Unsent gradient for error feedback. */
+  std::vector<T> m_residual;
+  /** @brief Top-k workspace or random-k permutation. */
+  std::vector<uint32_t> m_indices;
+  /** @brief Number of sparse entries per rank. */
+  size_t m_num_entries = 0;
+  /** @brief Packed (indices, values) sent by top-k. */
+  std::vector<unsigned char> m_send_buffer;
+  /** @brief Packed (indices, values) from all ranks. */
+  std::vector<unsigned char> m_recv_buffer;
+  /** @brief Values reduced by random-k. */
+  std::vector<T> m_values;
+  /** @brief Generates the random-k indices in lockstep on all ranks. */
+  std::mt19937_64 m_rng;
+
+  void start_cast(lbann_comm& comm, El::mpi::Comm const& c, Al::request& req);
+  void start_top_k(lbann_comm& comm, El::mpi::Comm const& c, Al::request& req);
+  void start_random_k(lbann_comm& comm,
+                      El::mpi::Comm const& c,
+                      Al::request& req);
+  /** @brief Choose the half-precision scale from the synchronized
+   *  gradient. */
+  void update_half_scale();
+  /** @brief Add the residual to the gradient. */
+  void apply_residual();
+  /** @brief Store the gradient as the residual minus the sent entries. */
+  void update_residual(const uint32_t* sent, size_t num_sent);
+};
+
+} // namespace lbann
+
+#endif // LBANN_OPTIMIZERS_GRADIENT_COMPRESSION_HPP_INCLUDED
@@ -29,6 +29,7 @@
 
 #include "lbann/base.hpp"
 #include "lbann/comm_nb_request.hpp"
+#include "lbann/optimizers/gradient_compression.hpp"
 #include "lbann/utils/cloneable.hpp"
 #include "lbann/utils/compiler_control.hpp"
 #ifdef LBANN_HAS_GPU
@@ -261,6 +262,18 @@ public:
 
   void inc_step_time(EvalType time) { m_step_time += time; }
 
+  /** @brief Compression applied to the gradient before it is
+   *  synchronized across the data-parallel ranks.
+   */
+  gradient_compression_config const& get_gradient_compression() const noexcept
+  {
+    return m_gradient_compression;
+  }
+  void set_gradient_compression(gradient_compression_config const& config)
+  {
+    m_gradient_compression = config;
+  }
+
   /** Are parent weights sharded across ranks? */
   virtual bool is_sharded() const = 0;
 
@@ -316,6 +329,9 @@ private:
   /** @brief Time spent in optimization step. */
   EvalType m_step_time = 0;
 
+  /** @brief Gradient compression settings. */
+  gradient_compression_config m_gradient_compression;
+
   /** @brief Map from data types to gradient contributions.
    *  @todo Refactor this out. It's a hack.
    */
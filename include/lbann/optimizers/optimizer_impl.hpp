@@ -27,9 +27,15 @@
 #ifndef LBANN_OPTIMIZERS_OPTIMIZER_IMPL_HPP_INCLUDED
 #define LBANN_OPTIMIZERS_OPTIMIZER_IMPL_HPP_INCLUDED
 
+#include "lbann/comm_impl.hpp"
 #include "lbann/optimizers/optimizer.hpp"
 #include "lbann/utils/exception.hpp"
 #include "lbann/utils/profiling.hpp"
+#include "lbann/utils/tracing.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
 
 namespace lbann {
 
@@ -39,12 +45,21 @@ class GradientHelperImpl : public optimizer::GradientHelper
 public:
   using AbsDistMatType = El::AbstractDistMatrix<TensorDataType>;
 
+private:
+  /** Gradient compression is implemented for float and double. */
+  static constexpr bool is_compressible =
+    std::is_same_v<TensorDataType, float> ||
+    std::is_same_v<TensorDataType, double>;
+  using compressed_type =
+    std::conditional_t<is_compressible, TensorDataType, float>;
+
 public:
   GradientHelperImpl(El::Int height,
                      El::Int width,
                      El::DistData dist_data,
                      El::DistData grad_dist_data,
-                     bool sharded_weights)
+                     bool sharded_weights,
+                     gradient_compression_config const& compression = {})
     : local_gradient_contrib_{AbsDistMatType::Instantiate(dist_data)},
       global_gradient_{AbsDistMatType::Instantiate(grad_dist_data)},
       sharded_weights_{sharded_weights}
@@ -54,6 +69,7 @@ public:
     if (sharded_weights_) {
       El::Zeros(*global_gradient_, height, width);
     }
+    setup_compression(compression);
   }
 
   void ensure_gradient_memory(El::Int height, El::Int width) override
@@ -112,33 +128,32 @@ public:
     }
 
     switch (this->get_status()) {
-    case optimizer_gradient_status::sync_needed:
+    case optimizer_gradient_status::sync_needed: {
+      LBANN_TRACE_SCOPE("allreduce_start", comm);
       // Sharded gradients are produced from a reduce-scatter on the local
       // contributions, non-sharded gradients use allreduce
-      if (!sharded_weights_) {
+      if (!sharded_weights_ && use_compression()) {
+        start_compressed_sync(comm);
+      }
+      else if (!sharded_weights_) {
         comm.nb_allreduce(*global_gradient_,
                           global_gradient_->RedundantComm(),
                           sync_req_);
       }
+      else if (can_reduce_scatter()) {
+        start_reduce_scatter(comm);
+      }
       else {
-        // Reduce the local contributions and scatter the results
-        // to the global gradient. The implementation below uses
-        // allreduce temporarily.
+        // Other distributions reduce the full local contributions and
+        // copy out the shard once the allreduce completes
         comm.nb_allreduce(*local_gradient_contrib_,
                           local_gradient_contrib_->RedundantComm(),
                           sync_req_);
-
-        // TODO: Call reduce-scatter directly (currently fails)
-        /*
-        comm.nb_reduce_scatter(*local_gradient_contrib_,
-                               *global_gradient_,
-                               global_gradient_->RedundantComm(),
-                               sync_req_);
-        */
       }
       this->set_status(optimizer_gradient_status::sync_started);
       lastsync = this;
       break;
+    }
     case optimizer_gradient_status::ready:
     case optimizer_gradient_status::cleared:
     case optimizer_gradient_status::sync_started:
@@ -157,10 +172,17 @@ public:
     }
 
     switch (this->get_status()) {
-    case optimizer_gradient_status::sync_started:
+    case optimizer_gradient_status::sync_started: {
+      LBANN_TRACE_SCOPE("allreduce_wait", comm);
       comm.wait(sync_req_);
-      if (sharded_weights_) {
-        // TODO: When reduce-scatter is called in start_sync, remove this copy
+      if (compressor_ != nullptr) {
+        compressor_->finish();
+      }
+      if (sharded_weights_ && reduce_scatter_pending_) {
+        unpack_reduce_scatter();
+        local_gradient_contrib_->Empty();
+      }
+      else if (sharded_weights_) {
         El::Copy(*local_gradient_contrib_, *global_gradient_);
 
         // Free up memory
@@ -169,6 +191,7 @@ public:
 
       this->set_status(optimizer_gradient_status::ready);
       break;
+    }
     case optimizer_gradient_status::ready:
     case optimizer_gradient_status::cleared:
       break;
@@ -191,6 +214,155 @@ public:
   }
 
 private:
+  /** Create the gradient compressor if the configuration supports it. */
+  void setup_compression(gradient_compression_config const& compression)
+  {
+    if (compression.type == gradient_compression_type::none) {
+      return;
+    }
+    if constexpr (is_compressible) {
+      if (sharded_weights_) {
+        LBANN_WARNING("gradient compression is not supported for sharded "
+                      "weights, using full-precision synchronization");
+      }
+      else if (local_gradient_contrib_->GetLocalDevice() !=
+               El::Device::CPU) {
+        LBANN_WARNING("gradient compression is only supported for CPU "
+                      "gradients, using full-precision synchronization");
+      }
+      else {
+        compressor_ =
+          std::make_unique<gradient_compressor<TensorDataType>>(compression);
+      }
+    }
+    else {
+      LBANN_WARNING("gradient compression is only supported for float and "
+                    "double gradients, using full-precision synchronization");
+    }
+  }
+
+  /** Whether the next synchronization should go through the compressor. */
+  bool use_compression() const
+  {
+    if (compressor_ == nullptr ||
+        El::mpi::Size(global_gradient_->RedundantComm()) == 1) {
+      return false;
+    }
+    auto const& grad = global_gradient_->LockedMatrix();
+    return (grad.Height() == grad.LDim() || grad.Width() == 1);
+  }
+
+  void start_compressed_sync(lbann_comm& comm)
+  {
+    if constexpr (is_compressible) {
+      auto& grad = global_gradient_->Matrix();
+      compressor_->start(comm,
+                         grad.Buffer(),
+                         grad.Height() * grad.Width(),
+                         global_gradient_->RedundantComm(),
+                         sync_req_);
+    }
+  }
+
+  /** Whether the local contributions can be reduced directly into the
+   *  gradient shard. Like the packed allgather of sharded weights,
+   *  this requires a CPU shard that owns a strided subset of the
+   *  columns (or entries, for column vectors).
+   */
+  bool can_reduce_scatter() const
+  {
+    if constexpr (is_compressible) {
+      const auto& contrib = *local_gradient_contrib_;
+      const auto& grad = *global_gradient_;
+      if (contrib.GetLocalDevice() != El::Device::CPU ||
+          grad.GetLocalDevice() != El::Device::CPU ||
+          contrib.ColDist() != El::STAR || contrib.RowDist() != El::STAR ||
+          grad.Wrap() != El::ELEMENT || contrib.Grid() != grad.Grid() ||
+          grad.Grid().VCSize() == 1) {
+        return false;
+      }
+      const bool shard_cols =
+        (grad.ColDist() == El::STAR && grad.RowDist() == El::VC);
+      const bool shard_rows = (grad.ColDist() == El::VC &&
+                               grad.RowDist() == El::STAR && grad.Width() == 1);
+      if (!shard_cols && !shard_rows) {
+        return false;
+      }
+      const El::Int num_procs = grad.Grid().VCSize();
+      const El::Int slice_size = shard_cols ? grad.Height() : 1;
+      const El::Int num_slices = shard_cols ? grad.Width() : grad.Height();
+      const El::Int count = slice_size * El::MaxLength(num_slices, num_procs);
+      return count * num_procs <= std::numeric_limits<int>::max();
+    }
+    else {
+      return false;
+    }
+  }
+
+  /** Pack the local contributions by owning rank, padded to the
+   *  largest shard, and start a reduce-scatter into the shard.
+   */
+  void start_reduce_scatter(lbann_comm& comm)
+  {
+    if constexpr (is_compressible) {
+      const auto& grad = *global_gradient_;
+      const auto& contrib = local_gradient_contrib_->LockedMatrix();
+      const bool shard_cols = (grad.RowDist() == El::VC);
+      const El::Int slice_size = shard_cols ? grad.Height() : 1;
+      const El::Int num_slices = shard_cols ? grad.Width() : grad.Height();
+      const El::Int align = shard_cols ? grad.RowAlign() : grad.ColAlign();
+      const El::Int num_procs = grad.Grid().VCSize();
+      const El::Int count = slice_size * El::MaxLength(num_slices, num_procs);
+      scatter_send_buffer_.Resize(count * num_procs, 1);
+      scatter_recv_buffer_.Resize(count, 1);
+      auto* send_buf = scatter_send_buffer_.Buffer();
+      for (El::Int rank = 0; rank < num_procs; ++rank) {
+        const El::Int shift = El::Shift(rank, align, num_procs);
+        const El::Int rank_slices = El::Length(num_slices, shift, num_procs);
+        auto* rank_buf = send_buf + rank * count;
+        for (El::Int k = 0; k < rank_slices; ++k) {
+          const El::Int slice_index = shift + k * num_procs;
+          const auto* slice = shard_cols ? contrib.LockedBuffer(0, slice_index)
+                                         : contrib.LockedBuffer(slice_index, 0);
+          std::copy(slice, slice + slice_size, rank_buf + k * slice_size);
+        }
+        std::fill(rank_buf + rank_slices * slice_size,
+                  rank_buf + count,
+                  TensorDataType(0));
+      }
+      comm.nb_reduce_scatter(send_buf,
+                             scatter_recv_buffer_.Buffer(),
+                             static_cast<int>(count),
+                             grad.Grid().VCComm(),
+                             sync_req_);
+      reduce_scatter_pending_ = true;
+    }
+  }
+
+  /** Copy the reduced shard into the global gradient. */
+  void unpack_reduce_scatter()
+  {
+    if constexpr (is_compressible) {
+      auto& grad = *global_gradient_;
+      auto& local_grad = grad.Matrix();
+      const bool shard_cols = (grad.RowDist() == El::VC);
+      const El::Int slice_size = shard_cols ? grad.Height() : 1;
+      const El::Int local_slices =
+        shard_cols ? grad.LocalWidth() : grad.LocalHeight();
+      const auto* recv_buf = scatter_recv_buffer_.LockedBuffer();
+      for (El::Int k = 0; k < local_slices; ++k) {
+        auto* slice =
+          shard_cols ? local_grad.Buffer(0, k) : local_grad.Buffer(k, 0);
+        std::copy(recv_buf + k * slice_size,
+                  recv_buf + (k + 1) * slice_size,
+                  slice);
+      }
+      scatter_send_buffer_.Empty();
+      scatter_recv_buffer_.Empty();
+    }
+    reduce_scatter_pending_ = false;
+  }
+
   /** Matches the distribution of gathered (unsharded) weights in backprop. */
   std::unique_ptr<AbsDistMatType> local_gradient_contrib_;
 
@@ -202,6 +374,18 @@ private:
 
   Al::request sync_req_;
   bool sharded_weights_;
+
+  /** Staging buffers for the packed reduce-scatter of sharded
+   *  gradients.
+   */
+  El::Matrix<compressed_type, El::Device::CPU> scatter_send_buffer_;
+  El::Matrix<compressed_type, El::Device::CPU> scatter_recv_buffer_;
+  bool reduce_scatter_pending_ = false;
+
+  /** Compresses the gradient allreduce. Keeps error-feedback state
+   *  across steps, so it must outlive @c clear.
+   */
+  std::unique_ptr<gradient_compressor<compressed_type>> compressor_;
 }; // class GradientHelperImpl
 
 template <typename TensorDataType>
@@ -244,7 +428,8 @@ optimizer::get_gradient_buffer(TensorDataType& buf_scale,
                                                  std::get<WIDTH>(mat_info),
                                                  std::get<DISTDATA_L>(mat_info),
                                                  std::get<DISTDATA_G>(mat_info),
-                                                 this->is_sharded());
+                                                 this->is_sharded(),
+                                                 m_gradient_compression);
     grad_mgr_ptr->set_status(optimizer_gradient_status::cleared);
   }
   grad_mgr_ptr->ensure_gradient_memory(std::get<HEIGHT>(mat_info),
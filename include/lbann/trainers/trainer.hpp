@@ -237,6 +237,14 @@ public:
                 execution_mode mode,
                 El::Int num_batches = 0);
 
+  /** @brief Evaluate several models in a single pass over the data.
+   *  @details Each mini-batch is loaded once and forward propagated
+   *           through every model.
+   */
+  void evaluate(std::vector<observer_ptr<model>> const& models,
+                execution_mode mode,
+                El::Int num_batches = 0);
+
   ///@}
   /** @name Sub-grid management */
   ///@{
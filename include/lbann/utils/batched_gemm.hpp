@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_UTILS_BATCHED_GEMM_HPP_INCLUDED
+#define LBANN_UTILS_BATCHED_GEMM_HPP_INCLUDED
+
+#include "lbann/base.hpp"
+
+namespace lbann {
+
+/** @brief Strided batched matrix-matrix product on CPU.
+ *
+ *  Computes @f$ C_i = \alpha \, op(A_i) \, op(B_i) + \beta C_i @f$
+ *  for @f$ i = 0, \ldots, batch\_count-1 @f$, where
+ *  @f$ X_i = X + i \cdot stride_X @f$ and @f$ op(A_i) @f$ is
+ *  @f$ m \times k @f$. Matrices are in column-major (Fortran) layout,
+ *  following the conventions of @c El::Gemm and
+ *  @c gpu_blas::GemmStridedBatched.
+ *
+ *  If Hydrogen is built with MKL, single and double precision
+ *  batches are handed to @c cblas_?gemm_batch_strided. Otherwise,
+ *  batches of small products are distributed over OpenMP threads
+ *  and each product is computed with the single-threaded
+ *  @c packed_gemm kernel. Large products are computed one at a time
+ *  with the (multithreaded) BLAS library so that threads are not
+ *  oversubscribed. Sizes and strides that do not fit in the BLAS
+ *  integer type fall back to @c packed_gemm.
+ */
+template <typename TensorDataType>
+void gemm_strided_batched(El::Orientation transA,
+                          El::Orientation transB,
+                          El::Int m,
+                          El::Int n,
+                          El::Int k,
+                          TensorDataType alpha,
+                          const TensorDataType* A,
+                          El::Int lda,
+                          El::Int strideA,
+                          const TensorDataType* B,
+                          El::Int ldb,
+                          El::Int strideB,
+                          TensorDataType beta,
+                          TensorDataType* C,
+                          El::Int ldc,
+                          El::Int strideC,
+                          El::Int batch_count);
+
+/** @brief Single-threaded matrix-matrix product with packed panels.
+ *
+ *  Computes @f$ C = \alpha \, op(A) \, op(B) + \beta C @f$ with
+ *  column-major matrices. Panels of @f$ op(A) @f$ and @f$ op(B) @f$
+ *  are copied into contiguous thread-local buffers so the inner
+ *  loops have unit stride regardless of the transpose modes. If
+ *  @f$ \beta = 0 @f$, @f$ C @f$ is overwritten without being read.
+ *
+ *  Single precision products with at most @f$ 32^3 @f$ multiply-adds
+ *  and double precision products with at most @f$ 16^3 @f$ are
+ *  handed to BLAS, which is faster at sizes where the packing
+ *  overhead is not amortized.
+ */
+template <typename TensorDataType>
+void packed_gemm(El::Orientation transA,
+                 El::Orientation transB,
+                 El::Int m,
+                 El::Int n,
+                 El::Int k,
+                 TensorDataType alpha,
+                 const TensorDataType* A,
+                 El::Int lda,
+                 const TensorDataType* B,
+                 El::Int ldb,
+                 TensorDataType beta,
+                 TensorDataType* C,
+                 El::Int ldc);
+
+} // namespace lbann
+
+#endif // LBANN_UTILS_BATCHED_GEMM_HPP_INCLUDED
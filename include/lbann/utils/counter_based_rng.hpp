@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_UTILS_COUNTER_BASED_RNG_HPP_INCLUDED
+#define LBANN_UTILS_COUNTER_BASED_RNG_HPP_INCLUDED
+
+#include "lbann/utils/omp_pragma.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace lbann {
+namespace philox {
+
+/** @brief 128-bit counter for Philox4x32. */
+using counter_type = std::array<uint32_t, 4>;
+/** @brief 64-bit key for Philox4x32. */
+using key_type = std::array<uint32_t, 2>;
+
+/** @brief Philox4x32-10 counter-based random number generator.
+ *
+ *  Maps a (counter, key) pair to four independent 32-bit random
+ *  values. The generator is stateless, so any entry of a random
+ *  stream can be regenerated from its seed and offset and loops
+ *  over independent counters vectorize well. See:
+ *
+ *  John K. Salmon, Mark A. Moraes, Ron O. Dror, and David E. Shaw.
+ *  "Parallel random numbers: as easy as 1, 2, 3." In Proceedings of
+ *  SC11, pp. 1-12. 2011.
+ */
+inline counter_type philox4x32(counter_type ctr, key_type key) noexcept
+{
+  constexpr uint32_t M0 = 0xD2511F53u;
+  constexpr uint32_t M1 = 0xCD9E8D57u;
+  constexpr uint32_t W0 = 0x9E3779B9u;
+  constexpr uint32_t W1 = 0xBB67AE85u;
+  for (int round = 0; round < 10; ++round) {
+    const uint64_t p0 = static_cast<uint64_t>(M0) * ctr[0];
+    const uint64_t p1 = static_cast<uint64_t>(M1) * ctr[2];
+    const uint32_t hi0 = static_cast<uint32_t>(p0 >> 32);
+    const uint32_t lo0 = static_cast<uint32_t>(p0);
+    const uint32_t hi1 = static_cast<uint32_t>(p1 >> 32);
+    const uint32_t lo1 = static_cast<uint32_t>(p1);
+    ctr = {hi1 ^ ctr[1] ^ key[0], lo1, hi0 ^ ctr[3] ^ key[1], lo0};
+    key[0] += W0;
+    key[1] += W1;
+  }
+  return ctr;
+}
+
+/** @brief Construct a Philox key from a 64-bit seed. */
+inline key_type make_key(uint64_t seed) noexcept
+{
+  return {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+}
+
+/** @brief Draw a fresh 64-bit seed from LBANN's global generator.
+ *
+ *  Used by layers that regenerate a dropout mask from its seed.
+ */
+uint64_t draw_seed();
+
+/** @brief Threshold for Bernoulli trials on 32-bit random values.
+ *
+ *  A trial succeeds if the random value is strictly less than the
+ *  threshold. Probabilities outside [0,1] are clamped.
+ */
+inline uint64_t bernoulli_threshold(double p) noexcept
+{
+  constexpr double range = 4294967296.0; // 2^32
+  if (!(p > 0.0)) {
+    return 0;
+  }
+  if (p >= 1.0) {
+    return static_cast<uint64_t>(range);
+  }
+  return static_cast<uint64_t>(p * range);
+}
+
+/** @brief Apply a regenerable Bernoulli mask to a column-major matrix.
+ *
+ *  Entry (i,j) is kept with the probability encoded in @c threshold
+ *  and the functor is called as @c f(x,keep) to compute the output
+ *  entry. The Bernoulli trial for entry (i,j) only depends on the
+ *  key and the entry's position, so the same mask is reproduced by
+ *  calling this function again with the same key. @c in and @c out
+ *  may alias.
+ */
+template <typename T, typename Functor>
+void apply_bernoulli_mask(key_type key,
+                          uint64_t threshold,
+                          size_t height,
+                          size_t width,
+                          const T* in,
+                          size_t in_ldim,
+                          T* out,
+                          size_t out_ldim,
+                          Functor f)
+{
+  const size_t num_blocks = (height + 3) / 4;
+  LBANN_OMP_PARALLEL_FOR
+  for (size_t col = 0; col < width; ++col) {
+    const T* in_col = in + col * in_ldim;
+    T* out_col = out + col * out_ldim;
+    for (size_t block = 0; block < num_blocks; ++block) {
+      const auto r =
+        philox4x32({static_cast<uint32_t>(block),
+                    static_cast<uint32_t>(col),
+                    static_cast<uint32_t>(static_cast<uint64_t>(col) >> 32),
+                    0u},
+                   key);
+      const size_t row_start = 4 * block;
+      const size_t block_size =
+        (height - row_start < 4) ? height - row_start : size_t{4};
+      for (size_t k = 0; k < block_size; ++k) {
+        const size_t row = row_start + k;
+        out_col[row] =
+          f(in_col[row], static_cast<uint64_t>(r[k]) < threshold);
+      }
+    }
+  }
+}
+
+} // namespace philox
+} // namespace lbann
+
+#endif // LBANN_UTILS_COUNTER_BASED_RNG_HPP_INCLUDED
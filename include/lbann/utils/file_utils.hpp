@@ -29,6 +29,7 @@
 #ifndef LBANN_UTILS_FILE_HPP_INCLUDED
 #define LBANN_UTILS_FILE_HPP_INCLUDED
 
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <iterator>
@@ -178,6 +179,47 @@ void make_directory(const std::string& path);
 
 void remove_multiple_slashes(std::string& str);
 
+/** @brief Read-only memory mapping of a whole file.
+ *
+ *  The mapping is shared between threads and is released when the
+ *  object is destroyed. Empty files are represented by a null data
+ *  pointer.
+ */
+class mapped_file
+{
+public:
+  /** @brief Map @c path into memory. Throws if it cannot be opened. */
+  explicit mapped_file(const std::string& path);
+  ~mapped_file();
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  const char* data() const noexcept { return m_data; }
+  size_t size() const noexcept { return m_size; }
+  const std::string& path() const noexcept { return m_path; }
+
+private:
+  std::string m_path;
+  const char* m_data = nullptr;
+  size_t m_size = 0;
+};
+
+/** @brief Size and modification time of a file, used to detect
+ *  whether files derived from it are stale. */
+struct file_stamp
+{
+  uint64_t size = 0;
+  uint64_t mtime_ns = 0;
+  bool operator==(const file_stamp& other) const
+  {
+    return size == other.size && mtime_ns == other.mtime_ns;
+  }
+  bool operator!=(const file_stamp& other) const { return !(*this == other); }
+};
+
+/** @brief Get the size and modification time of a file. */
+file_stamp get_file_stamp(const std::string& path);
+
 } // namespace file
 
 } // namespace lbann
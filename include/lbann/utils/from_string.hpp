@@ -28,6 +28,9 @@
 #define LBANN_UTILS_FROM_STRING_INCLUDED
 
 #include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
 #include <string>
 
 namespace lbann {
@@ -125,6 +128,122 @@ inline bool from_string<bool>(std::string const& str)
     return from_string<int>(str);
 }
 
+/** @brief Parse a floating-point number from a character range.
+ *
+ *  A non-allocating alternative to @c std::stod for parsing text that
+ *  is not null-terminated, e.g. memory-mapped files. Leading blanks
+ *  are skipped. Decimal and exponent notation with at most 19
+ *  significant digits is converted with the exact fast path of
+ *  Clinger's algorithm. Other inputs (long mantissas, "inf", "nan",
+ *  hexadecimal) fall back to @c std::strtod.
+ *
+ *  @param first Start of the range.
+ *  @param last  End of the range.
+ *  @param value The parsed value.
+ *
+ *  @return A pointer one past the last character of the number, or
+ *          @c first if no number was found.
+ */
+inline char const*
+parse_double(char const* first, char const* last, double& value)
+{
+  constexpr double powers_of_ten[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                      1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                      1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                      1e18, 1e19, 1e20, 1e21, 1e22};
+  char const* p = first;
+  while (p != last && (*p == ' ' || *p == '\t'))
+    ++p;
+  char const* const start = p;
+
+  bool negative = false;
+  if (p != last && (*p == '-' || *p == '+')) {
+    negative = (*p == '-');
+    ++p;
+  }
+  uint64_t mantissa = 0;
+  int num_digits = 0, exponent = 0;
+  // Hexadecimal numbers stop the scan at the 'x' and are converted
+  // by the slow path
+  bool has_digits = false;
+  bool fast = !(last - p >= 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X'));
+  for (; p != last && std::isdigit(static_cast<unsigned char>(*p)); ++p) {
+    has_digits = true;
+    if (mantissa == 0 && *p == '0')
+      continue;
+    if (++num_digits > 19)
+      fast = false;
+    mantissa = 10 * mantissa + (*p - '0');
+  }
+  if (p != last && *p == '.') {
+    for (++p; p != last && std::isdigit(static_cast<unsigned char>(*p)); ++p) {
+      has_digits = true;
+      --exponent;
+      if (mantissa == 0 && *p == '0')
+        continue;
+      if (++num_digits > 19)
+        fast = false;
+      mantissa = 10 * mantissa + (*p - '0');
+    }
+  }
+  if (has_digits && p != last && (*p == 'e' || *p == 'E')) {
+    char const* q = p + 1;
+    bool negative_exponent = false;
+    if (q != last && (*q == '-' || *q == '+')) {
+      negative_exponent = (*q == '-');
+      ++q;
+    }
+    if (q != last && std::isdigit(static_cast<unsigned char>(*q))) {
+      int e = 0;
+      for (; q != last && std::isdigit(static_cast<unsigned char>(*q)); ++q) {
+        if (e < 100000)
+          e = 10 * e + (*q - '0');
+      }
+      exponent += negative_exponent ? -e : e;
+      p = q;
+    }
+  }
+
+  if (has_digits && fast) {
+    if (mantissa == 0) {
+      value = negative ? -0.0 : 0.0;
+      return p;
+    }
+    if (mantissa <= (uint64_t{1} << 53) && exponent >= -22 && exponent <= 22) {
+      double v = static_cast<double>(mantissa);
+      v = exponent < 0 ? v / powers_of_ten[-exponent]
+                       : v * powers_of_ten[exponent];
+      value = negative ? -v : v;
+      return p;
+    }
+  }
+
+  // Slow path: copy the token so that it is null-terminated.
+  char const* end = start;
+  while (end != last && (std::isalnum(static_cast<unsigned char>(*end)) ||
+                         *end == '.' || *end == '-' || *end == '+'))
+    ++end;
+  if (end == start)
+    return first;
+  char buffer[64];
+  std::string long_token;
+  char* token = buffer;
+  const size_t length = end - start;
+  if (length < sizeof(buffer)) {
+    std::copy(start, end, buffer);
+    buffer[length] = '\0';
+  }
+  else {
+    long_token.assign(start, end);
+    token = &long_token[0];
+  }
+  char* token_end = nullptr;
+  value = std::strtod(token, &token_end);
+  if (token_end == token)
+    return first;
+  return start + (token_end - token);
+}
+
 } // namespace utils
 } // namespace lbann
 #endif // LBANN_UTILS_FROM_STRING_INCLUDED
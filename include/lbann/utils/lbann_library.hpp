@@ -41,13 +41,17 @@ const int lbann_default_random_seed = 42;
  * @param[in] mbs The max mini-batch size
  * @param[in] input_dims The dimension of the input tensor
  * @param[in] output_dims The dimension of the output tensor
+ * @param[in] optimize_graph Whether to apply inference-only graph
+ *            rewrites (see @c optimize_for_inference). They change
+ *            the layers of the model, so they are opt-in.
  * @return Model loaded from checkpoint
  */
 std::unique_ptr<model> load_inference_model(lbann_comm* lc,
                                             std::string cp_dir,
                                             int mbs,
                                             std::vector<int> input_dims,
-                                            std::vector<int> output_dims);
+                                            std::vector<int> output_dims,
+                                            bool optimize_graph = false);
 
 /** @brief Creates execution algorithm and infers on samples using a model
  * @param[in] model A trained model
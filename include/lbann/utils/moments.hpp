@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_UTILS_MOMENTS_HPP_INCLUDED
+#define LBANN_UTILS_MOMENTS_HPP_INCLUDED
+
+#include "lbann/base.hpp"
+
+#include <algorithm>
+
+namespace lbann {
+
+/** @brief Number of independent accumulators in CPU reductions.
+ *
+ *  Floating-point addition is not associative, so compilers will
+ *  not vectorize a reduction into a single scalar unless fast-math
+ *  is enabled. Accumulating into this many interleaved partial sums
+ *  gives the compiler independent lanes to vectorize over.
+ */
+constexpr El::Int reduction_lanes = 8;
+
+/** @brief Count, mean, and sum of squared deviations of a set of
+ *  values.
+ */
+template <typename T>
+struct moments
+{
+  T count = T(0);
+  T mean = T(0);
+  /** @brief Sum of squared deviations from the mean. */
+  T m2 = T(0);
+
+  /** @brief Combine with moments of a disjoint set of values.
+   *
+   *  Uses the pairwise update of Chan, Golub, and LeVeque ("Updating
+   *  formulae and a pairwise algorithm for computing sample
+   *  variances", 1979), which does not suffer from the cancellation
+   *  of the textbook @f$ E[x^2] - E[x]^2 @f$ formula.
+   */
+  void merge(const moments& other) noexcept
+  {
+    if (other.count == T(0)) {
+      return;
+    }
+    const T total = count + other.count;
+    const T delta = other.mean - mean;
+    const T other_frac = other.count / total;
+    mean += delta * other_frac;
+    m2 += other.m2 + delta * delta * count * other_frac;
+    count = total;
+  }
+};
+
+/** @brief Centered sums over a contiguous array.
+ *
+ *  With @f$ u_i = x_i - c @f$ and weights @f$ w_i @f$, computes
+ *  @f$ \sum w_i @f$ and @f$ \sum w_i u_i @f$. If @c w is a null
+ *  pointer, the weights are @f$ w_i = u_i @f$, i.e. the result is
+ *  the first and second moments about @f$ c @f$. The results are
+ *  added to @c sum_w and @c sum_wu.
+ */
+template <typename T>
+void accumulate_centered_sums(const T* x,
+                              const T* w,
+                              El::Int n,
+                              T center,
+                              T& sum_w,
+                              T& sum_wu) noexcept
+{
+  T acc_w[reduction_lanes] = {};
+  T acc_wu[reduction_lanes] = {};
+  const El::Int n_vec = n - n % reduction_lanes;
+  if (w == nullptr) {
+    for (El::Int i = 0; i < n_vec; i += reduction_lanes) {
+      for (El::Int l = 0; l < reduction_lanes; ++l) {
+        const T u = x[i + l] - center;
+        acc_w[l] += u;
+        acc_wu[l] += u * u;
+      }
+    }
+    for (El::Int i = n_vec; i < n; ++i) {
+      const T u = x[i] - center;
+      acc_w[0] += u;
+      acc_wu[0] += u * u;
+    }
+  }
+  else {
+    for (El::Int i = 0; i < n_vec; i += reduction_lanes) {
+      for (El::Int l = 0; l < reduction_lanes; ++l) {
+        const T u = x[i + l] - center;
+        acc_w[l] += w[i + l];
+        acc_wu[l] += w[i + l] * u;
+      }
+    }
+    for (El::Int i = n_vec; i < n; ++i) {
+      acc_w[0] += w[i];
+      acc_wu[0] += w[i] * (x[i] - center);
+    }
+  }
+  for (El::Int l = 0; l < reduction_lanes; ++l) {
+    sum_w += acc_w[l];
+    sum_wu += acc_wu[l];
+  }
+}
+
+/** @brief Moments of a contiguous array in one pass over memory.
+ *
+ *  The array is processed in chunks that stay resident in L1 cache.
+ *  Each chunk's mean is computed first and its squared deviations
+ *  are accumulated about that mean, so there is no catastrophic
+ *  cancellation even if the values have a large common offset. The
+ *  chunk moments are then combined with @c moments::merge.
+ */
+template <typename T>
+moments<T> compute_moments(const T* x, El::Int n) noexcept
+{
+  constexpr El::Int chunk_size = 512;
+  moments<T> result;
+  for (El::Int start = 0; start < n; start += chunk_size) {
+    const El::Int size = std::min(chunk_size, n - start);
+    const T* chunk = x + start;
+
+    // Chunk mean
+    T acc[reduction_lanes] = {};
+    const El::Int size_vec = size - size % reduction_lanes;
+    for (El::Int i = 0; i < size_vec; i += reduction_lanes) {
+      for (El::Int l = 0; l < reduction_lanes; ++l) {
+        acc[l] += chunk[i + l];
+      }
+    }
+    for (El::Int i = size_vec; i < size; ++i) {
+      acc[0] += chunk[i];
+    }
+    T sum = T(0);
+    for (El::Int l = 0; l < reduction_lanes; ++l) {
+      sum += acc[l];
+    }
+    const T count = static_cast<T>(size);
+    const T mean = sum / count;
+
+    // Squared deviations about chunk mean, corrected for the
+    // rounding error in the mean
+    T sum_u = T(0), sum_uu = T(0);
+    accumulate_centered_sums<T>(chunk, nullptr, size, mean, sum_u, sum_uu);
+    moments<T> chunk_moments;
+    chunk_moments.count = count;
+    chunk_moments.mean = mean + sum_u / count;
+    chunk_moments.m2 = std::max(sum_uu - sum_u * sum_u / count, T(0));
+    result.merge(chunk_moments);
+  }
+  return result;
+}
+
+} // namespace lbann
+
+#endif // LBANN_UTILS_MOMENTS_HPP_INCLUDED
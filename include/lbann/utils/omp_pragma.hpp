@@ -97,4 +97,9 @@
 #define OMP_CRITICAL
 
 #endif // LBANN_DETERMINISTIC
+
+// Vectorization does not reorder work across entries of an entrywise
+// loop, so it is also enabled in deterministic builds
+#define LBANN_OMP_SIMD _Pragma("omp simd")
+
 #endif // LBANN_OMP_PRAGMA_HPP
@@ -37,6 +37,7 @@ namespace lbann {
 
 /****** std options ******/
 // Bool flags
+#define LBANN_OPTION_COMM_PROGRESS_THREAD "comm_progress_thread"
 #define LBANN_OPTION_DISABLE_BACKGROUND_IO_ACTIVITY                            \
   "disable_background_io_activity"
 #define LBANN_OPTION_DISABLE_CUDA "disable_cuda"
@@ -65,6 +66,7 @@ namespace lbann {
 #define LBANN_OPTION_INIT_SHMEM "Initialize SHMEM when initializing LBANN"
 #define LBANN_OPTION_INIT_NVSHMEM "Initialize NVSHMEM when initializing LBANN"
 #define LBANN_OPTION_NO_INPLACE "no_inplace"
+#define LBANN_OPTION_NO_BUFFER_ALIASING "no_buffer_aliasing"
 #define LBANN_OPTION_NO_BACKPROP_DISABLE "no_backprop_disable"
 
 #define LBANN_OPTION_OMP_NUM_THREADS "Num. OMP threads"
@@ -86,6 +88,11 @@ namespace lbann {
 #define LBANN_OPTION_RANDOM_SEED "random_seed"
 #define LBANN_OPTION_READER "reader"
 #define LBANN_OPTION_RESTART_DIR "restart_dir"
+#define LBANN_OPTION_SHARDED_WEIGHTS_PREFETCH_BUDGET                           \
+  "sharded_weights_prefetch_budget"
+#define LBANN_OPTION_SHARDED_WEIGHTS_PREFETCH_DEPTH                            \
+  "sharded_weights_prefetch_depth"
+#define LBANN_OPTION_TRACE_FILE "trace_file"
 #define LBANN_OPTION_TRAINER_CREATE_TWO_MODELS                                 \
   "Create two models in Sub-grid parallelism"
 #define LBANN_OPTION_TRAINER_GRID_HEIGHT                                       \
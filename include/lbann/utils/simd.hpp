@@ -0,0 +1,247 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_UTILS_SIMD_HPP_INCLUDED
+#define LBANN_UTILS_SIMD_HPP_INCLUDED
+
+#include "lbann/utils/omp_pragma.hpp"
+
+#include <cstddef>
+#include <string>
+
+// Force inlining so that kernels are compiled for the instruction set
+// of the variant they are called from
+#if defined(__GNUC__)
+#define LBANN_SIMD_INLINE inline __attribute__((always_inline))
+#else
+#define LBANN_SIMD_INLINE inline
+#endif
+
+// x86-64 builds also compile AVX2 and AVX-512 variants of each kernel
+#if defined(__GNUC__) && defined(__x86_64__)
+#define LBANN_SIMD_HAS_X86_VARIANTS
+#define LBANN_SIMD_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define LBANN_SIMD_TARGET_AVX512                                               \
+  __attribute__((target("avx512f,avx512dq,avx512vl,avx2,fma")))
+#endif
+
+namespace lbann {
+namespace simd {
+
+/** @brief Instruction sets for vectorized CPU kernels.
+ *
+ *  @c reference uses the scalar implementations of the entrywise
+ *  operators. @c baseline uses the vectorized kernels compiled for
+ *  the build's target architecture (e.g. SSE2 on x86-64, NEON on
+ *  AArch64). @c avx2 and @c avx512 are only available on x86-64.
+ */
+enum class isa
+{
+  reference,
+  baseline,
+  avx2,
+  avx512,
+};
+
+/** @brief Best instruction set supported by this CPU and build. */
+isa detected_isa();
+
+/** @brief Instruction set used by vectorized kernels.
+ *
+ *  Defaults to the detected instruction set. It can be lowered with
+ *  the @c LBANN_SIMD_ISA environment variable (one of "reference",
+ *  "baseline", "avx2" or "avx512").
+ */
+isa get_isa() noexcept;
+
+/** @brief Change the instruction set used by vectorized kernels.
+ *
+ *  Throws if the CPU does not support it.
+ */
+void set_isa(isa instruction_set);
+
+/** @brief Whether this CPU and build support an instruction set. */
+bool is_supported(isa instruction_set);
+
+/** @brief Convert instruction set to a human-readable string. */
+std::string to_string(isa instruction_set);
+
+/** @brief Convert a string to an instruction set.
+ *
+ *  Throws if the string is not recognized.
+ */
+isa isa_from_string(std::string const& str);
+
+namespace details {
+
+template <typename T, typename F>
+LBANN_SIMD_INLINE void unary_loop(T const* x, T* y, size_t n, F const& f)
+{
+  LBANN_OMP_SIMD
+  for (size_t i = 0; i < n; ++i) {
+    y[i] = f(x[i]);
+  }
+}
+
+template <typename T, typename F>
+LBANN_SIMD_INLINE void
+binary_loop(T const* x1, T const* x2, T* y, size_t n, F const& f)
+{
+  LBANN_OMP_SIMD
+  for (size_t i = 0; i < n; ++i) {
+    y[i] = f(x1[i], x2[i]);
+  }
+}
+
+template <typename T, typename F>
+LBANN_SIMD_INLINE void binary_backprop_loop(T const* x1,
+                                            T const* x2,
+                                            T const* dy,
+                                            T* dx1,
+                                            T* dx2,
+                                            size_t n,
+                                            F const& f)
+{
+  LBANN_OMP_SIMD
+  for (size_t i = 0; i < n; ++i) {
+    f(x1[i], x2[i], dy[i], dx1[i], dx2[i]);
+  }
+}
+
+// Generate one function per instruction set that calls a loop helper
+#ifdef LBANN_SIMD_HAS_X86_VARIANTS
+#define LBANN_SIMD_DEFINE_VARIANTS(NAME, LOOP, PARAMS, ARGS)                   \
+  template <typename T, typename F>                                            \
+  void NAME##_baseline PARAMS                                                  \
+  {                                                                            \
+    LOOP ARGS;                                                                 \
+  }                                                                            \
+  template <typename T, typename F>                                            \
+  LBANN_SIMD_TARGET_AVX2 void NAME##_avx2 PARAMS                               \
+  {                                                                            \
+    LOOP ARGS;                                                                 \
+  }                                                                            \
+  template <typename T, typename F>                                            \
+  LBANN_SIMD_TARGET_AVX512 void NAME##_avx512 PARAMS                           \
+  {                                                                            \
+    LOOP ARGS;                                                                 \
+  }
+#else
+#define LBANN_SIMD_DEFINE_VARIANTS(NAME, LOOP, PARAMS, ARGS)                   \
+  template <typename T, typename F>                                            \
+  void NAME##_baseline PARAMS                                                  \
+  {                                                                            \
+    LOOP ARGS;                                                                 \
+  }
+#endif // LBANN_SIMD_HAS_X86_VARIANTS
+
+LBANN_SIMD_DEFINE_VARIANTS(apply_unary,
+                           unary_loop,
+                           (T const* x, T* y, size_t n, F const& f),
+                           (x, y, n, f))
+LBANN_SIMD_DEFINE_VARIANTS(apply_binary,
+                           binary_loop,
+                           (T const* x1,
+                            T const* x2,
+                            T* y,
+                            size_t n,
+                            F const& f),
+                           (x1, x2, y, n, f))
+LBANN_SIMD_DEFINE_VARIANTS(apply_binary_backprop,
+                           binary_backprop_loop,
+                           (T const* x1,
+                            T const* x2,
+                            T const* dy,
+                            T* dx1,
+                            T* dx2,
+                            size_t n,
+                            F const& f),
+                           (x1, x2, dy, dx1, dx2, n, f))
+
+#undef LBANN_SIMD_DEFINE_VARIANTS
+
+} // namespace details
+
+// Dispatch to the variant for the active instruction set
+#ifdef LBANN_SIMD_HAS_X86_VARIANTS
+#define LBANN_SIMD_DISPATCH(NAME, ...)                                         \
+  switch (get_isa()) {                                                         \
+  case isa::avx512:                                                            \
+    return details::NAME##_avx512(__VA_ARGS__);                                \
+  case isa::avx2:                                                              \
+    return details::NAME##_avx2(__VA_ARGS__);                                  \
+  default:                                                                     \
+    return details::NAME##_baseline(__VA_ARGS__);                              \
+  }
+#else
+#define LBANN_SIMD_DISPATCH(NAME, ...) details::NAME##_baseline(__VA_ARGS__)
+#endif // LBANN_SIMD_HAS_X86_VARIANTS
+
+/** @brief Vectorized entrywise map on contiguous data, y <- f(x).
+ *
+ *  The functor is inlined into a loop compiled for the active
+ *  instruction set, so it should be branch-free and avoid library
+ *  calls (see simd_math.hpp). @c x and @c y may alias.
+ */
+template <typename T, typename F>
+void apply_unary(T const* x, T* y, size_t n, F const& f)
+{
+  LBANN_SIMD_DISPATCH(apply_unary, x, y, n, f);
+}
+
+/** @brief Vectorized entrywise map on contiguous data,
+ *         y <- f(x1,x2).
+ */
+template <typename T, typename F>
+void apply_binary(T const* x1, T const* x2, T* y, size_t n, F const& f)
+{
+  LBANN_SIMD_DISPATCH(apply_binary, x1, x2, y, n, f);
+}
+
+/** @brief Vectorized backprop of a binary entrywise map on
+ *         contiguous data.
+ *
+ *  The functor is called as @c f(x1,x2,dy,dx1,dx2) and overwrites
+ *  the last two arguments.
+ */
+template <typename T, typename F>
+void apply_binary_backprop(T const* x1,
+                           T const* x2,
+                           T const* dy,
+                           T* dx1,
+                           T* dx2,
+                           size_t n,
+                           F const& f)
+{
+  LBANN_SIMD_DISPATCH(apply_binary_backprop, x1, x2, dy, dx1, dx2, n, f);
+}
+
+#undef LBANN_SIMD_DISPATCH
+
+} // namespace simd
+} // namespace lbann
+
+#endif // LBANN_UTILS_SIMD_HPP_INCLUDED
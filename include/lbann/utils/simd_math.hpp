@@ -0,0 +1,350 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_UTILS_SIMD_MATH_HPP_INCLUDED
+#define LBANN_UTILS_SIMD_MATH_HPP_INCLUDED
+
+#include "lbann/utils/simd.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+/** @file
+ *
+ *  Branch-free approximations of elementary functions for float and
+ *  double. Unlike the standard library, they are inlined and
+ *  vectorize inside the loops of simd.hpp. Errors versus a correctly
+ *  rounded result are at most 3 ULP (tested in simd_math_test.cpp),
+ *  except for subnormal results of exp and expm1 which are rounded
+ *  twice.
+ */
+
+namespace lbann {
+namespace simd {
+namespace details {
+
+template <typename T>
+struct float_traits;
+
+template <>
+struct float_traits<float>
+{
+  using int_type = int32_t;
+  using uint_type = uint32_t;
+  static constexpr int mantissa_bits = 23;
+  static constexpr int exponent_bias = 127;
+  static constexpr float ln2_hi = 0.693359375f;
+  static constexpr float ln2_lo = -2.12194440e-4f;
+  // exp overflows above the upper bound and underflows below the
+  // lower bound
+  static constexpr float exp_max = 88.8f;
+  static constexpr float exp_min = -104.f;
+  // tanh rounds to 1 above this value
+  static constexpr float tanh_max = 10.f;
+};
+
+template <>
+struct float_traits<double>
+{
+  using int_type = int64_t;
+  using uint_type = uint64_t;
+  static constexpr int mantissa_bits = 52;
+  static constexpr int exponent_bias = 1023;
+  static constexpr double ln2_hi = 6.93147180369123816490e-01;
+  static constexpr double ln2_lo = 1.90821492927058770002e-10;
+  static constexpr double exp_max = 709.9;
+  static constexpr double exp_min = -746.;
+  static constexpr double tanh_max = 20.;
+};
+
+template <typename T>
+LBANN_SIMD_INLINE typename float_traits<T>::uint_type to_bits(T x)
+{
+  typename float_traits<T>::uint_type bits;
+  std::memcpy(&bits, &x, sizeof(T));
+  return bits;
+}
+
+template <typename T>
+LBANN_SIMD_INLINE T from_bits(typename float_traits<T>::uint_type bits)
+{
+  T x;
+  std::memcpy(&x, &bits, sizeof(T));
+  return x;
+}
+
+/** @brief 2^n for integer n in the normal exponent range. */
+template <typename T>
+LBANN_SIMD_INLINE T pow2(int32_t n)
+{
+  using traits = float_traits<T>;
+  using uint_type = typename traits::uint_type;
+  const auto biased = static_cast<uint_type>(n + traits::exponent_bias);
+  return from_bits<T>(biased << traits::mantissa_bits);
+}
+
+/** @brief Branch-free select, cond ? a : b.
+ *
+ *  GCC does not if-convert a conditional expression with a constant
+ *  operand if it can propagate the constant into trapping floating
+ *  point operations, which prevents vectorization. Blending bits
+ *  avoids this.
+ */
+template <typename T>
+LBANN_SIMD_INLINE T select(bool cond, T a, T b)
+{
+  using uint_type = typename float_traits<T>::uint_type;
+  const uint_type mask = uint_type(0) - static_cast<uint_type>(cond);
+  return from_bits<T>((to_bits(a) & mask) | (to_bits(b) & ~mask));
+}
+
+/** @brief Clamp a non-NaN value to [lo,hi]. */
+template <typename T>
+LBANN_SIMD_INLINE T clamp(T x, T lo, T hi)
+{
+  x = select(x < lo, lo, x);
+  return select(x > hi, hi, x);
+}
+
+/** @brief Horner evaluation of c[0] + c[1]*x + ... */
+template <typename T, size_t N>
+LBANN_SIMD_INLINE T polynomial(T x, const T (&c)[N])
+{
+  T p = c[N - 1];
+  for (size_t i = N - 1; i > 0; --i) {
+    p = p * x + c[i - 1];
+  }
+  return p;
+}
+
+/** @brief exp(r)-1 for |r| <= log(2)/2.
+ *
+ *  Taylor series, truncated below a unit roundoff.
+ */
+template <typename T>
+LBANN_SIMD_INLINE T expm1_reduced(T r)
+{
+  // Coefficients of r^2, r^3, ... are 1/2!, 1/3!, ...
+  if constexpr (std::is_same_v<T, float>) {
+    constexpr float c[] = {1.f / 2,
+                           1.f / 6,
+                           1.f / 24,
+                           1.f / 120,
+                           1.f / 720,
+                           1.f / 5040};
+    return r + r * r * polynomial(r, c);
+  }
+  else {
+    constexpr double c[] = {1. / 2,
+                            1. / 6,
+                            1. / 24,
+                            1. / 120,
+                            1. / 720,
+                            1. / 5040,
+                            1. / 40320,
+                            1. / 362880,
+                            1. / 3628800,
+                            1. / 39916800,
+                            1. / 479001600,
+                            1. / 6227020800.};
+    return r + r * r * polynomial(r, c);
+  }
+}
+
+/** @brief Split x = k*log(2) + r with |r| <= log(2)/2.
+ *
+ *  x must be finite and within the exp bounds.
+ */
+template <typename T>
+LBANN_SIMD_INLINE T reduce_exp_argument(T x, int32_t& k)
+{
+  using traits = float_traits<T>;
+  constexpr T log2e = T(1.44269504088896340736);
+  // Adding and subtracting 1.5*2^p rounds to the nearest integer
+  constexpr T shifter =
+    std::is_same_v<T, float> ? T(12582912.) : T(6755399441055744.);
+  const T shifted = x * log2e + shifter;
+  const T kf = shifted - shifter;
+  // The low bits of the shifted value hold k. Reading them avoids a
+  // float-to-int conversion, which blocks if-conversion in GCC.
+  k = static_cast<int32_t>(static_cast<uint32_t>(to_bits(shifted)) -
+                           static_cast<uint32_t>(to_bits(shifter)));
+  return (x - kf * traits::ln2_hi) - kf * traits::ln2_lo;
+}
+
+/** @brief Split positive, normal x = m*2^e with sqrt(1/2) <= m <
+ *         sqrt(2).
+ */
+template <typename T>
+LBANN_SIMD_INLINE T reduce_log_argument(T x, T& e)
+{
+  using traits = float_traits<T>;
+  using uint_type = typename traits::uint_type;
+  constexpr uint_type mantissa_mask =
+    (uint_type(1) << traits::mantissa_bits) - 1;
+  constexpr uint_type half_exponent = uint_type(traits::exponent_bias - 1)
+                                      << traits::mantissa_bits;
+  const uint_type bits = to_bits(x);
+  const auto biased_exponent =
+    static_cast<int32_t>(bits >> traits::mantissa_bits);
+  // m is in [1/2,1)
+  T m = from_bits<T>((bits & mantissa_mask) | half_exponent);
+  e = static_cast<T>(biased_exponent - (traits::exponent_bias - 1));
+  const bool small = m < T(0.70710678118654752440);
+  m = select(small, m + m, m);
+  e = select(small, e - T(1), e);
+  return m;
+}
+
+} // namespace details
+
+/** @brief Branch-free select for vectorized functors, cond ? a : b.
+ */
+using details::select;
+
+/** @brief Vectorizable exponential function. */
+template <typename T>
+LBANN_SIMD_INLINE T exp(T x)
+{
+  using traits = details::float_traits<T>;
+  const bool is_nan = x != x;
+  const T xc = simd::select(
+    is_nan, T(0), details::clamp(x, traits::exp_min, traits::exp_max));
+  int32_t k;
+  const T r = details::reduce_exp_argument(xc, k);
+  // Scale by 2^k in two steps to cover overflow and subnormal results
+  const int32_t k1 = k >> 1;
+  const T y = (T(1) + details::expm1_reduced(r)) * details::pow2<T>(k1) *
+              details::pow2<T>(k - k1);
+  return simd::select(is_nan, x, y);
+}
+
+/** @brief Vectorizable exp(x)-1, accurate for small x. */
+template <typename T>
+LBANN_SIMD_INLINE T expm1(T x)
+{
+  using traits = details::float_traits<T>;
+  const bool is_nan = x != x;
+  const T xc = simd::select(
+    is_nan, T(0), details::clamp(x, traits::exp_min, traits::exp_max));
+  int32_t k;
+  const T r = details::reduce_exp_argument(xc, k);
+  const T p = details::expm1_reduced(r);
+  // 2^k*(p+1) - 1, with 2^k-1 exact for moderate k. Large arguments
+  // use the exponential instead to avoid overflow in 2^k.
+  const int32_t k1 = k >> 1;
+  const T scale_hi = details::pow2<T>(k1);
+  const T scale_lo = details::pow2<T>(k - k1);
+  const T scale = scale_hi * scale_lo;
+  const T y_small = scale * p + (scale - T(1));
+  const T y_large = (T(1) + p) * scale_hi * scale_lo - T(1);
+  T y = simd::select(k > traits::mantissa_bits, y_large, y_small);
+  y = simd::select(x == T(0), x, y);
+  return simd::select(is_nan, x, y);
+}
+
+/** @brief Vectorizable natural logarithm. */
+template <typename T>
+LBANN_SIMD_INLINE T log(T x)
+{
+  using traits = details::float_traits<T>;
+  constexpr T inf = std::numeric_limits<T>::infinity();
+  constexpr T min_normal = std::numeric_limits<T>::min();
+  // Normalize subnormal inputs
+  constexpr T subnormal_scale =
+    std::is_same_v<T, float> ? T(16777216.) : T(18014398509481984.);
+  constexpr T subnormal_exponent =
+    std::is_same_v<T, float> ? T(24) : T(54);
+  const bool subnormal = x < min_normal;
+  const T xs = simd::select(subnormal, x * subnormal_scale, x);
+  T e;
+  const T m = details::reduce_log_argument(xs, e);
+  e = simd::select(subnormal, e - subnormal_exponent, e);
+
+  // log(m) = 2 atanh(s) with s = (m-1)/(m+1) and |s| < 0.172
+  const T s = (m - T(1)) / (m + T(1));
+  const T z = s * s;
+  T p;
+  if constexpr (std::is_same_v<T, float>) {
+    constexpr float c[] = {1.f / 3, 1.f / 5, 1.f / 7, 1.f / 9, 1.f / 11};
+    p = details::polynomial(z, c);
+  }
+  else {
+    constexpr double c[] = {1. / 3,
+                            1. / 5,
+                            1. / 7,
+                            1. / 9,
+                            1. / 11,
+                            1. / 13,
+                            1. / 15,
+                            1. / 17,
+                            1. / 19,
+                            1. / 21,
+                            1. / 23};
+    p = details::polynomial(z, c);
+  }
+  const T two_s = s + s;
+  T y = e * traits::ln2_hi + (two_s + (two_s * z * p + e * traits::ln2_lo));
+
+  // Special values
+  y = simd::select(x == T(0), -inf, y);
+  y = simd::select(x < T(0), std::numeric_limits<T>::quiet_NaN(), y);
+  y = simd::select(x == inf, inf, y);
+  return simd::select(x != x, x, y);
+}
+
+/** @brief Vectorizable log(1+x), accurate for small x. */
+template <typename T>
+LBANN_SIMD_INLINE T log1p(T x)
+{
+  constexpr T inf = std::numeric_limits<T>::infinity();
+  // Correct log(u) for the rounding error in u = 1+x
+  const T u = T(1) + x;
+  T y = simd::log(u) - ((u - T(1)) - x) / u;
+  y = simd::select(u == T(1), x, y);
+  y = simd::select(x == T(-1), -inf, y);
+  return simd::select(x == inf, x, y);
+}
+
+/** @brief Vectorizable hyperbolic tangent. */
+template <typename T>
+LBANN_SIMD_INLINE T tanh(T x)
+{
+  using traits = details::float_traits<T>;
+  // tanh(|x|) = t/(t+2) with t = exp(2|x|)-1
+  const T a = details::clamp(std::fabs(x), T(0), traits::tanh_max);
+  const T t = simd::expm1(a + a);
+  const T y = t / (t + T(2));
+  return simd::select(x != x, x, std::copysign(y, x));
+}
+
+} // namespace simd
+} // namespace lbann
+
+#endif // LBANN_UTILS_SIMD_MATH_HPP_INCLUDED
@@ -0,0 +1,327 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_UTILS_SORT_KERNELS_HPP_INCLUDED
+#define LBANN_UTILS_SORT_KERNELS_HPP_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace lbann {
+namespace sort_kernels {
+
+/** @brief Sparse vector entry for top-k selection.
+ *
+ *  Entries are trivially copyable so that candidate lists can be
+ *  exchanged between processes as raw bytes.
+ */
+template <typename T, typename IndexT>
+struct top_k_entry
+{
+  /** Vector entry value. */
+  T value = min_value;
+  /** Vector entry index. */
+  IndexT index = max_index;
+
+  /** Minimum possible value. */
+  static constexpr T min_value = -std::numeric_limits<T>::infinity();
+  /** Maximum possible index. */
+  static constexpr IndexT max_index = std::numeric_limits<IndexT>::max();
+
+  /** Comparison operation to sort vector entries.
+   *  Entries are sorted by value in decreasing order, with ties
+   *  broken in favor of entries with smaller indices.
+   */
+  static bool compare(const top_k_entry& a, const top_k_entry& b)
+  {
+    return a.value > b.value || (a.value == b.value && a.index < b.index);
+  }
+};
+
+namespace details {
+
+/** @brief Scratch memory owned by the calling thread.
+ *
+ *  Kernels are called for many short columns in OpenMP loops, so
+ *  scratch buffers are kept per thread and reused instead of being
+ *  allocated for each column. The @c Tag distinguishes buffers that
+ *  are in use at the same time.
+ */
+template <typename T, int Tag = 0>
+std::vector<T>& thread_scratch(size_t size)
+{
+  thread_local std::vector<T> scratch;
+  if (scratch.size() < size) {
+    scratch.resize(size);
+  }
+  return scratch;
+}
+
+/** @brief Order-preserving map from floating-point values to unsigned
+ *  integers, used as radix sort keys.
+ *
+ *  Only specialized for IEEE single and double precision. Negative
+ *  and positive zero map to the same key so that they compare equal,
+ *  like they do with @c operator<.
+ */
+template <typename T>
+struct radix_key
+{
+  static constexpr bool supported = false;
+};
+
+template <typename FloatT, typename UIntT>
+struct float_radix_key
+{
+  static constexpr bool supported = true;
+  using type = UIntT;
+  static constexpr UIntT sign_bit = UIntT{1} << (8 * sizeof(UIntT) - 1);
+  static UIntT encode(FloatT x) noexcept
+  {
+    if (x == FloatT(0)) {
+      x = FloatT(0);
+    }
+    UIntT bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return (bits & sign_bit) ? ~bits : (bits | sign_bit);
+  }
+};
+
+template <>
+struct radix_key<float> : float_radix_key<float, uint32_t>
+{};
+template <>
+struct radix_key<double> : float_radix_key<double, uint64_t>
+{};
+
+/** Columns shorter than this are sorted with a comparison sort. */
+constexpr size_t radix_sort_min_size = 64;
+
+/** @brief Stable LSD radix argsort with 8-bit digits.
+ *
+ *  Passes in which all keys share the same digit are skipped.
+ */
+template <typename T, typename IndexT>
+void radix_argsort(const T* values, size_t size, IndexT* indices)
+{
+  using key_type = typename radix_key<T>::type;
+  constexpr size_t num_passes = sizeof(key_type);
+  constexpr size_t num_buckets = 256;
+
+  auto& keys = thread_scratch<key_type, 0>(2 * size);
+  auto& idx = thread_scratch<IndexT, 1>(2 * size);
+  key_type* keys_in = keys.data();
+  key_type* keys_out = keys.data() + size;
+  IndexT* idx_in = idx.data();
+  IndexT* idx_out = idx.data() + size;
+
+  // Encode keys and count digits for all passes at once
+  std::array<std::array<size_t, num_buckets>, num_passes> counts{};
+  for (size_t i = 0; i < size; ++i) {
+    const key_type key = radix_key<T>::encode(values[i]);
+    keys_in[i] = key;
+    idx_in[i] = static_cast<IndexT>(i);
+    for (size_t pass = 0; pass < num_passes; ++pass) {
+      ++counts[pass][(key >> (8 * pass)) & 0xFF];
+    }
+  }
+
+  for (size_t pass = 0; pass < num_passes; ++pass) {
+    auto& count = counts[pass];
+    const size_t shift = 8 * pass;
+    if (count[(keys_in[0] >> shift) & 0xFF] == size) {
+      continue;
+    }
+    std::array<size_t, num_buckets> offsets;
+    size_t offset = 0;
+    for (size_t b = 0; b < num_buckets; ++b) {
+      offsets[b] = offset;
+      offset += count[b];
+    }
+    for (size_t i = 0; i < size; ++i) {
+      const auto key = keys_in[i];
+      const size_t pos = offsets[(key >> shift) & 0xFF]++;
+      keys_out[pos] = key;
+      idx_out[pos] = idx_in[i];
+    }
+    std::swap(keys_in, keys_out);
+    std::swap(idx_in, idx_out);
+  }
+  std::copy(idx_in, idx_in + size, indices);
+}
+
+} // namespace details
+
+/** @brief Stable argsort in ascending order.
+ *
+ *  On exit, @c values[indices[0]], @c values[indices[1]], ... are in
+ *  ascending order and equal values appear in their original order.
+ *  Single and double precision values are sorted with a radix sort
+ *  that does not allocate memory once the calling thread's scratch
+ *  buffers are large enough. Other types use a comparison sort.
+ */
+template <typename T, typename IndexT>
+void argsort(const T* values, size_t size, IndexT* indices)
+{
+  if (size == 0) {
+    return;
+  }
+  if constexpr (details::radix_key<T>::supported) {
+    if (size >= details::radix_sort_min_size) {
+      details::radix_argsort(values, size, indices);
+      return;
+    }
+  }
+  for (size_t i = 0; i < size; ++i) {
+    indices[i] = static_cast<IndexT>(i);
+  }
+  std::stable_sort(indices, indices + size, [values](IndexT a, IndexT b) {
+    return values[a] < values[b];
+  });
+}
+
+/** @brief Find the top-k entries of a vector.
+ *
+ *  @param values      Vector entries.
+ *  @param size        Number of vector entries.
+ *  @param k           Number of entries to find.
+ *  @param get_index   Maps a position in @c values to the entry index
+ *                     reported in the output (e.g. a global row).
+ *  @param top_entries Output buffer with space for @c k entries. On
+ *                     exit, it holds the top-k entries sorted with
+ *                     @c top_k_entry::compare. If @c size is less than
+ *                     @c k, the remaining entries are default
+ *                     entries, which sort after all others.
+ *
+ *  Small @c k uses a bounded heap in the output buffer and rejects
+ *  most entries with one comparison, so the vector is only streamed
+ *  through once. Large @c k uses introselect on a copy of the entries
+ *  in the calling thread's scratch memory.
+ */
+template <typename T, typename IndexT, typename IndexFunction>
+void find_top_k(const T* values,
+                size_t size,
+                size_t k,
+                IndexFunction const& get_index,
+                top_k_entry<T, IndexT>* top_entries)
+{
+  using entry = top_k_entry<T, IndexT>;
+  if (k == 0) {
+    return;
+  }
+
+  // Short vectors: sort all entries
+  if (size <= k) {
+    for (size_t i = 0; i < size; ++i) {
+      top_entries[i].value = values[i];
+      top_entries[i].index = get_index(i);
+    }
+    std::fill(top_entries + size, top_entries + k, entry{});
+    std::sort(top_entries, top_entries + size, entry::compare);
+    return;
+  }
+
+  // Large k: introselect on a copy of the entries
+  if (8 * k >= size) {
+    auto& scratch = details::thread_scratch<entry>(size);
+    for (size_t i = 0; i < size; ++i) {
+      scratch[i].value = values[i];
+      scratch[i].index = get_index(i);
+    }
+    std::nth_element(scratch.begin(),
+                     scratch.begin() + (k - 1),
+                     scratch.begin() + size,
+                     entry::compare);
+    std::sort(scratch.begin(), scratch.begin() + k, entry::compare);
+    std::copy(scratch.begin(), scratch.begin() + k, top_entries);
+    return;
+  }
+
+  // Small k: the heap root is the worst of the current top-k entries
+  for (size_t i = 0; i < k; ++i) {
+    top_entries[i].value = values[i];
+    top_entries[i].index = get_index(i);
+  }
+  std::make_heap(top_entries, top_entries + k, entry::compare);
+  for (size_t i = k; i < size; ++i) {
+    if (values[i] < top_entries[0].value) {
+      continue;
+    }
+    const entry candidate{values[i], get_index(i)};
+    if (entry::compare(candidate, top_entries[0])) {
+      std::pop_heap(top_entries, top_entries + k, entry::compare);
+      top_entries[k - 1] = candidate;
+      std::push_heap(top_entries, top_entries + k, entry::compare);
+    }
+  }
+  std::sort_heap(top_entries, top_entries + k, entry::compare);
+}
+
+/** @brief Merge sorted top-k candidate lists.
+ *
+ *  @param candidates  @c num_lists lists of @c k entries, each sorted
+ *                     with @c top_k_entry::compare. List @c i starts
+ *                     at @c candidates[i*stride].
+ *  @param num_lists   Number of candidate lists.
+ *  @param stride      Distance between the starts of the lists.
+ *  @param k           Number of entries to find.
+ *  @param top_entries Output buffer with space for @c k entries.
+ */
+template <typename T, typename IndexT>
+void merge_top_k(const top_k_entry<T, IndexT>* candidates,
+                 size_t num_lists,
+                 size_t stride,
+                 size_t k,
+                 top_k_entry<T, IndexT>* top_entries)
+{
+  using entry = top_k_entry<T, IndexT>;
+  auto& cursors = details::thread_scratch<size_t, 2>(num_lists);
+  std::fill(cursors.begin(), cursors.begin() + num_lists, size_t{0});
+  for (size_t i = 0; i < k; ++i) {
+    size_t best = num_lists;
+    for (size_t list = 0; list < num_lists; ++list) {
+      if (cursors[list] < k &&
+          (best == num_lists ||
+           entry::compare(candidates[list * stride + cursors[list]],
+                          candidates[best * stride + cursors[best]]))) {
+        best = list;
+      }
+    }
+    top_entries[i] = candidates[best * stride + cursors[best]];
+    ++cursors[best];
+  }
+}
+
+} // namespace sort_kernels
+} // namespace lbann
+
+#endif // LBANN_UTILS_SORT_KERNELS_HPP_INCLUDED
@@ -50,6 +50,16 @@ void hwloc_print_topo();
 hwloc_cpuset_t get_local_cpuset_for_current_thread(hwloc_topology_t topo);
 
 #endif // LBANN_TOPO_AWARE
+
+/** @brief Bind the calling thread to a single processing unit.
+ *  @details @c index selects a processing unit among those available
+ *  to this process, in the same order used to place the I/O threads,
+ *  and wraps around if it is too large. Does nothing if LBANN is not
+ *  topology aware.
+ *  @returns Whether the thread was bound.
+ */
+bool bind_current_thread_to_pu(int index);
+
 } // namespace lbann
 
 #endif // LBANN_UTILS_HW_TOPOLOGY_HPP_INCLUDED
@@ -0,0 +1,229 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_UTILS_TRACING_HPP_INCLUDED
+#define LBANN_UTILS_TRACING_HPP_INCLUDED
+
+#include "lbann_config.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace lbann {
+
+// Forward declarations
+class lbann_comm;
+
+/** @brief Low-overhead event tracing.
+ *
+ *  Events are recorded into per-thread ring buffers, so recording
+ *  takes no locks: each buffer has a single writer (its thread) and
+ *  is only read when the trace is exported. Event names are interned
+ *  into integer ids once per call site (or once per thread for
+ *  dynamic names such as layer names). When a buffer is full, the
+ *  oldest events are overwritten.
+ *
+ *  The trace is exported in the Chrome Trace Event JSON format, which
+ *  can be opened in Perfetto (ui.perfetto.dev) or chrome://tracing.
+ *  Each rank is shown as a process and each thread (main, I/O,
+ *  communication progress) as a track. Timestamps are aligned across
+ *  ranks by a barrier when tracing starts.
+ *
+ *  Instrument code with the @c LBANN_TRACE_* macros, which compile to
+ *  nothing if LBANN is configured without tracing and only cost a
+ *  relaxed atomic load while tracing is not running.
+ */
+namespace tracing {
+
+/** @brief Interned event name. */
+using name_id = uint32_t;
+
+/** @brief Id that is never recorded. */
+constexpr name_id invalid_name = 0;
+
+/** @brief Event category, used to group and filter events. */
+enum class category : uint8_t
+{
+  forward_prop,
+  backward_prop,
+  optimizer,
+  io,
+  data_store,
+  comm,
+  region,
+};
+
+/** @brief Human-readable name of an event category. */
+char const* to_string(category cat) noexcept;
+
+namespace details {
+extern std::atomic<bool> enabled;
+} // namespace details
+
+/** @brief Whether events are currently being recorded. */
+inline bool is_enabled() noexcept
+{
+  return details::enabled.load(std::memory_order_relaxed);
+}
+
+/** @brief Nanoseconds on the tracing clock. */
+inline uint64_t now() noexcept
+{
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch())
+    .count();
+}
+
+/** @brief Intern an event name.
+ *  @details Thread-safe. Takes a global lock, so hot paths should
+ *  cache the id (the macros do).
+ */
+name_id intern(std::string const& name);
+
+/** @brief Intern an event name through a per-thread cache.
+ *  @details Avoids the global lock for names that are reused, such
+ *  as layer and weights names.
+ */
+name_id intern_cached(std::string const& name);
+
+/** @brief Record an event that spans [start, end] on this thread.
+ *
+ *  The event is dropped if the thread's buffer cannot be allocated.
+ */
+void record_complete(name_id name,
+                     category cat,
+                     uint64_t start,
+                     uint64_t end) noexcept;
+
+/** @brief Record a point event on this thread.
+ *
+ *  The event is dropped if the thread's buffer cannot be allocated.
+ */
+void record_instant(name_id name, category cat) noexcept;
+
+/** @brief Label this thread in the trace.
+ *  @details May be called before tracing starts.
+ */
+void set_thread_name(std::string const& name);
+
+/** @brief Start recording events.
+ *
+ *  Collective over the world communicator. Discards previously
+ *  recorded events.
+ *
+ *  @param events_per_thread Capacity of each thread's ring buffer.
+ */
+void start(lbann_comm const& comm, size_t events_per_thread = 1 << 18);
+
+/** @brief Stop recording events. */
+void stop();
+
+/** @brief Write the recorded events of all ranks to a JSON file.
+ *
+ *  Collective over the world communicator. The file is written by
+ *  the world master, which receives the other ranks' events in
+ *  chunks so that large traces do not overflow MPI counts. Recording
+ *  should be stopped first, since events recorded concurrently with
+ *  the export may be torn.
+ */
+void write_chrome_trace(lbann_comm const& comm, std::string const& filename);
+
+/** @brief RAII helper that records a complete event for its lifetime. */
+class scope
+{
+public:
+  scope(name_id name, category cat) noexcept
+    : m_name{is_enabled() ? name : invalid_name},
+      m_category{cat},
+      m_start{m_name != invalid_name ? now() : 0}
+  {}
+  ~scope()
+  {
+    if (m_name != invalid_name) {
+      record_complete(m_name, m_category, m_start, now());
+    }
+  }
+  scope(scope const&) = delete;
+  scope& operator=(scope const&) = delete;
+
+private:
+  name_id m_name;
+  category m_category;
+  uint64_t m_start;
+};
+
+} // namespace tracing
+} // namespace lbann
+
+#define LBANN_TRACE_CONCAT_IMPL(a, b) a##b
+#define LBANN_TRACE_CONCAT(a, b) LBANN_TRACE_CONCAT_IMPL(a, b)
+
+#if defined(LBANN_HAS_TRACING)
+
+/** @brief Trace the enclosing scope under a fixed name. */
+#define LBANN_TRACE_SCOPE(NAME, CAT)                                           \
+  static ::lbann::tracing::name_id const LBANN_TRACE_CONCAT(                   \
+    lbann_trace_name_,                                                         \
+    __LINE__) = ::lbann::tracing::intern(NAME);                                \
+  ::lbann::tracing::scope LBANN_TRACE_CONCAT(lbann_trace_scope_, __LINE__)(    \
+    LBANN_TRACE_CONCAT(lbann_trace_name_, __LINE__),                           \
+    ::lbann::tracing::category::CAT)
+
+/** @brief Trace the enclosing scope under a runtime name.
+ *  @details @c NAME is only evaluated while tracing is running.
+ */
+#define LBANN_TRACE_SCOPE_DYNAMIC(NAME, CAT)                                   \
+  ::lbann::tracing::scope LBANN_TRACE_CONCAT(lbann_trace_scope_, __LINE__)(    \
+    (::lbann::tracing::is_enabled() ? ::lbann::tracing::intern_cached(NAME)    \
+                                    : ::lbann::tracing::invalid_name),         \
+    ::lbann::tracing::category::CAT)
+
+/** @brief Record a point event under a fixed name. */
+#define LBANN_TRACE_INSTANT(NAME, CAT)                                         \
+  do {                                                                         \
+    if (::lbann::tracing::is_enabled()) {                                      \
+      static ::lbann::tracing::name_id const lbann_trace_name_ =               \
+        ::lbann::tracing::intern(NAME);                                        \
+      ::lbann::tracing::record_instant(lbann_trace_name_,                      \
+                                       ::lbann::tracing::category::CAT);       \
+    }                                                                          \
+  } while (0)
+
+/** @brief Label the calling thread in the trace. */
+#define LBANN_TRACE_THREAD_NAME(NAME) ::lbann::tracing::set_thread_name(NAME)
+
+#else
+
+#define LBANN_TRACE_SCOPE(NAME, CAT) ((void)0)
+#define LBANN_TRACE_SCOPE_DYNAMIC(NAME, CAT) ((void)0)
+#define LBANN_TRACE_INSTANT(NAME, CAT) ((void)0)
+#define LBANN_TRACE_THREAD_NAME(NAME) ((void)0)
+
+#endif // LBANN_HAS_TRACING
+
+#endif // LBANN_UTILS_TRACING_HPP_INCLUDED
@@ -164,6 +164,7 @@ public:
   void wait_for_full_weights() const override;
   /** @brief Releases the full view of the weights for memory reclamation. */
   void release_full_weights() const override;
+  size_t get_full_weights_memory_size() const override;
 
   /** Reconcile weight values.
    *  If weight values are duplicated across multiple processes, they
@@ -217,7 +218,32 @@ private:
   void do_move_values_(data_type_weights& other);
   void do_steal_values_(weights& other) override;
 
+  /** @brief Whether the full view can be gathered with non-blocking
+   *  communication.
+   *
+   *  This is the case for element-wise CPU shards that are distributed
+   *  over all processes (@c STAR_VC, or @c VC_STAR for column
+   *  vectors) and gathered into a @c STAR_STAR view, as long as the
+   *  padded gather buffer can be described with @c int counts. Other
+   *  cases are gathered synchronously in @c request_full_weights_async.
+   */
+  bool can_gather_full_weights_async() const;
+  /** @brief Copy the gathered shards from the staging buffer into the
+   *  full view. */
+  void unpack_full_weights() const;
+
 private:
+  /** Status of a request for the full view of sharded weights. */
+  enum class full_weights_status
+  {
+    /** No outstanding request. */
+    none,
+    /** Non-blocking gather has been started but not completed. */
+    pending,
+    /** Full view holds gathered weights that have not been accessed. */
+    ready
+  };
+
   /** Weight matrix (potentially sharded). */
   std::unique_ptr<AbsDistMatrixType> m_values;
 
@@ -226,6 +252,16 @@ private:
    */
   mutable std::unique_ptr<AbsDistMatrixType> m_values_view;
 
+  /** Status of @c m_values_view. */
+  mutable full_weights_status m_full_weights_status =
+    full_weights_status::none;
+  /** Request for the non-blocking gather of the full view. */
+  mutable Al::request m_full_weights_req;
+  /** Local shard, packed and padded to a uniform size on all ranks. */
+  mutable El::Matrix<TensorDataType, El::Device::CPU> m_gather_send_buffer;
+  /** Packed shards from all ranks, unpacked into the full view on wait. */
+  mutable El::Matrix<TensorDataType, El::Device::CPU> m_gather_recv_buffer;
+
   /** Weights initializer.
    *  Default is nullptr, which corresponds to zero initialization.
    */
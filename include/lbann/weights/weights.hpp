@@ -220,6 +220,8 @@ public:
   virtual void wait_for_full_weights() const = 0;
   /** @brief Releases the full view of the weights for memory reclamation. */
   virtual void release_full_weights() const = 0;
+  /** @brief Memory in bytes occupied by the full view of the weights. */
+  virtual size_t get_full_weights_memory_size() const = 0;
   ///@}
 
   // -----------------------------------------------
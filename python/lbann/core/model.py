@@ -42,7 +42,8 @@ class Model:
                  subgraph_communication=SubgraphCommunication.PT2PT,
                  subgraph_topology=False,
                  subgraph_num_common_resources=0,
-                 amp: AmpOptions = None):
+                 amp: AmpOptions = None,
+                 forward_only=False):
 
         # Scalar fields
         self.epochs = epochs
@@ -76,6 +77,9 @@ class Model:
         # AMP.
         self.amp = amp
 
+        # Inference-only execution.
+        self.forward_only = forward_only
+
     def export_proto(self):
         """Construct and return a protobuf message."""
         # Initialize protobuf message
@@ -86,6 +90,7 @@ class Model:
         model.subgraph_communication = convert_to_protbuf_enums(self.subgraph_communication)
         model.enable_subgraph_topology = self.subgraph_topology
         model.subgraph_parent_grid_resources = self.subgraph_num_common_resources
+        model.forward_only = self.forward_only
         if self.summary_dir is not None:
             model.summarizer.dir = self.summary_dir
         # Add model components
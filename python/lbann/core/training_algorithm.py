@@ -258,7 +258,7 @@ class RandomPairwiseExchange(MetaLearningStrategy):
         no effort has been made here to mirror the C++ polymorphism in
         this Python wrapper.
 
-        There are currently three strategies that are subtly different
+        There are currently four strategies that are subtly different
         in the way they exchange model data.
 
         1. "checkpoint_binary": This is the default strategy. Entire
@@ -284,12 +284,22 @@ class RandomPairwiseExchange(MetaLearningStrategy):
            happen to work, this essentially implies that the model
            topology should be homogenous across all trainers.
 
+        4. "packed_sendrecv_weights": Like "sendrecv_weights", but the
+           selected weights (and optionally the SGD/Adam optimizer
+           state, when `exchange_optimizer_state=True`) are packed
+           into one buffer that is streamed to the partner in chunks
+           of at most `chunk_size` entries. The partner weights are
+           evaluated in place in the local model, so no model copy
+           is made. The same homogeneity assumptions apply.
+
         """
 
         def __init__(self, strategy: str = "checkpoint_binary",
                      weights_names: list[str] = [],
                      exchange_hyperparameters: bool = False,
-                     checkpoint_dir: str = None):
+                     checkpoint_dir: str = None,
+                     exchange_optimizer_state: bool = False,
+                     chunk_size: int = 0):
             """Construct a new exchange strategy.
 
             Args:
@@ -302,11 +312,20 @@ class RandomPairwiseExchange(MetaLearningStrategy):
                   the "sendrecv_weights" strategy.
                 checkpoint_dir: A path to a directory for storing the
                   checkpoint files. Only applies to "checkpoint_file".
+                exchange_optimizer_state:
+                  If True, also exchange SGD velocity and Adam
+                  moments and bias-correction products. Only applies
+                  to "packed_sendrecv_weights".
+                chunk_size:
+                  Maximum number of entries per message (0 uses the
+                  default). Only applies to "packed_sendrecv_weights".
             """
             self.strategy = strategy
             self.exchange_hyperparameters = exchange_hyperparameters
             self.weights_names = make_iterable(weights_names)
             self.checkpoint_dir = checkpoint_dir
+            self.exchange_optimizer_state = exchange_optimizer_state
+            self.chunk_size = chunk_size
 
         def export_proto(self):
             """Get a protobuf representation of this object."""
@@ -324,6 +343,9 @@ class RandomPairwiseExchange(MetaLearningStrategy):
                     raise Exception("Must provide checkpoint dir")
             elif self.strategy == "sendrecv_weights":
                 msg.sendrecv_weights.exchange_hyperparameters = self.exchange_hyperparameters
+            elif self.strategy == "packed_sendrecv_weights":
+                msg.packed_sendrecv_weights.exchange_optimizer_state = self.exchange_optimizer_state
+                msg.packed_sendrecv_weights.chunk_size = self.chunk_size
             else:
                 raise ValueError("Unknown strategy")
             return msg
@@ -331,7 +353,8 @@ class RandomPairwiseExchange(MetaLearningStrategy):
     def __init__(self,
                  metric_strategies: dict[str,int] = {},
                  exchange_strategy = ExchangeStrategy(),
-                 mutation_strategy = MutationStrategy()):
+                 mutation_strategy = MutationStrategy(),
+                 paired_evaluation: bool = False):
         """Construct a new RandomPairwiseExchange metalearning strategy.
 
         Args:
@@ -342,11 +365,15 @@ class RandomPairwiseExchange(MetaLearningStrategy):
               The algorithm used for exchanging models.
             mutation_strategy:
               The algorithm used for mutating models.
+            paired_evaluation:
+              If True, evaluate the local and partner models in a
+              single pass over the tournament data set.
         """
 
         self.metric_strategies = metric_strategies
         self.exchange_strategy = exchange_strategy
         self.mutation_strategy = mutation_strategy
+        self.paired_evaluation = paired_evaluation
 
     def export_proto(self):
         """Get a protobuf representation of this object."""
@@ -357,6 +384,7 @@ class RandomPairwiseExchange(MetaLearningStrategy):
 
         msg.exchange_strategy.CopyFrom(self.exchange_strategy.export_proto())
         msg.mutation_strategy.CopyFrom(self.mutation_strategy.export_proto())
+        msg.paired_evaluation = self.paired_evaluation
         return msg
 
 class TruncationSelectionExchange(MetaLearningStrategy):
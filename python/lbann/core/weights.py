@@ -31,6 +31,47 @@ class ShardingStrategy(Enum):
         GRID_COLS = 2 # Sharded across the process grid columns (STAR x MR)
 
 
+class GradientCompression:
+    """Compression of the gradient before data-parallel synchronization.
+
+    Only applies to non-sharded float or double weights with CPU
+    gradients.
+
+    Args:
+        type (GradientCompression.Type): Compression scheme.
+        ratio (float, optional): Fraction of entries sent by the
+            sparsifying schemes (default: 0.01).
+        error_feedback (bool): Carry the unsent part of the gradient
+            over to the next step (sparsifying schemes only).
+        seed (int, optional): Seed for random-k index selection.
+
+    """
+
+    class Type(Enum):
+        NONE = 0     # Full-precision allreduce
+        FP16 = 1     # Half-precision allreduce with dynamic scaling
+        BF16 = 2     # bfloat16 allreduce
+        TOP_K = 3    # Allgather of the largest entries on each rank
+        RANDOM_K = 4 # Allreduce of a random subset of entries
+
+    def __init__(self, type, ratio=None, error_feedback=True, seed=None):
+        self.type = type
+        self.ratio = ratio
+        self.error_feedback = error_feedback
+        self.seed = seed
+
+    def export_proto(self):
+        """Construct and return a protobuf message."""
+        proto = weights_pb2.GradientCompression()
+        proto.type = self.type.value
+        if self.ratio is not None:
+            proto.ratio = self.ratio
+        proto.disable_error_feedback = not self.error_feedback
+        if self.seed is not None:
+            proto.seed = self.seed
+        return proto
+
+
 class Weights:
     """Trainable parameters for neural network."""
 
@@ -38,7 +79,8 @@ class Weights:
 
     def __init__(self, initializer=None, optimizer=None, name=None,
                  datatype=None, sharded=None,
-                 sharding_strategy: Optional[ShardingStrategy] = None):
+                 sharding_strategy: Optional[ShardingStrategy] = None,
+                 gradient_compression: Optional[GradientCompression] = None):
         Weights.global_count += 1
         self.name = name if name else 'weights{0}'.format(Weights.global_count)
         self.initializer = initializer
@@ -46,6 +88,7 @@ class Weights:
         self.datatype = datatype
         self.sharded = sharded
         self.sharding_strategy = sharding_strategy
+        self.gradient_compression = gradient_compression
 
     def export_proto(self):
         """Construct and return a protobuf message."""
@@ -72,4 +115,8 @@ class Weights:
         if self.sharding_strategy is not None:
             proto.sharding_strategy = self.sharding_strategy.value
 
+        if self.gradient_compression is not None:
+            proto.gradient_compression.CopyFrom(
+                self.gradient_compression.export_proto())
+
         return proto
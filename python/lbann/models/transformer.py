@@ -342,7 +342,8 @@ class TransformerDecoderLayer(lbann.modules.Module):
                           name=f'{self.name}_fc2_bias'),
         ]
 
-    def forward(self, x, memory, src_mask=None, tgt_mask=None):
+    def forward(self, x, memory, src_mask=None, tgt_mask=None,
+                tgt_causal=False):
         """Apply Transformer decoder layer.
 
         Args:
@@ -354,6 +355,8 @@ class TransformerDecoderLayer(lbann.modules.Module):
                 `memory`).
             tgt_mask (lbann.Layer, optional): Attention mask for first
                 attention module (attends only to `x`).
+            tgt_causal (bool): Whether the first attention module masks
+                subsequent positions itself. Requires fused attention.
 
         Returns:
             lbann.Layer: Sequence of output vectors.
@@ -368,7 +371,13 @@ class TransformerDecoderLayer(lbann.modules.Module):
             y = x
 
         # Self-attention with residual connection
-        y = self.attention1(y, y, y, mask=tgt_mask, **self.extra_layer_args)
+        attn_kwargs = dict(causal=True) if tgt_causal else {}
+        y = self.attention1(y,
+                            y,
+                            y,
+                            mask=tgt_mask,
+                            **attn_kwargs,
+                            **self.extra_layer_args)
         if self.dropout_prob > 0:
             y = lbann.Dropout(
                 y,
@@ -656,12 +665,18 @@ class Transformer(lbann.modules.Module):
         # Decoder stack
         x = target
 
-        # Create mask if not given
+        # Create mask if not given. Fused attention layers mask
+        # subsequent positions without a mask tensor.
+        causal = False
         if target_mask is None:
-            target_mask = self._subsequent_mask(target_length)
+            if all(getattr(dec.attention1, 'fused', False)
+                   for dec in self.decoder):
+                causal = True
+            else:
+                target_mask = self._subsequent_mask(target_length)
 
         # For attention-head parallelism, replicate mask for each subgraph
-        if self.parallel_attention_heads > 0:
+        if target_mask is not None and self.parallel_attention_heads > 0:
             target_mask = [
                 lbann.Identity(target_mask,
                                name=f'tgtmask_branch{i}',
@@ -670,6 +685,9 @@ class Transformer(lbann.modules.Module):
             ]
 
         for decoder_layer in self.decoder:
-            x = decoder_layer(x, memory, tgt_mask=target_mask)
+            x = decoder_layer(x,
+                              memory,
+                              tgt_mask=target_mask,
+                              tgt_causal=causal)
 
         return x
@@ -31,6 +31,12 @@ class MultiheadAttention(Module):
             probability matrix before softmax. If None, does not apply.
         positional_encoding (SequenceEncoding): An optional positional encoding
             object that may apply on each input.
+        fused (bool): If True, computes the attention heads with the fused
+            ScaledDotProductAttention layer, which never stores the full
+            attention matrix. Requires batched heads, no subgraph
+            parallelism, and no attention bias. If None, the fused layer is
+            used whenever these conditions hold and LBANN is built without
+            GPU support (the fused layer only runs on CPU).
         name (str): Default name is in the form
             'multiheadattention<index>'.
 
@@ -47,6 +53,7 @@ class MultiheadAttention(Module):
                  subgraph_branches: int = 0,
                  bias: Optional[lbann.Layer] = None,
                  positional_encoding: Optional[SequenceEncoding] = None,
+                 fused: Optional[bool] = None,
                  name: str = None):
         super().__init__()
         MultiheadAttention.global_count += 1
@@ -73,6 +80,15 @@ class MultiheadAttention(Module):
         else:
             self.separate_heads = not batch_heads
 
+        # Fused attention layer
+        fusable = not self.separate_heads and bias is None
+        if fused is None:
+            fused = fusable and not lbann.has_feature('GPU')
+        elif fused and not fusable:
+            raise ValueError('Fused attention requires batched heads, no '
+                             'subgraph parallelism, and no attention bias')
+        self.fused = fused
+
         # Module name
         self.name = name
         if not self.name:
@@ -119,6 +135,7 @@ class MultiheadAttention(Module):
                 values,
                 mask=None,
                 seqlen=None,
+                causal=False,
                 **extra_kwargs):
         """Apply multi-head attention.
 
@@ -136,6 +153,8 @@ class MultiheadAttention(Module):
                 the ith query does not attend to the jth key/value pair.
             seqlen (int): Optional sequence length of the current set of
                 sequences. If not given, max sequence length is assumed.
+            causal (bool): If True, the ith query only attends to the first
+                i+1 key/value pairs. Requires fused attention.
 
         Returns:
             lbann.Layer: Sequence of output vectors. The sequence
@@ -195,7 +214,23 @@ class MultiheadAttention(Module):
             queries_fc, keys_fc, values_fc = self.positional_encoding.apply_layer(
                 queries_fc, keys_fc, values_fc, seqlen, **extra_kwargs)
 
-        if self.separate_heads:
+        use_fused = self.fused and mask is None
+        if causal and not use_fused:
+            raise ValueError('Causal attention requires fused attention '
+                             'and no explicit mask')
+
+        if use_fused:
+            attentions = lbann.ScaledDotProductAttention(
+                queries_fc,
+                keys_fc,
+                values_fc,
+                num_heads=self.num_heads,
+                causal=causal,
+                dropout=self.dropout,
+                name=f'{name}_all_heads',
+                **extra_kwargs,
+            )
+        elif self.separate_heads:
             attentions = self.dot_product_attn_separate_heads(
                 name, queries_fc, keys_fc, values_fc, mask, **extra_kwargs)
         else:
@@ -28,9 +28,11 @@ FP32_LAYERS = frozenset([
     lbann.MeanAbsoluteError,
     lbann.L1Norm,
     lbann.L2Norm2,
+    lbann.SoftmaxCrossEntropy,
     lbann.Softmax,
     lbann.LogSoftmax,
     lbann.ChannelwiseSoftmax,
+    lbann.ScaledDotProductAttention,
     lbann.LayerNorm
 ])
 
@@ -10,6 +10,9 @@ from typing import Dict, List, Optional, Union
 from numpy.typing import ArrayLike
 import concurrent.futures as cf
 from multiprocessing import resource_tracker
+import ctypes
+import ctypes.util
+import platform
 
 
 class Sample:
@@ -159,13 +162,165 @@ class DistConvDataset(Dataset):
         self._num_io_partitions = num_io_partitions
 
 
+def _release_store_function():
+    """
+    Find a function that stores an int64 with release semantics.
+
+    Python has no memory fences, so the ready flags of a SampleRing are
+    written with libatomic's ``__atomic_store_8``. Without libatomic, a
+    plain store is only used on x86, where stores are not reordered
+    with earlier stores.
+    """
+    path = ctypes.util.find_library("atomic")
+    if path is not None:
+        atomic_store = ctypes.CDLL(path).__atomic_store_8
+        atomic_store.argtypes = [ctypes.c_void_p, ctypes.c_uint64, ctypes.c_int]
+        atomic_store.restype = None
+
+        def store(address: int, value: int) -> None:
+            atomic_store(address, value, 3)  # __ATOMIC_RELEASE
+
+        return store
+
+    if platform.machine().lower() in ("x86_64", "amd64", "i386", "i686"):
+
+        def store(address: int, value: int) -> None:
+            ctypes.c_int64.from_address(address).value = value
+
+        return store
+
+    raise RuntimeError(
+        "The shared-memory sample ring requires libatomic on "
+        f"{platform.machine()}"
+    )
+
+
+class SampleRing:
+    """
+    Shared-memory ring buffer that worker processes write samples into.
+
+    Each data field is stored in its own region, laid out as a
+    column-major matrix with one column per ring slot, so a run of
+    consecutive slots can be copied directly into LBANN's mini-batch
+    matrices. Each slot has an int64 ready flag that holds one plus
+    the sequence number of the last sample written into it. Samples
+    are assigned to slots in the order they are queued, so the sample
+    with sequence number ``s`` lives in slot ``s % num_slots``.
+    """
+
+    # Byte alignment of each region in the shared memory segment
+    alignment = 64
+
+    def __init__(
+        self,
+        num_slots: int,
+        field_sizes: Dict[str, int],
+        dtype: str,
+        name: Optional[str] = None,
+    ) -> None:
+        """
+        SampleRing Constructor
+
+        :param num_slots: Number of samples the ring can hold
+        :type num_slots: int
+        :param field_sizes: Number of entries per sample in each data field
+        :type field_sizes: Dict[str, int]
+        :param dtype: Data type of the sample entries
+        :type dtype: str
+        :param name: Name of an existing ring to attach to, defaults to
+            creating a new ring
+        :type name: Optional[str], optional
+        """
+        self.num_slots = num_slots
+        self.field_sizes = dict(field_sizes)
+        self.dtype = np.dtype(dtype)
+
+        def align(offset):
+            return -(-offset // self.alignment) * self.alignment
+
+        offsets = {}
+        size = num_slots * np.dtype(np.int64).itemsize
+        for field, field_size in self.field_sizes.items():
+            offsets[field] = align(size)
+            size = offsets[field] + num_slots * field_size * self.dtype.itemsize
+
+        self.owner = name is None
+        if self.owner:
+            self.shm = SharedMemory(create=True, size=size)
+        else:
+            self.shm = SharedMemory(name=name)
+            resource_tracker.unregister(
+                self.shm._name, "shared_memory"
+            )  # Prevent the resource tracker from interfering during process pool shutdown
+
+        self.flags = np.ndarray(num_slots, dtype=np.int64, buffer=self.shm.buf)
+        self.fields = {
+            field: np.ndarray(
+                (num_slots, field_size),
+                dtype=self.dtype,
+                buffer=self.shm.buf,
+                offset=offsets[field],
+            )
+            for field, field_size in self.field_sizes.items()
+        }
+        if self.owner:
+            self.flags[:] = 0
+        self._release_store = _release_store_function()
+
+    def spec(self) -> tuple:
+        """
+        Arguments needed to attach to this ring from another process.
+        """
+        return (self.num_slots, self.field_sizes, self.dtype.str, self.shm.name)
+
+    def buffers(self) -> Dict[str, int]:
+        """
+        Return pointers to the ready flags and to each data field.
+        """
+        buffers = {"flags": self.flags.ctypes.data}
+        for field, arr in self.fields.items():
+            buffers[field] = arr.ctypes.data
+        return buffers
+
+    def write(self, sequence_number: int, sample: Sample) -> None:
+        """
+        Write a sample into its slot and mark the slot as ready.
+        """
+        slot = sequence_number % self.num_slots
+        for field, arr in self.fields.items():
+            arr[slot, :] = getattr(sample, field).ravel()
+
+        # The sample must be visible before the flag. LBANN reads the
+        # flag with acquire semantics.
+        self._release_store(
+            self.flags.ctypes.data + slot * self.flags.itemsize,
+            sequence_number + 1,
+        )
+
+    def close(self) -> None:
+        """
+        Unmap the ring and, if this process created it, free it.
+        """
+        # Views into the shared memory must be released before closing
+        self.flags = None
+        self.fields = {}
+        self.shm.close()
+        if self.owner:
+            self.shm.unlink()
+
+
 class DataReader:
     """
     Helper class used by LBANN to control worker processes and handle sample/batch loading.
     """
 
     def __init__(
-        self, dataset: Dataset, num_procs: int, prefetch_factor: int, dtype: str
+        self,
+        dataset: Dataset,
+        num_procs: int,
+        prefetch_factor: int,
+        dtype: str,
+        ring_size: int = 0,
     ) -> None:
         """
         DataReader Constructor
@@ -180,6 +335,10 @@ class DataReader:
         :type prefetch_factor: int
         :param dtype: Type of the batches to be returned
         :type dtype: str
+        :param ring_size: If positive, workers write samples into a
+            SampleRing with this many slots instead of returning them
+            through get_batch, defaults to 0
+        :type ring_size: int, optional
         """
         self.dataset = dataset
         self.num_procs = num_procs
@@ -196,27 +355,36 @@ class DataReader:
         if isinstance(self.dataset, DistConvDataset):
             self.num_io_partitions = self.dataset.num_io_partitions
 
-        self.pool = Pool(
-            processes=num_procs,
-            initializer=DataReader.init_worker,
-            initargs=(self.dataset,),
-        )
-
         self.shm_size = 0
+        field_sizes = {}
         if hasattr(self.sample_dims, "sample"):
             self.sample_size = (
                 np.prod(self.sample_dims.sample) // self.num_io_partitions
             )
             self.shm_size += self.sample_size
+            field_sizes["sample"] = int(self.sample_size)
         if hasattr(self.sample_dims, "label"):
-            self.label_size = np.prod(self.sample_dims.sample)
+            self.label_size = self.sample_dims.label
             self.shm_size += self.label_size
+            field_sizes["label"] = int(self.label_size)
         if hasattr(self.sample_dims, "response"):
             self.response_size = self.sample_dims.response
             self.shm_size += self.response_size
+            field_sizes["response"] = int(self.response_size)
+
+        self.ring = None
+        self.ring_sequence_number = 0
+        if ring_size > 0:
+            self.ring = SampleRing(ring_size, field_sizes, self.dtype)
+
+        self.pool = Pool(
+            processes=num_procs,
+            initializer=DataReader.init_worker,
+            initargs=(self.dataset, self.ring.spec() if self.ring else None),
+        )
 
     @staticmethod
-    def init_worker(dataset):
+    def init_worker(dataset, ring_spec=None):
         """
         Initialize worker process.
 
@@ -233,8 +401,9 @@ class DataReader:
                 pass
 
         # Process-local storage
-        global g_dataset
+        global g_dataset, g_ring
         g_dataset = dataset
+        g_ring = SampleRing(*ring_spec) if ring_spec is not None else None
 
     def terminate(self) -> None:
         """
@@ -246,6 +415,10 @@ class DataReader:
             shm.close()
             shm.unlink()
 
+        if self.ring is not None:
+            self.ring.close()
+            self.ring = None
+
     @staticmethod
     def load_sample(ind, shm_name, shm_size, dtype) -> Sample:
         """
@@ -301,16 +474,73 @@ class DataReader:
             )
         )
 
-    def queue_samples(self, inds: List[int]) -> None:
+    @staticmethod
+    def load_samples_into_ring(first_sequence_number, inds) -> None:
+        """
+        Loads samples from the dataset and writes them into the ring.
+        This function must be called from a worker process.
+
+        :param first_sequence_number: Sequence number of the first sample
+        :type first_sequence_number: int
+        :param inds: Indices to load
+        :type inds: np.ndarray
+        """
+        for i, ind in enumerate(inds.tolist()):
+            g_ring.write(first_sequence_number + i, g_dataset[ind])
+
+    def ring_buffers(self) -> Dict[str, int]:
+        """
+        Return pointers to the ready flags and data fields of the ring.
+        """
+        return self.ring.buffers()
+
+    def poll(self) -> None:
+        """
+        Raise any exception from a finished worker job and forget
+        finished jobs. Only used with a SampleRing.
+        """
+        if self.ring is None:
+            return
+        pending = []
+        for result in self.loaded_samples:
+            if result.ready():
+                result.get()
+            else:
+                pending.append(result)
+        self.loaded_samples = pending
+
+    def queue_samples(self, inds: Union[List[int], memoryview]) -> None:
         """
         Set the indices to be loaded this epoch and start submitting jobs
         to the worker pool.
 
-        :param inds: List of sample indices
-        :type inds: List[int]
-        """
-        for ind in inds:
-            self.load_next_sample_async(ind)
+        :param inds: Sample indices, either as a list or a buffer of int64
+        :type inds: Union[List[int], memoryview]
+        """
+        if not isinstance(inds, list):
+            # Copy since the buffer is only valid during this call
+            inds = np.frombuffer(inds, dtype=np.int64).copy()
+
+        if self.ring is None:
+            for ind in list(inds):
+                self.load_next_sample_async(int(ind))
+            return
+
+        # Split samples into one contiguous job per worker
+        self.poll()
+        inds = np.asarray(inds, dtype=np.int64)
+        chunk_size = max(-(-len(inds) // self.num_procs), 1)
+        for start in range(0, len(inds), chunk_size):
+            self.loaded_samples.append(
+                self.pool.apply_async(
+                    DataReader.load_samples_into_ring,
+                    (
+                        self.ring_sequence_number + start,
+                        inds[start : start + chunk_size],
+                    ),
+                )
+            )
+        self.ring_sequence_number += len(inds)
 
     def get_batch(self, batch_size: int) -> Dict[str, Union[np.ndarray, int]]:
         """
@@ -385,6 +615,7 @@ def construct_python_dataset_reader(
     validation_fraction: Optional[float] = 0.0,
     load_module: Optional[bool] = True,
     prefetch_factor: Optional[int] = 1,
+    shared_memory_ring: Optional[bool] = False,
 ) -> lbann.reader_pb2.Reader:
     """
     Helper function to take a Dataset object, pickle it, save it, and return
@@ -407,6 +638,10 @@ def construct_python_dataset_reader(
     :type load_module: Optional[bool], optional
     :param prefetch_factor: Number of samples to prefetch per data reader process, defaults to 1
     :type prefetch_factor: Optional[int], optional
+    :param shared_memory_ring: If enabled, data reader processes write samples
+        directly into a shared-memory ring that LBANN reads without
+        holding the Python GIL, defaults to False
+    :type shared_memory_ring: Optional[bool], optional
     :return: LBANN Reader protobuf message
     :rtype: lbann.reader_pb2.Reader
     """
@@ -433,6 +668,7 @@ def construct_python_dataset_reader(
             dataset_path=dataset_path,
             module_dir=module_dir,
             prefetch_factor=prefetch_factor,
+            shared_memory_ring=shared_memory_ring,
         ),
     )
 
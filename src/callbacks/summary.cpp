@@ -75,6 +75,9 @@ void summary::on_batch_end(model* m)
   size_t trainer_barriers = comm->get_num_trainer_barriers();
   size_t intertrainer_barriers = comm->get_num_intertrainer_barriers();
   size_t global_barriers = comm->get_num_global_barriers();
+  const bool has_progress_thread = comm->has_progress_thread();
+  EvalType comm_overlap_time = comm->get_comm_overlap_time();
+  EvalType comm_wait_time = comm->get_comm_wait_time();
   comm->reset_stats_counters();
   m_summarizer->sum_reduce_scalar("bytes_sent", bytes_sent, c.get_step());
   m_summarizer->sum_reduce_scalar("bytes_received",
@@ -87,6 +90,14 @@ void summary::on_batch_end(model* m)
                               intertrainer_barriers,
                               c.get_step());
   m_summarizer->reduce_scalar("global_barriers", global_barriers, c.get_step());
+  if (has_progress_thread) {
+    m_summarizer->reduce_scalar("comm_overlap_time",
+                                comm_overlap_time,
+                                c.get_step());
+    m_summarizer->reduce_scalar("comm_wait_time",
+                                comm_wait_time,
+                                c.get_step());
+  }
   prof_region_end("summary-batch", false);
 }
 
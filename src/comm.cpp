@@ -28,6 +28,7 @@
 
 #define LBANN_COMM_INSTANTIATE
 #include "lbann/comm_impl.hpp"
+#include "lbann/comm_progress_engine.hpp"
 #include "lbann/utils/exception.hpp"
 #include "lbann/utils/gpu/helpers.hpp"
 #include "lbann/utils/memory.hpp"
@@ -87,6 +88,7 @@ lbann_comm::lbann_comm(int ppm, El::mpi::Comm world)
 
 lbann_comm::~lbann_comm()
 {
+  m_progress_engine.reset();
   m_grid.reset();
   El::mpi::Free(m_trainer_comm);
   El::mpi::Free(m_intertrainer_comm);
@@ -565,8 +567,8 @@ void lbann_comm::allreduce(El::AbstractMatrix<TensorDataType>& m,
   }
 
   const int local_size = m.Height() * m.Width();
-  m_bytes_sent += sizeof(DataType) * local_size;
-  m_bytes_received += sizeof(DataType) * local_size * (El::mpi::Size(c) - 1);
+  m_bytes_sent += sizeof(TensorDataType) * local_size;
+  m_bytes_received += sizeof(TensorDataType) * local_size * (El::mpi::Size(c) - 1);
 
   switch (m.GetDevice()) {
   case El::Device::CPU:
@@ -603,16 +605,18 @@ void lbann_comm::nb_allreduce(El::AbstractMatrix<TensorDataType>& m,
   }
 
   const int local_size = m.Height() * m.Width();
-  m_bytes_sent += sizeof(DataType) * local_size;
-  m_bytes_received += sizeof(DataType) * local_size * (El::mpi::Size(c) - 1);
+  m_bytes_sent += sizeof(TensorDataType) * local_size;
+  m_bytes_received += sizeof(TensorDataType) * local_size * (El::mpi::Size(c) - 1);
 
   switch (m.GetDevice()) {
   case El::Device::CPU:
-    return nb_allreduce_impl(
+    nb_allreduce_impl(
       static_cast<El::Matrix<TensorDataType, El::Device::CPU>&>(m),
       c,
       req,
       op);
+    track_request(req);
+    return;
 #ifdef LBANN_HAS_GPU
   case El::Device::GPU:
     return nb_allreduce_impl(
@@ -652,9 +656,13 @@ void lbann_comm::wait(Al::request& req) const
   }
 #endif // AL_HAS_HOST_TRANSFER
 #endif // LBANN_HAS_ALUMINUM
+  // Tracked requests must only be completed through the progress engine
+  if (m_progress_engine != nullptr &&
+      m_progress_engine->wait(&(req.raw_mpi_req))) {
+    return;
+  }
   if (req.raw_mpi_req != MPI_REQUEST_NULL) {
     MPI_Wait(&(req.raw_mpi_req), MPI_STATUS_IGNORE);
-    ;
   }
 }
 
@@ -677,6 +685,11 @@ bool lbann_comm::test(Al::request& req) const
   }
 #endif // AL_HAS_HOST_TRANSFER
 #endif // LBANN_HAS_ALUMINUM
+  bool complete = false;
+  if (m_progress_engine != nullptr &&
+      m_progress_engine->test(&(req.raw_mpi_req), complete)) {
+    return req_test && complete;
+  }
   if (req.raw_mpi_req != MPI_REQUEST_NULL) {
     int flag = 0;
     MPI_Test(&(req.raw_mpi_req), &flag, MPI_STATUS_IGNORE);
@@ -685,6 +698,54 @@ bool lbann_comm::test(Al::request& req) const
   return req_test;
 }
 
+void lbann_comm::track_request(Al::request& req) const
+{
+  if (m_progress_engine != nullptr) {
+    m_progress_engine->track(&(req.raw_mpi_req));
+  }
+}
+
+void lbann_comm::start_progress_thread(int pu_index)
+{
+  if (m_progress_engine != nullptr) {
+    return;
+  }
+  if (!comm_progress_engine::is_supported()) {
+    if (am_world_master()) {
+      LBANN_WARNING("MPI was not initialized with MPI_THREAD_MULTIPLE, "
+                    "not starting the communication progress thread");
+    }
+    return;
+  }
+  m_progress_engine = std::make_unique<comm_progress_engine>(pu_index);
+}
+
+void lbann_comm::stop_progress_thread() { m_progress_engine.reset(); }
+
+double lbann_comm::get_comm_overlap_time() const
+{
+  return (m_progress_engine != nullptr ? m_progress_engine->get_overlap_time()
+                                       : 0.0);
+}
+
+double lbann_comm::get_comm_wait_time() const
+{
+  return (m_progress_engine != nullptr ? m_progress_engine->get_wait_time()
+                                       : 0.0);
+}
+
+void lbann_comm::reset_stats_counters()
+{
+  m_num_trainer_barriers = 0;
+  m_num_intertrainer_barriers = 0;
+  m_num_global_barriers = 0;
+  m_bytes_sent = 0;
+  m_bytes_received = 0;
+  if (m_progress_engine != nullptr) {
+    m_progress_engine->reset_counters();
+  }
+}
+
 void lbann_comm::intertrainer_broadcast_matrix(AbsMat& mat, int root) const
 {
   El::Broadcast(mat, m_intertrainer_comm, root);
@@ -0,0 +1,221 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/comm_progress_engine.hpp"
+#include "lbann/utils/exception.hpp"
+#include "lbann/utils/threads/thread_topology.hpp"
+#include "lbann/utils/timer.hpp"
+#include "lbann/utils/tracing.hpp"
+
+#include <algorithm>
+
+namespace lbann {
+
+comm_progress_engine::comm_progress_engine(int pu_index)
+{
+  if (!is_supported()) {
+    LBANN_ERROR("communication progress thread requires MPI to be "
+                "initialized with MPI_THREAD_MULTIPLE");
+  }
+  m_thread = std::thread(&comm_progress_engine::progress_loop, this, pu_index);
+}
+
+comm_progress_engine::~comm_progress_engine()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_work_cv.notify_all();
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+}
+
+bool comm_progress_engine::is_supported()
+{
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Query_thread(&provided);
+  return provided == MPI_THREAD_MULTIPLE;
+}
+
+void comm_progress_engine::track(MPI_Request* req)
+{
+  if (req == nullptr || *req == MPI_REQUEST_NULL) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (find(*req) != m_requests.end()) {
+      LBANN_ERROR("attempted to track an MPI request that is still in flight");
+    }
+    m_requests.push_back({*req, get_time(), 0.0, false});
+    ++m_num_pending;
+  }
+  m_work_cv.notify_one();
+}
+
+bool comm_progress_engine::wait(MPI_Request* req)
+{
+  if (req == nullptr || *req == MPI_REQUEST_NULL) {
+    return false;
+  }
+  const MPI_Request handle = *req;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (find(handle) == m_requests.end()) {
+      return false;
+    }
+    const double wait_start = get_time();
+    m_done_cv.wait(lock, [this, handle] { return find(handle)->done; });
+    retire(find(handle), wait_start);
+  }
+  // The request has completed, so this only frees it
+  MPI_Wait(req, MPI_STATUS_IGNORE);
+  return true;
+}
+
+bool comm_progress_engine::test(MPI_Request* req, bool& complete)
+{
+  if (req == nullptr || *req == MPI_REQUEST_NULL) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = find(*req);
+    if (it == m_requests.end()) {
+      return false;
+    }
+    complete = it->done;
+    if (!complete) {
+      return true;
+    }
+    retire(it, get_time());
+  }
+  MPI_Wait(req, MPI_STATUS_IGNORE);
+  return true;
+}
+
+double comm_progress_engine::get_overlap_time() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_overlap_time;
+}
+
+double comm_progress_engine::get_wait_time() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_wait_time;
+}
+
+size_t comm_progress_engine::get_num_requests() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_num_requests;
+}
+
+void comm_progress_engine::reset_counters()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_overlap_time = 0.0;
+  m_wait_time = 0.0;
+  m_num_requests = 0;
+}
+
+auto comm_progress_engine::find(MPI_Request req)
+  -> std::vector<tracked_request>::iterator
+{
+  return std::find_if(m_requests.begin(),
+                      m_requests.end(),
+                      [req](const tracked_request& r) {
+                        return r.handle == req;
+                      });
+}
+
+void comm_progress_engine::retire(std::vector<tracked_request>::iterator it,
+                                  double wait_start)
+{
+  const double hidden_end = std::min(it->finish_time, wait_start);
+  m_overlap_time += std::max(hidden_end - it->start_time, 0.0);
+  m_wait_time += std::max(get_time() - wait_start, 0.0);
+  ++m_num_requests;
+  *it = m_requests.back();
+  m_requests.pop_back();
+}
+
+void comm_progress_engine::progress_loop(int pu_index)
+{
+  if (pu_index >= 0) {
+    bind_current_thread_to_pu(pu_index);
+  }
+  LBANN_TRACE_THREAD_NAME("comm progress");
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_work_cv.wait(lock, [this] { return m_stop || m_num_pending > 0; });
+    if (m_stop) {
+      break;
+    }
+
+    // Poll a snapshot of the pending handles without holding the
+    // mutex, so the main thread can register and retire requests
+    // while MPI progresses. MPI_Request_get_status does not free
+    // requests, so the handles remain valid until they are retired.
+    m_polled.clear();
+    for (const auto& r : m_requests) {
+      if (!r.done) {
+        m_polled.push_back(r.handle);
+      }
+    }
+    lock.unlock();
+    m_completed.clear();
+    for (const auto& handle : m_polled) {
+      int flag = 0;
+      MPI_Request_get_status(handle, &flag, MPI_STATUS_IGNORE);
+      if (flag) {
+        m_completed.push_back(handle);
+      }
+    }
+    const double finish_time = get_time();
+    if (m_completed.empty()) {
+      std::this_thread::yield();
+    }
+    lock.lock();
+
+    // Only completed requests are retired, so these are still tracked
+    for (const auto& handle : m_completed) {
+      auto it = find(handle);
+      it->done = true;
+      it->finish_time = finish_time;
+      --m_num_pending;
+      LBANN_TRACE_INSTANT("request_complete", comm);
+    }
+    if (!m_completed.empty()) {
+      m_done_cv.notify_all();
+    }
+  }
+}
+
+} // namespace lbann
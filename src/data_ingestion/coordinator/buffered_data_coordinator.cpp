@@ -246,6 +246,14 @@ uint64_t buffered_data_coordinator<TensorDataType>::get_current_mini_batch_size(
   return m_current_mini_batch_size.at(buffer_id).at(mode);
 }
 
+template <typename TensorDataType>
+uint64_t
+buffered_data_coordinator<TensorDataType>::get_effective_sequence_length(
+  execution_mode mode) const
+{
+  return get_active_buffer(mode).m_effective_sequence_length;
+}
+
 /// Check for each buffer if there is an outstanding fetch request
 template <typename TensorDataType>
 void buffered_data_coordinator<TensorDataType>::collect_background_data_fetch(
@@ -283,12 +291,20 @@ void buffered_data_coordinator<TensorDataType>::fetch_active_batch_synchronous(
     // without worrying about where the data reader is currently at.
     m_current_mini_batch_size[buffer_id][mode] = loaded_mini_batch_size;
     uint64_t relative_base_position = ds.get_position();
+    // Every rank holds the same shuffled indices, so the longest
+    // sample of the whole mini-batch is known without communication
+    const uint64_t mini_batch_begin =
+      relative_base_position - ds.get_base_offset();
+    active_buffer.m_effective_sequence_length =
+      get_data_reader(mode)->get_max_sample_length(
+        mini_batch_begin,
+        mini_batch_begin + loaded_mini_batch_size);
 
     // Start data store exchange if necessary (this should be moved
     // earlier as a future optimization)
     get_data_reader(mode)->start_data_store_mini_batch_exchange(
       // Use the relative position of the mini-batch (adjusted for rank)
-      relative_base_position - ds.get_base_offset(),
+      mini_batch_begin,
       loaded_mini_batch_size,
       ds.at_new_epoch());
     // Finish data store exchange before accessing samples
@@ -344,12 +360,20 @@ void buffered_data_coordinator<TensorDataType>::fetch_data_asynchronous(
     // without worrying about where the data reader is currently at.
     m_current_mini_batch_size[next_buffer_id][mode] = next_mini_batch_size;
     uint64_t relative_base_position = ds.get_next_position();
+    // Every rank holds the same shuffled indices, so the longest
+    // sample of the whole mini-batch is known without communication
+    const uint64_t mini_batch_begin =
+      relative_base_position - ds.get_base_offset();
+    next_buffer.m_effective_sequence_length =
+      get_data_reader(mode)->get_max_sample_length(
+        mini_batch_begin,
+        mini_batch_begin + next_mini_batch_size);
 
     // Start data store exchange if necessary (this should be moved
     // earlier as a future optimization)
     get_data_reader(mode)->start_data_store_mini_batch_exchange(
       // Use the relative position of the mini-batch (adjusted for rank)
-      relative_base_position - ds.get_base_offset(),
+      mini_batch_begin,
       next_mini_batch_size,
       ds.at_new_epoch());
     // Finish data store exchange before accessing samples
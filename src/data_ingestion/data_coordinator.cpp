@@ -115,6 +115,7 @@ void data_coordinator::setup(
   for (auto&& dr : m_data_readers) {
     if (!dr.second)
       continue;
+    dr.second->set_length_bucketing_mini_batch_size(max_mini_batch_size);
     dr.second->setup(m_io_thread_pool->get_num_threads(), m_io_thread_pool);
   }
 
@@ -559,6 +560,12 @@ data_coordinator::get_current_mini_batch_size(execution_mode mode) const
   return (dataset.initialized()) ? dataset.get_current_mini_batch_size() : 0;
 }
 
+uint64_t
+data_coordinator::get_effective_sequence_length(execution_mode mode) const
+{
+  return 0;
+}
+
 // save state of IO to a checkpoint
 bool data_coordinator::save_to_checkpoint_shared(persist& p) const
 {
@@ -31,6 +31,7 @@
 #include "lbann/comm_impl.hpp"
 #include "lbann/data_ingestion/data_coordinator.hpp"
 #include "lbann/data_ingestion/data_store_conduit.hpp"
+#include "lbann/data_ingestion/readers/utils/length_bucketing.hpp"
 #include "lbann/execution_algorithms/sgd_execution_context.hpp"
 #include "lbann/io/persist.hpp"
 #include "lbann/io/persist_impl.hpp"
@@ -38,6 +39,7 @@
 #include "lbann/utils/serialize.hpp"
 #include "lbann/utils/threads/thread_pool.hpp"
 #include "lbann/utils/timer.hpp"
+#include "lbann/utils/tracing.hpp"
 
 #include "conduit/conduit_node.hpp"
 
@@ -73,7 +75,32 @@ void generic_data_reader::shuffle_indices(rng_gen& gen)
   // Shuffle the data
   if (m_shuffle) {
     std::shuffle(m_shuffled_indices.begin(), m_shuffled_indices.end(), gen);
+    // Optionally group samples of similar length into mini-batches
+    if (m_length_bucketing_pool_size > 0 && !m_shuffled_indices.empty() &&
+        get_sample_length(m_shuffled_indices.front()) >= 0) {
+      bucket_indices_by_length(
+        m_shuffled_indices,
+        [this](uint64_t data_id) { return get_sample_length(data_id); },
+        m_length_bucketing_mini_batch_size,
+        m_length_bucketing_pool_size,
+        gen);
+    }
+  }
+}
+
+uint64_t generic_data_reader::get_max_sample_length(uint64_t begin,
+                                                    uint64_t end) const
+{
+  end = std::min(end, static_cast<uint64_t>(m_shuffled_indices.size()));
+  int max_length = 0;
+  for (uint64_t i = begin; i < end; ++i) {
+    const int length = get_sample_length(m_shuffled_indices[i]);
+    if (length < 0) {
+      return 0;
+    }
+    max_length = std::max(max_length, length);
   }
+  return static_cast<uint64_t>(max_length);
 }
 
 void generic_data_reader::setup(int num_io_threads,
@@ -333,6 +360,7 @@ bool lbann::generic_data_reader::fetch_data_block(
   El::Matrix<El::Int>& indices_fetched,
   execution_mode mode)
 {
+  LBANN_TRACE_SCOPE("fetch_data_block", io);
   for (uint64_t s = block_offset; s < mb_size; s += block_stride) {
     locked_io_rng_ref io_rng = set_io_generators_local_index(s, mode);
     int n = current_position_in_data_set + (s * sample_stride);
@@ -415,6 +443,7 @@ bool lbann::generic_data_reader::fetch_data_block_conduit(
   El::Matrix<El::Int>& indices_fetched,
   execution_mode mode)
 {
+  LBANN_TRACE_SCOPE("fetch_data_block_conduit", io);
   if (mb_size > samples.size()) {
     LBANN_ERROR("unable to fetch data to conduit nodes, vector length ",
                 samples.size(),
@@ -41,6 +41,7 @@
 #include "lbann/utils/options.hpp"
 #include "lbann/utils/serialize.hpp"
 #include "lbann/utils/timer.hpp"
+#include "lbann/utils/tracing.hpp"
 #include <errno.h>
 #include <fcntl.h>
 #include <stdarg.h>
@@ -51,9 +52,68 @@
 #include <unordered_set>
 
 #include <cstdlib>
+#include <sstream>
 
 namespace lbann {
 
+sample_field_accessor::sample_field_accessor(const std::string& field_path)
+  : m_field_path(field_path)
+{
+  std::istringstream iss(field_path);
+  std::string component;
+  while (std::getline(iss, component, '/')) {
+    if (!component.empty()) {
+      m_path.push_back(component);
+    }
+  }
+  if (m_path.empty()) {
+    LBANN_ERROR("empty field path for sample accessor: \"", field_path, "\"");
+  }
+}
+
+const conduit::Node&
+sample_field_accessor::get_node(const conduit::Node& sample) const
+{
+  if (sample.number_of_children() != 1) {
+    LBANN_ERROR("expected a single sample in conduit node, found ",
+                sample.number_of_children(),
+                " children; field: ",
+                m_field_path);
+  }
+  const conduit::Node* node = &sample.child(0);
+  for (const auto& name : m_path) {
+    const auto& child_names = node->schema().child_names();
+    const conduit::Node* next = nullptr;
+    for (size_t j = 0; j < child_names.size(); ++j) {
+      if (child_names[j] == name) {
+        next = &node->child(static_cast<conduit::index_t>(j));
+        break;
+      }
+    }
+    if (next == nullptr) {
+      LBANN_ERROR("conduit node for sample ",
+                  sample.child(0).name(),
+                  " has no field ",
+                  m_field_path);
+    }
+    node = next;
+  }
+  return *node;
+}
+
+sample_field_view
+sample_field_accessor::get_view(const conduit::Node& sample) const
+{
+  const conduit::Node& node = get_node(sample);
+  sample_field_view view;
+  view.dtype_id = node.dtype().id();
+  view.count = static_cast<size_t>(node.dtype().number_of_elements());
+  if (view.count > 0) {
+    view.data = node.element_ptr(0);
+  }
+  return view;
+}
+
 data_store_conduit::data_store_conduit(generic_data_reader* reader)
   : m_reader(reader)
 {
@@ -556,6 +616,7 @@ void data_store_conduit::build_node_for_sending(const conduit::Node& node_in,
 void data_store_conduit::start_exchange_data_by_sample(uint64_t current_pos,
                                                        uint64_t mb_size)
 {
+  LBANN_TRACE_SCOPE("start_exchange_data_by_sample", data_store);
   if (!m_is_setup) {
     LBANN_ERROR("setup(mb_size) has not been called");
   }
@@ -719,6 +780,7 @@ void data_store_conduit::start_exchange_data_by_sample(uint64_t current_pos,
 
 void data_store_conduit::finish_exchange_data_by_sample()
 {
+  LBANN_TRACE_SCOPE("finish_exchange_data_by_sample", data_store);
   // wait for all msgs to complete
   double tm5 = get_time();
   m_comm->wait_all(m_send_requests);
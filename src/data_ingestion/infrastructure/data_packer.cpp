@@ -26,11 +26,11 @@
 
 #include "lbann/data_ingestion/infrastructure/data_packer.hpp"
 
+#include "lbann/data_ingestion/data_store_conduit.hpp"
 #include "lbann/utils/exception.hpp"
 
 #include <conduit/conduit_data_type.hpp>
 #include <conduit/conduit_node.hpp>
-#include <conduit/conduit_utils.hpp>
 
 /* The data_packer class is designed to extract data fields from
  * Conduit nodes and pack them into Hydrogen matrices.
@@ -42,13 +42,14 @@ void lbann::data_packer::extract_data_fields_from_samples(
   auto const num_samples = samples.size();
   for (auto const& [data_field, X] : input_buffers) {
     LBANN_ASSERT_DEBUG(num_samples <= static_cast<size_t>(X->Width()));
+    sample_field_accessor const field(data_field);
     for (size_t mb_idx = 0UL; mb_idx < num_samples; ++mb_idx) {
       // This call will verify that the extracted sample has the
       // expected size. In particular, the extracted sample's
       // linearized size must equal the height of the input matrix
       // X. The assertion above verifies that the matrix X has
       // sufficient width to accommodate the sample.
-      extract_data_field_from_sample(data_field, samples[mb_idx], *X, mb_idx);
+      extract_data_field_from_sample(field, samples[mb_idx], *X, mb_idx);
     }
   }
 }
@@ -67,26 +68,33 @@ size_t lbann::data_packer::extract_data_field_from_sample(
   CPUMat& X,
   size_t const mb_idx)
 {
-  std::string const data_id = sample.child(0).name();
-  auto const sample_path = conduit::utils::join_path(data_id, data_field);
+  return extract_data_field_from_sample(sample_field_accessor(data_field),
+                                        sample,
+                                        X,
+                                        mb_idx);
+}
 
-  // Check to make sure that each Conduit node only has a single
-  // sample
-  if (sample.number_of_children() != 1)
-    LBANN_ERROR("Unsupported number of samples per Conduit node");
-  if (!sample.has_path(sample_path))
-    LBANN_ERROR("Conduit node has no such path: ", sample_path);
+size_t lbann::data_packer::extract_data_field_from_sample(
+  sample_field_accessor const& field,
+  conduit::Node const& sample,
+  CPUMat& X,
+  size_t const mb_idx)
+{
+  // The accessor checks that each Conduit node only has a single
+  // sample and that the field exists
+  conduit::Node const& data_field_node = field.get_node(sample);
 #ifdef LBANN_DEBUG
   if (!sample.is_compact())
-    LBANN_WARNING("sample[", data_id, "] does not have a compact layout");
+    LBANN_WARNING("sample[",
+                  sample.child(0).name(),
+                  "] does not have a compact layout");
 #endif
 
-  conduit::Node const& data_field_node = sample[sample_path];
   size_t const n_elts = data_field_node.dtype().number_of_elements();
   if (n_elts != static_cast<size_t>(X.Height())) {
     LBANN_ERROR(
       "data field ",
-      data_field,
+      field.get_field_path(),
       " has ",
       n_elts,
       " elements, but the matrix only has a linearized size (height) of ",
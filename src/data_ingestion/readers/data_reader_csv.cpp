@@ -24,17 +24,115 @@
 // permissions and limitations under the license.
 //
 // lbann_data_reader_csv .hpp .cpp - generic_data_reader class for CSV files
-////////////////////////////////////////////////////////////////////////////////
 
 #include "lbann/data_ingestion/readers/data_reader_csv.hpp"
 #include "lbann/comm_impl.hpp"
+#include "lbann/utils/exception.hpp"
+#include "lbann/utils/from_string.hpp"
 #include "lbann/utils/options.hpp"
 #include "lbann/utils/threads/thread_pool.hpp"
 
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
 #include <unordered_set>
 
 namespace lbann {
 
+namespace {
+
+/** Identifies sidecar index files ("LBCSVIDX"). */
+constexpr uint64_t index_file_magic = 0x5844495653434c42ull;
+/** Identifies binary cache files ("LBCSVBIN"). */
+constexpr uint64_t cache_file_magic = 0x4e49425653434c42ull;
+/** Version of the sidecar index and binary cache formats. */
+constexpr uint64_t file_format_version = 1;
+/** Number of header entries in a sidecar index file. */
+constexpr size_t index_header_size = 9;
+/** Alignment of the arrays in a binary cache. */
+constexpr size_t cache_alignment = 64;
+
+/** Where ranks other than the master get the line index from. */
+enum index_source : int
+{
+  broadcast_index = 0,
+  sidecar_index = 1,
+  binary_cache = 2
+};
+
+size_t align_up(size_t n)
+{
+  return (n + cache_alignment - 1) / cache_alignment * cache_alignment;
+}
+
+/** Byte offsets of the arrays in a binary cache.
+ *
+ *  The cache consists of a header of 64-bit entries (the cache key
+ *  followed by the number of columns, samples and values per sample),
+ *  the line offsets, the labels, the responses and the row-major data
+ *  values.
+ */
+struct cache_layout
+{
+  size_t offsets;
+  size_t labels;
+  size_t responses;
+  size_t values;
+  size_t size;
+};
+
+cache_layout get_cache_layout(size_t header_size,
+                              uint64_t num_samples,
+                              uint64_t row_width,
+                              bool has_labels,
+                              bool has_responses)
+{
+  cache_layout layout;
+  layout.offsets = header_size * sizeof(uint64_t);
+  layout.labels =
+    align_up(layout.offsets + (num_samples + 1) * sizeof(uint64_t));
+  layout.responses =
+    align_up(layout.labels + (has_labels ? num_samples * sizeof(int) : 0));
+  layout.values = align_up(layout.responses + (has_responses
+                                                 ? num_samples * sizeof(DataType)
+                                                 : 0));
+  layout.size = layout.values + num_samples * row_width * sizeof(DataType);
+  return layout;
+}
+
+/** Write a file under a temporary name and move it into place, so that
+ *  readers never see a partially written file. */
+bool write_file_atomically(const std::string& path,
+                           const std::function<bool(std::ofstream&)>& write)
+{
+  const std::string tmp_path = path + ".tmp." + std::to_string(::getpid());
+  bool success;
+  {
+    std::ofstream ofs(tmp_path,
+                      std::ios::out | std::ios::binary | std::ios::trunc);
+    success = ofs.good() && write(ofs) && ofs.flush().good();
+  }
+  if (success) {
+    success = std::rename(tmp_path.c_str(), path.c_str()) == 0;
+  }
+  if (!success) {
+    std::remove(tmp_path.c_str());
+  }
+  return success;
+}
+
+/** Strip the newline at the end of a line. */
+std::string_view strip_newline(const char* begin, const char* end)
+{
+  if (end != begin && end[-1] == '\n') {
+    --end;
+  }
+  return std::string_view(begin, end - begin);
+}
+
+} // namespace
+
 csv_reader::csv_reader(bool shuffle) : generic_data_reader(shuffle)
 {
   // By default assume that there are labels in the CSV data set
@@ -56,18 +154,21 @@ csv_reader::csv_reader(const csv_reader& other)
     m_num_cols(other.m_num_cols),
     m_num_samples(other.m_num_samples),
     m_num_labels(other.m_num_labels),
+    m_persistent_index(other.m_persistent_index),
+    m_binary_cache(other.m_binary_cache),
+    m_data_file(other.m_data_file),
+    m_index_file(other.m_index_file),
+    m_cache_file(other.m_cache_file),
+    m_cache_offsets_offset(other.m_cache_offsets_offset),
+    m_cache_values_offset(other.m_cache_values_offset),
+    m_cache_row_width(other.m_cache_row_width),
     m_index(other.m_index),
     m_labels(other.m_labels),
     m_responses(other.m_responses),
     m_col_transforms(other.m_col_transforms),
     m_label_transform(other.m_label_transform),
     m_response_transform(other.m_response_transform)
-{
-  if (!other.m_ifstreams.empty()) {
-    // Need to set these up again manually.
-    setup_ifstreams();
-  }
-}
+{}
 
 csv_reader& csv_reader::operator=(const csv_reader& other)
 {
@@ -83,194 +184,213 @@ csv_reader& csv_reader::operator=(const csv_reader& other)
   m_num_cols = other.m_num_cols;
   m_num_samples = other.m_num_samples;
   m_num_labels = other.m_num_labels;
+  m_persistent_index = other.m_persistent_index;
+  m_binary_cache = other.m_binary_cache;
+  m_data_file = other.m_data_file;
+  m_index_file = other.m_index_file;
+  m_cache_file = other.m_cache_file;
+  m_cache_offsets_offset = other.m_cache_offsets_offset;
+  m_cache_values_offset = other.m_cache_values_offset;
+  m_cache_row_width = other.m_cache_row_width;
   m_index = other.m_index;
   m_labels = other.m_labels;
   m_responses = other.m_responses;
   m_col_transforms = other.m_col_transforms;
   m_label_transform = other.m_label_transform;
   m_response_transform = other.m_response_transform;
-  if (!other.m_ifstreams.empty()) {
-    // Possibly free our current ifstreams, set them up again.
-    for (std::ifstream* ifs : m_ifstreams) {
-      delete ifs;
-    }
-    setup_ifstreams();
-  }
   return *this;
 }
 
-csv_reader::~csv_reader()
-{
-  for (auto&& ifs : m_ifstreams) {
-    delete ifs;
-  }
-}
+csv_reader::~csv_reader() = default;
 
 void csv_reader::load()
 {
   bool master = m_comm->am_world_master();
-  setup_ifstreams();
-  std::ifstream& ifs = *m_ifstreams[0];
   const El::mpi::Comm& world_comm = m_comm->get_world_comm();
-  // Parse the header to determine how many columns there are.
-  // Skip rows if needed.
-  if (master) {
-    skip_rows(ifs, m_skip_rows);
-  }
-  m_comm->broadcast<int>(0, m_skip_rows, world_comm);
+  const std::string path = get_file_dir() + get_data_filename();
+  const std::string index_path = path + ".lbidx";
+  const std::string cache_path = path + ".lbcache";
 
-  // This will be broadcast from root to other procs, and will
-  // then be converted to std::vector<int> m_labels; this is because
-  // El::mpi::Broadcast<std::streampos> doesn't work
-  std::vector<long long> index;
+  // The file is mapped by every rank; pages are shared within a node.
+  m_data_file = std::make_shared<const file::mapped_file>(path);
+  m_index_file.reset();
+  m_cache_file.reset();
+  m_index.clear();
+  m_labels.clear();
+  m_responses.clear();
+
+  int num_samples_to_use = get_absolute_sample_count();
+  if (num_samples_to_use == 0) {
+    num_samples_to_use = -1;
+  }
+  file::file_stamp stamp;
+  std::vector<uint64_t> cache_key;
+  if (m_persistent_index || m_binary_cache) {
+    stamp = file::get_file_stamp(path);
+    cache_key = get_binary_cache_key(stamp, num_samples_to_use);
+  }
 
+  int source = broadcast_index;
   if (master) {
-    std::string line;
-    std::streampos header_start = ifs.tellg();
-    // TODO: Skip comment lines.
-    if (std::getline(ifs, line)) {
-      m_num_cols = std::count(line.begin(), line.end(), m_separator) + 1;
-      if (m_skip_cols >= m_num_cols) {
-        throw lbann_exception(
-          "csv_reader: asked to skip more columns than are present");
+    if (m_binary_cache && open_binary_cache(cache_path, cache_key)) {
+      source = binary_cache;
+    }
+    else {
+      if (m_persistent_index && open_index_file(index_path, stamp)) {
+        source = sidecar_index;
+      }
+      else {
+        // A persistent index covers the whole file so that it can be
+        // reused with a different sample count.
+        build_index(m_persistent_index ? -1 : num_samples_to_use);
+        if (m_persistent_index) {
+          if (write_index_file(index_path, stamp)) {
+            source = sidecar_index;
+          }
+          else {
+            LBANN_WARNING("csv_reader: could not write line index to ",
+                          index_path);
+          }
+        }
+      }
+      m_num_samples = get_num_indexed_lines();
+      if (num_samples_to_use >= 0 && m_num_samples > num_samples_to_use) {
+        m_num_samples = num_samples_to_use;
       }
 
+      if (m_skip_cols >= m_num_cols) {
+        LBANN_ERROR("csv_reader: asked to skip more columns than are present");
+      }
       if (!m_disable_labels) {
         if (m_label_col < 0) {
           // Last column becomes the label column.
           m_label_col = m_num_cols - 1;
         }
         if (m_label_col >= m_num_cols) {
-          throw lbann_exception("csv_reader: label column" +
-                                std::to_string(m_label_col) +
-                                " is not present");
+          LBANN_ERROR("csv_reader: label column ",
+                      m_label_col,
+                      " is not present");
         }
       }
-
       if (!m_disable_responses) {
         if (m_response_col < 0) {
           // Last column becomes the response column.
           m_response_col = m_num_cols - 1;
         }
         if (m_response_col >= m_num_cols) {
-          throw lbann_exception("csv_reader: response column" +
-                                std::to_string(m_response_col) +
-                                " is not present");
+          LBANN_ERROR("csv_reader: response column ",
+                      m_response_col,
+                      " is not present");
         }
       }
-    }
-    else {
-      throw lbann_exception("csv_reader: failed to read header in " +
-                            get_data_filename());
-    }
-    if (ifs.eof()) {
-      throw lbann_exception("csv_reader: reached EOF after reading header");
-    }
-    // If there was no header, skip back to the beginning.
-    if (!m_has_header) {
-      ifs.clear();
-      ifs.seekg(header_start, std::ios::beg);
-    }
-    // Construct an index mapping each line (sample) to its offset.
-    // TODO: Skip comment lines.
-    // Used to count the number of label classes.
-    std::unordered_set<int> label_classes;
-    index.push_back(ifs.tellg());
-
-    int num_samples_to_use = get_absolute_sample_count();
-    int line_num = 0;
-    if (num_samples_to_use == 0) {
-      num_samples_to_use = -1;
-    }
-    while (std::getline(ifs, line)) {
-      if (line_num == num_samples_to_use) {
-        break;
-      }
-      ++line_num;
 
-      // Verify the line has the right number of columns.
-      if (std::count(line.begin(), line.end(), m_separator) + 1 != m_num_cols) {
-        throw lbann_exception("csv_reader: line " + std::to_string(line_num) +
-                              " does not have right number of entries");
-      }
-      index.push_back(ifs.tellg());
-      // Extract the label.
-      if (!m_disable_labels) {
-        size_t cur_pos = 0;
-        for (int col = 0; col < m_num_cols; ++col) {
-          size_t end_pos = line.find_first_of(m_separator, cur_pos);
-          if (col == m_label_col) {
-            int label =
-              m_label_transform(line.substr(cur_pos, end_pos - cur_pos));
-            label_classes.insert(label);
-            m_labels.push_back(label);
-            break;
-          }
-          cur_pos = end_pos + 1;
+      // Extract labels and responses.
+      // Used to count the number of label classes.
+      std::unordered_set<int> label_classes;
+      for (int i = 0; i < m_num_samples; ++i) {
+        const std::string_view line = fetch_raw_line(i);
+        if (!m_disable_labels) {
+          const int label = parse_label(line);
+          label_classes.insert(label);
+          m_labels.push_back(label);
         }
-      }
-      // Possibly extract the response.
-      if (!m_disable_responses) {
-        size_t cur_pos = 0;
-        for (int col = 0; col < m_num_cols; ++col) {
-          size_t end_pos = line.find_first_of(m_separator, cur_pos);
-          if (col == m_response_col) {
-            DataType response =
-              m_response_transform(line.substr(cur_pos, end_pos - cur_pos));
-            m_responses.push_back(response);
-            break;
-          }
-          cur_pos = end_pos + 1;
+        if (!m_disable_responses) {
+          m_responses.push_back(parse_response(line));
         }
       }
-    }
-
-    if (!ifs.eof() && num_samples_to_use == 0) {
-      // If we didn't get to EOF, something went wrong.
-      throw lbann_exception("csv_reader: did not reach EOF");
-    }
-    if (!m_disable_labels) {
-      // Do some simple validation checks on the classes.
-      // Ensure the elements begin with 0, and there are no gaps.
-      auto minmax =
-        std::minmax_element(label_classes.begin(), label_classes.end());
-      if (*minmax.first != 0) {
-        throw lbann_exception("csv_reader: classes are not indexed from 0");
-      }
-      if (*minmax.second != (int)label_classes.size() - 1) {
-        throw lbann_exception("csv_reader: label classes are not contiguous");
+      if (!m_disable_labels && !label_classes.empty()) {
+        // Do some simple validation checks on the classes.
+        // Ensure the elements begin with 0, and there are no gaps.
+        auto minmax =
+          std::minmax_element(label_classes.begin(), label_classes.end());
+        if (*minmax.first != 0) {
+          LBANN_ERROR("csv_reader: classes are not indexed from 0");
+        }
+        if (*minmax.second != (int)label_classes.size() - 1) {
+          LBANN_ERROR("csv_reader: label classes are not contiguous");
+        }
+        m_num_labels = label_classes.size();
       }
-      m_num_labels = label_classes.size();
     }
-    ifs.clear();
   } // if (master)
 
+  m_comm->broadcast<int>(0, source, world_comm);
   m_comm->broadcast<int>(0, m_num_cols, world_comm);
+  m_comm->broadcast<int>(0, m_num_samples, world_comm);
   m_label_col = m_num_cols - 1;
 
-  // bcast the index vector
-  m_comm->world_broadcast<long long>(0, index);
-  m_num_samples = index.size() - 1;
+  // Get the line index. The master's sidecar files may not be
+  // visible on every rank (e.g. node-local storage or delayed
+  // visibility), in which case the index is broadcast instead.
+  bool broadcast = (source == broadcast_index);
+  if (!broadcast) {
+    int opened = 1;
+    if (!master) {
+      opened = (source == binary_cache)
+                 ? open_binary_cache(cache_path, cache_key)
+                 : open_index_file(index_path, stamp);
+    }
+    opened = m_comm->allreduce(opened, world_comm, El::mpi::MIN);
+    if (!opened) {
+      if (master) {
+        LBANN_WARNING("csv_reader: ",
+                      (source == binary_cache ? cache_path : index_path),
+                      " is not visible on every rank, "
+                      "broadcasting the line index instead");
+      }
+      broadcast = true;
+    }
+  }
+  if (broadcast) {
+    // El::mpi::Broadcast does not support uint64_t.
+    std::vector<long long> index;
+    if (master) {
+      const uint64_t* offsets = get_line_offsets();
+      index.assign(offsets, offsets + m_num_samples + 1);
+    }
+    m_comm->world_broadcast<long long>(0, index);
+    // Ranks that mapped the master's files keep using them.
+    if (m_cache_file == nullptr && m_index_file == nullptr) {
+      m_index.assign(index.begin(), index.end());
+    }
+  }
   if (get_comm()->am_world_master())
     std::cerr << "num samples: " << m_num_samples << "\n";
 
-  m_index.reserve(index.size());
-  for (auto t : index) {
-    m_index.push_back(t);
-  }
-
   // optionally bcast the response vector
   if (!m_disable_responses) {
     m_response_col = m_num_cols - 1;
-    m_comm->world_broadcast<DataType>(0, m_responses);
+    if (source != binary_cache || broadcast) {
+      m_comm->world_broadcast<DataType>(0, m_responses);
+    }
   }
 
   // optionally bcast the label vector
   if (!m_disable_labels) {
-    m_comm->world_broadcast<int>(0, m_labels);
+    if (source != binary_cache || broadcast) {
+      m_comm->world_broadcast<int>(0, m_labels);
+    }
     m_num_labels = m_labels.size();
   }
 
+  // Convert the file to a binary cache for subsequent runs.
+  if (m_binary_cache && source != binary_cache) {
+    int cached = 0;
+    if (master) {
+      cached = write_binary_cache(cache_path, cache_key);
+      if (!cached) {
+        LBANN_WARNING("csv_reader: could not write binary cache to ",
+                      cache_path);
+      }
+    }
+    m_comm->broadcast<int>(0, cached, world_comm);
+    // Ranks that cannot see the new cache keep parsing the text file
+    // with the broadcast index.
+    if (cached) {
+      open_binary_cache(cache_path, cache_key);
+    }
+  }
+
   // Reset indices.
   m_shuffled_indices.resize(m_num_samples);
   std::iota(m_shuffled_indices.begin(), m_shuffled_indices.end(), 0);
@@ -282,15 +402,21 @@ void csv_reader::setup(int num_io_threads,
                        observer_ptr<thread_pool> io_thread_pool)
 {
   generic_data_reader::setup(num_io_threads, io_thread_pool);
-  setup_ifstreams();
 }
 
 bool csv_reader::fetch_datum(CPUMat& X, uint64_t data_id, uint64_t mb_idx)
 {
-  auto line = fetch_line_label_response(data_id);
-  // TODO: Avoid unneeded copies.
-  for (size_t i = 0; i < line.size(); ++i) {
-    X(i, mb_idx) = line[i];
+  // Parse directly into the minibatch column.
+  DataType* buf = X.Buffer(0, mb_idx);
+  const size_t height = X.Height();
+  if (m_cache_file != nullptr) {
+    const DataType* values = reinterpret_cast<const DataType*>(
+                               m_cache_file->data() + m_cache_values_offset) +
+                             data_id * m_cache_row_width;
+    std::copy(values, values + std::min(m_cache_row_width, height), buf);
+  }
+  else {
+    parse_line(fetch_raw_line(data_id), buf, height, true);
   }
   return true;
 }
@@ -309,123 +435,363 @@ bool csv_reader::fetch_response(CPUMat& Y, uint64_t data_id, uint64_t mb_idx)
 
 std::vector<DataType> csv_reader::fetch_line(uint64_t data_id)
 {
-  std::string line = fetch_raw_line(data_id);
-  std::vector<DataType> parsed_line;
-  // Note: load already verified that every line is properly formatted.
-  size_t cur_pos = 0; // Current *start* of a column.
-  for (int col = 0; col < m_num_cols; ++col) {
-    // Note for last column, this returns std::npos, which substr handles.
-    size_t end_pos = line.find_first_of(m_separator, cur_pos);
-    // Skip columns if needed.
-    if (col < m_skip_cols) {
-      cur_pos = end_pos + 1;
-      continue;
-    }
-    // @TODO Note: This results in a copy, switch to string_view when we can.
-    std::string str_val = line.substr(cur_pos, end_pos - cur_pos);
-    cur_pos = end_pos + 1;
-    DataType val;
-    if (m_col_transforms.count(col)) {
-      val = m_col_transforms[col](str_val);
-    }
-    else {
-      // No easy way to parameterize based on DataType, so always use double.
-      val = std::stod(str_val);
-    }
-    parsed_line.push_back(val);
-  }
+  std::vector<DataType> parsed_line(m_num_cols);
+  parsed_line.resize(parse_line(fetch_raw_line(data_id),
+                                parsed_line.data(),
+                                parsed_line.size(),
+                                false));
   return parsed_line;
 }
 
 std::vector<DataType> csv_reader::fetch_line_label_response(uint64_t data_id)
 {
-  std::string line = fetch_raw_line(data_id);
-  std::vector<DataType> parsed_line;
+  if (m_cache_file != nullptr) {
+    const DataType* values = reinterpret_cast<const DataType*>(
+                               m_cache_file->data() + m_cache_values_offset) +
+                             data_id * m_cache_row_width;
+    return std::vector<DataType>(values, values + m_cache_row_width);
+  }
+  std::vector<DataType> parsed_line(m_num_cols);
+  parsed_line.resize(parse_line(fetch_raw_line(data_id),
+                                parsed_line.data(),
+                                parsed_line.size(),
+                                true));
+  return parsed_line;
+}
+
+std::string_view csv_reader::fetch_raw_line(uint64_t data_id) const
+{
+  const uint64_t* offsets = get_line_offsets();
+  const char* data = m_data_file->data();
+  return strip_newline(data + offsets[data_id], data + offsets[data_id + 1]);
+}
+
+size_t csv_reader::parse_line(std::string_view line,
+                              DataType* out,
+                              size_t capacity,
+                              bool skip_label_response) const
+{
   // Note: load already verified that every line is properly formatted.
-  size_t cur_pos = 0; // Current *start* of a column.
-  for (int col = 0; col < m_num_cols; ++col) {
-    // Note for last column, this returns std::npos, which substr handles.
-    size_t end_pos = line.find_first_of(m_separator, cur_pos);
+  const char* pos = line.data(); // Current *start* of a column.
+  const char* const end = pos + line.size();
+  size_t num_values = 0;
+  for (int col = 0; col < m_num_cols && num_values < capacity; ++col) {
+    const void* sep = std::memchr(pos, m_separator, end - pos);
+    const char* col_end = sep != nullptr ? static_cast<const char*>(sep) : end;
     // Skip the label, response, and any columns if needed.
-    if ((!m_disable_labels && col == m_label_col) ||
-        (!m_disable_responses && col == m_response_col) || col < m_skip_cols) {
-      cur_pos = end_pos + 1;
-      continue;
-    }
-    // Note: This results in a copy, switch to string_view when we can.
-    std::string str_val = line.substr(cur_pos, end_pos - cur_pos);
-    cur_pos = end_pos + 1;
-    DataType val;
-    if (m_col_transforms.count(col)) {
-      val = m_col_transforms[col](str_val);
-    }
-    else {
-      // No easy way to parameterize based on DataType, so always use double.
-      try {
-        val = std::stod(str_val);
+    const bool skip =
+      col < m_skip_cols ||
+      (skip_label_response && ((!m_disable_labels && col == m_label_col) ||
+                               (!m_disable_responses && col == m_response_col)));
+    if (!skip) {
+      auto transform = m_col_transforms.empty() ? m_col_transforms.end()
+                                                : m_col_transforms.find(col);
+      if (transform != m_col_transforms.end()) {
+        out[num_values] = transform->second(std::string(pos, col_end));
       }
-      catch (std::invalid_argument& e) {
-        throw lbann_exception("csv_reader: could not convert '" + str_val +
-                              "'");
+      else {
+        // No easy way to parameterize based on DataType, so always use double.
+        double val;
+        if (utils::parse_double(pos, col_end, val) == pos) {
+          LBANN_ERROR("csv_reader: could not convert '",
+                      std::string(pos, col_end),
+                      "'");
+        }
+        out[num_values] = val;
       }
+      ++num_values;
     }
-    parsed_line.push_back(val);
+    pos = (col_end == end) ? end : col_end + 1;
   }
-  return parsed_line;
+  return num_values;
 }
 
-std::string csv_reader::fetch_raw_line(uint64_t data_id)
+std::string_view csv_reader::get_column(std::string_view line, int col) const
 {
-  static int n = 0;
-  std::ifstream& ifs = *m_ifstreams[m_io_thread_pool->get_local_thread_id()];
-  // Seek to the start of this datum's line.
-  ifs.seekg(m_index[data_id], std::ios::beg);
-  // Compute the length of the line to read, excluding newline.
-  std::streamsize cnt = m_index[data_id + 1] - m_index[data_id] - 1;
-  // Read directly into a string buffer.
-  std::string line;
-  line.resize(cnt);
-  if (!ifs.read(&line[0], cnt)) {
-    std::stringstream err;
-    err << __FILE__ << " " << __LINE__ << " :: "
-        << "csv_reader: error on reading data_id: " << data_id << "\n"
-        << "index.size(): " << m_index.size() << "  m_index[" << data_id
-        << ")=" << m_index[data_id] << "; index[" << data_id + 1
-        << ")= " << m_index[data_id + 1] << "\ncnt: " << cnt
-        << " role: " << get_role() << " gcount: " << ifs.gcount()
-        << " n: " << n;
-    throw lbann_exception(err.str());
-  }
-  ++n;
-  return line;
+  size_t cur_pos = 0;
+  for (int i = 0; i < col; ++i) {
+    const size_t end_pos = line.find(m_separator, cur_pos);
+    if (end_pos == std::string_view::npos) {
+      return std::string_view();
+    }
+    cur_pos = end_pos + 1;
+  }
+  return line.substr(cur_pos, line.find(m_separator, cur_pos) - cur_pos);
 }
 
-void csv_reader::skip_rows(std::ifstream& s, int rows)
+int csv_reader::parse_label(std::string_view line) const
 {
-  std::string unused; // Unused buffer for extracting lines.
-  for (int i = 0; i < rows; ++i) {
-    if (!std::getline(s, unused)) {
-      throw lbann_exception("csv_reader: error on skipping rows");
+  const std::string_view str_val = get_column(line, m_label_col);
+  if (m_label_transform) {
+    return m_label_transform(std::string(str_val));
+  }
+  double val;
+  const char* first = str_val.data();
+  if (utils::parse_double(first, first + str_val.size(), val) == first) {
+    LBANN_ERROR("csv_reader: could not convert label '", str_val, "'");
+  }
+  return static_cast<int>(val);
+}
+
+DataType csv_reader::parse_response(std::string_view line) const
+{
+  const std::string_view str_val = get_column(line, m_response_col);
+  if (m_response_transform) {
+    return m_response_transform(std::string(str_val));
+  }
+  double val;
+  const char* first = str_val.data();
+  if (utils::parse_double(first, first + str_val.size(), val) == first) {
+    LBANN_ERROR("csv_reader: could not convert response '", str_val, "'");
+  }
+  return val;
+}
+
+void csv_reader::build_index(int max_rows)
+{
+  const char* const begin = m_data_file->data();
+  const char* const end = begin + m_data_file->size();
+  // Start of the line following the one starting at p.
+  auto next_line = [end](const char* p) {
+    const void* newline = std::memchr(p, '\n', end - p);
+    return newline != nullptr ? static_cast<const char*>(newline) + 1 : end;
+  };
+
+  // Skip rows if needed.
+  const char* pos = begin;
+  for (int i = 0; i < m_skip_rows; ++i) {
+    if (pos == end) {
+      LBANN_ERROR("csv_reader: error on skipping rows");
     }
+    pos = next_line(pos);
+  }
+
+  // Parse the header to determine how many columns there are.
+  // TODO: Skip comment lines.
+  if (pos == end) {
+    LBANN_ERROR("csv_reader: failed to read header in ", get_data_filename());
+  }
+  const char* header_end = next_line(pos);
+  const std::string_view header = strip_newline(pos, header_end);
+  m_num_cols = std::count(header.begin(), header.end(), m_separator) + 1;
+  if (header_end == end && end[-1] != '\n') {
+    LBANN_ERROR("csv_reader: reached EOF after reading header");
+  }
+  // If there was no header, the first line is a sample.
+  if (m_has_header) {
+    pos = header_end;
+  }
+
+  // Construct an index mapping each line (sample) to its offset.
+  m_index.clear();
+  m_index.push_back(pos - begin);
+  int line_num = 0;
+  while (pos != end && line_num != max_rows) {
+    const char* line_end = next_line(pos);
+    ++line_num;
+    // Verify the line has the right number of columns.
+    const std::string_view line = strip_newline(pos, line_end);
+    if (std::count(line.begin(), line.end(), m_separator) + 1 != m_num_cols) {
+      LBANN_ERROR("csv_reader: line ",
+                  line_num,
+                  " does not have right number of entries");
+    }
+    m_index.push_back(line_end - begin);
+    pos = line_end;
   }
 }
 
-void csv_reader::setup_ifstreams()
+bool csv_reader::open_index_file(const std::string& path,
+                                 const file::file_stamp& stamp)
 {
-  if (m_io_thread_pool != nullptr) {
-    m_ifstreams.resize(m_io_thread_pool->get_num_threads());
+  if (!file::file_exists(path)) {
+    return false;
   }
-  else {
-    m_ifstreams.resize(1);
-  }
-  for (size_t i = 0; i < m_ifstreams.size(); ++i) {
-    m_ifstreams[i] = new std::ifstream(get_file_dir() + get_data_filename(),
-                                       std::ios::in | std::ios::binary);
-    if (m_ifstreams[i]->fail()) {
-      throw lbann_exception("csv_reader: failed to open " + get_file_dir() +
-                            get_data_filename());
+  auto index_file = std::make_shared<const file::mapped_file>(path);
+  if (index_file->size() < (index_header_size + 1) * sizeof(uint64_t)) {
+    return false;
+  }
+  const uint64_t* header = reinterpret_cast<const uint64_t*>(index_file->data());
+  const uint64_t expected[] = {index_file_magic,
+                               file_format_version,
+                               stamp.size,
+                               stamp.mtime_ns,
+                               static_cast<uint64_t>(m_separator),
+                               static_cast<uint64_t>(m_skip_rows),
+                               static_cast<uint64_t>(m_has_header)};
+  if (!std::equal(std::begin(expected), std::end(expected), header)) {
+    return false;
+  }
+  const uint64_t num_lines = header[8];
+  if (index_file->size() !=
+      (index_header_size + num_lines + 1) * sizeof(uint64_t)) {
+    return false;
+  }
+  m_num_cols = header[7];
+  m_index_file = std::move(index_file);
+  m_index.clear();
+  return true;
+}
+
+bool csv_reader::write_index_file(const std::string& path,
+                                  const file::file_stamp& stamp) const
+{
+  const uint64_t header[index_header_size] = {
+    index_file_magic,
+    file_format_version,
+    stamp.size,
+    stamp.mtime_ns,
+    static_cast<uint64_t>(m_separator),
+    static_cast<uint64_t>(m_skip_rows),
+    static_cast<uint64_t>(m_has_header),
+    static_cast<uint64_t>(m_num_cols),
+    static_cast<uint64_t>(m_index.size() - 1)};
+  return write_file_atomically(path, [&](std::ofstream& ofs) {
+    ofs.write(reinterpret_cast<const char*>(header), sizeof(header));
+    ofs.write(reinterpret_cast<const char*>(m_index.data()),
+              m_index.size() * sizeof(uint64_t));
+    return ofs.good();
+  });
+}
+
+std::vector<uint64_t>
+csv_reader::get_binary_cache_key(const file::file_stamp& stamp,
+                                 int num_samples_to_use) const
+{
+  return {cache_file_magic,
+          file_format_version,
+          stamp.size,
+          stamp.mtime_ns,
+          sizeof(DataType),
+          static_cast<uint64_t>(m_separator),
+          static_cast<uint64_t>(m_skip_rows),
+          static_cast<uint64_t>(m_has_header),
+          static_cast<uint64_t>(m_skip_cols),
+          static_cast<uint64_t>(m_label_col),
+          static_cast<uint64_t>(m_response_col),
+          static_cast<uint64_t>(m_disable_labels),
+          static_cast<uint64_t>(m_disable_responses),
+          static_cast<uint64_t>(num_samples_to_use)};
+}
+
+bool csv_reader::open_binary_cache(const std::string& path,
+                                   const std::vector<uint64_t>& key)
+{
+  if (!file::file_exists(path)) {
+    return false;
+  }
+  auto cache_file = std::make_shared<const file::mapped_file>(path);
+  const size_t header_size = key.size() + 3;
+  if (cache_file->size() < header_size * sizeof(uint64_t)) {
+    return false;
+  }
+  const uint64_t* header = reinterpret_cast<const uint64_t*>(cache_file->data());
+  if (!std::equal(key.begin(), key.end(), header)) {
+    return false;
+  }
+  const uint64_t num_cols = header[key.size()];
+  const uint64_t num_samples = header[key.size() + 1];
+  const uint64_t row_width = header[key.size() + 2];
+  const auto layout = get_cache_layout(header_size,
+                                       num_samples,
+                                       row_width,
+                                       !m_disable_labels,
+                                       !m_disable_responses);
+  if (cache_file->size() != layout.size) {
+    return false;
+  }
+
+  m_num_cols = num_cols;
+  m_num_samples = num_samples;
+  m_cache_row_width = row_width;
+  m_cache_offsets_offset = layout.offsets;
+  m_cache_values_offset = layout.values;
+  if (!m_disable_labels) {
+    const int* labels =
+      reinterpret_cast<const int*>(cache_file->data() + layout.labels);
+    m_labels.assign(labels, labels + num_samples);
+  }
+  if (!m_disable_responses) {
+    const DataType* responses =
+      reinterpret_cast<const DataType*>(cache_file->data() + layout.responses);
+    m_responses.assign(responses, responses + num_samples);
+  }
+  m_cache_file = std::move(cache_file);
+  // The cache has its own copy of the line index.
+  m_index_file.reset();
+  m_index.clear();
+  m_index.shrink_to_fit();
+  return true;
+}
+
+bool csv_reader::write_binary_cache(const std::string& path,
+                                    const std::vector<uint64_t>& key) const
+{
+  std::vector<DataType> values(m_num_cols);
+  const uint64_t row_width =
+    m_num_samples > 0
+      ? parse_line(fetch_raw_line(0), values.data(), values.size(), true)
+      : 0;
+  std::vector<uint64_t> header(key);
+  header.push_back(m_num_cols);
+  header.push_back(m_num_samples);
+  header.push_back(row_width);
+  const auto layout = get_cache_layout(header.size(),
+                                       m_num_samples,
+                                       row_width,
+                                       !m_disable_labels,
+                                       !m_disable_responses);
+  const uint64_t* offsets = get_line_offsets();
+
+  return write_file_atomically(path, [&](std::ofstream& ofs) {
+    size_t pos = 0;
+    auto write = [&](const void* data, size_t size) {
+      ofs.write(static_cast<const char*>(data), size);
+      pos += size;
+    };
+    auto pad_to = [&](size_t offset) {
+      const char zeros[cache_alignment] = {};
+      write(zeros, offset - pos);
+    };
+    write(header.data(), header.size() * sizeof(uint64_t));
+    write(offsets, (m_num_samples + 1) * sizeof(uint64_t));
+    pad_to(layout.labels);
+    if (!m_disable_labels) {
+      write(m_labels.data(), m_num_samples * sizeof(int));
     }
+    pad_to(layout.responses);
+    if (!m_disable_responses) {
+      write(m_responses.data(), m_num_samples * sizeof(DataType));
+    }
+    pad_to(layout.values);
+    for (int i = 0; i < m_num_samples && ofs.good(); ++i) {
+      parse_line(fetch_raw_line(i), values.data(), values.size(), true);
+      write(values.data(), row_width * sizeof(DataType));
+    }
+    return ofs.good() && pos == layout.size;
+  });
+}
+
+const uint64_t* csv_reader::get_line_offsets() const
+{
+  if (m_cache_file != nullptr) {
+    return reinterpret_cast<const uint64_t*>(m_cache_file->data() +
+                                             m_cache_offsets_offset);
+  }
+  if (m_index_file != nullptr) {
+    return reinterpret_cast<const uint64_t*>(m_index_file->data()) +
+           index_header_size;
+  }
+  return m_index.data();
+}
+
+int csv_reader::get_num_indexed_lines() const
+{
+  if (m_index_file != nullptr) {
+    return static_cast<int>(
+      reinterpret_cast<const uint64_t*>(m_index_file->data())[8]);
   }
+  return m_index.empty() ? 0 : static_cast<int>(m_index.size() - 1);
 }
 
 } // namespace lbann
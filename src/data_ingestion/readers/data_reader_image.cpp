@@ -398,7 +398,9 @@ void image_data_reader::load_list_of_samples(const std::string sample_list_file)
 
   std::vector<char> buffer;
 
-  if (arg_parser.get<bool>(LBANN_OPTION_LOAD_FULL_SAMPLE_LIST_ONCE)) {
+  // Each rank reads its own lines of a binary sample list directly
+  if (arg_parser.get<bool>(LBANN_OPTION_LOAD_FULL_SAMPLE_LIST_ONCE) &&
+      !binary_sample_list_file::is_binary(sample_list_file)) {
     if (m_comm->am_trainer_master()) {
       load_file(sample_list_file, buffer);
     }
@@ -27,12 +27,19 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "lbann/data_ingestion/readers/data_reader_imagenet.hpp"
+#include "lbann/data_ingestion/data_store_conduit.hpp"
 #include "lbann/data_ingestion/readers/sample_list_impl.hpp"
 #include "lbann/utils/file_utils.hpp"
 #include "lbann/utils/image.hpp"
 
 namespace lbann {
 
+namespace {
+/** Encoded image of a sample in the data store */
+const sample_field_accessor image_buffer_field("buffer");
+const sample_field_accessor image_buffer_size_field("buffer_size");
+} // namespace
+
 imagenet_reader::imagenet_reader(bool shuffle) : image_data_reader(shuffle)
 {
   set_defaults();
@@ -104,12 +111,11 @@ bool imagenet_reader::fetch_datum(CPUMat& X, uint64_t data_id, uint64_t mb_idx)
     }
 
     if (have_node) {
-      char* buf = node[LBANN_DATA_ID_STR(data_id) + "/buffer"].value();
-      size_t size = node[LBANN_DATA_ID_STR(data_id) + "/buffer_size"].value();
-      El::Matrix<uint8_t> encoded_image(size,
-                                        1,
-                                        reinterpret_cast<uint8_t*>(buf),
-                                        size);
+      // decode_image only reads the encoded buffer
+      auto* buf = static_cast<uint8_t*>(
+        const_cast<void*>(image_buffer_field.get_view(node).data));
+      size_t size = image_buffer_size_field.get_node(node).to_uint64();
+      El::Matrix<uint8_t> encoded_image(size, 1, buf, size);
       decode_image(encoded_image, image, dims);
     }
   }
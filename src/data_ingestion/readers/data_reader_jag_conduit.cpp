@@ -1004,7 +1004,9 @@ void data_reader_jag_conduit::load_list_of_samples(
 
   std::vector<char> buffer;
 
-  if (arg_parser.get<bool>(LBANN_OPTION_LOAD_FULL_SAMPLE_LIST_ONCE)) {
+  // Each rank reads its own lines of a binary sample list directly
+  if (arg_parser.get<bool>(LBANN_OPTION_LOAD_FULL_SAMPLE_LIST_ONCE) &&
+      !binary_sample_list_file::is_binary(sample_list_file)) {
     if (m_comm->am_trainer_master()) {
       load_file(sample_list_file, buffer);
     }
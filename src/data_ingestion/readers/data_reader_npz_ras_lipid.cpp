@@ -37,6 +37,12 @@
 
 namespace lbann {
 
+namespace {
+/** Fields of a sample in the data store */
+const sample_field_accessor density_sig1_field("density_sig1");
+const sample_field_accessor states_field("states");
+} // namespace
+
 ras_lipid_conduit_data_reader::ras_lipid_conduit_data_reader(const bool shuffle)
   : generic_data_reader(shuffle)
 {}
@@ -321,8 +327,7 @@ bool ras_lipid_conduit_data_reader::fetch_datum(Mat& X,
                                                 uint64_t mb_idx)
 {
   const conduit::Node& node = m_data_store->get_conduit_node(data_id);
-  const double* data =
-    node[LBANN_DATA_ID_STR(data_id) + "/density_sig1"].value();
+  const double* data = density_sig1_field.get_view(node).as<double>();
 
   size_t n = m_seq_len * m_datum_num_words["density_sig1"];
   for (size_t j = 0; j < n; ++j) {
@@ -359,8 +364,8 @@ bool ras_lipid_conduit_data_reader::fetch_label(Mat& Y,
                                                 uint64_t data_id,
                                                 uint64_t mb_idx)
 {
-  const conduit::Node node = m_data_store->get_conduit_node(data_id);
-  const int* labels = node[LBANN_DATA_ID_STR(data_id) + "/states"].value();
+  const conduit::Node& node = m_data_store->get_conduit_node(data_id);
+  const int* labels = states_field.get_view(node).as<int>();
   for (int j = 0; j < m_seq_len; j++) {
     Y.Set(3 * j + labels[j], mb_idx, 1);
   }
@@ -38,6 +38,13 @@
 
 namespace lbann {
 
+namespace {
+/** Fields of a sample in the data store */
+const sample_field_accessor npz_data_field("data/data");
+const sample_field_accessor npz_label_field("frm/data");
+const sample_field_accessor npz_responses_field("responses/data");
+} // namespace
+
 numpy_npz_conduit_reader::numpy_npz_conduit_reader(const bool shuffle)
   : generic_data_reader(shuffle)
 {}
@@ -311,8 +318,7 @@ bool numpy_npz_conduit_reader::fetch_datum(Mat& X,
     }
   }
 
-  const char* char_data =
-    node[LBANN_DATA_ID_STR(data_id) + "/data/data"].value();
+  const char* char_data = npz_data_field.get_view(node).as<char>();
   char* char_data_2 = const_cast<char*>(char_data);
 
   if (m_data_word_size == 2) {
@@ -359,8 +365,7 @@ bool numpy_npz_conduit_reader::fetch_label(Mat& Y,
   }
 
   const conduit::Node& node = m_data_store->get_conduit_node(data_id);
-  const char* char_data =
-    node[LBANN_DATA_ID_STR(data_id) + "/frm/data"].value();
+  const char* char_data = npz_label_field.get_view(node).as<char>();
   char* char_data_2 = const_cast<char*>(char_data);
   int* label = reinterpret_cast<int*>(char_data_2);
   Y(*label, mb_idx) = 1;
@@ -396,8 +401,7 @@ bool numpy_npz_conduit_reader::fetch_response(Mat& Y,
     }
   }
 
-  const char* char_data =
-    node[LBANN_DATA_ID_STR(data_id) + "/responses/data"].value();
+  const char* char_data = npz_responses_field.get_view(node).as<char>();
   void* responses = (void*)char_data;
   // char *char_data_2 = const_cast<char*>(char_data);
   // void *responses = (void*)
@@ -33,8 +33,10 @@
 #include "lbann/utils/distconv.hpp"
 #ifdef LBANN_HAS_EMBEDDED_PYTHON
 #include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <regex>
+#include <thread>
 
 #include <Python.h>
 
@@ -89,6 +91,18 @@ bool python_dataset_reader::fetch_data_block(
     return true;
   }
 
+  El::Int sample_index;
+  for (uint64_t i = 0; i < mb_size; ++i) {
+    sample_index =
+      m_shuffled_indices[current_position_in_data_set + i * sample_stride];
+    indices_fetched.Set(i, 0, sample_index);
+  }
+
+  if (m_shared_memory_ring) {
+    fetch_from_ring(input_buffers, mb_size);
+    return true;
+  }
+
   // Acquire Python GIL on first IO thread
   python::global_interpreter_lock gil;
 
@@ -104,13 +118,6 @@ bool python_dataset_reader::fetch_data_block(
 #endif // LBANN_HAS_DISTCONV
   const uint64_t sample_size = get_linearized_data_size() / num_io_partitions;
 
-  El::Int sample_index;
-  for (uint64_t i = 0; i < mb_size; ++i) {
-    sample_index =
-      m_shuffled_indices[current_position_in_data_set + i * sample_stride];
-    indices_fetched.Set(i, 0, sample_index);
-  }
-
   // Get the next batch from the Python data reader
   python::object batch =
     PyObject_CallMethod(m_data_reader, "get_batch", "(l)", mb_size);
@@ -166,6 +173,101 @@ bool python_dataset_reader::fetch_data_block(
   return true;
 }
 
+void python_dataset_reader::fetch_from_ring(
+  std::map<data_field_type, CPUMat*>& input_buffers,
+  uint64_t mb_size)
+{
+  // If not enough samples were queued when the epoch began, queue the rest
+  if (m_queued_samples < mb_size) {
+    python::global_interpreter_lock gil;
+    queue_samples(mb_size - m_queued_samples);
+  }
+
+  // Wait for worker processes to write the mini-batch
+  for (uint64_t i = 0; i < mb_size; ++i) {
+    wait_for_ring_slot(m_ring_consumed + i);
+  }
+
+  // Copy each data field out of the ring
+  // Note: The mini-batch is a contiguous range of ring columns,
+  // except when it wraps around the end of the ring.
+  const El::Int start = m_ring_consumed % m_ring_size;
+  const El::Int first_size =
+    std::min(static_cast<El::Int>(mb_size),
+             static_cast<El::Int>(m_ring_size) - start);
+  auto copy_field = [&](DataType* ring_buffer, El::Int field_size, CPUMat& X) {
+    CPUMat ring_matrix(field_size, m_ring_size, ring_buffer, field_size);
+    auto X_first = El::View(X, El::ALL, El::IR(0, first_size));
+    El::Copy(El::LockedView(ring_matrix,
+                            El::ALL,
+                            El::IR(start, start + first_size)),
+             X_first);
+    if (first_size < static_cast<El::Int>(mb_size)) {
+      auto X_second = El::View(X, El::ALL, El::IR(first_size, mb_size));
+      El::Copy(El::LockedView(ring_matrix,
+                              El::ALL,
+                              El::IR(0, mb_size - first_size)),
+               X_second);
+    }
+  };
+  uint64_t num_io_partitions = 1;
+#ifdef LBANN_HAS_DISTCONV
+  num_io_partitions = dc::get_number_of_io_partitions();
+#endif // LBANN_HAS_DISTCONV
+  copy_field(m_ring_samples,
+             get_linearized_data_size() / num_io_partitions,
+             *input_buffers[INPUT_DATA_TYPE_SAMPLES]);
+  if (has_labels()) {
+    copy_field(m_ring_labels,
+               get_num_labels(),
+               *input_buffers[INPUT_DATA_TYPE_LABELS]);
+  }
+  if (has_responses()) {
+    CPUMat& Y = *input_buffers[INPUT_DATA_TYPE_RESPONSES];
+    copy_field(m_ring_responses, get_num_responses(), Y);
+#ifdef LBANN_HAS_DISTCONV
+    if (!m_tensor_shuffle_required) {
+      if (Y.LDim() != get_num_responses()) {
+        LBANN_ERROR("response buffer must be contiguous to shuffle "
+                    "responses for distconv");
+      }
+      shuffle_responses(Y.Buffer());
+    }
+#endif // LBANN_HAS_DISTCONV
+  }
+  m_ring_consumed += mb_size;
+
+  // Prefetch the next minibatch asynchronously
+  python::global_interpreter_lock gil;
+  this->queue_samples(mb_size);
+}
+
+void python_dataset_reader::wait_for_ring_slot(uint64_t sequence_number)
+{
+  const int64_t* flag = &m_ring_flags[sequence_number % m_ring_size];
+  const auto expected = static_cast<int64_t>(sequence_number + 1);
+  constexpr auto poll_interval = std::chrono::milliseconds(100);
+  auto last_poll = std::chrono::steady_clock::now();
+  for (unsigned spin = 0; __atomic_load_n(flag, __ATOMIC_ACQUIRE) < expected;
+       ++spin) {
+    if (spin < 64) {
+      std::this_thread::yield();
+    }
+    else {
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    // Periodically check whether a worker process has failed
+    const auto now = std::chrono::steady_clock::now();
+    if (now - last_poll > poll_interval) {
+      python::global_interpreter_lock gil;
+      python::object(PyObject_CallMethod(m_data_reader, "poll", nullptr));
+      python::check_error();
+      last_poll = now;
+    }
+  }
+}
+
 #ifdef LBANN_HAS_DISTCONV
 void python_dataset_reader::shuffle_responses(DataType* responses_ptr)
 {
@@ -297,17 +399,46 @@ void python_dataset_reader::setup(int num_io_threads,
               "(only float and double are supported)");
 #endif
 
+  // The ring must hold every queued sample that has not been consumed
+  if (m_shared_memory_ring) {
+    m_ring_size =
+      std::max(static_cast<uint64_t>(m_prefetch_factor) * num_io_threads,
+               get_trainer().get_max_mini_batch_size());
+    m_ring_queued = 0;
+    m_ring_consumed = 0;
+  }
+
   // Create Python data reader and worker processes
   python::object lbann_data = PyImport_ImportModule("lbann.util.data");
   m_data_reader = PyObject_CallMethod(lbann_data,
                                       "DataReader",
-                                      "(O, l, l, s)",
+                                      "(O, l, l, s, l)",
                                       m_dataset.get(),
                                       num_io_threads,
                                       m_prefetch_factor,
-                                      datatype_typecode.c_str());
+                                      datatype_typecode.c_str(),
+                                      static_cast<long>(m_ring_size));
   python::check_error();
 
+  // Get pointers into the shared-memory ring
+  // Note: The ring stays mapped as long as the Python data reader is
+  // alive.
+  if (m_shared_memory_ring) {
+    python::object buffers =
+      PyObject_CallMethod(m_data_reader, "ring_buffers", nullptr);
+    python::check_error();
+    auto get_ptr = [&buffers](const char* name) -> void* {
+      // Note: PyDict_GetItemString returns a borrowed reference
+      auto ptr = PyDict_GetItemString(buffers, name);
+      return ptr != nullptr ? PyLong_AsVoidPtr(ptr) : nullptr;
+    };
+    m_ring_flags = static_cast<int64_t*>(get_ptr("flags"));
+    m_ring_samples = static_cast<DataType*>(get_ptr("sample"));
+    m_ring_labels = static_cast<DataType*>(get_ptr("label"));
+    m_ring_responses = static_cast<DataType*>(get_ptr("response"));
+    python::check_error();
+  }
+
   queue_epoch();
 }
 
@@ -318,7 +449,7 @@ void python_dataset_reader::queue_samples(uint64_t samples_to_queue)
   dataset& ds = get_trainer().get_data_coordinator().get_dataset(mode);
 
   // Get shuffled indices to be fetched by worker processes
-  python::object inds_list = PyList_New(0);
+  m_indices_to_queue.clear();
   uint64_t num_samples = m_num_samples;
   uint64_t sample_stride = ds.get_sample_stride();
   uint64_t mini_batch_stride = ds.get_stride_to_next_mini_batch();
@@ -333,9 +464,7 @@ void python_dataset_reader::queue_samples(uint64_t samples_to_queue)
     if (sample_ind >= num_samples)
       break;
 
-    PyList_Append(
-      inds_list,
-      python::object(PyLong_FromLong(m_shuffled_indices[sample_ind])));
+    m_indices_to_queue.push_back(m_shuffled_indices[sample_ind]);
 
     ++m_dataset_sample_offset;
     ++m_queued_samples;
@@ -348,10 +477,29 @@ void python_dataset_reader::queue_samples(uint64_t samples_to_queue)
     }
   }
 
-  python::object(PyObject_CallMethod(m_data_reader,
-                                     "queue_samples",
-                                     "(O)",
-                                     inds_list.get()));
+  if (m_shared_memory_ring) {
+    if (m_ring_queued + m_indices_to_queue.size() - m_ring_consumed >
+        m_ring_size) {
+      LBANN_ERROR("attempted to queue ",
+                  m_indices_to_queue.size(),
+                  " samples into a shared-memory ring with ",
+                  m_ring_size,
+                  " slots and ",
+                  m_ring_queued - m_ring_consumed,
+                  " pending samples");
+    }
+    m_ring_queued += m_indices_to_queue.size();
+  }
+
+  // Pass indices as a flat int64 buffer
+  // Note: The Python data reader copies the indices before returning.
+  python::object inds = PyMemoryView_FromMemory(
+    reinterpret_cast<char*>(m_indices_to_queue.data()),
+    m_indices_to_queue.size() * sizeof(int64_t),
+    PyBUF_READ);
+  python::check_error();
+  python::object(
+    PyObject_CallMethod(m_data_reader, "queue_samples", "(O)", inds.get()));
   python::check_error();
 }
 
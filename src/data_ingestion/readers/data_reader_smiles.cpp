@@ -44,6 +44,11 @@
 
 namespace lbann {
 
+namespace {
+/** Encoded SMILES string of a sample in the data store */
+const sample_field_accessor smiles_data_field("data");
+} // namespace
+
 smiles_data_reader::smiles_data_reader(const bool shuffle)
   : data_reader_sample_list(shuffle)
 {}
@@ -317,7 +322,7 @@ bool smiles_data_reader::fetch_datum(Mat& X, uint64_t data_id, uint64_t mb_idx)
 
   const conduit::Node& node = m_data_store->get_conduit_node(data_id);
   const conduit::unsigned_short_array data =
-    node["/" + LBANN_DATA_ID_STR(data_id) + "/data"].as_unsigned_short_array();
+    smiles_data_field.get_node(node).as_unsigned_short_array();
   size_t j;
   size_t n = data.number_of_elements();
   for (j = 0; j < n; ++j) {
@@ -821,6 +826,17 @@ void smiles_data_reader::use_unused_index_set(execution_mode m)
   print_statistics();
 }
 
+int smiles_data_reader::get_sample_length(uint64_t data_id) const
+{
+  offset_map_t::const_iterator iter = m_sample_offsets.find(data_id);
+  if (iter == m_sample_offsets.end()) {
+    return -1;
+  }
+  // +2 is for <bos> and <eos>; longer strings are truncated when encoded
+  return std::min(static_cast<int>(iter->second.second) + 2,
+                  m_linearized_data_size);
+}
+
 void smiles_data_reader::get_sample_origin(const size_t index_in,
                                            std::string& filename_out,
                                            size_t& offset_out,
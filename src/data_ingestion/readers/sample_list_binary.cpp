@@ -0,0 +1,299 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/data_ingestion/readers/sample_list_binary.hpp"
+#include "lbann/data_ingestion/readers/sample_list_impl.hpp"
+#include "lbann/utils/exception.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace lbann {
+
+namespace {
+
+const std::string binary_sample_list_magic = "LBSLBIN1";
+
+void write_u64(std::ostream& out, uint64_t val)
+{
+  out.write(reinterpret_cast<const char*>(&val), sizeof(val));
+}
+
+} // namespace
+
+binary_sample_list_file::binary_sample_list_file(const std::string& filename)
+  : m_filename(filename)
+{
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LBANN_ERROR("unable to open binary sample list ",
+                filename,
+                ": ",
+                std::strerror(errno));
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    LBANN_ERROR("unable to stat binary sample list ", filename);
+  }
+  m_size = static_cast<size_t>(st.st_size);
+  if (m_size < binary_sample_list_magic.size() + 4 * sizeof(uint64_t)) {
+    ::close(fd);
+    LBANN_ERROR("binary sample list ", filename, " is truncated");
+  }
+  void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    LBANN_ERROR("unable to map binary sample list ",
+                filename,
+                ": ",
+                std::strerror(errno));
+  }
+  m_data = static_cast<const char*>(data);
+
+  try {
+    read_layout();
+  }
+  catch (...) {
+    ::munmap(data, m_size);
+    throw;
+  }
+}
+
+void binary_sample_list_file::read_layout()
+{
+  if (std::memcmp(m_data,
+                  binary_sample_list_magic.data(),
+                  binary_sample_list_magic.size()) != 0) {
+    LBANN_ERROR(m_filename, " is not a binary sample list");
+  }
+  size_t pos = binary_sample_list_magic.size();
+  m_header_size = read_u64(pos);
+  if (m_header_size > m_size) {
+    LBANN_ERROR("binary sample list ", m_filename, " is corrupted");
+  }
+  pos += sizeof(uint64_t) + m_header_size;
+  m_num_records = read_u64(pos);
+  pos += sizeof(uint64_t);
+  m_num_partitions = read_u64(pos);
+  pos += sizeof(uint64_t);
+  if (m_num_partitions == 0) {
+    LBANN_ERROR("binary sample list ", m_filename, " has no partitions");
+  }
+  m_partition_table = pos;
+  m_offset_table = m_partition_table + (m_num_partitions + 1) * sizeof(uint64_t);
+  m_record_data = m_offset_table + (m_num_records + 1) * sizeof(uint64_t);
+  if (m_num_records > m_size || m_num_partitions > m_size ||
+      m_record_data > m_size ||
+      read_u64(m_partition_table + m_num_partitions * sizeof(uint64_t)) !=
+        m_num_records ||
+      m_record_data + read_u64(m_offset_table +
+                               m_num_records * sizeof(uint64_t)) !=
+        m_size) {
+    LBANN_ERROR("binary sample list ", m_filename, " is corrupted");
+  }
+}
+
+binary_sample_list_file::~binary_sample_list_file()
+{
+  if (m_data != nullptr) {
+    ::munmap(const_cast<char*>(m_data), m_size);
+  }
+}
+
+bool binary_sample_list_file::is_binary(const std::string& filename)
+{
+  std::ifstream ifs(filename, std::ios::binary);
+  std::string magic(binary_sample_list_magic.size(), '\0');
+  ifs.read(&magic[0], magic.size());
+  return ifs.good() && magic == binary_sample_list_magic;
+}
+
+std::string binary_sample_list_file::get_header() const
+{
+  const size_t pos = binary_sample_list_magic.size() + sizeof(uint64_t);
+  return std::string(m_data + pos, m_header_size);
+}
+
+void binary_sample_list_file::for_each_record(
+  size_t stride,
+  size_t offset,
+  const std::function<void(const std::string&)>& f) const
+{
+  if (stride == 0 || offset >= stride) {
+    LBANN_ERROR("invalid stride (",
+                stride,
+                ") and offset (",
+                offset,
+                ") to load binary sample list ",
+                m_filename);
+  }
+  if (stride == m_num_partitions) {
+    // The records of this rank are contiguous
+    const size_t begin = read_u64(m_partition_table + offset * sizeof(uint64_t));
+    const size_t end =
+      read_u64(m_partition_table + (offset + 1) * sizeof(uint64_t));
+    for (size_t pos = begin; pos < end; ++pos) {
+      f(get_stored_record(pos));
+    }
+  }
+  else {
+    for (size_t idx = offset; idx < m_num_records; idx += stride) {
+      f(get_record(idx));
+    }
+  }
+}
+
+std::string binary_sample_list_file::get_record(size_t idx) const
+{
+  const size_t part = idx % m_num_partitions;
+  const size_t begin = read_u64(m_partition_table + part * sizeof(uint64_t));
+  return get_stored_record(begin + idx / m_num_partitions);
+}
+
+std::string binary_sample_list_file::get_stored_record(size_t pos) const
+{
+  if (pos >= m_num_records) {
+    LBANN_ERROR("record ",
+                pos,
+                " is out of range in binary sample list ",
+                m_filename);
+  }
+  const size_t begin = read_u64(m_offset_table + pos * sizeof(uint64_t));
+  const size_t end = read_u64(m_offset_table + (pos + 1) * sizeof(uint64_t));
+  if (begin > end || m_record_data + end > m_size) {
+    LBANN_ERROR("binary sample list ", m_filename, " is corrupted");
+  }
+  return std::string(m_data + m_record_data + begin, end - begin);
+}
+
+uint64_t binary_sample_list_file::read_u64(size_t pos) const
+{
+  if (pos + sizeof(uint64_t) > m_size) {
+    LBANN_ERROR("binary sample list ", m_filename, " is truncated");
+  }
+  uint64_t val;
+  std::memcpy(&val, m_data + pos, sizeof(val));
+  return val;
+}
+
+void convert_sample_list_to_binary(std::istream& text,
+                                   std::ostream& out,
+                                   size_t num_partitions)
+{
+  if (num_partitions == 0) {
+    LBANN_ERROR("binary sample lists need at least one partition");
+  }
+
+  // Copy the header lines verbatim
+  auto read_header_line = [&text](const char* info) {
+    std::string line;
+    if (!std::getline(text, line) || line.empty()) {
+      LBANN_ERROR("unable to read the header line of the sample list for ",
+                  info);
+    }
+    return line;
+  };
+  sample_list_header header;
+  std::string header_text;
+  std::string line = read_header_line("the exclusiveness");
+  header.set_sample_list_type(line);
+  header_text += line + '\n';
+  line = read_header_line("the number of samples and the number of files");
+  header.set_sample_count(line);
+  header_text += line + '\n';
+  header_text += read_header_line("the data file directory") + '\n';
+  if (header.use_label_header()) {
+    header_text += read_header_line("the path to label/response file") + '\n';
+  }
+
+  // Read the body lines, with trailing whitespace removed
+  const std::string whitespaces(" \t\f\v\n\r");
+  const size_t num_files = header.get_num_files();
+  std::vector<std::string> lines;
+  lines.reserve(num_files);
+  while (lines.size() < num_files && std::getline(text, line)) {
+    const size_t end_of_str = line.find_last_not_of(whitespaces);
+    if (end_of_str == std::string::npos) { // empty line
+      continue;
+    }
+    line.resize(end_of_str + 1);
+    lines.emplace_back(std::move(line));
+  }
+  if (lines.size() != num_files) {
+    LBANN_ERROR("sample list header lists ",
+                num_files,
+                " files, but the body has ",
+                lines.size(),
+                " lines");
+  }
+
+  // Lay out the records by partition
+  std::vector<uint64_t> partition_begin(num_partitions + 1, 0);
+  for (size_t p = 0; p < num_partitions; ++p) {
+    const size_t count =
+      (num_files > p ? (num_files - p + num_partitions - 1) / num_partitions
+                     : 0);
+    partition_begin[p + 1] = partition_begin[p] + count;
+  }
+  std::vector<uint64_t> record_offset;
+  record_offset.reserve(num_files + 1);
+  record_offset.push_back(0);
+  for (size_t p = 0; p < num_partitions; ++p) {
+    for (size_t idx = p; idx < num_files; idx += num_partitions) {
+      record_offset.push_back(record_offset.back() + lines[idx].size());
+    }
+  }
+
+  out.write(binary_sample_list_magic.data(), binary_sample_list_magic.size());
+  write_u64(out, header_text.size());
+  out.write(header_text.data(), header_text.size());
+  write_u64(out, num_files);
+  write_u64(out, num_partitions);
+  for (const auto& b : partition_begin) {
+    write_u64(out, b);
+  }
+  for (const auto& o : record_offset) {
+    write_u64(out, o);
+  }
+  for (size_t p = 0; p < num_partitions; ++p) {
+    for (size_t idx = p; idx < num_files; idx += num_partitions) {
+      out.write(lines[idx].data(), lines[idx].size());
+    }
+  }
+  if (!out.good()) {
+    LBANN_ERROR("failed to write the binary sample list");
+  }
+}
+
+} // namespace lbann
@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Catch2BasicSupport.hpp"
+
+// The code being tested
+#include "lbann/data_ingestion/readers/utils/length_bucketing.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Sample i has length (7 * i) % 50, so lengths are spread out but
+// repeat
+int sample_length(uint64_t i) { return static_cast<int>((7 * i) % 50); }
+
+std::vector<uint64_t> shuffled_indices(size_t n, std::mt19937& gen)
+{
+  std::vector<uint64_t> indices(n);
+  std::iota(indices.begin(), indices.end(), uint64_t{0});
+  std::shuffle(indices.begin(), indices.end(), gen);
+  return indices;
+}
+
+} // namespace
+
+TEST_CASE("Length-bucketed shuffle", "[data_reader][length_bucketing]")
+{
+  std::mt19937 gen(20240101);
+  constexpr size_t num_samples = 1003;
+  constexpr size_t mini_batch_size = 10;
+
+  SECTION("Every sample is visited once and the remainder is kept")
+  {
+    auto indices = shuffled_indices(num_samples, gen);
+    const auto original = indices;
+    lbann::bucket_indices_by_length(indices,
+                                    sample_length,
+                                    mini_batch_size,
+                                    4,
+                                    gen);
+    auto sorted = indices;
+    std::sort(sorted.begin(), sorted.end());
+    for (size_t i = 0; i < num_samples; ++i) {
+      CHECK(sorted[i] == i);
+    }
+    // The last partial mini-batch is untouched
+    for (size_t i = 1000; i < num_samples; ++i) {
+      CHECK(indices[i] == original[i]);
+    }
+  }
+
+  SECTION("Mini-batches from a single pool do not overlap in length")
+  {
+    auto indices = shuffled_indices(num_samples, gen);
+    lbann::bucket_indices_by_length(indices,
+                                    sample_length,
+                                    mini_batch_size,
+                                    num_samples,
+                                    gen);
+    std::vector<std::pair<int, int>> ranges;
+    for (size_t b = 0; b < num_samples / mini_batch_size; ++b) {
+      int lo = 50, hi = -1;
+      for (size_t k = 0; k < mini_batch_size; ++k) {
+        const int length = sample_length(indices[b * mini_batch_size + k]);
+        lo = std::min(lo, length);
+        hi = std::max(hi, length);
+      }
+      ranges.emplace_back(lo, hi);
+    }
+    std::sort(ranges.begin(), ranges.end());
+    for (size_t b = 1; b < ranges.size(); ++b) {
+      CHECK(ranges[b - 1].second <= ranges[b].first);
+    }
+    // Mini-batch order is shuffled rather than sorted by length
+    std::vector<int> batch_lengths;
+    for (size_t b = 0; b < ranges.size(); ++b) {
+      batch_lengths.push_back(sample_length(indices[b * mini_batch_size]));
+    }
+    CHECK_FALSE(std::is_sorted(batch_lengths.begin(), batch_lengths.end()));
+  }
+
+  SECTION("Bucketing is disabled without a pool size")
+  {
+    auto indices = shuffled_indices(num_samples, gen);
+    const auto original = indices;
+    lbann::bucket_indices_by_length(indices,
+                                    sample_length,
+                                    mini_batch_size,
+                                    0,
+                                    gen);
+    CHECK(indices == original);
+  }
+}
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Catch2BasicSupport.hpp"
+
+// The code being tested
+#include "lbann/data_ingestion/data_store_conduit.hpp"
+#include "lbann/data_ingestion/infrastructure/data_packer.hpp"
+
+#include <conduit/conduit_node.hpp>
+
+#include <vector>
+
+namespace {
+
+conduit::Node make_sample(uint64_t data_id)
+{
+  conduit::Node sample;
+  const std::string id = LBANN_DATA_ID_STR(data_id);
+  sample[id + "/data"].set(std::vector<conduit::int32>{1, 2, 3});
+  sample[id + "/frm/data"].set(std::vector<conduit::float64>{4.5, 5.5});
+  sample[id + "/label"].set(conduit::int64(7));
+  return sample;
+}
+
+} // namespace
+
+TEST_CASE("Sample field accessor", "[data_store][sample_accessor]")
+{
+  const auto sample = make_sample(42);
+
+  SECTION("Top-level field")
+  {
+    const lbann::sample_field_accessor field("data");
+    const auto view = field.get_view(sample);
+    REQUIRE(view.count == 3);
+    CHECK(view.dtype_id == conduit::DataType::INT32_ID);
+    CHECK(view.as<conduit::int32>()[0] == 1);
+    CHECK(view.as<conduit::int32>()[2] == 3);
+  }
+
+  SECTION("Nested field")
+  {
+    const lbann::sample_field_accessor field("frm/data");
+    const auto view = field.get_view(sample);
+    REQUIRE(view.count == 2);
+    CHECK(view.dtype_id == conduit::DataType::FLOAT64_ID);
+    CHECK(view.as<conduit::float64>()[1] == 5.5);
+    CHECK(field.get_node(sample).dtype().number_of_elements() == 2);
+  }
+
+  SECTION("The same accessor works for different samples")
+  {
+    const lbann::sample_field_accessor field("label");
+    const auto other = make_sample(1234567);
+    CHECK(field.get_node(sample).to_int64() == 7);
+    CHECK(field.get_node(other).to_int64() == 7);
+  }
+
+  SECTION("Missing fields and malformed samples are errors")
+  {
+    CHECK_THROWS(lbann::sample_field_accessor("bogus").get_node(sample));
+    CHECK_THROWS(lbann::sample_field_accessor("frm/bogus").get_node(sample));
+    conduit::Node two_samples;
+    two_samples.update(sample);
+    two_samples.update(make_sample(43));
+    CHECK_THROWS(lbann::sample_field_accessor("data").get_node(two_samples));
+  }
+
+  SECTION("Packing into a matrix")
+  {
+    const lbann::sample_field_accessor field("data");
+    lbann::CPUMat X(3, 2);
+    El::Zero(X);
+    CHECK(lbann::data_packer::extract_data_field_from_sample(field,
+                                                             sample,
+                                                             X,
+                                                             1) == 3);
+    CHECK(X(0, 0) == 0);
+    CHECK(X(0, 1) == 1);
+    CHECK(X(2, 1) == 3);
+  }
+}
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Catch2BasicSupport.hpp"
+
+#include "MPITestHelpers.hpp"
+#include "lbann/data_ingestion/readers/sample_list_binary.hpp"
+#include "lbann/data_ingestion/readers/sample_list_impl.hpp"
+#include <lbann/base.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+std::string const single_sample_list = R"ptext(SINGLE-SAMPLE
+7
+/p/vast1/lbann/datasets/images/
+/p/vast1/lbann/datasets/labels.txt
+img_0.png
+img_1.png
+img_2.png
+
+img_3.png
+img_4.png
+img_5.png
+img_6.png
+)ptext";
+
+} // namespace
+
+TEST_CASE("Binary sample list", "[mpi][data_reader][sample_list]")
+{
+  auto& comm = unit_test::utilities::current_world_comm();
+  std::string const filename = "binary_sample_list_test.bin";
+  const size_t num_ranks = comm.get_procs_per_trainer();
+
+  // Expected contents: the text list without the blank line
+  std::string expected = single_sample_list;
+  expected.erase(expected.find("\n\n"), 1);
+
+  auto const num_partitions =
+    GENERATE_COPY(size_t{1}, num_ranks, num_ranks + 1);
+  if (comm.am_world_master()) {
+    std::istringstream text(single_sample_list);
+    std::ofstream out(filename, std::ios::binary);
+    lbann::convert_sample_list_to_binary(text, out, num_partitions);
+  }
+  comm.global_barrier();
+
+  {
+    lbann::binary_sample_list_file blist(filename);
+    CHECK(blist.get_num_records() == 7);
+    CHECK(blist.get_num_partitions() == num_partitions);
+    std::vector<std::string> records;
+    blist.for_each_record(2, 1, [&records](std::string const& r) {
+      records.push_back(r);
+    });
+    CHECK(records ==
+          std::vector<std::string>{"img_1.png", "img_3.png", "img_5.png"});
+  }
+
+  lbann::sample_list<std::string> slist;
+  CHECK(lbann::binary_sample_list_file::is_binary(filename));
+  slist.load(filename, comm, true);
+  CHECK(slist.size() ==
+        (7 + num_ranks - 1 - comm.get_rank_in_trainer()) / num_ranks);
+  slist.all_gather_packed_lists(comm);
+  std::string buf;
+  slist.to_string(buf);
+  CHECK(buf == expected);
+  CHECK(slist[3].second == "img_3.png");
+
+  comm.global_barrier();
+  if (comm.am_world_master()) {
+    std::remove(filename.c_str());
+  }
+}
+
+TEST_CASE("Binary sample list conversion errors",
+          "[mpi][data_reader][sample_list]")
+{
+  std::string const truncated = R"ptext(SINGLE-SAMPLE
+3
+/p/vast1/lbann/datasets/images/
+/p/vast1/lbann/datasets/labels.txt
+img_0.png
+)ptext";
+  std::istringstream text(truncated);
+  std::ostringstream out;
+  CHECK_THROWS(lbann::convert_sample_list_to_binary(text, out));
+  CHECK_FALSE(lbann::binary_sample_list_file::is_binary("no_such_file"));
+}
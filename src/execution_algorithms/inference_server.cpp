@@ -0,0 +1,336 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "lbann/execution_algorithms/inference_server.hpp"
+
+#include "lbann/comm.hpp"
+#include "lbann/execution_algorithms/sgd_execution_context.hpp"
+#include "lbann/layers/data_type_layer.hpp"
+#include "lbann/layers/io/input_layer.hpp"
+#include "lbann/models/model.hpp"
+#include "lbann/utils/exception.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace lbann {
+
+namespace {
+
+template <El::Device Device>
+bool try_get_input_layer(
+  Layer& l,
+  std::function<void(El::AbstractDistMatrix<DataType> const&)>& set_samples)
+{
+  using InputLayerType =
+    input_layer<DataType, data_layout::DATA_PARALLEL, Device>;
+  auto* il = dynamic_cast<InputLayerType*>(&l);
+  if (il == nullptr) {
+    return false;
+  }
+  set_samples = [il](El::AbstractDistMatrix<DataType> const& samples) {
+    il->set_samples(samples);
+  };
+  return true;
+}
+
+} // namespace
+
+inference_server::inference_server(observer_ptr<model> m,
+                                   size_t max_batch_size,
+                                   std::chrono::microseconds max_delay,
+                                   std::string const& output_layer)
+  : m_model(*m),
+    m_output_layer(nullptr),
+    m_sample_size(0),
+    m_output_size(0),
+    m_max_batch_size(max_batch_size),
+    m_max_delay(max_delay)
+{
+  if (m_max_batch_size == 0) {
+    LBANN_ERROR("inference server requires a positive max batch size");
+  }
+  if (m_max_batch_size > m_model.get_max_mini_batch_size()) {
+    LBANN_ERROR("inference server max batch size (",
+                m_max_batch_size,
+                ") exceeds the max mini-batch size of model \"",
+                m_model.get_name(),
+                "\" (",
+                m_model.get_max_mini_batch_size(),
+                ")");
+  }
+  auto& comm = *m_model.get_comm();
+  if (comm.get_procs_per_trainer() != 1) {
+    LBANN_ERROR("inference server only supports trainers with one process, "
+                "but the trainer has ",
+                comm.get_procs_per_trainer());
+  }
+
+  // Find input and output layers
+  Layer* output = nullptr;
+  for (auto* l : m_model.get_layers()) {
+    if (l->get_type() == "input") {
+      if (m_set_samples) {
+        LBANN_ERROR("inference server requires a model with one input layer");
+      }
+      m_sample_size = l->get_output_size();
+      bool found = try_get_input_layer<El::Device::CPU>(*l, m_set_samples);
+#ifdef LBANN_HAS_GPU
+      found = found || try_get_input_layer<El::Device::GPU>(*l, m_set_samples);
+#endif // LBANN_HAS_GPU
+      if (!found) {
+        LBANN_ERROR("input layer \"",
+                    l->get_name(),
+                    "\" does not have the default data type");
+      }
+    }
+    if (output_layer.empty() ? l->get_type() != "dummy"
+                             : l->get_name() == output_layer) {
+      output = l;
+    }
+  }
+  if (!m_set_samples) {
+    LBANN_ERROR("could not find an input layer in model \"",
+                m_model.get_name(),
+                "\"");
+  }
+  if (output == nullptr) {
+    LBANN_ERROR("could not find output layer \"",
+                output_layer,
+                "\" in model \"",
+                m_model.get_name(),
+                "\"");
+  }
+  // Forward-only models release intermediate activations unless
+  // the layer keeps them. A child that runs in-place would overwrite
+  // them, which is only prevented if this is set before setup.
+  output->set_keep_activations(true);
+  for (int i = 0; i < output->get_num_children(); ++i) {
+    if (output->get_child_layer(i).runs_inplace()) {
+      LBANN_ERROR("output layer \"",
+                  output->get_name(),
+                  "\" has a child layer that runs in-place, so its ",
+                  "activations cannot be read after forward prop. ",
+                  "Call set_keep_activations on it before model setup.");
+    }
+  }
+  m_output_layer = dynamic_cast<data_type_layer<DataType> const*>(output);
+  if (m_output_layer == nullptr) {
+    LBANN_ERROR("output layer \"",
+                output->get_name(),
+                "\" does not have the default data type");
+  }
+  m_output_size = m_output_layer->get_output_size();
+
+  // Allocate staging buffers for double buffering
+  auto& grid = comm.get_trainer_grid();
+  for (int i = 0; i < 2; ++i) {
+    m_free_buffers.emplace_back(
+      std::make_unique<buffer_type>(m_sample_size, m_max_batch_size, grid));
+  }
+
+  m_batch_thread = std::thread(&inference_server::batch_loop, this);
+  m_execute_thread = std::thread(&inference_server::execute_loop, this);
+}
+
+inference_server::~inference_server()
+{
+  try {
+    stop();
+  }
+  catch (std::exception const& e) {
+    LBANN_WARNING("error while stopping inference server: ", e.what());
+  }
+}
+
+std::future<inference_server::output_type>
+inference_server::submit(sample_type sample)
+{
+  if (static_cast<El::Int>(sample.size()) != m_sample_size) {
+    LBANN_ERROR("inference server expected a sample with ",
+                m_sample_size,
+                " entries, but got ",
+                sample.size());
+  }
+  request req;
+  req.sample = std::move(sample);
+  req.arrival = clock_type::now();
+  auto result = req.result.get_future();
+  {
+    std::lock_guard<std::mutex> lock(m_request_mutex);
+    if (m_stopping) {
+      LBANN_ERROR("inference server has been stopped");
+    }
+    m_requests.emplace_back(std::move(req));
+  }
+  m_request_cv.notify_one();
+  return result;
+}
+
+void inference_server::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_request_mutex);
+    m_stopping = true;
+  }
+  m_request_cv.notify_all();
+  if (m_batch_thread.joinable()) {
+    m_batch_thread.join();
+  }
+  if (m_execute_thread.joinable()) {
+    m_execute_thread.join();
+  }
+}
+
+inference_server::statistics inference_server::get_statistics() const
+{
+  std::lock_guard<std::mutex> lock(m_batch_mutex);
+  return m_statistics;
+}
+
+void inference_server::batch_loop()
+{
+  while (true) {
+
+    // Wait for a free staging buffer. Requests keep accumulating
+    // meanwhile, so a busy model gets larger mini-batches.
+    std::unique_ptr<buffer_type> buffer;
+    {
+      std::unique_lock<std::mutex> lock(m_batch_mutex);
+      m_batch_cv.wait(lock, [this] { return !m_free_buffers.empty(); });
+      buffer = std::move(m_free_buffers.back());
+      m_free_buffers.pop_back();
+    }
+
+    // Wait until the batch is full or its oldest request is due
+    std::vector<request> requests;
+    {
+      std::unique_lock<std::mutex> lock(m_request_mutex);
+      m_request_cv.wait(lock,
+                        [this] { return m_stopping || !m_requests.empty(); });
+      if (m_requests.empty()) {
+        break;
+      }
+      const auto deadline = m_requests.front().arrival + m_max_delay;
+      m_request_cv.wait_until(lock, deadline, [this] {
+        return m_stopping || m_requests.size() >= m_max_batch_size;
+      });
+      const size_t batch_size = std::min(m_requests.size(), m_max_batch_size);
+      requests.reserve(batch_size);
+      for (size_t i = 0; i < batch_size; ++i) {
+        requests.emplace_back(std::move(m_requests.front()));
+        m_requests.pop_front();
+      }
+    }
+
+    // Pack samples into the staging buffer, one per column
+    batch b;
+    b.samples = std::move(buffer);
+    b.samples->Resize(m_sample_size, requests.size());
+    auto& local_samples = b.samples->Matrix();
+    b.results.reserve(requests.size());
+    for (size_t j = 0; j < requests.size(); ++j) {
+      std::memcpy(local_samples.Buffer(0, j),
+                  requests[j].sample.data(),
+                  m_sample_size * sizeof(DataType));
+      b.results.emplace_back(std::move(requests[j].result));
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_batch_mutex);
+      m_batches.emplace_back(std::move(b));
+    }
+    m_batch_cv.notify_all();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_batch_mutex);
+    m_batching_done = true;
+  }
+  m_batch_cv.notify_all();
+}
+
+void inference_server::execute_loop()
+{
+  // Layers get the mini-batch size through an SGD execution context
+  // (see batch_functional_inference_algorithm)
+  auto c = SGDExecutionContext(execution_mode::inference);
+  m_model.reset_mode(c, execution_mode::inference);
+
+  while (true) {
+    batch b;
+    {
+      std::unique_lock<std::mutex> lock(m_batch_mutex);
+      m_batch_cv.wait(lock,
+                      [this] { return m_batching_done || !m_batches.empty(); });
+      if (m_batches.empty()) {
+        break;
+      }
+      b = std::move(m_batches.front());
+      m_batches.pop_front();
+    }
+
+    execute(b);
+
+    {
+      std::lock_guard<std::mutex> lock(m_batch_mutex);
+      ++m_statistics.num_batches;
+      m_statistics.num_requests += b.results.size();
+      m_free_buffers.emplace_back(std::move(b.samples));
+    }
+    m_batch_cv.notify_all();
+  }
+}
+
+void inference_server::execute(batch& b)
+{
+  try {
+    const El::Int batch_size = b.samples->Width();
+    m_model.set_current_mini_batch_size(batch_size);
+    m_set_samples(*b.samples);
+    m_model.forward_prop(execution_mode::inference);
+
+    El::Matrix<DataType, El::Device::CPU> outputs;
+    El::Copy(m_output_layer->get_activations().LockedMatrix(), outputs);
+    for (El::Int j = 0; j < batch_size; ++j) {
+      DataType const* col = outputs.LockedBuffer(0, j);
+      b.results[j].set_value(output_type(col, col + m_output_size));
+    }
+  }
+  catch (...) {
+    for (auto& result : b.results) {
+      try {
+        result.set_exception(std::current_exception());
+      }
+      catch (std::future_error const&) {
+        // Result was already set
+      }
+    }
+  }
+}
+
+} // namespace lbann
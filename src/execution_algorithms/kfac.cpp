@@ -49,6 +49,7 @@
 #include "lbann/proto/training_algorithm.pb.h"
 
 #include <cstddef>
+#include <future>
 #include <limits>
 
 namespace lbann {
@@ -77,7 +78,9 @@ KFAC::KFAC(std::string name,
            bool distribute_precondition_compute,
            bool use_eigen_decomposition,
            bool enable_copy_errors,
-           bool enable_copy_activations)
+           bool enable_copy_activations,
+           size_t max_inverse_staleness,
+           bool refine_inverse_placement)
 
   : TrainingAlgorithm{std::move(name)},
     m_stopping_criteria{std::move(stop)},
@@ -94,6 +97,7 @@ KFAC::KFAC(std::string name,
     m_update_intervals{std::move(update_intervals)},
     m_update_interval_steps{update_interval_steps},
     m_inverse_strategy{inverse_strategy},
+    m_refine_inverse_placement{refine_inverse_placement},
     m_disable_layers{std::move(disable_layers)},
     m_learning_rate_factor{learning_rate_factor},
     m_learning_rate_factor_gru{learning_rate_factor_gru},
@@ -102,6 +106,7 @@ KFAC::KFAC(std::string name,
     m_enable_copy_errors{enable_copy_errors},
     m_enable_copy_activations{enable_copy_activations},
     m_use_eigen_decomposition{use_eigen_decomposition},
+    m_max_inverse_staleness{max_inverse_staleness},
     m_use_KFAC_epoch{std::move(kfac_use_interval)}
 {}
 
@@ -187,6 +192,38 @@ void KFAC::train(ExeContextType& kfac_context,
       // Finalize epoch
       sgd_context.inc_epoch();
 
+      if (m_print_time && m_num_async_inverses > 0 &&
+          comm.am_trainer_master()) {
+        std::ostringstream oss;
+        oss << "K-FAC: background inverse updates (epoch "
+            << sgd_context.get_epoch() - 1 << "): "
+            << m_num_blocked_async_inverses << " of " << m_num_async_inverses
+            << " blocked a step, waited "
+            << m_time_span_inverse_wait / 1000.0 << " ms" << std::endl;
+        std::cout << oss.str();
+      }
+      if (m_print_time) {
+        // Collective over the trainer, so every process takes part
+        const double inverse_time = m_time_span_inverse / 1000.0;
+        const double min_time =
+          comm.trainer_allreduce(inverse_time, El::mpi::MIN);
+        const double max_time =
+          comm.trainer_allreduce(inverse_time, El::mpi::MAX);
+        const double mean_time =
+          comm.trainer_allreduce(inverse_time) / comm.get_procs_per_trainer();
+        if (comm.am_trainer_master()) {
+          std::ostringstream oss;
+          oss << "K-FAC: inverse time per rank (epoch "
+              << sgd_context.get_epoch() - 1 << "): min=" << min_time
+              << " ms, mean=" << mean_time << " ms, max=" << max_time << " ms"
+              << std::endl;
+          std::cout << oss.str();
+        }
+      }
+      m_time_span_inverse = 0;
+      m_num_async_inverses = 0;
+      m_num_blocked_async_inverses = 0;
+      m_time_span_inverse_wait = 0;
       m_time_span_inverse_comm = 0;
       m_time_span_backward_comm = 0;
       m_time_span_backward_comm_end = 0;
@@ -245,6 +282,11 @@ void KFAC::train(ExeContextType& kfac_context,
 
   sgd_context.stop_timer();
 
+  // Publish inverses that are still being computed in the background
+  if (m_inverse_future.valid()) {
+    finish_async_inverse(kfac_context, comm);
+  }
+
   // Reset the model back to the training execution context prior to
   // end of training callbacks
   model.reset_mode(sgd_context, execution_mode::training);
@@ -1372,6 +1414,10 @@ void KFAC::on_forward_prop_end(ExeContextType& context, model& model)
     if (comm.am_trainer_master()) {
       for (const auto& block : context.m_blocks)
         std::cout << "K-FAC setup: " << block->get_info() << std::endl;
+      if (m_inverse_strategy == kfac::kfac_inverse_strategy::BALANCED &&
+          comm.get_grid_type() != GridType::NO_GRID)
+        LBANN_WARNING("The balanced K-FAC inverse strategy is not supported "
+                      "with sub-grid parallelism, using round-robin placement");
     }
 
     prof_region_end("kfac-setup", prof_sync);
@@ -1432,6 +1478,166 @@ void KFAC::on_forward_prop_end(ExeContextType& context, model& model)
       .count();
 }
 
+void KFAC::update_block_inverse(ExeContextType& context,
+                                size_t block_index,
+                                lbann_comm& comm,
+                                double damping_act,
+                                double damping_err,
+                                double damping_bn_act,
+                                double damping_bn_err)
+{
+  auto& block = *context.m_blocks[block_index];
+  auto t_start = std::chrono::high_resolution_clock::now();
+  // TODO: Add kfac_block::is_bn?
+  const bool is_bn = dynamic_cast<kfac_block_bn<Device>*>(&block) != nullptr;
+  const bool is_gru = dynamic_cast<kfac_block_gru<Device>*>(&block) != nullptr;
+  block.update_kronecker_inverse(
+    &comm,
+    m_use_pi,
+    is_bn ? damping_bn_act : damping_act,
+    is_bn ? damping_bn_err : damping_err,
+    is_gru ? m_learning_rate_factor_gru : m_learning_rate_factor,
+    m_use_eigen_decomposition,
+    m_print_matrix,
+    m_print_matrix_summary,
+    m_print_time);
+#ifdef LBANN_HAS_GPU
+  // Only wait for the GPU while the measured times are printed or
+  // still needed to refine the inverse placement
+  if (m_print_time ||
+      (m_refine_inverse_placement && !m_inverse_placement_refined)) {
+    hydrogen::gpu::SynchronizeDevice();
+  }
+#endif // LBANN_HAS_GPU
+  auto t_stop = std::chrono::high_resolution_clock::now();
+  m_inverse_block_times[block_index] =
+    std::chrono::duration_cast<std::chrono::microseconds>(t_stop - t_start)
+      .count();
+}
+
+void KFAC::update_inverse_proc_ranks(ExeContextType& context,
+                                     lbann_comm& comm)
+{
+  const size_t num_blocks = context.m_blocks.size();
+  std::vector<double> costs(num_blocks);
+  if (!m_has_kronecker_inverse) {
+    // Every process holds all of the average Kronecker factors
+    for (size_t i = 0; i < num_blocks; ++i)
+      costs[i] = context.m_blocks[i]->get_inverse_cost();
+  }
+  else if (m_refine_inverse_placement && !m_inverse_placement_refined &&
+           m_num_inverse_updates > 1) {
+    // Only the owner of a block measured its time. The first
+    // update is skipped since it includes workspace allocation. Every
+    // process keeps the average Kronecker factors, so a new owner
+    // continues their history.
+    std::vector<double> times(num_blocks, 0.0);
+    for (size_t i = 0; i < num_blocks; ++i) {
+      if ((size_t)comm.get_rank_in_trainer() ==
+          context.m_blocks[i]->get_inverse_proc_rank())
+        times[i] = m_inverse_block_times[i];
+    }
+    comm.trainer_allreduce(times.data(), num_blocks, costs.data());
+    m_inverse_placement_refined = true;
+  }
+  else {
+    return;
+  }
+
+  const auto ranks =
+    kfac::assign_inverse_proc_ranks(costs, comm.get_procs_per_trainer());
+  for (size_t i = 0; i < num_blocks; ++i)
+    context.m_blocks[i]->set_inverse_proc_rank(ranks[i]);
+
+  if (comm.am_trainer_master()) {
+    for (const auto& block : context.m_blocks)
+      std::cout << "K-FAC balanced placement: " << block->get_info()
+                << std::endl;
+  }
+}
+
+void KFAC::allgather_inverses(ExeContextType& context, lbann_comm& comm)
+{
+  int global_buffer_inverses_size = 0;
+
+  for (auto& block : context.m_blocks) {
+    global_buffer_inverses_size += block->get_inverse_matrices_size(&comm);
+  }
+
+  El::Matrix<DataType, Device>& global_buffer_inverse =
+    context.get_workspace_matrix("allgather_inverse_recv_buffer",
+                                 global_buffer_inverses_size,
+                                 1);
+  kfac::allgather_inverse_matrices(context.m_blocks,
+                                   global_buffer_inverse,
+                                   &comm);
+}
+
+void KFAC::start_async_inverse(ExeContextType& context,
+                               lbann_comm& comm,
+                               size_t step)
+{
+  std::vector<size_t> blocks;
+  for (size_t i = 0; i < context.m_blocks.size(); ++i) {
+    auto& block = *context.m_blocks[i];
+    if ((size_t)comm.get_rank_in_trainer() == block.get_inverse_proc_rank()) {
+      block.set_stage_inverse_updates(true);
+      blocks.push_back(i);
+    }
+  }
+
+  // The damping values are updated every step, so the background
+  // thread works on a snapshot of them.
+  const double damping_act = context.m_damping_act;
+  const double damping_err = context.m_damping_err;
+  const double damping_bn_act = context.m_damping_bn_act;
+  const double damping_bn_err = context.m_damping_bn_err;
+  auto update_inverses = [this, &context, &comm, blocks, damping_act,
+                          damping_err, damping_bn_act, damping_bn_err]() {
+    for (const auto& i : blocks) {
+      update_block_inverse(context,
+                           i,
+                           comm,
+                           damping_act,
+                           damping_err,
+                           damping_bn_act,
+                           damping_bn_err);
+    }
+#ifdef LBANN_HAS_GPU
+    hydrogen::gpu::SynchronizeDevice();
+#endif // LBANN_HAS_GPU
+  };
+  m_inverse_future = std::async(std::launch::async, update_inverses);
+  m_inverse_launch_step = step;
+  ++m_num_async_inverses;
+}
+
+void KFAC::finish_async_inverse(ExeContextType& context, lbann_comm& comm)
+{
+  prof_region_begin("kfac-inverse", prof_color, prof_sync);
+  auto t_start = std::chrono::high_resolution_clock::now();
+  if (m_inverse_future.wait_for(std::chrono::seconds(0)) !=
+      std::future_status::ready) {
+    ++m_num_blocked_async_inverses;
+  }
+  m_inverse_future.get();
+  auto t_stop = std::chrono::high_resolution_clock::now();
+  m_time_span_inverse_wait +=
+    std::chrono::duration_cast<std::chrono::microseconds>(t_stop - t_start)
+      .count();
+
+  for (size_t i = 0; i < context.m_blocks.size(); ++i) {
+    auto& block = *context.m_blocks[i];
+    if ((size_t)comm.get_rank_in_trainer() == block.get_inverse_proc_rank()) {
+      block.set_stage_inverse_updates(false);
+      block.publish_staged_inverses();
+      m_time_span_inverse += m_inverse_block_times[i];
+    }
+  }
+  allgather_inverses(context, comm);
+  prof_region_end("kfac-inverse", prof_sync);
+}
+
 void KFAC::on_backward_prop_end(ExeContextType& context, model& model)
 {
 
@@ -1532,6 +1738,16 @@ void KFAC::on_backward_prop_end(ExeContextType& context, model& model)
     const bool is_kronecker_update_required =
       ((num_steps % context.m_update_interval) == 0 ||
        !m_has_kronecker_inverse);
+
+    // Inverses computed in the background are published after at most
+    // m_max_inverse_staleness steps, and always before the Kronecker
+    // factors they are computed from are updated again.
+    if (m_inverse_future.valid() &&
+        (is_kronecker_update_required ||
+         num_steps - m_inverse_launch_step >= m_max_inverse_staleness)) {
+      finish_async_inverse(context, comm);
+    }
+
     if (is_kronecker_update_required) {
       prof_region_begin("kfac-update", prof_color, prof_sync);
 
@@ -1614,63 +1830,65 @@ void KFAC::on_backward_prop_end(ExeContextType& context, model& model)
       prof_region_end("kfac-update", prof_sync);
     }
 
-    // Step 2: Model-parallel inverse computation
-    prof_region_begin("kfac-inverse", prof_color, prof_sync);
-    for (auto& block : context.m_blocks) {
-      if (!is_kronecker_update_required ||
-          (size_t)comm.get_rank_in_trainer() != block->get_inverse_proc_rank())
-        continue;
-
-      prof_region_begin(("kfac-inverse/" + block->get_name()).c_str(),
-                        prof_color,
-                        prof_sync);
-      // TODO: Add kfac_block::is_bn?
-      const bool is_bn =
-        dynamic_cast<kfac_block_bn<Device>*>(block.get()) != nullptr;
-      const bool is_gru =
-        dynamic_cast<kfac_block_gru<Device>*>(block.get()) != nullptr;
-      block->update_kronecker_inverse(
-        &comm,
-        m_use_pi,
-        is_bn ? context.m_damping_bn_act : context.m_damping_act,
-        is_bn ? context.m_damping_bn_err : context.m_damping_err,
-        is_gru ? m_learning_rate_factor_gru : m_learning_rate_factor,
-        m_use_eigen_decomposition,
-        m_print_matrix,
-        m_print_matrix_summary,
-        m_print_time);
-      prof_region_end(("kfac-inverse/" + block->get_name()).c_str(), prof_sync);
+    if (is_kronecker_update_required) {
+      if (m_inverse_block_times.size() != context.m_blocks.size())
+        m_inverse_block_times.assign(context.m_blocks.size(), 0.0);
+      if (m_inverse_strategy == kfac::kfac_inverse_strategy::BALANCED &&
+          comm.get_grid_type() == GridType::NO_GRID)
+        update_inverse_proc_ranks(context, comm);
+      ++m_num_inverse_updates;
     }
 
-    // allgather inverse matrices
-    if (is_first_step and false) {
-      kfac::allgather_inverse_matrices_sizes(context.m_blocks,
-                                             m_inverse_matrices_size,
-                                             &comm);
-      int block_number = 0;
-      for (auto& block : context.m_blocks) {
-        block->resize_inverse_matrices_size(m_inverse_matrices_size,
-                                            block_number);
-        block_number++;
+    // Step 2: Model-parallel inverse computation
+    if (m_max_inverse_staleness > 0 && m_has_kronecker_inverse) {
+      // Precondition with the current inverses while the new ones are
+      // computed in the background.
+      if (is_kronecker_update_required) {
+        start_async_inverse(context, comm, num_steps);
       }
     }
+    else {
+      prof_region_begin("kfac-inverse", prof_color, prof_sync);
+      for (size_t i = 0; i < context.m_blocks.size(); ++i) {
+        const auto& block = context.m_blocks[i];
+        if (!is_kronecker_update_required ||
+            (size_t)comm.get_rank_in_trainer() !=
+              block->get_inverse_proc_rank())
+          continue;
 
-    int global_buffer_inverses_size = 0;
+        prof_region_begin(("kfac-inverse/" + block->get_name()).c_str(),
+                          prof_color,
+                          prof_sync);
+        update_block_inverse(context,
+                             i,
+                             comm,
+                             context.m_damping_act,
+                             context.m_damping_err,
+                             context.m_damping_bn_act,
+                             context.m_damping_bn_err);
+        m_time_span_inverse += m_inverse_block_times[i];
+        prof_region_end(("kfac-inverse/" + block->get_name()).c_str(),
+                        prof_sync);
+      }
 
-    for (auto& block : context.m_blocks) {
-      global_buffer_inverses_size += block->get_inverse_matrices_size(&comm);
-    }
+      // allgather inverse matrices
+      if (is_first_step and false) {
+        kfac::allgather_inverse_matrices_sizes(context.m_blocks,
+                                               m_inverse_matrices_size,
+                                               &comm);
+        int block_number = 0;
+        for (auto& block : context.m_blocks) {
+          block->resize_inverse_matrices_size(m_inverse_matrices_size,
+                                              block_number);
+          block_number++;
+        }
+      }
 
-    El::Matrix<DataType, Device>& global_buffer_inverse =
-      context.get_workspace_matrix("allgather_inverse_recv_buffer",
-                                   global_buffer_inverses_size,
-                                   1);
-    kfac::allgather_inverse_matrices(context.m_blocks,
-                                     global_buffer_inverse,
-                                     &comm);
+      allgather_inverses(context, comm);
 
-    m_has_kronecker_inverse = true;
-    prof_region_end("kfac-inverse", prof_sync);
+      m_has_kronecker_inverse = true;
+      prof_region_end("kfac-inverse", prof_sync);
+    }
 
 #ifdef LBANN_NVPROF
     prof_region_begin("kfac-inverse-barrier", prof_color, prof_sync);
@@ -1865,6 +2083,8 @@ lbann::make<lbann::KFAC>(google::protobuf::Message const& msg_in)
   const bool enable_copy_errors = kfac_params.enable_copy_errors();
   const bool enable_copy_activations = kfac_params.enable_copy_activations();
   const bool use_eigen_decomposition = kfac_params.use_eigen_decomposition();
+  const size_t max_inverse_staleness = kfac_params.max_inverse_staleness();
+  const bool refine_inverse_placement = kfac_params.refine_inverse_placement();
 
   const std::string inverse_strategy_str = kfac_params.inverse_strategy();
   kfac::kfac_inverse_strategy inverse_strategy;
@@ -1874,6 +2094,8 @@ lbann::make<lbann::KFAC>(google::protobuf::Message const& msg_in)
     inverse_strategy = kfac::kfac_inverse_strategy::EACH;
   else if (inverse_strategy_str == "root")
     inverse_strategy = kfac::kfac_inverse_strategy::ROOT;
+  else if (inverse_strategy_str == "balanced")
+    inverse_strategy = kfac::kfac_inverse_strategy::BALANCED;
   else {
     std::stringstream err;
     err << "Invalid inverse strategy type: " << inverse_strategy_str;
@@ -1913,5 +2135,7 @@ lbann::make<lbann::KFAC>(google::protobuf::Message const& msg_in)
                                     distribute_precondition_compute,
                                     use_eigen_decomposition,
                                     enable_copy_errors,
-                                    enable_copy_activations);
+                                    enable_copy_activations,
+                                    max_inverse_staleness,
+                                    refine_inverse_placement);
 }
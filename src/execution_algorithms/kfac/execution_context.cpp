@@ -68,6 +68,7 @@ KFACExecutionContext::get_workspace_matrix(const std::string& key,
                                            const size_t height,
                                            const size_t width)
 {
+  std::lock_guard<std::mutex> lock(m_workspace_mutex);
   if (m_workspace.find(key) == m_workspace.end()) {
     // std::ostringstream oss;
     // oss << "K-FAC workspace allocation (rank=" << m_rank
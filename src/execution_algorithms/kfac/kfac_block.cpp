@@ -125,6 +125,35 @@ kfac_block<Device>::get_internal_matrix_info() const
   LBANN_ERROR("this function should be called via a sub-class.");
 }
 
+template <El::Device Device>
+double kfac_block<Device>::get_inverse_cost() const
+{
+  LBANN_ERROR("this function should be called via a sub-class.");
+}
+
+template <El::Device Device>
+El::Matrix<DataType, Device>& kfac_block<Device>::get_inverse_update_target(
+  El::Matrix<DataType, Device>& inverse)
+{
+  if (!m_stage_inverse_updates) {
+    return inverse;
+  }
+  auto& staged = m_staged_inverses[&inverse];
+  if (staged.Height() != inverse.Height() ||
+      staged.Width() != inverse.Width()) {
+    staged.Resize(inverse.Height(), inverse.Width());
+  }
+  return staged;
+}
+
+template <El::Device Device>
+void kfac_block<Device>::publish_staged_inverses()
+{
+  for (auto& kv : m_staged_inverses) {
+    El::Copy(kv.second, *kv.first);
+  }
+}
+
 template class kfac_block<El::Device::CPU>;
 #ifdef LBANN_HAS_GPU
 template class kfac_block<El::Device::GPU>;
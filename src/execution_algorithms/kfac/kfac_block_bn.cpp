@@ -155,8 +155,9 @@ void kfac_block_bn<Device>::update_kronecker_average(
   kfac::unpack_lower_tri(fisher_block, m_fisher_buf, sync_info);
 
   // Update average Kronecker factors
-  if (!this->m_has_kronecker_inverse) {
+  if (!this->m_has_kronecker_average) {
     El::Copy(fisher_block, m_fisher_average);
+    this->m_has_kronecker_average = true;
   }
   auto& Fave = m_fisher_average;
   kfac::update_kronecker_average(Fave,
@@ -187,7 +188,7 @@ void kfac_block_bn<Device>::update_kronecker_inverse(
     m_fisher_inverse.Resize(Fave.Height(), Fave.Width());
   }
   // TODO: Refactoring
-  auto& Finv = m_fisher_inverse;
+  auto& Finv = this->get_inverse_update_target(m_fisher_inverse);
   auto& FLinv =
     this->get_workspace_matrix("bn_FLinv", Fave.Height(), Fave.Height());
 
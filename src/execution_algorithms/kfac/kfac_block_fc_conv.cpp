@@ -185,9 +185,10 @@ void kfac_block_fc_conv<Device>::update_kronecker_average(
   kfac::unpack_lower_tri(G, m_kronecker_factor_buf_G, sync_info);
 
   // Update average Kronecker factors
-  if (!this->m_has_kronecker_inverse) {
+  if (!this->m_has_kronecker_average) {
     El::Copy(A, m_kronecker_average_A);
     El::Copy(G, m_kronecker_average_G);
+    this->m_has_kronecker_average = true;
   }
   auto& Aave = m_kronecker_average_A;
   auto& Gave = m_kronecker_average_G;
@@ -272,8 +273,8 @@ void kfac_block_fc_conv<Device>::update_kronecker_inverse(
     m_kronecker_inverse_G.Resize(Gave.Height(), Gave.Width());
   }
   // TODO: Refactoring
-  auto& Ainv = m_kronecker_inverse_A;
-  auto& Ginv = m_kronecker_inverse_G;
+  auto& Ainv = this->get_inverse_update_target(m_kronecker_inverse_A);
+  auto& Ginv = this->get_inverse_update_target(m_kronecker_inverse_G);
   auto& ALinv =
     this->get_workspace_matrix("ALinv", Aave.Height(), Aave.Height());
   auto& GLinv =
@@ -470,7 +470,7 @@ void kfac_block_gru<Device>::update_kronecker_average(
   auto& A_x = this->get_workspace_matrix("Ax", input_size, input_size);
   kfac::unpack_lower_tri(A_h, m_kronecker_factor_buf_A_h, sync_info);
   kfac::unpack_lower_tri(A_x, m_kronecker_factor_buf_A_x, sync_info);
-  if (!this->m_has_kronecker_inverse) {
+  if (!this->m_has_kronecker_average) {
     El::Copy(A_h, m_kronecker_average_A_h);
     El::Copy(A_x, m_kronecker_average_A_x);
   }
@@ -519,7 +519,7 @@ void kfac_block_gru<Device>::update_kronecker_average(
     auto& G =
       this->get_workspace_matrix(std::string("G_") + mname, height, height);
     kfac::unpack_lower_tri(G, m_kronecker_factor_buf_G[matrix_type], sync_info);
-    if (!this->m_has_kronecker_inverse)
+    if (!this->m_has_kronecker_average)
       El::Copy(G, m_kronecker_average_G[matrix_type]);
     auto& Gave = m_kronecker_average_G[matrix_type];
     kfac::update_kronecker_average(Gave,
@@ -548,6 +548,8 @@ void kfac_block_gru<Device>::update_kronecker_average(
       std::cout << oss.str();
     }
   }
+
+  this->m_has_kronecker_average = true;
 }
 
 template <El::Device Device>
@@ -575,8 +577,8 @@ void kfac_block_gru<Device>::update_kronecker_inverse(
   if (use_pi)
     LBANN_ERROR(
       "The GRU K-FAC implementation does not currently support use_pi.");
-  auto& Ainv_h = m_kronecker_inverse_A_h;
-  auto& Ainv_x = m_kronecker_inverse_A_x;
+  auto& Ainv_h = this->get_inverse_update_target(m_kronecker_inverse_A_h);
+  auto& Ainv_x = this->get_inverse_update_target(m_kronecker_inverse_A_x);
   auto& ALinv_h =
     this->get_workspace_matrix("ALinv_h", Aave_h.Height(), Aave_h.Height());
   auto& ALinv_x =
@@ -642,7 +644,8 @@ void kfac_block_gru<Device>::update_kronecker_inverse(
     const auto& Gave = m_kronecker_average_G[matrix_type];
     if (!this->m_has_kronecker_inverse)
       m_kronecker_inverse_G[matrix_type].Resize(Gave.Height(), Gave.Width());
-    auto& Ginv = m_kronecker_inverse_G[matrix_type];
+    auto& Ginv =
+      this->get_inverse_update_target(m_kronecker_inverse_G.at(matrix_type));
     auto& GLinv = this->get_workspace_matrix(std::string("GLinv_" + mname),
                                              Gave.Height(),
                                              Gave.Height());
@@ -34,8 +34,11 @@
 #include "lbann/utils/gpu/helpers.hpp"
 #include <cassert>
 #include <core/imports/mpi.hpp>
+#include <functional>
 #include <iomanip>
 #include <iterator>
+#include <numeric>
+#include <queue>
 
 namespace lbann {
 namespace kfac {
@@ -366,6 +369,35 @@ void allreduce_lower_tri(El::AbstractMatrix<DataType>& A,
   unpack_lower_tri<Device>(A, AL, sync_info);
 }
 
+std::vector<size_t> assign_inverse_proc_ranks(const std::vector<double>& costs,
+                                              const size_t num_procs)
+{
+  if (num_procs == 0)
+    LBANN_ERROR("Cannot assign K-FAC blocks to zero processes");
+
+  std::vector<size_t> order(costs.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::stable_sort(order.begin(), order.end(), [&costs](size_t a, size_t b) {
+    return costs[a] > costs[b];
+  });
+
+  // Min-heap of (load, rank)
+  using LoadT = std::pair<double, size_t>;
+  std::priority_queue<LoadT, std::vector<LoadT>, std::greater<LoadT>> loads;
+  for (size_t rank = 0; rank < num_procs; ++rank)
+    loads.emplace(0.0, rank);
+
+  std::vector<size_t> ranks(costs.size());
+  for (const auto& i : order) {
+    auto least_loaded = loads.top();
+    loads.pop();
+    ranks[i] = least_loaded.second;
+    least_loaded.first += costs[i];
+    loads.push(least_loaded);
+  }
+  return ranks;
+}
+
 bool is_reduce_scatter_buffer_required(const kfac_reduce_scatter_mode mode)
 {
   if (mode == kfac_reduce_scatter_mode::ALLREDUCE)
@@ -0,0 +1,322 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+#include "lbann/execution_algorithms/ltfb/random_pairwise_exchange.hpp"
+
+#include "lbann/comm_impl.hpp"
+#include "lbann/models/model.hpp"
+#include "lbann/optimizers/adam.hpp"
+#include "lbann/optimizers/sgd.hpp"
+#include "lbann/utils/typename.hpp"
+#include "lbann/weights/data_type_weights.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <typeinfo>
+#include <vector>
+
+namespace lbann {
+namespace ltfb {
+namespace {
+
+/** @brief Default maximum number of entries per message. */
+constexpr size_t default_chunk_size = size_t{1} << 24;
+
+using WeightsType = data_type_weights<DataType>;
+
+/** @brief Weights that take part in the exchange, in model order. */
+std::vector<WeightsType*>
+get_exchange_weights(model& m, std::set<std::string> const& weights_names)
+{
+  std::vector<WeightsType*> weights_list;
+  for (auto* w : m.get_weights()) {
+    if (!weights_names.empty() &&
+        weights_names.find(w->get_name()) == weights_names.cend()) {
+      continue;
+    }
+    auto* dtw = dynamic_cast<WeightsType*>(w);
+    if (dtw == nullptr) {
+      LBANN_ERROR("LTFB packed weights exchange only supports weights with ",
+                  "data type ",
+                  TypeName<DataType>(),
+                  ", but weights \"",
+                  w->get_name(),
+                  "\" have data type ",
+                  w->get_datatype_name());
+    }
+    weights_list.push_back(dtw);
+  }
+  return weights_list;
+}
+
+/** @brief Local optimizer state matrices supported by the exchange. */
+std::vector<AbsMat*> get_optimizer_state(optimizer* opt)
+{
+  if (auto* sgd_opt = dynamic_cast<sgd<DataType>*>(opt)) {
+    return {&sgd_opt->get_velocity().Matrix()};
+  }
+  if (auto* adam_opt = dynamic_cast<adam<DataType>*>(opt)) {
+    return {&adam_opt->get_moment1().Matrix(),
+            &adam_opt->get_moment2().Matrix()};
+  }
+  return {};
+}
+
+/** @brief Number of scalar optimizer state entries. */
+size_t get_num_optimizer_scalars(optimizer* opt)
+{
+  // Adam's bias-correction products
+  return dynamic_cast<adam<DataType>*>(opt) != nullptr ? 2 : 0;
+}
+
+/** @brief Copy scalar optimizer state into a buffer. */
+void get_optimizer_scalars(optimizer* opt, DataType* buffer)
+{
+  if (auto* adam_opt = dynamic_cast<adam<DataType>*>(opt)) {
+    buffer[0] = adam_opt->get_current_beta1();
+    buffer[1] = adam_opt->get_current_beta2();
+  }
+}
+
+/** @brief Copy scalar optimizer state out of a buffer. */
+void set_optimizer_scalars(optimizer* opt, DataType const* buffer)
+{
+  if (auto* adam_opt = dynamic_cast<adam<DataType>*>(opt)) {
+    adam_opt->set_current_beta1(buffer[0]);
+    adam_opt->set_current_beta2(buffer[1]);
+  }
+}
+
+} // namespace
+
+PackedSendRecvWeights::PackedSendRecvWeights(
+  std::set<std::string> weights_names,
+  bool exchange_optimizer_state,
+  size_t chunk_size)
+  : BaseType(std::move(weights_names)),
+    m_exchange_optimizer_state{exchange_optimizer_state},
+    m_chunk_size{chunk_size > 0 ? chunk_size : default_chunk_size}
+{
+  // Message sizes are passed to MPI as int
+  if (m_chunk_size > static_cast<size_t>(std::numeric_limits<int>::max())) {
+    LBANN_ERROR("LTFB packed weights exchange chunk size (",
+                m_chunk_size,
+                ") exceeds the maximum MPI message size (",
+                std::numeric_limits<int>::max(),
+                ")");
+  }
+}
+
+void PackedSendRecvWeights::negotiate_optimizer_state(model& m,
+                                                      lbann_comm const& comm,
+                                                      El::Int partner_trainer)
+{
+  auto const weights_list = get_exchange_weights(m, this->weights_names());
+  m_with_optimizer_state.assign(weights_list.size(), false);
+  if (!m_exchange_optimizer_state || weights_list.empty()) {
+    return;
+  }
+
+  // Optimizer state is only exchanged if both trainers use the same
+  // optimizer type for a weights object. All type hashes are
+  // exchanged in a single message.
+  if (weights_list.size() >
+      static_cast<size_t>(std::numeric_limits<int>::max())) {
+    LBANN_ERROR("Too many weights (",
+                weights_list.size(),
+                ") for the LTFB packed weights exchange");
+  }
+  std::vector<size_t> local_hashes(weights_list.size(), 0);
+  std::vector<size_t> partner_hashes(weights_list.size(), 0);
+  for (size_t i = 0; i < weights_list.size(); ++i) {
+    auto* opt = weights_list[i]->get_optimizer();
+    if (opt != nullptr && !get_optimizer_state(opt).empty()) {
+      local_hashes[i] = typeid(*opt).hash_code();
+    }
+  }
+  comm.sendrecv(local_hashes.data(),
+                static_cast<int>(local_hashes.size()),
+                partner_trainer,
+                comm.get_rank_in_trainer(),
+                partner_hashes.data(),
+                static_cast<int>(partner_hashes.size()),
+                partner_trainer,
+                comm.get_rank_in_trainer(),
+                El::SyncInfo<El::Device::CPU>{});
+  for (size_t i = 0; i < weights_list.size(); ++i) {
+    if (local_hashes[i] != partner_hashes[i]) {
+      LBANN_WARNING("Optimizer of weights \"",
+                    weights_list[i]->get_name(),
+                    "\" differs from the partner trainer's. ",
+                    "Exchanging weights values only.");
+    }
+    m_with_optimizer_state[i] =
+      (local_hashes[i] != 0 && local_hashes[i] == partner_hashes[i]);
+  }
+}
+
+auto PackedSendRecvWeights::get_exchange_state(model& m) -> ExchangeState
+{
+  auto const weights_list = get_exchange_weights(m, this->weights_names());
+  if (weights_list.size() != m_with_optimizer_state.size()) {
+    LBANN_ERROR("Exchanged weights do not match the negotiated layout");
+  }
+  ExchangeState state;
+  for (size_t i = 0; i < weights_list.size(); ++i) {
+    auto& w = *weights_list[i];
+    state.matrices.push_back(&w.get_values_sharded().Matrix());
+    if (m_with_optimizer_state[i]) {
+      auto* opt = w.get_optimizer();
+      for (auto* mat : get_optimizer_state(opt)) {
+        state.matrices.push_back(mat);
+      }
+      state.optimizers.push_back(opt);
+    }
+  }
+  return state;
+}
+
+El::Int PackedSendRecvWeights::get_packed_size(ExchangeState const& state)
+{
+  El::Int size = 0;
+  for (auto const* mat : state.matrices) {
+    size += mat->Height() * mat->Width();
+  }
+  for (auto* opt : state.optimizers) {
+    size += get_num_optimizer_scalars(opt);
+  }
+  return size;
+}
+
+void PackedSendRecvWeights::pack(ExchangeState const& state,
+                                 BufferType& buffer)
+{
+  buffer.Resize(get_packed_size(state), 1);
+  El::Int offset = 0;
+  for (auto const* mat : state.matrices) {
+    BufferType view;
+    view.Attach(mat->Height(),
+                mat->Width(),
+                buffer.Buffer() + offset,
+                std::max(mat->Height(), El::Int{1}));
+    El::Copy(*mat, view);
+    offset += mat->Height() * mat->Width();
+  }
+  for (auto* opt : state.optimizers) {
+    get_optimizer_scalars(opt, buffer.Buffer() + offset);
+    offset += get_num_optimizer_scalars(opt);
+  }
+}
+
+void PackedSendRecvWeights::unpack(BufferType const& buffer,
+                                   ExchangeState const& state)
+{
+  const auto size = get_packed_size(state);
+  if (size != buffer.Height()) {
+    LBANN_ERROR("Received ",
+                buffer.Height(),
+                " weights entries from partner trainer, but expected ",
+                size);
+  }
+  El::Int offset = 0;
+  for (auto* mat : state.matrices) {
+    BufferType view;
+    view.LockedAttach(mat->Height(),
+                      mat->Width(),
+                      buffer.LockedBuffer() + offset,
+                      std::max(mat->Height(), El::Int{1}));
+    El::Copy(view, *mat);
+    offset += mat->Height() * mat->Width();
+  }
+  for (auto* opt : state.optimizers) {
+    set_optimizer_scalars(opt, buffer.LockedBuffer() + offset);
+    offset += get_num_optimizer_scalars(opt);
+  }
+}
+
+void PackedSendRecvWeights::start_weights_exchange(model& m,
+                                                   El::Int partner_trainer,
+                                                   size_t /*step*/)
+{
+  auto const& comm = *m.get_comm();
+  auto const rank_in_trainer = comm.get_rank_in_trainer();
+  negotiate_optimizer_state(m, comm, partner_trainer);
+
+  // The packed local values are kept as the shadow copy
+  pack(get_exchange_state(m), m_local_buffer);
+  m_partner_buffer.Resize(m_local_buffer.Height(), 1);
+  m_has_shadow = false;
+
+  // Stream the packed buffer in chunks
+  const size_t size = m_local_buffer.Height();
+  const size_t num_chunks = (size + m_chunk_size - 1) / m_chunk_size;
+  m_requests.assign(2 * num_chunks, El::mpi::Request<DataType>{});
+  for (size_t i = 0; i < num_chunks; ++i) {
+    const size_t offset = i * m_chunk_size;
+    const int count = static_cast<int>(std::min(m_chunk_size, size - offset));
+    comm.nb_recv(m_partner_buffer.Buffer() + offset,
+                 count,
+                 partner_trainer,
+                 rank_in_trainer,
+                 m_requests[2 * i]);
+    comm.nb_send(m_local_buffer.LockedBuffer() + offset,
+                 count,
+                 partner_trainer,
+                 rank_in_trainer,
+                 m_requests[2 * i + 1]);
+  }
+}
+
+void PackedSendRecvWeights::finish_weights_exchange(model& m)
+{
+  m.get_comm()->wait_all(m_requests);
+  m_requests.clear();
+  unpack(m_partner_buffer, get_exchange_state(m));
+  m_has_shadow = true;
+}
+
+void PackedSendRecvWeights::restore_local_weights(model& m)
+{
+  if (!m_has_shadow) {
+    LBANN_ERROR("No local weights values to restore");
+  }
+  unpack(m_local_buffer, get_exchange_state(m));
+  m_has_shadow = false;
+}
+
+std::unique_ptr<model>
+PackedSendRecvWeights::get_partner_model(model const& m,
+                                         El::Int partner_trainer,
+                                         size_t step)
+{
+  auto partner_model_ptr = std::make_unique<model>(m);
+  start_weights_exchange(*partner_model_ptr, partner_trainer, step);
+  finish_weights_exchange(*partner_model_ptr);
+  m_has_shadow = false;
+  return partner_model_ptr;
+}
+
+} // namespace ltfb
+} // namespace lbann
@@ -134,15 +134,39 @@ bool local_wins(EvalType local,
 
 } // namespace
 
+// ExchangeStrategy implementation
+
+void RandomPairwiseExchange::ExchangeStrategy::start_weights_exchange(
+  model& /*m*/,
+  El::Int /*partner_trainer*/,
+  size_t /*step*/)
+{
+  LBANN_ERROR("Exchange strategy does not support in-place exchange");
+}
+
+void RandomPairwiseExchange::ExchangeStrategy::finish_weights_exchange(
+  model& /*m*/)
+{
+  LBANN_ERROR("Exchange strategy does not support in-place exchange");
+}
+
+void RandomPairwiseExchange::ExchangeStrategy::restore_local_weights(
+  model& /*m*/)
+{
+  LBANN_ERROR("Exchange strategy does not support in-place exchange");
+}
+
 // RandomPairwiseExchange implementation
 
 RandomPairwiseExchange::RandomPairwiseExchange(
   std::unordered_map<std::string, metric_strategy> metrics,
   std::unique_ptr<ExchangeStrategy> comm_algo,
-  std::unique_ptr<MutationStrategy> mutate_algo)
+  std::unique_ptr<MutationStrategy> mutate_algo,
+  bool paired_evaluation)
   : m_metrics{std::move(metrics)},
     m_comm_algo{std::move(comm_algo)},
-    m_mutate_algo{std::move(mutate_algo)}
+    m_mutate_algo{std::move(mutate_algo)},
+    m_paired_evaluation{paired_evaluation}
 {
   LBANN_ASSERT(m_metrics.size());
 }
@@ -151,23 +175,34 @@ RandomPairwiseExchange::RandomPairwiseExchange(
   std::string metric_name,
   metric_strategy winner_strategy,
   std::unique_ptr<ExchangeStrategy> comm_algo,
-  std::unique_ptr<MutationStrategy> mutate_algo)
+  std::unique_ptr<MutationStrategy> mutate_algo,
+  bool paired_evaluation)
   : RandomPairwiseExchange({{metric_name, winner_strategy}},
                            std::move(comm_algo),
-                           std::move(mutate_algo))
+                           std::move(mutate_algo),
+                           paired_evaluation)
 {}
 
 RandomPairwiseExchange::RandomPairwiseExchange(
   RandomPairwiseExchange const& other)
   : m_metrics{other.m_metrics},
     m_comm_algo{other.m_comm_algo->clone()},
-    m_mutate_algo{other.m_mutate_algo->clone()}
+    m_mutate_algo{other.m_mutate_algo->clone()},
+    m_paired_evaluation{other.m_paired_evaluation}
 {}
 
 std::unordered_map<std::string, EvalType>
 RandomPairwiseExchange::evaluate_model(model& m,
                                        LTFBExecutionContext& ctxt,
                                        data_coordinator& dc) const
+{
+  return evaluate_models({&m}, ctxt, dc).front();
+}
+
+std::vector<std::unordered_map<std::string, EvalType>>
+RandomPairwiseExchange::evaluate_models(std::vector<model*> const& models,
+                                        LTFBExecutionContext& ctxt,
+                                        data_coordinator& dc) const
 {
   // Make sure data readers finish asynchronous work
   const auto original_mode = ctxt.get_execution_mode();
@@ -183,35 +218,41 @@ RandomPairwiseExchange::evaluate_model(model& m,
   // for the current use of the tournament
   dc.mark_data_store_explicitly_loading(execution_mode::tournament);
 
-  // Evaluate model on validation set
-  get_trainer().evaluate(&m, execution_mode::tournament);
+  // Evaluate models on validation set
+  get_trainer().evaluate(models, execution_mode::tournament);
 
   // Get metric values
-  std::unordered_map<std::string, EvalType> metric_values;
-  for (const auto& met : m.get_metrics()) {
-    auto const& metric_name = met->name();
-    if (m_metrics.count(metric_name)) {
-      metric_values[metric_name] =
-        met->get_mean_value(execution_mode::tournament);
+  std::vector<std::unordered_map<std::string, EvalType>> all_metric_values;
+  for (auto* m : models) {
+    std::unordered_map<std::string, EvalType> metric_values;
+    for (const auto& met : m->get_metrics()) {
+      auto const& metric_name = met->name();
+      if (m_metrics.count(metric_name)) {
+        metric_values[metric_name] =
+          met->get_mean_value(execution_mode::tournament);
+      }
     }
-  }
-  if (metric_values.size() != m_metrics.size()) {
-    auto missing = set_diff(keys(m_metrics), keys(metric_values));
-    LBANN_ERROR("Could not find metrics \"",
-                stringify(missing),
-                "\" in model \"",
-                m.get_name(),
-                "\"");
+    if (metric_values.size() != m_metrics.size()) {
+      auto missing = set_diff(keys(m_metrics), keys(metric_values));
+      LBANN_ERROR("Could not find metrics \"",
+                  stringify(missing),
+                  "\" in model \"",
+                  m->get_name(),
+                  "\"");
+    }
+    all_metric_values.emplace_back(std::move(metric_values));
   }
 
   // Mark the data store as loaded - Note that this is a temporary fix
   // for the current use of the tournament
   dc.make_data_store_preloaded(execution_mode::tournament);
 
-  // Clean up and return metric value
-  m.reset_mode(ctxt, original_mode);
+  // Clean up and return metric values
+  for (auto* m : models) {
+    m->reset_mode(ctxt, original_mode);
+  }
   dc.reset_mode(ctxt);
-  return metric_values;
+  return all_metric_values;
 }
 
 int RandomPairwiseExchange::get_partner_trainer(
@@ -306,31 +347,85 @@ void RandomPairwiseExchange::select_next(model& m,
   int const local_trainer = comm.get_trainer_rank();
   int const partner_trainer = get_partner_trainer(comm);
 
-  LBANN_LOG_WORLD_MASTER(comm, message_prefix, "evaluating local model...");
+  std::unordered_map<std::string, EvalType> local_scores, partner_scores;
+  int tournament_winner = local_trainer;
+  if (m_paired_evaluation) {
+    // Evaluate both models in a single pass over the tournament data
+    LBANN_LOG_WORLD_MASTER(comm, message_prefix, "exchanging model data...");
 
-  auto const local_scores = evaluate_model(m, ctxt, dc);
+    auto partner_model =
+      m_comm_algo->get_partner_model(m, partner_trainer, ctxt.get_step());
 
-  LBANN_LOG_WORLD_MASTER(comm, message_prefix, "exchanging model data...");
+    LBANN_LOG_WORLD_MASTER(comm,
+                           message_prefix,
+                           "evaluating local and partner models...");
+
+    auto scores = evaluate_models({&m, partner_model.get()}, ctxt, dc);
+    local_scores = std::move(scores[0]);
+    partner_scores = std::move(scores[1]);
+    tournament_winner =
+      (local_is_better(local_scores, partner_scores) ? local_trainer
+                                                     : partner_trainer);
+    if (tournament_winner == partner_trainer) {
+      m = std::move(*partner_model);
+    }
+  }
+  else if (m_comm_algo->supports_in_place_exchange()) {
+    // Evaluate the partner weights inside the local model. This
+    // avoids copying the model. The weights transfer is overlapped
+    // with the local evaluation, and the local weights are restored
+    // if we win.
+    LBANN_LOG_WORLD_MASTER(comm, message_prefix, "exchanging model data...");
 
-  // The "local_model" is passed in here to accommodate the
-  // "sendrecv_weights" strategy; other than that, I don't think it
-  // should be necessary.
-  auto partner_model =
-    m_comm_algo->get_partner_model(m, partner_trainer, ctxt.get_step());
+    m_comm_algo->start_weights_exchange(m, partner_trainer, step);
 
-  LBANN_LOG_WORLD_MASTER(comm, message_prefix, "evaluating partner model...");
+    LBANN_LOG_WORLD_MASTER(comm, message_prefix, "evaluating local model...");
 
-  auto const partner_scores = evaluate_model(*partner_model, ctxt, dc);
+    local_scores = evaluate_model(m, ctxt, dc);
+    m_comm_algo->finish_weights_exchange(m);
 
-  // If we win, we do nothing. The input model is the winner, so no
-  // further action is required. Otherwise, swap models.
-  int const tournament_winner =
-    (local_is_better(local_scores, partner_scores) ? local_trainer
-                                                   : partner_trainer);
+    LBANN_LOG_WORLD_MASTER(comm,
+                           message_prefix,
+                           "evaluating partner model...");
+
+    partner_scores = evaluate_model(m, ctxt, dc);
+    tournament_winner =
+      (local_is_better(local_scores, partner_scores) ? local_trainer
+                                                     : partner_trainer);
+    if (tournament_winner == local_trainer) {
+      m_comm_algo->restore_local_weights(m);
+    }
+  }
+  else {
+    LBANN_LOG_WORLD_MASTER(comm, message_prefix, "evaluating local model...");
 
-  if (tournament_winner == partner_trainer) {
-    m = std::move(*partner_model);
+    local_scores = evaluate_model(m, ctxt, dc);
+
+    LBANN_LOG_WORLD_MASTER(comm, message_prefix, "exchanging model data...");
+
+    // The "local_model" is passed in here to accommodate the
+    // "sendrecv_weights" strategy; other than that, I don't think it
+    // should be necessary.
+    auto partner_model =
+      m_comm_algo->get_partner_model(m, partner_trainer, ctxt.get_step());
+
+    LBANN_LOG_WORLD_MASTER(comm,
+                           message_prefix,
+                           "evaluating partner model...");
 
+    partner_scores = evaluate_model(*partner_model, ctxt, dc);
+
+    // If we win, we do nothing. The input model is the winner, so no
+    // further action is required. Otherwise, swap models.
+    tournament_winner =
+      (local_is_better(local_scores, partner_scores) ? local_trainer
+                                                     : partner_trainer);
+    if (tournament_winner == partner_trainer) {
+      m = std::move(*partner_model);
+    }
+  }
+
+  if (tournament_winner == partner_trainer) {
     // Winning model mutates according to mutation strategy
     m_mutate_algo->mutate(m, step);
 
@@ -420,12 +515,27 @@ to_lbann(lbann_data::RandomPairwiseExchange::MetricStrategy strategy)
   return LBANNEnumType::LOWER_IS_BETTER;
 }
 
+std::unique_ptr<lbann::ltfb::PackedSendRecvWeights>
+make_packed_sendrecv_weights(std::set<std::string> weights_names,
+                             google::protobuf::Message const& msg)
+{
+  using PackedSendRecvWeights =
+    lbann_data::RandomPairwiseExchange::ExchangeStrategy::PackedSendRecvWeights;
+  auto const& params = dynamic_cast<PackedSendRecvWeights const&>(msg);
+  return std::make_unique<lbann::ltfb::PackedSendRecvWeights>(
+    std::move(weights_names),
+    params.exchange_optimizer_state(),
+    params.chunk_size());
+}
+
 ExchangeStrategyFactory build_default_exchange_factory()
 {
   ExchangeStrategyFactory factory;
   factory.register_builder("CheckpointBinary", make_checkpoint_binary);
   factory.register_builder("CheckpointFile", make_checkpoint_file);
   factory.register_builder("SendRecvWeights", make_sendrecv_weights);
+  factory.register_builder("PackedSendRecvWeights",
+                           make_packed_sendrecv_weights);
   return factory;
 }
 
@@ -489,5 +599,6 @@ lbann::make<lbann::ltfb::RandomPairwiseExchange>(
   return std::make_unique<lbann::ltfb::RandomPairwiseExchange>(
     std::move(metric_map),
     make_abstract<ExchangeStrategyType>(msg.exchange_strategy()),
-    make_abstract<MutationStrategyType>(msg.mutation_strategy()));
+    make_abstract<MutationStrategyType>(msg.mutation_strategy()),
+    msg.paired_evaluation());
 }
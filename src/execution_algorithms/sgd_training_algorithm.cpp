@@ -314,6 +314,16 @@ void SGDTrainingAlgorithm::evaluate(SGDExecutionContext& c,
                                     data_coordinator& dc,
                                     execution_mode mode,
                                     SGDTerminationCriteria const& term)
+{
+  evaluate(c, std::vector<observer_ptr<lbann::model>>{&model}, dc, mode, term);
+}
+
+void SGDTrainingAlgorithm::evaluate(
+  SGDExecutionContext& c,
+  std::vector<observer_ptr<model>> const& models,
+  data_coordinator& dc,
+  execution_mode mode,
+  SGDTerminationCriteria const& term)
 {
   ScopeTimer eval_timer{m_timers,
                         build_string("evaluate(", to_string(mode), ")")};
@@ -323,8 +333,10 @@ void SGDTrainingAlgorithm::evaluate(SGDExecutionContext& c,
   /// valid mode, the state of the data coordinator is not
   /// consistent.  Fix this once the data coordinator is fully
   /// decoupled from the input layer.
-  model.reset_epoch_statistics(mode);
-  model.reset_mode(c, mode);
+  for (auto* m : models) {
+    m->reset_epoch_statistics(mode);
+    m->reset_mode(c, mode);
+  }
   // Ensure that the data coordinator has the right execution context
   dc.reset_mode(c);
   // Return early if execution mode is invalid
@@ -336,40 +348,51 @@ void SGDTrainingAlgorithm::evaluate(SGDExecutionContext& c,
   }
 
   // Evaluate on all mini-batches
-  do_evaluate_begin_cbs(model,
-                        mode,
-                        ScopeTimer{eval_timer, "eval_begin callbacks"});
+  for (auto* m : models) {
+    do_evaluate_begin_cbs(*m,
+                          mode,
+                          ScopeTimer{eval_timer, "eval_begin callbacks"});
+  }
   LBANN_CALIPER_LOOP_BEGIN(eval_batch, loop_label(mode));
   if (get_trainer().background_io_activity_allowed()) {
     // Fetch the first step in an evaluation
     dc.fetch_active_batch_synchronous(mode);
     El::Int current_mini_batch_size = dc.get_current_mini_batch_size(mode);
-    model.set_current_mini_batch_size(current_mini_batch_size);
+    for (auto* m : models) {
+      m->set_current_mini_batch_size(current_mini_batch_size);
+    }
   }
   while (!term(c)) {
     LBANN_CALIPER_LOOP_ITER(eval_batch, c.get_step());
     if (evaluate_mini_batch(c,
-                            model,
+                            models,
                             dc,
                             mode,
                             ScopeTimer{eval_timer, "eval minibatch"}))
       c.inc_epoch();
   }
   LBANN_CALIPER_LOOP_END(eval_batch);
-  do_evaluate_end_cbs(model,
-                      mode,
-                      ScopeTimer{eval_timer, "eval_end callbacks"});
+  for (auto* m : models) {
+    do_evaluate_end_cbs(*m,
+                        mode,
+                        ScopeTimer{eval_timer, "eval_end callbacks"});
+  }
 }
 
-bool SGDTrainingAlgorithm::evaluate_mini_batch(SGDExecutionContext& c,
-                                               model& model,
-                                               data_coordinator& dc,
-                                               execution_mode mode,
-                                               ScopeTimer timer)
+bool SGDTrainingAlgorithm::evaluate_mini_batch(
+  SGDExecutionContext& c,
+  std::vector<observer_ptr<model>> const& models,
+  data_coordinator& dc,
+  execution_mode mode,
+  ScopeTimer timer)
 {
-  model.reset_mode(c, mode);
+  for (auto* m : models) {
+    m->reset_mode(c, mode);
+  }
   dc.reset_mode(c);
-  do_batch_begin_cbs(model, mode, ScopeTimer{timer, "batch_begin callbacks"});
+  for (auto* m : models) {
+    do_batch_begin_cbs(*m, mode, ScopeTimer{timer, "batch_begin callbacks"});
+  }
   if (get_trainer().background_io_activity_allowed()) {
     dc.fetch_data_asynchronous(mode);
   }
@@ -377,18 +400,25 @@ bool SGDTrainingAlgorithm::evaluate_mini_batch(SGDExecutionContext& c,
     dc.fetch_active_batch_synchronous(mode);
   }
   El::Int current_mini_batch_size = dc.get_current_mini_batch_size(mode);
-  model.set_current_mini_batch_size(current_mini_batch_size);
-  model.forward_prop(mode);
+  // The mini-batch is loaded once and shared by every model
+  for (auto* m : models) {
+    m->set_current_mini_batch_size(current_mini_batch_size);
+    m->forward_prop(mode);
+  }
   bool const finished = dc.ready_for_next_fetch(mode);
 
-  model.get_objective_function()->start_evaluation(mode,
+  for (auto* m : models) {
+    m->get_objective_function()->start_evaluation(mode,
+                                                  current_mini_batch_size);
+    m->get_objective_function()->finish_evaluation(mode,
                                                    current_mini_batch_size);
-  model.get_objective_function()->finish_evaluation(mode,
-                                                    current_mini_batch_size);
-  model.evaluate_metrics(mode, current_mini_batch_size);
-  model.update_layers();
+    m->evaluate_metrics(mode, current_mini_batch_size);
+    m->update_layers();
+  }
   c.inc_step();
-  do_batch_end_cbs(model, mode, ScopeTimer{timer, "batch_end callbacks"});
+  for (auto* m : models) {
+    do_batch_end_cbs(*m, mode, ScopeTimer{timer, "batch_end callbacks"});
+  }
   return finished;
 }
 
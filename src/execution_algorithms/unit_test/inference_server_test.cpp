@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Catch2BasicSupport.hpp"
+
+#include "MPITestHelpers.hpp"
+#include "TestHelpers.hpp"
+
+#include <lbann/base.hpp>
+#include <lbann/execution_algorithms/inference_server.hpp>
+#include <lbann/models/model.hpp>
+#include <lbann/utils/lbann_library.hpp>
+
+#include "lbann/proto/lbann.pb.h"
+#include <google/protobuf/text_format.h>
+
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <vector>
+
+namespace pb = ::google::protobuf;
+
+namespace {
+// Input layer into a softmax layer
+std::string const model_prototext = R"ptext(
+model {
+  layer {
+    name: "layer1"
+    children: "layer2"
+    input {
+      data_field: "samples"
+    }
+  }
+  layer {
+    name: "layer2"
+    parents: "layer1"
+    softmax {
+    }
+  }
+}
+)ptext";
+
+auto make_model(lbann::lbann_comm& comm, int num_classes, int mbs)
+{
+  lbann_data::LbannPB my_proto;
+  if (!pb::TextFormat::ParseFromString(model_prototext, &my_proto))
+    throw "Parsing protobuf failed.";
+  // Construct a trainer so that the model can register the input layer
+  auto& trainer =
+    lbann::construct_trainer(&comm, my_proto.mutable_trainer(), my_proto);
+  unit_test::utilities::mock_data_reader(trainer,
+                                         {1, 1, num_classes},
+                                         num_classes);
+  auto my_model = lbann::proto::construct_model(&comm,
+                                                my_proto.optimizer(),
+                                                my_proto.trainer(),
+                                                my_proto.model());
+  my_model->setup(mbs, {&comm.get_trainer_grid()});
+  return my_model;
+}
+
+std::vector<float> softmax(std::vector<float> const& x)
+{
+  std::vector<float> y(x.size());
+  double sum = 0.;
+  for (size_t i = 0; i < x.size(); ++i) {
+    y[i] = std::exp(x[i]);
+    sum += y[i];
+  }
+  for (auto& val : y) {
+    val /= sum;
+  }
+  return y;
+}
+
+} // namespace
+
+TEST_CASE("Inference server", "[mpi][inference]")
+{
+  using namespace std::chrono_literals;
+  constexpr int num_classes = 4;
+  constexpr int max_batch_size = 4;
+
+  auto& comm = unit_test::utilities::current_world_comm();
+  auto model = make_model(comm, num_classes, max_batch_size);
+
+  if (comm.get_procs_per_trainer() != 1) {
+    REQUIRE_THROWS(
+      lbann::inference_server(model.get(), max_batch_size, 1000us));
+    return;
+  }
+
+  SECTION("Invalid configurations")
+  {
+    REQUIRE_THROWS(lbann::inference_server(model.get(), 0, 1000us));
+    REQUIRE_THROWS(
+      lbann::inference_server(model.get(), 2 * max_batch_size, 1000us));
+    REQUIRE_THROWS(
+      lbann::inference_server(model.get(), max_batch_size, 1000us, "foo"));
+  }
+
+  SECTION("Requests are batched and answered")
+  {
+    constexpr int num_requests = 10;
+    lbann::inference_server server(model.get(), max_batch_size, 100ms);
+    REQUIRE(server.get_sample_size() == num_classes);
+    REQUIRE(server.get_output_size() == num_classes);
+    REQUIRE_THROWS(server.submit(std::vector<float>(num_classes + 1, 0.f)));
+
+    std::vector<std::vector<float>> samples;
+    std::vector<std::future<std::vector<float>>> results;
+    for (int i = 0; i < num_requests; ++i) {
+      std::vector<float> sample(num_classes);
+      for (int j = 0; j < num_classes; ++j) {
+        sample[j] = 0.25f * ((i + j) % num_classes) - 0.1f * i;
+      }
+      results.emplace_back(server.submit(sample));
+      samples.emplace_back(std::move(sample));
+    }
+
+    for (int i = 0; i < num_requests; ++i) {
+      auto const outputs = results[i].get();
+      auto const expected = softmax(samples[i]);
+      REQUIRE(outputs.size() == expected.size());
+      for (size_t j = 0; j < expected.size(); ++j) {
+        CHECK(outputs[j] == Approx(expected[j]));
+      }
+    }
+
+    server.stop();
+    auto const stats = server.get_statistics();
+    CHECK(stats.num_requests == num_requests);
+    CHECK(stats.num_batches >= (num_requests + max_batch_size - 1) /
+                                 max_batch_size);
+    CHECK(stats.num_batches <= num_requests);
+    REQUIRE_THROWS(server.submit(std::vector<float>(num_classes, 0.f)));
+  }
+
+  SECTION("A lone request is answered after the max delay")
+  {
+    lbann::inference_server server(model.get(), max_batch_size, 1ms);
+    auto result = server.submit(std::vector<float>(num_classes, 1.f));
+    REQUIRE(result.wait_for(10s) == std::future_status::ready);
+    for (auto const& val : result.get()) {
+      CHECK(val == Approx(1.f / num_classes));
+    }
+  }
+}
@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+#include "Catch2BasicSupport.hpp"
+
+#include "lbann/execution_algorithms/kfac/kfac_util.hpp"
+#include "lbann/utils/exception.hpp"
+
+#include <vector>
+
+using lbann::kfac::assign_inverse_proc_ranks;
+
+TEST_CASE("K-FAC inverse placement", "[kfac][algorithm]")
+{
+  SECTION("Longest blocks are placed first on the least loaded rank")
+  {
+    std::vector<double> const costs = {7., 5., 4., 3., 2.};
+    std::vector<size_t> const expected = {0, 1, 1, 0, 1};
+    CHECK(assign_inverse_proc_ranks(costs, 2) == expected);
+  }
+
+  SECTION("Ties are broken by block index")
+  {
+    std::vector<double> const costs = {1., 1., 1., 1.};
+    std::vector<size_t> const expected = {0, 1, 0, 1};
+    CHECK(assign_inverse_proc_ranks(costs, 2) == expected);
+  }
+
+  SECTION("A dominant block gets a rank to itself")
+  {
+    std::vector<double> const costs = {lbann::kfac::get_inverse_cost(64),
+                                       lbann::kfac::get_inverse_cost(16384),
+                                       lbann::kfac::get_inverse_cost(512),
+                                       lbann::kfac::get_inverse_cost(4096),
+                                       lbann::kfac::get_inverse_cost(1024)};
+    auto const ranks = assign_inverse_proc_ranks(costs, 3);
+    REQUIRE(ranks.size() == costs.size());
+    for (size_t i = 0; i < ranks.size(); ++i) {
+      if (i != 1)
+        CHECK(ranks[i] != ranks[1]);
+    }
+  }
+
+  SECTION("More ranks than blocks")
+  {
+    std::vector<double> const costs = {1., 8., 2.};
+    std::vector<size_t> const expected = {2, 0, 1};
+    CHECK(assign_inverse_proc_ranks(costs, 4) == expected);
+  }
+
+  SECTION("No blocks")
+  {
+    CHECK(assign_inverse_proc_ranks({}, 4).empty());
+  }
+
+  SECTION("Zero ranks is an error")
+  {
+    CHECK_THROWS_AS(assign_inverse_proc_ranks({1.}, 0), lbann::exception);
+  }
+}
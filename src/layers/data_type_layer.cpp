@@ -81,6 +81,10 @@ data_type_layer<InputTensorDataType, OutputTensorDataType>::operator=(
   m_gradient_wrt_outputs = copy_all(other.m_gradient_wrt_outputs);
   m_gradient_wrt_inputs = copy_all(other.m_gradient_wrt_inputs);
   m_persistent_error_signals = other.m_persistent_error_signals;
+
+  // Buffer aliases refer to the other layer's neighbors
+  m_output_aliases.clear();
+  m_aliased_output_ready = false;
   return *this;
 }
 
@@ -221,6 +225,11 @@ void data_type_layer<InputTensorDataType, OutputTensorDataType>::forward_prop()
     get_distconv_adapter().fp_setup();
 #endif // LBANN_HAS_DISTCONV
 
+  // Complete non-blocking gathers of sharded weights
+  for (size_t i = 0; i < this->num_weights(); ++i) {
+    this->get_weights(i).wait_for_full_weights();
+  }
+
   // Apply layer's compute function
   if (this->is_participating())
   {
@@ -246,11 +255,24 @@ void data_type_layer<InputTensorDataType, OutputTensorDataType>::forward_prop()
   if (m != nullptr) {
     auto& refcnt = m->get_activation_reference_counter();
     auto bpreqs = this->get_backprop_requirements();
+    if (m->is_forward_only()) {
+      // Only layers without children keep their inputs, so that the
+      // model's outputs can be read after forward prop. Other layers
+      // whose outputs are read must ask to keep them.
+      bpreqs = (this->get_num_children() == 0 ? PREV_ACTIVATIONS : 0);
+      if (this->keeps_activations()) {
+        bpreqs |= ACTIVATIONS;
+      }
+    }
 
     // If activations are owned and not necessary for backprop, release owned
     // activation memory (the next layer will also release its previous
-    // activations later).
-    if (this->owns_activations() && !(bpreqs & ACTIVATIONS)) {
+    // activations later). In-place layers hold an extra reference to their
+    // parent's activations, which forward-only models also release.
+    const bool release_outputs =
+      this->owns_activations() ||
+      (m->is_forward_only() && this->runs_inplace() && !distconv_enabled());
+    if (release_outputs && !(bpreqs & ACTIVATIONS)) {
       for (size_t i = 0; i < m_outputs.size(); ++i) {
         modify_reference_counter(refcnt, this->get_activations(i), false);
       }
@@ -288,6 +310,67 @@ void data_type_layer<InputTensorDataType, OutputTensorDataType>::
   this->m_activations_created = true;
 }
 
+template <typename InputTensorDataType, typename OutputTensorDataType>
+void data_type_layer<InputTensorDataType, OutputTensorDataType>::
+  set_output_alias(int child_index,
+                   data_type_layer<OutputTensorDataType>* owner,
+                   El::Int row_offset)
+{
+  if (child_index < 0 || child_index >= get_num_children()) {
+    LBANN_ERROR("attempted to alias output tensor ",
+                child_index,
+                " of layer \"",
+                get_name(),
+                "\", which has ",
+                get_num_children(),
+                " output tensors");
+  }
+  m_output_aliases.resize(get_num_children(), {nullptr, 0});
+  m_output_aliases[child_index] = {owner, row_offset};
+
+  // Stop viewing a previously aliased buffer
+  auto& output = get_activations(child_index);
+  if (owner == nullptr && output.Viewing()) {
+    output.Empty(false);
+  }
+}
+
+template <typename InputTensorDataType, typename OutputTensorDataType>
+auto data_type_layer<InputTensorDataType, OutputTensorDataType>::
+  get_aliased_output(El::Int mini_batch_size, El::DistData const& alignment)
+    -> OutputAbsDistMatrixType&
+{
+  auto& output = get_activations();
+  if (!m_aliased_output_ready) {
+    output.Empty(false);
+    output.AlignWith(alignment);
+    output.Resize(get_output_size(), mini_batch_size);
+    this->setup_reference_counter(output);
+    m_aliased_output_ready = true;
+  }
+
+  // The requesting layer holds a reference until it releases its
+  // output tensor
+  model* m = this->get_model();
+  if (m != nullptr) {
+    auto& refcnt = m->get_activation_reference_counter();
+    modify_reference_counter(refcnt, output, true);
+  }
+  return output;
+}
+
+template <typename InputTensorDataType, typename OutputTensorDataType>
+bool data_type_layer<InputTensorDataType,
+                     OutputTensorDataType>::fp_setup_aliased_output()
+{
+  if (!m_aliased_output_ready) {
+    return false;
+  }
+  m_aliased_output_ready = false;
+  m_activations_created = true;
+  return true;
+}
+
 template <typename InputTensorDataType, typename OutputTensorDataType>
 void data_type_layer<InputTensorDataType,
                      OutputTensorDataType>::back_prop_impl_()
@@ -323,6 +406,11 @@ void data_type_layer<InputTensorDataType,
     get_distconv_adapter().bp_setup();
 #endif // LBANN_HAS_DISTCONV
 
+  // Complete non-blocking gathers of sharded weights
+  for (size_t i = 0; i < this->num_weights(); ++i) {
+    this->get_weights(i).wait_for_full_weights();
+  }
+
   // Backprop the compute function.
   if (this->is_participating())
   {
@@ -1010,6 +1098,8 @@ void data_type_layer<InputTensorDataType, OutputTensorDataType>::setup_matrices(
   m_gradient_wrt_inputs.clear();
   m_temp_grad.clear();
   m_subgrid_tensors_split.clear();
+  m_output_aliases.assign(get_num_children(), {nullptr, 0});
+  m_aliased_output_ready = false;
 
   // Construct matrices
   m_inputs.resize(get_num_parents());
@@ -1042,6 +1132,16 @@ void data_type_layer<InputTensorDataType, OutputTensorDataType>::setup_matrices(
     this->do_setup_matrices_simple(*grids[tag]);
   }
 
+  // Forward-only models never compute error signals
+  if (this->get_model()->is_forward_only()) {
+    for (auto& grad_wrt_output : m_gradient_wrt_outputs) {
+      grad_wrt_output.reset();
+    }
+    for (auto& grad_wrt_input : m_gradient_wrt_inputs) {
+      grad_wrt_input.reset();
+    }
+  }
+
 #ifdef LBANN_HAS_GPU
   // Use GPU memory pool for forward prop matrices to support de/reallocation
   // upon end of use
@@ -1151,6 +1251,11 @@ void data_type_layer<InputTensorDataType, OutputTensorDataType>::check_setup()
       LBANN_ERROR(err.str());
     }
   }
+  model const* m = this->get_model();
+  if (m != nullptr && m->is_forward_only()) {
+    // Error signals are not constructed
+    return;
+  }
   for (int i = 0; i < num_children; ++i) {
     if (!m_gradient_wrt_outputs[i]) {
       err << "layer \"" << get_name() << "\" has an "
@@ -1228,6 +1333,21 @@ void data_type_layer<InputTensorDataType,
       continue;
 #endif // LBANN_HAS_DISTCONV
     auto& output = get_activations(i);
+
+    // Write directly into rows of a child layer's output
+    if (static_cast<size_t>(i) < m_output_aliases.size() &&
+        m_output_aliases[i].first != nullptr) {
+      auto& [owner, row_offset] = m_output_aliases[i];
+      auto& buffer = owner->get_aliased_output(mini_batch_size, alignment_dist);
+      output.Empty(false);
+      El::View(output,
+               buffer,
+               El::IR(row_offset, row_offset + get_output_size(i)),
+               El::ALL);
+      m_activations_created = true;
+      continue;
+    }
+
     if (output.Viewing()) {
       LBANN_ERROR(get_name(),
                   " fp_setup_outputs should be overridden",
@@ -73,6 +73,7 @@ Layer::Layer(const Layer& other)
     m_update_time(other.m_update_time),
     m_name(other.m_name),
     m_runs_inplace(other.m_runs_inplace),
+    m_keep_activations(other.m_keep_activations),
     m_parent_layers(other.m_parent_layers),
     m_child_layers(other.m_child_layers),
     m_weights(other.m_weights),
@@ -100,6 +101,7 @@ Layer& Layer::operator=(const Layer& other)
   m_output_dims_list = other.m_output_dims_list;
   m_hint_layer = other.m_hint_layer;
   m_runs_inplace = other.m_runs_inplace;
+  m_keep_activations = other.m_keep_activations;
 
   return *this;
 }
@@ -622,12 +624,12 @@ void Layer::setup_pointers()
 
     if (can_run_inplace) {
       // If any of the parents needs its output activations for
-      // backprop, this layer cannot run in-place.
+      // backprop or keeps them, this layer cannot run in-place.
       for (int i = 0; i < get_num_parents(); ++i) {
         const auto& parent = get_parent_layer(i);
 
         int bp_requirements = parent.get_backprop_requirements();
-        if (bp_requirements & ACTIVATIONS) {
+        if ((bp_requirements & ACTIVATIONS) || parent.keeps_activations()) {
           can_run_inplace = false;
           break;
         }
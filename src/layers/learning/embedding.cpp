@@ -41,9 +41,19 @@ void embedding_layer<TensorDataType, Layout, Device>::fp_compute()
   const auto& local_input =
     dynamic_cast<const MatType&>(this->get_local_prev_activations());
   auto& local_output = dynamic_cast<MatType&>(this->get_local_activations());
-  const size_t input_size = this->get_input_size();
+  const size_t input_size = this->get_active_input_size();
   const size_t local_mini_batch_size = local_input.Width();
 
+  // Entries past the effective sequence length are padding
+  if (input_size < this->get_input_size()) {
+    MatType padding_v;
+    El::View(padding_v,
+             local_output,
+             El::IR(input_size * m_embedding_dim, El::END),
+             El::ALL);
+    El::Zero(padding_v);
+  }
+
   // Populate output matrix with values from embedding matrix
   MatType embedding_v, output_v;
   for (size_t j = 0; j < local_mini_batch_size; ++j) {
@@ -90,7 +100,7 @@ void embedding_layer<TensorDataType, Layout, Device>::bp_compute()
     opt.get_gradient_buffer(dst_scale, gradient_scale, true);
   auto& local_embedding_grad = dynamic_cast<MatType&>(embeddings_grad.Matrix());
 
-  const size_t input_size = this->get_input_size();
+  const size_t input_size = this->get_active_input_size();
   const size_t local_mini_batch_size = local_input.Width();
 
   // Update gradient w.r.t. embeddings
@@ -127,9 +127,19 @@ void embedding_layer<TensorDataType, T_layout, Dev>::fp_compute()
   const auto& local_input =
     dynamic_cast<const MatType&>(this->get_local_prev_activations());
   auto& local_output = dynamic_cast<MatType&>(this->get_local_activations());
-  const auto& input_size = this->get_input_size();
+  const size_t input_size = this->get_active_input_size();
   const auto& local_mini_batch_size = local_input.Width();
 
+  // Entries past the effective sequence length are padding
+  if (input_size < this->get_input_size()) {
+    MatType padding_v;
+    El::View(padding_v,
+             local_output,
+             El::IR(input_size * this->m_embedding_dim, El::END),
+             El::ALL);
+    El::Zero(padding_v);
+  }
+
   // Launch GPU kernel
   if (!local_input.IsEmpty()) {
     auto multisync = El::MakeMultiSync(gpu::get_sync_info(local_output),
@@ -184,7 +194,7 @@ void embedding_layer<TensorDataType, T_layout, Dev>::bp_compute()
     opt.get_gradient_buffer(dst_scale, gradient_scale, true);
   auto& local_embedding_grad = dynamic_cast<MatType&>(embeddings_grad.Matrix());
 
-  const auto& input_size = this->get_input_size();
+  const size_t input_size = this->get_active_input_size();
   const auto& local_mini_batch_size = local_input.Width();
 
   // Launch GPU kernel
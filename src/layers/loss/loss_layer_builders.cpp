@@ -32,6 +32,7 @@
 #include "lbann/layers/loss/l2_norm2.hpp"
 #include "lbann/layers/loss/mean_absolute_error.hpp"
 #include "lbann/layers/loss/mean_squared_error.hpp"
+#include "lbann/layers/loss/softmax_cross_entropy.hpp"
 #include "lbann/layers/loss/top_k_categorical_accuracy.hpp"
 
 #include "lbann/proto/layers.pb.h"
@@ -85,6 +86,32 @@ lbann::build_mean_squared_error_layer_from_pbuf(lbann_comm* comm,
   return std::make_unique<mean_squared_error_layer<T, L, D>>(comm);
 }
 
+template <typename T, lbann::data_layout L, El::Device D>
+std::unique_ptr<lbann::Layer>
+lbann::build_softmax_cross_entropy_layer_from_pbuf(
+  lbann_comm* comm,
+  lbann_data::Layer const& proto_layer)
+{
+  if constexpr (L == data_layout::DATA_PARALLEL && D == El::Device::CPU) {
+    const auto& params = proto_layer.softmax_cross_entropy();
+    const El::Int ignore_index =
+      (params.has_ignore_index() ? params.ignore_index().value() : -1);
+    using LayerType = softmax_cross_entropy_layer<T,
+                                                  data_layout::DATA_PARALLEL,
+                                                  El::Device::CPU>;
+    return std::make_unique<LayerType>(comm,
+                                       params.vocab_chunk_size(),
+                                       ignore_index);
+  }
+  else {
+    (void)comm;
+    (void)proto_layer;
+    LBANN_ERROR("softmax cross entropy layer is only supported with a "
+                "data-parallel layout and on CPU");
+    return nullptr;
+  }
+}
+
 template <typename T, lbann::data_layout L, El::Device D>
 std::unique_ptr<lbann::Layer>
 lbann::build_top_k_categorical_accuracy_layer_from_pbuf(
@@ -106,6 +133,7 @@ namespace lbann {
   LBANN_LAYER_BUILDER_ETI(l2_norm2, T, Device);                                \
   LBANN_LAYER_BUILDER_ETI(mean_absolute_error, T, Device);                     \
   LBANN_LAYER_BUILDER_ETI(mean_squared_error, T, Device);                      \
+  LBANN_LAYER_BUILDER_ETI(softmax_cross_entropy, T, Device);                   \
   LBANN_LAYER_BUILDER_ETI(top_k_categorical_accuracy, T, Device)
 
 #include "lbann/macros/instantiate_device.hpp"
@@ -0,0 +1,244 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#define LBANN_SOFTMAX_CROSS_ENTROPY_LAYER_INSTANTIATE
+#include "lbann/layers/loss/softmax_cross_entropy.hpp"
+#include "lbann/utils/exception.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace lbann {
+
+namespace {
+
+/** @brief Online log-sum-exp over chunks of a vector.
+ *
+ *  Each chunk is shifted by its own maximum, and the running sum is
+ *  rescaled whenever a chunk raises the overall maximum. Chunks that
+ *  fit in cache are only read once from memory.
+ */
+template <typename TensorDataType>
+TensorDataType
+log_sum_exp(const TensorDataType* x, El::Int size, El::Int chunk_size)
+{
+  const TensorDataType zero = El::TypeTraits<TensorDataType>::Zero();
+  TensorDataType max_val = -std::numeric_limits<TensorDataType>::infinity();
+  TensorDataType sum = zero;
+  for (El::Int begin = 0; begin < size; begin += chunk_size) {
+    const El::Int end = std::min(begin + chunk_size, size);
+    const TensorDataType chunk_max = *std::max_element(x + begin, x + end);
+    if (chunk_max == -std::numeric_limits<TensorDataType>::infinity()) {
+      continue;
+    }
+    TensorDataType chunk_sum = zero;
+    for (El::Int i = begin; i < end; ++i) {
+      chunk_sum += std::exp(x[i] - chunk_max);
+    }
+    if (chunk_max > max_val) {
+      sum = sum * std::exp(max_val - chunk_max) + chunk_sum;
+      max_val = chunk_max;
+    }
+    else {
+      sum += chunk_sum * std::exp(chunk_max - max_val);
+    }
+  }
+  return max_val + std::log(sum);
+}
+
+} // namespace
+
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+El::Int
+softmax_cross_entropy_layer<TensorDataType, Layout, Device>::get_num_classes()
+  const
+{
+  return this->get_input_dims(0).back();
+}
+
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+void softmax_cross_entropy_layer<TensorDataType, Layout, Device>::setup_dims()
+{
+  data_type_layer<TensorDataType>::setup_dims();
+  this->set_output_dims({1});
+
+  // Check that there is one label per position in the logits
+  const auto& logits_dims = this->get_input_dims(0);
+  const auto& labels_dims = this->get_input_dims(1);
+  const El::Int num_classes = get_num_classes();
+  if (num_classes < 1 ||
+      this->get_input_size(0) != this->get_input_size(1) * num_classes) {
+    const auto& parents = this->get_parent_layers();
+    LBANN_ERROR(get_type(),
+                " layer \"",
+                this->get_name(),
+                "\" expects one label per position of the logits, ",
+                "but parent layer \"",
+                parents[0]->get_name(),
+                "\" outputs a ",
+                logits_dims.size(),
+                "-D tensor with ",
+                this->get_input_size(0),
+                " entries and parent layer \"",
+                parents[1]->get_name(),
+                "\" outputs a ",
+                labels_dims.size(),
+                "-D tensor with ",
+                this->get_input_size(1),
+                " entries");
+  }
+  if (m_vocab_chunk_size < 0) {
+    LBANN_ERROR(get_type(),
+                " layer \"",
+                this->get_name(),
+                "\" has invalid vocabulary chunk size (",
+                m_vocab_chunk_size,
+                ")");
+  }
+}
+
+template <typename T, data_layout L, El::Device D>
+void softmax_cross_entropy_layer<T, L, D>::write_specific_proto(
+  lbann_data::Layer& proto) const
+{
+  proto.set_datatype(proto::ProtoDataType<T>);
+  auto* msg = proto.mutable_softmax_cross_entropy();
+  msg->set_vocab_chunk_size(m_vocab_chunk_size);
+  msg->mutable_ignore_index()->set_value(m_ignore_index);
+}
+
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+void softmax_cross_entropy_layer<TensorDataType, Layout, Device>::fp_compute()
+{
+  using CPUMatType = El::Matrix<TensorDataType, El::Device::CPU>;
+  const auto& local_logits =
+    dynamic_cast<const CPUMatType&>(this->get_local_prev_activations(0));
+  const auto& local_labels =
+    dynamic_cast<const CPUMatType&>(this->get_local_prev_activations(1));
+  auto& local_loss = dynamic_cast<CPUMatType&>(this->get_local_activations());
+  const El::Int num_classes = get_num_classes();
+  const El::Int num_positions = local_labels.Height();
+  const El::Int local_width = local_logits.Width();
+  const El::Int chunk_size =
+    (m_vocab_chunk_size > 0 ? std::min(m_vocab_chunk_size, num_classes)
+                            : num_classes);
+  const El::Int ignore_index = m_ignore_index;
+
+  // Log-sum-exp of each position's logits
+  m_log_sum_exp.Resize(num_positions, local_width);
+  LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+  for (El::Int col = 0; col < local_width; ++col) {
+    for (El::Int pos = 0; pos < num_positions; ++pos) {
+      const auto* x = local_logits.LockedBuffer(pos * num_classes, col);
+      m_log_sum_exp(pos, col) = log_sum_exp(x, num_classes, chunk_size);
+    }
+  }
+
+  // Loss is -log(softmax(x)[label]) = log-sum-exp - x[label]
+  int num_bad_labels = 0;
+  LBANN_OMP_PARALLEL_FOR_ARGS(reduction(+ : num_bad_labels))
+  for (El::Int col = 0; col < local_width; ++col) {
+    TensorDataType sum = El::TypeTraits<TensorDataType>::Zero();
+    for (El::Int pos = 0; pos < num_positions; ++pos) {
+      const auto label = static_cast<El::Int>(local_labels(pos, col));
+      if (ignore_index >= 0 && label == ignore_index) {
+        continue;
+      }
+      if (label < 0 || label >= num_classes) {
+        ++num_bad_labels;
+        continue;
+      }
+      sum += m_log_sum_exp(pos, col) -
+             local_logits(pos * num_classes + label, col);
+    }
+    local_loss(0, col) = sum;
+  }
+  if (num_bad_labels > 0) {
+    LBANN_ERROR(get_type(),
+                " layer \"",
+                this->get_name(),
+                "\" got ",
+                num_bad_labels,
+                " labels outside the range [0,",
+                num_classes,
+                ")");
+  }
+}
+
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+void softmax_cross_entropy_layer<TensorDataType, Layout, Device>::bp_compute()
+{
+  using CPUMatType = El::Matrix<TensorDataType, El::Device::CPU>;
+  const auto& local_logits =
+    dynamic_cast<const CPUMatType&>(this->get_local_prev_activations(0));
+  const auto& local_labels =
+    dynamic_cast<const CPUMatType&>(this->get_local_prev_activations(1));
+  const auto& local_gradient_wrt_output =
+    dynamic_cast<const CPUMatType&>(this->get_local_prev_error_signals());
+  auto& local_gradient_wrt_logits =
+    dynamic_cast<CPUMatType&>(this->get_local_error_signals(0));
+  const El::Int num_classes = get_num_classes();
+  const El::Int num_positions = local_labels.Height();
+  const El::Int local_width = local_logits.Width();
+  const El::Int ignore_index = m_ignore_index;
+
+  // Gradient is dy * (softmax(x) - onehot(label)), computed in one
+  // pass from the saved log-sum-exp
+  LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+  for (El::Int col = 0; col < local_width; ++col) {
+    for (El::Int pos = 0; pos < num_positions; ++pos) {
+      const auto* x = local_logits.LockedBuffer(pos * num_classes, col);
+      auto* dx = local_gradient_wrt_logits.Buffer(pos * num_classes, col);
+      const auto label = static_cast<El::Int>(local_labels(pos, col));
+      if (ignore_index >= 0 && label == ignore_index) {
+        std::fill(dx, dx + num_classes, El::TypeTraits<TensorDataType>::Zero());
+        continue;
+      }
+      const auto& dy = local_gradient_wrt_output(0, col);
+      const auto& lse = m_log_sum_exp(pos, col);
+      for (El::Int i = 0; i < num_classes; ++i) {
+        dx[i] = dy * std::exp(x[i] - lse);
+      }
+      if (0 <= label && label < num_classes) {
+        dx[label] -= dy;
+      }
+    }
+  }
+
+  // Labels are not differentiable
+  El::Zero(this->get_error_signals(1));
+}
+
+#define PROTO(T)                                                               \
+  template class softmax_cross_entropy_layer<T,                                \
+                                             data_layout::DATA_PARALLEL,       \
+                                             El::Device::CPU>
+
+#define LBANN_INSTANTIATE_CPU_HALF
+#include "lbann/macros/instantiate.hpp"
+
+} // namespace lbann
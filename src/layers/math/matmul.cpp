@@ -27,6 +27,7 @@
 #define LBANN_MATMUL_LAYER_INSTANTIATE
 #include "lbann/layers/math/matmul.hpp"
 #include "lbann/proto/datatype_helpers.hpp"
+#include "lbann/utils/batched_gemm.hpp"
 #include "lbann/utils/exception.hpp"
 
 #ifdef LBANN_HAS_GPU
@@ -206,34 +207,24 @@ void fp_compute_impl(
   const auto input1_stride = input1_height * input1_width;
   const auto output_stride = output_height * output_width;
 
-  LBANN_OMP_PARALLEL_FOR
-  for (El::Int j = 0; j < mat_depth; ++j) {
-    auto input0_buffer_start = j * input0_stride;
-    auto input1_buffer_start = j * input1_stride;
-    auto output_buffer_start = j * output_stride;
-    for (El::Int i = 0; i < local_mini_batch_size; ++i) {
-      LocalMat input0_v, input1_v, output_v;
-      input0_v.LockedAttach(input0_width,
-                            input0_height,
-                            local_input0.LockedBuffer(input0_buffer_start, i),
-                            input0_width);
-      input1_v.LockedAttach(input1_width,
-                            input1_height,
-                            local_input1.LockedBuffer(input1_buffer_start, i),
-                            input1_width);
-      output_v.Attach(output_width,
-                      output_height,
-                      local_output.Buffer(output_buffer_start, i),
-                      output_width);
-      El::Gemm(transpose_input1 ? El::TRANSPOSE : El::NORMAL,
-               transpose_input0 ? El::TRANSPOSE : El::NORMAL,
-               El::TypeTraits<TensorDataType>::One(),
-               input1_v,
-               input0_v,
-               El::TypeTraits<TensorDataType>::Zero(),
-               output_v);
-    }
-  }
+  const auto num_matrices = mat_depth * local_mini_batch_size;
+  gemm_strided_batched(transpose_input1 ? El::TRANSPOSE : El::NORMAL,
+                       transpose_input0 ? El::TRANSPOSE : El::NORMAL,
+                       output_width,
+                       output_height,
+                       transpose_input0 ? input0_height : input0_width,
+                       El::TypeTraits<TensorDataType>::One(),
+                       local_input1.LockedBuffer(),
+                       input1_width,
+                       input1_stride,
+                       local_input0.LockedBuffer(),
+                       input0_width,
+                       input0_stride,
+                       El::TypeTraits<TensorDataType>::Zero(),
+                       local_output.Buffer(),
+                       output_width,
+                       output_stride,
+                       num_matrices);
 }
 
 template <typename TensorDataType>
@@ -289,71 +280,82 @@ void bp_compute_impl(
   const auto input1_stride = input1_height * input1_width;
   const auto output_stride = output_height * output_width;
 
-  LBANN_OMP_PARALLEL_FOR
-  for (El::Int j = 0; j < mat_depth; ++j) {
-    auto input0_buffer_start = j * input0_stride;
-    auto input1_buffer_start = j * input1_stride;
-    auto output_buffer_start = j * output_stride;
-    for (El::Int i = 0; i < local_mini_batch_size; ++i) {
-      LocalMat input0_v, input1_v, output_grad_v, input0_grad_v, input1_grad_v;
-      input0_v.LockedAttach(input0_width,
-                            input0_height,
-                            local_input0.LockedBuffer(input0_buffer_start, i),
-                            input0_width);
-      input1_v.LockedAttach(input1_width,
-                            input1_height,
-                            local_input1.LockedBuffer(input1_buffer_start, i),
-                            input1_width);
-      output_grad_v.LockedAttach(
-        output_width,
-        output_height,
-        local_output_grad.LockedBuffer(output_buffer_start, i),
-        output_width);
-      input0_grad_v.Attach(input0_width,
-                           input0_height,
-                           local_input0_grad.Buffer(input0_buffer_start, i),
-                           input0_width);
-      input1_grad_v.Attach(input1_width,
-                           input1_height,
-                           local_input1_grad.Buffer(input1_buffer_start, i),
-                           input1_width);
-      if (transpose_input0) {
-        El::Gemm(El::TRANSPOSE,
-                 transpose_input1 ? El::TRANSPOSE : El::NORMAL,
-                 El::TypeTraits<TensorDataType>::One(),
-                 output_grad_v,
-                 input1_v,
-                 El::TypeTraits<TensorDataType>::Zero(),
-                 input0_grad_v);
-      }
-      else {
-        El::Gemm(transpose_input1 ? El::NORMAL : El::TRANSPOSE,
-                 El::NORMAL,
-                 El::TypeTraits<TensorDataType>::One(),
-                 input1_v,
-                 output_grad_v,
-                 El::TypeTraits<TensorDataType>::Zero(),
-                 input0_grad_v);
-      }
-      if (transpose_input1) {
-        El::Gemm(transpose_input0 ? El::TRANSPOSE : El::NORMAL,
-                 El::TRANSPOSE,
-                 El::TypeTraits<TensorDataType>::One(),
-                 input0_v,
-                 output_grad_v,
-                 El::TypeTraits<TensorDataType>::Zero(),
-                 input1_grad_v);
-      }
-      else {
-        El::Gemm(El::NORMAL,
-                 transpose_input0 ? El::NORMAL : El::TRANSPOSE,
-                 El::TypeTraits<TensorDataType>::One(),
-                 output_grad_v,
-                 input0_v,
-                 El::TypeTraits<TensorDataType>::Zero(),
-                 input1_grad_v);
-      }
-    }
+  const auto num_matrices = mat_depth * local_mini_batch_size;
+  if (transpose_input0) {
+    gemm_strided_batched(El::TRANSPOSE,
+                         transpose_input1 ? El::TRANSPOSE : El::NORMAL,
+                         input0_width,
+                         input0_height,
+                         output_width,
+                         El::TypeTraits<TensorDataType>::One(),
+                         local_output_grad.LockedBuffer(),
+                         output_width,
+                         output_stride,
+                         local_input1.LockedBuffer(),
+                         input1_width,
+                         input1_stride,
+                         El::TypeTraits<TensorDataType>::Zero(),
+                         local_input0_grad.Buffer(),
+                         input0_width,
+                         input0_stride,
+                         num_matrices);
+  }
+  else {
+    gemm_strided_batched(transpose_input1 ? El::NORMAL : El::TRANSPOSE,
+                         El::NORMAL,
+                         input0_width,
+                         input0_height,
+                         output_width,
+                         El::TypeTraits<TensorDataType>::One(),
+                         local_input1.LockedBuffer(),
+                         input1_width,
+                         input1_stride,
+                         local_output_grad.LockedBuffer(),
+                         output_width,
+                         output_stride,
+                         El::TypeTraits<TensorDataType>::Zero(),
+                         local_input0_grad.Buffer(),
+                         input0_width,
+                         input0_stride,
+                         num_matrices);
+  }
+  if (transpose_input1) {
+    gemm_strided_batched(transpose_input0 ? El::TRANSPOSE : El::NORMAL,
+                         El::TRANSPOSE,
+                         input1_width,
+                         input1_height,
+                         output_height,
+                         El::TypeTraits<TensorDataType>::One(),
+                         local_input0.LockedBuffer(),
+                         input0_width,
+                         input0_stride,
+                         local_output_grad.LockedBuffer(),
+                         output_width,
+                         output_stride,
+                         El::TypeTraits<TensorDataType>::Zero(),
+                         local_input1_grad.Buffer(),
+                         input1_width,
+                         input1_stride,
+                         num_matrices);
+  }
+  else {
+    gemm_strided_batched(El::NORMAL,
+                         transpose_input0 ? El::NORMAL : El::TRANSPOSE,
+                         input1_width,
+                         input1_height,
+                         output_height,
+                         El::TypeTraits<TensorDataType>::One(),
+                         local_output_grad.LockedBuffer(),
+                         output_width,
+                         output_stride,
+                         local_input0.LockedBuffer(),
+                         input0_width,
+                         input0_stride,
+                         El::TypeTraits<TensorDataType>::Zero(),
+                         local_input1_grad.Buffer(),
+                         input1_width,
+                         input1_stride,
+                         num_matrices);
   }
 }
 
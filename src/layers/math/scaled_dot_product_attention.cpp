@@ -0,0 +1,644 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#define LBANN_SCALED_DOT_PRODUCT_ATTENTION_LAYER_INSTANTIATE
+#include "lbann/layers/math/scaled_dot_product_attention.hpp"
+#include "lbann/comm_impl.hpp"
+#include "lbann/execution_algorithms/execution_context.hpp"
+#include "lbann/models/model.hpp"
+#include "lbann/proto/datatype_helpers.hpp"
+#include "lbann/proto/layers.pb.h"
+#include "lbann/utils/batched_gemm.hpp"
+#include "lbann/utils/counter_based_rng.hpp"
+#include "lbann/utils/exception.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+namespace lbann {
+
+namespace {
+
+/** Number of query rows in an attention tile. */
+constexpr El::Int query_tile_size = 64;
+/** Number of key columns in an attention tile. */
+constexpr El::Int key_tile_size = 64;
+
+/** Problem dimensions and buffers for one head of one sample.
+ *
+ *  Sequences are stored row-major, so the head's slice of each
+ *  tensor is a column-major (head dim) x (sequence length) matrix
+ *  with a leading dimension equal to the full embedding dimension.
+ */
+template <typename T>
+struct head_problem
+{
+  El::Int num_queries;
+  El::Int num_keys;
+  El::Int head_dim;
+  El::Int value_head_dim;
+  El::Int ldq; // Leading dimension of queries and keys
+  El::Int ldv; // Leading dimension of values and output
+  T scale;
+  bool causal;
+  // Dropout
+  bool dropout;
+  philox::key_type key;
+  uint64_t threshold;
+  T inv_keep_prob;
+  El::Int col; // Global sample index
+  El::Int head;
+};
+
+/** Number of leading keys that query @c i may attend to in a tile
+ *  starting at key @c j0. */
+template <typename T>
+El::Int num_visible_keys(const head_problem<T>& prob,
+                         El::Int i,
+                         El::Int j0,
+                         El::Int tile_keys)
+{
+  if (!prob.causal) {
+    return tile_keys;
+  }
+  return std::max(El::Int{0}, std::min(tile_keys, i - j0 + 1));
+}
+
+/** Scaled dropout mask for a tile of attention weights.
+ *
+ *  The Bernoulli trial for weight (i,j) only depends on the sample,
+ *  head, and positions, so backprop regenerates the same mask. The
+ *  mask is column-major with one column per query.
+ */
+template <typename T>
+void fill_dropout_tile(const head_problem<T>& prob,
+                       El::Int i0,
+                       El::Int tile_queries,
+                       El::Int j0,
+                       El::Int tile_keys,
+                       T* mask)
+{
+  const T zero = El::TypeTraits<T>::Zero();
+  for (El::Int i = 0; i < tile_queries; ++i) {
+    T* mask_col = mask + i * key_tile_size;
+    for (El::Int j = 0; j < tile_keys; j += 4) {
+      const auto r =
+        philox::philox4x32({static_cast<uint32_t>((j0 + j) / 4),
+                            static_cast<uint32_t>(i0 + i),
+                            static_cast<uint32_t>(prob.head),
+                            static_cast<uint32_t>(prob.col)},
+                           prob.key);
+      const El::Int block_size = std::min(El::Int{4}, tile_keys - j);
+      for (El::Int k = 0; k < block_size; ++k) {
+        const bool keep = static_cast<uint64_t>(r[k]) < prob.threshold;
+        mask_col[j + k] = keep ? prob.inv_keep_prob : zero;
+      }
+    }
+  }
+}
+
+/** Scaled query-key dot products for a tile.
+ *
+ *  The result is column-major with one column per query.
+ */
+template <typename T>
+void compute_scores(const head_problem<T>& prob,
+                    const T* queries,
+                    const T* keys,
+                    El::Int i0,
+                    El::Int tile_queries,
+                    El::Int j0,
+                    El::Int tile_keys,
+                    T* scores)
+{
+  packed_gemm(El::TRANSPOSE,
+              El::NORMAL,
+              tile_keys,
+              tile_queries,
+              prob.head_dim,
+              prob.scale,
+              keys + j0 * prob.ldq,
+              prob.ldq,
+              queries + i0 * prob.ldq,
+              prob.ldq,
+              El::TypeTraits<T>::Zero(),
+              scores,
+              key_tile_size);
+}
+
+/** Attention for one head of one sample, with an online softmax. */
+template <typename T>
+void attention_forward(const head_problem<T>& prob,
+                       const T* queries,
+                       const T* keys,
+                       const T* values,
+                       T* output,
+                       T* log_sum_exp)
+{
+  const T zero = El::TypeTraits<T>::Zero();
+  const T one = El::TypeTraits<T>::One();
+  const T neg_inf = -std::numeric_limits<T>::infinity();
+  std::vector<T> scores(key_tile_size * query_tile_size);
+  std::vector<T> mask(prob.dropout ? key_tile_size * query_tile_size : 0);
+  std::vector<T> acc(prob.value_head_dim * query_tile_size);
+  std::vector<T> row_max(query_tile_size), row_sum(query_tile_size);
+
+  for (El::Int i0 = 0; i0 < prob.num_queries; i0 += query_tile_size) {
+    const El::Int tile_queries =
+      std::min(query_tile_size, prob.num_queries - i0);
+    const El::Int keys_end =
+      prob.causal ? std::min(prob.num_keys, i0 + tile_queries)
+                  : prob.num_keys;
+    std::fill(acc.begin(), acc.end(), zero);
+    std::fill(row_max.begin(), row_max.end(), neg_inf);
+    std::fill(row_sum.begin(), row_sum.end(), zero);
+
+    for (El::Int j0 = 0; j0 < keys_end; j0 += key_tile_size) {
+      const El::Int tile_keys = std::min(key_tile_size, keys_end - j0);
+      compute_scores(prob, queries, keys, i0, tile_queries, j0, tile_keys,
+                     scores.data());
+      if (prob.dropout) {
+        fill_dropout_tile(prob, i0, tile_queries, j0, tile_keys,
+                          mask.data());
+      }
+
+      // Online softmax: rescale running sums to the new row maximum
+      // and replace scores with unnormalized probabilities
+      for (El::Int i = 0; i < tile_queries; ++i) {
+        T* s = scores.data() + i * key_tile_size;
+        const El::Int visible = num_visible_keys(prob, i0 + i, j0, tile_keys);
+        std::fill(s + visible, s + tile_keys, zero);
+        if (visible == 0) {
+          continue;
+        }
+        const T new_max =
+          std::max(row_max[i], *std::max_element(s, s + visible));
+        const T correction = std::exp(row_max[i] - new_max);
+        T sum = zero;
+        for (El::Int j = 0; j < visible; ++j) {
+          s[j] = std::exp(s[j] - new_max);
+          sum += s[j];
+        }
+        row_sum[i] = row_sum[i] * correction + sum;
+        row_max[i] = new_max;
+        if (correction != one) {
+          T* a = acc.data() + i * prob.value_head_dim;
+          for (El::Int p = 0; p < prob.value_head_dim; ++p) {
+            a[p] *= correction;
+          }
+        }
+        if (prob.dropout) {
+          const T* m = mask.data() + i * key_tile_size;
+          for (El::Int j = 0; j < visible; ++j) {
+            s[j] *= m[j];
+          }
+        }
+      }
+
+      // Accumulate weighted values
+      packed_gemm(El::NORMAL,
+                  El::NORMAL,
+                  prob.value_head_dim,
+                  tile_queries,
+                  tile_keys,
+                  one,
+                  values + j0 * prob.ldv,
+                  prob.ldv,
+                  scores.data(),
+                  key_tile_size,
+                  one,
+                  acc.data(),
+                  prob.value_head_dim);
+    }
+
+    // Normalize and write output
+    for (El::Int i = 0; i < tile_queries; ++i) {
+      const T* a = acc.data() + i * prob.value_head_dim;
+      T* y = output + (i0 + i) * prob.ldv;
+      const T inv_sum = one / row_sum[i];
+      for (El::Int p = 0; p < prob.value_head_dim; ++p) {
+        y[p] = a[p] * inv_sum;
+      }
+      log_sum_exp[i0 + i] = row_max[i] + std::log(row_sum[i]);
+    }
+  }
+}
+
+/** Backprop for one head of one sample.
+ *
+ *  Attention weights are recomputed tile by tile from the saved
+ *  log-sum-exp. Gradient buffers are overwritten.
+ */
+template <typename T>
+void attention_backward(const head_problem<T>& prob,
+                        const T* queries,
+                        const T* keys,
+                        const T* values,
+                        const T* output,
+                        const T* log_sum_exp,
+                        const T* output_grad,
+                        T* queries_grad,
+                        T* keys_grad,
+                        T* values_grad)
+{
+  const T zero = El::TypeTraits<T>::Zero();
+  const T one = El::TypeTraits<T>::One();
+  std::vector<T> probs(key_tile_size * query_tile_size);
+  std::vector<T> probs_grad(key_tile_size * query_tile_size);
+  std::vector<T> dropped(prob.dropout ? key_tile_size * query_tile_size : 0);
+  std::vector<T> mask(prob.dropout ? key_tile_size * query_tile_size : 0);
+  std::vector<T> row_dot(query_tile_size);
+
+  for (El::Int i = 0; i < prob.num_queries; ++i) {
+    std::fill_n(queries_grad + i * prob.ldq, prob.head_dim, zero);
+  }
+  for (El::Int j = 0; j < prob.num_keys; ++j) {
+    std::fill_n(keys_grad + j * prob.ldq, prob.head_dim, zero);
+    std::fill_n(values_grad + j * prob.ldv, prob.value_head_dim, zero);
+  }
+
+  for (El::Int i0 = 0; i0 < prob.num_queries; i0 += query_tile_size) {
+    const El::Int tile_queries =
+      std::min(query_tile_size, prob.num_queries - i0);
+    const El::Int keys_end =
+      prob.causal ? std::min(prob.num_keys, i0 + tile_queries)
+                  : prob.num_keys;
+
+    // Row sums of dy * y, i.e. of the attention weights times their
+    // gradients
+    for (El::Int i = 0; i < tile_queries; ++i) {
+      const T* y = output + (i0 + i) * prob.ldv;
+      const T* dy = output_grad + (i0 + i) * prob.ldv;
+      T sum = zero;
+      for (El::Int p = 0; p < prob.value_head_dim; ++p) {
+        sum += y[p] * dy[p];
+      }
+      row_dot[i] = sum;
+    }
+
+    for (El::Int j0 = 0; j0 < keys_end; j0 += key_tile_size) {
+      const El::Int tile_keys = std::min(key_tile_size, keys_end - j0);
+
+      // Recompute attention weights
+      compute_scores(prob, queries, keys, i0, tile_queries, j0, tile_keys,
+                     probs.data());
+      for (El::Int i = 0; i < tile_queries; ++i) {
+        T* p = probs.data() + i * key_tile_size;
+        const El::Int visible = num_visible_keys(prob, i0 + i, j0, tile_keys);
+        const T lse = log_sum_exp[i0 + i];
+        for (El::Int j = 0; j < visible; ++j) {
+          p[j] = std::exp(p[j] - lse);
+        }
+        std::fill(p + visible, p + tile_keys, zero);
+      }
+      const T* weights = probs.data();
+      if (prob.dropout) {
+        fill_dropout_tile(prob, i0, tile_queries, j0, tile_keys,
+                          mask.data());
+        for (El::Int i = 0; i < tile_queries; ++i) {
+          for (El::Int j = 0; j < tile_keys; ++j) {
+            const El::Int k = j + i * key_tile_size;
+            dropped[k] = probs[k] * mask[k];
+          }
+        }
+        weights = dropped.data();
+      }
+
+      // Gradient w.r.t. values
+      packed_gemm(El::NORMAL,
+                  El::TRANSPOSE,
+                  prob.value_head_dim,
+                  tile_keys,
+                  tile_queries,
+                  one,
+                  output_grad + i0 * prob.ldv,
+                  prob.ldv,
+                  weights,
+                  key_tile_size,
+                  one,
+                  values_grad + j0 * prob.ldv,
+                  prob.ldv);
+
+      // Gradient w.r.t. attention weights, then w.r.t. scores
+      packed_gemm(El::TRANSPOSE,
+                  El::NORMAL,
+                  tile_keys,
+                  tile_queries,
+                  prob.value_head_dim,
+                  one,
+                  values + j0 * prob.ldv,
+                  prob.ldv,
+                  output_grad + i0 * prob.ldv,
+                  prob.ldv,
+                  zero,
+                  probs_grad.data(),
+                  key_tile_size);
+      for (El::Int i = 0; i < tile_queries; ++i) {
+        const T* p = probs.data() + i * key_tile_size;
+        T* dp = probs_grad.data() + i * key_tile_size;
+        if (prob.dropout) {
+          const T* m = mask.data() + i * key_tile_size;
+          for (El::Int j = 0; j < tile_keys; ++j) {
+            dp[j] = p[j] * (dp[j] * m[j] - row_dot[i]);
+          }
+        }
+        else {
+          for (El::Int j = 0; j < tile_keys; ++j) {
+            dp[j] = p[j] * (dp[j] - row_dot[i]);
+          }
+        }
+      }
+
+      // Gradients w.r.t. queries and keys
+      packed_gemm(El::NORMAL,
+                  El::NORMAL,
+                  prob.head_dim,
+                  tile_queries,
+                  tile_keys,
+                  prob.scale,
+                  keys + j0 * prob.ldq,
+                  prob.ldq,
+                  probs_grad.data(),
+                  key_tile_size,
+                  one,
+                  queries_grad + i0 * prob.ldq,
+                  prob.ldq);
+      packed_gemm(El::NORMAL,
+                  El::TRANSPOSE,
+                  prob.head_dim,
+                  tile_keys,
+                  tile_queries,
+                  prob.scale,
+                  queries + i0 * prob.ldq,
+                  prob.ldq,
+                  probs_grad.data(),
+                  key_tile_size,
+                  one,
+                  keys_grad + j0 * prob.ldq,
+                  prob.ldq);
+    }
+  }
+}
+
+} // namespace
+
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+double
+scaled_dot_product_attention_layer<TensorDataType, Layout, Device>::get_scale()
+  const
+{
+  if (m_scale > 0.0) {
+    return m_scale;
+  }
+  const auto& query_dims = this->get_input_dims(0);
+  El::Int head_dim = 1;
+  if (!query_dims.empty() && m_num_heads > 0) {
+    head_dim = std::max(El::Int{1}, query_dims.back() / m_num_heads);
+  }
+  return 1.0 / std::sqrt(static_cast<double>(head_dim));
+}
+
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+bool scaled_dot_product_attention_layer<TensorDataType, Layout, Device>::
+  is_dropout_active() const
+{
+  const auto& mode =
+    this->m_model->get_execution_context().get_execution_mode();
+  return m_dropout > 0.0 && mode == execution_mode::training;
+}
+
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+void scaled_dot_product_attention_layer<TensorDataType, Layout, Device>::
+  setup_dims()
+{
+  data_type_layer<TensorDataType>::setup_dims();
+
+  // Check input dimensions
+  const auto& query_dims = this->get_input_dims(0);
+  const auto& key_dims = this->get_input_dims(1);
+  const auto& value_dims = this->get_input_dims(2);
+  const bool bad_dims =
+    (query_dims.size() != 2 || key_dims.size() != 2 ||
+     value_dims.size() != 2 || query_dims[1] != key_dims[1] ||
+     key_dims[0] != value_dims[0]);
+  if (bad_dims) {
+    auto print_dims = [](const std::vector<int>& dims) -> std::string {
+      std::ostringstream ss;
+      for (size_t i = 0; i < dims.size(); ++i) {
+        ss << (i > 0 ? "x" : "") << dims[i];
+      }
+      return ss.str();
+    };
+    LBANN_ERROR(get_type(),
+                " layer \"",
+                this->get_name(),
+                "\" expects 2D query, key, and value tensors with ",
+                "matching key/value sequence lengths and matching ",
+                "query/key embedding dimensions, but got queries with dims ",
+                print_dims(query_dims),
+                ", keys with dims ",
+                print_dims(key_dims),
+                ", and values with dims ",
+                print_dims(value_dims));
+  }
+  if (m_num_heads < 1 || query_dims[1] % m_num_heads != 0 ||
+      value_dims[1] % m_num_heads != 0) {
+    LBANN_ERROR(get_type(),
+                " layer \"",
+                this->get_name(),
+                "\" has ",
+                m_num_heads,
+                " heads, which do not evenly divide the query embedding ",
+                "dimension (",
+                query_dims[1],
+                ") and value embedding dimension (",
+                value_dims[1],
+                ")");
+  }
+  if (m_dropout < 0.0 || m_dropout >= 1.0) {
+    LBANN_ERROR(get_type(),
+                " layer \"",
+                this->get_name(),
+                "\" has invalid dropout probability (",
+                m_dropout,
+                ")");
+  }
+
+  this->set_output_dims({query_dims[0], value_dims[1]});
+}
+
+template <typename T, data_layout L, El::Device D>
+void scaled_dot_product_attention_layer<T, L, D>::write_specific_proto(
+  lbann_data::Layer& proto) const
+{
+  proto.set_datatype(proto::ProtoDataType<T>);
+  auto* msg = proto.mutable_scaled_dot_product_attention();
+  msg->set_num_heads(m_num_heads);
+  msg->set_causal(m_causal);
+  msg->set_dropout(m_dropout);
+  if (m_scale > 0.0) {
+    msg->mutable_scale()->set_value(m_scale);
+  }
+}
+
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+void scaled_dot_product_attention_layer<TensorDataType, Layout, Device>::
+  fp_compute()
+{
+  using CPUMatType = El::Matrix<TensorDataType, El::Device::CPU>;
+  const auto& queries = this->get_prev_activations(0);
+  const auto& local_queries =
+    dynamic_cast<const CPUMatType&>(this->get_local_prev_activations(0));
+  const auto& local_keys =
+    dynamic_cast<const CPUMatType&>(this->get_local_prev_activations(1));
+  const auto& local_values =
+    dynamic_cast<const CPUMatType&>(this->get_local_prev_activations(2));
+  auto& local_output = dynamic_cast<CPUMatType&>(this->get_local_activations());
+  const auto& query_dims = this->get_input_dims(0);
+  const auto& value_dims = this->get_input_dims(2);
+  const El::Int num_heads = m_num_heads;
+  const El::Int num_queries = query_dims[0];
+  const El::Int local_width = local_queries.Width();
+
+  head_problem<TensorDataType> prob{};
+  prob.num_queries = num_queries;
+  prob.num_keys = value_dims[0];
+  prob.head_dim = query_dims[1] / num_heads;
+  prob.value_head_dim = value_dims[1] / num_heads;
+  prob.ldq = query_dims[1];
+  prob.ldv = value_dims[1];
+  prob.scale = static_cast<TensorDataType>(get_scale());
+  prob.causal = m_causal;
+  prob.dropout = is_dropout_active();
+  if (prob.dropout) {
+    m_mask_seed = philox::draw_seed();
+#ifdef LBANN_DETERMINISTIC
+    // Share the trainer master's seed so the mask does not depend on
+    // the number of processes
+    const auto& comm = *this->get_comm();
+    comm.trainer_broadcast(comm.get_trainer_master(), m_mask_seed);
+#endif // LBANN_DETERMINISTIC
+    prob.key = philox::make_key(m_mask_seed);
+    prob.threshold = philox::bernoulli_threshold(1.0 - m_dropout);
+    prob.inv_keep_prob = static_cast<TensorDataType>(1.0 / (1.0 - m_dropout));
+  }
+
+  m_log_sum_exp.Resize(num_heads * num_queries, local_width);
+  LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+  for (El::Int col = 0; col < local_width; ++col) {
+    for (El::Int head = 0; head < num_heads; ++head) {
+      auto head_prob = prob;
+      head_prob.col = queries.GlobalCol(col);
+      head_prob.head = head;
+      attention_forward(
+        head_prob,
+        local_queries.LockedBuffer(head * prob.head_dim, col),
+        local_keys.LockedBuffer(head * prob.head_dim, col),
+        local_values.LockedBuffer(head * prob.value_head_dim, col),
+        local_output.Buffer(head * prob.value_head_dim, col),
+        m_log_sum_exp.Buffer(head * num_queries, col));
+    }
+  }
+}
+
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+void scaled_dot_product_attention_layer<TensorDataType, Layout, Device>::
+  bp_compute()
+{
+  using CPUMatType = El::Matrix<TensorDataType, El::Device::CPU>;
+  const auto& queries = this->get_prev_activations(0);
+  const auto& local_queries =
+    dynamic_cast<const CPUMatType&>(this->get_local_prev_activations(0));
+  const auto& local_keys =
+    dynamic_cast<const CPUMatType&>(this->get_local_prev_activations(1));
+  const auto& local_values =
+    dynamic_cast<const CPUMatType&>(this->get_local_prev_activations(2));
+  const auto& local_output =
+    dynamic_cast<const CPUMatType&>(this->get_local_activations());
+  const auto& local_output_grad =
+    dynamic_cast<const CPUMatType&>(this->get_local_prev_error_signals());
+  auto& local_queries_grad =
+    dynamic_cast<CPUMatType&>(this->get_local_error_signals(0));
+  auto& local_keys_grad =
+    dynamic_cast<CPUMatType&>(this->get_local_error_signals(1));
+  auto& local_values_grad =
+    dynamic_cast<CPUMatType&>(this->get_local_error_signals(2));
+  const auto& query_dims = this->get_input_dims(0);
+  const auto& value_dims = this->get_input_dims(2);
+  const El::Int num_heads = m_num_heads;
+  const El::Int num_queries = query_dims[0];
+  const El::Int local_width = local_queries.Width();
+
+  head_problem<TensorDataType> prob{};
+  prob.num_queries = num_queries;
+  prob.num_keys = value_dims[0];
+  prob.head_dim = query_dims[1] / num_heads;
+  prob.value_head_dim = value_dims[1] / num_heads;
+  prob.ldq = query_dims[1];
+  prob.ldv = value_dims[1];
+  prob.scale = static_cast<TensorDataType>(get_scale());
+  prob.causal = m_causal;
+  prob.dropout = is_dropout_active();
+  if (prob.dropout) {
+    prob.key = philox::make_key(m_mask_seed);
+    prob.threshold = philox::bernoulli_threshold(1.0 - m_dropout);
+    prob.inv_keep_prob = static_cast<TensorDataType>(1.0 / (1.0 - m_dropout));
+  }
+
+  LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+  for (El::Int col = 0; col < local_width; ++col) {
+    for (El::Int head = 0; head < num_heads; ++head) {
+      auto head_prob = prob;
+      head_prob.col = queries.GlobalCol(col);
+      head_prob.head = head;
+      attention_backward(
+        head_prob,
+        local_queries.LockedBuffer(head * prob.head_dim, col),
+        local_keys.LockedBuffer(head * prob.head_dim, col),
+        local_values.LockedBuffer(head * prob.value_head_dim, col),
+        local_output.LockedBuffer(head * prob.value_head_dim, col),
+        m_log_sum_exp.LockedBuffer(head * num_queries, col),
+        local_output_grad.LockedBuffer(head * prob.value_head_dim, col),
+        local_queries_grad.Buffer(head * prob.head_dim, col),
+        local_keys_grad.Buffer(head * prob.head_dim, col),
+        local_values_grad.Buffer(head * prob.value_head_dim, col));
+    }
+  }
+}
+
+#define PROTO(T)                                                               \
+  template class scaled_dot_product_attention_layer<                           \
+    T,                                                                         \
+    data_layout::DATA_PARALLEL,                                                \
+    El::Device::CPU>
+
+#define LBANN_INSTANTIATE_CPU_HALF
+#include "lbann/macros/instantiate.hpp"
+
+} // namespace lbann
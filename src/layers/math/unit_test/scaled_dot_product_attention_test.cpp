@@ -0,0 +1,325 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Catch2BasicSupport.hpp"
+
+#include "MPITestHelpers.hpp"
+#include "TestHelpers.hpp"
+
+#include <lbann/base.hpp>
+#include <lbann/layers/data_type_layer.hpp>
+#include <lbann/layers/transform/dummy.hpp>
+#include <lbann/models/model.hpp>
+#include <lbann/proto/lbann.pb.h>
+#include <lbann/proto/proto_common.hpp>
+#include <lbann/utils/lbann_library.hpp>
+#include <lbann/utils/random_number_generators.hpp>
+#include <lbann/weights/data_type_weights.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string>
+
+namespace {
+
+using DummyLayerType = lbann::
+  dummy_layer<float, lbann::data_layout::DATA_PARALLEL, El::Device::CPU>;
+using StarMatrixType =
+  El::DistMatrix<float, El::STAR, El::STAR, El::ELEMENT, El::Device::CPU>;
+
+// Problem size. Queries and keys span more than one attention tile.
+constexpr El::Int num_heads = 2;
+constexpr El::Int num_queries = 70;
+constexpr El::Int num_keys = 70;
+constexpr El::Int embed_dim = 8;
+constexpr El::Int value_dim = num_heads * num_keys;
+constexpr double dropout = 0.25;
+constexpr int mask_seed = 20241018;
+
+const std::string model_prototext = R"""(
+model {
+  layer {
+    name: "q"
+    children: "attn"
+    weights: "q_values"
+    device_allocation: "cpu"
+    weights_layer {
+      dims: 70
+      dims: 8
+    }
+  }
+  layer {
+    name: "k"
+    children: "attn"
+    weights: "k_values"
+    device_allocation: "cpu"
+    weights_layer {
+      dims: 70
+      dims: 8
+    }
+  }
+  layer {
+    name: "v"
+    children: "attn"
+    weights: "v_values"
+    device_allocation: "cpu"
+    weights_layer {
+      dims: 70
+      dims: 140
+    }
+  }
+  layer {
+    name: "attn"
+    parents: "q k v"
+    children: "out"
+    device_allocation: "cpu"
+    scaled_dot_product_attention {
+      num_heads: 2
+      dropout: 0.25
+    }
+  }
+  layer {
+    name: "out"
+    parents: "attn"
+    device_allocation: "cpu"
+    dummy {
+    }
+  }
+  weights {
+    name: "q_values"
+    initializer {
+      constant_initializer {
+        value: 0
+      }
+    }
+  }
+  weights {
+    name: "k_values"
+    initializer {
+      constant_initializer {
+        value: 0
+      }
+    }
+  }
+  weights {
+    name: "v_values"
+    initializer {
+      constant_initializer {
+        value: 0
+      }
+    }
+  }
+}
+)""";
+
+std::unique_ptr<lbann::model> setup_model(const std::string& model_contents)
+{
+  auto& world_comm = unit_test::utilities::current_world_comm();
+  auto& g = world_comm.get_trainer_grid();
+
+  lbann_data::LbannPB pb;
+  REQUIRE_NOTHROW(lbann::read_prototext_string(model_contents, pb, true));
+
+  // Construct a trainer so that the model can register the input layer
+  lbann::construct_trainer(&world_comm, pb.mutable_trainer(), pb);
+  auto my_model = lbann::proto::construct_model(&world_comm,
+                                                pb.optimizer(),
+                                                pb.trainer(),
+                                                pb.model());
+  my_model->setup(1UL, {&g});
+  return my_model;
+}
+
+template <typename LayerT>
+LayerT& get_layer(lbann::model& m, std::string const& name)
+{
+  auto const layers = m.get_layers();
+  auto iter =
+    std::find_if(layers.cbegin(), layers.cend(), [&name](auto const* l) {
+      return l->get_name() == name;
+    });
+  REQUIRE(iter != layers.cend());
+  auto* layer = dynamic_cast<LayerT*>(*iter);
+  REQUIRE(layer != nullptr);
+  return *layer;
+}
+
+lbann::data_type_weights<float>& get_weights(lbann::model& m,
+                                             std::string const& name)
+{
+  auto const weights = m.get_weights();
+  auto iter =
+    std::find_if(weights.cbegin(), weights.cend(), [&name](auto const* w) {
+      return w->get_name() == name;
+    });
+  REQUIRE(iter != weights.cend());
+  auto* w = dynamic_cast<lbann::data_type_weights<float>*>(*iter);
+  REQUIRE(w != nullptr);
+  return *w;
+}
+
+/** Set every entry of a weights tensor from its flat index. */
+void fill_weights(lbann::data_type_weights<float>& w,
+                  std::function<float(size_t)> const& f)
+{
+  for (size_t i = 0; i < w.get_size(); ++i) {
+    w.set_value(f(i), i);
+  }
+}
+
+StarMatrixType gather(El::AbstractDistMatrix<float> const& x)
+{
+  StarMatrixType x_star(x.Grid(), x.Root());
+  El::Copy(x, x_star);
+  return x_star;
+}
+
+/** Forward prop in training mode with a fixed dropout mask seed. */
+StarMatrixType forward(lbann::model& m, lbann::Layer const& attn)
+{
+  lbann::init_random(mask_seed);
+  m.forward_prop(lbann::execution_mode::training);
+  auto const& attn_layer =
+    dynamic_cast<lbann::data_type_layer<float> const&>(attn);
+  return gather(attn_layer.get_activations());
+}
+
+} // namespace
+
+TEST_CASE("Scaled dot-product attention dropout",
+          "[mpi][layer][attention][dropout]")
+{
+  auto& world_comm = unit_test::utilities::current_world_comm();
+  auto& g = world_comm.get_trainer_grid();
+  lbann::utils::grid_manager mgr(g);
+
+  auto m = setup_model(model_prototext);
+  auto& attn = get_layer<lbann::data_type_layer<float>>(*m, "attn");
+  auto& q = get_weights(*m, "q_values");
+  auto& k = get_weights(*m, "k_values");
+  auto& v = get_weights(*m, "v_values");
+
+  SECTION("Dropped fraction and scaling")
+  {
+    // With zero queries, attention weights are uniform. Each head's
+    // values form an identity matrix, so the output holds the scaled
+    // dropout mask.
+    fill_weights(k, [](size_t i) { return std::sin(0.7f * i); });
+    fill_weights(v, [](size_t i) {
+      const auto row = static_cast<El::Int>(i) / value_dim;
+      const auto col = static_cast<El::Int>(i) % value_dim;
+      return col % num_keys == row ? 1.f : 0.f;
+    });
+
+    m->forward_prop(lbann::execution_mode::testing);
+    auto const test_output = gather(attn.get_activations());
+    for (El::Int i = 0; i < num_queries * value_dim; ++i) {
+      REQUIRE(test_output.Get(i, 0) == Approx(1. / num_keys));
+    }
+
+    auto const output = forward(*m, attn);
+    const double kept_value = 1. / ((1. - dropout) * num_keys);
+    El::Int num_dropped = 0;
+    for (El::Int i = 0; i < num_queries * value_dim; ++i) {
+      auto const y = output.Get(i, 0);
+      if (y == 0.f) {
+        ++num_dropped;
+      }
+      else {
+        REQUIRE(y == Approx(kept_value));
+      }
+    }
+    const double dropped_fraction =
+      static_cast<double>(num_dropped) / (num_queries * value_dim);
+    CHECK(dropped_fraction == Approx(dropout).margin(0.02));
+
+    // The same seed reproduces the mask
+    auto const output2 = forward(*m, attn);
+    for (El::Int i = 0; i < num_queries * value_dim; ++i) {
+      REQUIRE(output2.Get(i, 0) == output.Get(i, 0));
+    }
+  }
+
+  SECTION("Gradient check with a fixed mask")
+  {
+    auto q_init = [](size_t i) { return std::sin(0.7f * i); };
+    auto k_init = [](size_t i) { return std::cos(0.3f * i); };
+    auto v_init = [](size_t i) { return std::sin(0.11f * i + 1.f); };
+    fill_weights(q, q_init);
+    fill_weights(k, k_init);
+    fill_weights(v, v_init);
+
+    // Objective is the dot product of the output with a fixed tensor
+    auto grad_wrt_output =
+      std::make_unique<StarMatrixType>(num_queries * value_dim, 1, g);
+    for (El::Int i = 0; i < num_queries * value_dim; ++i) {
+      grad_wrt_output->Set(i, 0, std::sin(0.37f * i));
+    }
+    auto const dy = *grad_wrt_output;
+    auto objective = [&]() {
+      auto const y = forward(*m, attn);
+      double sum = 0.;
+      for (El::Int i = 0; i < num_queries * value_dim; ++i) {
+        sum += static_cast<double>(y.Get(i, 0)) * dy.Get(i, 0);
+      }
+      return sum;
+    };
+
+    // Backprop regenerates the mask drawn in forward prop
+    forward(*m, attn);
+    get_layer<DummyLayerType>(*m, "out")
+      .set_error_signal(std::move(grad_wrt_output));
+    attn.set_keep_error_signals(true);
+    REQUIRE_NOTHROW(m->backward_prop(false));
+    std::vector<StarMatrixType> grads;
+    for (int i = 0; i < 3; ++i) {
+      grads.push_back(gather(attn.get_error_signals(i)));
+    }
+
+    // Compare with central differences on a subset of entries
+    constexpr float step = 1e-2f;
+    auto check_input = [&](lbann::data_type_weights<float>& w,
+                           std::function<float(size_t)> const& init,
+                           StarMatrixType const& grad,
+                           size_t stride) {
+      for (size_t i = 0; i < w.get_size(); i += stride) {
+        const float x = init(i);
+        w.set_value(x + step, i);
+        const double f_plus = objective();
+        w.set_value(x - step, i);
+        const double f_minus = objective();
+        w.set_value(x, i);
+        const double expected = (f_plus - f_minus) / (2 * step);
+        CHECK(grad.Get(i, 0) ==
+              Approx(expected).epsilon(0.01).margin(2e-3));
+      }
+    };
+    check_input(q, q_init, grads[0], 13);
+    check_input(k, k_init, grads[1], 13);
+    check_input(v, v_init, grads[2], 97);
+  }
+}
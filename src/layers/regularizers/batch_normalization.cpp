@@ -29,10 +29,145 @@
 #include "lbann/execution_algorithms/execution_context.hpp"
 #include "lbann/layers/regularizers/batch_normalization_impl.hpp"
 #include "lbann/optimizers/optimizer.hpp"
+#include "lbann/utils/moments.hpp"
+#include "lbann/utils/omp_pragma.hpp"
 #include "lbann/weights/weights_helpers.hpp"
 
+#include <algorithm>
+#include <vector>
+
 namespace lbann {
 
+namespace {
+
+/** @brief Per-channel centered sums over local mini-batch
+ *
+ *  For each channel, computes sum(w_i) and sum(w_i * (x_i - c)),
+ *  where c is the channel's center and i ranges over the channel's
+ *  entries in all local samples. If @c w is a null pointer, the
+ *  weights are w_i = x_i - c (see @c accumulate_centered_sums).
+ *
+ *  The matrices are traversed in tiles of (channels x columns) so
+ *  that there is enough parallel work even with few channels, and
+ *  so that each tile streams through contiguous memory. Long
+ *  channels are reduced with vectorized accumulators. Short
+ *  channels are grouped so that each column contributes a
+ *  contiguous segment that is accumulated row by row. Partial sums
+ *  are combined in a fixed order, so results do not depend on
+ *  thread scheduling.
+ */
+template <typename TensorDataType>
+void channel_centered_sums(const TensorDataType* x,
+                           El::Int x_ldim,
+                           const TensorDataType* w,
+                           El::Int w_ldim,
+                           El::Int width,
+                           const TensorDataType* centers,
+                           El::Int num_channels,
+                           El::Int channel_size,
+                           TensorDataType* sums_w,
+                           TensorDataType* sums_wu)
+{
+  using T = TensorDataType;
+  constexpr El::Int long_channel_size = 64;
+  constexpr El::Int max_tile_rows = 1024;
+  const bool long_channels = channel_size >= long_channel_size;
+  const El::Int channels_per_tile =
+    long_channels ? 1 : max_tile_rows / std::max(channel_size, El::Int{1});
+  const El::Int num_tiles =
+    (num_channels + channels_per_tile - 1) / channels_per_tile;
+  const El::Int max_threads = omp_get_max_threads();
+  const El::Int num_col_blocks = std::max(
+    El::Int{1},
+    std::min(width, (4 * max_threads + num_tiles - 1) / num_tiles));
+  std::vector<T> partials(2 * num_channels * num_col_blocks, T(0));
+
+  LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+  for (El::Int tile = 0; tile < num_tiles; ++tile) {
+    for (El::Int block = 0; block < num_col_blocks; ++block) {
+      const El::Int channel_start = tile * channels_per_tile;
+      const El::Int channel_end =
+        std::min(channel_start + channels_per_tile, num_channels);
+      const El::Int col_start = (block * width) / num_col_blocks;
+      const El::Int col_end = ((block + 1) * width) / num_col_blocks;
+      auto* block_partials = &partials[2 * num_channels * block];
+      if (long_channels) {
+        const El::Int channel = channel_start;
+        const El::Int row_start = channel * channel_size;
+        T sum_w = T(0), sum_wu = T(0);
+        for (El::Int col = col_start; col < col_end; ++col) {
+          accumulate_centered_sums<T>(
+            x + col * x_ldim + row_start,
+            w ? w + col * w_ldim + row_start : nullptr,
+            channel_size,
+            centers[channel],
+            sum_w,
+            sum_wu);
+        }
+        block_partials[2 * channel] = sum_w;
+        block_partials[2 * channel + 1] = sum_wu;
+      }
+      else {
+        const El::Int row_start = channel_start * channel_size;
+        const El::Int num_rows = (channel_end - channel_start) * channel_size;
+        T row_centers[max_tile_rows];
+        T acc_w[max_tile_rows];
+        T acc_wu[max_tile_rows];
+        for (El::Int channel = channel_start; channel < channel_end;
+             ++channel) {
+          const El::Int offset = (channel - channel_start) * channel_size;
+          std::fill_n(&row_centers[offset], channel_size, centers[channel]);
+        }
+        std::fill_n(acc_w, num_rows, T(0));
+        std::fill_n(acc_wu, num_rows, T(0));
+        for (El::Int col = col_start; col < col_end; ++col) {
+          const T* __restrict__ x_col = x + col * x_ldim + row_start;
+          if (w == nullptr) {
+            for (El::Int r = 0; r < num_rows; ++r) {
+              const T u = x_col[r] - row_centers[r];
+              acc_w[r] += u;
+              acc_wu[r] += u * u;
+            }
+          }
+          else {
+            const T* __restrict__ w_col = w + col * w_ldim + row_start;
+            for (El::Int r = 0; r < num_rows; ++r) {
+              const T u = x_col[r] - row_centers[r];
+              acc_w[r] += w_col[r];
+              acc_wu[r] += w_col[r] * u;
+            }
+          }
+        }
+        for (El::Int channel = channel_start; channel < channel_end;
+             ++channel) {
+          const El::Int offset = (channel - channel_start) * channel_size;
+          T sum_w = T(0), sum_wu = T(0);
+          for (El::Int r = offset; r < offset + channel_size; ++r) {
+            sum_w += acc_w[r];
+            sum_wu += acc_wu[r];
+          }
+          block_partials[2 * channel] = sum_w;
+          block_partials[2 * channel + 1] = sum_wu;
+        }
+      }
+    }
+  }
+
+  // Combine partial sums from column blocks
+  LBANN_OMP_PARALLEL_FOR
+  for (El::Int channel = 0; channel < num_channels; ++channel) {
+    T sum_w = T(0), sum_wu = T(0);
+    for (El::Int block = 0; block < num_col_blocks; ++block) {
+      sum_w += partials[2 * (num_channels * block + channel)];
+      sum_wu += partials[2 * (num_channels * block + channel) + 1];
+    }
+    sums_w[channel] = sum_w;
+    sums_wu[channel] = sum_wu;
+  }
+}
+
+} // namespace
+
 template <typename TensorDataType, data_layout T_layout, El::Device Dev>
 void batch_normalization_layer<TensorDataType, T_layout, Dev>::fp_compute()
 {
@@ -66,23 +201,21 @@ void batch_normalization_layer<TensorDataType, T_layout, Dev>::fp_compute()
       ValuesGetter::mutable_values(this->get_weights(2)).Matrix();
     auto& local_running_var =
       ValuesGetter::mutable_values(this->get_weights(3)).Matrix();
-    // Compute sums and sums of squares
-    LBANN_OMP_PARALLEL_FOR
-    for (El::Int channel = 0; channel < num_channels; ++channel) {
-      TensorDataType sum = zero;
-      TensorDataType sqsum = zero;
-      const auto& row_start = channel * channel_size;
-      const auto& row_end = (channel + 1) * channel_size;
-      for (El::Int col = 0; col < local_width; ++col) {
-        for (El::Int row = row_start; row < row_end; ++row) {
-          const auto& x = local_input(row, col);
-          sum += x;
-          sqsum += x * x;
-        }
-      }
-      local_mean(channel, 0) = sum;
-      local_var(channel, 0) = sqsum;
-    }
+    // Compute sums and sums of squares about the running mean
+    // Note: Centering the sums avoids cancellation when computing
+    // the variance. The running mean is replicated across the
+    // statistics group, so the sums can still be combined with a
+    // single allreduce.
+    channel_centered_sums<TensorDataType>(local_input.LockedBuffer(),
+                                          local_input.LDim(),
+                                          nullptr,
+                                          0,
+                                          local_width,
+                                          local_running_mean.LockedBuffer(),
+                                          num_channels,
+                                          channel_size,
+                                          local_mean.Buffer(),
+                                          local_var.Buffer());
     El::Int num_per_sum;
     if (this->m_statistics_group_size == 0) {
       // Global statistics aggregation; allreduce on fused buffer.
@@ -115,16 +248,24 @@ void batch_normalization_layer<TensorDataType, T_layout, Dev>::fp_compute()
     }
 
     // Compute minibatch statistics
+    //   mean = running_mean + sum / n
+    //   var = ( sqsum - sum^2 / n ) / ( n - correction )
     if (num_per_sum <= 1) {
+      LBANN_OMP_PARALLEL_FOR
+      for (El::Int channel = 0; channel < num_channels; ++channel) {
+        local_mean(channel, 0) += local_running_mean(channel, 0);
+      }
       El::Fill(local_var, one);
     }
     else {
       LBANN_OMP_PARALLEL_FOR
       for (El::Int channel = 0; channel < num_channels; ++channel) {
         auto num_per_sum_dt = El::To<TensorDataType>(num_per_sum);
-        const auto& mean = local_mean(channel, 0) / num_per_sum_dt;
-        const auto& sqmean = local_var(channel, 0) / num_per_sum_dt;
-        auto var = num_per_sum_dt * (sqmean - mean * mean) /
+        const auto& sum = local_mean(channel, 0);
+        const auto& sqsum = local_var(channel, 0);
+        const auto& mean_offset = sum / num_per_sum_dt;
+        const auto& mean = local_running_mean(channel, 0) + mean_offset;
+        auto var = std::max(sqsum - sum * mean_offset, zero) /
                    (num_per_sum_dt - correction);
         var = std::max(var, this->m_epsilon);
         local_mean(channel, 0) = mean;
@@ -148,27 +289,36 @@ void batch_normalization_layer<TensorDataType, T_layout, Dev>::fp_compute()
     (is_training ? this->m_var_v->LockedMatrix()
                  : this->weights_values(3).LockedMatrix());
 
-  // Iterate through channels
+  // Fold normalization and affine transform
+  //   y = scale * (x - mean) / sqrt(var + epsilon) + bias
+  //     = a * x + b
+  std::vector<TensorDataType> coeffs(2 * num_channels);
   LBANN_OMP_PARALLEL_FOR
   for (El::Int channel = 0; channel < num_channels; ++channel) {
-
-    // Get channel parameters
     const auto& mean = local_mean(channel, 0);
     const auto& var = local_var(channel, 0);
     const TensorDataType inv_stdev =
       static_cast<TensorDataType>(1 / El::Sqrt(var + this->m_epsilon));
-    const auto& scale = local_scale(channel, 0);
-    const auto& bias = local_bias(channel, 0);
+    const auto a = local_scale(channel, 0) * inv_stdev;
+    coeffs[2 * channel] = a;
+    coeffs[2 * channel + 1] = local_bias(channel, 0) - a * mean;
+  }
 
-    // Apply batch normalization to inputs in channel
-    const auto& row_start = channel * channel_size;
-    const auto& row_end = (channel + 1) * channel_size;
-    for (El::Int col = 0; col < local_width; ++col) {
-      for (El::Int row = row_start; row < row_end; ++row) {
-        const auto& x = local_input(row, col);
-        const auto& xhat = (x - mean) * inv_stdev;
-        auto& y = local_output(row, col);
-        y = scale * xhat + bias;
+  // Apply batch normalization
+  const TensorDataType* input_buffer = local_input.LockedBuffer();
+  const El::Int input_ldim = local_input.LDim();
+  TensorDataType* output_buffer = local_output.Buffer();
+  const El::Int output_ldim = local_output.LDim();
+  LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+  for (El::Int col = 0; col < local_width; ++col) {
+    for (El::Int channel = 0; channel < num_channels; ++channel) {
+      const auto a = coeffs[2 * channel];
+      const auto b = coeffs[2 * channel + 1];
+      const El::Int row_start = channel * channel_size;
+      const auto* __restrict__ x = input_buffer + col * input_ldim + row_start;
+      auto* __restrict__ y = output_buffer + col * output_ldim + row_start;
+      for (El::Int row = 0; row < channel_size; ++row) {
+        y[row] = a * x[row] + b;
       }
     }
   }
@@ -208,40 +358,35 @@ void batch_normalization_layer<TensorDataType, T_layout, Dev>::bp_compute()
   const int correction = this->m_bessel_correction ? 1 : 0;
 
   // Compute local gradients
+  //   sum_dy = sum(dy_i)
+  //   sum_dy_xc = sum(dy_i * (x_i - mean))
+  //   dL/dscale = sum_dy_xc / sqrt(var+epsilon)
+  //   dL/dbias = sum_dy
+  //   dL/dmean = - scale * sum_dy / sqrt(var+epsilon)
+  //   dL/dvar = - scale * sum_dy_xc * (var+epsilon)^(-3/2) / 2
+  channel_centered_sums<TensorDataType>(
+    local_input.LockedBuffer(),
+    local_input.LDim(),
+    local_gradient_wrt_output.LockedBuffer(),
+    local_gradient_wrt_output.LDim(),
+    local_width,
+    local_mean.LockedBuffer(),
+    num_channels,
+    channel_size,
+    local_bias_gradient.Buffer(),
+    local_scale_gradient.Buffer());
   LBANN_OMP_PARALLEL_FOR
   for (El::Int channel = 0; channel < num_channels; ++channel) {
-
-    // Initialize channel parameters and gradients
-    const auto& mean = local_mean(channel, 0);
     const auto& var = local_var(channel, 0);
     const auto& scale = local_scale(channel, 0);
     const TensorDataType inv_stdev =
       static_cast<TensorDataType>(1 / El::Sqrt(var + this->m_epsilon));
     const auto& dvar_factor = inv_stdev * inv_stdev * inv_stdev / 2;
-    TensorDataType dmean = El::TypeTraits<TensorDataType>::Zero();
-    TensorDataType dvar = El::TypeTraits<TensorDataType>::Zero();
-    TensorDataType dscale = El::TypeTraits<TensorDataType>::Zero();
-    TensorDataType dbias = El::TypeTraits<TensorDataType>::Zero();
-
-    // Compute gradient contributions from local entries
-    const auto& row_start = channel * channel_size;
-    const auto& row_end = (channel + 1) * channel_size;
-    for (El::Int col = 0; col < local_width; ++col) {
-      for (El::Int row = row_start; row < row_end; ++row) {
-        const auto& x = local_input(row, col);
-        const auto& xhat = (x - mean) * inv_stdev;
-        const auto& dy = local_gradient_wrt_output(row, col);
-        dscale += dy * xhat;
-        dbias += dy;
-        const auto& dxhat = dy * scale;
-        dmean += -dxhat * inv_stdev;
-        dvar += -dxhat * (x - mean) * dvar_factor;
-      }
-    }
-    local_mean_gradient(channel, 0) = dmean;
-    local_var_gradient(channel, 0) = dvar;
-    local_scale_gradient(channel, 0) = dscale;
-    local_bias_gradient(channel, 0) = dbias;
+    const auto sum_dy = local_bias_gradient(channel, 0);
+    const auto sum_dy_xc = local_scale_gradient(channel, 0);
+    local_mean_gradient(channel, 0) = -scale * sum_dy * inv_stdev;
+    local_var_gradient(channel, 0) = -scale * sum_dy_xc * dvar_factor;
+    local_scale_gradient(channel, 0) = sum_dy_xc * inv_stdev;
   }
 
   // Accumulate gradients
@@ -296,32 +441,46 @@ void batch_normalization_layer<TensorDataType, T_layout, Dev>::bp_compute()
     El::Zero(local_gradient_wrt_input);
   }
   else {
+    // Fold error signal into per-channel coefficients
+    //   dL/dx = a * dL/dy + b * (x - mean) + c
+    std::vector<TensorDataType> coeffs(3 * num_channels);
     LBANN_OMP_PARALLEL_FOR
     for (El::Int channel = 0; channel < num_channels; ++channel) {
-
-      // Initialize channel parameters and gradients
-      const auto& mean = local_mean(channel, 0);
       const auto& var = local_var(channel, 0);
       const auto& scale = local_scale(channel, 0);
       const auto& dmean = local_mean_gradient(channel, 0);
       const auto& dvar = local_var_gradient(channel, 0);
-
-      // Compute useful constants
       const TensorDataType inv_stdev =
         static_cast<TensorDataType>(1 / El::Sqrt(var + this->m_epsilon));
-      const auto& dmean_term = dmean / num_per_sum;
-      const auto& dvar_term = dvar * 2 / (num_per_sum - correction);
+      coeffs[3 * channel] = scale * inv_stdev;
+      coeffs[3 * channel + 1] = dvar * 2 / (num_per_sum - correction);
+      coeffs[3 * channel + 2] = dmean / num_per_sum;
+    }
 
-      // Compute error signal for current channel
-      const auto& row_start = channel * channel_size;
-      const auto& row_end = (channel + 1) * channel_size;
-      for (El::Int col = 0; col < local_width; ++col) {
-        for (El::Int row = row_start; row < row_end; ++row) {
-          const auto& x = local_input(row, col);
-          const auto& dy = local_gradient_wrt_output(row, col);
-          const auto& dxhat = dy * scale;
-          auto& dx = local_gradient_wrt_input(row, col);
-          dx = dxhat * inv_stdev + dmean_term + dvar_term * (x - mean);
+    // Compute error signal
+    const TensorDataType* input_buffer = local_input.LockedBuffer();
+    const El::Int input_ldim = local_input.LDim();
+    const TensorDataType* output_grad_buffer =
+      local_gradient_wrt_output.LockedBuffer();
+    const El::Int output_grad_ldim = local_gradient_wrt_output.LDim();
+    TensorDataType* input_grad_buffer = local_gradient_wrt_input.Buffer();
+    const El::Int input_grad_ldim = local_gradient_wrt_input.LDim();
+    LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+    for (El::Int col = 0; col < local_width; ++col) {
+      for (El::Int channel = 0; channel < num_channels; ++channel) {
+        const auto mean = local_mean(channel, 0);
+        const auto a = coeffs[3 * channel];
+        const auto b = coeffs[3 * channel + 1];
+        const auto c = coeffs[3 * channel + 2];
+        const El::Int row_start = channel * channel_size;
+        const auto* __restrict__ x =
+          input_buffer + col * input_ldim + row_start;
+        const auto* __restrict__ dy =
+          output_grad_buffer + col * output_grad_ldim + row_start;
+        auto* __restrict__ dx =
+          input_grad_buffer + col * input_grad_ldim + row_start;
+        for (El::Int row = 0; row < channel_size; ++row) {
+          dx[row] = a * dy[row] + b * (x[row] - mean) + c;
         }
       }
     }
@@ -35,7 +35,8 @@ void dropout<TensorDataType, Layout, Device>::serialize(ArchiveT& ar)
   using DataTypeLayer = data_type_layer<TensorDataType>;
   ar(::cereal::make_nvp("DataTypeLayer",
                         ::cereal::base_class<DataTypeLayer>(this)),
-     CEREAL_NVP(m_keep_prob));
+     CEREAL_NVP(m_keep_prob),
+     CEREAL_NVP(m_regenerate_mask));
 }
 
 } // namespace lbann
@@ -38,7 +38,8 @@ void selu_dropout<TensorDataType, Layout, Device>::serialize(ArchiveT& ar)
      CEREAL_NVP(m_alpha_prime),
      CEREAL_NVP(m_a),
      CEREAL_NVP(m_b),
-     CEREAL_NVP(m_keep_prob));
+     CEREAL_NVP(m_keep_prob),
+     CEREAL_NVP(m_regenerate_mask));
 }
 
 } // namespace lbann
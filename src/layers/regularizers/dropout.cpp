@@ -37,6 +37,33 @@
 
 namespace lbann {
 
+namespace {
+
+/** Multiply a local matrix by a scaled Bernoulli mask in one pass. */
+template <typename TensorDataType>
+void apply_dropout_mask(uint64_t seed,
+                        EvalType keep_prob,
+                        const El::AbstractMatrix<TensorDataType>& input,
+                        El::AbstractMatrix<TensorDataType>& output)
+{
+  const TensorDataType scale = static_cast<TensorDataType>(1 / keep_prob);
+  const TensorDataType zero = El::TypeTraits<TensorDataType>::Zero();
+  philox::apply_bernoulli_mask(
+    philox::make_key(seed),
+    philox::bernoulli_threshold(keep_prob),
+    input.Height(),
+    input.Width(),
+    input.LockedBuffer(),
+    input.LDim(),
+    output.Buffer(),
+    output.LDim(),
+    [scale, zero](const TensorDataType& x, bool keep) {
+      return keep ? x * scale : zero;
+    });
+}
+
+} // namespace
+
 template <typename TensorDataType, data_layout layout, El::Device device>
 void dropout<TensorDataType, layout, device>::fp_compute_cpu()
 {
@@ -53,6 +80,16 @@ void dropout<TensorDataType, layout, device>::fp_compute_cpu()
     return;
   }
 
+  // Generate mask and apply it in a single pass
+  if (m_regenerate_mask) {
+    m_mask_seed = philox::draw_seed();
+    apply_dropout_mask(m_mask_seed,
+                       m_keep_prob,
+                       input.LockedMatrix(),
+                       output.Matrix());
+    return;
+  }
+
   // Construct mask matrix
   const TensorDataType scale = static_cast<TensorDataType>(1 / m_keep_prob);
   const auto& height = input.Height();
@@ -62,15 +99,20 @@ void dropout<TensorDataType, layout, device>::fp_compute_cpu()
   bernoulli_fill_procdet(*m_mask, height, width, TensorDataType(m_keep_prob));
   El::Scale(scale, *m_mask);
 #else
-  El::EntrywiseMap(
-    *m_mask,
-    (std::function<TensorDataType(
-       const TensorDataType&)>)([this, scale](
-                                  const TensorDataType& z) -> TensorDataType {
-      auto& gen = get_fast_generator();
-      std::bernoulli_distribution dist(m_keep_prob);
-      return dist(gen) ? scale : El::TypeTraits<TensorDataType>::Zero();
-    }));
+  m_mask_seed = philox::draw_seed();
+  auto& local_mask = m_mask->Matrix();
+  philox::apply_bernoulli_mask(
+    philox::make_key(m_mask_seed),
+    philox::bernoulli_threshold(m_keep_prob),
+    local_mask.Height(),
+    local_mask.Width(),
+    local_mask.LockedBuffer(),
+    local_mask.LDim(),
+    local_mask.Buffer(),
+    local_mask.LDim(),
+    [scale](const TensorDataType&, bool keep) {
+      return keep ? scale : El::TypeTraits<TensorDataType>::Zero();
+    });
 #endif // LBANN_DETERMINISTIC
 
   // Apply mask matrix to get activations
@@ -88,6 +130,12 @@ void dropout<TensorDataType, layout, device>::bp_compute_cpu()
   if (mode != execution_mode::training || m_keep_prob < EvalType(0)) {
     El::Copy(gradient_wrt_output, gradient_wrt_input);
   }
+  else if (m_regenerate_mask) {
+    apply_dropout_mask(m_mask_seed,
+                       m_keep_prob,
+                       gradient_wrt_output.LockedMatrix(),
+                       gradient_wrt_input.Matrix());
+  }
   else {
     El::Hadamard(gradient_wrt_output, *m_mask, gradient_wrt_input);
   }
@@ -176,7 +224,8 @@ build_dropout_layer_from_pbuf(lbann_comm* comm,
 {
   const auto& params = layer_msg.dropout();
   return std::make_unique<dropout_layer<TensorDataType, layout, device>>(
-    params.keep_prob());
+    params.keep_prob(),
+    params.regenerate_mask());
 }
 
 template <typename T, data_layout L, El::Device D>
@@ -185,6 +234,7 @@ void dropout<T, L, D>::write_specific_proto(lbann_data::Layer& proto) const
   proto.set_datatype(proto::ProtoDataType<T>);
   auto* msg = proto.mutable_dropout();
   msg->set_keep_prob(m_keep_prob);
+  msg->set_regenerate_mask(m_regenerate_mask);
 }
 
 #define PROTO_DEVICE(T, Device)                                                \
@@ -28,15 +28,90 @@
 #include "lbann/layers/regularizers/layer_norm.hpp"
 #include "lbann/comm_impl.hpp"
 #include "lbann/optimizers/optimizer.hpp"
+#include "lbann/utils/moments.hpp"
+#include "lbann/utils/omp_pragma.hpp"
 
 #ifdef LBANN_HAS_DISTCONV
 #include "lbann/layers/data_type_distconv_adapter.hpp"
 #endif // LBANN_HAS_DISTCONV
 
+#include <algorithm>
+#include <vector>
+
 namespace lbann {
 
 namespace {
 
+/** @brief Normalize and apply affine transform to one group */
+template <typename TensorDataType, bool HasScale, bool HasBias>
+void apply_layer_norm(const TensorDataType* __restrict__ x,
+                      TensorDataType* __restrict__ y,
+                      El::Int size,
+                      TensorDataType mean,
+                      TensorDataType inv_stdev,
+                      const TensorDataType* __restrict__ scale,
+                      const TensorDataType* __restrict__ bias)
+{
+  for (El::Int k = 0; k < size; ++k) {
+    TensorDataType result = (x[k] - mean) * inv_stdev;
+    if constexpr (HasScale) {
+      result *= scale[k];
+    }
+    if constexpr (HasBias) {
+      result += bias[k];
+    }
+    y[k] = result;
+  }
+}
+
+/** @brief Backprop reductions for one group
+ *
+ *  Computes sum(dL/dy_i * s_i) and sum(dL/dy_i * s_i * (x_i-mean)),
+ *  where s is the scale, and accumulates the group's contributions
+ *  to the scale and bias gradients in the same sweep.
+ */
+template <typename TensorDataType, bool HasScale, bool HasBias>
+void bp_group_sums(const TensorDataType* __restrict__ x,
+                   const TensorDataType* __restrict__ dy,
+                   El::Int size,
+                   TensorDataType mean,
+                   TensorDataType inv_stdev,
+                   const TensorDataType* __restrict__ scale,
+                   TensorDataType* __restrict__ scale_grad,
+                   TensorDataType* __restrict__ bias_grad,
+                   TensorDataType& sum_dy,
+                   TensorDataType& sum_dy_xc)
+{
+  TensorDataType acc_dy[reduction_lanes] = {};
+  TensorDataType acc_dy_xc[reduction_lanes] = {};
+  auto step = [&](El::Int k, El::Int lane) {
+    const TensorDataType xc = x[k] - mean;
+    TensorDataType g = dy[k];
+    if constexpr (HasBias) {
+      bias_grad[k] += g;
+    }
+    if constexpr (HasScale) {
+      scale_grad[k] += g * xc * inv_stdev;
+      g *= scale[k];
+    }
+    acc_dy[lane] += g;
+    acc_dy_xc[lane] += g * xc;
+  };
+  const El::Int size_vec = size - size % reduction_lanes;
+  for (El::Int k = 0; k < size_vec; k += reduction_lanes) {
+    for (El::Int l = 0; l < reduction_lanes; ++l) {
+      step(k + l, l);
+    }
+  }
+  for (El::Int k = size_vec; k < size; ++k) {
+    step(k, 0);
+  }
+  for (El::Int l = 0; l < reduction_lanes; ++l) {
+    sum_dy += acc_dy[l];
+    sum_dy_xc += acc_dy_xc[l];
+  }
+}
+
 /** @brief Forward prop */
 template <typename TensorDataType>
 void fp_impl(lbann_comm& comm,
@@ -64,52 +139,70 @@ void fp_impl(lbann_comm& comm,
   auto& local_output = dynamic_cast<CPUMatType&>(output.Matrix());
   auto& local_statistics = dynamic_cast<CPUMatType&>(statistics.Matrix());
   auto local_means =
-    El::LockedView(local_statistics, El::IR(0, num_normalized), El::ALL);
-  auto local_vars = El::LockedView(local_statistics,
-                                   El::IR(num_normalized, 2 * num_normalized),
-                                   El::ALL);
+    El::View(local_statistics, El::IR(0, num_normalized), El::ALL);
+  auto local_vars =
+    El::View(local_statistics, El::IR(num_normalized, 2 * num_normalized),
+             El::ALL);
 
   // Dimensions
   const El::Int local_num_samples = local_input.Width();
-
-  // Compute sums
-  El::Zero(statistics);
+  const TensorDataType* input_buffer = local_input.LockedBuffer();
+  const El::Int input_ldim = local_input.LDim();
+  TensorDataType* output_buffer = local_output.Buffer();
+  const El::Int output_ldim = local_output.LDim();
+
+  // Compute local statistics in a single pass over the input
+  //   local_means = mean(x_i)
+  //   local_vars = sum( (x_i - mean)^2 )
   LBANN_OMP_PARALLEL_FOR_COLLAPSE2
   for (El::Int i = 0; i < local_num_samples; ++i) {
     for (El::Int j = 0; j < num_normalized; ++j) {
-      auto& sum = local_means(j, i);
-      auto& sqsum = local_vars(j, i);
-      for (El::Int k = 0; k < normalization_size; ++k) {
-        const auto& x = local_input(k + j * normalization_stride, i);
-        sum += x;
-        sqsum += x * x;
+      const auto m = compute_moments(
+        input_buffer + i * input_ldim + j * normalization_stride,
+        normalization_size);
+      local_means(j, i) = m.mean;
+      local_vars(j, i) = m.m2;
+    }
+  }
+
+  // Combine statistics from other processes
+  //   mean = sum( n_p * mean_p ) / n
+  //   M2 = sum( M2_p + n_p * (mean_p - mean)^2 )
+  const auto& redundant_comm = statistics.RedundantComm();
+  if (El::mpi::Size(redundant_comm) > 1) {
+    const auto local_size_dt = El::To<TensorDataType>(normalization_size);
+    const auto global_size_dt =
+      El::To<TensorDataType>(global_normalization_size);
+    CPUMatType local_partial_means;
+    El::Copy(local_means, local_partial_means);
+    El::Scale(local_size_dt / global_size_dt, local_means);
+    comm.allreduce(static_cast<El::AbstractMatrix<TensorDataType>&>(
+                     local_means),
+                   redundant_comm,
+                   El::mpi::SUM);
+    LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+    for (El::Int i = 0; i < local_num_samples; ++i) {
+      for (El::Int j = 0; j < num_normalized; ++j) {
+        const auto delta = local_partial_means(j, i) - local_means(j, i);
+        local_vars(j, i) += local_size_dt * delta * delta;
       }
     }
+    comm.allreduce(static_cast<El::AbstractMatrix<TensorDataType>&>(
+                     local_vars),
+                   redundant_comm,
+                   El::mpi::SUM);
   }
-  comm.allreduce(statistics, statistics.RedundantComm(), El::mpi::SUM);
 
-  // Compute statistics from sums
-  //   mean = sum(x_i) / n
-  //   var = ( sum(x_i^2)/n - mean^2 )
+  // Compute variances
+  //   var = M2 / n
   if (global_normalization_size <= 1) {
     // local_means already has correct values
     El::Fill(local_vars, El::TypeTraits<TensorDataType>::One());
   }
   else {
-    LBANN_OMP_PARALLEL_FOR_COLLAPSE2
-    for (El::Int i = 0; i < local_num_samples; ++i) {
-      for (El::Int j = 0; j < num_normalized; ++j) {
-        const auto sum = local_means(j, i);
-        const auto sqsum = local_vars(j, i);
-        auto sample_size_dt = El::To<TensorDataType>(global_normalization_size);
-        const auto& mean = sum / sample_size_dt;
-        const auto& sqmean = sqsum / sample_size_dt;
-        const auto& var = (sqmean - mean * mean);
-        local_means(j, i) = mean;
-        local_vars(j, i) =
-          std::max(var, El::TypeTraits<TensorDataType>::Zero());
-      }
-    }
+    El::Scale(El::TypeTraits<TensorDataType>::One() /
+                El::To<TensorDataType>(global_normalization_size),
+              local_vars);
   }
 
   // Apply layer norm
@@ -121,15 +214,23 @@ void fp_impl(lbann_comm& comm,
       const auto& var = local_vars(j, i);
       const TensorDataType inv_stdev =
         El::TypeTraits<TensorDataType>::One() / El::Sqrt(var + epsilon);
-      for (El::Int k = 0; k < normalization_size; ++k) {
-        const auto& x = local_input(k + j * normalization_stride, i);
-        auto& y = local_output(k + j * normalization_stride, i);
-        TensorDataType result = (x - mean) * inv_stdev;
-        if (local_scale)
-          result *= local_scale[k];
-        if (local_bias)
-          result += local_bias[k];
-        y = result;
+      const auto* x = input_buffer + i * input_ldim + j * normalization_stride;
+      auto* y = output_buffer + i * output_ldim + j * normalization_stride;
+      if (local_scale && local_bias) {
+        apply_layer_norm<TensorDataType, true, true>(
+          x, y, normalization_size, mean, inv_stdev, local_scale, local_bias);
+      }
+      else if (local_scale) {
+        apply_layer_norm<TensorDataType, true, false>(
+          x, y, normalization_size, mean, inv_stdev, local_scale, local_bias);
+      }
+      else if (local_bias) {
+        apply_layer_norm<TensorDataType, false, true>(
+          x, y, normalization_size, mean, inv_stdev, local_scale, local_bias);
+      }
+      else {
+        apply_layer_norm<TensorDataType, false, false>(
+          x, y, normalization_size, mean, inv_stdev, local_scale, local_bias);
       }
     }
   }
@@ -183,6 +284,12 @@ void bp_impl(lbann_comm& comm,
 
   // Dimensions
   const El::Int local_num_samples = local_input.Width();
+  const TensorDataType* input_buffer = local_input.LockedBuffer();
+  const El::Int input_ldim = local_input.LDim();
+  const TensorDataType* output_grad_buffer = local_output_grad.LockedBuffer();
+  const El::Int output_grad_ldim = local_output_grad.LDim();
+  TensorDataType* input_grad_buffer = local_input_grad.Buffer();
+  const El::Int input_grad_ldim = local_input_grad.LDim();
 
   // Trivial case if sample size <= 1
   // Note: Output is constant, so error signal is zero.
@@ -194,35 +301,104 @@ void bp_impl(lbann_comm& comm,
   // Compute gradient w.r.t. statistics
   //   dL/dmean = - sum(dL/dy_i) / sqrt(var+epsilon)
   //   dL/dvar = - sum(dL/dy_i * (x_i-mean)) * (var+epsilon)^(-3/2) / 2
-  El::Zero(statistics_grad);
-  LBANN_OMP_PARALLEL_FOR_COLLAPSE2
-  for (El::Int i = 0; i < local_num_samples; ++i) {
-    for (El::Int j = 0; j < num_normalized; ++j) {
+  // Note: Groups are split into a fixed number of blocks, each with
+  // its own scale and bias gradient buffers, so the weight gradients
+  // are accumulated without atomics and in a deterministic order.
+  const El::Int num_groups = local_num_samples * num_normalized;
+  const El::Int num_blocks =
+    std::max(El::Int{1},
+             std::min(static_cast<El::Int>(omp_get_max_threads()),
+                      num_groups));
+  std::vector<TensorDataType> block_scale_grads(
+    scale_grad ? num_blocks * normalization_size : 0,
+    El::TypeTraits<TensorDataType>::Zero());
+  std::vector<TensorDataType> block_bias_grads(
+    bias_grad ? num_blocks * normalization_size : 0,
+    El::TypeTraits<TensorDataType>::Zero());
+  LBANN_OMP_PARALLEL_FOR
+  for (El::Int block = 0; block < num_blocks; ++block) {
+    auto* block_scale_grad =
+      scale_grad ? &block_scale_grads[block * normalization_size] : nullptr;
+    auto* block_bias_grad =
+      bias_grad ? &block_bias_grads[block * normalization_size] : nullptr;
+    const El::Int group_start = (block * num_groups) / num_blocks;
+    const El::Int group_end = ((block + 1) * num_groups) / num_blocks;
+    for (El::Int group = group_start; group < group_end; ++group) {
+      const El::Int i = group / num_normalized;
+      const El::Int j = group % num_normalized;
       const auto& mean = local_means(j, i);
       const auto& var = local_vars(j, i);
       const TensorDataType inv_stdev =
         El::TypeTraits<TensorDataType>::One() / El::Sqrt(var + epsilon);
-      auto& dmean = local_means_grad(j, i);
-      auto& dvar = local_vars_grad(j, i);
-      for (El::Int k = 0; k < normalization_size; ++k) {
-        const auto& x = local_input(k + j * normalization_stride, i);
-        auto dy = local_output_grad(k + j * normalization_stride, i);
-
-        if (bias_grad) {
-          LBANN_OMP_ATOMIC
-          bias_grad[k] += dy;
-        }
+      const auto* x = input_buffer + i * input_ldim + j * normalization_stride;
+      const auto* dy =
+        output_grad_buffer + i * output_grad_ldim + j * normalization_stride;
+      auto sum_dy = El::TypeTraits<TensorDataType>::Zero();
+      auto sum_dy_xc = El::TypeTraits<TensorDataType>::Zero();
+      if (scale_grad && bias_grad) {
+        bp_group_sums<TensorDataType, true, true>(x,
+                                                  dy,
+                                                  normalization_size,
+                                                  mean,
+                                                  inv_stdev,
+                                                  local_scale,
+                                                  block_scale_grad,
+                                                  block_bias_grad,
+                                                  sum_dy,
+                                                  sum_dy_xc);
+      }
+      else if (scale_grad) {
+        bp_group_sums<TensorDataType, true, false>(x,
+                                                   dy,
+                                                   normalization_size,
+                                                   mean,
+                                                   inv_stdev,
+                                                   local_scale,
+                                                   block_scale_grad,
+                                                   block_bias_grad,
+                                                   sum_dy,
+                                                   sum_dy_xc);
+      }
+      else if (bias_grad) {
+        bp_group_sums<TensorDataType, false, true>(x,
+                                                   dy,
+                                                   normalization_size,
+                                                   mean,
+                                                   inv_stdev,
+                                                   local_scale,
+                                                   block_scale_grad,
+                                                   block_bias_grad,
+                                                   sum_dy,
+                                                   sum_dy_xc);
+      }
+      else {
+        bp_group_sums<TensorDataType, false, false>(x,
+                                                    dy,
+                                                    normalization_size,
+                                                    mean,
+                                                    inv_stdev,
+                                                    local_scale,
+                                                    block_scale_grad,
+                                                    block_bias_grad,
+                                                    sum_dy,
+                                                    sum_dy_xc);
+      }
+      local_means_grad(j, i) = -sum_dy * inv_stdev;
+      local_vars_grad(j, i) =
+        -sum_dy_xc * inv_stdev * inv_stdev * inv_stdev / 2;
+    }
+  }
+  if (scale_grad || bias_grad) {
+    LBANN_OMP_PARALLEL_FOR
+    for (El::Int k = 0; k < normalization_size; ++k) {
+      for (El::Int block = 0; block < num_blocks; ++block) {
         if (scale_grad) {
-          LBANN_OMP_ATOMIC
-          scale_grad[k] += dy * (x - mean) * inv_stdev;
-          dy *= local_scale[k];
+          scale_grad[k] += block_scale_grads[block * normalization_size + k];
+        }
+        if (bias_grad) {
+          bias_grad[k] += block_bias_grads[block * normalization_size + k];
         }
-
-        dmean += dy;
-        dvar += dy * (x - mean);
       }
-      dmean *= -inv_stdev;
-      dvar *= -inv_stdev * inv_stdev * inv_stdev / 2;
     }
   }
   comm.allreduce(statistics_grad,
@@ -233,25 +409,34 @@ void bp_impl(lbann_comm& comm,
   //   dL/dx_i = ( dL/dy_i / sqrt(var+epsilon)
   //             + dL/dmean / n
   //             + dL/dvar * (x_i - mean) * 2/(n-1) )
+  const auto inv_size =
+    El::TypeTraits<TensorDataType>::One() /
+    El::To<TensorDataType>(global_normalization_size);
   LBANN_OMP_PARALLEL_FOR_COLLAPSE2
   for (El::Int i = 0; i < local_num_samples; ++i) {
     for (El::Int j = 0; j < num_normalized; ++j) {
-      const auto& mean = local_means(j, i);
-      const auto& var = local_vars(j, i);
+      const auto mean = local_means(j, i);
+      const auto var = local_vars(j, i);
       const TensorDataType inv_stdev =
         El::TypeTraits<TensorDataType>::One() / El::Sqrt(var + epsilon);
-      const auto& dmean = local_means_grad(j, i);
-      const auto& dvar = local_vars_grad(j, i);
-      for (El::Int k = 0; k < normalization_size; ++k) {
-        const auto& x = local_input(k + j * normalization_stride, i);
-        auto dy = local_output_grad(k + j * normalization_stride, i);
-        auto& dx = local_input_grad(k + j * normalization_stride, i);
-
-        if (local_scale)
-          dy *= local_scale[k];
-
-        dx = (dy * inv_stdev + dmean / global_normalization_size +
-              dvar * (x - mean) * 2 / global_normalization_size);
+      const auto dmean_term = local_means_grad(j, i) * inv_size;
+      const auto dvar_term = local_vars_grad(j, i) * 2 * inv_size;
+      const auto* __restrict__ x =
+        input_buffer + i * input_ldim + j * normalization_stride;
+      const auto* __restrict__ dy =
+        output_grad_buffer + i * output_grad_ldim + j * normalization_stride;
+      auto* __restrict__ dx =
+        input_grad_buffer + i * input_grad_ldim + j * normalization_stride;
+      if (local_scale) {
+        for (El::Int k = 0; k < normalization_size; ++k) {
+          dx[k] = (dy[k] * local_scale[k] * inv_stdev + dmean_term +
+                   dvar_term * (x[k] - mean));
+        }
+      }
+      else {
+        for (El::Int k = 0; k < normalization_size; ++k) {
+          dx[k] = dy[k] * inv_stdev + dmean_term + dvar_term * (x[k] - mean);
+        }
       }
     }
   }
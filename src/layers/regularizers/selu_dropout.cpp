@@ -46,18 +46,29 @@ lbann::build_selu_dropout_layer_from_pbuf(lbann_comm* comm,
   if (params.alpha() != 0.0 && params.scale() != 0.0) {
     auto const alpha = El::To<T>(params.alpha());
     auto const scale = El::To<T>(params.scale());
-    return std::make_unique<selu_dropout<T, L, D>>(keep_prob, alpha, scale);
+    return std::make_unique<selu_dropout<T, L, D>>(keep_prob,
+                                                   alpha,
+                                                   scale,
+                                                   params.regenerate_mask());
   }
   else {
-    return std::make_unique<selu_dropout<T, L, D>>(keep_prob);
+    auto layer = std::make_unique<selu_dropout<T, L, D>>(keep_prob);
+    layer->set_regenerate_mask(params.regenerate_mask());
+    return layer;
   }
 }
 
 namespace lbann {
 
 template <typename T, data_layout L, El::Device D>
-selu_dropout<T, L, D>::selu_dropout(T keep_prob, T alpha, T scale)
-  : data_type_layer<T>(nullptr), m_keep_prob(keep_prob), m_mask(nullptr)
+selu_dropout<T, L, D>::selu_dropout(T keep_prob,
+                                    T alpha,
+                                    T scale,
+                                    bool regenerate_mask)
+  : data_type_layer<T>(nullptr),
+    m_keep_prob(keep_prob),
+    m_regenerate_mask(regenerate_mask),
+    m_mask(nullptr)
 {
 #ifdef LBANN_DETERMINISTIC
   LBANN_WARNING("selu_dropout: deterministic dropout not supported");
@@ -77,6 +88,8 @@ selu_dropout<T, L, D>::selu_dropout(const selu_dropout& other)
     m_a(other.m_a),
     m_b(other.m_b),
     m_keep_prob(other.m_keep_prob),
+    m_regenerate_mask(other.m_regenerate_mask),
+    m_mask_seed(other.m_mask_seed),
     m_mask(other.m_mask)
 {
   if (m_mask != nullptr) {
@@ -93,6 +106,8 @@ auto selu_dropout<T, L, D>::operator=(const selu_dropout& other)
   m_a = other.m_a;
   m_b = other.m_b;
   m_keep_prob = other.m_keep_prob;
+  m_regenerate_mask = other.m_regenerate_mask;
+  m_mask_seed = other.m_mask_seed;
   if (m_mask != nullptr) {
     delete m_mask;
   }
@@ -143,6 +158,7 @@ void selu_dropout<T, L, D>::write_specific_proto(lbann_data::Layer& proto) const
   msg->set_keep_prob(m_keep_prob);
   msg->set_alpha(-m_alpha_prime);
   msg->set_scale(El::To<T>(1));
+  msg->set_regenerate_mask(m_regenerate_mask);
 }
 
 template <typename T, data_layout L, El::Device D>
@@ -156,10 +172,19 @@ template <typename T, data_layout L, El::Device D>
 void selu_dropout<T, L, D>::setup_data(size_t max_mini_batch_size)
 {
   data_type_layer<T>::setup_data(max_mini_batch_size);
+  if (m_regenerate_mask && D != El::Device::CPU) {
+    LBANN_ERROR(this->get_type(),
+                " layer \"",
+                this->get_name(),
+                "\" can only regenerate its dropout mask on CPU");
+  }
   if (m_mask != nullptr) {
     delete m_mask;
+    m_mask = nullptr;
+  }
+  if (!m_regenerate_mask) {
+    m_mask = this->get_activations().Copy();
   }
-  m_mask = this->get_activations().Copy();
 }
 
 template <typename T, data_layout L, El::Device D>
@@ -173,6 +198,29 @@ void selu_dropout<T, L, D>::fp_compute()
   }
   else {
 
+    if (m_regenerate_mask) {
+      // Generate mask and apply the affine transform in a single pass.
+      m_mask_seed = philox::draw_seed();
+      const auto& local_input = this->get_local_prev_activations();
+      auto& local_output = this->get_local_activations();
+      const T a = m_a;
+      const T dropped = m_a * m_alpha_prime + m_b;
+      const T b = m_b;
+      philox::apply_bernoulli_mask(
+        philox::make_key(m_mask_seed),
+        philox::bernoulli_threshold(static_cast<double>(m_keep_prob)),
+        local_input.Height(),
+        local_input.Width(),
+        local_input.LockedBuffer(),
+        local_input.LDim(),
+        local_output.Buffer(),
+        local_output.LDim(),
+        [a, b, dropped](const T& x, bool keep) {
+          return keep ? a * x + b : dropped;
+        });
+      return;
+    }
+
     const auto* input_acts = &this->get_prev_activations();
     const El::Int height = input_acts->Height();
     const El::Int width = input_acts->Width();
@@ -206,6 +254,23 @@ void selu_dropout<T, L, D>::bp_compute()
       m_keep_prob < El::To<T>(0.0f)) {
     El::Copy(this->get_prev_error_signals(), this->get_error_signals());
   }
+  else if (m_regenerate_mask) {
+    const auto& local_prev_error_signal = this->get_local_prev_error_signals();
+    auto& local_error_signal = this->get_local_error_signals();
+    const T a = m_a;
+    philox::apply_bernoulli_mask(
+      philox::make_key(m_mask_seed),
+      philox::bernoulli_threshold(static_cast<double>(m_keep_prob)),
+      local_prev_error_signal.Height(),
+      local_prev_error_signal.Width(),
+      local_prev_error_signal.LockedBuffer(),
+      local_prev_error_signal.LDim(),
+      local_error_signal.Buffer(),
+      local_error_signal.LDim(),
+      [a](const T& dy, bool keep) {
+        return keep ? a * dy : El::TypeTraits<T>::Zero();
+      });
+  }
   else {
 
     const auto& local_prev_error_signal = this->get_local_prev_error_signals();
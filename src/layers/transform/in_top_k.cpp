@@ -28,9 +28,9 @@
 #include "lbann/layers/transform/in_top_k.hpp"
 
 #include "lbann/comm_impl.hpp"
+#include "lbann/utils/sort_kernels.hpp"
 
 #include <algorithm>
-#include <limits>
 
 namespace lbann {
 
@@ -38,29 +38,7 @@ namespace {
 
 /** Sparse vector entry. */
 template <typename TensorDataType>
-struct entry
-{
-
-  /** Vector entry value. */
-  TensorDataType value = min_value;
-  /** Vector entry index. */
-  El::Int index = max_index;
-
-  /** Minimum possible value. */
-  static constexpr TensorDataType min_value =
-    -std::numeric_limits<TensorDataType>::infinity();
-  /** Maximum possible index. */
-  static constexpr El::Int max_index = std::numeric_limits<El::Int>::max();
-
-  /** Comparison operation to sort vector entries.
-   *  Entries are sorted by value in decreasing order, with ties
-   *  broken in favor of entries with smaller indices.
-   */
-  static bool compare(const entry& a, const entry& b)
-  {
-    return a.value > b.value || (a.value == b.value && a.index < b.index);
-  }
-};
+using entry = sort_kernels::top_k_entry<TensorDataType, El::Int>;
 
 /** CPU implementation of in_top_k layer forward prop. */
 template <typename TensorDataType>
@@ -98,16 +76,12 @@ void fp_cpu(lbann_comm& comm,
   std::vector<entry<TensorDataType>> top_entries(local_width * k);
   LBANN_OMP_PARALLEL_FOR
   for (El::Int col = 0; col < local_width; ++col) {
-    std::vector<entry<TensorDataType>> local_entries(std::max(local_height, k));
-    for (El::Int row = 0; row < local_height; ++row) {
-      local_entries[row].value = local_input(row, col);
-      local_entries[row].index = input.GlobalRow(row);
-    }
-    std::partial_sort_copy(local_entries.begin(),
-                           local_entries.end(),
-                           &top_entries[col * k],
-                           &top_entries[col * k] + k,
-                           entry<TensorDataType>::compare);
+    sort_kernels::find_top_k(
+      local_input.LockedBuffer(0, col),
+      local_height,
+      k,
+      [&input](size_t row) { return input.GlobalRow(row); },
+      &top_entries[col * k]);
   }
 
   // Find top-k entries in each column of global input matrix
@@ -121,17 +95,11 @@ void fp_cpu(lbann_comm& comm,
                     col_comm);
     LBANN_OMP_PARALLEL_FOR
     for (El::Int col = 0; col < local_width; ++col) {
-      std::vector<entry<TensorDataType>> col_entries(col_comm_size * k);
-      for (El::Int rank = 0; rank < col_comm_size; ++rank) {
-        const auto* start =
-          &global_top_entries[rank * local_width * k + col * k];
-        std::copy(start, start + k, &col_entries[rank * k]);
-      }
-      std::partial_sort_copy(col_entries.begin(),
-                             col_entries.end(),
-                             &top_entries[col * k],
-                             &top_entries[col * k] + k,
-                             entry<TensorDataType>::compare);
+      sort_kernels::merge_top_k(&global_top_entries[col * k],
+                                col_comm_size,
+                                local_width * k,
+                                k,
+                                &top_entries[col * k]);
     }
   }
 
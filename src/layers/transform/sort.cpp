@@ -26,6 +26,9 @@
 
 #define LBANN_SORT_LAYER_INSTANTIATE
 #include "lbann/layers/transform/sort_impl.hpp"
+#include "lbann/utils/sort_kernels.hpp"
+
+#include <algorithm>
 
 namespace lbann {
 
@@ -43,23 +46,14 @@ void sort_layer<TensorDataType, T_layout, Dev>::fp_compute()
   // Sort each matrix column
   LBANN_OMP_PARALLEL_FOR
   for (El::Int col = 0; col < local_width; ++col) {
-    std::multimap<DataType, El::Int> sorted_list;
-    for (El::Int row = 0; row < local_height; ++row) {
-      sorted_list.emplace(local_input(row, col), row);
-    }
+    const auto* input = local_input.LockedBuffer(0, col);
+    auto* indices = local_indices.Buffer(0, col);
+    sort_kernels::argsort(input, local_height, indices);
     if (this->m_descending) {
-      auto&& it = sorted_list.rbegin();
-      for (El::Int row = 0; row < local_height; ++row, ++it) {
-        local_output(row, col) = it->first;
-        local_indices(row, col) = it->second;
-      }
+      std::reverse(indices, indices + local_height);
     }
-    else {
-      auto&& it = sorted_list.begin();
-      for (El::Int row = 0; row < local_height; ++row, ++it) {
-        local_output(row, col) = it->first;
-        local_indices(row, col) = it->second;
-      }
+    for (El::Int row = 0; row < local_height; ++row) {
+      local_output(row, col) = input[indices[row]];
     }
   }
 }
@@ -0,0 +1,279 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Catch2BasicSupport.hpp"
+
+#include "MPITestHelpers.hpp"
+#include "TestHelpers.hpp"
+
+#include <lbann/base.hpp>
+#include <lbann/layers/data_type_layer.hpp>
+#include <lbann/layers/operator_layer.hpp>
+#include <lbann/layers/transform/dummy.hpp>
+#include <lbann/models/model.hpp>
+#include <lbann/proto/lbann.pb.h>
+#include <lbann/proto/proto_common.hpp>
+#include <lbann/utils/lbann_library.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace {
+
+constexpr auto data_parallel = lbann::data_layout::DATA_PARALLEL;
+using OperatorLayerType =
+  lbann::OperatorLayer<float, float, data_parallel, El::Device::CPU>;
+using DummyLayerType =
+  lbann::dummy_layer<float, data_parallel, El::Device::CPU>;
+using StarMatrixType =
+  El::DistMatrix<float, El::STAR, El::STAR, El::ELEMENT, El::Device::CPU>;
+
+// Tensor height. Spans more than one block of the fused kernels.
+constexpr El::Int height = 300;
+
+std::string operators(std::string const& name)
+{
+  std::string const clamp = R"""(
+    ops {
+      parameters {
+        [type.googleapis.com/lbann_data.ClampOperator] { min: -0.8 max: 0.8 }
+      }
+    }
+)""";
+  std::string const add = R"""(
+    ops {
+      parameters {
+        [type.googleapis.com/lbann_data.AddConstantOperator] { constant: 0.25 }
+      }
+    }
+)""";
+  std::string const tanh = R"""(
+    ops {
+      parameters {
+        [type.googleapis.com/lbann_data.TanhOperator] {}
+      }
+    }
+)""";
+  std::string const scale = R"""(
+    ops {
+      parameters {
+        [type.googleapis.com/lbann_data.ScaleOperator] { constant: 3 }
+      }
+    }
+)""";
+  auto op_layer = [](std::string const& layer_name,
+                     std::string const& parent,
+                     std::string const& child,
+                     std::string const& ops) {
+    return "  layer {\n    name: \"" + layer_name + "\"\n    parents: \"" +
+           parent + "\"\n    children: \"" + child +
+           "\"\n    device_allocation: \"cpu\"\n    operator_layer {" + ops +
+           "    }\n  }\n";
+  };
+
+  // The fused layer applies all operators. The unfused chain applies
+  // one operator per layer.
+  if (name == "fused") {
+    return op_layer("fused", "slice", "fused_out", clamp + add + tanh + scale);
+  }
+  return op_layer("unfused1", "split", "unfused2", clamp) +
+         op_layer("unfused2", "unfused1", "unfused3", add) +
+         op_layer("unfused3", "unfused2", "unfused4", tanh) +
+         op_layer("unfused4", "unfused3", "unfused_out", scale);
+}
+
+// The fused layer reads rows [0,height) of the input through a slice
+// view, so its input is not contiguous. The unfused chain reads the
+// full input.
+std::string const model_prototext = R"""(
+model {
+  layer {
+    name: "inp"
+    children: "split"
+    weights: "dummy_inputs"
+    device_allocation: "cpu"
+    weights_layer {
+      dims: 600
+    }
+  }
+  layer {
+    name: "split"
+    parents: "inp"
+    children: "slice unfused1"
+    device_allocation: "cpu"
+    split {
+    }
+  }
+  layer {
+    name: "slice"
+    parents: "split"
+    children: "fused rest"
+    device_allocation: "cpu"
+    slice {
+      axis: 0
+      slice_points: 0
+      slice_points: 300
+      slice_points: 600
+    }
+  }
+  layer {
+    name: "rest"
+    parents: "slice"
+    device_allocation: "cpu"
+    elu {
+    }
+  }
+)""" + operators("fused") +
+                                     operators("unfused") + R"""(
+  layer {
+    name: "fused_out"
+    parents: "fused"
+    device_allocation: "cpu"
+    dummy {
+    }
+  }
+  layer {
+    name: "unfused_out"
+    parents: "unfused4"
+    device_allocation: "cpu"
+    dummy {
+    }
+  }
+  weights {
+    name: "dummy_inputs"
+    initializer {
+      uniform_initializer {
+        min: -2
+        max: 2
+      }
+    }
+  }
+}
+)""";
+
+std::unique_ptr<lbann::model> setup_model(const std::string& model_contents)
+{
+  auto& world_comm = unit_test::utilities::current_world_comm();
+  auto& g = world_comm.get_trainer_grid();
+
+  lbann_data::LbannPB pb;
+  REQUIRE_NOTHROW(lbann::read_prototext_string(model_contents, pb, true));
+
+  // Construct a trainer so that the model can register the input layer
+  lbann::construct_trainer(&world_comm, pb.mutable_trainer(), pb);
+  auto my_model = lbann::proto::construct_model(&world_comm,
+                                                pb.optimizer(),
+                                                pb.trainer(),
+                                                pb.model());
+  my_model->setup(1UL, {&g});
+  return my_model;
+}
+
+template <typename LayerT>
+LayerT& get_layer(lbann::model& m, std::string const& name)
+{
+  auto const layers = m.get_layers();
+  auto iter =
+    std::find_if(layers.cbegin(), layers.cend(), [&name](auto const* l) {
+      return l->get_name() == name;
+    });
+  REQUIRE(iter != layers.cend());
+  auto* layer = dynamic_cast<LayerT*>(*iter);
+  REQUIRE(layer != nullptr);
+  return *layer;
+}
+
+StarMatrixType gather(El::AbstractDistMatrix<float> const& x)
+{
+  StarMatrixType x_star(x.Grid(), x.Root());
+  El::Copy(x, x_star);
+  return x_star;
+}
+
+} // namespace
+
+TEST_CASE("Fused operator layer matches unfused operators",
+          "[mpi][layer][operator]")
+{
+  auto& world_comm = unit_test::utilities::current_world_comm();
+  auto& g = world_comm.get_trainer_grid();
+  lbann::utils::grid_manager mgr(g);
+
+  auto m = setup_model(model_prototext);
+  auto& fused = get_layer<OperatorLayerType>(*m, "fused");
+  auto& unfused1 = get_layer<OperatorLayerType>(*m, "unfused1");
+  auto& unfused4 = get_layer<OperatorLayerType>(*m, "unfused4");
+  REQUIRE(fused.has_fused_operators());
+  REQUIRE_FALSE(unfused1.has_fused_operators());
+  REQUIRE_FALSE(fused.runs_inplace());
+
+  // Forward prop
+  REQUIRE_NOTHROW(m->forward_prop(lbann::execution_mode::training));
+
+  // The fused layer reads a strided view of the input
+  auto const& local_input = fused.get_prev_activations().LockedMatrix();
+  CHECK(fused.get_prev_activations().Viewing());
+  if (local_input.Width() > 0) {
+    CHECK(local_input.LDim() > local_input.Height());
+  }
+
+  auto const fused_output = gather(fused.get_activations());
+  auto const unfused_output = gather(unfused4.get_activations());
+  REQUIRE(fused_output.Height() == height);
+  REQUIRE(fused_output.Width() == 1);
+  for (El::Int i = 0; i < height; ++i) {
+    CHECK(fused_output.Get(i, 0) ==
+          Approx(unfused_output.Get(i, 0)).margin(1e-6));
+  }
+
+  // Backprop the same gradient through both paths. The unfused chain
+  // gets zero gradient for the rows the fused layer does not read.
+  auto fused_grad = std::make_unique<StarMatrixType>(height, 1, g);
+  auto unfused_grad = std::make_unique<StarMatrixType>(2 * height, 1, g);
+  El::Zero(*unfused_grad);
+  for (El::Int i = 0; i < height; ++i) {
+    auto const dy = std::sin(0.1f * i);
+    fused_grad->Set(i, 0, dy);
+    unfused_grad->Set(i, 0, dy);
+  }
+  get_layer<DummyLayerType>(*m, "fused_out")
+    .set_error_signal(std::move(fused_grad));
+  get_layer<DummyLayerType>(*m, "unfused_out")
+    .set_error_signal(std::move(unfused_grad));
+  fused.set_keep_error_signals(true);
+  unfused1.set_keep_error_signals(true);
+  REQUIRE_NOTHROW(m->backward_prop(false));
+
+  auto const fused_grad_wrt_input = gather(fused.get_error_signals());
+  auto const unfused_grad_wrt_input = gather(unfused1.get_error_signals());
+  REQUIRE(fused_grad_wrt_input.Height() == height);
+  REQUIRE(unfused_grad_wrt_input.Height() == 2 * height);
+  for (El::Int i = 0; i < height; ++i) {
+    CHECK(fused_grad_wrt_input.Get(i, 0) ==
+          Approx(unfused_grad_wrt_input.Get(i, 0)).margin(1e-6));
+  }
+}
@@ -142,13 +142,22 @@ TEMPLATE_LIST_TEST_CASE("OperatorLayer lifecycle",
       layer = std::make_unique<OperatorLayer>(world_comm, std::move(ops)));
     CHECK(IsValidPtr(layer));
   }
-  SECTION("Constructing with multiple operators fails")
+  SECTION("Construct with multiple operators")
   {
-    LayerPtr layer = nullptr;
+    std::unique_ptr<OperatorLayer> layer = nullptr;
     std::vector<std::unique_ptr<OpType>> ops;
     ops.reserve(2);
     ops.push_back(std::make_unique<ClampOpType>(-1.0, 1.0));
     ops.push_back(std::make_unique<ClampOpType>(-0.5, 0.5));
+    REQUIRE_NOTHROW(
+      layer = std::make_unique<OperatorLayer>(world_comm, std::move(ops)));
+    REQUIRE(IsValidPtr(layer));
+    CHECK(layer->get_num_operators() == 2UL);
+  }
+  SECTION("Constructing without operators fails")
+  {
+    LayerPtr layer = nullptr;
+    std::vector<std::unique_ptr<OpType>> ops;
     REQUIRE_THROWS(
       layer = std::make_unique<OperatorLayer>(world_comm, std::move(ops)));
     CHECK_FALSE(IsValidPtr(layer));
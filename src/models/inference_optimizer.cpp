@@ -0,0 +1,354 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "lbann/models/inference_optimizer.hpp"
+
+#include "lbann/layers/learning/convolution.hpp"
+#include "lbann/layers/learning/fully_connected.hpp"
+#include "lbann/layers/operator_layer.hpp"
+#include "lbann/layers/regularizers/batch_normalization.hpp"
+#include "lbann/metrics/metric.hpp"
+#include "lbann/models/model.hpp"
+#include "lbann/objective_functions/objective_function.hpp"
+#include "lbann/utils/exception.hpp"
+#include "lbann/weights/data_type_weights.hpp"
+
+#include <cmath>
+#include <functional>
+#include <string>
+#include <unordered_set>
+
+namespace lbann {
+namespace {
+
+/** @brief Deferred write of folded weights values.
+ *
+ *  Applied after the model is set up again, once bias weights added
+ *  during folding have been allocated.
+ */
+using weights_update = std::function<void()>;
+
+/** @brief Layers whose outputs are used outside of the layer graph. */
+std::unordered_set<Layer const*> get_protected_layers(model& m)
+{
+  std::unordered_set<Layer const*> layers;
+  for (auto const& l : m.get_objective_function()->get_layer_pointers()) {
+    layers.insert(l.lock().get());
+  }
+  for (auto const* met : m.get_metrics()) {
+    for (auto const& l : met->get_layer_pointers()) {
+      layers.insert(l.lock().get());
+    }
+  }
+  return layers;
+}
+
+/** @brief Whether any of a layer's weights are used by other layers. */
+bool has_shared_weights(model& m, Layer const& layer)
+{
+  for (auto const& w_ptr : layer.get_weights_pointers()) {
+    auto const w = w_ptr.lock();
+    for (auto const* other : m.get_layers()) {
+      if (other == &layer) {
+        continue;
+      }
+      for (auto const& other_w : other->get_weights_pointers()) {
+        if (w != nullptr && other_w.lock() == w) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+template <typename T>
+El::Matrix<T, El::Device::CPU> get_local_values(weights const& w)
+{
+  auto const& values = dynamic_cast<data_type_weights<T> const&>(w).get_values();
+  El::Matrix<T, El::Device::CPU> local;
+  El::Copy(values.LockedMatrix(), local);
+  return local;
+}
+
+template <typename T>
+void set_local_values(weights& w, El::Matrix<T, El::Device::CPU> const& local)
+{
+  auto& values =
+    dynamic_cast<El::AbstractDistMatrix<T>&>(w.get_values_sharded());
+  El::Copy(local, values.Matrix());
+}
+
+/** @brief Fold batch normalization into a convolution or
+ *  fully-connected layer.
+ *
+ *  With the running statistics, batch normalization computes
+ *  @f$ y = \gamma (x - \mu) / \sqrt{\sigma^2 + \epsilon} + \beta @f$
+ *  per channel. Scaling the channel's weights by
+ *  @f$ s = \gamma / \sqrt{\sigma^2 + \epsilon} @f$ and replacing its
+ *  bias @f$ b @f$ with @f$ s (b - \mu) + \beta @f$ gives the same
+ *  result.
+ */
+template <typename T, El::Device D>
+bool try_fold_batch_norm(Layer& linear_layer,
+                         Layer& bn_layer,
+                         std::vector<weights_update>& updates)
+{
+  using BatchNormLayer =
+    batch_normalization_layer<T, data_layout::DATA_PARALLEL, D>;
+  using ConvolutionLayer = convolution_layer<T, data_layout::DATA_PARALLEL, D>;
+  using FullyConnectedLayer =
+    fully_connected_layer<T, data_layout::DATA_PARALLEL, D>;
+  using AccT = typename BatchNormLayer::AccT;
+  using CPUMatT = El::Matrix<T, El::Device::CPU>;
+
+  auto* bn = dynamic_cast<BatchNormLayer*>(&bn_layer);
+  auto* conv = dynamic_cast<ConvolutionLayer*>(&linear_layer);
+  auto* fc = dynamic_cast<FullyConnectedLayer*>(&linear_layer);
+  if (bn == nullptr || (conv == nullptr && fc == nullptr)) {
+    return false;
+  }
+  for (size_t i = 0; i < linear_layer.num_weights(); ++i) {
+    if (linear_layer.get_weights(i).is_sharded()) {
+      return false;
+    }
+  }
+  const bool has_bias = (conv != nullptr ? conv->has_bias() : fc->has_bias());
+
+  // Batch normalization parameters
+  const auto scale = get_local_values<AccT>(bn_layer.get_weights(0));
+  const auto shift = get_local_values<AccT>(bn_layer.get_weights(1));
+  const auto mean = get_local_values<AccT>(bn_layer.get_weights(2));
+  const auto var = get_local_values<AccT>(bn_layer.get_weights(3));
+  const double epsilon = El::To<double>(bn->get_epsilon());
+  const El::Int num_channels = scale.Height();
+  const auto& output_dims = linear_layer.get_output_dims();
+  const El::Int output_size = linear_layer.get_output_size();
+  if (output_dims.empty() || output_dims[0] != num_channels) {
+    return false;
+  }
+
+  // Weights of the linear layer. Convolution kernels and biases are
+  // packed by output channel. A fully-connected layer has one row (or
+  // column, if transposed) and one bias entry per output.
+  CPUMatT kernel = get_local_values<T>(linear_layer.get_weights(0));
+  CPUMatT bias;
+  if (has_bias) {
+    bias = get_local_values<T>(linear_layer.get_weights(1));
+  }
+  else {
+    El::Zeros(bias, (conv != nullptr ? num_channels : output_size), 1);
+  }
+  const El::Int bias_per_channel = bias.Height() / num_channels;
+  const bool transposed = (fc != nullptr && fc->is_transposed());
+
+  for (El::Int channel = 0; channel < num_channels; ++channel) {
+    const double factor =
+      El::To<double>(scale(channel, 0)) /
+      std::sqrt(El::To<double>(var(channel, 0)) + epsilon);
+    const double mu = El::To<double>(mean(channel, 0));
+    const double beta = El::To<double>(shift(channel, 0));
+    auto scale_entry = [factor](T& x) {
+      x = El::To<T>(factor * El::To<double>(x));
+    };
+    if (conv != nullptr) {
+      const El::Int channel_size = kernel.Height() / num_channels;
+      for (El::Int row = channel * channel_size;
+           row < (channel + 1) * channel_size;
+           ++row) {
+        scale_entry(kernel(row, 0));
+      }
+    }
+    else if (!transposed) {
+      const El::Int rows_per_channel = kernel.Height() / num_channels;
+      for (El::Int col = 0; col < kernel.Width(); ++col) {
+        for (El::Int row = channel * rows_per_channel;
+             row < (channel + 1) * rows_per_channel;
+             ++row) {
+          scale_entry(kernel(row, col));
+        }
+      }
+    }
+    else {
+      const El::Int cols_per_channel = kernel.Width() / num_channels;
+      for (El::Int col = channel * cols_per_channel;
+           col < (channel + 1) * cols_per_channel;
+           ++col) {
+        for (El::Int row = 0; row < kernel.Height(); ++row) {
+          scale_entry(kernel(row, col));
+        }
+      }
+    }
+    for (El::Int row = channel * bias_per_channel;
+         row < (channel + 1) * bias_per_channel;
+         ++row) {
+      bias(row, 0) =
+        El::To<T>(factor * (El::To<double>(bias(row, 0)) - mu) + beta);
+    }
+  }
+
+  if (!has_bias) {
+    if (conv != nullptr) {
+      conv->enable_bias();
+    }
+    else {
+      fc->enable_bias();
+    }
+  }
+  Layer* linear = &linear_layer;
+  updates.emplace_back([linear, kernel, bias]() {
+    set_local_values<T>(linear->get_weights(0), kernel);
+    set_local_values<T>(linear->get_weights(1), bias);
+  });
+  return true;
+}
+
+bool fold_batch_norm(Layer& linear_layer,
+                     Layer& bn_layer,
+                     std::vector<weights_update>& updates)
+{
+#define PROTO_DEVICE(T, Device)                                                \
+  if (try_fold_batch_norm<T, Device>(linear_layer, bn_layer, updates))         \
+  return true
+#include "lbann/macros/instantiate_device.hpp"
+#undef PROTO_DEVICE
+  return false;
+}
+
+template <typename T, data_layout Layout, El::Device D>
+bool try_fuse_operator_layers(Layer& first, Layer const& second)
+{
+  using OperatorLayerType = OperatorLayer<T, T, Layout, D>;
+  auto* first_op = dynamic_cast<OperatorLayerType*>(&first);
+  auto const* second_op = dynamic_cast<OperatorLayerType const*>(&second);
+  if (first_op == nullptr || second_op == nullptr) {
+    return false;
+  }
+  first_op->append_operators(*second_op);
+  return true;
+}
+
+bool fuse_operator_layers(Layer& first, Layer const& second)
+{
+#define PROTO_DEVICE(T, Device)                                                \
+  if (try_fuse_operator_layers<T, data_layout::DATA_PARALLEL, Device>(         \
+        first,                                                                 \
+        second) ||                                                             \
+      try_fuse_operator_layers<T, data_layout::MODEL_PARALLEL, Device>(        \
+        first,                                                                 \
+        second))                                                               \
+  return true
+#include "lbann/macros/instantiate_device.hpp"
+#undef PROTO_DEVICE
+  return false;
+}
+
+} // namespace
+
+inference_optimization_summary
+optimize_for_inference(model& m, std::vector<El::Grid*> const& grids)
+{
+  inference_optimization_summary summary;
+  std::vector<weights_update> updates;
+  const auto protected_layers = get_protected_layers(m);
+  // Removing a layer also removes its weights, so layers that share
+  // weights with another layer are kept
+  auto can_rewrite = [&m, &protected_layers](Layer const& l) {
+    return (protected_layers.count(&l) == 0 && l.get_num_parents() == 1 &&
+            l.get_num_children() == 1 && !has_shared_weights(m, l));
+  };
+
+  // Remove layers that are the identity in inference mode
+  const std::unordered_set<std::string> noop_types = {"dropout",
+                                                      "selu dropout",
+                                                      "identity",
+                                                      "stop_gradient"};
+  std::vector<std::string> removed_layers;
+  for (auto const* l : m.get_layers()) {
+    if (noop_types.count(l->get_type()) > 0 && can_rewrite(*l)) {
+      removed_layers.push_back(l->get_name());
+    }
+  }
+  for (auto const& name : removed_layers) {
+    m.remove_layer(name);
+  }
+  summary.num_removed_layers = removed_layers.size();
+
+  // Fold batch normalization into the preceding layer
+  removed_layers.clear();
+  for (auto* l : m.get_layers()) {
+    if (l->get_type() != "batch normalization" || !can_rewrite(*l)) {
+      continue;
+    }
+    auto& parent = const_cast<Layer&>(l->get_parent_layer(0));
+    if ((parent.get_type() != "convolution" &&
+         parent.get_type() != "fully connected") ||
+        parent.get_num_children() != 1 ||
+        protected_layers.count(&parent) > 0 || has_shared_weights(m, parent)) {
+      continue;
+    }
+    if (fold_batch_norm(parent, *l, updates)) {
+      removed_layers.push_back(l->get_name());
+    }
+  }
+  for (auto const& name : removed_layers) {
+    m.remove_layer(name);
+  }
+  summary.num_folded_normalizations = removed_layers.size();
+
+  // Merge chains of operator layers
+  bool fused = true;
+  while (fused) {
+    fused = false;
+    for (auto* l : m.get_layers()) {
+      if (l->get_type() != "operator" || l->get_num_children() != 1 ||
+          protected_layers.count(l) > 0) {
+        continue;
+      }
+      auto const& child = l->get_child_layer(0);
+      if (child.get_type() != "operator" || !can_rewrite(child)) {
+        continue;
+      }
+      if (fuse_operator_layers(*l, child)) {
+        m.remove_layer(std::string(child.get_name()));
+        ++summary.num_fused_operator_layers;
+        fused = true;
+        break;
+      }
+    }
+  }
+
+  if (summary.num_rewrites() > 0) {
+    m.setup(m.get_max_mini_batch_size(), grids, /*force*/ true);
+    for (auto const& update : updates) {
+      update();
+    }
+  }
+  return summary;
+}
+
+} // namespace lbann
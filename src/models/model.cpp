@@ -40,6 +40,7 @@
 #include "lbann/layers/transform/evaluation.hpp"
 #include "lbann/layers/transform/split.hpp"
 #include "lbann/metrics/layer_metric.hpp"
+#include "lbann/models/sharded_weights_prefetcher.hpp"
 #include "lbann/objective_functions/layer_term.hpp"
 #include "lbann/objective_functions/objective_function.hpp"
 #include "lbann/trainers/trainer.hpp"
@@ -49,8 +50,10 @@
 #include "lbann/utils/graph.hpp"
 #include "lbann/utils/omp_diagnostics.hpp"
 #include "lbann/utils/onnx_utils.hpp"
+#include "lbann/utils/options.hpp"
 #include "lbann/utils/serialize.hpp"
 #include "lbann/utils/summary_impl.hpp"
+#include "lbann/utils/tracing.hpp"
 
 #include "lbann/proto/model.pb.h"
 #include "lbann/proto/optimizers.pb.h"
@@ -63,6 +66,8 @@
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace lbann {
 
@@ -91,7 +96,8 @@ model::model(const model& other)
   : m_execution_context(other.m_execution_context),
     m_comm(other.m_comm),
     m_name(other.m_name),
-    m_model_is_setup(false)
+    m_model_is_setup(false),
+    m_forward_only(other.m_forward_only)
 {
 
   // Deep copies
@@ -155,6 +161,7 @@ model& model::operator=(const model& other)
   m_comm = other.m_comm;
   m_name = other.m_name;
   m_model_is_setup = false;
+  m_forward_only = other.m_forward_only;
 
   // Deep copies
   m_execution_context = other.m_execution_context;
@@ -225,6 +232,8 @@ void model::serialize(Archive& ar)
     // CEREAL_NVP(m_model_is_setup),
     CEREAL_NVP(m_max_mini_batch_size),
     // CEREAL_NVP(m_current_mini_batch_size),
+    // m_forward_only is not saved, so checkpoints written before it
+    // existed still load. It is set by the prototext or the caller.
     CEREAL_NVP(m_amp_enabled),
     CEREAL_NVP(m_amp_scale_factor),
     CEREAL_NVP(m_amp_growth_factor),
@@ -1133,6 +1142,16 @@ void model::setup_layers(uint64_t max_mini_batch_size,
       cb->on_setup_end(this, &l);
     }
   }
+
+  // Share buffers between neighboring layers once every layer knows
+  // its final configuration (e.g. whether it runs in-place)
+  auto const& arg_parser = global_argument_parser();
+  if (!this->is_subgraph_parallelism_enabled() &&
+      !arg_parser.get<bool>(LBANN_OPTION_NO_BUFFER_ALIASING)) {
+    for (El::Int i = 0; i < get_num_layers(); ++i) {
+      get_layer(i).setup_buffer_aliasing();
+    }
+  }
 }
 
 void model::setup_weights()
@@ -1146,6 +1165,14 @@ void model::setup_weights()
               return x->get_name().compare(y->get_name()) < 0;
             });
 
+  // Forward-only models never update their weights, so optimizers
+  // are dropped before they allocate any state
+  if (m_forward_only) {
+    for (auto&& w : m_weights) {
+      w->set_optimizer(nullptr);
+    }
+  }
+
   // Setup weights
   for (auto&& w : m_weights) {
     w->setup();
@@ -1619,14 +1646,20 @@ void model::forward_prop(execution_mode mode, bool skip_callbacks)
   // Clear layers that will be required in backpropagation
   m_needed_for_backprop.clear();
 
+  auto prefetcher = make_sharded_weights_prefetcher(*this, false);
+
   for (El::Int i = 0; i < get_num_layers(); ++i) {
     auto& l = get_layer(i);
+    prefetcher.prefetch(i);
 
     if (this->is_subgraph_parallelism_enabled()) {
       if (l.get_run_layer_in_subgraph()) {
         if (!skip_callbacks)
           do_layer_forward_prop_begin_cbs(mode, &l);
-        l.forward_prop();
+        {
+          LBANN_TRACE_SCOPE_DYNAMIC(l.get_name(), forward_prop);
+          l.forward_prop();
+        }
         if (!skip_callbacks)
           do_layer_forward_prop_end_cbs(mode, &l);
       }
@@ -1638,14 +1671,20 @@ void model::forward_prop(execution_mode mode, bool skip_callbacks)
     else {
       if (!skip_callbacks)
         do_layer_forward_prop_begin_cbs(mode, &l);
-      l.forward_prop();
+      {
+        LBANN_TRACE_SCOPE_DYNAMIC(l.get_name(), forward_prop);
+        l.forward_prop();
+      }
       if (!skip_callbacks)
         do_layer_forward_prop_end_cbs(mode, &l);
     }
 
-    if (is_layer_needed_for_backprop(&l))
+    prefetcher.release(i);
+
+    if (!m_forward_only && is_layer_needed_for_backprop(&l))
       m_needed_for_backprop.insert(&l);
   }
+  prefetcher.finish();
   if (!skip_callbacks)
     do_model_forward_prop_end_cbs(mode);
 }
@@ -1654,6 +1693,12 @@ void model::backward_prop(bool compute_weight_grads_only, bool skip_callbacks)
 {
   LBANN_CALIPER_MARK_FUNCTION;
 
+  if (m_forward_only) {
+    LBANN_ERROR("attempted backprop in forward-only model \"",
+                get_name(),
+                "\"");
+  }
+
   // Layers disabled due to not propagating error signals through
   std::unordered_set<const Layer*> disabled_layers;
   auto const& arg_parser = global_argument_parser();
@@ -1663,10 +1708,14 @@ void model::backward_prop(bool compute_weight_grads_only, bool skip_callbacks)
   if (!skip_callbacks)
     do_model_backward_prop_begin_cbs();
 
+  auto prefetcher = make_sharded_weights_prefetcher(*this, true);
+
   for (El::Int i = get_num_layers() - 1; i >= 0; --i) {
 
     // Perform backward prop step on current layer
     auto& l = get_layer(i);
+    const size_t pos = get_num_layers() - 1 - i;
+    prefetcher.prefetch(pos);
 
     // Check if layer should be skipped
     bool enable_layer = true;
@@ -1705,8 +1754,10 @@ void model::backward_prop(bool compute_weight_grads_only, bool skip_callbacks)
       if (l.get_run_layer_in_subgraph()) {
         if (!skip_callbacks)
           do_layer_backward_prop_begin_cbs(&l);
-        if (enable_layer)
+        if (enable_layer) {
+          LBANN_TRACE_SCOPE_DYNAMIC(l.get_name(), backward_prop);
           l.back_prop();
+        }
         if (!skip_callbacks)
           do_layer_backward_prop_end_cbs(&l);
       }
@@ -1718,11 +1769,14 @@ void model::backward_prop(bool compute_weight_grads_only, bool skip_callbacks)
     else {
       if (!skip_callbacks)
         do_layer_backward_prop_begin_cbs(&l);
-      if (enable_layer)
+      if (enable_layer) {
+        LBANN_TRACE_SCOPE_DYNAMIC(l.get_name(), backward_prop);
         l.back_prop();
+      }
       if (!skip_callbacks)
         do_layer_backward_prop_end_cbs(&l);
     }
+    prefetcher.release(pos);
 
     // Terminate early if all gradients have been computed
     bool all_gradients_computed = true;
@@ -1745,6 +1799,7 @@ void model::backward_prop(bool compute_weight_grads_only, bool skip_callbacks)
       break;
     }
   }
+  prefetcher.finish();
 
   if (!skip_callbacks)
     do_model_backward_prop_end_cbs();
@@ -1785,7 +1840,10 @@ void model::update_weights()
 
       if (opt != nullptr) {
         do_weight_optimize_begin_cbs(&w);
-        opt->step();
+        {
+          LBANN_TRACE_SCOPE_DYNAMIC(w.get_name(), optimizer);
+          opt->step();
+        }
         do_weight_optimize_end_cbs(&w);
       }
     }
@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/models/sharded_weights_prefetcher.hpp"
+
+#include "lbann/layers/layer.hpp"
+#include "lbann/models/model.hpp"
+#include "lbann/utils/argument_parser.hpp"
+#include "lbann/utils/options.hpp"
+#include "lbann/weights/weights.hpp"
+
+#include <algorithm>
+
+namespace lbann {
+
+sharded_weights_prefetcher::sharded_weights_prefetcher(
+  std::vector<Layer*> layers,
+  size_t depth,
+  size_t budget)
+  : m_layers(std::move(layers)), m_depth(depth), m_budget(budget)
+{}
+
+void sharded_weights_prefetcher::prefetch(size_t pos)
+{
+  if (m_depth == 0) {
+    return;
+  }
+  m_next = std::max(m_next, pos + 1);
+  const size_t end = std::min(pos + m_depth + 1, m_layers.size());
+  for (; m_next < end; ++m_next) {
+    auto const& l = *m_layers[m_next];
+    if (!l.is_participating()) {
+      continue;
+    }
+
+    // Find sharded weights that are not already requested
+    std::vector<weights const*> to_request;
+    size_t bytes = 0;
+    for (size_t i = 0; i < l.num_weights(); ++i) {
+      auto const& w = l.get_weights(i);
+      if (!w.is_sharded() || is_requested(w) ||
+          std::find(to_request.begin(), to_request.end(), &w) !=
+            to_request.end()) {
+        continue;
+      }
+      to_request.push_back(&w);
+      bytes += w.get_full_weights_memory_size();
+    }
+
+    // Stop if over budget, unless nothing else is in flight
+    if (m_budget > 0 && m_bytes + bytes > m_budget && !m_requested.empty()) {
+      break;
+    }
+    for (auto const* w : to_request) {
+      w->request_full_weights_async();
+      m_requested.emplace_back(m_next, w);
+    }
+    m_bytes += bytes;
+  }
+}
+
+void sharded_weights_prefetcher::release(size_t pos)
+{
+  auto it = m_requested.begin();
+  while (it != m_requested.end()) {
+    if (it->first <= pos) {
+      it->second->release_full_weights();
+      m_bytes -= it->second->get_full_weights_memory_size();
+      it = m_requested.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+void sharded_weights_prefetcher::finish() { release(m_layers.size()); }
+
+bool sharded_weights_prefetcher::is_requested(weights const& w) const
+{
+  return std::any_of(m_requested.begin(),
+                     m_requested.end(),
+                     [&w](auto const& r) { return r.second == &w; });
+}
+
+sharded_weights_prefetcher make_sharded_weights_prefetcher(model& m,
+                                                           bool reverse)
+{
+  auto const& arg_parser = global_argument_parser();
+  size_t depth = static_cast<size_t>(
+    std::max(arg_parser.get<int>(LBANN_OPTION_SHARDED_WEIGHTS_PREFETCH_DEPTH),
+             0));
+  if (m.is_subgraph_parallelism_enabled()) {
+    depth = 0;
+  }
+  const size_t budget =
+    arg_parser.get<size_t>(LBANN_OPTION_SHARDED_WEIGHTS_PREFETCH_BUDGET) *
+    1024 * 1024;
+  std::vector<Layer*> layers;
+  if (depth > 0) {
+    layers = m.get_layers();
+    if (reverse) {
+      std::reverse(layers.begin(), layers.end());
+    }
+  }
+  return sharded_weights_prefetcher(std::move(layers), depth, budget);
+}
+
+} // namespace lbann
@@ -0,0 +1,269 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Catch2BasicSupport.hpp"
+
+#include "MPITestHelpers.hpp"
+#include "TestHelpers.hpp"
+
+#include <lbann/base.hpp>
+#include <lbann/layers/data_type_layer.hpp>
+#include <lbann/layers/layer.hpp>
+#include <lbann/models/model.hpp>
+#include <lbann/proto/lbann.pb.h>
+#include <lbann/proto/proto_common.hpp>
+#include <lbann/utils/lbann_library.hpp>
+#include <lbann/utils/reference_counter.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+const std::vector<float> input_values = {-1.5f,
+                                         0.25f,
+                                         2.f,
+                                         -0.75f,
+                                         3.5f,
+                                         -2.f,
+                                         0.5f,
+                                         -0.125f,
+                                         1.f,
+                                         -4.f,
+                                         0.f,
+                                         0.875f};
+
+// Slice outputs feed ELU layers, whose outputs (one through an
+// in-place ReLU) are concatenated
+const std::string model_prototext = R"""(
+model {
+  layer {
+    name: "inp"
+    children: "slice"
+    weights: "dummy_inputs"
+    weights_layer {
+      dims: 12
+    }
+  }
+  layer {
+    name: "slice"
+    parents: "inp"
+    children: "a b"
+    slice {
+      axis: 0
+      slice_points: 0
+      slice_points: 4
+      slice_points: 12
+    }
+  }
+  layer {
+    name: "a"
+    parents: "slice"
+    children: "a_relu"
+    elu {
+    }
+  }
+  layer {
+    name: "a_relu"
+    parents: "a"
+    children: "cat"
+    relu {
+    }
+  }
+  layer {
+    name: "b"
+    parents: "slice"
+    children: "cat"
+    elu {
+    }
+  }
+  layer {
+    name: "cat"
+    parents: "a_relu b"
+    children: "fc"
+    concatenation {
+      axis: 0
+    }
+  }
+  layer {
+    name: "fc"
+    parents: "cat"
+    children: "out"
+    fully_connected {
+      num_neurons: 3
+      has_bias: true
+    }
+  }
+  layer {
+    name: "out"
+    parents: "fc"
+    softmax {
+    }
+  }
+  weights {
+    name: "dummy_inputs"
+    initializer {
+      value_initializer {
+        values: -1.5
+        values: 0.25
+        values: 2
+        values: -0.75
+        values: 3.5
+        values: -2
+        values: 0.5
+        values: -0.125
+        values: 1
+        values: -4
+        values: 0
+        values: 0.875
+      }
+    }
+  }
+}
+)""";
+
+std::unique_ptr<lbann::model> setup_model(const std::string& model_contents)
+{
+  auto& world_comm = unit_test::utilities::current_world_comm();
+  auto& g = world_comm.get_trainer_grid();
+
+  lbann_data::LbannPB pb;
+  REQUIRE_NOTHROW(lbann::read_prototext_string(model_contents, pb, true));
+
+  // Construct a trainer so that the model can register the input layer
+  lbann::construct_trainer(&world_comm, pb.mutable_trainer(), pb);
+  auto my_model = lbann::proto::construct_model(&world_comm,
+                                                pb.optimizer(),
+                                                pb.trainer(),
+                                                pb.model());
+  my_model->setup(1UL, {&g});
+  return my_model;
+}
+
+lbann::data_type_layer<float> const& get_layer(lbann::model const& m,
+                                               std::string const& name)
+{
+  auto const layers = m.get_layers();
+  auto iter =
+    std::find_if(layers.cbegin(), layers.cend(), [&name](auto const* l) {
+      return l->get_name() == name;
+    });
+  REQUIRE(iter != layers.cend());
+  return dynamic_cast<lbann::data_type_layer<float> const&>(**iter);
+}
+
+float elu(float x) { return x > 0.f ? x : std::expm1(x); }
+
+} // namespace
+
+TEST_CASE("Concatenate and slice buffer aliasing",
+          "[mpi][model][layer][concatenate][slice]")
+{
+  auto& world_comm = unit_test::utilities::current_world_comm();
+  auto& g = world_comm.get_trainer_grid();
+  lbann::utils::grid_manager mgr(g);
+
+  auto m = setup_model(model_prototext);
+  auto const& slice = get_layer(*m, "slice");
+  auto const& a = get_layer(*m, "a");
+  auto const& a_relu = get_layer(*m, "a_relu");
+  auto const& b = get_layer(*m, "b");
+  auto const& cat = get_layer(*m, "cat");
+  REQUIRE(a_relu.runs_inplace());
+
+  SECTION("Neighboring layers share buffers")
+  {
+    REQUIRE_NOTHROW(m->forward_prop(lbann::execution_mode::training));
+
+    // Slice outputs view row ranges of the slice input
+    auto const& slice_input = slice.get_prev_activations().LockedMatrix();
+    auto const& slice_output0 = slice.get_activations(0).LockedMatrix();
+    auto const& slice_output1 = slice.get_activations(1).LockedMatrix();
+    CHECK(slice.get_activations(0).Viewing());
+    CHECK(slice.get_activations(1).Viewing());
+    if (slice_input.Width() > 0) {
+      CHECK(slice_output0.LockedBuffer() == slice_input.LockedBuffer());
+      CHECK(slice_output1.LockedBuffer() == slice_input.LockedBuffer(4, 0));
+      CHECK(slice_output0.LDim() == slice_input.LDim());
+      CHECK(slice_output1.LDim() == slice_input.LDim());
+    }
+
+    // Parents write into row ranges of the concatenated output, through
+    // the in-place ReLU
+    auto const& output = cat.get_activations().LockedMatrix();
+    auto const& a_output = a.get_activations().LockedMatrix();
+    auto const& a_relu_output = a_relu.get_activations().LockedMatrix();
+    auto const& b_output = b.get_activations().LockedMatrix();
+    CHECK(a.get_activations().Viewing());
+    CHECK(b.get_activations().Viewing());
+    if (output.Width() > 0) {
+      CHECK(a_output.LockedBuffer() == output.LockedBuffer());
+      CHECK(a_relu_output.LockedBuffer() == output.LockedBuffer());
+      CHECK(b_output.LockedBuffer() == output.LockedBuffer(4, 0));
+      CHECK(a_output.LDim() == output.LDim());
+      CHECK(b_output.LDim() == output.LDim());
+    }
+
+    // Values match the unaliased computation
+    El::DistMatrix<float, El::STAR, El::STAR, El::ELEMENT, El::Device::CPU>
+      output_star(cat.get_activations().Grid(), cat.get_activations().Root());
+    El::Copy(cat.get_activations(), output_star);
+    auto const& local_output = output_star.LockedMatrix();
+    REQUIRE(local_output.Height() == 12);
+    REQUIRE(local_output.Width() == 1);
+    for (El::Int i = 0; i < 12; ++i) {
+      auto y = elu(input_values[i]);
+      if (i < 4) {
+        y = std::max(y, 0.f);
+      }
+      CHECK(local_output.Get(i, 0) == Approx(y));
+    }
+  }
+
+  SECTION("Shared buffers are released")
+  {
+    m->set_forward_only(true);
+    REQUIRE_NOTHROW(m->setup(1UL, {&g}, /*force*/ true));
+    REQUIRE_NOTHROW(m->forward_prop(lbann::execution_mode::inference));
+
+    // Parents do not allocate their own outputs, and the reference
+    // count of the concatenated output returns to zero once the
+    // fully-connected layer has consumed it
+    bool found_output = false;
+    for (auto const& [range, counter] : m->get_activation_reference_counter()) {
+      auto const* owner = counter.get_owner();
+      CHECK(owner != static_cast<void const*>(&a));
+      CHECK(owner != static_cast<void const*>(&b));
+      CHECK(owner != static_cast<void const*>(&slice));
+      if (owner == static_cast<void const*>(&cat)) {
+        found_output = true;
+        CHECK(counter.count() == 0);
+      }
+    }
+    CHECK(found_output);
+  }
+}
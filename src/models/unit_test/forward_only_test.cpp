@@ -0,0 +1,196 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Catch2BasicSupport.hpp"
+
+#include "MPITestHelpers.hpp"
+#include "TestHelpers.hpp"
+
+#include <lbann/base.hpp>
+#include <lbann/layers/data_type_layer.hpp>
+#include <lbann/layers/layer.hpp>
+#include <lbann/models/model.hpp>
+#include <lbann/proto/lbann.pb.h>
+#include <lbann/proto/proto_common.hpp>
+#include <lbann/utils/lbann_library.hpp>
+#include <lbann/utils/serialize.hpp>
+#include <lbann/weights/weights.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const std::string model_prototext = R"""(
+model {
+  layer {
+    name: "inp"
+    children: "fc1"
+    weights: "dummy_inputs"
+    weights_layer {
+      dims: 4
+    }
+  }
+  layer {
+    name: "fc1"
+    parents: "inp"
+    children: "relu"
+    fully_connected {
+      num_neurons: 6
+      has_bias: true
+    }
+  }
+  layer {
+    name: "relu"
+    parents: "fc1"
+    children: "fc2"
+    relu {
+    }
+  }
+  layer {
+    name: "fc2"
+    parents: "relu"
+    children: "out"
+    fully_connected {
+      num_neurons: 3
+      has_bias: true
+    }
+  }
+  layer {
+    name: "out"
+    parents: "fc2"
+    softmax {
+    }
+  }
+  weights {
+    name: "dummy_inputs"
+    initializer {
+      value_initializer {
+        values: -1.2
+        values: 3.4
+        values: -5.67
+        values: 0.5
+      }
+    }
+  }
+}
+)""";
+
+std::unique_ptr<lbann::model> setup_model(const std::string& model_contents)
+{
+  auto& world_comm = unit_test::utilities::current_world_comm();
+  auto& g = world_comm.get_trainer_grid();
+
+  lbann_data::LbannPB pb;
+  REQUIRE_NOTHROW(lbann::read_prototext_string(model_contents, pb, true));
+
+  // Construct a trainer so that the model can register the input layer
+  lbann::construct_trainer(&world_comm, pb.mutable_trainer(), pb);
+  auto my_model = lbann::proto::construct_model(&world_comm,
+                                                pb.optimizer(),
+                                                pb.trainer(),
+                                                pb.model());
+  my_model->setup(1UL, {&g});
+  return my_model;
+}
+
+lbann::data_type_layer<float> const& get_layer(lbann::model const& m,
+                                               std::string const& name)
+{
+  auto const layers = m.get_layers();
+  auto iter =
+    std::find_if(layers.cbegin(), layers.cend(), [&name](auto const* l) {
+      return l->get_name() == name;
+    });
+  REQUIRE(iter != layers.cend());
+  return dynamic_cast<lbann::data_type_layer<float> const&>(**iter);
+}
+
+El::Matrix<float, El::Device::CPU> get_outputs(lbann::model const& m,
+                                               std::string const& name = "out")
+{
+  auto const& act = get_layer(m, name).get_activations();
+  El::DistMatrix<float, El::STAR, El::STAR, El::ELEMENT, El::Device::CPU>
+    act_star(act.Grid(), act.Root());
+  El::Copy(act, act_star);
+  El::Matrix<float, El::Device::CPU> outputs;
+  El::Copy(act_star.LockedMatrix(), outputs);
+  return outputs;
+}
+
+} // namespace
+
+TEST_CASE("Forward-only models", "[mpi][model][inference]")
+{
+  auto& world_comm = unit_test::utilities::current_world_comm();
+  auto& g = world_comm.get_trainer_grid();
+  lbann::utils::grid_manager mgr(g);
+
+  auto m = setup_model(model_prototext);
+  REQUIRE_FALSE(m->is_forward_only());
+  REQUIRE_NOTHROW(m->forward_prop(lbann::execution_mode::inference));
+  auto const reference = get_outputs(*m);
+  auto const reference_fc2 = get_outputs(*m, "fc2");
+
+  // Forward-only mode is selected at setup time
+  m->set_forward_only(true);
+  REQUIRE_NOTHROW(m->setup(1UL, {&g}, /*force*/ true));
+  for (auto const* w : m->get_weights()) {
+    CHECK_FALSE(w->has_optimizer());
+  }
+  CHECK_THROWS(get_layer(*m, "fc1").get_error_signals());
+  CHECK_THROWS(get_layer(*m, "fc2").get_prev_error_signals());
+
+  REQUIRE_NOTHROW(m->forward_prop(lbann::execution_mode::inference));
+
+  // Intermediate activations are released once consumed, outputs are
+  // kept
+  CHECK(get_layer(*m, "fc1").get_activations().Width() == 0);
+  auto const outputs = get_outputs(*m);
+  REQUIRE(outputs.Height() == reference.Height());
+  REQUIRE(outputs.Width() == reference.Width());
+  for (El::Int i = 0; i < reference.Height(); ++i) {
+    CHECK(outputs.Get(i, 0) == Approx(reference.Get(i, 0)));
+  }
+
+  CHECK_THROWS(m->backward_prop());
+
+  // Intermediate layers can keep their outputs
+  for (auto* l : m->get_layers()) {
+    if (l->get_name() == "fc2") {
+      l->set_keep_activations(true);
+    }
+  }
+  REQUIRE_NOTHROW(m->setup(1UL, {&g}, /*force*/ true));
+  REQUIRE_NOTHROW(m->forward_prop(lbann::execution_mode::inference));
+  CHECK(get_layer(*m, "fc1").get_activations().Width() == 0);
+  auto const outputs_fc2 = get_outputs(*m, "fc2");
+  REQUIRE(outputs_fc2.Height() == reference_fc2.Height());
+  REQUIRE(outputs_fc2.Width() == reference_fc2.Width());
+  for (El::Int i = 0; i < reference_fc2.Height(); ++i) {
+    CHECK(outputs_fc2.Get(i, 0) == Approx(reference_fc2.Get(i, 0)));
+  }
+}
@@ -0,0 +1,415 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Catch2BasicSupport.hpp"
+
+#include "MPITestHelpers.hpp"
+#include "TestHelpers.hpp"
+
+#include <lbann/base.hpp>
+#include <lbann/layers/data_type_layer.hpp>
+#include <lbann/layers/layer.hpp>
+#include <lbann/models/inference_optimizer.hpp>
+#include <lbann/models/model.hpp>
+#include <lbann/proto/lbann.pb.h>
+#include <lbann/proto/proto_common.hpp>
+#include <lbann/utils/lbann_library.hpp>
+#include <lbann/utils/serialize.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Convolution and fully-connected layers followed by batch
+// normalization, no-op layers and a chain of operator layers
+// (x+1, then 2x).
+const std::string model_prototext = R"""(
+model {
+  layer {
+    name: "inp"
+    children: "conv"
+    weights: "dummy_inputs"
+    weights_layer {
+      dims: 2
+      dims: 2
+      dims: 2
+    }
+  }
+  layer {
+    name: "conv"
+    parents: "inp"
+    children: "bn1"
+    convolution {
+      num_dims: 2
+      out_channels: 2
+      kernel_size: 1
+      kernel_size: 1
+      stride: 1
+      stride: 1
+      padding: 0
+      padding: 0
+      has_bias: false
+    }
+  }
+  layer {
+    name: "bn1"
+    parents: "conv"
+    children: "drop"
+    weights: "bn1_scale"
+    weights: "bn1_bias"
+    weights: "bn1_mean"
+    weights: "bn1_var"
+    batch_normalization {
+      epsilon: 1e-5
+    }
+  }
+  layer {
+    name: "drop"
+    parents: "bn1"
+    children: "ident"
+    dropout {
+      keep_prob: 0.5
+    }
+  }
+  layer {
+    name: "ident"
+    parents: "drop"
+    children: "addconst"
+    identity {
+    }
+  }
+  layer {
+    name: "addconst"
+    parents: "ident"
+    children: "scale"
+    operator_layer {
+      ops {
+        parameters {
+          type_url: "type.googleapis.com/lbann_data.AddConstantOperator"
+          value: "\t\000\000\000\000\000\000\360?"
+        }
+      }
+    }
+  }
+  layer {
+    name: "scale"
+    parents: "addconst"
+    children: "fc"
+    operator_layer {
+      ops {
+        parameters {
+          type_url: "type.googleapis.com/lbann_data.ScaleOperator"
+          value: "\t\000\000\000\000\000\000\000@"
+        }
+      }
+    }
+  }
+  layer {
+    name: "fc"
+    parents: "scale"
+    children: "bn2"
+    fully_connected {
+      num_neurons: 3
+      has_bias: true
+    }
+  }
+  layer {
+    name: "bn2"
+    parents: "fc"
+    children: "out"
+    weights: "bn2_scale"
+    weights: "bn2_bias"
+    weights: "bn2_mean"
+    weights: "bn2_var"
+    batch_normalization {
+      epsilon: 1e-3
+    }
+  }
+  layer {
+    name: "out"
+    parents: "bn2"
+    relu {
+    }
+  }
+  weights {
+    name: "dummy_inputs"
+    initializer {
+      value_initializer {
+        values: [-1.2, 3.4, -5.67, 0.5, 2.0, -0.25, 1.5, -3.0]
+      }
+    }
+  }
+  weights {
+    name: "bn1_scale"
+    initializer { value_initializer { values: [0.5, -2.0] } }
+  }
+  weights {
+    name: "bn1_bias"
+    initializer { value_initializer { values: [0.25, 1.0] } }
+  }
+  weights {
+    name: "bn1_mean"
+    initializer { value_initializer { values: [-0.3, 0.7] } }
+  }
+  weights {
+    name: "bn1_var"
+    initializer { value_initializer { values: [2.0, 0.5] } }
+  }
+  weights {
+    name: "bn2_scale"
+    initializer { value_initializer { values: [1.5, 0.75, -1.0] } }
+  }
+  weights {
+    name: "bn2_bias"
+    initializer { value_initializer { values: [0.1, -0.2, 0.3] } }
+  }
+  weights {
+    name: "bn2_mean"
+    initializer { value_initializer { values: [0.2, -0.4, 1.1] } }
+  }
+  weights {
+    name: "bn2_var"
+    initializer { value_initializer { values: [0.8, 1.3, 4.0] } }
+  }
+}
+)""";
+
+// Two convolutions followed by batch normalization layers that share
+// their weights. Neither may be folded.
+const std::string shared_weights_prototext = R"""(
+model {
+  layer {
+    name: "inp"
+    children: "conv1"
+    weights: "dummy_inputs"
+    weights_layer {
+      dims: 2
+      dims: 2
+      dims: 2
+    }
+  }
+  layer {
+    name: "conv1"
+    parents: "inp"
+    children: "bn1"
+    convolution {
+      num_dims: 2
+      out_channels: 2
+      kernel_size: 1
+      kernel_size: 1
+      stride: 1
+      stride: 1
+      padding: 0
+      padding: 0
+      has_bias: false
+    }
+  }
+  layer {
+    name: "bn1"
+    parents: "conv1"
+    children: "conv2"
+    weights: "bn_scale"
+    weights: "bn_bias"
+    weights: "bn_mean"
+    weights: "bn_var"
+    batch_normalization {
+      epsilon: 1e-5
+    }
+  }
+  layer {
+    name: "conv2"
+    parents: "bn1"
+    children: "bn2"
+    convolution {
+      num_dims: 2
+      out_channels: 2
+      kernel_size: 1
+      kernel_size: 1
+      stride: 1
+      stride: 1
+      padding: 0
+      padding: 0
+      has_bias: false
+    }
+  }
+  layer {
+    name: "bn2"
+    parents: "conv2"
+    children: "out"
+    weights: "bn_scale"
+    weights: "bn_bias"
+    weights: "bn_mean"
+    weights: "bn_var"
+    batch_normalization {
+      epsilon: 1e-5
+    }
+  }
+  layer {
+    name: "out"
+    parents: "bn2"
+    relu {
+    }
+  }
+  weights {
+    name: "dummy_inputs"
+    initializer {
+      value_initializer {
+        values: [-1.2, 3.4, -5.67, 0.5, 2.0, -0.25, 1.5, -3.0]
+      }
+    }
+  }
+  weights {
+    name: "bn_scale"
+    initializer { value_initializer { values: [0.5, -2.0] } }
+  }
+  weights {
+    name: "bn_bias"
+    initializer { value_initializer { values: [0.25, 1.0] } }
+  }
+  weights {
+    name: "bn_mean"
+    initializer { value_initializer { values: [-0.3, 0.7] } }
+  }
+  weights {
+    name: "bn_var"
+    initializer { value_initializer { values: [2.0, 0.5] } }
+  }
+}
+)""";
+
+std::unique_ptr<lbann::model> setup_model(const std::string& model_contents)
+{
+  auto& world_comm = unit_test::utilities::current_world_comm();
+  auto& g = world_comm.get_trainer_grid();
+
+  lbann_data::LbannPB pb;
+  REQUIRE_NOTHROW(lbann::read_prototext_string(model_contents, pb, true));
+
+  // Construct a trainer so that the model can register the input layer
+  lbann::construct_trainer(&world_comm, pb.mutable_trainer(), pb);
+  auto my_model = lbann::proto::construct_model(&world_comm,
+                                                pb.optimizer(),
+                                                pb.trainer(),
+                                                pb.model());
+  my_model->setup(1UL, {&g});
+  return my_model;
+}
+
+lbann::Layer* find_layer(lbann::model const& m, std::string const& name)
+{
+  auto const layers = m.get_layers();
+  auto iter =
+    std::find_if(layers.cbegin(), layers.cend(), [&name](auto const* l) {
+      return l->get_name() == name;
+    });
+  return (iter != layers.cend() ? *iter : nullptr);
+}
+
+El::Matrix<float, El::Device::CPU> get_outputs(lbann::model const& m)
+{
+  auto const* l = find_layer(m, "out");
+  REQUIRE(l != nullptr);
+  auto const& dtl = dynamic_cast<lbann::data_type_layer<float> const&>(*l);
+  auto const& act = dtl.get_activations();
+  El::DistMatrix<float, El::STAR, El::STAR, El::ELEMENT, El::Device::CPU>
+    act_star(act.Grid(), act.Root());
+  El::Copy(act, act_star);
+  El::Matrix<float, El::Device::CPU> outputs;
+  El::Copy(act_star.LockedMatrix(), outputs);
+  return outputs;
+}
+
+} // namespace
+
+TEST_CASE("Inference graph optimization", "[mpi][model][inference]")
+{
+  auto& world_comm = unit_test::utilities::current_world_comm();
+  auto& g = world_comm.get_trainer_grid();
+  lbann::utils::grid_manager mgr(g);
+
+  auto m = setup_model(model_prototext);
+
+  REQUIRE_NOTHROW(m->forward_prop(lbann::execution_mode::testing));
+  auto const reference = get_outputs(*m);
+
+  lbann::inference_optimization_summary summary;
+  REQUIRE_NOTHROW(summary = lbann::optimize_for_inference(*m, {&g}));
+  CHECK(summary.num_folded_normalizations == 2UL);
+  CHECK(summary.num_removed_layers == 2UL);
+  CHECK(summary.num_fused_operator_layers == 1UL);
+
+  for (auto const* name : {"bn1", "drop", "ident", "scale", "bn2"}) {
+    CHECK(find_layer(*m, name) == nullptr);
+  }
+  auto const* fused = find_layer(*m, "addconst");
+  REQUIRE(fused != nullptr);
+  CHECK(fused->get_child_layer(0).get_name() == "fc");
+
+  REQUIRE_NOTHROW(m->forward_prop(lbann::execution_mode::testing));
+  auto const outputs = get_outputs(*m);
+  REQUIRE(outputs.Height() == reference.Height());
+  REQUIRE(outputs.Width() == reference.Width());
+  for (El::Int i = 0; i < reference.Height(); ++i) {
+    CHECK(std::fabs(outputs.Get(i, 0) - reference.Get(i, 0)) <=
+          1e-4f * (1.f + std::fabs(reference.Get(i, 0))));
+  }
+
+  SECTION("Optimizing again is a no-op")
+  {
+    CHECK(lbann::optimize_for_inference(*m, {&g}).num_rewrites() == 0UL);
+  }
+}
+
+TEST_CASE("Inference graph optimization keeps shared weights",
+          "[mpi][model][inference]")
+{
+  auto& world_comm = unit_test::utilities::current_world_comm();
+  auto& g = world_comm.get_trainer_grid();
+  lbann::utils::grid_manager mgr(g);
+
+  auto m = setup_model(shared_weights_prototext);
+
+  REQUIRE_NOTHROW(m->forward_prop(lbann::execution_mode::testing));
+  auto const reference = get_outputs(*m);
+
+  lbann::inference_optimization_summary summary;
+  REQUIRE_NOTHROW(summary = lbann::optimize_for_inference(*m, {&g}));
+  CHECK(summary.num_rewrites() == 0UL);
+  for (auto const* name : {"bn1", "bn2"}) {
+    auto const* bn = find_layer(*m, name);
+    REQUIRE(bn != nullptr);
+    CHECK(bn->num_weights() == 4UL);
+  }
+  CHECK(m->get_weights().size() == 7UL);
+
+  REQUIRE_NOTHROW(m->forward_prop(lbann::execution_mode::testing));
+  auto const outputs = get_outputs(*m);
+  REQUIRE(outputs.Height() == reference.Height());
+  for (El::Int i = 0; i < reference.Height(); ++i) {
+    CHECK(outputs.Get(i, 0) == reference.Get(i, 0));
+  }
+}
@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Catch2BasicSupport.hpp"
+
+#include "MPITestHelpers.hpp"
+#include "TestHelpers.hpp"
+
+#include <lbann/base.hpp>
+#include <lbann/layers/layer.hpp>
+#include <lbann/models/model.hpp>
+#include <lbann/models/sharded_weights_prefetcher.hpp>
+#include <lbann/proto/lbann.pb.h>
+#include <lbann/proto/proto_common.hpp>
+#include <lbann/utils/lbann_library.hpp>
+#include <lbann/weights/weights.hpp>
+
+#include <algorithm>
+
+namespace {
+
+// Each fully-connected layer has 160000 sharded weights (625 KiB in
+// single precision), so only one of them fits in a 1 MiB budget
+const std::string model_prototext = R"""(
+model {
+  layer {
+    name: "inp"
+    children: "fc1"
+    weights: "dummy_inputs"
+    weights_layer {
+      dims: 4
+    }
+  }
+  layer {
+    name: "fc1"
+    parents: "inp"
+    children: "fc2"
+    weights: "w1"
+    fully_connected {
+      num_neurons: 40000
+      has_bias: false
+    }
+  }
+  layer {
+    name: "fc2"
+    parents: "fc1"
+    children: "fc3"
+    weights: "w2"
+    fully_connected {
+      num_neurons: 4
+      has_bias: false
+    }
+  }
+  layer {
+    name: "fc3"
+    parents: "fc2"
+    children: "out"
+    weights: "w3"
+    fully_connected {
+      num_neurons: 4
+      has_bias: false
+    }
+  }
+  layer {
+    name: "out"
+    parents: "fc3"
+    identity {
+    }
+  }
+  weights {
+    name: "dummy_inputs"
+    initializer {
+      value_initializer {
+        values: 1
+        values: 2
+        values: 3
+        values: 4
+      }
+    }
+  }
+  weights {
+    name: "w1"
+    sharded: true
+    initializer {
+      constant_initializer {
+        value: 0.5
+      }
+    }
+  }
+  weights {
+    name: "w2"
+    sharded: true
+    initializer {
+      constant_initializer {
+        value: 0.25
+      }
+    }
+  }
+  weights {
+    name: "w3"
+    sharded: true
+    initializer {
+      constant_initializer {
+        value: 0.125
+      }
+    }
+  }
+}
+)""";
+
+std::unique_ptr<lbann::model> setup_model(const std::string& model_contents)
+{
+  auto& world_comm = unit_test::utilities::current_world_comm();
+  auto& g = world_comm.get_trainer_grid();
+
+  lbann_data::LbannPB pb;
+  REQUIRE_NOTHROW(lbann::read_prototext_string(model_contents, pb, true));
+
+  // Construct a trainer so that the model can register the input layer
+  lbann::construct_trainer(&world_comm, pb.mutable_trainer(), pb);
+  auto my_model = lbann::proto::construct_model(&world_comm,
+                                                pb.optimizer(),
+                                                pb.trainer(),
+                                                pb.model());
+  my_model->setup(1UL, {&g});
+  return my_model;
+}
+
+size_t get_layer_index(lbann::model const& m, std::string const& name)
+{
+  auto const layers = m.get_layers();
+  auto iter =
+    std::find_if(layers.cbegin(), layers.cend(), [&name](auto const* l) {
+      return l->get_name() == name;
+    });
+  REQUIRE(iter != layers.cend());
+  return std::distance(layers.cbegin(), iter);
+}
+
+lbann::weights const& get_weights(lbann::model const& m, size_t layer_index)
+{
+  auto const& l = *m.get_layers()[layer_index];
+  REQUIRE(l.num_weights() == 1);
+  REQUIRE(l.get_weights(0).is_sharded());
+  return l.get_weights(0);
+}
+
+void parse_options(std::vector<char const*> argv)
+{
+  auto& arg_parser = unit_test::utilities::reset_global_argument_parser();
+  argv.insert(argv.begin(), "sharded_weights_prefetcher_test.exe");
+  REQUIRE_NOTHROW(arg_parser.parse(static_cast<int>(argv.size()), argv.data()));
+}
+
+} // namespace
+
+TEST_CASE("Sharded weights prefetcher", "[mpi][model][weights][sharded]")
+{
+  auto& world_comm = unit_test::utilities::current_world_comm();
+  auto& g = world_comm.get_trainer_grid();
+  lbann::utils::grid_manager mgr(g);
+
+  auto m = setup_model(model_prototext);
+  size_t const inp = get_layer_index(*m, "inp");
+  size_t const fc1 = get_layer_index(*m, "fc1");
+  auto const& w1 = get_weights(*m, fc1);
+  auto const& w2 = get_weights(*m, get_layer_index(*m, "fc2"));
+  auto const& w3 = get_weights(*m, get_layer_index(*m, "fc3"));
+  REQUIRE(fc1 == inp + 1);
+  size_t const w1_size = w1.get_full_weights_memory_size();
+  size_t const w2_size = w2.get_full_weights_memory_size();
+  REQUIRE(w1_size == 160000 * sizeof(float));
+  REQUIRE(w2_size == 160000 * sizeof(float));
+
+  SECTION("Depth limits the look-ahead")
+  {
+    lbann::sharded_weights_prefetcher prefetcher(m->get_layers(), 2, 0);
+    prefetcher.prefetch(inp);
+    CHECK(prefetcher.is_requested(w1));
+    CHECK(prefetcher.is_requested(w2));
+    CHECK_FALSE(prefetcher.is_requested(w3));
+    CHECK(prefetcher.get_requested_memory_size() == w1_size + w2_size);
+
+    // Moving forward requests the next layer and releasing frees the
+    // passed layers
+    prefetcher.prefetch(fc1);
+    CHECK(prefetcher.is_requested(w3));
+    prefetcher.release(fc1);
+    CHECK_FALSE(prefetcher.is_requested(w1));
+    CHECK(prefetcher.is_requested(w2));
+    prefetcher.finish();
+    CHECK(prefetcher.get_requested_memory_size() == 0);
+  }
+
+  SECTION("Budget limits the requested memory")
+  {
+    lbann::sharded_weights_prefetcher prefetcher(m->get_layers(),
+                                                 3,
+                                                 w1_size + w2_size - 1);
+    prefetcher.prefetch(inp);
+    CHECK(prefetcher.is_requested(w1));
+    CHECK_FALSE(prefetcher.is_requested(w2));
+    CHECK(prefetcher.get_requested_memory_size() <= w1_size + w2_size - 1);
+
+    // The next layer is requested once memory is released
+    prefetcher.release(fc1);
+    prefetcher.prefetch(fc1);
+    CHECK(prefetcher.is_requested(w2));
+    prefetcher.finish();
+  }
+
+  SECTION("Command-line options")
+  {
+    parse_options({"--sharded_weights_prefetch_depth=1"});
+    {
+      auto prefetcher = lbann::make_sharded_weights_prefetcher(*m, false);
+      prefetcher.prefetch(inp);
+      CHECK(prefetcher.is_requested(w1));
+      CHECK_FALSE(prefetcher.is_requested(w2));
+      prefetcher.finish();
+    }
+
+    // The budget is given in MiB
+    parse_options({"--sharded_weights_prefetch_depth=3",
+                   "--sharded_weights_prefetch_budget=1"});
+    {
+      auto prefetcher = lbann::make_sharded_weights_prefetcher(*m, false);
+      prefetcher.prefetch(inp);
+      CHECK(prefetcher.is_requested(w1));
+      CHECK_FALSE(prefetcher.is_requested(w2));
+      CHECK(prefetcher.get_requested_memory_size() <= 1024 * 1024);
+      prefetcher.finish();
+    }
+
+    // Prefetching is disabled by default
+    parse_options({});
+    {
+      auto prefetcher = lbann::make_sharded_weights_prefetcher(*m, false);
+      prefetcher.prefetch(inp);
+      CHECK_FALSE(prefetcher.is_requested(w1));
+    }
+  }
+
+  // Layers wait on the prefetched weights during forward prop
+  parse_options({"--sharded_weights_prefetch_depth=2"});
+  REQUIRE_NOTHROW(m->forward_prop(lbann::execution_mode::inference));
+  unit_test::utilities::reset_global_argument_parser();
+}
@@ -26,6 +26,7 @@
 
 #include "lbann/operators/activations/activations.hpp"
 #include "../math/common.hpp"
+#include "lbann/utils/simd_math.hpp"
 
 namespace lbann {
 
@@ -149,10 +150,99 @@ struct SoftsignOpImpl
   }
 };
 
+// Vectorized implementations of operators that call math library
+// functions. They are used by the vectorized CPU kernels for float
+// and double (see lbann/utils/simd.hpp).
+
+template <typename DataT>
+struct LogSigmoidSimdOpImpl
+{
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x) const noexcept
+  {
+    // min(x,0) - log(1+exp(-|x|))
+    const DataT neg_part = simd::select(x < DataT(0), x, DataT(0));
+    return neg_part - simd::log1p(simd::exp(-std::fabs(x)));
+  }
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x,
+                                     DataT const& dy) const noexcept
+  {
+    return dy / (DataT(1) + simd::exp(x));
+  }
+};
+
+template <typename DataT>
+struct SeluSimdOpImpl
+{
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x) const noexcept
+  {
+    const DataT alpha = DataT(1.6732632423543772848170429916717);
+    const DataT scale = DataT(1.0507009873554804934193349852946);
+    return simd::select(x > DataT(0),
+                        scale * x,
+                        scale * alpha * simd::expm1(x));
+  }
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x,
+                                     DataT const& dy) const noexcept
+  {
+    const DataT alpha = DataT(1.6732632423543772848170429916717);
+    const DataT scale = DataT(1.0507009873554804934193349852946);
+    return simd::select(x > DataT(0),
+                        dy * scale,
+                        dy * scale * alpha * simd::exp(x));
+  }
+};
+
+template <typename DataT>
+struct SigmoidSimdOpImpl
+{
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x) const noexcept
+  {
+    const DataT y = DataT(1) / (DataT(1) + simd::exp(-x));
+#ifdef LBANN_ENABLE_SIGMOID_CUTOFF
+    const DataT eps = std::numeric_limits<DataT>::epsilon();
+    const DataT y_cut = simd::select(y <= eps, eps, y);
+    return simd::select(y >= DataT(1) - eps, DataT(1) - eps, y_cut);
+#else
+    return y;
+#endif // LBANN_ENABLE_SIGMOID_CUTOFF
+  }
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x,
+                                     DataT const& dy) const noexcept
+  {
+    const DataT y = DataT(1) / (DataT(1) + simd::exp(-x));
+#ifdef LBANN_ENABLE_SIGMOID_CUTOFF
+    const DataT eps = std::numeric_limits<DataT>::epsilon();
+    return simd::select(y <= eps || y >= DataT(1) - eps,
+                        DataT(0),
+                        dy * y * (DataT(1) - y));
+#else
+    return dy * y * (DataT(1) - y);
+#endif // LBANN_ENABLE_SIGMOID_CUTOFF
+  }
+};
+
+template <typename DataT>
+struct SoftplusSimdOpImpl
+{
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x) const noexcept
+  {
+    // max(x,0) + log(1+exp(-|x|))
+    const DataT pos_part = simd::select(x > DataT(0), x, DataT(0));
+    return simd::log1p(simd::exp(-std::fabs(x))) + pos_part;
+  }
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x,
+                                     DataT const& dy) const noexcept
+  {
+    return dy / (DataT(1) + simd::exp(-x));
+  }
+};
+
 } // namespace
 
 // Template instantiation
 #define DEFINE_COMPUTE_OPS(OP_NAME)                                            \
+  DEFINE_SIMD_COMPUTE_OPS(OP_NAME, OP_NAME##OpImpl)
+#define DEFINE_SIMD_COMPUTE_OPS(OP_NAME, SIMD_IMPL)                            \
   template <typename DataT, El::Device Device>                                 \
   void OP_NAME##Operator<DataT, Device>::fp_compute_local(                     \
     std::vector<ConstLocalInputTensorType> inputs,                             \
@@ -162,10 +252,10 @@ struct SoftsignOpImpl
     LBANN_ASSERT_DEBUG(outputs.size() == 1);                                   \
     auto const& input = inputs.front().data();                                 \
     auto& output = outputs.front().data();                                     \
-    El::EntrywiseMap(                                                          \
-      input,                                                                   \
-      output,                                                                  \
-      std::function<DataT(DataT const&)>(OP_NAME##OpImpl<DataT>{}));           \
+    internal::apply_unary_operator(input,                                      \
+                                   output,                                     \
+                                   OP_NAME##OpImpl<DataT>{},                   \
+                                   SIMD_IMPL<DataT>{});                        \
   }                                                                            \
   template <typename DataT, El::Device Device>                                 \
   void OP_NAME##Operator<DataT, Device>::bp_compute_local(                     \
@@ -179,16 +269,41 @@ struct SoftsignOpImpl
     auto const& input = inputs.front().data();                                 \
     auto const& grad_wrt_output = grads_wrt_outputs.front().data();            \
     auto& grad_wrt_input = grads_wrt_inputs.front().data();                    \
-    internal::EntrywiseZipInto(input,                                          \
-                               grad_wrt_output,                                \
-                               grad_wrt_input,                                 \
-                               OP_NAME##OpImpl<DataT>{});                      \
+    internal::apply_binary_operator(input,                                     \
+                                    grad_wrt_output,                           \
+                                    grad_wrt_input,                            \
+                                    OP_NAME##OpImpl<DataT>{},                  \
+                                    SIMD_IMPL<DataT>{});                       \
+  }                                                                            \
+  template <typename DataT, El::Device Device>                                 \
+  void OP_NAME##Operator<DataT, Device>::fp_compute_block(DataT const* x,      \
+                                                          DataT* y,            \
+                                                          El::Int n) const     \
+  {                                                                            \
+    internal::apply_unary_block(x,                                             \
+                                y,                                             \
+                                n,                                             \
+                                OP_NAME##OpImpl<DataT>{},                      \
+                                SIMD_IMPL<DataT>{});                           \
+  }                                                                            \
+  template <typename DataT, El::Device Device>                                 \
+  void OP_NAME##Operator<DataT, Device>::bp_compute_block(DataT const* x,      \
+                                                          DataT const* dy,     \
+                                                          DataT* dx,           \
+                                                          El::Int n) const     \
+  {                                                                            \
+    internal::apply_unary_backprop_block(x,                                    \
+                                         dy,                                   \
+                                         dx,                                   \
+                                         n,                                    \
+                                         OP_NAME##OpImpl<DataT>{},             \
+                                         SIMD_IMPL<DataT>{});                  \
   }
 
-DEFINE_COMPUTE_OPS(LogSigmoid)
-DEFINE_COMPUTE_OPS(Selu)
-DEFINE_COMPUTE_OPS(Sigmoid)
-DEFINE_COMPUTE_OPS(Softplus)
+DEFINE_SIMD_COMPUTE_OPS(LogSigmoid, LogSigmoidSimdOpImpl)
+DEFINE_SIMD_COMPUTE_OPS(Selu, SeluSimdOpImpl)
+DEFINE_SIMD_COMPUTE_OPS(Sigmoid, SigmoidSimdOpImpl)
+DEFINE_SIMD_COMPUTE_OPS(Softplus, SoftplusSimdOpImpl)
 DEFINE_COMPUTE_OPS(Softsign)
 
 #define PROTO(T)                                                               \
@@ -26,6 +26,7 @@
 
 #include "lbann/operators/loss/entrywise.hpp"
 #include "../math/common.hpp"
+#include "lbann/utils/simd_math.hpp"
 
 namespace lbann {
 
@@ -187,9 +188,74 @@ struct BooleanFalsePositiveOpImpl
   }
 };
 
+// Vectorized implementations of operators that call math library
+// functions. They are used by the vectorized CPU kernels for float
+// and double (see lbann/utils/simd.hpp).
+
+template <typename DataT>
+struct BinaryCrossEntropySimdOpImpl
+{
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x1,
+                                     DataT const& x2) const noexcept
+  {
+    const DataT zero = DataT(0), one = DataT(1);
+    const DataT y = simd::select(x2 > zero, -x2 * simd::log(x1), zero);
+    return y + simd::select(x2 < one, -(one - x2) * simd::log(one - x1), zero);
+  }
+  LBANN_SIMD_INLINE void operator()(DataT const& x1,
+                                    DataT const& x2,
+                                    DataT const& dy,
+                                    DataT& dx1,
+                                    DataT& dx2) const noexcept
+  {
+    const DataT zero = DataT(0), one = DataT(1);
+    const bool pos = x2 > zero && dy != zero;
+    const bool neg = x2 < one && dy != zero;
+    dx1 = simd::select(pos, -x2 / x1 * dy, zero) +
+          simd::select(neg, (one - x2) / (one - x1) * dy, zero);
+    dx2 = simd::select(pos, -simd::log(x1) * dy, zero) +
+          simd::select(neg, simd::log(one - x1) * dy, zero);
+  }
+};
+
+template <typename DataT>
+struct SigmoidBinaryCrossEntropySimdOpImpl
+{
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x1,
+                                     DataT const& x2) const noexcept
+  {
+    const DataT zero = DataT(0), one = DataT(1);
+    const DataT z = clamp_label(x2);
+    const DataT linear = simd::select(x1 > zero, (one - z) * x1, -x1 * z);
+    return linear + simd::log1p(simd::exp(-std::fabs(x1)));
+  }
+  LBANN_SIMD_INLINE void operator()(DataT const& x1,
+                                    DataT const& x2,
+                                    DataT const& dy,
+                                    DataT& dx1,
+                                    DataT& dx2) const noexcept
+  {
+    const DataT zero = DataT(0), one = DataT(1);
+    const DataT z = clamp_label(x2);
+    // sigmoid(|x1|)
+    const DataT s = one / (one + simd::exp(-std::fabs(x1)));
+    dx1 = simd::select(x1 > zero, s - z, one - z - s) * dy;
+    dx2 = simd::select(x2 == z, -x1 * dy, zero);
+  }
+  /** @brief Same as std::max(0,std::min(x,1)), including for NaN. */
+  LBANN_SIMD_INLINE static DataT clamp_label(DataT const& x) noexcept
+  {
+    const DataT zero = DataT(0), one = DataT(1);
+    const DataT y = simd::select(one < x, one, x);
+    return simd::select(zero < y, y, zero);
+  }
+};
+
 } // namespace
 
 #define DEFINE_COMPUTE_OPS(OP_NAME)                                            \
+  DEFINE_SIMD_COMPUTE_OPS(OP_NAME, OP_NAME##OpImpl)
+#define DEFINE_SIMD_COMPUTE_OPS(OP_NAME, SIMD_IMPL)                            \
   template <typename DataT, El::Device Device>                                 \
   void OP_NAME##Operator<DataT, Device>::fp_compute_local(                     \
     std::vector<ConstLocalInputTensorType> inputs,                             \
@@ -200,10 +266,11 @@ struct BooleanFalsePositiveOpImpl
     auto const& input0 = inputs[0].data();                                     \
     auto const& input1 = inputs[1].data();                                     \
     auto& output = outputs.front().data();                                     \
-    internal::EntrywiseZipInto(input0,                                         \
-                               input1,                                         \
-                               output,                                         \
-                               OP_NAME##OpImpl<DataT>{});                      \
+    internal::apply_binary_operator(input0,                                    \
+                                    input1,                                    \
+                                    output,                                    \
+                                    OP_NAME##OpImpl<DataT>{},                  \
+                                    SIMD_IMPL<DataT>{});                       \
   }                                                                            \
   template <typename DataT, El::Device Device>                                 \
   void OP_NAME##Operator<DataT, Device>::bp_compute_local(                     \
@@ -224,11 +291,13 @@ struct BooleanFalsePositiveOpImpl
                                              grad_wrt_output,                  \
                                              grad_wrt_input0,                  \
                                              grad_wrt_input1,                  \
-                                             OP_NAME##OpImpl<DataT>{});        \
+                                             OP_NAME##OpImpl<DataT>{},         \
+                                             SIMD_IMPL<DataT>{});              \
   }
 
-DEFINE_COMPUTE_OPS(BinaryCrossEntropy)
-DEFINE_COMPUTE_OPS(SigmoidBinaryCrossEntropy)
+DEFINE_SIMD_COMPUTE_OPS(BinaryCrossEntropy, BinaryCrossEntropySimdOpImpl)
+DEFINE_SIMD_COMPUTE_OPS(SigmoidBinaryCrossEntropy,
+                        SigmoidBinaryCrossEntropySimdOpImpl)
 DEFINE_COMPUTE_OPS(BooleanAccuracy)
 DEFINE_COMPUTE_OPS(BooleanFalseNegative)
 DEFINE_COMPUTE_OPS(BooleanFalsePositive)
@@ -471,10 +471,10 @@ struct LogicalXorOpImpl
     auto& output = outputs.front().data();                                     \
     LBANN_ASSERT(input0.Height() == input1.Height());                          \
     LBANN_ASSERT(input0.Width() == input1.Width());                            \
-    internal::EntrywiseZipInto(input0,                                         \
-                               input1,                                         \
-                               output,                                         \
-                               OP_NAME##OpImpl<DataT>{});                      \
+    internal::apply_binary_operator(input0,                                    \
+                                    input1,                                    \
+                                    output,                                    \
+                                    OP_NAME##OpImpl<DataT>{});                 \
   }                                                                            \
   template <typename DataT, El::Device Device>                                 \
   void OP_NAME##Operator<DataT, Device>::bp_compute_local(                     \
@@ -358,6 +358,88 @@ void GreaterEqualConstantOperator<DataT, D>::bp_compute_local(
   El::Zero(gradient_wrt_inputs.front().data());
 }
 
+// Block kernels for fusing operators in OperatorLayer. FP_FUNC(c,x)
+// and BP_FUNC(c,x,dy) are passed the constant explicitly.
+#define DEFINE_BLOCK_KERNELS(OP_NAME, FP_FUNC, BP_FUNC)                        \
+  template <typename DataT, El::Device D>                                      \
+  void OP_NAME##Operator<DataT, D>::fp_compute_block(DataT const* input,       \
+                                                     DataT* output,            \
+                                                     El::Int n) const          \
+  {                                                                            \
+    auto const f = FP_FUNC;                                                    \
+    internal::apply_unary_block(                                               \
+      input,                                                                   \
+      output,                                                                  \
+      n,                                                                       \
+      [f, c = this->m_constant](DataT const& v) { return f(c, v); });          \
+  }                                                                            \
+  template <typename DataT, El::Device D>                                      \
+  void OP_NAME##Operator<DataT, D>::bp_compute_block(                          \
+    DataT const* input,                                                        \
+    DataT const* gradient_wrt_output,                                          \
+    DataT* gradient_wrt_input,                                                 \
+    El::Int n) const                                                           \
+  {                                                                            \
+    auto const f = BP_FUNC;                                                    \
+    internal::apply_unary_backprop_block(                                      \
+      input,                                                                   \
+      gradient_wrt_output,                                                     \
+      gradient_wrt_input,                                                      \
+      n,                                                                       \
+      [f, c = this->m_constant](DataT const& v, DataT const& dv) {             \
+        return f(c, v, dv);                                                    \
+      });                                                                      \
+  }
+
+#define ZERO_GRADIENT                                                          \
+  [](DataT const&, DataT const&, DataT const&) {                               \
+    return El::TypeTraits<DataT>::Zero();                                      \
+  }
+#define INDICATOR(PRED)                                                        \
+  [](DataT const& c, DataT const& x) {                                         \
+    return (PRED) ? El::TypeTraits<DataT>::One()                               \
+                  : El::TypeTraits<DataT>::Zero();                             \
+  }
+
+DEFINE_BLOCK_KERNELS(
+  AddConstant,
+  [](DataT const& c, DataT const& x) { return x + c; },
+  [](DataT const&, DataT const&, DataT const& dy) { return dy; })
+DEFINE_BLOCK_KERNELS(
+  Scale,
+  [](DataT const& c, DataT const& x) { return x * c; },
+  [](DataT const& c, DataT const&, DataT const& dy) { return dy * c; })
+DEFINE_BLOCK_KERNELS(
+  SubtractConstant,
+  [](DataT const& c, DataT const& x) { return x - c; },
+  [](DataT const&, DataT const&, DataT const& dy) { return dy; })
+DEFINE_BLOCK_KERNELS(
+  ConstantSubtract,
+  [](DataT const& c, DataT const& x) { return c - x; },
+  [](DataT const&, DataT const&, DataT const& dy) { return -dy; })
+DEFINE_BLOCK_KERNELS(
+  MaxConstant,
+  [](DataT const& c, DataT const& x) { return std::max(c, x); },
+  [](DataT const& c, DataT const& x, DataT const& dy) {
+    return (x < c ? El::TypeTraits<DataT>::Zero() : (x > c ? dy : dy / 2));
+  })
+DEFINE_BLOCK_KERNELS(
+  MinConstant,
+  [](DataT const& c, DataT const& x) { return std::min(c, x); },
+  [](DataT const& c, DataT const& x, DataT const& dy) {
+    return (x < c ? dy : (x > c ? El::TypeTraits<DataT>::Zero() : dy / 2));
+  })
+DEFINE_BLOCK_KERNELS(EqualConstant, INDICATOR(c == x), ZERO_GRADIENT)
+DEFINE_BLOCK_KERNELS(NotEqualConstant, INDICATOR(c != x), ZERO_GRADIENT)
+DEFINE_BLOCK_KERNELS(LessConstant, INDICATOR(x < c), ZERO_GRADIENT)
+DEFINE_BLOCK_KERNELS(LessEqualConstant, INDICATOR(x <= c), ZERO_GRADIENT)
+DEFINE_BLOCK_KERNELS(GreaterConstant, INDICATOR(c < x), ZERO_GRADIENT)
+DEFINE_BLOCK_KERNELS(GreaterEqualConstant, INDICATOR(c <= x), ZERO_GRADIENT)
+
+#undef INDICATOR
+#undef ZERO_GRADIENT
+#undef DEFINE_BLOCK_KERNELS
+
 #define PROTO(T)                                                               \
   template class AddConstantOperator<T, El::Device::CPU>;                      \
   template class ScaleOperator<T, El::Device::CPU>;                            \
@@ -455,6 +455,39 @@ void GreaterEqualConstantOperator<DataT, D>::bp_compute_local(
   El::Zero(gradient_wrt_inputs.front().data());
 }
 
+// Block kernels are only used to fuse operators on CPU
+#define DEFINE_BLOCK_KERNELS(OP_NAME)                                          \
+  template <typename DataT, El::Device D>                                      \
+  void OP_NAME##Operator<DataT, D>::fp_compute_block(DataT const*,             \
+                                                     DataT*,                   \
+                                                     El::Int) const            \
+  {                                                                            \
+    LBANN_ERROR("block kernels are only available on CPU");                    \
+  }                                                                            \
+  template <typename DataT, El::Device D>                                      \
+  void OP_NAME##Operator<DataT, D>::bp_compute_block(DataT const*,             \
+                                                     DataT const*,             \
+                                                     DataT*,                   \
+                                                     El::Int) const            \
+  {                                                                            \
+    LBANN_ERROR("block kernels are only available on CPU");                    \
+  }
+
+DEFINE_BLOCK_KERNELS(AddConstant)
+DEFINE_BLOCK_KERNELS(Scale)
+DEFINE_BLOCK_KERNELS(SubtractConstant)
+DEFINE_BLOCK_KERNELS(ConstantSubtract)
+DEFINE_BLOCK_KERNELS(MaxConstant)
+DEFINE_BLOCK_KERNELS(MinConstant)
+DEFINE_BLOCK_KERNELS(EqualConstant)
+DEFINE_BLOCK_KERNELS(NotEqualConstant)
+DEFINE_BLOCK_KERNELS(LessConstant)
+DEFINE_BLOCK_KERNELS(LessEqualConstant)
+DEFINE_BLOCK_KERNELS(GreaterConstant)
+DEFINE_BLOCK_KERNELS(GreaterEqualConstant)
+
+#undef DEFINE_BLOCK_KERNELS
+
 #define PROTO(T)                                                               \
   template class AddConstantOperator<T, El::Device::GPU>;                      \
   template class ScaleOperator<T, El::Device::GPU>;                            \
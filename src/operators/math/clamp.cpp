@@ -64,6 +64,32 @@ void ClampOperator<DataT, D>::bp_compute_local(
                              });
 }
 
+template <typename DataT, El::Device D>
+void ClampOperator<DataT, D>::fp_compute_block(DataT const* x,
+                                               DataT* y,
+                                               El::Int n) const
+{
+  internal::apply_unary_block(x, y, n, [this](DataT const& v) {
+    return std::max(m_min, std::min(m_max, v));
+  });
+}
+
+template <typename DataT, El::Device D>
+void ClampOperator<DataT, D>::bp_compute_block(DataT const* x,
+                                               DataT const* dy,
+                                               DataT* dx,
+                                               El::Int n) const
+{
+  internal::apply_unary_backprop_block(
+    x,
+    dy,
+    dx,
+    n,
+    [this](DataT const& v, DataT const& dv) {
+      return (v <= m_min || v >= m_max) ? El::TypeTraits<DataT>::Zero() : dv;
+    });
+}
+
 #define PROTO(T) template class ClampOperator<T, El::Device::CPU>
 
 #define LBANN_INSTANTIATE_CPU_HALF
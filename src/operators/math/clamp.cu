@@ -200,6 +200,23 @@ void ClampOperator<DataT, D>::bp_compute_local(
            gradient_wrt_inputs[0].data());
 }
 
+template <typename DataT, El::Device D>
+void ClampOperator<DataT, D>::fp_compute_block(DataT const*,
+                                               DataT*,
+                                               El::Int) const
+{
+  LBANN_ERROR("block kernels are only available on CPU");
+}
+
+template <typename DataT, El::Device D>
+void ClampOperator<DataT, D>::bp_compute_block(DataT const*,
+                                               DataT const*,
+                                               DataT*,
+                                               El::Int) const
+{
+  LBANN_ERROR("block kernels are only available on CPU");
+}
+
 #define PROTO(T) template class ClampOperator<T, El::Device::GPU>
 
 #define LBANN_INSTANTIATE_GPU_HALF
@@ -28,10 +28,50 @@
 
 #include "lbann/base.hpp"
 #include "lbann/utils/profiling.hpp"
+#include "lbann/utils/simd.hpp"
+
+#include <algorithm>
+#include <type_traits>
 
 namespace lbann {
 namespace internal {
 
+/** @brief Whether vectorized CPU kernels exist for a data type.
+ *  @details They are used unless the reference instruction set is
+ *           selected (see lbann/utils/simd.hpp).
+ */
+template <typename DataT>
+constexpr bool has_simd_kernels =
+  std::is_same_v<DataT, float> || std::is_same_v<DataT, double>;
+
+/** @brief Entries per task in vectorized CPU kernels. */
+constexpr El::Int simd_block_size = 4096;
+
+/** @brief Whether to use vectorized CPU kernels for a data type. */
+template <typename DataT>
+bool use_simd_kernels()
+{
+  return has_simd_kernels<DataT> && simd::get_isa() != simd::isa::reference;
+}
+
+/** @brief Split columns into contiguous blocks and process them in
+ *         parallel.
+ *  @details The functor is called as @c f(i,j,n) for the @c n
+ *           entries starting at row @c i of column @c j.
+ */
+template <typename F>
+void for_each_simd_block(El::Int height, El::Int width, F f)
+{
+  const El::Int num_blocks = (height + simd_block_size - 1) / simd_block_size;
+  LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+  for (El::Int j = 0; j < width; ++j) {
+    for (El::Int b = 0; b < num_blocks; ++b) {
+      const El::Int i = b * simd_block_size;
+      f(i, j, std::min(simd_block_size, height - i));
+    }
+  }
+}
+
 /** @brief A binary entrywise map c <- f(a,b).
  */
 template <typename S, typename T, typename U, typename F>
@@ -76,24 +116,145 @@ void EntrywiseZipInto(El::Matrix<S, El::Device::CPU> const& A,
   }
 }
 
+/** @brief Apply a unary operator to CPU data, y <- f(x).
+ *  @details Vectorized kernels call @c simd_f on blocks of
+ *           contiguous entries. It may differ from @c f, e.g. by
+ *           using the functions in lbann/utils/simd_math.hpp instead
+ *           of library calls. Otherwise @c f is applied with
+ *           El::EntrywiseMap.
+ */
+template <typename DataT, typename F, typename SimdF>
+void apply_unary_operator(El::Matrix<DataT, El::Device::CPU> const& x,
+                          El::Matrix<DataT, El::Device::CPU>& y,
+                          F f,
+                          SimdF simd_f)
+{
+  LBANN_CALIPER_MARK_FUNCTION;
+  if constexpr (has_simd_kernels<DataT>) {
+    if (use_simd_kernels<DataT>()) {
+      LBANN_ASSERT_DEBUG(y.Height() == x.Height());
+      LBANN_ASSERT_DEBUG(y.Width() == x.Width());
+      El::Int height = x.Height(), width = x.Width();
+      if (x.Contiguous() && y.Contiguous()) {
+        height *= width;
+        width = 1;
+      }
+      const auto* x_buffer = x.LockedBuffer();
+      auto* y_buffer = y.Buffer();
+      const auto x_ldim = x.LDim();
+      const auto y_ldim = y.LDim();
+      for_each_simd_block(height, width, [&](El::Int i, El::Int j, El::Int n) {
+        simd::apply_unary(x_buffer + i + j * x_ldim,
+                          y_buffer + i + j * y_ldim,
+                          n,
+                          simd_f);
+      });
+      return;
+    }
+  }
+  El::EntrywiseMap(x, y, std::function<DataT(DataT const&)>(f));
+}
+
+/** @brief Apply a binary operator to CPU data, y <- f(x1,x2).
+ *  @details See apply_unary_operator. For unary operators this
+ *           also computes the backprop, dx <- f(x,dy).
+ */
+template <typename DataT, typename F, typename SimdF>
+void apply_binary_operator(El::Matrix<DataT, El::Device::CPU> const& x1,
+                           El::Matrix<DataT, El::Device::CPU> const& x2,
+                           El::Matrix<DataT, El::Device::CPU>& y,
+                           F f,
+                           SimdF simd_f)
+{
+  LBANN_CALIPER_MARK_FUNCTION;
+  if constexpr (has_simd_kernels<DataT>) {
+    if (use_simd_kernels<DataT>()) {
+      El::Int height = x1.Height(), width = x1.Width();
+      if (x1.Contiguous() && x2.Contiguous() && y.Contiguous()) {
+        height *= width;
+        width = 1;
+      }
+      const auto* x1_buffer = x1.LockedBuffer();
+      const auto* x2_buffer = x2.LockedBuffer();
+      auto* y_buffer = y.Buffer();
+      const auto x1_ldim = x1.LDim();
+      const auto x2_ldim = x2.LDim();
+      const auto y_ldim = y.LDim();
+      for_each_simd_block(height, width, [&](El::Int i, El::Int j, El::Int n) {
+        simd::apply_binary(x1_buffer + i + j * x1_ldim,
+                           x2_buffer + i + j * x2_ldim,
+                           y_buffer + i + j * y_ldim,
+                           n,
+                           simd_f);
+      });
+      return;
+    }
+  }
+  EntrywiseZipInto(x1, x2, y, f);
+}
+
+/** @brief Apply a binary operator to CPU data with the same functor
+ *         for the scalar and vectorized kernels.
+ */
+template <typename DataT, typename F>
+void apply_binary_operator(El::Matrix<DataT, El::Device::CPU> const& x1,
+                           El::Matrix<DataT, El::Device::CPU> const& x2,
+                           El::Matrix<DataT, El::Device::CPU>& y,
+                           F f)
+{
+  apply_binary_operator(x1, x2, y, f, f);
+}
+
 /** Apply a binary backprop operator to CPU data.
  *  The input and output data must be on CPU and must have the same
  *  dimensions. Given a binary function \f$ y = f(x_1,x_2) \f$, the
  *  corresponding BinaryBackPropOperator is a 5-ary function with the
  *  arguments \f$ x_1 \f$, \f$ x_2 \f$, \f$ dL/dy \f$, \f$ dL/dx_1\f$,
  *  \f$ dL/dx_2 \f$. The last two arguments should be overwritten when
- *  the BinaryBackPropOperator is called.
+ *  the BinaryBackPropOperator is called. Vectorized kernels call
+ *  @c simd_f instead of @c f (see apply_unary_operator).
  */
-template <typename DataT, typename F>
+template <typename DataT, typename F, typename SimdF>
 void apply_binary_backprop_operator(
   El::Matrix<DataT, El::Device::CPU> const& x1,
   El::Matrix<DataT, El::Device::CPU> const& x2,
   El::Matrix<DataT, El::Device::CPU> const& dy,
   El::Matrix<DataT, El::Device::CPU>& dx1,
   El::Matrix<DataT, El::Device::CPU>& dx2,
-  F f)
+  F f,
+  SimdF simd_f)
 {
   LBANN_CALIPER_MARK_FUNCTION;
+  if constexpr (has_simd_kernels<DataT>) {
+    if (use_simd_kernels<DataT>()) {
+      El::Int height = x1.Height(), width = x1.Width();
+      if (x1.Contiguous() && x2.Contiguous() && dy.Contiguous() &&
+          dx1.Contiguous() && dx2.Contiguous()) {
+        height *= width;
+        width = 1;
+      }
+      const auto* x1_buffer = x1.LockedBuffer();
+      const auto* x2_buffer = x2.LockedBuffer();
+      const auto* dy_buffer = dy.LockedBuffer();
+      auto* dx1_buffer = dx1.Buffer();
+      auto* dx2_buffer = dx2.Buffer();
+      const auto x1_ldim = x1.LDim();
+      const auto x2_ldim = x2.LDim();
+      const auto dy_ldim = dy.LDim();
+      const auto dx1_ldim = dx1.LDim();
+      const auto dx2_ldim = dx2.LDim();
+      for_each_simd_block(height, width, [&](El::Int i, El::Int j, El::Int n) {
+        simd::apply_binary_backprop(x1_buffer + i + j * x1_ldim,
+                                    x2_buffer + i + j * x2_ldim,
+                                    dy_buffer + i + j * dy_ldim,
+                                    dx1_buffer + i + j * dx1_ldim,
+                                    dx2_buffer + i + j * dx2_ldim,
+                                    n,
+                                    simd_f);
+      });
+      return;
+    }
+  }
   if (x1.Contiguous() && x2.Contiguous() && dy.Contiguous() &&
       dx1.Contiguous() && dx2.Contiguous()) {
     const auto* x1_buffer = x1.LockedBuffer();
@@ -119,6 +280,85 @@ void apply_binary_backprop_operator(
   }
 }
 
+/** Apply a binary backprop operator to CPU data with the same
+ *  functor for the scalar and vectorized kernels.
+ */
+template <typename DataT, typename F>
+void apply_binary_backprop_operator(
+  El::Matrix<DataT, El::Device::CPU> const& x1,
+  El::Matrix<DataT, El::Device::CPU> const& x2,
+  El::Matrix<DataT, El::Device::CPU> const& dy,
+  El::Matrix<DataT, El::Device::CPU>& dx1,
+  El::Matrix<DataT, El::Device::CPU>& dx2,
+  F f)
+{
+  apply_binary_backprop_operator(x1, x2, dy, dx1, dx2, f, f);
+}
+
+/** @brief Apply a unary operator to a contiguous block, y <- f(x).
+ *  @details @c x and @c y may alias. Vectorized kernels call
+ *           @c simd_f instead of @c f.
+ */
+template <typename DataT, typename F, typename SimdF>
+void apply_unary_block(DataT const* x, DataT* y, El::Int n, F f, SimdF simd_f)
+{
+  if constexpr (has_simd_kernels<DataT>) {
+    if (use_simd_kernels<DataT>()) {
+      simd::apply_unary(x, y, n, simd_f);
+      return;
+    }
+  }
+  for (El::Int i = 0; i < n; ++i) {
+    y[i] = f(x[i]);
+  }
+}
+
+/** @brief Apply a unary operator to a contiguous block with the same
+ *         functor for the scalar and vectorized kernels.
+ */
+template <typename DataT, typename F>
+void apply_unary_block(DataT const* x, DataT* y, El::Int n, F f)
+{
+  apply_unary_block(x, y, n, f, f);
+}
+
+/** @brief Apply a unary backprop operator to a contiguous block,
+ *         dx <- f(x,dy).
+ *  @details @c dy and @c dx may alias. Vectorized kernels call
+ *           @c simd_f instead of @c f.
+ */
+template <typename DataT, typename F, typename SimdF>
+void apply_unary_backprop_block(DataT const* x,
+                                DataT const* dy,
+                                DataT* dx,
+                                El::Int n,
+                                F f,
+                                SimdF simd_f)
+{
+  if constexpr (has_simd_kernels<DataT>) {
+    if (use_simd_kernels<DataT>()) {
+      simd::apply_binary(x, dy, dx, n, simd_f);
+      return;
+    }
+  }
+  for (El::Int i = 0; i < n; ++i) {
+    dx[i] = f(x[i], dy[i]);
+  }
+}
+
+/** @brief Apply a unary backprop operator to a contiguous block with
+ *         the same functor for the scalar and vectorized kernels.
+ */
+template <typename DataT, typename F>
+void apply_unary_backprop_block(DataT const* x,
+                                DataT const* dy,
+                                DataT* dx,
+                                El::Int n,
+                                F f)
+{
+  apply_unary_backprop_block(x, dy, dx, n, f, f);
+}
+
 /** @brief A ternary entrywise map c <- f(a,b,c).
  */
 template <typename S, typename T, typename U, typename R, typename F>
@@ -27,6 +27,7 @@
 #include "lbann/operators/math/unary.hpp"
 
 #include "common.hpp"
+#include "lbann/utils/simd_math.hpp"
 
 namespace lbann {
 namespace {
@@ -494,10 +495,119 @@ struct GeluOpImpl
   }
 };
 
+// Vectorized implementations of operators that call math library
+// functions. They are used by the vectorized CPU kernels for float
+// and double (see lbann/utils/simd.hpp).
+
+template <typename DataT>
+struct ExpSimdOpImpl
+{
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x) const noexcept
+  {
+    return simd::exp(x);
+  }
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x,
+                                     DataT const& dy) const noexcept
+  {
+    return dy * simd::exp(x);
+  }
+};
+
+template <typename DataT>
+struct Expm1SimdOpImpl
+{
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x) const noexcept
+  {
+    return simd::expm1(x);
+  }
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x,
+                                     DataT const& dy) const noexcept
+  {
+    return dy * simd::exp(x);
+  }
+};
+
+template <typename DataT>
+struct LogSimdOpImpl
+{
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x) const noexcept
+  {
+    return simd::log(x);
+  }
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x,
+                                     DataT const& dy) const noexcept
+  {
+    return dy / x;
+  }
+};
+
+template <typename DataT>
+struct Log1pSimdOpImpl
+{
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x) const noexcept
+  {
+    return simd::log1p(x);
+  }
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x,
+                                     DataT const& dy) const noexcept
+  {
+    return dy / (x + DataT(1));
+  }
+};
+
+template <typename DataT>
+struct TanhSimdOpImpl
+{
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x) const noexcept
+  {
+    return simd::tanh(x);
+  }
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x,
+                                     DataT const& dy) const noexcept
+  {
+    // 1/cosh(x)^2 = 4e/(1+e)^2 with e = exp(-2|x|), which does not
+    // overflow or lose accuracy for large |x|
+    const DataT e = simd::exp(DataT(-2) * std::fabs(x));
+    const DataT denom = DataT(1) + e;
+    return dy * (DataT(4) * e) / (denom * denom);
+  }
+};
+
+template <typename DataT>
+struct GeluSimdOpImpl
+{
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x) const noexcept
+  {
+    const DataT sqrt_two_over_pi = DataT(0.7978845608028654);
+    const DataT coeff = DataT(0.044715);
+    const DataT hx = x * DataT(0.5);
+    return hx * (DataT(1) + simd::tanh(sqrt_two_over_pi *
+                                       (x + coeff * x * x * x)));
+  }
+  LBANN_SIMD_INLINE DataT operator()(DataT const& x,
+                                     DataT const& dy) const noexcept
+  {
+    const DataT c1 = DataT(0.797885);
+    const DataT c2 = DataT(0.107032);
+    const DataT c3 = DataT(0.0356774);
+    const DataT x3 = x * x * x;
+    const DataT c1x = c1 * x;
+    const DataT u = c1x + c3 * x3;
+    // sech(u)^2 as in TanhSimdOpImpl
+    const DataT e = simd::exp(DataT(-2) * std::fabs(u));
+    const DataT denom = DataT(1) + e;
+    const DataT sech2 = DataT(4) * e / (denom * denom);
+    const DataT dx = DataT(1) + (c1x + c2 * x3) * sech2 + simd::tanh(u);
+    return dx * dy * DataT(0.5);
+  }
+};
+
 } // namespace
 
 // Template instantiation
 #define DEFINE_COMPUTE_OPS(OP_NAME)                                            \
+  DEFINE_SIMD_COMPUTE_OPS(OP_NAME, OP_NAME##OpImpl)
+#define DEFINE_SIMD_COMPUTE_OPS(OP_NAME, SIMD_IMPL)                            \
   template <typename DataT, El::Device Device>                                 \
   void OP_NAME##Operator<DataT, Device>::fp_compute_local(                     \
     std::vector<ConstLocalInputTensorType> inputs,                             \
@@ -507,10 +617,10 @@ struct GeluOpImpl
     LBANN_ASSERT_DEBUG(outputs.size() == 1);                                   \
     auto const& input = inputs.front().data();                                 \
     auto& output = outputs.front().data();                                     \
-    El::EntrywiseMap(                                                          \
-      input,                                                                   \
-      output,                                                                  \
-      std::function<DataT(DataT const&)>(OP_NAME##OpImpl<DataT>{}));           \
+    internal::apply_unary_operator(input,                                      \
+                                   output,                                     \
+                                   OP_NAME##OpImpl<DataT>{},                   \
+                                   SIMD_IMPL<DataT>{});                        \
   }                                                                            \
   template <typename DataT, El::Device Device>                                 \
   void OP_NAME##Operator<DataT, Device>::bp_compute_local(                     \
@@ -524,10 +634,35 @@ struct GeluOpImpl
     auto const& input = inputs.front().data();                                 \
     auto const& grad_wrt_output = grads_wrt_outputs.front().data();            \
     auto& grad_wrt_input = grads_wrt_inputs.front().data();                    \
-    internal::EntrywiseZipInto(input,                                          \
-                               grad_wrt_output,                                \
-                               grad_wrt_input,                                 \
-                               OP_NAME##OpImpl<DataT>{});                      \
+    internal::apply_binary_operator(input,                                     \
+                                    grad_wrt_output,                           \
+                                    grad_wrt_input,                            \
+                                    OP_NAME##OpImpl<DataT>{},                  \
+                                    SIMD_IMPL<DataT>{});                       \
+  }                                                                            \
+  template <typename DataT, El::Device Device>                                 \
+  void OP_NAME##Operator<DataT, Device>::fp_compute_block(DataT const* x,      \
+                                                          DataT* y,            \
+                                                          El::Int n) const     \
+  {                                                                            \
+    internal::apply_unary_block(x,                                             \
+                                y,                                             \
+                                n,                                             \
+                                OP_NAME##OpImpl<DataT>{},                      \
+                                SIMD_IMPL<DataT>{});                           \
+  }                                                                            \
+  template <typename DataT, El::Device Device>                                 \
+  void OP_NAME##Operator<DataT, Device>::bp_compute_block(DataT const* x,      \
+                                                          DataT const* dy,     \
+                                                          DataT* dx,           \
+                                                          El::Int n) const     \
+  {                                                                            \
+    internal::apply_unary_backprop_block(x,                                    \
+                                         dy,                                   \
+                                         dx,                                   \
+                                         n,                                    \
+                                         OP_NAME##OpImpl<DataT>{},             \
+                                         SIMD_IMPL<DataT>{});                  \
   }
 
 DEFINE_COMPUTE_OPS(Acos)
@@ -541,12 +676,12 @@ DEFINE_COMPUTE_OPS(Cos)
 DEFINE_COMPUTE_OPS(Cosh)
 DEFINE_COMPUTE_OPS(Erf)
 DEFINE_COMPUTE_OPS(ErfInv)
-DEFINE_COMPUTE_OPS(Exp)
-DEFINE_COMPUTE_OPS(Expm1)
+DEFINE_SIMD_COMPUTE_OPS(Exp, ExpSimdOpImpl)
+DEFINE_SIMD_COMPUTE_OPS(Expm1, Expm1SimdOpImpl)
 DEFINE_COMPUTE_OPS(Floor)
-DEFINE_COMPUTE_OPS(Gelu)
-DEFINE_COMPUTE_OPS(Log)
-DEFINE_COMPUTE_OPS(Log1p)
+DEFINE_SIMD_COMPUTE_OPS(Gelu, GeluSimdOpImpl)
+DEFINE_SIMD_COMPUTE_OPS(Log, LogSimdOpImpl)
+DEFINE_SIMD_COMPUTE_OPS(Log1p, Log1pSimdOpImpl)
 DEFINE_COMPUTE_OPS(LogicalNot)
 DEFINE_COMPUTE_OPS(Negative)
 DEFINE_COMPUTE_OPS(Reciprocal)
@@ -559,7 +694,7 @@ DEFINE_COMPUTE_OPS(Sinh)
 DEFINE_COMPUTE_OPS(Sqrt)
 DEFINE_COMPUTE_OPS(Square)
 DEFINE_COMPUTE_OPS(Tan)
-DEFINE_COMPUTE_OPS(Tanh)
+DEFINE_SIMD_COMPUTE_OPS(Tanh, TanhSimdOpImpl)
 
 #define PROTO(T)                                                               \
   template class AcosOperator<T, El::Device::CPU>;                             \
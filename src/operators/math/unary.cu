@@ -547,6 +547,21 @@ struct GeluOpImpl
                                grad_wrt_output,                                \
                                grad_wrt_input,                                 \
                                OP_NAME##OpImpl<DataT>{});                      \
+  }                                                                            \
+  template <typename DataT, El::Device Device>                                 \
+  void OP_NAME##Operator<DataT, Device>::fp_compute_block(DataT const*,        \
+                                                          DataT*,              \
+                                                          El::Int) const       \
+  {                                                                            \
+    LBANN_ERROR("block kernels are only available on CPU");                    \
+  }                                                                            \
+  template <typename DataT, El::Device Device>                                 \
+  void OP_NAME##Operator<DataT, Device>::bp_compute_block(DataT const*,        \
+                                                          DataT const*,        \
+                                                          DataT*,              \
+                                                          El::Int) const       \
+  {                                                                            \
+    LBANN_ERROR("block kernels are only available on CPU");                    \
   }
 
 DEFINE_COMPUTE_OPS(Acos)
@@ -0,0 +1,316 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+// Testing framework stuff
+#include "Catch2BasicSupport.hpp"
+
+#include "MPITestHelpers.hpp"
+#include "TestHelpers.hpp"
+
+#include "OperatorTraits.hpp"
+
+// CUT
+#include "lbann/operators/activations/activations.hpp"
+#include "lbann/operators/loss/entrywise.hpp"
+#include "lbann/operators/math/unary.hpp"
+#include "lbann/utils/simd.hpp"
+
+#include <h2/meta/TypeList.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace lbann;
+
+// The vectorized kernels are compared against the scalar functors
+// that run with the reference instruction set. Both run on the same
+// inputs, laid out contiguously or as views of taller matrices.
+
+namespace {
+
+using SimdOperatorTypes = h2::meta::TL<
+#ifdef LBANN_HAS_DOUBLE
+  double,
+#endif // LBANN_HAS_DOUBLE
+  float>;
+
+template <typename T>
+using MatType = DataParallelMatrixType<T, El::Device::CPU>;
+
+constexpr El::Int height = 67;
+constexpr El::Int width = 9;
+
+/** @brief Restores the instruction set on destruction. */
+class isa_guard
+{
+public:
+  isa_guard() : m_isa{simd::get_isa()} {}
+  ~isa_guard() { simd::set_isa(m_isa); }
+
+private:
+  simd::isa m_isa;
+};
+
+/** @brief A matrix that is either contiguous or a view of the first
+ *         rows of a matrix with twice the height.
+ */
+template <typename T>
+struct TestMatrix
+{
+  TestMatrix(El::Grid const& g, bool contiguous)
+    : storage(contiguous ? height : 2 * height, width, g, 0), view(g)
+  {
+    El::Fill(storage, El::To<T>(-7.));
+    El::View(view, storage, El::IR(0, height), El::ALL);
+  }
+  MatType<T> storage;
+  MatType<T> view;
+};
+
+/** @brief Number of entries that differ by more than a few ULP.
+ *  @details NaNs must match. Small values are compared with an
+ *           absolute tolerance.
+ */
+template <typename T>
+El::Int count_mismatches(MatType<T> const& ref, MatType<T> const& val)
+{
+  const T tol = 64 * std::numeric_limits<T>::epsilon();
+  auto const& ref_local = ref.LockedMatrix();
+  auto const& val_local = val.LockedMatrix();
+  El::Int mismatches = 0;
+  for (El::Int j = 0; j < ref_local.Width(); ++j) {
+    for (El::Int i = 0; i < ref_local.Height(); ++i) {
+      const T a = ref_local.Get(i, j);
+      const T b = val_local.Get(i, j);
+      if (std::isnan(a) || std::isnan(b)) {
+        mismatches += (std::isnan(a) && std::isnan(b)) ? 0 : 1;
+      }
+      else if (a != b && std::fabs(a - b) > tol * (1 + std::fabs(a))) {
+        ++mismatches;
+      }
+    }
+  }
+  return mismatches;
+}
+
+/** @brief Whether every local entry is zero. */
+template <typename T>
+bool all_zero(MatType<T> const& x)
+{
+  auto const& x_local = x.LockedMatrix();
+  for (El::Int j = 0; j < x_local.Width(); ++j) {
+    for (El::Int i = 0; i < x_local.Height(); ++i) {
+      if (x_local.Get(i, j) != T(0)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/** @brief Compare a unary operator and its derivative on inputs
+ *         uniform in [center-radius,center+radius].
+ */
+template <typename T, typename OpT>
+void check_unary(OpT const& op,
+                 El::Grid const& g,
+                 bool contiguous,
+                 T center,
+                 T radius)
+{
+  TestMatrix<T> x(g, contiguous), dy(g, contiguous);
+  TestMatrix<T> y_ref(g, contiguous), y(g, contiguous);
+  TestMatrix<T> dx_ref(g, contiguous), dx(g, contiguous);
+  El::MakeUniform(x.view, center, radius);
+  El::MakeUniform(dy.view);
+  if (x.view.LocalWidth() > 0) {
+    // Endpoints of the range and zero (if it is in the range)
+    x.view.Matrix().Set(0, 0, center - radius);
+    x.view.Matrix().Set(1, 0, center + radius);
+    x.view.Matrix().Set(2, 0, std::max(center - radius, T(0)));
+  }
+
+  simd::set_isa(simd::isa::reference);
+  op.fp_compute({x.view}, {y_ref.view});
+  op.bp_compute({x.view}, {dy.view}, {dx_ref.view});
+  simd::set_isa(simd::detected_isa());
+  op.fp_compute({x.view}, {y.view});
+  op.bp_compute({x.view}, {dy.view}, {dx.view});
+
+  CHECK(count_mismatches(y_ref.view, y.view) == 0);
+  CHECK(count_mismatches(dx_ref.view, dx.view) == 0);
+  if (!contiguous) {
+    // Rows outside the views are untouched
+    auto const& storage = y.storage.LockedMatrix();
+    for (El::Int j = 0; j < storage.Width(); ++j) {
+      CHECK(storage.Get(height, j) == El::To<T>(-7.));
+    }
+  }
+}
+
+/** @brief Compare a binary loss operator and its derivatives. */
+template <typename T, typename OpT>
+void check_binary(OpT const& op,
+                  TestMatrix<T> const& x1,
+                  TestMatrix<T> const& x2,
+                  TestMatrix<T> const& dy,
+                  El::Grid const& g,
+                  bool contiguous)
+{
+  TestMatrix<T> y_ref(g, contiguous), y(g, contiguous);
+  TestMatrix<T> dx1_ref(g, contiguous), dx1(g, contiguous);
+  TestMatrix<T> dx2_ref(g, contiguous), dx2(g, contiguous);
+
+  simd::set_isa(simd::isa::reference);
+  op.fp_compute({x1.view, x2.view}, {y_ref.view});
+  op.bp_compute({x1.view, x2.view}, {dy.view}, {dx1_ref.view, dx2_ref.view});
+  simd::set_isa(simd::detected_isa());
+  op.fp_compute({x1.view, x2.view}, {y.view});
+  op.bp_compute({x1.view, x2.view}, {dy.view}, {dx1.view, dx2.view});
+
+  CHECK(count_mismatches(y_ref.view, y.view) == 0);
+  CHECK(count_mismatches(dx1_ref.view, dx1.view) == 0);
+  CHECK(count_mismatches(dx2_ref.view, dx2.view) == 0);
+}
+
+} // namespace
+
+TEMPLATE_LIST_TEST_CASE("Vectorized operators match the reference kernels",
+                        "[mpi][operator][simd]",
+                        SimdOperatorTypes)
+{
+  using T = TestType;
+  constexpr auto D = El::Device::CPU;
+
+  auto& world_comm = unit_test::utilities::current_world_comm();
+  auto const& g = world_comm.get_trainer_grid();
+  isa_guard guard;
+
+  for (const bool contiguous : {true, false}) {
+    const auto* layout = contiguous ? "contiguous" : "strided";
+
+    DYNAMIC_SECTION("Math operators (" << layout << ")")
+    {
+      check_unary(ExpOperator<T, D>{}, g, contiguous, T(0), T(80));
+      check_unary(Expm1Operator<T, D>{}, g, contiguous, T(0), T(80));
+      check_unary(LogOperator<T, D>{}, g, contiguous, T(50), T(49.99));
+      check_unary(Log1pOperator<T, D>{}, g, contiguous, T(10), T(10.99));
+      check_unary(TanhOperator<T, D>{}, g, contiguous, T(0), T(30));
+      check_unary(GeluOperator<T, D>{}, g, contiguous, T(0), T(30));
+    }
+
+    DYNAMIC_SECTION("Activation operators (" << layout << ")")
+    {
+      check_unary(LogSigmoidOperator<T, D>{}, g, contiguous, T(0), T(30));
+      check_unary(SeluOperator<T, D>{}, g, contiguous, T(0), T(30));
+      check_unary(SigmoidOperator<T, D>{}, g, contiguous, T(0), T(30));
+      check_unary(SoftplusOperator<T, D>{}, g, contiguous, T(0), T(30));
+    }
+
+    DYNAMIC_SECTION("Binary cross entropy (" << layout << ")")
+    {
+      TestMatrix<T> x1(g, contiguous), x2(g, contiguous), dy(g, contiguous);
+      El::MakeUniform(x1.view, T(0.5), T(0.5));
+      El::MakeUniform(dy.view);
+      El::Zero(x2.view);
+      auto& x1_local = x1.view.Matrix();
+      auto& x2_local = x2.view.Matrix();
+      auto& dy_local = dy.view.Matrix();
+      for (El::Int j = 0; j < x2_local.Width(); ++j) {
+        for (El::Int i = 0; i < height; ++i) {
+          x2_local.Set(i, j, T(i % 3) / T(2));
+        }
+        // log(0) terms are masked when their label weight is zero
+        x1_local.Set(0, j, T(0));
+        x2_local.Set(0, j, T(0));
+        x1_local.Set(1, j, T(1));
+        x2_local.Set(1, j, T(1));
+        // Nothing is computed when the gradient is zero
+        x1_local.Set(2, j, T(0));
+        x2_local.Set(2, j, T(0.5));
+        dy_local.Set(2, j, T(0));
+      }
+
+      check_binary(BinaryCrossEntropyOperator<T, D>{},
+                   x1,
+                   x2,
+                   dy,
+                   g,
+                   contiguous);
+
+      TestMatrix<T> dx1(g, contiguous), dx2(g, contiguous);
+      BinaryCrossEntropyOperator<T, D>{}.bp_compute({x1.view, x2.view},
+                                                    {dy.view},
+                                                    {dx1.view, dx2.view});
+      MatType<T> masked1(g), masked2(g);
+      El::LockedView(masked1, dx1.view, El::IR(0, 3), El::ALL);
+      El::LockedView(masked2, dx2.view, El::IR(0, 3), El::ALL);
+      CHECK(all_zero(masked2));
+      for (El::Int j = 0; j < masked1.LocalWidth(); ++j) {
+        CHECK(std::isfinite(masked1.GetLocal(0, j)));
+        CHECK(std::isfinite(masked1.GetLocal(1, j)));
+        CHECK(masked1.GetLocal(2, j) == T(0));
+      }
+    }
+
+    DYNAMIC_SECTION("Sigmoid binary cross entropy (" << layout << ")")
+    {
+      TestMatrix<T> x1(g, contiguous), x2(g, contiguous), dy(g, contiguous);
+      El::MakeUniform(x1.view, T(0), T(30));
+      El::MakeUniform(dy.view);
+      auto& x2_local = x2.view.Matrix();
+      for (El::Int j = 0; j < x2_local.Width(); ++j) {
+        for (El::Int i = 0; i < height; ++i) {
+          // Labels outside [0,1] have no gradient
+          x2_local.Set(i, j, T(i % 5 - 1) / T(2));
+        }
+      }
+
+      check_binary(SigmoidBinaryCrossEntropyOperator<T, D>{},
+                   x1,
+                   x2,
+                   dy,
+                   g,
+                   contiguous);
+
+      TestMatrix<T> dx1(g, contiguous), dx2(g, contiguous);
+      SigmoidBinaryCrossEntropyOperator<T, D>{}.bp_compute(
+        {x1.view, x2.view},
+        {dy.view},
+        {dx1.view, dx2.view});
+      auto const& dx2_local = dx2.view.LockedMatrix();
+      for (El::Int j = 0; j < dx2_local.Width(); ++j) {
+        for (El::Int i = 0; i < height; ++i) {
+          const T label = x2_local.Get(i, j);
+          if (label < T(0) || label > T(1)) {
+            CHECK(dx2_local.Get(i, j) == T(0));
+          }
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,194 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+// Testing framework stuff
+#include "Catch2BasicSupport.hpp"
+
+// CUT
+#include "lbann/operators/math/binary.hpp"
+#include "lbann/operators/math/binary_with_constant.hpp"
+#include "lbann/operators/math/clamp.hpp"
+#include "lbann/operators/math/unary.hpp"
+
+#include <h2/meta/TypeList.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace lbann;
+
+using BlockKernelTypes = h2::meta::TL<
+#ifdef LBANN_HAS_DOUBLE
+  double,
+#endif // LBANN_HAS_DOUBLE
+  float>;
+
+TEMPLATE_LIST_TEST_CASE("Unary operator block kernels",
+                        "[operator][math][fusion]",
+                        BlockKernelTypes)
+{
+  using T = TestType;
+  constexpr auto D = El::Device::CPU;
+  constexpr El::Int n = 300;
+
+  NegativeOperator<T, D> negative;
+  ExpOperator<T, D> exp;
+  SquareOperator<T, D> square;
+
+  std::vector<T> x(n), dy(n);
+  for (El::Int i = 0; i < n; ++i) {
+    x[i] = static_cast<T>(i % 17 - 8) / T(8);
+    dy[i] = static_cast<T>(i % 5 - 2) / T(3);
+  }
+
+  SECTION("Availability")
+  {
+    CHECK(negative.has_block_kernels());
+    CHECK(exp.has_block_kernels());
+    CHECK(square.has_block_kernels());
+    CHECK_FALSE(AddOperator<T, D>{}.has_block_kernels());
+  }
+
+  SECTION("Forward chain in place")
+  {
+    // y = (exp(-x))^2 = exp(-2x)
+    std::vector<T> y(x);
+    negative.fp_compute_block(y.data(), y.data(), n);
+    exp.fp_compute_block(y.data(), y.data(), n);
+    square.fp_compute_block(y.data(), y.data(), n);
+    for (El::Int i = 0; i < n; ++i) {
+      CHECK(y[i] == Approx(std::exp(T(-2) * x[i])));
+    }
+  }
+
+  SECTION("Backward chain with recomputed inputs")
+  {
+    // Recompute the input of each operator, then apply the chain
+    // rule in reverse order. dx = -2 exp(-2x) dy
+    std::vector<T> a1(n), a2(n), grad(n), dx(n);
+    negative.fp_compute_block(x.data(), a1.data(), n);
+    exp.fp_compute_block(a1.data(), a2.data(), n);
+    square.bp_compute_block(a2.data(), dy.data(), grad.data(), n);
+    exp.bp_compute_block(a1.data(), grad.data(), grad.data(), n);
+    negative.bp_compute_block(x.data(), grad.data(), dx.data(), n);
+    for (El::Int i = 0; i < n; ++i) {
+      CHECK(dx[i] == Approx(T(-2) * std::exp(T(-2) * x[i]) * dy[i]));
+    }
+  }
+}
+
+TEMPLATE_LIST_TEST_CASE("Clamp and constant operator block kernels",
+                        "[operator][math][fusion]",
+                        BlockKernelTypes)
+{
+  using T = TestType;
+  constexpr auto D = El::Device::CPU;
+  constexpr El::Int n = 300;
+
+  // Inputs include entries equal to the constant and the clamp bounds
+  std::vector<T> x(n), dy(n), y(n), dx(n);
+  for (El::Int i = 0; i < n; ++i) {
+    x[i] = static_cast<T>(i % 17 - 8) / T(8);
+    dy[i] = static_cast<T>(i % 5 - 2) / T(3);
+  }
+
+  SECTION("Clamp")
+  {
+    ClampOperator<T, D> op(-0.5, 0.75);
+    REQUIRE(op.has_block_kernels());
+    op.fp_compute_block(x.data(), y.data(), n);
+    op.bp_compute_block(x.data(), dy.data(), dx.data(), n);
+    for (El::Int i = 0; i < n; ++i) {
+      CHECK(y[i] == std::max(T(-0.5), std::min(T(0.75), x[i])));
+      const bool inside = x[i] > T(-0.5) && x[i] < T(0.75);
+      CHECK(dx[i] == (inside ? dy[i] : T(0)));
+    }
+  }
+
+  SECTION("Add constant")
+  {
+    AddConstantOperator<T, D> op(0.25);
+    REQUIRE(op.has_block_kernels());
+    op.fp_compute_block(x.data(), y.data(), n);
+    op.bp_compute_block(x.data(), dy.data(), dx.data(), n);
+    for (El::Int i = 0; i < n; ++i) {
+      CHECK(y[i] == x[i] + T(0.25));
+      CHECK(dx[i] == dy[i]);
+    }
+  }
+
+  SECTION("Scale in place")
+  {
+    ScaleOperator<T, D> op(3.);
+    REQUIRE(op.has_block_kernels());
+    std::vector<T> grad(dy);
+    y = x;
+    op.fp_compute_block(y.data(), y.data(), n);
+    op.bp_compute_block(x.data(), grad.data(), grad.data(), n);
+    for (El::Int i = 0; i < n; ++i) {
+      CHECK(y[i] == x[i] * T(3));
+      CHECK(grad[i] == dy[i] * T(3));
+    }
+  }
+
+  SECTION("Constant subtract")
+  {
+    ConstantSubtractOperator<T, D> op(1.);
+    REQUIRE(op.has_block_kernels());
+    op.fp_compute_block(x.data(), y.data(), n);
+    op.bp_compute_block(x.data(), dy.data(), dx.data(), n);
+    for (El::Int i = 0; i < n; ++i) {
+      CHECK(y[i] == T(1) - x[i]);
+      CHECK(dx[i] == -dy[i]);
+    }
+  }
+
+  SECTION("Max constant splits the gradient at ties")
+  {
+    MaxConstantOperator<T, D> op(0.25);
+    REQUIRE(op.has_block_kernels());
+    op.fp_compute_block(x.data(), y.data(), n);
+    op.bp_compute_block(x.data(), dy.data(), dx.data(), n);
+    for (El::Int i = 0; i < n; ++i) {
+      CHECK(y[i] == std::max(T(0.25), x[i]));
+      const T expected =
+        x[i] < T(0.25) ? T(0) : (x[i] > T(0.25) ? dy[i] : dy[i] / T(2));
+      CHECK(dx[i] == expected);
+    }
+  }
+
+  SECTION("Comparison with a constant")
+  {
+    LessEqualConstantOperator<T, D> op(0.25);
+    REQUIRE(op.has_block_kernels());
+    op.fp_compute_block(x.data(), y.data(), n);
+    op.bp_compute_block(x.data(), dy.data(), dx.data(), n);
+    for (El::Int i = 0; i < n; ++i) {
+      CHECK(y[i] == (x[i] <= T(0.25) ? T(1) : T(0)));
+      CHECK(dx[i] == T(0));
+    }
+  }
+}
@@ -0,0 +1,435 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/optimizers/gradient_compression.hpp"
+#include "lbann/comm_impl.hpp"
+#include "lbann/utils/exception.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace lbann {
+
+std::string to_string(gradient_compression_type type)
+{
+  switch (type) {
+  case gradient_compression_type::none:
+    return "none";
+  case gradient_compression_type::fp16:
+    return "fp16";
+  case gradient_compression_type::bf16:
+    return "bf16";
+  case gradient_compression_type::top_k:
+    return "top-k";
+  case gradient_compression_type::random_k:
+    return "random-k";
+  default:
+    return "unknown";
+  }
+}
+
+namespace gradient_compression {
+
+size_t num_sparse_entries(size_t size, double ratio)
+{
+  if (size == 0) {
+    return 0;
+  }
+  const auto k = static_cast<size_t>(std::ceil(ratio * size));
+  return std::max(std::min(k, size), size_t{1});
+}
+
+template <typename T>
+void select_top_k(const T* values,
+                  size_t size,
+                  size_t k,
+                  std::vector<uint32_t>& indices)
+{
+  if (indices.size() != size) {
+    indices.resize(size);
+  }
+  std::iota(indices.begin(), indices.end(), uint32_t{0});
+  if (k >= size) {
+    return;
+  }
+  auto magnitude = [values](uint32_t i) {
+    const T x = values[i];
+    return std::isnan(x) ? std::numeric_limits<T>::infinity() : std::abs(x);
+  };
+  std::nth_element(indices.begin(),
+                   indices.begin() + k,
+                   indices.end(),
+                   [&magnitude](uint32_t a, uint32_t b) {
+                     return magnitude(a) > magnitude(b);
+                   });
+}
+
+} // namespace gradient_compression
+
+namespace {
+
+using gradient_compression::bfloat16_bits_to_float;
+using gradient_compression::float_to_bfloat16_bits;
+using gradient_compression::float_to_half_bits;
+using gradient_compression::half_bits_to_float;
+
+/** Largest sum magnitude targeted by the half-precision scaling.
+ *  One bit below the largest finite value to leave room for rounding.
+ */
+constexpr float half_sum_limit = 32768.f;
+/** Headroom for growth of the gradient between steps. */
+constexpr float half_sum_headroom = 16.f;
+
+// Partial sums are added in single precision and rounded back to 16
+// bits at every step of the reduction.
+void sum_half(void* in, void* inout, int* len, MPI_Datatype*)
+{
+  const auto* x = static_cast<const uint16_t*>(in);
+  auto* y = static_cast<uint16_t*>(inout);
+  for (int i = 0; i < *len; ++i) {
+    y[i] = float_to_half_bits(half_bits_to_float(x[i]) +
+                              half_bits_to_float(y[i]));
+  }
+}
+
+void sum_bfloat16(void* in, void* inout, int* len, MPI_Datatype*)
+{
+  const auto* x = static_cast<const uint16_t*>(in);
+  auto* y = static_cast<uint16_t*>(inout);
+  for (int i = 0; i < *len; ++i) {
+    y[i] = float_to_bfloat16_bits(bfloat16_bits_to_float(x[i]) +
+                                  bfloat16_bits_to_float(y[i]));
+  }
+}
+
+/** MPI reduction operations are created on first use and live until
+ *  MPI is finalized.
+ */
+MPI_Op get_sum_op(gradient_compression_type type)
+{
+  static MPI_Op half_op = MPI_OP_NULL;
+  static MPI_Op bfloat16_op = MPI_OP_NULL;
+  auto& op = (type == gradient_compression_type::fp16 ? half_op : bfloat16_op);
+  if (op == MPI_OP_NULL) {
+    MPI_Op_create(
+      (type == gradient_compression_type::fp16 ? &sum_half : &sum_bfloat16),
+      /*commute=*/1,
+      &op);
+  }
+  return op;
+}
+
+} // namespace
+
+template <typename T>
+gradient_compressor<T>::gradient_compressor(
+  gradient_compression_config const& config)
+  : m_config{config}, m_rng{config.seed}
+{
+  switch (m_config.type) {
+  case gradient_compression_type::top_k:
+  case gradient_compression_type::random_k:
+    if (!(m_config.ratio > 0.0 && m_config.ratio <= 1.0)) {
+      LBANN_ERROR("gradient compression ratio must be in (0,1], got ",
+                  m_config.ratio);
+    }
+    break;
+  case gradient_compression_type::fp16:
+  case gradient_compression_type::bf16:
+    break;
+  default:
+    LBANN_ERROR("invalid gradient compression type (",
+                to_string(m_config.type),
+                ")");
+  }
+}
+
+template <typename T>
+void gradient_compressor<T>::start(lbann_comm& comm,
+                                   T* data,
+                                   size_t size,
+                                   El::mpi::Comm const& c,
+                                   Al::request& req)
+{
+  if (m_data != nullptr) {
+    LBANN_ERROR("attempted to start gradient compression "
+                "while a synchronization is in progress");
+  }
+  // MPI counts are ints
+  if (size > static_cast<size_t>(std::numeric_limits<int>::max())) {
+    LBANN_ERROR("gradient compression does not support buffers with more "
+                "than ",
+                std::numeric_limits<int>::max(),
+                " entries (got ",
+                size,
+                ")");
+  }
+  m_data = data;
+  m_size = size;
+  m_comm = &comm;
+  m_mpi_comm = &c;
+  m_comm_size = El::mpi::Size(c);
+  m_passthrough = false;
+  switch (m_config.type) {
+  case gradient_compression_type::fp16:
+  case gradient_compression_type::bf16:
+    start_cast(comm, c, req);
+    break;
+  case gradient_compression_type::top_k:
+    start_top_k(comm, c, req);
+    break;
+  case gradient_compression_type::random_k:
+    start_random_k(comm, c, req);
+    break;
+  default:
+    LBANN_ERROR("invalid gradient compression type");
+  }
+}
+
+template <typename T>
+void gradient_compressor<T>::start_cast(lbann_comm& comm,
+                                        El::mpi::Comm const& c,
+                                        Al::request& req)
+{
+  const bool is_half = (m_config.type == gradient_compression_type::fp16);
+  if (is_half && !m_has_scale) {
+    // The scale is chosen from a full-precision sum
+    m_passthrough = true;
+    comm.nb_allreduce(m_data, static_cast<int>(m_size), c, req);
+    return;
+  }
+  const float scale = is_half ? m_scale : 1.f;
+  m_packed.resize(m_size);
+  for (size_t i = 0; i < m_size; ++i) {
+    const float x = static_cast<float>(m_data[i]) * scale;
+    m_packed[i] = is_half ? float_to_half_bits(x) : float_to_bfloat16_bits(x);
+  }
+  comm.nb_allreduce(m_packed.data(),
+                    static_cast<int>(m_size),
+                    c,
+                    req,
+                    MPI_UINT16_T,
+                    get_sum_op(m_config.type));
+}
+
+template <typename T>
+void gradient_compressor<T>::start_top_k(lbann_comm& comm,
+                                         El::mpi::Comm const& c,
+                                         Al::request& req)
+{
+  apply_residual();
+  m_num_entries =
+    gradient_compression::num_sparse_entries(m_size, m_config.ratio);
+  gradient_compression::select_top_k(m_data, m_size, m_num_entries, m_indices);
+
+  // Pack indices followed by values
+  const size_t index_bytes = m_num_entries * sizeof(uint32_t);
+  const size_t entry_bytes = index_bytes + m_num_entries * sizeof(T);
+  if (entry_bytes > static_cast<size_t>(std::numeric_limits<int>::max())) {
+    LBANN_ERROR("top-k gradient compression message is too large (",
+                entry_bytes,
+                " bytes)");
+  }
+  m_send_buffer.resize(entry_bytes);
+  m_recv_buffer.resize(entry_bytes * m_comm_size);
+  std::memcpy(m_send_buffer.data(), m_indices.data(), index_bytes);
+  auto* values = m_send_buffer.data() + index_bytes;
+  for (size_t i = 0; i < m_num_entries; ++i) {
+    std::memcpy(values + i * sizeof(T), &m_data[m_indices[i]], sizeof(T));
+  }
+  update_residual(m_indices.data(), m_num_entries);
+
+  comm.nb_all_gather(m_send_buffer.data(),
+                     static_cast<int>(entry_bytes),
+                     m_recv_buffer.data(),
+                     static_cast<int>(entry_bytes),
+                     c,
+                     req);
+}
+
+template <typename T>
+void gradient_compressor<T>::start_random_k(lbann_comm& comm,
+                                            El::mpi::Comm const& c,
+                                            Al::request& req)
+{
+  apply_residual();
+  m_num_entries =
+    gradient_compression::num_sparse_entries(m_size, m_config.ratio);
+
+  // Partial Fisher-Yates shuffle of a persistent permutation. Every
+  // rank draws the same sequence, so the selected indices agree
+  // without communication.
+  if (m_indices.size() != m_size) {
+    m_indices.resize(m_size);
+    std::iota(m_indices.begin(), m_indices.end(), uint32_t{0});
+  }
+  for (size_t i = 0; i < m_num_entries; ++i) {
+    std::uniform_int_distribution<size_t> dist(i, m_size - 1);
+    std::swap(m_indices[i], m_indices[dist(m_rng)]);
+  }
+
+  m_values.resize(m_num_entries);
+  for (size_t i = 0; i < m_num_entries; ++i) {
+    m_values[i] = m_data[m_indices[i]];
+  }
+  update_residual(m_indices.data(), m_num_entries);
+  comm.nb_allreduce(m_values.data(), static_cast<int>(m_num_entries), c, req);
+}
+
+template <typename T>
+void gradient_compressor<T>::update_half_scale()
+{
+  // The synchronized gradient is the same on every rank, so every
+  // rank chooses the same scale
+  float max_abs = 0.f;
+  for (size_t i = 0; i < m_size; ++i) {
+    const float x = std::abs(static_cast<float>(m_data[i]));
+    if (std::isfinite(x)) {
+      max_abs = std::max(max_abs, x);
+    }
+  }
+  if (max_abs > 0.f) {
+    const float exponent =
+      std::floor(std::log2(half_sum_limit / (half_sum_headroom * max_abs)));
+    m_scale = std::ldexp(
+      1.f,
+      static_cast<int>(std::max(std::min(exponent, 64.f), -126.f)));
+    m_has_scale = true;
+  }
+}
+
+template <typename T>
+void gradient_compressor<T>::apply_residual()
+{
+  if (!m_config.error_feedback) {
+    return;
+  }
+  if (m_residual.size() != m_size) {
+    m_residual.assign(m_size, T(0));
+  }
+  for (size_t i = 0; i < m_size; ++i) {
+    m_data[i] += m_residual[i];
+  }
+}
+
+template <typename T>
+void gradient_compressor<T>::update_residual(const uint32_t* sent,
+                                             size_t num_sent)
+{
+  if (!m_config.error_feedback) {
+    return;
+  }
+  // Non-finite values are dropped so that a skipped step does not
+  // poison later gradients.
+  for (size_t i = 0; i < m_size; ++i) {
+    const T x = m_data[i];
+    m_residual[i] = std::isfinite(x) ? x : T(0);
+  }
+  for (size_t i = 0; i < num_sent; ++i) {
+    m_residual[sent[i]] = T(0);
+  }
+}
+
+template <typename T>
+void gradient_compressor<T>::finish()
+{
+  if (m_data == nullptr) {
+    return;
+  }
+  if (!m_passthrough) {
+    switch (m_config.type) {
+    case gradient_compression_type::fp16: {
+      const bool is_finite =
+        std::none_of(m_packed.cbegin(), m_packed.cend(), [](uint16_t h) {
+          return (h & 0x7C00u) == 0x7C00u;
+        });
+      if (!is_finite) {
+        // Sum again at full precision so that the caller sees whether
+        // the gradient itself is finite
+        m_comm->allreduce(m_data, static_cast<int>(m_size), *m_mpi_comm);
+        break;
+      }
+      const float inv_scale = 1.f / m_scale;
+      for (size_t i = 0; i < m_size; ++i) {
+        m_data[i] = static_cast<T>(half_bits_to_float(m_packed[i]) * inv_scale);
+      }
+      break;
+    }
+    case gradient_compression_type::bf16:
+      for (size_t i = 0; i < m_size; ++i) {
+        m_data[i] = static_cast<T>(bfloat16_bits_to_float(m_packed[i]));
+      }
+      break;
+    case gradient_compression_type::top_k: {
+      std::fill(m_data, m_data + m_size, T(0));
+      const size_t index_bytes = m_num_entries * sizeof(uint32_t);
+      const size_t entry_bytes = index_bytes + m_num_entries * sizeof(T);
+      for (int rank = 0; rank < m_comm_size; ++rank) {
+        const auto* block = m_recv_buffer.data() + rank * entry_bytes;
+        for (size_t i = 0; i < m_num_entries; ++i) {
+          uint32_t index;
+          T value;
+          std::memcpy(&index, block + i * sizeof(uint32_t), sizeof(index));
+          std::memcpy(&value,
+                      block + index_bytes + i * sizeof(T),
+                      sizeof(value));
+          m_data[index] += value;
+        }
+      }
+      break;
+    }
+    case gradient_compression_type::random_k:
+      std::fill(m_data, m_data + m_size, T(0));
+      for (size_t i = 0; i < m_num_entries; ++i) {
+        m_data[m_indices[i]] = m_values[i];
+      }
+      break;
+    default:
+      LBANN_ERROR("invalid gradient compression type");
+    }
+  }
+  if (m_config.type == gradient_compression_type::fp16) {
+    update_half_scale();
+  }
+  m_data = nullptr;
+  m_size = 0;
+  m_comm = nullptr;
+  m_mpi_comm = nullptr;
+}
+
+#define PROTO(T)                                                               \
+  template void gradient_compression::select_top_k<T>(const T*,               \
+                                                      size_t,                  \
+                                                      size_t,                  \
+                                                      std::vector<uint32_t>&); \
+  template class gradient_compressor<T>
+
+#define LBANN_INSTANTIATE_DOUBLE
+#include "lbann/macros/instantiate.hpp"
+
+} // namespace lbann
@@ -96,7 +96,8 @@ optimizer::optimizer(const optimizer& other)
   : m_comm(other.m_comm),
     m_gradient_sources(other.m_gradient_sources),
     m_gradient_status(other.m_gradient_status),
-    m_step_time(other.m_step_time)
+    m_step_time(other.m_step_time),
+    m_gradient_compression(other.m_gradient_compression)
 {
   if (m_gradient_status == optimizer_gradient_status::sync_started) {
     LBANN_ERROR("attempted to copy optimizer while a "
@@ -110,6 +111,7 @@ optimizer& optimizer::operator=(const optimizer& other)
   m_gradient_sources = other.m_gradient_sources;
   m_gradient_status = other.m_gradient_status;
   m_step_time = other.m_step_time;
+  m_gradient_compression = other.m_gradient_compression;
   if (m_gradient_status == optimizer_gradient_status::sync_started) {
     LBANN_ERROR("attempted to copy optimizer while a "
                 "gradient sync is in progress");
@@ -126,6 +128,9 @@ void optimizer::serialize(Archive& ar)
 description optimizer::get_description() const
 {
   description desc(get_type() + " optimizer");
+  if (m_gradient_compression.type != gradient_compression_type::none) {
+    desc.add("Gradient compression", to_string(m_gradient_compression.type));
+  }
   return desc;
 }
 
@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+// Must include this for all the Catch2 machinery
+#include "Catch2BasicSupport.hpp"
+
+// File being tested
+#include <lbann/optimizers/gradient_compression.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace lbann::gradient_compression;
+
+TEST_CASE("Half-precision conversion", "[optimizer][compression]")
+{
+  SECTION("Representable values are exact")
+  {
+    for (float x : {0.f, 1.f, -2.5f, 0.099975586f, 65504.f, -65504.f}) {
+      CHECK(half_bits_to_float(float_to_half_bits(x)) == x);
+    }
+    // Smallest subnormal and normal halves
+    CHECK(half_bits_to_float(float_to_half_bits(std::ldexp(1.f, -24))) ==
+          std::ldexp(1.f, -24));
+    CHECK(float_to_half_bits(std::ldexp(1.f, -14)) == 0x0400);
+  }
+
+  SECTION("Rounds to nearest even")
+  {
+    // 1 + 2^-11 is halfway between 1 and 1 + 2^-10
+    CHECK(float_to_half_bits(1.f + std::ldexp(1.f, -11)) == 0x3C00);
+    CHECK(float_to_half_bits(1.f + 3 * std::ldexp(1.f, -11)) == 0x3C02);
+    CHECK(float_to_half_bits(std::ldexp(1.f, -25)) == 0x0000);
+    CHECK(float_to_half_bits(3 * std::ldexp(1.f, -25)) == 0x0002);
+  }
+
+  SECTION("Overflow and special values")
+  {
+    const float inf = std::numeric_limits<float>::infinity();
+    CHECK(float_to_half_bits(65520.f) == 0x7C00);
+    CHECK(float_to_half_bits(-1e10f) == 0xFC00);
+    CHECK(half_bits_to_float(float_to_half_bits(inf)) == inf);
+    CHECK(std::isnan(half_bits_to_float(
+      float_to_half_bits(std::numeric_limits<float>::quiet_NaN()))));
+  }
+}
+
+TEST_CASE("bfloat16 conversion", "[optimizer][compression]")
+{
+  CHECK(bfloat16_bits_to_float(float_to_bfloat16_bits(1.f)) == 1.f);
+  CHECK(bfloat16_bits_to_float(float_to_bfloat16_bits(-3.f)) == -3.f);
+  CHECK(bfloat16_bits_to_float(float_to_bfloat16_bits(1e30f)) ==
+        Approx(1e30f).epsilon(1e-2));
+  // 1 + 2^-8 is halfway between 1 and 1 + 2^-7
+  CHECK(float_to_bfloat16_bits(1.f + std::ldexp(1.f, -8)) == 0x3F80);
+  CHECK(float_to_bfloat16_bits(1.f + 3 * std::ldexp(1.f, -8)) == 0x3F82);
+  CHECK(std::isnan(bfloat16_bits_to_float(
+    float_to_bfloat16_bits(std::numeric_limits<float>::quiet_NaN()))));
+}
+
+TEST_CASE("Sparse gradient selection", "[optimizer][compression]")
+{
+  SECTION("Number of entries")
+  {
+    CHECK(num_sparse_entries(0, 0.1) == 0);
+    CHECK(num_sparse_entries(1000, 0.01) == 10);
+    CHECK(num_sparse_entries(1000, 0.0001) == 1);
+    CHECK(num_sparse_entries(10, 1.0) == 10);
+  }
+
+  SECTION("Top-k finds largest magnitudes")
+  {
+    const std::vector<float> values = {0.1f, -5.f, 2.f, 0.f, 3.f, -0.5f};
+    std::vector<uint32_t> indices;
+    select_top_k(values.data(), values.size(), 3, indices);
+    REQUIRE(indices.size() == values.size());
+    std::vector<uint32_t> top(indices.begin(), indices.begin() + 3);
+    std::sort(top.begin(), top.end());
+    CHECK(top == std::vector<uint32_t>{1, 2, 4});
+  }
+
+  SECTION("Top-k always sends NaN")
+  {
+    const std::vector<double> values = {1.0,
+                                        std::numeric_limits<double>::quiet_NaN(),
+                                        -2.0};
+    std::vector<uint32_t> indices;
+    select_top_k(values.data(), values.size(), 1, indices);
+    CHECK(indices[0] == 1);
+  }
+}
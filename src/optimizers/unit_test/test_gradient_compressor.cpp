@@ -0,0 +1,212 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+// Must include this for all the Catch2 machinery
+#include "Catch2BasicSupport.hpp"
+
+#include "MPITestHelpers.hpp"
+
+// File being tested
+#include <lbann/optimizers/gradient_compression.hpp>
+
+#include <lbann/comm_impl.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+/** Synchronize a gradient and wait for the result. */
+void sync(lbann::gradient_compressor<float>& compressor,
+          lbann::lbann_comm& comm,
+          std::vector<float>& grad)
+{
+  Al::request req;
+  compressor.start(comm,
+                   grad.data(),
+                   grad.size(),
+                   comm.get_trainer_comm(),
+                   req);
+  comm.wait(req);
+  compressor.finish();
+}
+
+} // namespace
+
+TEST_CASE("Compressed gradient allreduce", "[mpi][optimizer][compression]")
+{
+  auto& comm = unit_test::utilities::current_world_comm();
+  const int rank = El::mpi::Rank(comm.get_trainer_comm());
+  const int num_procs = El::mpi::Size(comm.get_trainer_comm());
+  const float rank_sum = 0.5f * num_procs * (num_procs + 1);
+
+  // Rank r contributes (r+1) times a shared gradient
+  constexpr size_t size = 1000;
+  auto shared_grad = [](size_t i) { return std::sin(0.1f * i); };
+  auto local_grad = [&]() {
+    std::vector<float> grad(size);
+    for (size_t i = 0; i < size; ++i) {
+      grad[i] = (rank + 1) * shared_grad(i);
+    }
+    return grad;
+  };
+
+  lbann::gradient_compression_config config;
+
+  SECTION("Half precision")
+  {
+    config.type = lbann::gradient_compression_type::fp16;
+    lbann::gradient_compressor<float> compressor(config);
+
+    // The first sum is at full precision and sets the scale
+    auto grad = local_grad();
+    sync(compressor, comm, grad);
+    for (size_t i = 0; i < size; ++i) {
+      REQUIRE(grad[i] == Approx(rank_sum * shared_grad(i)));
+    }
+
+    // Later sums are at half precision
+    for (int step = 0; step < 2; ++step) {
+      grad = local_grad();
+      sync(compressor, comm, grad);
+      for (size_t i = 0; i < size; ++i) {
+        REQUIRE(grad[i] == Approx(rank_sum * shared_grad(i))
+                             .epsilon(1e-2)
+                             .margin(1e-3 * rank_sum));
+      }
+    }
+
+    // A gradient that overflows the scaled range is summed again at
+    // full precision
+    grad = local_grad();
+    for (auto& x : grad) {
+      x *= 1e6f;
+    }
+    sync(compressor, comm, grad);
+    for (size_t i = 0; i < size; ++i) {
+      REQUIRE(grad[i] == Approx(1e6f * rank_sum * shared_grad(i)));
+    }
+
+    // Non-finite gradients stay visible
+    grad = local_grad();
+    if (rank == 0) {
+      grad[3] = std::numeric_limits<float>::infinity();
+    }
+    sync(compressor, comm, grad);
+    CHECK(std::isinf(grad[3]));
+    CHECK(grad[4] == Approx(rank_sum * shared_grad(4)));
+  }
+
+  SECTION("bfloat16")
+  {
+    config.type = lbann::gradient_compression_type::bf16;
+    lbann::gradient_compressor<float> compressor(config);
+    auto grad = local_grad();
+    sync(compressor, comm, grad);
+    for (size_t i = 0; i < size; ++i) {
+      REQUIRE(grad[i] == Approx(rank_sum * shared_grad(i))
+                           .epsilon(5e-2)
+                           .margin(1e-2 * rank_sum));
+    }
+  }
+}
+
+TEST_CASE("Sparse gradient error feedback", "[mpi][optimizer][compression]")
+{
+  auto& comm = unit_test::utilities::current_world_comm();
+  const auto num_procs =
+    static_cast<float>(El::mpi::Size(comm.get_trainer_comm()));
+
+  lbann::gradient_compression_config config;
+  config.ratio = 0.25;
+
+  SECTION("Top-k sends the residual in later steps")
+  {
+    config.type = lbann::gradient_compression_type::top_k;
+    lbann::gradient_compressor<float> compressor(config);
+
+    // One of four entries is sent per step
+    std::vector<float> grad = {1.f, -5.f, 2.f, 0.5f};
+    sync(compressor, comm, grad);
+    CHECK(grad == std::vector<float>{0.f, -5.f * num_procs, 0.f, 0.f});
+    CHECK(compressor.get_residual() == std::vector<float>{1.f, 0.f, 2.f, 0.5f});
+
+    grad.assign(4, 0.f);
+    sync(compressor, comm, grad);
+    CHECK(grad == std::vector<float>{0.f, 0.f, 2.f * num_procs, 0.f});
+    CHECK(compressor.get_residual() ==
+          std::vector<float>{1.f, 0.f, 0.f, 0.5f});
+
+    grad.assign(4, 0.f);
+    sync(compressor, comm, grad);
+    CHECK(grad == std::vector<float>{num_procs, 0.f, 0.f, 0.f});
+  }
+
+  SECTION("Top-k without error feedback")
+  {
+    config.type = lbann::gradient_compression_type::top_k;
+    config.error_feedback = false;
+    lbann::gradient_compressor<float> compressor(config);
+
+    std::vector<float> grad = {1.f, -5.f, 2.f, 0.5f};
+    sync(compressor, comm, grad);
+    CHECK(grad == std::vector<float>{0.f, -5.f * num_procs, 0.f, 0.f});
+    CHECK(compressor.get_residual().empty());
+
+    grad.assign(4, 0.f);
+    sync(compressor, comm, grad);
+    CHECK(grad == std::vector<float>(4, 0.f));
+  }
+
+  SECTION("Random-k eventually sends every entry")
+  {
+    config.type = lbann::gradient_compression_type::random_k;
+    config.ratio = 0.5;
+    config.seed = 1234;
+    lbann::gradient_compressor<float> compressor(config);
+
+    // With error feedback, the sum of the synchronized gradients
+    // converges to the sum of the inputs
+    const std::vector<float> input = {1.f, -5.f, 2.f, 0.5f, 3.f, -1.f};
+    std::vector<float> total(input.size(), 0.f);
+    std::vector<float> grad = input;
+    for (int step = 0; step < 32; ++step) {
+      sync(compressor, comm, grad);
+      size_t num_sent = 0;
+      for (size_t i = 0; i < grad.size(); ++i) {
+        total[i] += grad[i];
+        num_sent += (grad[i] != 0.f ? 1 : 0);
+      }
+      CHECK(num_sent <= 3);
+      grad.assign(input.size(), 0.f);
+    }
+    for (size_t i = 0; i < input.size(); ++i) {
+      CHECK(total[i] == input[i] * num_procs);
+    }
+    CHECK(compressor.get_residual() == std::vector<float>(input.size(), 0.f));
+  }
+}
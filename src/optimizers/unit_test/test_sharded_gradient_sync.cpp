@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+// Must include this for all the Catch2 machinery
+#include "Catch2BasicSupport.hpp"
+
+#include "MPITestHelpers.hpp"
+
+// File being tested
+#include <lbann/optimizers/optimizer_impl.hpp>
+
+#include <cmath>
+
+namespace {
+
+using StarStarMatType =
+  El::DistMatrix<float, El::STAR, El::STAR, El::ELEMENT, El::Device::CPU>;
+using StarVCMatType =
+  El::DistMatrix<float, El::STAR, El::VC, El::ELEMENT, El::Device::CPU>;
+using VCStarMatType =
+  El::DistMatrix<float, El::VC, El::STAR, El::ELEMENT, El::Device::CPU>;
+
+float shared_grad(El::Int i, El::Int j) { return std::sin(0.1f * i + j); }
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Synchronizing sharded gradients",
+                   "[mpi][optimizer][sharded]",
+                   StarVCMatType,
+                   VCStarMatType)
+{
+  auto& comm = unit_test::utilities::current_world_comm();
+  auto const& g = comm.get_trainer_grid();
+  El::Int const rank = g.VCRank();
+  El::Int const num_procs = g.VCSize();
+  float const rank_sum = 0.5f * num_procs * (num_procs + 1);
+
+  // Shards have different sizes unless there is only one rank. Column
+  // vectors sharded by row use the reduce-scatter, other VC_STAR
+  // matrices reduce the full contributions.
+  El::Int height = 3, width = 2 * num_procs + 1;
+  SECTION("Matrix") {}
+  SECTION("Column vector")
+  {
+    height = 3 * num_procs + 2;
+    width = 1;
+  }
+
+  StarStarMatType contrib_dist(g);
+  TestType grad_dist(g);
+  lbann::GradientHelperImpl<float> helper(height,
+                                          width,
+                                          contrib_dist.DistData(),
+                                          grad_dist.DistData(),
+                                          true);
+
+  // Rank r contributes (r+1) times a shared gradient
+  auto& contrib = helper.local_gradient();
+  auto& local_contrib = contrib.Matrix();
+  for (El::Int j = 0; j < width; ++j) {
+    for (El::Int i = 0; i < height; ++i) {
+      local_contrib(i, j) = (rank + 1) * shared_grad(i, j);
+    }
+  }
+
+  // Blocking reference: allreduce the contributions and copy out the
+  // shard
+  StarStarMatType reduced(g);
+  El::Copy(contrib, reduced);
+  El::AllReduce(reduced, reduced.RedundantComm());
+  TestType expected(g);
+  El::Copy(reduced, expected);
+
+  helper.set_status(lbann::optimizer_gradient_status::sync_needed);
+  helper.start_sync(comm);
+  helper.complete_sync(comm);
+  REQUIRE(helper.get_status() == lbann::optimizer_gradient_status::ready);
+
+  auto const& grad = helper.global_gradient();
+  REQUIRE(grad.Height() == height);
+  REQUIRE(grad.Width() == width);
+  REQUIRE(grad.LocalHeight() == expected.LocalHeight());
+  REQUIRE(grad.LocalWidth() == expected.LocalWidth());
+  for (El::Int j = 0; j < grad.LocalWidth(); ++j) {
+    for (El::Int i = 0; i < grad.LocalHeight(); ++i) {
+      auto const global_i = grad.GlobalRow(i);
+      auto const global_j = grad.GlobalCol(j);
+      CHECK(grad.LockedMatrix().Get(i, j) ==
+            Approx(expected.LockedMatrix().Get(i, j)));
+      CHECK(grad.LockedMatrix().Get(i, j) ==
+            Approx(rank_sum * shared_grad(global_i, global_j)));
+    }
+  }
+
+  // start_sync remembers the last helper it started. Starting a ready
+  // helper forgets it, so it does not outlive this test.
+  helper.start_sync(comm);
+}
@@ -128,6 +128,8 @@ private:
 
     // Math layers
     LBANN_REGISTER_BUILDER(MatMul, matmul);
+    LBANN_REGISTER_BUILDER(ScaledDotProductAttention,
+                           scaled_dot_product_attention);
 
     // Transform layers
     LBANN_REGISTER_BUILDER(BatchwiseReduceSum, batchwise_reduce_sum);
@@ -179,6 +181,7 @@ private:
     LBANN_REGISTER_BUILDER(L2Norm2, l2_norm2);
     LBANN_REGISTER_BUILDER(MeanAbsoluteError, mean_absolute_error);
     LBANN_REGISTER_BUILDER(MeanSquaredError, mean_squared_error);
+    LBANN_REGISTER_BUILDER(SoftmaxCrossEntropy, softmax_cross_entropy);
     LBANN_REGISTER_BUILDER(TopKCategoricalAccuracy, top_k_categorical_accuracy);
 
     // Regularizer layers
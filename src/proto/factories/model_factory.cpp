@@ -297,6 +297,7 @@ std::unique_ptr<model> construct_model(lbann_comm* comm,
   m->set_subgrid_topology(proto_model.enable_subgraph_topology());
   m->set_subgraph_num_parent_resources(
     proto_model.subgraph_parent_grid_resources());
+  m->set_forward_only(proto_model.forward_only());
 
   const auto& proto_amp = proto_model.amp();
   if (proto_amp.enabled()) {
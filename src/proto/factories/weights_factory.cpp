@@ -195,6 +195,35 @@ lbann::proto::construct_weights(lbann_comm* comm,
     w->set_sharding_distribution(dist);
   }
 
+  // Set gradient compression
+  if (opt != nullptr && proto_weights.has_gradient_compression()) {
+    const auto& proto_compression = proto_weights.gradient_compression();
+    gradient_compression_config compression;
+    switch (proto_compression.type()) {
+    case lbann_data::GradientCompression::FP16:
+      compression.type = gradient_compression_type::fp16;
+      break;
+    case lbann_data::GradientCompression::BF16:
+      compression.type = gradient_compression_type::bf16;
+      break;
+    case lbann_data::GradientCompression::TOP_K:
+      compression.type = gradient_compression_type::top_k;
+      break;
+    case lbann_data::GradientCompression::RANDOM_K:
+      compression.type = gradient_compression_type::random_k;
+      break;
+    default:
+      compression.type = gradient_compression_type::none;
+      break;
+    }
+    if (proto_compression.ratio() != 0.0) {
+      compression.ratio = proto_compression.ratio();
+    }
+    compression.error_feedback = !proto_compression.disable_error_feedback();
+    compression.seed = proto_compression.seed();
+    opt->set_gradient_compression(compression);
+  }
+
   // Set weights initializer and optimizer
   w->set_initializer(std::move(init));
   w->set_optimizer(std::move(opt));
@@ -179,6 +179,8 @@ void init_data_readers(
       reader_csv->set_skip_cols(readme.skip_cols());
       reader_csv->set_skip_rows(readme.skip_rows());
       reader_csv->set_has_header(readme.has_header());
+      reader_csv->set_persistent_index(readme.csv_persistent_index());
+      reader_csv->set_binary_cache(readme.csv_binary_cache());
       reader = reader_csv;
     }
     else if (name == "numpy_npz_conduit_reader") {
@@ -336,6 +338,8 @@ void init_data_readers(
           reader_csv->set_skip_cols(readme.skip_cols());
           reader_csv->set_skip_rows(readme.skip_rows());
           reader_csv->set_has_header(readme.has_header());
+          reader_csv->set_persistent_index(readme.csv_persistent_index());
+          reader_csv->set_binary_cache(readme.csv_binary_cache());
           reader_csv->set_absolute_sample_count(readme.absolute_sample_count());
           reader_csv->set_use_fraction(readme.fraction_of_data_to_use());
           reader_csv->set_first_n(readme.first_n());
@@ -452,7 +456,8 @@ void init_data_readers(
       reader = new python_dataset_reader(params.dataset_path(),
                                          params.module_dir(),
                                          params.prefetch_factor(),
-                                         shuffle);
+                                         shuffle,
+                                         params.shared_memory_ring());
 #else
       LBANN_ERROR("attempted to construct Python data reader, "
                   "but LBANN is not built with Python/C API");
@@ -505,6 +510,8 @@ void init_data_readers(
     reader->set_use_fraction(readme.fraction_of_data_to_use());
     reader->set_first_n(readme.first_n());
 
+    reader->set_length_bucketing_pool_size(readme.length_bucketing_pool_size());
+
     reader->set_gan_labelling(readme.gan_labelling());
     reader->set_gan_label_value(readme.gan_label_value());
 
@@ -664,10 +671,12 @@ void init_data_readers(
           else if (name == "python_dataset") {
 #ifdef LBANN_HAS_EMBEDDED_PYTHON
             const auto& params = readme.python_dataset();
-            split_reader = new python_dataset_reader(params.dataset_path(),
-                                                     params.module_dir(),
-                                                     params.prefetch_factor(),
-                                                     shuffle);
+            split_reader =
+              new python_dataset_reader(params.dataset_path(),
+                                        params.module_dir(),
+                                        params.prefetch_factor(),
+                                        shuffle,
+                                        params.shared_memory_ring());
             (*(python_dataset_reader*)split_reader) = (*(python_dataset_reader*)reader);
 #else
             LBANN_ERROR("attempted to construct Python data reader, "
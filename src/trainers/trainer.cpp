@@ -285,6 +285,13 @@ void trainer::train(observer_ptr<model> model,
 void trainer::evaluate(observer_ptr<model> model,
                        execution_mode mode,
                        El::Int num_batches)
+{
+  evaluate(std::vector<observer_ptr<lbann::model>>{model}, mode, num_batches);
+}
+
+void trainer::evaluate(std::vector<observer_ptr<model>> const& models,
+                       execution_mode mode,
+                       El::Int num_batches)
 {
   auto sgd = std::make_unique<SGDTrainingAlgorithm>(
     "sgd_evaluate",
@@ -292,14 +299,16 @@ void trainer::evaluate(observer_ptr<model> model,
     /*suppress_timer=*/true);
   auto ctxt = sgd->get_new_execution_context();
   ctxt->set_execution_mode(mode);
-  model->reset_mode(*ctxt, execution_mode::invalid);
+  for (auto* m : models) {
+    m->reset_mode(*ctxt, execution_mode::invalid);
+  }
 
-  sgd->setup_models({model}, get_max_mini_batch_size(), get_grids());
+  sgd->setup_models(models, get_max_mini_batch_size(), get_grids());
 
   if (m_comm->get_grid_type() == GridType::NO_GRID or
       m_comm->get_grid_type() == GridType::PRIMARY_GRID) {
     sgd->evaluate(*ctxt,
-                  *model,
+                  models,
                   get_data_coordinator(),
                   mode,
                   EpochTerminationCriteria(/*num_epochs=*/1UL));
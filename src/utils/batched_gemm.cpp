@@ -0,0 +1,459 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/utils/batched_gemm.hpp"
+#include "lbann/utils/omp_pragma.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#ifdef HYDROGEN_HAVE_MKL
+#include <mkl.h>
+#if defined(INTEL_MKL_VERSION) && INTEL_MKL_VERSION >= 20210000
+#define LBANN_HAS_MKL_GEMM_BATCH_STRIDED
+#endif
+#endif // HYDROGEN_HAVE_MKL
+
+namespace lbann {
+
+namespace {
+
+/** Rows of op(A) in a packed panel. */
+constexpr El::Int panel_rows = 128;
+/** Columns of op(A) (and rows of op(B)) in a packed panel. */
+constexpr El::Int panel_depth = 256;
+/** Products with at least this many multiply-adds are large enough
+ *  to be computed one at a time with multithreaded BLAS. */
+constexpr El::Int large_gemm_size = 128 * 128 * 128;
+
+template <typename T>
+constexpr bool is_blas_type_v =
+  std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+/** Products with at most this many multiply-adds are faster with
+ *  BLAS than with the packed kernel, whose packing overhead is not
+ *  amortized (measured with OpenBLAS 0.3.21 on one core). */
+template <typename T>
+constexpr El::Int small_gemm_size =
+  std::is_same_v<T, float> ? 32 * 32 * 32 : 16 * 16 * 16;
+
+/** Whether sizes can be passed as BLAS integers of type @c IntT
+ *  without narrowing. */
+template <typename IntT>
+bool fits_blas_int(std::initializer_list<El::Int> sizes)
+{
+  return std::all_of(sizes.begin(), sizes.end(), [](El::Int size) {
+    return static_cast<std::intmax_t>(size) <=
+           static_cast<std::intmax_t>(std::numeric_limits<IntT>::max());
+  });
+}
+
+/** Thread-local scratch space for packed panels. */
+template <typename T>
+T* get_panel_buffer(size_t size, bool second)
+{
+  thread_local std::vector<T> a_buffer, b_buffer;
+  auto& buffer = second ? b_buffer : a_buffer;
+  if (buffer.size() < size) {
+    buffer.resize(size);
+  }
+  return buffer.data();
+}
+
+/** Accumulate the product of packed panels into C.
+ *
+ *  @c a is @c mb x @c kb and @c b is @c kb x @c n, both column-major
+ *  with unit stride. Four columns of C are updated at a time so each
+ *  column of @c a is reused from registers or L1 cache.
+ */
+template <typename T>
+void accumulate_panel(El::Int mb,
+                      El::Int n,
+                      El::Int kb,
+                      const T* __restrict__ a,
+                      const T* __restrict__ b,
+                      T* __restrict__ C,
+                      El::Int ldc)
+{
+  El::Int j = 0;
+  for (; j + 4 <= n; j += 4) {
+    T* __restrict__ c0 = C + j * ldc;
+    T* __restrict__ c1 = c0 + ldc;
+    T* __restrict__ c2 = c1 + ldc;
+    T* __restrict__ c3 = c2 + ldc;
+    const T* b0 = b + j * kb;
+    const T* b1 = b0 + kb;
+    const T* b2 = b1 + kb;
+    const T* b3 = b2 + kb;
+    for (El::Int p = 0; p < kb; ++p) {
+      const T* __restrict__ a_col = a + p * mb;
+      const T x0 = b0[p], x1 = b1[p], x2 = b2[p], x3 = b3[p];
+      for (El::Int i = 0; i < mb; ++i) {
+        const T ai = a_col[i];
+        c0[i] += ai * x0;
+        c1[i] += ai * x1;
+        c2[i] += ai * x2;
+        c3[i] += ai * x3;
+      }
+    }
+  }
+  for (; j < n; ++j) {
+    T* __restrict__ c = C + j * ldc;
+    const T* b_col = b + j * kb;
+    for (El::Int p = 0; p < kb; ++p) {
+      const T* __restrict__ a_col = a + p * mb;
+      const T x = b_col[p];
+      for (El::Int i = 0; i < mb; ++i) {
+        c[i] += a_col[i] * x;
+      }
+    }
+  }
+}
+
+#ifdef LBANN_HAS_MKL_GEMM_BATCH_STRIDED
+CBLAS_TRANSPOSE to_cblas(El::Orientation orient)
+{
+  return orient == El::NORMAL ? CblasNoTrans : CblasTrans;
+}
+
+void mkl_gemm_strided_batched(El::Orientation transA,
+                              El::Orientation transB,
+                              El::Int m,
+                              El::Int n,
+                              El::Int k,
+                              float alpha,
+                              const float* A,
+                              El::Int lda,
+                              El::Int strideA,
+                              const float* B,
+                              El::Int ldb,
+                              El::Int strideB,
+                              float beta,
+                              float* C,
+                              El::Int ldc,
+                              El::Int strideC,
+                              El::Int batch_count)
+{
+  cblas_sgemm_batch_strided(CblasColMajor,
+                            to_cblas(transA),
+                            to_cblas(transB),
+                            m,
+                            n,
+                            k,
+                            alpha,
+                            A,
+                            lda,
+                            strideA,
+                            B,
+                            ldb,
+                            strideB,
+                            beta,
+                            C,
+                            ldc,
+                            strideC,
+                            batch_count);
+}
+
+void mkl_gemm_strided_batched(El::Orientation transA,
+                              El::Orientation transB,
+                              El::Int m,
+                              El::Int n,
+                              El::Int k,
+                              double alpha,
+                              const double* A,
+                              El::Int lda,
+                              El::Int strideA,
+                              const double* B,
+                              El::Int ldb,
+                              El::Int strideB,
+                              double beta,
+                              double* C,
+                              El::Int ldc,
+                              El::Int strideC,
+                              El::Int batch_count)
+{
+  cblas_dgemm_batch_strided(CblasColMajor,
+                            to_cblas(transA),
+                            to_cblas(transB),
+                            m,
+                            n,
+                            k,
+                            alpha,
+                            A,
+                            lda,
+                            strideA,
+                            B,
+                            ldb,
+                            strideB,
+                            beta,
+                            C,
+                            ldc,
+                            strideC,
+                            batch_count);
+}
+#endif // LBANN_HAS_MKL_GEMM_BATCH_STRIDED
+
+} // namespace
+
+template <typename TensorDataType>
+void packed_gemm(El::Orientation transA,
+                 El::Orientation transB,
+                 El::Int m,
+                 El::Int n,
+                 El::Int k,
+                 TensorDataType alpha,
+                 const TensorDataType* A,
+                 El::Int lda,
+                 const TensorDataType* B,
+                 El::Int ldb,
+                 TensorDataType beta,
+                 TensorDataType* C,
+                 El::Int ldc)
+{
+  using T = TensorDataType;
+  if (m < 1 || n < 1) {
+    return;
+  }
+
+  // Small products are left to BLAS
+  if constexpr (is_blas_type_v<T>) {
+    if (m * n * k <= small_gemm_size<T> &&
+        fits_blas_int<El::BlasInt>({m, n, k, lda, ldb, ldc})) {
+      El::blas::Gemm(transA == El::NORMAL ? 'N' : 'T',
+                     transB == El::NORMAL ? 'N' : 'T',
+                     m,
+                     n,
+                     k,
+                     alpha,
+                     A,
+                     lda,
+                     B,
+                     ldb,
+                     beta,
+                     C,
+                     ldc);
+      return;
+    }
+  }
+
+  // Scale C by beta
+  const T zero = El::TypeTraits<T>::Zero();
+  const T one = El::TypeTraits<T>::One();
+  if (beta != one) {
+    for (El::Int j = 0; j < n; ++j) {
+      T* c = C + j * ldc;
+      for (El::Int i = 0; i < m; ++i) {
+        c[i] = (beta == zero ? zero : beta * c[i]);
+      }
+    }
+  }
+  if (k < 1 || alpha == zero) {
+    return;
+  }
+
+  const bool trans_a = (transA != El::NORMAL);
+  const bool trans_b = (transB != El::NORMAL);
+  const El::Int max_kb = std::min(k, panel_depth);
+  const El::Int max_mb = std::min(m, panel_rows);
+  T* b_panel = get_panel_buffer<T>(max_kb * n, true);
+  T* a_panel = get_panel_buffer<T>(max_mb * max_kb, false);
+
+  for (El::Int pc = 0; pc < k; pc += panel_depth) {
+    const El::Int kb = std::min(panel_depth, k - pc);
+
+    // Pack op(B)(pc:pc+kb, :) so each column is contiguous
+    for (El::Int j = 0; j < n; ++j) {
+      T* b_col = b_panel + j * kb;
+      if (trans_b) {
+        for (El::Int p = 0; p < kb; ++p) {
+          b_col[p] = B[j + (pc + p) * ldb];
+        }
+      }
+      else {
+        std::copy_n(B + pc + j * ldb, kb, b_col);
+      }
+    }
+
+    for (El::Int ic = 0; ic < m; ic += panel_rows) {
+      const El::Int mb = std::min(panel_rows, m - ic);
+
+      // Pack alpha * op(A)(ic:ic+mb, pc:pc+kb)
+      for (El::Int p = 0; p < kb; ++p) {
+        T* a_col = a_panel + p * mb;
+        if (trans_a) {
+          const T* a_row = A + (pc + p) + ic * lda;
+          for (El::Int i = 0; i < mb; ++i) {
+            a_col[i] = alpha * a_row[i * lda];
+          }
+        }
+        else {
+          const T* a_src = A + ic + (pc + p) * lda;
+          for (El::Int i = 0; i < mb; ++i) {
+            a_col[i] = alpha * a_src[i];
+          }
+        }
+      }
+
+      accumulate_panel(mb, n, kb, a_panel, b_panel, C + ic, ldc);
+    }
+  }
+}
+
+template <typename TensorDataType>
+void gemm_strided_batched(El::Orientation transA,
+                          El::Orientation transB,
+                          El::Int m,
+                          El::Int n,
+                          El::Int k,
+                          TensorDataType alpha,
+                          const TensorDataType* A,
+                          El::Int lda,
+                          El::Int strideA,
+                          const TensorDataType* B,
+                          El::Int ldb,
+                          El::Int strideB,
+                          TensorDataType beta,
+                          TensorDataType* C,
+                          El::Int ldc,
+                          El::Int strideC,
+                          El::Int batch_count)
+{
+  if (m < 1 || n < 1 || batch_count < 1) {
+    return;
+  }
+
+#ifdef LBANN_HAS_MKL_GEMM_BATCH_STRIDED
+  if constexpr (is_blas_type_v<TensorDataType>) {
+    if (fits_blas_int<MKL_INT>(
+          {m, n, k, lda, ldb, ldc, strideA, strideB, strideC, batch_count})) {
+      mkl_gemm_strided_batched(transA,
+                               transB,
+                               m,
+                               n,
+                               k,
+                               alpha,
+                               A,
+                               lda,
+                               strideA,
+                               B,
+                               ldb,
+                               strideB,
+                               beta,
+                               C,
+                               ldc,
+                               strideC,
+                               batch_count);
+      return;
+    }
+  }
+#endif // LBANN_HAS_MKL_GEMM_BATCH_STRIDED
+
+  // Large products with too few batch entries to occupy every
+  // thread are left to the multithreaded BLAS library
+  if constexpr (is_blas_type_v<TensorDataType>) {
+    if (batch_count < omp_get_max_threads() && m * n * k >= large_gemm_size &&
+        fits_blas_int<El::BlasInt>({m, n, k, lda, ldb, ldc})) {
+      const char transa = (transA == El::NORMAL ? 'N' : 'T');
+      const char transb = (transB == El::NORMAL ? 'N' : 'T');
+      for (El::Int i = 0; i < batch_count; ++i) {
+        El::blas::Gemm(transa,
+                       transb,
+                       m,
+                       n,
+                       k,
+                       alpha,
+                       A + i * strideA,
+                       lda,
+                       B + i * strideB,
+                       ldb,
+                       beta,
+                       C + i * strideC,
+                       ldc);
+      }
+      return;
+    }
+  }
+
+  // Distribute products over threads and compute each one with the
+  // single-threaded kernel
+  LBANN_OMP_PARALLEL_FOR
+  for (El::Int i = 0; i < batch_count; ++i) {
+    packed_gemm(transA,
+                transB,
+                m,
+                n,
+                k,
+                alpha,
+                A + i * strideA,
+                lda,
+                B + i * strideB,
+                ldb,
+                beta,
+                C + i * strideC,
+                ldc);
+  }
+}
+
+#define PROTO(T)                                                               \
+  template void gemm_strided_batched<T>(El::Orientation,                       \
+                                        El::Orientation,                       \
+                                        El::Int,                               \
+                                        El::Int,                               \
+                                        El::Int,                               \
+                                        T,                                     \
+                                        const T*,                              \
+                                        El::Int,                               \
+                                        El::Int,                               \
+                                        const T*,                              \
+                                        El::Int,                               \
+                                        El::Int,                               \
+                                        T,                                     \
+                                        T*,                                    \
+                                        El::Int,                               \
+                                        El::Int,                               \
+                                        El::Int);                              \
+  template void packed_gemm<T>(El::Orientation,                                \
+                               El::Orientation,                                \
+                               El::Int,                                        \
+                               El::Int,                                        \
+                               El::Int,                                        \
+                               T,                                              \
+                               const T*,                                       \
+                               El::Int,                                        \
+                               const T*,                                       \
+                               El::Int,                                        \
+                               T,                                              \
+                               T*,                                             \
+                               El::Int)
+
+#define LBANN_INSTANTIATE_CPU_HALF
+#include "lbann/macros/instantiate.hpp"
+
+} // namespace lbann
@@ -31,11 +31,15 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <errno.h>
+#include <fcntl.h>
 #include <fstream>
 #include <libgen.h>
 #include <sstream>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 namespace lbann {
 
@@ -289,6 +293,51 @@ void remove_multiple_slashes(std::string& str)
   str = s.str();
 }
 
+mapped_file::mapped_file(const std::string& path) : m_path(path)
+{
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd == -1) {
+    LBANN_ERROR("failed to open ", path, " (", strerror(errno), ")");
+  }
+  struct ::stat buffer;
+  if (::fstat(fd, &buffer) != 0) {
+    ::close(fd);
+    LBANN_ERROR("failed to stat ", path, " (", strerror(errno), ")");
+  }
+  m_size = buffer.st_size;
+  if (m_size > 0) {
+    void* m = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (m == MAP_FAILED) {
+      ::close(fd);
+      LBANN_ERROR("failed to mmap ", path, " (", strerror(errno), ")");
+    }
+    m_data = static_cast<const char*>(m);
+  }
+  // The mapping stays valid after the descriptor is closed
+  ::close(fd);
+}
+
+mapped_file::~mapped_file()
+{
+  if (m_data != nullptr) {
+    ::munmap(const_cast<char*>(m_data), m_size);
+  }
+}
+
+file_stamp get_file_stamp(const std::string& path)
+{
+  struct ::stat buffer;
+  if (::stat(path.c_str(), &buffer) != 0) {
+    LBANN_ERROR("failed to stat ", path, " (", strerror(errno), ")");
+  }
+  file_stamp stamp;
+  stamp.size = buffer.st_size;
+  stamp.mtime_ns =
+    static_cast<uint64_t>(buffer.st_mtim.tv_sec) * 1000000000ull +
+    buffer.st_mtim.tv_nsec;
+  return stamp;
+}
+
 } // namespace file
 
 } // namespace lbann
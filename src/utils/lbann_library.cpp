@@ -28,6 +28,7 @@
 #include "lbann/comm.hpp"
 #include "lbann/comm_impl.hpp"
 #include "lbann/data_ingestion/data_reader.hpp"
+#include "lbann/models/inference_optimizer.hpp"
 #include "lbann/models/model.hpp"
 #include "lbann/utils/exception.hpp"
 
@@ -43,6 +44,7 @@
 #include "lbann/utils/argument_parser.hpp"
 #include "lbann/utils/omp_diagnostics.hpp"
 #include "lbann/utils/threads/thread_utils.hpp"
+#include "lbann/utils/tracing.hpp"
 
 #include "lbann/proto/lbann.pb.h"
 #include "lbann/proto/model.pb.h"
@@ -56,7 +58,8 @@ std::unique_ptr<model> load_inference_model(lbann_comm* lc,
                                             std::string cp_dir,
                                             int mbs,
                                             std::vector<El::Int> input_dims,
-                                            std::vector<El::Int> output_dims)
+                                            std::vector<El::Int> output_dims,
+                                            bool optimize_graph)
 {
   persist p;
   p.open_restart(cp_dir.c_str());
@@ -64,8 +67,22 @@ std::unique_ptr<model> load_inference_model(lbann_comm* lc,
   m->load_from_checkpoint_shared(p);
   p.close_restart();
 
+  m->set_forward_only(true);
   m->setup(mbs, get_trainer().get_grids());
 
+  if (optimize_graph) {
+    auto const summary =
+      optimize_for_inference(*m, get_trainer().get_grids());
+    if (lc->am_world_master() && summary.num_rewrites() > 0) {
+      std::cout << "Inference graph optimization: folded "
+                << summary.num_folded_normalizations
+                << " normalization layer(s), removed "
+                << summary.num_removed_layers << " no-op layer(s), fused "
+                << summary.num_fused_operator_layers << " operator layer(s)"
+                << std::endl;
+    }
+  }
+
   return m;
 }
 
@@ -138,7 +155,19 @@ bool trainer_exists()
   }
 }
 
-void finalize_trainer() { global_trainer_.reset(); }
+void finalize_trainer()
+{
+#ifdef LBANN_HAS_TRACING
+  // Export the trace while the communicator is still alive
+  auto const& trace_file =
+    global_argument_parser().get<std::string>(LBANN_OPTION_TRACE_FILE);
+  if (global_trainer_ != nullptr && !trace_file.empty()) {
+    tracing::stop();
+    tracing::write_chrome_trace(*global_trainer_->get_comm(), trace_file);
+  }
+#endif // LBANN_HAS_TRACING
+  global_trainer_.reset();
+}
 
 /// Construct a trainer that contains a lbann comm object and threadpool
 trainer& construct_trainer(lbann_comm* comm,
@@ -162,6 +191,18 @@ trainer& construct_trainer(lbann_comm* comm,
     }
   }
 
+#ifdef LBANN_HAS_TRACING
+  if (!arg_parser.get<std::string>(LBANN_OPTION_TRACE_FILE).empty()) {
+    tracing::start(*comm);
+  }
+#endif // LBANN_HAS_TRACING
+
+  // Launch the communication progress thread before the I/O threads
+  // so that it takes the first free core
+  if (arg_parser.get<bool>(LBANN_OPTION_COMM_PROGRESS_THREAD)) {
+    comm->start_progress_thread(free_core_offset(comm));
+  }
+
   // Initalize a per-trainer I/O thread pool
   std::unique_ptr<thread_pool> io_thread_pool =
     construct_io_thread_pool(comm, serialized_io);
@@ -40,6 +40,12 @@ void construct_std_options()
     {"--disable_background_io_activity"},
     utils::ENV("LBANN_DISABLE_BACKGROUND_IO_ACTIVITY"),
     "[STD] prevent the data coordinator from fetching data in the background");
+  arg_parser.add_flag(
+    LBANN_OPTION_COMM_PROGRESS_THREAD,
+    {"--comm_progress_thread"},
+    utils::ENV("LBANN_COMM_PROGRESS_THREAD"),
+    "[STD] Progress non-blocking MPI collectives (e.g. gradient allreduces "
+    "without Aluminum) on a dedicated thread. Requires MPI_THREAD_MULTIPLE");
   arg_parser.add_flag(
     LBANN_OPTION_DISABLE_CUDA,
     {"--disable_cuda"},
@@ -133,6 +139,11 @@ void construct_std_options()
                       {"--no_inplace"},
                       utils::ENV("LBANN_NO_INPLACE"),
                       "[STD] Disable in-place layer memory optimization");
+  arg_parser.add_flag(LBANN_OPTION_NO_BUFFER_ALIASING,
+                      {"--no_buffer_aliasing"},
+                      utils::ENV("LBANN_NO_BUFFER_ALIASING"),
+                      "[STD] Disable sharing of concatenate and slice "
+                      "layer buffers with neighboring layers");
   arg_parser.add_flag(LBANN_OPTION_NO_BACKPROP_DISABLE,
                       {"--no_backprop_disable"},
                       utils::ENV("LBANN_NO_BACKPROP_DISABLE"),
@@ -237,6 +248,30 @@ void construct_std_options()
     "If the directory doesn't exist or doesn't contain a checkpoint,\n"
     "an error will be thrown.\n",
     "");
+  arg_parser.add_option(
+    LBANN_OPTION_SHARDED_WEIGHTS_PREFETCH_BUDGET,
+    {"--sharded_weights_prefetch_budget"},
+    utils::ENV("LBANN_SHARDED_WEIGHTS_PREFETCH_BUDGET"),
+    "[STD] Maximum size in MiB of the full sharded weights that may be "
+    "gathered ahead of the layers that use them. 0 means no limit",
+    size_t{0});
+  arg_parser.add_option(
+    LBANN_OPTION_SHARDED_WEIGHTS_PREFETCH_DEPTH,
+    {"--sharded_weights_prefetch_depth"},
+    utils::ENV("LBANN_SHARDED_WEIGHTS_PREFETCH_DEPTH"),
+    "[STD] Number of layers ahead of the current layer whose sharded "
+    "weights are gathered with non-blocking communication during forward "
+    "and backward propagation. 0 disables prefetching",
+    0);
+  arg_parser.add_option(
+    LBANN_OPTION_TRACE_FILE,
+    {"--trace_file"},
+    utils::ENV("LBANN_TRACE_FILE"),
+    "[STD] Record a trace of layer, optimizer, I/O, data store and "
+    "communication events and write it to the given file in the Chrome "
+    "trace format (viewable in Perfetto). Has no effect unless LBANN was "
+    "compiled with LBANN_HAS_TRACING",
+    "");
   arg_parser.add_option(
     LBANN_OPTION_TRAINER_CREATE_TWO_MODELS,
     {"--trainer_create_two_models"},
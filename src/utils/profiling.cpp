@@ -33,6 +33,10 @@
 // For get_current_comm, which is here for some reason.
 #include "lbann/utils/options.hpp"
 #include "lbann/utils/serialize.hpp"
+#include "lbann/utils/tracing.hpp"
+
+#include <cstring>
+#include <vector>
 
 #if defined(LBANN_SCOREP)
 #include <scorep/SCOREP_User.h>
@@ -267,12 +271,12 @@ void prof_start()
   return;
 }
 void prof_stop() { return; }
-void prof_region_begin(const char* s, int, bool)
+static void backend_region_begin(const char* s, int, bool)
 {
   SCOREP_USER_REGION_BY_NAME_BEGIN(s, SCOREP_USER_REGION_TYPE_COMMON);
   return;
 }
-void prof_region_end(const char* s, bool)
+static void backend_region_end(const char* s, bool)
 {
   SCOREP_USER_REGION_BY_NAME_END(s);
   return;
@@ -288,7 +292,7 @@ void prof_stop()
   CHECK_CUDA(cudaProfilerStop());
   profiling_started = false;
 }
-void prof_region_begin(const char* s, int c, bool sync)
+static void backend_region_begin(const char* s, int c, bool sync)
 {
   if (!profiling_started)
     return;
@@ -307,7 +311,7 @@ void prof_region_begin(const char* s, int c, bool sync)
   ev.message.ascii = s;
   nvtxRangePushEx(&ev);
 }
-void prof_region_end(const char*, bool sync)
+static void backend_region_end(const char*, bool sync)
 {
   if (!profiling_started)
     return;
@@ -327,7 +331,7 @@ void prof_stop()
   roctracer_stop();
   profiling_started = false;
 }
-void prof_region_begin(const char* s, int, bool sync)
+static void backend_region_begin(const char* s, int, bool sync)
 {
   if (!profiling_started)
     return;
@@ -336,7 +340,7 @@ void prof_region_begin(const char* s, int, bool sync)
   }
   LBANN_ASSERT(0 <= roctxRangePush(s));
 }
-void prof_region_end(const char*, bool sync)
+static void backend_region_end(const char*, bool sync)
 {
   if (!profiling_started)
     return;
@@ -356,10 +360,50 @@ void prof_stop()
   profiling_started = false;
   return;
 }
-void prof_region_begin(const char*, int, bool) { return; }
-void prof_region_end(const char*, bool) { return; }
+static void backend_region_begin(const char*, int, bool) { return; }
+static void backend_region_end(const char*, bool) { return; }
 #endif
 
+#ifdef LBANN_HAS_TRACING
+namespace {
+/** @brief Traced regions that are open on this thread. */
+struct open_region
+{
+  const char* name;
+  uint64_t start;
+};
+thread_local std::vector<open_region> open_regions;
+} // namespace
+#endif // LBANN_HAS_TRACING
+
+void prof_region_begin(const char* s, int c, bool sync)
+{
+  backend_region_begin(s, c, sync);
+#ifdef LBANN_HAS_TRACING
+  if (tracing::is_enabled()) {
+    open_regions.push_back({s, tracing::now()});
+  }
+#endif // LBANN_HAS_TRACING
+}
+
+void prof_region_end(const char* s, bool sync)
+{
+#ifdef LBANN_HAS_TRACING
+  // Regions opened before tracing started are not on the stack
+  if (!open_regions.empty() &&
+      (open_regions.back().name == s ||
+       std::strcmp(open_regions.back().name, s) == 0)) {
+    auto const start = open_regions.back().start;
+    open_regions.pop_back();
+    tracing::record_complete(tracing::intern_cached(s),
+                             tracing::category::region,
+                             start,
+                             tracing::now());
+  }
+#endif // LBANN_HAS_TRACING
+  backend_region_end(s, sync);
+}
+
 static int next_color() noexcept
 {
   static int idx = -1;
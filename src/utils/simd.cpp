@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/utils/simd.hpp"
+
+#include "lbann/utils/environment_variable.hpp"
+#include "lbann/utils/exception.hpp"
+
+#include <atomic>
+
+namespace lbann {
+namespace simd {
+namespace {
+
+isa detect_hardware_isa()
+{
+#ifdef LBANN_SIMD_HAS_X86_VARIANTS
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+      __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("fma")) {
+    return isa::avx512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return isa::avx2;
+  }
+#endif // LBANN_SIMD_HAS_X86_VARIANTS
+  return isa::baseline;
+}
+
+isa initial_isa()
+{
+  const isa detected = detected_isa();
+  utils::EnvVariable<> env("LBANN_SIMD_ISA");
+  if (!env.exists()) {
+    return detected;
+  }
+  const isa requested = isa_from_string(env.raw_value());
+  if (!is_supported(requested)) {
+    LBANN_WARNING("LBANN_SIMD_ISA=",
+                  env.raw_value(),
+                  " is not supported by this CPU, using ",
+                  to_string(detected));
+    return detected;
+  }
+  return requested;
+}
+
+std::atomic<isa>& active_isa()
+{
+  static std::atomic<isa> instruction_set{initial_isa()};
+  return instruction_set;
+}
+
+} // namespace
+
+isa detected_isa()
+{
+  static const isa instruction_set = detect_hardware_isa();
+  return instruction_set;
+}
+
+isa get_isa() noexcept
+{
+  return active_isa().load(std::memory_order_relaxed);
+}
+
+void set_isa(isa instruction_set)
+{
+  if (!is_supported(instruction_set)) {
+    LBANN_ERROR("instruction set ",
+                to_string(instruction_set),
+                " is not supported by this CPU");
+  }
+  active_isa().store(instruction_set, std::memory_order_relaxed);
+}
+
+bool is_supported(isa instruction_set)
+{
+  return static_cast<int>(instruction_set) <=
+         static_cast<int>(detected_isa());
+}
+
+std::string to_string(isa instruction_set)
+{
+  switch (instruction_set) {
+  case isa::reference:
+    return "reference";
+  case isa::baseline:
+    return "baseline";
+  case isa::avx2:
+    return "avx2";
+  case isa::avx512:
+    return "avx512";
+  default:
+    LBANN_ERROR("invalid instruction set");
+  }
+  return "";
+}
+
+isa isa_from_string(std::string const& str)
+{
+  for (auto instruction_set :
+       {isa::reference, isa::baseline, isa::avx2, isa::avx512}) {
+    if (str == to_string(instruction_set)) {
+      return instruction_set;
+    }
+  }
+  LBANN_ERROR("unknown instruction set \"", str, "\"");
+  return isa::reference;
+}
+
+} // namespace simd
+} // namespace lbann
@@ -27,6 +27,7 @@
 #include "lbann/utils/argument_parser.hpp"
 #include "lbann/utils/lbann_library.hpp"
 #include "lbann/utils/threads/thread_topology.hpp"
+#include "lbann/utils/tracing.hpp"
 
 #if defined(LBANN_TOPO_AWARE)
 #include <hwloc.h>
@@ -218,6 +219,7 @@ void thread_pool::relaunch_pinned_threads(size_type num_threads)
 
 void thread_pool::do_thread_work_()
 {
+  LBANN_TRACE_THREAD_NAME("io");
   while (not all_work_done_) {
     auto task = global_work_queue_.wait_and_pop();
     if (task) {
@@ -250,6 +252,7 @@ void thread_pool::do_thread_work_pinned_thread_(int tid,
     std::thread::id this_id = std::this_thread::get_id();
     m_thread_id_to_local_id_map[this_id] = tid;
   }
+  LBANN_TRACE_THREAD_NAME("io " + std::to_string(tid));
   while (not all_work_done_) {
     auto task = global_work_queue_.wait_and_pop();
     if (task) {
@@ -118,4 +118,38 @@ hwloc_cpuset_t get_local_cpuset_for_current_thread(hwloc_topology_t topo)
 
 #endif // LBANN_TOPO_AWARE
 
+bool bind_current_thread_to_pu(int index)
+{
+#if defined(LBANN_TOPO_AWARE)
+  hwloc_topology_t topo;
+  if (hwloc_topology_init(&topo) != 0) {
+    return false;
+  }
+  if (hwloc_topology_load(topo) != 0) {
+    hwloc_topology_destroy(topo);
+    return false;
+  }
+  hwloc_cpuset_t local_cpuset = get_local_cpuset_for_current_thread(topo);
+  const int num_pus = hwloc_bitmap_weight(local_cpuset);
+  bool bound = false;
+  if (num_pus > 0) {
+    // Find the index-th processing unit in the local cpuset
+    int pu = hwloc_bitmap_first(local_cpuset);
+    for (int skip = index % num_pus; skip > 0; --skip) {
+      pu = hwloc_bitmap_next(local_cpuset, pu);
+    }
+    hwloc_cpuset_t pu_cpuset = hwloc_bitmap_alloc();
+    hwloc_bitmap_only(pu_cpuset, pu);
+    bound = (hwloc_set_cpubind(topo, pu_cpuset, HWLOC_CPUBIND_THREAD) == 0);
+    hwloc_bitmap_free(pu_cpuset);
+  }
+  hwloc_bitmap_free(local_cpuset);
+  hwloc_topology_destroy(topo);
+  return bound;
+#else
+  (void)index;
+  return false;
+#endif // LBANN_TOPO_AWARE
+}
+
 } // namespace lbann
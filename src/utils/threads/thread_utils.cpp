@@ -44,12 +44,15 @@ int num_free_cores_per_process(const lbann_comm* comm)
 #ifdef LBANN_HAS_ALUMINUM
   aluminum_threads = 1;
 #endif // LBANN_HAS_ALUMINUM
+  auto progress_threads = (comm->has_progress_thread() ? 1 : 0);
 
   auto max_cores_per_process =
     static_cast<int>(max_threads / processes_on_node);
 
   auto io_threads_per_process =
-    std::max(1, (max_cores_per_process - omp_threads - aluminum_threads));
+    std::max(1,
+             (max_cores_per_process - omp_threads - aluminum_threads -
+              progress_threads));
 
   return io_threads_per_process;
 }
@@ -65,9 +68,11 @@ int free_core_offset(const lbann_comm* comm)
 #ifdef LBANN_HAS_ALUMINUM
   aluminum_threads = 1;
 #endif // LBANN_HAS_ALUMINUM
+  auto progress_threads = (comm->has_progress_thread() ? 1 : 0);
 
   // Offset into the CPUMASK of each process
-  auto io_threads_offset = (omp_threads + aluminum_threads) % max_threads;
+  auto io_threads_offset =
+    (omp_threads + aluminum_threads + progress_threads) % max_threads;
 
   return io_threads_offset;
 }
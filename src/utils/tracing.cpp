@@ -0,0 +1,408 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/utils/tracing.hpp"
+#include "lbann/comm.hpp"
+#include "lbann/utils/exception.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+namespace lbann {
+namespace tracing {
+
+namespace details {
+std::atomic<bool> enabled{false};
+} // namespace details
+
+namespace {
+
+/** @brief Recorded event. Complete events have @c phase 'X' and
+ *  instant events have @c phase 'i'.
+ */
+struct event
+{
+  uint64_t start;
+  uint64_t duration;
+  name_id name;
+  category cat;
+  char phase;
+};
+
+/** @brief Single-writer ring buffer of events. */
+class thread_buffer
+{
+public:
+  thread_buffer(uint32_t tid, size_t capacity, uint64_t generation)
+    : m_events(new event[capacity]),
+      m_capacity{capacity},
+      m_mask{capacity - 1},
+      m_tid{tid},
+      m_generation{generation}
+  {}
+
+  void push(event const& e) noexcept
+  {
+    const auto head = m_head.load(std::memory_order_relaxed);
+    m_events[head & m_mask] = e;
+    m_head.store(head + 1, std::memory_order_release);
+  }
+
+  /** @brief Call @c f on the retained events, oldest first. */
+  template <typename F>
+  void for_each(F&& f) const
+  {
+    const auto head = m_head.load(std::memory_order_acquire);
+    const auto count = std::min<uint64_t>(head, m_capacity);
+    for (auto i = head - count; i < head; ++i) {
+      f(m_events[i & m_mask]);
+    }
+  }
+
+  uint32_t tid() const noexcept { return m_tid; }
+  uint64_t generation() const noexcept { return m_generation; }
+
+  /** @brief Thread label (guarded by the registry mutex). */
+  std::string m_name;
+
+private:
+  /** @brief Left uninitialized so that pages are only touched as
+   *  events are recorded.
+   */
+  std::unique_ptr<event[]> m_events;
+  const uint64_t m_capacity;
+  const uint64_t m_mask;
+  std::atomic<uint64_t> m_head{0};
+  const uint32_t m_tid;
+  const uint64_t m_generation;
+};
+
+/** @brief Process-wide tracing state. */
+struct registry
+{
+  std::mutex mutex;
+  /** @brief Interned names, indexed by id. */
+  std::vector<std::string> names{"<invalid>"};
+  std::unordered_map<std::string, name_id> ids;
+  /** @brief Buffers of the current recording. */
+  std::vector<std::shared_ptr<thread_buffer>> buffers;
+  size_t capacity = 1;
+  /** @brief Trace time zero (aligned across ranks). */
+  uint64_t origin = 0;
+  /** @brief Incremented by each start so that threads drop the
+   *  buffers of earlier recordings.
+   */
+  std::atomic<uint64_t> generation{0};
+  std::atomic<uint32_t> next_tid{0};
+};
+
+registry& get_registry()
+{
+  static registry reg;
+  return reg;
+}
+
+thread_local std::shared_ptr<thread_buffer> t_buffer;
+thread_local std::string t_name;
+thread_local uint32_t t_tid = static_cast<uint32_t>(-1);
+
+thread_buffer& get_thread_buffer()
+{
+  auto& reg = get_registry();
+  const auto generation = reg.generation.load(std::memory_order_acquire);
+  if (t_buffer == nullptr || t_buffer->generation() != generation) {
+    if (t_tid == static_cast<uint32_t>(-1)) {
+      t_tid = reg.next_tid.fetch_add(1);
+    }
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    t_buffer = std::make_shared<thread_buffer>(t_tid, reg.capacity, generation);
+    t_buffer->m_name =
+      (t_name.empty() ? "thread " + std::to_string(t_tid) : t_name);
+    reg.buffers.push_back(t_buffer);
+  }
+  return *t_buffer;
+}
+
+void write_json_string(std::ostream& os, std::string const& str)
+{
+  os << '"';
+  for (const char c : str) {
+    switch (c) {
+    case '"':
+      os << "\\\"";
+      break;
+    case '\\':
+      os << "\\\\";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        os << ' ';
+      }
+      else {
+        os << c;
+      }
+    }
+  }
+  os << '"';
+}
+
+/** @brief Serialize this rank's events as comma-terminated JSON
+ *  objects.
+ */
+std::string serialize_events(int rank)
+{
+  auto& reg = get_registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  std::ostringstream os;
+  os.precision(3);
+  os << std::fixed;
+  os << R"({"name":"process_name","ph":"M","pid":)" << rank
+     << R"(,"args":{"name":"rank )" << rank << "\"}},\n";
+  os << R"({"name":"process_sort_index","ph":"M","pid":)" << rank
+     << R"(,"args":{"sort_index":)" << rank << "}},\n";
+  for (auto const& buffer : reg.buffers) {
+    os << R"({"name":"thread_name","ph":"M","pid":)" << rank
+       << R"(,"tid":)" << buffer->tid() << R"(,"args":{"name":)";
+    write_json_string(os, buffer->m_name);
+    os << "}},\n";
+    buffer->for_each([&](event const& e) {
+      if (e.start < reg.origin) {
+        return;
+      }
+      os << R"({"name":)";
+      write_json_string(os, reg.names[e.name]);
+      os << R"(,"cat":")" << to_string(e.cat) << R"(","ph":")" << e.phase
+         << R"(","pid":)" << rank << R"(,"tid":)" << buffer->tid()
+         << R"(,"ts":)" << (e.start - reg.origin) * 1e-3;
+      if (e.phase == 'X') {
+        os << R"(,"dur":)" << e.duration * 1e-3;
+      }
+      else {
+        os << R"(,"s":"t")";
+      }
+      os << "},\n";
+    });
+  }
+  return os.str();
+}
+
+} // namespace
+
+char const* to_string(category cat) noexcept
+{
+  switch (cat) {
+  case category::forward_prop:
+    return "forward_prop";
+  case category::backward_prop:
+    return "backward_prop";
+  case category::optimizer:
+    return "optimizer";
+  case category::io:
+    return "io";
+  case category::data_store:
+    return "data_store";
+  case category::comm:
+    return "comm";
+  case category::region:
+    return "region";
+  default:
+    return "unknown";
+  }
+}
+
+name_id intern(std::string const& name)
+{
+  auto& reg = get_registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  auto it = reg.ids.find(name);
+  if (it != reg.ids.end()) {
+    return it->second;
+  }
+  const auto id = static_cast<name_id>(reg.names.size());
+  reg.names.push_back(name);
+  reg.ids.emplace(name, id);
+  return id;
+}
+
+name_id intern_cached(std::string const& name)
+{
+  thread_local std::unordered_map<std::string, name_id> cache;
+  auto it = cache.find(name);
+  if (it != cache.end()) {
+    return it->second;
+  }
+  const auto id = intern(name);
+  cache.emplace(name, id);
+  return id;
+}
+
+void record_complete(name_id name,
+                     category cat,
+                     uint64_t start,
+                     uint64_t end) noexcept
+{
+  // Drop the event if the thread's buffer cannot be allocated
+  try {
+    get_thread_buffer().push({start, end - start, name, cat, 'X'});
+  }
+  catch (...) {
+  }
+}
+
+void record_instant(name_id name, category cat) noexcept
+{
+  try {
+    get_thread_buffer().push({now(), 0, name, cat, 'i'});
+  }
+  catch (...) {
+  }
+}
+
+void set_thread_name(std::string const& name)
+{
+  t_name = name;
+  if (t_buffer != nullptr) {
+    std::lock_guard<std::mutex> lock(get_registry().mutex);
+    t_buffer->m_name = name;
+  }
+}
+
+void start(lbann_comm const& comm, size_t events_per_thread)
+{
+  if (t_name.empty()) {
+    set_thread_name("main");
+  }
+  // Align time zero across ranks
+  comm.global_barrier();
+  auto& reg = get_registry();
+  {
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    size_t capacity = 1;
+    while (capacity < events_per_thread) {
+      capacity *= 2;
+    }
+    reg.capacity = capacity;
+    reg.buffers.clear();
+    reg.origin = now();
+    reg.generation.fetch_add(1, std::memory_order_acq_rel);
+  }
+  details::enabled.store(true, std::memory_order_release);
+}
+
+void stop() { details::enabled.store(false, std::memory_order_release); }
+
+void write_chrome_trace(lbann_comm const& comm, std::string const& filename)
+{
+  const auto mpi_comm = comm.get_world_comm().GetMPIComm();
+  const int rank = comm.get_rank_in_world();
+  const int num_ranks = comm.get_procs_in_world();
+  std::string local = serialize_events(rank);
+
+  // Drop the trailing separator
+  while (!local.empty() && (local.back() == '\n' || local.back() == ',')) {
+    local.pop_back();
+  }
+
+  // Make sure the file can be written before other ranks send events
+  std::ofstream ofs;
+  int opened = 1;
+  if (rank == 0) {
+    ofs.open(filename);
+    opened = static_cast<bool>(ofs);
+  }
+  MPI_Bcast(&opened, 1, MPI_INT, 0, mpi_comm);
+  if (!opened) {
+    if (rank == 0) {
+      LBANN_ERROR("could not open trace file \"", filename, "\"");
+    }
+    return;
+  }
+
+  // Stream each rank's events to the world master. Traces may exceed
+  // the int counts of MPI messages, so they are sent in chunks. A
+  // duplicate communicator keeps them apart from other messages.
+  constexpr int tag = 0;
+  constexpr size_t max_chunk_size = size_t{1} << 30;
+  MPI_Comm trace_comm;
+  MPI_Comm_dup(mpi_comm, &trace_comm);
+  if (rank != 0) {
+    uint64_t size = local.size();
+    MPI_Send(&size, 1, MPI_UINT64_T, 0, tag, trace_comm);
+    for (size_t pos = 0; pos < size; pos += max_chunk_size) {
+      const auto chunk_size = std::min(max_chunk_size, size - pos);
+      MPI_Send(&local[pos],
+               static_cast<int>(chunk_size),
+               MPI_CHAR,
+               0,
+               tag,
+               trace_comm);
+    }
+    MPI_Comm_free(&trace_comm);
+    return;
+  }
+  ofs << "{\"traceEvents\":[\n" << local;
+  std::vector<char> chunk;
+  for (int source = 1; source < num_ranks; ++source) {
+    uint64_t size = 0;
+    MPI_Recv(&size,
+             1,
+             MPI_UINT64_T,
+             source,
+             tag,
+             trace_comm,
+             MPI_STATUS_IGNORE);
+    if (size > 0) {
+      ofs << ",\n";
+    }
+    chunk.resize(std::min<uint64_t>(size, max_chunk_size));
+    for (size_t pos = 0; pos < size; pos += max_chunk_size) {
+      const auto chunk_size = std::min(max_chunk_size, size - pos);
+      MPI_Recv(chunk.data(),
+               static_cast<int>(chunk_size),
+               MPI_CHAR,
+               source,
+               tag,
+               trace_comm,
+               MPI_STATUS_IGNORE);
+      ofs.write(chunk.data(), chunk_size);
+    }
+  }
+  MPI_Comm_free(&trace_comm);
+  ofs << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  if (!ofs) {
+    LBANN_ERROR("could not write trace file \"", filename, "\"");
+  }
+  std::cout << "Wrote trace to " << filename << std::endl;
+}
+
+} // namespace tracing
+} // namespace lbann
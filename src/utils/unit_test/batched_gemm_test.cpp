@@ -0,0 +1,352 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+// MUST include this
+#include "Catch2BasicSupport.hpp"
+
+// File being tested
+#include <lbann/utils/batched_gemm.hpp>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+// Reference column-major GEMM
+template <typename T>
+void reference_gemm(bool trans_a,
+                    bool trans_b,
+                    El::Int m,
+                    El::Int n,
+                    El::Int k,
+                    T alpha,
+                    const T* A,
+                    El::Int lda,
+                    const T* B,
+                    El::Int ldb,
+                    T beta,
+                    T* C,
+                    El::Int ldc)
+{
+  for (El::Int j = 0; j < n; ++j) {
+    for (El::Int i = 0; i < m; ++i) {
+      double sum = 0.;
+      for (El::Int p = 0; p < k; ++p) {
+        const double a = trans_a ? A[p + i * lda] : A[i + p * lda];
+        const double b = trans_b ? B[j + p * ldb] : B[p + j * ldb];
+        sum += a * b;
+      }
+      auto& c = C[i + j * ldc];
+      c = static_cast<T>(alpha * sum + (beta == T(0) ? T(0) : beta * c));
+    }
+  }
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("CPU strided batched GEMM",
+                   "[utilities][gemm]",
+                   float,
+                   double)
+{
+  using T = TestType;
+  std::mt19937 gen(17);
+  std::uniform_real_distribution<T> dist(-1, 1);
+
+  // Shapes exercise partial panels and panel boundaries
+  using I = El::Int;
+  auto shape = GENERATE(std::make_tuple(I(1), I(1), I(1)),
+                        std::make_tuple(I(7), I(5), I(3)),
+                        std::make_tuple(I(16), I(9), I(33)),
+                        std::make_tuple(I(130), I(6), I(300)));
+  const El::Int m = std::get<0>(shape);
+  const El::Int n = std::get<1>(shape);
+  const El::Int k = std::get<2>(shape);
+  auto trans_a = GENERATE(false, true);
+  auto trans_b = GENERATE(false, true);
+  const El::Int batch_count = 5;
+  const El::Int lda = (trans_a ? k : m) + 2;
+  const El::Int ldb = (trans_b ? n : k) + 1;
+  const El::Int ldc = m + 3;
+  const El::Int strideA = lda * (trans_a ? m : k) + 4;
+  const El::Int strideB = ldb * (trans_b ? k : n);
+  const El::Int strideC = ldc * n + 1;
+
+  std::vector<T> A(strideA * batch_count), B(strideB * batch_count);
+  std::vector<T> C(strideC * batch_count);
+  for (auto& x : A) {
+    x = dist(gen);
+  }
+  for (auto& x : B) {
+    x = dist(gen);
+  }
+  for (auto& x : C) {
+    x = dist(gen);
+  }
+  auto C_ref = C;
+
+  const T tol = 64 * k * std::numeric_limits<T>::epsilon();
+  auto check = [&](T alpha, T beta) {
+    for (El::Int i = 0; i < batch_count; ++i) {
+      reference_gemm<T>(trans_a,
+                        trans_b,
+                        m,
+                        n,
+                        k,
+                        alpha,
+                        A.data() + i * strideA,
+                        lda,
+                        B.data() + i * strideB,
+                        ldb,
+                        beta,
+                        C_ref.data() + i * strideC,
+                        ldc);
+    }
+    lbann::gemm_strided_batched<T>(trans_a ? El::TRANSPOSE : El::NORMAL,
+                                   trans_b ? El::TRANSPOSE : El::NORMAL,
+                                   m,
+                                   n,
+                                   k,
+                                   alpha,
+                                   A.data(),
+                                   lda,
+                                   strideA,
+                                   B.data(),
+                                   ldb,
+                                   strideB,
+                                   beta,
+                                   C.data(),
+                                   ldc,
+                                   strideC,
+                                   batch_count);
+    for (size_t i = 0; i < C.size(); ++i) {
+      REQUIRE(std::abs(C[i] - C_ref[i]) <= tol);
+    }
+  };
+
+  SECTION("Overwrite output")
+  {
+    // Output is not read, even if it contains NaNs
+    for (El::Int i = 0; i < batch_count; ++i) {
+      for (El::Int j = 0; j < n; ++j) {
+        for (El::Int r = 0; r < m; ++r) {
+          C[i * strideC + r + j * ldc] = std::nan("");
+          C_ref[i * strideC + r + j * ldc] = 0;
+        }
+      }
+    }
+    check(T(1), T(0));
+  }
+  SECTION("Accumulate into output") { check(T(-0.5), T(2)); }
+}
+
+TEST_CASE("Packed GEMM with zero inner dimension", "[utilities][gemm]")
+{
+  std::vector<float> C = {1.f, 2.f, 3.f, 4.f};
+  lbann::packed_gemm<float>(El::NORMAL,
+                            El::NORMAL,
+                            2,
+                            2,
+                            0,
+                            1.f,
+                            nullptr,
+                            2,
+                            nullptr,
+                            1,
+                            3.f,
+                            C.data(),
+                            2);
+  CHECK(C == std::vector<float>({3.f, 6.f, 9.f, 12.f}));
+}
+
+TEMPLATE_TEST_CASE("Packed GEMM around the small-product BLAS threshold",
+                   "[utilities][gemm]",
+                   float,
+                   double)
+{
+  using T = TestType;
+  std::mt19937 gen(29);
+  std::uniform_real_distribution<T> dist(-1, 1);
+
+  // Products with at most 16^3 (double) or 32^3 (float) multiply-adds
+  // are handed to BLAS, the others use the packed kernel
+  using I = El::Int;
+  auto shape = GENERATE(std::make_tuple(I(2), I(3), I(1)),
+                        std::make_tuple(I(4), I(4), I(4)),
+                        std::make_tuple(I(16), I(16), I(16)),
+                        std::make_tuple(I(17), I(16), I(16)),
+                        std::make_tuple(I(32), I(32), I(32)),
+                        std::make_tuple(I(32), I(33), I(32)));
+  const El::Int m = std::get<0>(shape);
+  const El::Int n = std::get<1>(shape);
+  const El::Int k = std::get<2>(shape);
+  auto trans_a = GENERATE(false, true);
+  auto trans_b = GENERATE(false, true);
+  const El::Int lda = (trans_a ? k : m) + 1;
+  const El::Int ldb = (trans_b ? n : k) + 2;
+  const El::Int ldc = m + 1;
+
+  std::vector<T> A(lda * (trans_a ? m : k)), B(ldb * (trans_b ? k : n));
+  std::vector<T> C(ldc * n);
+  for (auto& x : A) {
+    x = dist(gen);
+  }
+  for (auto& x : B) {
+    x = dist(gen);
+  }
+  for (auto& x : C) {
+    x = dist(gen);
+  }
+  auto C_ref = C;
+
+  const T tol = 64 * k * std::numeric_limits<T>::epsilon();
+  auto check = [&](T alpha, T beta) {
+    reference_gemm<T>(trans_a,
+                      trans_b,
+                      m,
+                      n,
+                      k,
+                      alpha,
+                      A.data(),
+                      lda,
+                      B.data(),
+                      ldb,
+                      beta,
+                      C_ref.data(),
+                      ldc);
+    lbann::packed_gemm<T>(trans_a ? El::TRANSPOSE : El::NORMAL,
+                          trans_b ? El::TRANSPOSE : El::NORMAL,
+                          m,
+                          n,
+                          k,
+                          alpha,
+                          A.data(),
+                          lda,
+                          B.data(),
+                          ldb,
+                          beta,
+                          C.data(),
+                          ldc);
+    for (size_t i = 0; i < C.size(); ++i) {
+      REQUIRE(std::abs(C[i] - C_ref[i]) <= tol);
+    }
+  };
+
+  SECTION("Overwrite output")
+  {
+    // Output is not read, even if it contains NaNs
+    for (El::Int j = 0; j < n; ++j) {
+      for (El::Int r = 0; r < m; ++r) {
+        C[r + j * ldc] = std::nan("");
+        C_ref[r + j * ldc] = 0;
+      }
+    }
+    check(T(1), T(0));
+  }
+  SECTION("Accumulate into output") { check(T(0.75), T(-1)); }
+}
+
+#ifdef LBANN_HAS_HALF
+TEST_CASE("CPU strided batched GEMM in half precision", "[utilities][gemm]")
+{
+  using T = lbann::cpu_fp16;
+  std::mt19937 gen(31);
+  // Small integers keep every product and partial sum exact in half
+  // precision, so results can be compared exactly
+  std::uniform_int_distribution<int> dist(-2, 2);
+
+  using I = El::Int;
+  auto shape = GENERATE(std::make_tuple(I(3), I(2), I(1)),
+                        std::make_tuple(I(7), I(5), I(3)),
+                        std::make_tuple(I(16), I(9), I(33)),
+                        std::make_tuple(I(130), I(6), I(300)));
+  const El::Int m = std::get<0>(shape);
+  const El::Int n = std::get<1>(shape);
+  const El::Int k = std::get<2>(shape);
+  auto trans_a = GENERATE(false, true);
+  auto trans_b = GENERATE(false, true);
+  const El::Int batch_count = 3;
+  const El::Int lda = trans_a ? k : m;
+  const El::Int ldb = trans_b ? n : k;
+  const El::Int ldc = m + 1;
+  const El::Int strideA = lda * (trans_a ? m : k);
+  const El::Int strideB = ldb * (trans_b ? k : n);
+  const El::Int strideC = ldc * n;
+
+  std::vector<float> A(strideA * batch_count), B(strideB * batch_count);
+  std::vector<float> C_ref(strideC * batch_count);
+  for (auto& x : A) {
+    x = static_cast<float>(dist(gen));
+  }
+  for (auto& x : B) {
+    x = static_cast<float>(dist(gen));
+  }
+  for (auto& x : C_ref) {
+    x = static_cast<float>(dist(gen));
+  }
+  std::vector<T> A_half(A.begin(), A.end()), B_half(B.begin(), B.end());
+  std::vector<T> C_half(C_ref.begin(), C_ref.end());
+
+  for (El::Int i = 0; i < batch_count; ++i) {
+    reference_gemm<float>(trans_a,
+                          trans_b,
+                          m,
+                          n,
+                          k,
+                          1.f,
+                          A.data() + i * strideA,
+                          lda,
+                          B.data() + i * strideB,
+                          ldb,
+                          2.f,
+                          C_ref.data() + i * strideC,
+                          ldc);
+  }
+  lbann::gemm_strided_batched<T>(trans_a ? El::TRANSPOSE : El::NORMAL,
+                                 trans_b ? El::TRANSPOSE : El::NORMAL,
+                                 m,
+                                 n,
+                                 k,
+                                 T(1.f),
+                                 A_half.data(),
+                                 lda,
+                                 strideA,
+                                 B_half.data(),
+                                 ldb,
+                                 strideB,
+                                 T(2.f),
+                                 C_half.data(),
+                                 ldc,
+                                 strideC,
+                                 batch_count);
+  for (size_t i = 0; i < C_half.size(); ++i) {
+    REQUIRE(static_cast<float>(C_half[i]) == C_ref[i]);
+  }
+}
+#endif // LBANN_HAS_HALF
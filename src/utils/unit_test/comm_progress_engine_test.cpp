@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Catch2BasicSupport.hpp"
+
+#include "MPITestHelpers.hpp"
+
+#include <lbann/comm_progress_engine.hpp>
+
+#include <memory>
+#include <vector>
+
+using lbann::comm_progress_engine;
+
+namespace {
+
+/** @brief Start an allreduce of the ranks into @c sum. */
+MPI_Request start_rank_sum(int const& rank, int& sum)
+{
+  MPI_Request req = MPI_REQUEST_NULL;
+  MPI_Iallreduce(&rank, &sum, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD, &req);
+  return req;
+}
+
+} // namespace
+
+TEST_CASE("Communication progress engine", "[mpi][comm][progress]")
+{
+  if (!comm_progress_engine::is_supported()) {
+    WARN("MPI does not provide MPI_THREAD_MULTIPLE, skipping");
+    return;
+  }
+
+  auto& world_comm = unit_test::utilities::current_world_comm();
+  const int rank = world_comm.get_rank_in_world();
+  const int num_procs = world_comm.get_procs_in_world();
+  const int expected = num_procs * (num_procs - 1) / 2;
+
+  comm_progress_engine engine;
+
+  SECTION("Wait on a tracked request")
+  {
+    int sum = -1;
+    MPI_Request req = start_rank_sum(rank, sum);
+    engine.track(&req);
+    CHECK(engine.wait(&req));
+    CHECK(req == MPI_REQUEST_NULL);
+    CHECK(sum == expected);
+    CHECK(engine.get_num_requests() == 1UL);
+    CHECK(engine.get_overlap_time() >= 0.0);
+    CHECK(engine.get_wait_time() >= 0.0);
+
+    // Completed requests are no longer tracked
+    CHECK_FALSE(engine.wait(&req));
+    engine.reset_counters();
+    CHECK(engine.get_num_requests() == 0UL);
+  }
+
+  SECTION("Test a tracked request")
+  {
+    int sum = -1;
+    MPI_Request req = start_rank_sum(rank, sum);
+    engine.track(&req);
+    bool complete = false;
+    while (!complete) {
+      REQUIRE(engine.test(&req, complete));
+    }
+    CHECK(req == MPI_REQUEST_NULL);
+    CHECK(sum == expected);
+    CHECK(engine.get_num_requests() == 1UL);
+  }
+
+  SECTION("Requests are identified by handle, not by address")
+  {
+    // The structure that held the handle when it was tracked is gone
+    // by the time the request is completed
+    int sum = -1;
+    auto holder = std::make_unique<MPI_Request>(start_rank_sum(rank, sum));
+    engine.track(holder.get());
+    MPI_Request req = *holder;
+    holder.reset();
+    CHECK(engine.wait(&req));
+    CHECK(req == MPI_REQUEST_NULL);
+    CHECK(sum == expected);
+  }
+
+  SECTION("Many requests in flight")
+  {
+    constexpr int num_requests = 32;
+    std::vector<int> values(num_requests), sums(num_requests, -1);
+    std::vector<MPI_Request> reqs(num_requests);
+    for (int i = 0; i < num_requests; ++i) {
+      values[i] = rank + i;
+      reqs[i] = start_rank_sum(values[i], sums[i]);
+      engine.track(&reqs[i]);
+    }
+    for (int i = num_requests - 1; i >= 0; --i) {
+      CHECK(engine.wait(&reqs[i]));
+      CHECK(reqs[i] == MPI_REQUEST_NULL);
+      CHECK(sums[i] == expected + num_procs * i);
+    }
+    CHECK(engine.get_num_requests() == static_cast<size_t>(num_requests));
+  }
+
+  SECTION("Untracked and null requests")
+  {
+    MPI_Request null_req = MPI_REQUEST_NULL;
+    engine.track(&null_req);
+    CHECK_FALSE(engine.wait(&null_req));
+    bool complete = false;
+    CHECK_FALSE(engine.test(&null_req, complete));
+
+    int sum = -1;
+    MPI_Request req = start_rank_sum(rank, sum);
+    const MPI_Request handle = req;
+    CHECK_FALSE(engine.wait(&req));
+    CHECK(req == handle);
+    MPI_Wait(&req, MPI_STATUS_IGNORE);
+    CHECK(sum == expected);
+    CHECK(engine.get_num_requests() == 0UL);
+  }
+
+  SECTION("A request cannot be tracked twice")
+  {
+    int sum = -1;
+    MPI_Request req = start_rank_sum(rank, sum);
+    engine.track(&req);
+    MPI_Request copy = req;
+    CHECK_THROWS(engine.track(&copy));
+    CHECK(engine.wait(&req));
+    CHECK(sum == expected);
+  }
+}
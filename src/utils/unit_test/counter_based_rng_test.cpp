@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+// MUST include this
+#include "Catch2BasicSupport.hpp"
+
+// File being tested
+#include <lbann/utils/counter_based_rng.hpp>
+
+#include <vector>
+
+using namespace lbann::philox;
+
+TEST_CASE("Testing Philox4x32-10", "[random][utilities]")
+{
+
+  SECTION("Known-answer vectors")
+  {
+    // Reference values from the Random123 test suite
+    CHECK(philox4x32({0u, 0u, 0u, 0u}, {0u, 0u}) ==
+          counter_type{0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u});
+    CHECK(philox4x32({0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu},
+                     {0xffffffffu, 0xffffffffu}) ==
+          counter_type{0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu});
+    CHECK(philox4x32({0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u},
+                     {0xa4093822u, 0x299f31d0u}) ==
+          counter_type{0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u});
+  }
+
+  SECTION("Bernoulli thresholds")
+  {
+    CHECK(bernoulli_threshold(-1.0) == 0ul);
+    CHECK(bernoulli_threshold(0.0) == 0ul);
+    CHECK(bernoulli_threshold(0.5) == 2147483648ul);
+    CHECK(bernoulli_threshold(1.0) == 4294967296ul);
+    CHECK(bernoulli_threshold(2.0) == 4294967296ul);
+  }
+}
+
+TEST_CASE("Testing regenerable Bernoulli masks", "[random][utilities]")
+{
+  constexpr size_t height = 37;
+  constexpr size_t width = 23;
+  constexpr size_t ldim = 41;
+  const auto key = make_key(0x0123456789abcdefull);
+  const auto threshold = bernoulli_threshold(0.75);
+  auto mask_value = [](const float& x, bool keep) {
+    return keep ? x : 0.f;
+  };
+
+  std::vector<float> ones(ldim * width, 1.f);
+  std::vector<float> mask(ldim * width, -1.f);
+  apply_bernoulli_mask(key,
+                       threshold,
+                       height,
+                       width,
+                       ones.data(),
+                       ldim,
+                       mask.data(),
+                       ldim,
+                       mask_value);
+
+  SECTION("Mask is regenerated from the key")
+  {
+    std::vector<float> regen(ones);
+    apply_bernoulli_mask(key,
+                         threshold,
+                         height,
+                         width,
+                         regen.data(),
+                         ldim,
+                         regen.data(),
+                         ldim,
+                         mask_value);
+    for (size_t col = 0; col < width; ++col) {
+      for (size_t row = 0; row < height; ++row) {
+        REQUIRE(regen[row + col * ldim] == mask[row + col * ldim]);
+      }
+    }
+  }
+
+  SECTION("Padding entries are untouched")
+  {
+    for (size_t col = 0; col < width; ++col) {
+      for (size_t row = height; row < ldim; ++row) {
+        REQUIRE(mask[row + col * ldim] == -1.f);
+      }
+    }
+  }
+
+  SECTION("Keep fraction matches probability")
+  {
+    size_t num_kept = 0;
+    for (size_t col = 0; col < width; ++col) {
+      for (size_t row = 0; row < height; ++row) {
+        num_kept += (mask[row + col * ldim] == 1.f) ? 1 : 0;
+      }
+    }
+    const double frac = double(num_kept) / double(height * width);
+    CHECK(frac > 0.70);
+    CHECK(frac < 0.80);
+  }
+
+  SECTION("Different keys give different masks")
+  {
+    std::vector<float> other(ldim * width, -1.f);
+    apply_bernoulli_mask(make_key(42),
+                         threshold,
+                         height,
+                         width,
+                         ones.data(),
+                         ldim,
+                         other.data(),
+                         ldim,
+                         mask_value);
+    CHECK(other != mask);
+  }
+}
+
+TEST_CASE("Testing dropout masks across passes", "[random][utilities]")
+{
+  // Mirrors how dropout layers regenerate their masks: a seed is drawn
+  // in forward prop and reused in backprop.
+  constexpr size_t height = 19;
+  constexpr size_t width = 11;
+  const auto threshold = bernoulli_threshold(0.5);
+  auto mask_value = [](const float& x, bool keep) {
+    return keep ? x : 0.f;
+  };
+  const std::vector<float> ones(height * width, 1.f);
+  auto make_mask = [&](uint64_t seed) {
+    std::vector<float> mask(height * width, -1.f);
+    apply_bernoulli_mask(make_key(seed),
+                         threshold,
+                         height,
+                         width,
+                         ones.data(),
+                         height,
+                         mask.data(),
+                         height,
+                         mask_value);
+    return mask;
+  };
+
+  const auto seed = draw_seed();
+  const auto fp_mask = make_mask(seed);
+
+  SECTION("Mask stays fixed within a pass")
+  {
+    CHECK(make_mask(seed) == fp_mask);
+  }
+
+  SECTION("Mask changes between passes")
+  {
+    const auto next_seed = draw_seed();
+    CHECK(next_seed != seed);
+    CHECK(make_mask(next_seed) != fp_mask);
+  }
+}
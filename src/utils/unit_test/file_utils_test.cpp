@@ -29,8 +29,10 @@
 // File being tested
 #include <lbann/utils/file_utils.hpp>
 
+#include <cstdio>
 #include <memory>
 #include <numeric>
+#include <string>
 #include <vector>
 
 TEST_CASE("Testing \"file_join\" function", "[seq][file][utilities]")
@@ -41,3 +43,36 @@ TEST_CASE("Testing \"file_join\" function", "[seq][file][utilities]")
   REQUIRE(lbann::file::join_path("/a", "b", std::string("c"), "d") ==
           "/a/b/c/d");
 }
+
+TEST_CASE("Testing \"mapped_file\" class", "[seq][file][utilities]")
+{
+  std::string const path = "mapped_file_test.txt";
+  std::string const contents = "1,2,3\n4,5,6\n";
+  {
+    std::ofstream ofs(path, std::ios::binary);
+    ofs << contents;
+  }
+
+  SECTION("Maps the file contents")
+  {
+    lbann::file::mapped_file file(path);
+    REQUIRE(file.size() == contents.size());
+    REQUIRE(std::string(file.data(), file.size()) == contents);
+    REQUIRE(lbann::file::get_file_stamp(path).size == contents.size());
+  }
+
+  SECTION("Empty files have no data")
+  {
+    std::ofstream(path, std::ios::trunc);
+    lbann::file::mapped_file file(path);
+    REQUIRE(file.size() == 0UL);
+    REQUIRE(file.data() == nullptr);
+  }
+
+  SECTION("Missing files throw")
+  {
+    REQUIRE_THROWS(lbann::file::mapped_file("no_such_file_for_mapped_file"));
+  }
+
+  std::remove(path.c_str());
+}
@@ -197,3 +197,65 @@ TEMPLATE_TEST_CASE("From string to unsigned integer type",
   REQUIRE(from_string<TestType>("9876543210") == PositiveAnswer<TestType>());
   REQUIRE(from_string<TestType>("-1") == NegativeAnswer<TestType>());
 }
+
+TEST_CASE("Parsing doubles from character ranges", "[utilities][string]")
+{
+  using lbann::utils::parse_double;
+  auto parse = [](std::string const& str, double& value) {
+    char const* first = str.data();
+    return parse_double(first, first + str.size(), value) - first;
+  };
+  double value = 0.;
+
+  SECTION("Matches strtod")
+  {
+    for (std::string const str : {"9.87",
+                                  "-6.54",
+                                  "  42",
+                                  ".5",
+                                  "1e-5",
+                                  "3E10",
+                                  "0.1",
+                                  "123456789012345678901234",
+                                  "1.7976931348623157e308",
+                                  "4.9e-324",
+                                  "inf"}) {
+      CHECK(parse(str, value) == static_cast<long>(str.size()));
+      CHECK(value == std::strtod(str.c_str(), nullptr));
+    }
+  }
+
+  SECTION("Hexadecimal numbers")
+  {
+    REQUIRE(parse("0x10", value) == 4);
+    REQUIRE(value == 16.);
+    REQUIRE(parse("-0X1.8p1,3", value) == 8);
+    REQUIRE(value == -3.);
+    REQUIRE(parse(" 0x1p-2", value) == 7);
+    REQUIRE(value == 0.25);
+  }
+
+  SECTION("Stops at the end of the number")
+  {
+    REQUIRE(parse("1.5,2", value) == 3);
+    REQUIRE(value == 1.5);
+    REQUIRE(parse("7\n", value) == 1);
+    REQUIRE(value == 7.);
+    REQUIRE(parse("2e", value) == 1);
+    REQUIRE(value == 2.);
+  }
+
+  SECTION("Respects the end of the range")
+  {
+    std::string const str = "12345";
+    REQUIRE(parse_double(str.data(), str.data() + 2, value) == str.data() + 2);
+    REQUIRE(value == 12.);
+  }
+
+  SECTION("Rejects non-numbers")
+  {
+    REQUIRE(parse("pineapple", value) == 0);
+    REQUIRE(parse("", value) == 0);
+    REQUIRE(parse("-", value) == 0);
+  }
+}
@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+// MUST include this
+#include "Catch2BasicSupport.hpp"
+
+// File being tested
+#include <lbann/utils/moments.hpp>
+
+#include <cmath>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+// Two-pass reference in double precision
+template <typename T>
+void reference_moments(const std::vector<T>& x, double& mean, double& m2)
+{
+  mean = 0.;
+  for (const auto& val : x) {
+    mean += val;
+  }
+  mean /= x.size();
+  m2 = 0.;
+  for (const auto& val : x) {
+    m2 += (val - mean) * (val - mean);
+  }
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Single-pass moments", "[utilities][stats]", float, double)
+{
+  using T = TestType;
+  const double tol = std::is_same_v<T, float> ? 1e-4 : 1e-10;
+  const El::Int size = GENERATE(1, 7, 8, 100, 512, 513, 5000);
+  const T offset = GENERATE(T(0), T(1e4));
+  std::mt19937 gen(size);
+  std::normal_distribution<T> dist(offset, T(1));
+  std::vector<T> x(size);
+  for (auto& val : x) {
+    val = dist(gen);
+  }
+  double mean, m2;
+  reference_moments(x, mean, m2);
+
+  SECTION("compute_moments")
+  {
+    const auto m = lbann::compute_moments(x.data(), size);
+    CHECK(m.count == T(size));
+    CHECK(m.mean == Approx(mean).epsilon(tol));
+    CHECK(m.m2 == Approx(m2).epsilon(tol).margin(tol));
+  }
+
+  SECTION("merge")
+  {
+    const El::Int split = size / 3;
+    auto m = lbann::compute_moments(x.data(), split);
+    m.merge(lbann::compute_moments(x.data() + split, size - split));
+    CHECK(m.count == T(size));
+    CHECK(m.mean == Approx(mean).epsilon(tol));
+    CHECK(m.m2 == Approx(m2).epsilon(tol).margin(tol));
+  }
+
+  SECTION("accumulate_centered_sums")
+  {
+    const T center = static_cast<T>(mean);
+    std::vector<T> w(size);
+    for (auto& val : w) {
+      val = dist(gen) - offset;
+    }
+    double ref_w = 0., ref_wu = 0., ref_u = 0., ref_uu = 0., abs_sum = 0.;
+    for (El::Int i = 0; i < size; ++i) {
+      const double u = static_cast<double>(x[i]) - center;
+      ref_w += w[i];
+      ref_wu += w[i] * u;
+      ref_u += u;
+      ref_uu += u * u;
+      abs_sum += std::abs(w[i]) * (1. + std::abs(u));
+    }
+    T sum_w = T(0), sum_wu = T(0);
+    lbann::accumulate_centered_sums(x.data(),
+                                    w.data(),
+                                    size,
+                                    center,
+                                    sum_w,
+                                    sum_wu);
+    CHECK(sum_w == Approx(ref_w).margin(tol * abs_sum));
+    CHECK(sum_wu == Approx(ref_wu).margin(tol * abs_sum));
+
+    T sum_u = T(0), sum_uu = T(0);
+    lbann::accumulate_centered_sums<T>(x.data(),
+                                       nullptr,
+                                       size,
+                                       center,
+                                       sum_u,
+                                       sum_uu);
+    CHECK(sum_u == Approx(ref_u).margin(tol * size));
+    CHECK(sum_uu == Approx(ref_uu).epsilon(tol).margin(tol));
+  }
+}
@@ -0,0 +1,227 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+// MUST include this
+#include "Catch2BasicSupport.hpp"
+
+// File being tested
+#include <lbann/utils/simd.hpp>
+#include <lbann/utils/simd_math.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+/** @brief Error in units in the last place, relative to a reference
+ *         computed in higher precision.
+ */
+template <typename T>
+long double ulp_error(T x, long double ref)
+{
+  if (std::isnan(ref)) {
+    return std::isnan(x) ? 0.l : std::numeric_limits<long double>::infinity();
+  }
+  if (std::isinf(ref) || std::isinf(x)) {
+    return (static_cast<long double>(x) == ref)
+             ? 0.l
+             : std::numeric_limits<long double>::infinity();
+  }
+  const T r = static_cast<T>(ref);
+  const T a = std::fabs(r);
+  T ulp = std::nextafter(a, std::numeric_limits<T>::infinity()) - a;
+  ulp = std::isinf(ulp) ? a - std::nextafter(a, T(0)) : ulp;
+  return std::fabs(static_cast<long double>(x) - ref) / ulp;
+}
+
+/** @brief Evenly spaced sample points, with an odd count so that
+ *         vectorized loops also have a remainder.
+ */
+template <typename T>
+std::vector<T> linspace(T lo, T hi, size_t n = 100001)
+{
+  std::vector<T> x(n);
+  for (size_t i = 0; i < n; ++i) {
+    x[i] = lo + (hi - lo) * static_cast<T>(i) / static_cast<T>(n - 1);
+  }
+  return x;
+}
+
+/** @brief Largest error of a vectorized function for an instruction
+ *         set.
+ */
+template <typename T, typename F, typename RefF>
+long double max_ulp_error(lbann::simd::isa instruction_set,
+                          std::vector<T> const& x,
+                          F f,
+                          RefF ref)
+{
+  lbann::simd::set_isa(instruction_set);
+  std::vector<T> y(x.size());
+  lbann::simd::apply_unary(x.data(), y.data(), x.size(), f);
+  long double max_error = 0.l;
+  for (size_t i = 0; i < x.size(); ++i) {
+    max_error = std::max(max_error, ulp_error(y[i], ref(x[i])));
+  }
+  return max_error;
+}
+
+std::vector<lbann::simd::isa> supported_isas()
+{
+  using lbann::simd::isa;
+  std::vector<isa> isas;
+  for (auto instruction_set : {isa::baseline, isa::avx2, isa::avx512}) {
+    if (lbann::simd::is_supported(instruction_set)) {
+      isas.push_back(instruction_set);
+    }
+  }
+  return isas;
+}
+
+} // namespace
+
+TEST_CASE("Testing SIMD instruction set selection", "[simd][utilities]")
+{
+  using namespace lbann::simd;
+  const isa initial = get_isa();
+
+  CHECK(is_supported(isa::reference));
+  CHECK(is_supported(isa::baseline));
+  CHECK(is_supported(detected_isa()));
+  for (auto instruction_set :
+       {isa::reference, isa::baseline, isa::avx2, isa::avx512}) {
+    CHECK(isa_from_string(to_string(instruction_set)) == instruction_set);
+  }
+  CHECK_THROWS(isa_from_string("sse9"));
+
+  set_isa(isa::reference);
+  CHECK(get_isa() == isa::reference);
+  if (!is_supported(isa::avx512)) {
+    CHECK_THROWS(set_isa(isa::avx512));
+    CHECK(get_isa() == isa::reference);
+  }
+  set_isa(initial);
+}
+
+TEMPLATE_TEST_CASE("Testing vectorized math functions",
+                   "[simd][utilities]",
+                   float,
+                   double)
+{
+  using T = TestType;
+  using namespace lbann;
+  const simd::isa initial = simd::get_isa();
+  constexpr long double max_ulp = 3.l;
+  constexpr T min_normal = std::numeric_limits<T>::min();
+
+  // Sections are named after the instruction set, since Catch2 only
+  // enters a section with a given name once per run
+  for (auto instruction_set : supported_isas()) {
+    const auto isa_name = simd::to_string(instruction_set);
+
+    DYNAMIC_SECTION("exp (" << isa_name << ")")
+    {
+      auto f = [](T x) { return simd::exp(x); };
+      auto ref = [](T x) { return std::exp(static_cast<long double>(x)); };
+      CHECK(max_ulp_error(instruction_set, linspace<T>(-5, 5), f, ref) <=
+            max_ulp);
+      // Stay clear of the overflow threshold, which rounds up
+      const T max_arg = T(0.999) * std::log(std::numeric_limits<T>::max());
+      CHECK(max_ulp_error(instruction_set,
+                          linspace<T>(std::log(min_normal), max_arg),
+                          f,
+                          ref) <= max_ulp);
+    }
+
+    DYNAMIC_SECTION("expm1 (" << isa_name << ")")
+    {
+      auto f = [](T x) { return simd::expm1(x); };
+      auto ref = [](T x) { return std::expm1(static_cast<long double>(x)); };
+      CHECK(max_ulp_error(instruction_set, linspace<T>(-1, 1), f, ref) <=
+            max_ulp);
+      CHECK(max_ulp_error(instruction_set, linspace<T>(-50, 80), f, ref) <=
+            max_ulp);
+      CHECK(max_ulp_error(instruction_set, linspace<T>(1e-30, 1e-3), f, ref) <=
+            max_ulp);
+    }
+
+    DYNAMIC_SECTION("log (" << isa_name << ")")
+    {
+      auto f = [](T x) { return simd::log(x); };
+      auto ref = [](T x) { return std::log(static_cast<long double>(x)); };
+      CHECK(max_ulp_error(instruction_set, linspace<T>(0.5, 2), f, ref) <=
+            max_ulp);
+      CHECK(max_ulp_error(instruction_set, linspace<T>(1e-30, 1e30), f, ref) <=
+            max_ulp);
+      CHECK(max_ulp_error(instruction_set,
+                          linspace<T>(std::numeric_limits<T>::denorm_min(),
+                                      min_normal),
+                          f,
+                          ref) <= max_ulp);
+    }
+
+    DYNAMIC_SECTION("log1p (" << isa_name << ")")
+    {
+      auto f = [](T x) { return simd::log1p(x); };
+      auto ref = [](T x) { return std::log1p(static_cast<long double>(x)); };
+      CHECK(max_ulp_error(instruction_set, linspace<T>(-0.999, 1), f, ref) <=
+            max_ulp);
+      CHECK(max_ulp_error(instruction_set, linspace<T>(1e-30, 1e20), f, ref) <=
+            max_ulp);
+    }
+
+    DYNAMIC_SECTION("tanh (" << isa_name << ")")
+    {
+      auto f = [](T x) { return simd::tanh(x); };
+      auto ref = [](T x) { return std::tanh(static_cast<long double>(x)); };
+      CHECK(max_ulp_error(instruction_set, linspace<T>(-30, 30), f, ref) <=
+            max_ulp);
+      CHECK(max_ulp_error(instruction_set, linspace<T>(1e-20, 1), f, ref) <=
+            max_ulp);
+    }
+
+    DYNAMIC_SECTION("Special values (" << isa_name << ")")
+    {
+      constexpr T inf = std::numeric_limits<T>::infinity();
+      constexpr T nan = std::numeric_limits<T>::quiet_NaN();
+      const std::vector<T> x = {inf, -inf, nan, T(0), T(-0.), T(-1), T(1e6)};
+      auto check = [&](auto f, auto ref) {
+        CHECK(max_ulp_error(instruction_set, x, f, ref) <= max_ulp);
+      };
+      check([](T v) { return simd::exp(v); },
+            [](T v) { return std::exp(static_cast<long double>(v)); });
+      check([](T v) { return simd::expm1(v); },
+            [](T v) { return std::expm1(static_cast<long double>(v)); });
+      check([](T v) { return simd::log(v); },
+            [](T v) { return std::log(static_cast<long double>(v)); });
+      check([](T v) { return simd::log1p(v); },
+            [](T v) { return std::log1p(static_cast<long double>(v)); });
+      check([](T v) { return simd::tanh(v); },
+            [](T v) { return std::tanh(static_cast<long double>(v)); });
+    }
+  }
+  simd::set_isa(initial);
+}
@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+// MUST include this
+#include "Catch2BasicSupport.hpp"
+
+// File being tested
+#include <lbann/utils/sort_kernels.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace lbann::sort_kernels;
+
+namespace {
+
+template <typename T>
+std::vector<T> make_values(size_t size, int num_distinct, unsigned seed)
+{
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(-num_distinct, num_distinct);
+  std::vector<T> values(size);
+  for (auto& x : values) {
+    x = static_cast<T>(dist(gen)) / T(4);
+  }
+  return values;
+}
+
+template <typename T>
+std::vector<int64_t> reference_argsort(std::vector<T> const& values)
+{
+  std::vector<int64_t> indices(values.size());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    indices[i] = i;
+  }
+  std::stable_sort(indices.begin(), indices.end(), [&](int64_t a, int64_t b) {
+    return values[a] < values[b];
+  });
+  return indices;
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Testing argsort", "[sort][utilities]", float, double)
+{
+  for (size_t size : {1ul, 7ul, 63ul, 64ul, 1000ul, 4099ul}) {
+    // Few distinct values to exercise stability
+    auto values = make_values<TestType>(size, 20, size);
+    values[0] = TestType(-0.0);
+    values[size / 2] = TestType(0.0);
+    std::vector<int64_t> indices(size, -1);
+    argsort(values.data(), size, indices.data());
+    CHECK(indices == reference_argsort(values));
+  }
+}
+
+TEST_CASE("Testing argsort with large magnitudes", "[sort][utilities]")
+{
+  std::vector<float> values = {3.e38f, -1.f, -3.e38f, 1.e-38f, -1.e-38f, 0.f};
+  values.resize(128, 2.f);
+  std::vector<int32_t> indices(values.size());
+  argsort(values.data(), values.size(), indices.data());
+  for (size_t i = 1; i < values.size(); ++i) {
+    CHECK(values[indices[i - 1]] <= values[indices[i]]);
+  }
+  CHECK(indices.front() == 2);
+  CHECK(indices.back() == 0);
+}
+
+TEST_CASE("Testing top-k selection", "[sort][utilities]")
+{
+  using entry = top_k_entry<float, int64_t>;
+  auto get_index = [](size_t i) { return static_cast<int64_t>(3 * i + 1); };
+
+  for (size_t size : {0ul, 3ul, 10ul, 100ul, 5000ul}) {
+    for (size_t k : {1ul, 5ul, 10ul, 40ul}) {
+      auto values = make_values<float>(size, 50, 17 * size + k);
+
+      // Reference: sort all entries
+      std::vector<entry> expected(std::max(size, k));
+      for (size_t i = 0; i < size; ++i) {
+        expected[i].value = values[i];
+        expected[i].index = get_index(i);
+      }
+      std::sort(expected.begin(), expected.end(), entry::compare);
+
+      std::vector<entry> top(k);
+      find_top_k(values.data(), size, k, get_index, top.data());
+      for (size_t i = 0; i < k; ++i) {
+        CHECK(top[i].value == expected[i].value);
+        CHECK(top[i].index == expected[i].index);
+      }
+    }
+  }
+}
+
+TEST_CASE("Testing top-k merge", "[sort][utilities]")
+{
+  using entry = top_k_entry<double, int64_t>;
+  constexpr size_t k = 6;
+  constexpr size_t num_lists = 4;
+  constexpr size_t stride = 2 * k;
+  auto values = make_values<double>(num_lists * 20, 10, 5);
+
+  // Split entries into lists and find each list's top-k
+  std::vector<entry> candidates(num_lists * stride);
+  for (size_t list = 0; list < num_lists; ++list) {
+    find_top_k(
+      &values[list * 20],
+      20,
+      k,
+      [list](size_t i) { return static_cast<int64_t>(list * 20 + i); },
+      &candidates[list * stride]);
+  }
+  std::vector<entry> merged(k);
+  merge_top_k(candidates.data(), num_lists, stride, k, merged.data());
+
+  std::vector<entry> expected(k);
+  find_top_k(
+    values.data(),
+    values.size(),
+    k,
+    [](size_t i) { return static_cast<int64_t>(i); },
+    expected.data());
+  for (size_t i = 0; i < k; ++i) {
+    CHECK(merged[i].value == expected[i].value);
+    CHECK(merged[i].index == expected[i].index);
+  }
+}
@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2024, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Catch2BasicSupport.hpp"
+
+#include "MPITestHelpers.hpp"
+
+#include <lbann/utils/tracing.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace {
+std::string read_file(std::string const& filename)
+{
+  std::ifstream ifs(filename);
+  std::stringstream ss;
+  ss << ifs.rdbuf();
+  return ss.str();
+}
+} // namespace
+
+TEST_CASE("Tracing name interning", "[mpi][utilities][tracing]")
+{
+  using namespace lbann::tracing;
+  auto const a = intern("trace_test_a");
+  auto const b = intern("trace_test_b");
+  CHECK(a != invalid_name);
+  CHECK(b != invalid_name);
+  CHECK(a != b);
+  CHECK(intern("trace_test_a") == a);
+  CHECK(intern_cached("trace_test_a") == a);
+  CHECK(intern_cached("trace_test_a") == a);
+}
+
+TEST_CASE("Chrome trace export", "[mpi][utilities][tracing]")
+{
+  using namespace lbann::tracing;
+  auto& comm = ::unit_test::utilities::current_world_comm();
+  std::string const filename = "lbann_tracing_test.json";
+
+  // Events recorded while tracing is stopped are dropped
+  {
+    scope s(intern("trace_test_before"), category::region);
+  }
+
+  start(comm, 16);
+  CHECK(is_enabled());
+  {
+    scope s(intern("trace_test_outer"), category::forward_prop);
+    record_instant(intern("trace_test_instant"), category::comm);
+  }
+  std::thread worker([] {
+    set_thread_name("trace_test_worker");
+    scope s(intern("trace_test_worker_event"), category::io);
+  });
+  worker.join();
+
+  // Ring buffer keeps only the most recent events
+  for (int i = 0; i < 64; ++i) {
+    scope s(intern("trace_test_repeat"), category::optimizer);
+  }
+  stop();
+  CHECK_FALSE(is_enabled());
+  {
+    scope s(intern("trace_test_after"), category::region);
+  }
+
+  write_chrome_trace(comm, filename);
+  comm.global_barrier();
+  if (comm.am_world_master()) {
+    auto const trace = read_file(filename);
+    CHECK(trace.find("\"traceEvents\"") != std::string::npos);
+    CHECK(trace.find("trace_test_outer") == std::string::npos);
+    CHECK(trace.find("trace_test_instant") == std::string::npos);
+    CHECK(trace.find("trace_test_repeat") != std::string::npos);
+    CHECK(trace.find("trace_test_worker_event") != std::string::npos);
+    CHECK(trace.find("\"trace_test_worker\"") != std::string::npos);
+    CHECK(trace.find("trace_test_before") == std::string::npos);
+    CHECK(trace.find("trace_test_after") == std::string::npos);
+    for (int rank = 0; rank < comm.get_procs_in_world(); ++rank) {
+      std::string const process = "\"rank " + std::to_string(rank) + "\"";
+      CHECK(trace.find(process) != std::string::npos);
+    }
+    std::remove(filename.c_str());
+  }
+}
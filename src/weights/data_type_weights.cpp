@@ -40,6 +40,7 @@
 #include "lbann/proto/weights.pb.h"
 
 #include <algorithm>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -309,9 +310,12 @@ auto data_type_weights<TensorDataType>::get_values() const
     return *m_values;
   }
 
-  // Get weights as necessary
+  // Use prefetched weights if available, otherwise gather them now.
+  // Prefetched weights are only used once so that later calls observe
+  // updates to the shard.
   request_full_weights_async();
   wait_for_full_weights();
+  m_full_weights_status = full_weights_status::none;
 
   return *m_values_view;
 }
@@ -455,23 +459,136 @@ void data_type_weights<TensorDataType>::set_value(TensorDataType value,
 template <typename TensorDataType>
 void data_type_weights<TensorDataType>::request_full_weights_async() const
 {
+  if (!this->is_sharded() ||
+      m_full_weights_status != full_weights_status::none) {
+    return;
+  }
   m_values_view->AlignWith(this->get_matrix_distribution());
   m_values_view->Resize(this->get_matrix_height(), this->get_matrix_width());
-  El::Copy(*m_values, *m_values_view);
+  if (!can_gather_full_weights_async()) {
+    El::Copy(*m_values, *m_values_view);
+    m_full_weights_status = full_weights_status::ready;
+    return;
+  }
+
+  // Each rank owns a strided subset of the columns (or entries, for
+  // column vectors). Pack the local slices into a buffer padded to
+  // the largest local size so a plain allgather can be used.
+  const auto& values = *m_values;
+  const auto& local_values = values.LockedMatrix();
+  const bool shard_cols = (values.RowDist() == El::VC);
+  const El::Int slice_size = shard_cols ? values.Height() : 1;
+  const El::Int num_slices = shard_cols ? values.Width() : values.Height();
+  const El::Int local_slices =
+    shard_cols ? values.LocalWidth() : values.LocalHeight();
+  const El::Int num_procs = values.Grid().VCSize();
+  const El::Int max_local_slices = El::MaxLength(num_slices, num_procs);
+  const El::Int count = slice_size * max_local_slices;
+  m_gather_send_buffer.Resize(count, 1);
+  m_gather_recv_buffer.Resize(count * num_procs, 1);
+  auto* send_buf = m_gather_send_buffer.Buffer();
+  for (El::Int k = 0; k < local_slices; ++k) {
+    const auto* slice = shard_cols ? local_values.LockedBuffer(0, k)
+                                   : local_values.LockedBuffer(k, 0);
+    std::copy(slice, slice + slice_size, send_buf + k * slice_size);
+  }
+  this->get_comm().nb_all_gather(send_buf,
+                                 static_cast<int>(count),
+                                 m_gather_recv_buffer.Buffer(),
+                                 static_cast<int>(count),
+                                 values.Grid().VCComm(),
+                                 m_full_weights_req);
+  m_full_weights_status = full_weights_status::pending;
 }
 
 template <typename TensorDataType>
 void data_type_weights<TensorDataType>::wait_for_full_weights() const
 {
-  // TODO(later): Wait for asynchronous gather, if necessary
+  if (m_full_weights_status != full_weights_status::pending) {
+    return;
+  }
+  this->get_comm().wait(m_full_weights_req);
+  unpack_full_weights();
+  m_full_weights_status = full_weights_status::ready;
 }
 
 template <typename TensorDataType>
 void data_type_weights<TensorDataType>::release_full_weights() const
 {
   if (this->is_sharded()) {
+    if (m_full_weights_status == full_weights_status::pending) {
+      this->get_comm().wait(m_full_weights_req);
+      m_gather_recv_buffer.Empty();
+    }
     m_values_view->Empty();
+    m_full_weights_status = full_weights_status::none;
+  }
+}
+
+template <typename TensorDataType>
+size_t data_type_weights<TensorDataType>::get_full_weights_memory_size() const
+{
+  return this->get_size() * sizeof(TensorDataType);
+}
+
+template <typename TensorDataType>
+bool data_type_weights<TensorDataType>::can_gather_full_weights_async() const
+{
+  const auto& values = *m_values;
+  const auto& view = *m_values_view;
+  if (values.GetLocalDevice() != El::Device::CPU ||
+      values.Wrap() != El::ELEMENT || !values.Participating() ||
+      values.Grid().VCSize() == 1) {
+    return false;
+  }
+  if (view.ColDist() != El::STAR || view.RowDist() != El::STAR ||
+      view.GetLocalDevice() != El::Device::CPU) {
+    return false;
+  }
+  const bool shard_cols =
+    (values.ColDist() == El::STAR && values.RowDist() == El::VC);
+  const bool shard_rows = (values.ColDist() == El::VC &&
+                           values.RowDist() == El::STAR && values.Width() == 1);
+  if (!shard_cols && !shard_rows) {
+    return false;
+  }
+
+  // The allgather takes int counts
+  const El::Int num_procs = values.Grid().VCSize();
+  const El::Int slice_size = shard_cols ? values.Height() : 1;
+  const El::Int num_slices = shard_cols ? values.Width() : values.Height();
+  const El::Int count = slice_size * El::MaxLength(num_slices, num_procs);
+  return count * num_procs <= std::numeric_limits<int>::max();
+}
+
+template <typename TensorDataType>
+void data_type_weights<TensorDataType>::unpack_full_weights() const
+{
+  const auto& values = *m_values;
+  auto& local_view = m_values_view->Matrix();
+  const bool shard_cols = (values.RowDist() == El::VC);
+  const El::Int slice_size = shard_cols ? values.Height() : 1;
+  const El::Int num_slices = shard_cols ? values.Width() : values.Height();
+  const El::Int align = shard_cols ? values.RowAlign() : values.ColAlign();
+  const El::Int num_procs = values.Grid().VCSize();
+  const El::Int max_local_slices = El::MaxLength(num_slices, num_procs);
+  const auto* recv_buf = m_gather_recv_buffer.LockedBuffer();
+  for (El::Int rank = 0; rank < num_procs; ++rank) {
+    const El::Int shift = El::Shift(rank, align, num_procs);
+    const El::Int rank_slices = El::Length(num_slices, shift, num_procs);
+    const auto* rank_buf = recv_buf + rank * max_local_slices * slice_size;
+    for (El::Int k = 0; k < rank_slices; ++k) {
+      const El::Int slice_index = shift + k * num_procs;
+      auto* slice = shard_cols ? local_view.Buffer(0, slice_index)
+                               : local_view.Buffer(slice_index, 0);
+      std::copy(rank_buf + k * slice_size,
+                rank_buf + (k + 1) * slice_size,
+                slice);
+    }
   }
+
+  // The staging buffer holds a full copy of the weights, so free it
+  m_gather_recv_buffer.Empty();
 }
 
 template <typename TensorDataType>
@@ -171,3 +171,67 @@ TEST_CASE("Serializing weights", "[mpi][weights][serialize]")
   }
 #endif // LBANN_HAS_CEREAL_XML_ARCHIVES
 }
+
+TEST_CASE("Gathering sharded weights", "[mpi][weights][sharded]")
+{
+  using DataType = float;
+
+  auto& world_comm = unit_test::utilities::current_world_comm();
+  auto const& g = world_comm.get_trainer_grid();
+  lbann::utils::grid_manager mgr(g);
+  size_t const num_procs = g.VCSize();
+
+  // Shards have different sizes unless there is only one rank
+  size_t height = 3, width = 2 * num_procs + 1;
+  SECTION("Sharded columns") {}
+  SECTION("Sharded column vector")
+  {
+    height = 3 * num_procs + 2;
+    width = 1;
+  }
+
+  DataTypeWeights<DataType> dtw(world_comm);
+  dtw.set_dims({height}, {width});
+  dtw.set_sharded(true);
+  dtw.set_sharding_distribution(El::VC);
+  dtw.setup();
+
+  // Fill the shard with values that identify each entry
+  auto& shard = dtw.get_values_sharded();
+  auto& local_shard = shard.Matrix();
+  for (El::Int j = 0; j < shard.LocalWidth(); ++j) {
+    for (El::Int i = 0; i < shard.LocalHeight(); ++i) {
+      local_shard(i, j) =
+        El::To<DataType>(shard.GlobalRow(i) + 100 * shard.GlobalCol(j));
+    }
+  }
+
+  // The packed allgather matches a redistribution with El::Copy
+  El::DistMatrix<DataType, El::STAR, El::STAR, El::ELEMENT, El::Device::CPU>
+    expected(g);
+  El::Copy(shard, expected);
+  auto const& values = dtw.get_values();
+  REQUIRE(values.Height() == El::Int(height));
+  REQUIRE(values.Width() == El::Int(width));
+  REQUIRE(values.LocalHeight() == El::Int(height));
+  REQUIRE(values.LocalWidth() == El::Int(width));
+  for (El::Int j = 0; j < El::Int(width); ++j) {
+    for (El::Int i = 0; i < El::Int(height); ++i) {
+      CHECK(values.LockedMatrix().Get(i, j) ==
+            expected.LockedMatrix().Get(i, j));
+      CHECK(values.LockedMatrix().Get(i, j) == El::To<DataType>(i + 100 * j));
+    }
+  }
+
+  // Prefetched weights are unpacked by the wait
+  dtw.release_full_weights();
+  dtw.request_full_weights_async();
+  dtw.wait_for_full_weights();
+  auto const& prefetched = dtw.get_values();
+  for (El::Int j = 0; j < El::Int(width); ++j) {
+    for (El::Int i = 0; i < El::Int(height); ++i) {
+      CHECK(prefetched.LockedMatrix().Get(i, j) ==
+            expected.LockedMatrix().Get(i, j));
+    }
+  }
+}
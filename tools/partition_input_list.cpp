@@ -7,12 +7,41 @@
 #include <random>
 #include <chrono>
 
+#include "lbann/data_ingestion/readers/sample_list_binary.hpp"
+
 using namespace std;
 
+// Convert a text sample list to the binary format, with the records
+// laid out for the given number of ranks per trainer
+int convert_sample_list(int argc, char** argv)
+{
+  if(argc < 4) {
+    cout << "Usage .... exec --sample_list input_sample_list output_file [num_partitions]" << endl;
+    return -1;
+  }
+  std::string input_file = argv[2];
+  std::string output_file = argv[3];
+  size_t num_partitions = (argc > 4 ? std::stoul(argv[4]) : 1ul);
+
+  std::ifstream infile(input_file);
+  if (!infile) { std::cout << "\n can't open file : " << input_file << std::endl; return -1; }
+  std::ofstream outfile(output_file, std::ios::binary);
+  if (!outfile) { std::cout << "\n can't open file : " << output_file << std::endl; return -1; }
+  lbann::convert_sample_list_to_binary(infile, outfile, num_partitions);
+
+  std::cout << "Binary sample list for " << num_partitions
+            << " partition(s) saved as: " << output_file << std::endl;
+  return 0;
+}
+
 int main( int argc, char** argv)
 {
+  if(argc > 1 && std::string(argv[1]) == "--sample_list") {
+    return convert_sample_list(argc, argv);
+  }
   if(argc < 4) { 
     cout << "Usage .... exec input_file output_file_basename num_partitions" << endl;
+    cout << "      .... exec --sample_list input_sample_list output_file [num_partitions]" << endl;
     exit(-1);
   }
     